@@ -0,0 +1,103 @@
+// JSON [de]serialization for protobuf + embedded HTTP server and client in C++.
+// Copyright (C) 2014 http://protojson.com/
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <uv.h>
+
+#include "pjcore/json.h"
+#include "pjcore_test/test_message.pb.h"
+
+using namespace pjcore;  // NOLINT(build/namespaces)
+
+namespace {
+
+const int kDefaultDepth = 10;
+
+const int kDefaultWidth = 64;
+
+const int kDefaultIterations = 20;
+
+void FillLevel(int depth, int width, TestMessage* message) {
+  message->set_optional_int32(depth);
+  message->set_optional_string("level");
+  message->set_optional_bytes("\x01\x02\x03");
+
+  for (int index = 0; index < width; ++index) {
+    message->add_repeated_int32(index);
+    message->add_repeated_double(index * .5);
+    message->add_repeated_string("element");
+  }
+
+  if (depth > 1) {
+    FillLevel(depth - 1, width, message->mutable_optional_message());
+
+    for (int index = 0; index < 2; ++index) {
+      TestMessage* repeated = message->add_repeated_message();
+      repeated->set_optional_int64(index);
+      for (int element = 0; element < width; ++element) {
+        repeated->add_repeated_uint64(element);
+      }
+    }
+  }
+}
+
+}  // unnamed namespace
+
+int main(int argc, const char* argv[]) {
+  int depth = kDefaultDepth;
+  int width = kDefaultWidth;
+  int iterations = kDefaultIterations;
+
+  int arg_index = 1;
+  if (arg_index < argc) {
+    depth = atoi(argv[arg_index++]);
+  }
+  if (arg_index < argc) {
+    width = atoi(argv[arg_index++]);
+  }
+  if (arg_index < argc) {
+    iterations = atoi(argv[arg_index++]);
+  }
+
+  if (depth < 1 || width < 0 || iterations < 1) {
+    fprintf(stderr, "Usage: %s [depth [width [iterations]]]\n", argv[0]);
+    return 1;
+  }
+
+  TestMessage message;
+  FillLevel(depth, width, &message);
+
+  size_t json_size = 0;
+
+  uint64_t begin_ns = uv_hrtime();
+
+  for (int iteration = 0; iteration < iterations; ++iteration) {
+    JsonValue value = MakeJsonValue(message);
+    json_size += ComputeJsonSize(value);
+  }
+
+  uint64_t elapsed_ns = uv_hrtime() - begin_ns;
+
+  fprintf(stdout,
+          "Depth: %d, width: %d, iterations: %d, JSON bytes per iteration: "
+          "%d, microseconds per iteration: %.1f\n",
+          depth, width, iterations, static_cast<int>(json_size / iterations),
+          elapsed_ns / 1000. / iterations);
+
+  return 0;
+}
@@ -51,6 +51,7 @@ enum HttpStatusCode {
   HTTP_STATUS_CODE_NO_CONTENT = 204,
   HTTP_STATUS_CODE_RESET_CONTENT = 205,
   HTTP_STATUS_CODE_PARTIAL_CONTENT = 206,
+  HTTP_STATUS_CODE_IM_USED = 226,
   HTTP_STATUS_CODE_MULTIPLE_CHOICES = 300,
   HTTP_STATUS_CODE_MOVED_PERMANENTLY = 301,
   HTTP_STATUS_CODE_FOUND = 302,
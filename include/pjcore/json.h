@@ -18,6 +18,8 @@
 #ifndef PJCORE_JSON_H_
 #define PJCORE_JSON_H_
 
+#include "pjcore/json_binary.h"
+#include "pjcore/json_field_mask.h"
 #include "pjcore/json_properties.h"
 #include "pjcore/json_reader.h"
 #include "pjcore/json_util.h"
@@ -50,11 +50,12 @@ enum JsonValue_Type {
   JsonValue_Type_TYPE_DOUBLE = 4,
   JsonValue_Type_TYPE_STRING = 5,
   JsonValue_Type_TYPE_OBJECT = 6,
-  JsonValue_Type_TYPE_ARRAY = 7
+  JsonValue_Type_TYPE_ARRAY = 7,
+  JsonValue_Type_TYPE_RAW_NUMBER = 8
 };
 bool JsonValue_Type_IsValid(int value);
 const JsonValue_Type JsonValue_Type_Type_MIN = JsonValue_Type_TYPE_NULL;
-const JsonValue_Type JsonValue_Type_Type_MAX = JsonValue_Type_TYPE_ARRAY;
+const JsonValue_Type JsonValue_Type_Type_MAX = JsonValue_Type_TYPE_RAW_NUMBER;
 const int JsonValue_Type_Type_ARRAYSIZE = JsonValue_Type_Type_MAX + 1;
 
 const ::google::protobuf::EnumDescriptor* JsonValue_Type_descriptor();
@@ -248,6 +249,7 @@ class JsonValue : public ::google::protobuf::Message {
   static const Type TYPE_STRING = JsonValue_Type_TYPE_STRING;
   static const Type TYPE_OBJECT = JsonValue_Type_TYPE_OBJECT;
   static const Type TYPE_ARRAY = JsonValue_Type_TYPE_ARRAY;
+  static const Type TYPE_RAW_NUMBER = JsonValue_Type_TYPE_RAW_NUMBER;
   static inline bool Type_IsValid(int value) {
     return JsonValue_Type_IsValid(value);
   }
@@ -342,6 +344,42 @@ class JsonValue : public ::google::protobuf::Message {
   inline ::google::protobuf::RepeatedPtrField< ::pjcore::JsonValue >*
       mutable_array_elements();
 
+  // repeated int64 packed_signed_values = 9;
+  inline int packed_signed_values_size() const;
+  inline void clear_packed_signed_values();
+  static const int kPackedSignedValuesFieldNumber = 9;
+  inline ::google::protobuf::int64 packed_signed_values(int index) const;
+  inline void set_packed_signed_values(int index, ::google::protobuf::int64 value);
+  inline void add_packed_signed_values(::google::protobuf::int64 value);
+  inline const ::google::protobuf::RepeatedField< ::google::protobuf::int64 >&
+      packed_signed_values() const;
+  inline ::google::protobuf::RepeatedField< ::google::protobuf::int64 >*
+      mutable_packed_signed_values();
+
+  // repeated uint64 packed_unsigned_values = 10;
+  inline int packed_unsigned_values_size() const;
+  inline void clear_packed_unsigned_values();
+  static const int kPackedUnsignedValuesFieldNumber = 10;
+  inline ::google::protobuf::uint64 packed_unsigned_values(int index) const;
+  inline void set_packed_unsigned_values(int index, ::google::protobuf::uint64 value);
+  inline void add_packed_unsigned_values(::google::protobuf::uint64 value);
+  inline const ::google::protobuf::RepeatedField< ::google::protobuf::uint64 >&
+      packed_unsigned_values() const;
+  inline ::google::protobuf::RepeatedField< ::google::protobuf::uint64 >*
+      mutable_packed_unsigned_values();
+
+  // repeated double packed_double_values = 11;
+  inline int packed_double_values_size() const;
+  inline void clear_packed_double_values();
+  static const int kPackedDoubleValuesFieldNumber = 11;
+  inline double packed_double_values(int index) const;
+  inline void set_packed_double_values(int index, double value);
+  inline void add_packed_double_values(double value);
+  inline const ::google::protobuf::RepeatedField< double >&
+      packed_double_values() const;
+  inline ::google::protobuf::RepeatedField< double >*
+      mutable_packed_double_values();
+
   // @@protoc_insertion_point(class_scope:pjcore.JsonValue)
  private:
   inline void set_has_type();
@@ -368,6 +406,9 @@ class JsonValue : public ::google::protobuf::Message {
   ::google::protobuf::internal::ArenaStringPtr string_value_;
   ::google::protobuf::RepeatedPtrField< ::pjcore::JsonValue_Property > object_properties_;
   ::google::protobuf::RepeatedPtrField< ::pjcore::JsonValue > array_elements_;
+  ::google::protobuf::RepeatedField< ::google::protobuf::int64 > packed_signed_values_;
+  ::google::protobuf::RepeatedField< ::google::protobuf::uint64 > packed_unsigned_values_;
+  ::google::protobuf::RepeatedField< double > packed_double_values_;
   friend void  protobuf_AddDesc_pjcore_2fjson_2eproto();
   friend void protobuf_AssignDesc_pjcore_2fjson_2eproto();
   friend void protobuf_ShutdownFile_pjcore_2fjson_2eproto();
@@ -476,6 +517,20 @@ class JsonReaderConfig : public ::google::protobuf::Message {
   inline bool disallow_nan_and_infinity() const;
   inline void set_disallow_nan_and_infinity(bool value);
 
+  // optional bool pack_numeric_arrays = 6;
+  inline bool has_pack_numeric_arrays() const;
+  inline void clear_pack_numeric_arrays();
+  static const int kPackNumericArraysFieldNumber = 6;
+  inline bool pack_numeric_arrays() const;
+  inline void set_pack_numeric_arrays(bool value);
+
+  // optional bool raw_numbers = 7;
+  inline bool has_raw_numbers() const;
+  inline void clear_raw_numbers();
+  static const int kRawNumbersFieldNumber = 7;
+  inline bool raw_numbers() const;
+  inline void set_raw_numbers(bool value);
+
   // @@protoc_insertion_point(class_scope:pjcore.JsonReaderConfig)
  private:
   inline void set_has_disallow_comments();
@@ -488,6 +543,10 @@ class JsonReaderConfig : public ::google::protobuf::Message {
   inline void clear_has_allow_control_characters();
   inline void set_has_disallow_nan_and_infinity();
   inline void clear_has_disallow_nan_and_infinity();
+  inline void set_has_pack_numeric_arrays();
+  inline void clear_has_pack_numeric_arrays();
+  inline void set_has_raw_numbers();
+  inline void clear_has_raw_numbers();
 
   ::google::protobuf::internal::InternalMetadataWithArena _internal_metadata_;
   ::google::protobuf::uint32 _has_bits_[1];
@@ -497,6 +556,8 @@ class JsonReaderConfig : public ::google::protobuf::Message {
   bool properties_as_is_;
   bool allow_control_characters_;
   bool disallow_nan_and_infinity_;
+  bool pack_numeric_arrays_;
+  bool raw_numbers_;
   friend void  protobuf_AddDesc_pjcore_2fjson_2eproto();
   friend void protobuf_AssignDesc_pjcore_2fjson_2eproto();
   friend void protobuf_ShutdownFile_pjcore_2fjson_2eproto();
@@ -974,6 +1035,96 @@ JsonValue::mutable_array_elements() {
   return &array_elements_;
 }
 
+// repeated int64 packed_signed_values = 9;
+inline int JsonValue::packed_signed_values_size() const {
+  return packed_signed_values_.size();
+}
+inline void JsonValue::clear_packed_signed_values() {
+  packed_signed_values_.Clear();
+}
+inline ::google::protobuf::int64 JsonValue::packed_signed_values(int index) const {
+  // @@protoc_insertion_point(field_get:pjcore.JsonValue.packed_signed_values)
+  return packed_signed_values_.Get(index);
+}
+inline void JsonValue::set_packed_signed_values(int index, ::google::protobuf::int64 value) {
+  packed_signed_values_.Set(index, value);
+  // @@protoc_insertion_point(field_set:pjcore.JsonValue.packed_signed_values)
+}
+inline void JsonValue::add_packed_signed_values(::google::protobuf::int64 value) {
+  packed_signed_values_.Add(value);
+  // @@protoc_insertion_point(field_add:pjcore.JsonValue.packed_signed_values)
+}
+inline const ::google::protobuf::RepeatedField< ::google::protobuf::int64 >&
+JsonValue::packed_signed_values() const {
+  // @@protoc_insertion_point(field_list:pjcore.JsonValue.packed_signed_values)
+  return packed_signed_values_;
+}
+inline ::google::protobuf::RepeatedField< ::google::protobuf::int64 >*
+JsonValue::mutable_packed_signed_values() {
+  // @@protoc_insertion_point(field_mutable_list:pjcore.JsonValue.packed_signed_values)
+  return &packed_signed_values_;
+}
+
+// repeated uint64 packed_unsigned_values = 10;
+inline int JsonValue::packed_unsigned_values_size() const {
+  return packed_unsigned_values_.size();
+}
+inline void JsonValue::clear_packed_unsigned_values() {
+  packed_unsigned_values_.Clear();
+}
+inline ::google::protobuf::uint64 JsonValue::packed_unsigned_values(int index) const {
+  // @@protoc_insertion_point(field_get:pjcore.JsonValue.packed_unsigned_values)
+  return packed_unsigned_values_.Get(index);
+}
+inline void JsonValue::set_packed_unsigned_values(int index, ::google::protobuf::uint64 value) {
+  packed_unsigned_values_.Set(index, value);
+  // @@protoc_insertion_point(field_set:pjcore.JsonValue.packed_unsigned_values)
+}
+inline void JsonValue::add_packed_unsigned_values(::google::protobuf::uint64 value) {
+  packed_unsigned_values_.Add(value);
+  // @@protoc_insertion_point(field_add:pjcore.JsonValue.packed_unsigned_values)
+}
+inline const ::google::protobuf::RepeatedField< ::google::protobuf::uint64 >&
+JsonValue::packed_unsigned_values() const {
+  // @@protoc_insertion_point(field_list:pjcore.JsonValue.packed_unsigned_values)
+  return packed_unsigned_values_;
+}
+inline ::google::protobuf::RepeatedField< ::google::protobuf::uint64 >*
+JsonValue::mutable_packed_unsigned_values() {
+  // @@protoc_insertion_point(field_mutable_list:pjcore.JsonValue.packed_unsigned_values)
+  return &packed_unsigned_values_;
+}
+
+// repeated double packed_double_values = 11;
+inline int JsonValue::packed_double_values_size() const {
+  return packed_double_values_.size();
+}
+inline void JsonValue::clear_packed_double_values() {
+  packed_double_values_.Clear();
+}
+inline double JsonValue::packed_double_values(int index) const {
+  // @@protoc_insertion_point(field_get:pjcore.JsonValue.packed_double_values)
+  return packed_double_values_.Get(index);
+}
+inline void JsonValue::set_packed_double_values(int index, double value) {
+  packed_double_values_.Set(index, value);
+  // @@protoc_insertion_point(field_set:pjcore.JsonValue.packed_double_values)
+}
+inline void JsonValue::add_packed_double_values(double value) {
+  packed_double_values_.Add(value);
+  // @@protoc_insertion_point(field_add:pjcore.JsonValue.packed_double_values)
+}
+inline const ::google::protobuf::RepeatedField< double >&
+JsonValue::packed_double_values() const {
+  // @@protoc_insertion_point(field_list:pjcore.JsonValue.packed_double_values)
+  return packed_double_values_;
+}
+inline ::google::protobuf::RepeatedField< double >*
+JsonValue::mutable_packed_double_values() {
+  // @@protoc_insertion_point(field_mutable_list:pjcore.JsonValue.packed_double_values)
+  return &packed_double_values_;
+}
+
 // -------------------------------------------------------------------
 
 // JsonReaderConfig
@@ -1098,6 +1249,54 @@ inline void JsonReaderConfig::set_disallow_nan_and_infinity(bool value) {
   // @@protoc_insertion_point(field_set:pjcore.JsonReaderConfig.disallow_nan_and_infinity)
 }
 
+// optional bool pack_numeric_arrays = 6;
+inline bool JsonReaderConfig::has_pack_numeric_arrays() const {
+  return (_has_bits_[0] & 0x00000020u) != 0;
+}
+inline void JsonReaderConfig::set_has_pack_numeric_arrays() {
+  _has_bits_[0] |= 0x00000020u;
+}
+inline void JsonReaderConfig::clear_has_pack_numeric_arrays() {
+  _has_bits_[0] &= ~0x00000020u;
+}
+inline void JsonReaderConfig::clear_pack_numeric_arrays() {
+  pack_numeric_arrays_ = false;
+  clear_has_pack_numeric_arrays();
+}
+inline bool JsonReaderConfig::pack_numeric_arrays() const {
+  // @@protoc_insertion_point(field_get:pjcore.JsonReaderConfig.pack_numeric_arrays)
+  return pack_numeric_arrays_;
+}
+inline void JsonReaderConfig::set_pack_numeric_arrays(bool value) {
+  set_has_pack_numeric_arrays();
+  pack_numeric_arrays_ = value;
+  // @@protoc_insertion_point(field_set:pjcore.JsonReaderConfig.pack_numeric_arrays)
+}
+
+// optional bool raw_numbers = 7;
+inline bool JsonReaderConfig::has_raw_numbers() const {
+  return (_has_bits_[0] & 0x00000040u) != 0;
+}
+inline void JsonReaderConfig::set_has_raw_numbers() {
+  _has_bits_[0] |= 0x00000040u;
+}
+inline void JsonReaderConfig::clear_has_raw_numbers() {
+  _has_bits_[0] &= ~0x00000040u;
+}
+inline void JsonReaderConfig::clear_raw_numbers() {
+  raw_numbers_ = false;
+  clear_has_raw_numbers();
+}
+inline bool JsonReaderConfig::raw_numbers() const {
+  // @@protoc_insertion_point(field_get:pjcore.JsonReaderConfig.raw_numbers)
+  return raw_numbers_;
+}
+inline void JsonReaderConfig::set_raw_numbers(bool value) {
+  set_has_raw_numbers();
+  raw_numbers_ = value;
+  // @@protoc_insertion_point(field_set:pjcore.JsonReaderConfig.raw_numbers)
+}
+
 // -------------------------------------------------------------------
 
 // JsonWriterConfig
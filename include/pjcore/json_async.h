@@ -0,0 +1,80 @@
+// JSON [de]serialization for protobuf + embedded HTTP server and client in C++.
+// Copyright (C) 2014 http://protojson.com/
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+
+#ifndef PJCORE_JSON_ASYNC_H_
+#define PJCORE_JSON_ASYNC_H_
+
+#include <string>
+
+#include "pjcore/third_party/chromium/callback.h"
+#include "pjcore/third_party/chromium/scoped_ptr.h"
+#include "pjcore/third_party/chromium/string_piece.h"
+
+#include "pjcore/error.pb.h"
+#include "pjcore/json.pb.h"
+#include "pjcore/shared_uv_loop.h"
+
+namespace pjcore {
+
+// Inputs smaller than this are read or written on the calling thread, where
+// the cost of a thread pool round trip would exceed the work itself.
+const size_t kDefaultMinAsyncJsonSize = 256 * 1024;
+
+typedef Callback<void(scoped_ptr<JsonValue> value, const Error& error)>
+    JsonValueCallback;
+
+typedef Callback<void(scoped_ptr<std::string> str, const Error& error)>
+    JsonStringCallback;
+
+// Parses str on the thread pool of shared_loop when it is at least
+// min_async_size bytes long and runs on_value on the loop thread afterwards,
+// or parses it and runs on_value before returning otherwise. str must stay
+// valid until on_value runs. On failure on_value gets a NULL value.
+void ReadJsonAsync(
+    const SharedUvLoop& shared_loop, StringPiece str,
+    const JsonValueCallback& on_value,
+    const JsonReaderConfig& config = JsonReaderConfig::default_instance(),
+    size_t min_async_size = kDefaultMinAsyncJsonSize);
+
+// Writes value the same way, going by its encoded protobuf size, which is
+// much cheaper to compute than the JSON one. value is deleted on the thread
+// that writes it.
+void WriteJsonAsync(
+    const SharedUvLoop& shared_loop, scoped_ptr<JsonValue> value,
+    const JsonStringCallback& on_str,
+    const JsonWriterConfig& config = JsonWriterConfig::default_instance(),
+    size_t min_async_size = kDefaultMinAsyncJsonSize);
+
+const size_t kDefaultJsonStepSize = 64 * 1024;
+
+typedef Callback<void(StringPiece chunk)> JsonChunkCallback;
+
+// Writes value on the loop thread without holding it up: on each turn of the
+// loop an idle handle runs one ResumableJsonWriter step of step_size bytes
+// and passes its text to on_chunk, so that other handles of the loop are
+// served in between. on_complete runs after the last chunk. value must stay
+// valid and unchanged until then.
+void WriteJsonInSteps(
+    const SharedUvLoop& shared_loop, const JsonValue& value,
+    const JsonChunkCallback& on_chunk, const Closure& on_complete,
+    const JsonWriterConfig& config = JsonWriterConfig::default_instance(),
+    size_t step_size = kDefaultJsonStepSize);
+
+}  // namespace pjcore
+
+#endif  // PJCORE_JSON_ASYNC_H_
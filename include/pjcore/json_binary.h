@@ -0,0 +1,90 @@
+// JSON [de]serialization for protobuf + embedded HTTP server and client in C++.
+// Copyright (C) 2014 http://protojson.com/
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+
+#ifndef PJCORE_JSON_BINARY_H_
+#define PJCORE_JSON_BINARY_H_
+
+#include <string>
+
+#include "pjcore/third_party/chromium/string_piece.h"
+
+#include "pjcore/error.pb.h"
+#include "pjcore/json.pb.h"
+#include "pjcore/make_json_value.h"
+
+namespace pjcore {
+
+// CBOR (RFC 7049) encoding of JSON values. Integers are written in the
+// shortest form and read back as TYPE_SIGNED unless they exceed int64_t, like
+// ReadJson does for text. Doubles stay doubles, using single precision when
+// that is exact.
+std::string WriteCbor(const JsonValue& value);
+
+template <typename Value>
+std::string WriteCbor(const Value& value) {
+  return WriteCbor(MakeJsonValue(value));
+}
+
+// Appends to output.
+void WriteCbor(const JsonValue& value, std::string* output);
+
+template <typename Value>
+void WriteCbor(const Value& value, std::string* output) {
+  WriteCbor(MakeJsonValue(value), output);
+}
+
+// Reads a single CBOR data item. Tags are skipped, undefined is read as null,
+// and byte strings are rejected. Of config, only properties_as_is,
+// disallow_nan_and_infinity and pack_numeric_arrays apply.
+bool ReadCbor(
+    StringPiece cbor, JsonValue* value, Error* error,
+    const JsonReaderConfig& config = JsonReaderConfig::default_instance());
+
+bool ReadCbor(StringPiece cbor, google::protobuf::Message* message,
+              Error* error);
+
+// MessagePack encoding of JSON values. Unlike CBOR, signed and unsigned
+// integers use separate formats, so all JsonValue types round-trip exactly.
+std::string WriteMsgPack(const JsonValue& value);
+
+template <typename Value>
+std::string WriteMsgPack(const Value& value) {
+  return WriteMsgPack(MakeJsonValue(value));
+}
+
+// Appends to output.
+void WriteMsgPack(const JsonValue& value, std::string* output);
+
+template <typename Value>
+void WriteMsgPack(const Value& value, std::string* output) {
+  WriteMsgPack(MakeJsonValue(value), output);
+}
+
+// Reads a single MessagePack object. Binary and extension types are
+// rejected. Of config, only properties_as_is, disallow_nan_and_infinity and
+// pack_numeric_arrays apply.
+bool ReadMsgPack(
+    StringPiece msg_pack, JsonValue* value, Error* error,
+    const JsonReaderConfig& config = JsonReaderConfig::default_instance());
+
+bool ReadMsgPack(StringPiece msg_pack, google::protobuf::Message* message,
+                 Error* error);
+
+}  // namespace pjcore
+
+#endif  // PJCORE_JSON_BINARY_H_
@@ -0,0 +1,464 @@
+// JSON [de]serialization for protobuf + embedded HTTP server and client in C++.
+// Copyright (C) 2014 http://protojson.com/
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+
+#ifndef PJCORE_JSON_BINDING_H_
+#define PJCORE_JSON_BINDING_H_
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "pjcore/third_party/chromium/macros.h"
+#include "pjcore/third_party/chromium/string_piece.h"
+
+#include "pjcore/error.pb.h"
+#include "pjcore/json.pb.h"
+#include "pjcore/json_reader.h"
+#include "pjcore/json_tokenizer.h"
+#include "pjcore/json_writer.h"
+#include "pjcore/logging.h"
+
+namespace pjcore {
+
+/**
+ * Binds the fields of a plain struct to the properties of a JSON object.
+ * Specialized at global scope with
+ *
+ *   PJCORE_JSON_BINDING(Point,
+ *                       PJCORE_JSON_FIELD(x)
+ *                       PJCORE_JSON_FIELD(y)
+ *                       PJCORE_JSON_NAMED_FIELD(labels, "tags"))
+ *
+ * after which WriteJson and ReadJson below read and write Point, and
+ * std::vector, std::map with string keys and JsonOptional of it, straight
+ * from the tokenizer and to the writer. They follow the signatures of the
+ * codecs generated by protoc-gen-pjcore, so that bound structs and messages
+ * with generated codecs may hold each other.
+ */
+template <typename Struct>
+struct JsonBinding;
+
+#define PJCORE_JSON_BINDING(Struct, fields)                  \
+  namespace pjcore {                                         \
+  template <>                                                \
+  struct JsonBinding<Struct> {                               \
+    template <typename Value, typename Visitor>              \
+    static bool VisitFields(Value* value, Visitor* visitor) { \
+      return true fields;                                    \
+    }                                                        \
+  };                                                         \
+  }
+
+#define PJCORE_JSON_FIELD(member) PJCORE_JSON_NAMED_FIELD(member, #member)
+
+#define PJCORE_JSON_NAMED_FIELD(member, name) \
+  &&visitor->Field(name, &value->member)
+
+/**
+ * Value that may be missing, written as null or, in a bound struct, not at
+ * all.
+ */
+template <typename Value>
+class JsonOptional {
+ public:
+  JsonOptional() : has_value_(false), value_() {}
+
+  explicit JsonOptional(const Value& value) : has_value_(true), value_(value) {}
+
+  bool has_value() const { return has_value_; }
+
+  const Value& value() const { return value_; }
+
+  Value* mutable_value() {
+    has_value_ = true;
+    return &value_;
+  }
+
+  void Clear() {
+    has_value_ = false;
+    value_ = Value();
+  }
+
+ private:
+  bool has_value_;
+
+  Value value_;
+};
+
+void WriteJson(bool bool_value, JsonWriter* writer);
+void WriteJson(int32_t signed_value, JsonWriter* writer);
+void WriteJson(int64_t signed_value, JsonWriter* writer);
+#ifdef PJCORE_DISTINCT_LONG_LONG
+void WriteJson(long long int signed_value,  // NOLINT(runtime/int)
+               JsonWriter* writer);
+#endif  // PJCORE_DISTINCT_LONG_LONG
+void WriteJson(uint32_t unsigned_value, JsonWriter* writer);
+void WriteJson(uint64_t unsigned_value, JsonWriter* writer);
+#ifdef PJCORE_DISTINCT_LONG_LONG
+void WriteJson(long long unsigned int unsigned_value,  // NOLINT(runtime/int)
+               JsonWriter* writer);
+#endif  // PJCORE_DISTINCT_LONG_LONG
+void WriteJson(float float_value, JsonWriter* writer);
+void WriteJson(double double_value, JsonWriter* writer);
+void WriteJson(const std::string& string_value, JsonWriter* writer);
+void WriteJson(const JsonValue& value, JsonWriter* writer);
+
+template <typename Struct>
+void WriteJson(const Struct& value, JsonWriter* writer);
+
+template <typename Element>
+void WriteJson(const std::vector<Element>& value, JsonWriter* writer);
+
+template <typename Element>
+void WriteJson(const std::map<std::string, Element>& value,
+               JsonWriter* writer);
+
+template <typename Value>
+void WriteJson(const JsonOptional<Value>& value, JsonWriter* writer);
+
+// The readers take the value starting at the current token, leaving the
+// tokenizer at its last token, as ReadJson for JsonValue does.
+
+bool ReadJson(JsonTokenizer* tokenizer, bool* bool_value, Error* error);
+bool ReadJson(JsonTokenizer* tokenizer, int32_t* signed_value, Error* error);
+bool ReadJson(JsonTokenizer* tokenizer, int64_t* signed_value, Error* error);
+#ifdef PJCORE_DISTINCT_LONG_LONG
+bool ReadJson(JsonTokenizer* tokenizer,
+              long long int* signed_value,  // NOLINT(runtime/int)
+              Error* error);
+#endif  // PJCORE_DISTINCT_LONG_LONG
+bool ReadJson(JsonTokenizer* tokenizer, uint32_t* unsigned_value,
+              Error* error);
+bool ReadJson(JsonTokenizer* tokenizer, uint64_t* unsigned_value,
+              Error* error);
+#ifdef PJCORE_DISTINCT_LONG_LONG
+bool ReadJson(JsonTokenizer* tokenizer,
+              long long unsigned int* unsigned_value,  // NOLINT(runtime/int)
+              Error* error);
+#endif  // PJCORE_DISTINCT_LONG_LONG
+bool ReadJson(JsonTokenizer* tokenizer, float* float_value, Error* error);
+bool ReadJson(JsonTokenizer* tokenizer, double* double_value, Error* error);
+bool ReadJson(JsonTokenizer* tokenizer, std::string* string_value,
+              Error* error);
+bool ReadJson(JsonTokenizer* tokenizer, std::vector<bool>* value,
+              Error* error);
+
+template <typename Struct>
+bool ReadJson(JsonTokenizer* tokenizer, Struct* value, Error* error);
+
+template <typename Element>
+bool ReadJson(JsonTokenizer* tokenizer, std::vector<Element>* value,
+              Error* error);
+
+template <typename Element>
+bool ReadJson(JsonTokenizer* tokenizer,
+              std::map<std::string, Element>* value, Error* error);
+
+template <typename Value>
+bool ReadJson(JsonTokenizer* tokenizer, JsonOptional<Value>* value,
+              Error* error);
+
+template <typename Value>
+void WriteBoundJson(
+    const Value& value, std::string* output,
+    const JsonWriterConfig& config = JsonWriterConfig::default_instance()) {
+  JsonWriter writer(output, config);
+  WriteJson(value, &writer);
+}
+
+template <typename Value>
+std::string WriteBoundJson(
+    const Value& value,
+    const JsonWriterConfig& config = JsonWriterConfig::default_instance()) {
+  std::string output;
+  WriteBoundJson(value, &output, config);
+  return output;
+}
+
+template <typename Value>
+bool ReadBoundJson(
+    StringPiece str, Value* value, Error* error,
+    const JsonReaderConfig& config = JsonReaderConfig::default_instance()) {
+  PJCORE_CHECK(value);
+  PJCORE_CHECK(error);
+  error->Clear();
+
+  JsonTokenizer tokenizer(str, config);
+
+  PJCORE_REQUIRE_CAUSE(tokenizer.Next(error) &&
+                           ReadJson(&tokenizer, value, error) &&
+                           tokenizer.Next(error),
+                       "Failed to parse JSON string");
+
+  return true;
+}
+
+namespace internal {
+
+class JsonBindingWriter {
+ public:
+  explicit JsonBindingWriter(JsonWriter* writer) : writer_(writer) {}
+
+  template <typename Value>
+  bool Field(const char* name, const Value* value) {
+    writer_->Key(name);
+    WriteJson(*value, writer_);
+    return true;
+  }
+
+  template <typename Value>
+  bool Field(const char* name, const JsonOptional<Value>* value) {
+    if (value->has_value()) {
+      writer_->Key(name);
+      WriteJson(value->value(), writer_);
+    }
+    return true;
+  }
+
+ private:
+  JsonWriter* writer_;
+
+  DISALLOW_COPY_AND_ASSIGN(JsonBindingWriter);
+};
+
+// Reads the value of the property named name into the field of that name,
+// stopping the visit there.
+class JsonBindingReader {
+ public:
+  JsonBindingReader(StringPiece name, JsonTokenizer* tokenizer,
+                    std::vector<bool>* seen, Error* error)
+      : name_(name),
+        tokenizer_(tokenizer),
+        seen_(seen),
+        error_(error),
+        index_(0),
+        found_(false),
+        succeeded_(true) {}
+
+  bool found() const { return found_; }
+
+  bool succeeded() const { return succeeded_; }
+
+  template <typename Value>
+  bool Field(const char* name, Value* value) {
+    size_t index = index_++;
+    if (name_ != name) {
+      return true;
+    }
+
+    found_ = true;
+
+    if (!tokenizer_->config().properties_as_is()) {
+      if (seen_->size() <= index) {
+        seen_->resize(index + 1);
+      }
+      if ((*seen_)[index]) {
+        succeeded_ = tokenizer_->SkipValue(error_);
+        return false;
+      }
+      (*seen_)[index] = true;
+    }
+
+    if (tokenizer_->token() == JsonTokenizer::TOKEN_NULL) {
+      *value = Value();
+    } else {
+      succeeded_ = ReadJson(tokenizer_, value, error_);
+    }
+    return false;
+  }
+
+ private:
+  StringPiece name_;
+
+  JsonTokenizer* tokenizer_;
+
+  std::vector<bool>* seen_;
+
+  Error* error_;
+
+  size_t index_;
+
+  bool found_;
+
+  bool succeeded_;
+
+  DISALLOW_COPY_AND_ASSIGN(JsonBindingReader);
+};
+
+}  // namespace internal
+
+template <typename Struct>
+void WriteJson(const Struct& value, JsonWriter* writer) {
+  writer->BeginObject();
+  internal::JsonBindingWriter binding_writer(writer);
+  JsonBinding<Struct>::VisitFields(&value, &binding_writer);
+  writer->EndObject();
+}
+
+template <typename Element>
+void WriteJson(const std::vector<Element>& value, JsonWriter* writer) {
+  writer->BeginArray();
+  for (typename std::vector<Element>::const_iterator it = value.begin();
+       it != value.end(); ++it) {
+    WriteJson(*it, writer);
+  }
+  writer->EndArray();
+}
+
+template <typename Element>
+void WriteJson(const std::map<std::string, Element>& value,
+               JsonWriter* writer) {
+  writer->BeginObject();
+  for (typename std::map<std::string, Element>::const_iterator it =
+           value.begin();
+       it != value.end(); ++it) {
+    writer->Key(it->first);
+    WriteJson(it->second, writer);
+  }
+  writer->EndObject();
+}
+
+template <typename Value>
+void WriteJson(const JsonOptional<Value>& value, JsonWriter* writer) {
+  if (value.has_value()) {
+    WriteJson(value.value(), writer);
+  } else {
+    writer->Null();
+  }
+}
+
+template <typename Struct>
+bool ReadJson(JsonTokenizer* tokenizer, Struct* value, Error* error) {
+  PJCORE_CHECK(tokenizer);
+  PJCORE_CHECK(value);
+  *value = Struct();
+  PJCORE_CHECK(error);
+  error->Clear();
+
+  PJCORE_REQUIRE(tokenizer->token() == JsonTokenizer::TOKEN_BEGIN_OBJECT,
+                 "Object expected");
+
+  std::vector<bool> seen;
+  std::string name;
+
+  for (;;) {
+    PJCORE_REQUIRE_SILENT(tokenizer->Next(error), "Failed to read property");
+    if (tokenizer->token() == JsonTokenizer::TOKEN_END_OBJECT) {
+      return true;
+    }
+
+    name.swap(*tokenizer->mutable_string_value());
+    PJCORE_REQUIRE_SILENT(tokenizer->Next(error), "Failed to read value");
+
+    internal::JsonBindingReader binding_reader(name, tokenizer, &seen, error);
+    JsonBinding<Struct>::VisitFields(value, &binding_reader);
+
+    if (!binding_reader.found()) {
+      PJCORE_REQUIRE_SILENT(tokenizer->SkipValue(error),
+                            "Failed to skip value");
+    } else {
+      PJCORE_REQUIRE_SILENT(binding_reader.succeeded(),
+                            "Failed to read field " + name);
+    }
+  }
+}
+
+template <typename Element>
+bool ReadJson(JsonTokenizer* tokenizer, std::vector<Element>* value,
+              Error* error) {
+  PJCORE_CHECK(tokenizer);
+  PJCORE_CHECK(value);
+  value->clear();
+  PJCORE_CHECK(error);
+  error->Clear();
+
+  PJCORE_REQUIRE(tokenizer->token() == JsonTokenizer::TOKEN_BEGIN_ARRAY,
+                 "Array expected");
+
+  for (;;) {
+    PJCORE_REQUIRE_SILENT(tokenizer->Next(error), "Failed to read element");
+    if (tokenizer->token() == JsonTokenizer::TOKEN_END_ARRAY) {
+      return true;
+    }
+
+    value->push_back(Element());
+    PJCORE_REQUIRE_SILENT(ReadJson(tokenizer, &value->back(), error),
+                          "Failed to read element");
+  }
+}
+
+template <typename Element>
+bool ReadJson(JsonTokenizer* tokenizer,
+              std::map<std::string, Element>* value, Error* error) {
+  PJCORE_CHECK(tokenizer);
+  PJCORE_CHECK(value);
+  value->clear();
+  PJCORE_CHECK(error);
+  error->Clear();
+
+  PJCORE_REQUIRE(tokenizer->token() == JsonTokenizer::TOKEN_BEGIN_OBJECT,
+                 "Object expected");
+
+  std::string name;
+
+  for (;;) {
+    PJCORE_REQUIRE_SILENT(tokenizer->Next(error), "Failed to read property");
+    if (tokenizer->token() == JsonTokenizer::TOKEN_END_OBJECT) {
+      return true;
+    }
+
+    name.swap(*tokenizer->mutable_string_value());
+    PJCORE_REQUIRE_SILENT(tokenizer->Next(error), "Failed to read value");
+
+    std::pair<typename std::map<std::string, Element>::iterator, bool>
+        inserted = value->insert(std::make_pair(name, Element()));
+    if (!inserted.second && !tokenizer->config().properties_as_is()) {
+      PJCORE_REQUIRE_SILENT(tokenizer->SkipValue(error),
+                            "Failed to skip value");
+      continue;
+    }
+
+    PJCORE_REQUIRE_SILENT(ReadJson(tokenizer, &inserted.first->second, error),
+                          "Failed to read value of " + name);
+  }
+}
+
+template <typename Value>
+bool ReadJson(JsonTokenizer* tokenizer, JsonOptional<Value>* value,
+              Error* error) {
+  PJCORE_CHECK(tokenizer);
+  PJCORE_CHECK(value);
+  value->Clear();
+  PJCORE_CHECK(error);
+  error->Clear();
+
+  if (tokenizer->token() == JsonTokenizer::TOKEN_NULL) {
+    return true;
+  }
+
+  if (!ReadJson(tokenizer, value->mutable_value(), error)) {
+    value->Clear();
+    PJCORE_FAIL_SILENT("Failed to read optional value");
+  }
+
+  return true;
+}
+
+}  // namespace pjcore
+
+#endif  // PJCORE_JSON_BINDING_H_
@@ -0,0 +1,78 @@
+// JSON [de]serialization for protobuf + embedded HTTP server and client in C++.
+// Copyright (C) 2014 http://protojson.com/
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+
+#ifndef PJCORE_JSON_BODY_HANDLER_H_
+#define PJCORE_JSON_BODY_HANDLER_H_
+
+#include "pjcore/abstract_http_handler.h"
+#include "pjcore/json.pb.h"
+#include "pjcore/json_async.h"
+#include "pjcore/shared_uv_loop.h"
+
+namespace pjcore {
+
+typedef Callback<void(scoped_ptr<HttpRequest> request,
+                      scoped_ptr<JsonValue> body,
+                      const HttpResponseCallback& on_response)>
+    JsonBodyCallback;
+
+/**
+ * Parses the JSON content of each request with ReadJsonAsync, so that large
+ * bodies are parsed on the thread pool and don't hold up other connections
+ * of the loop, then passes the request and its parsed body to callback. A
+ * request without content gets a NULL body; one whose content fails to parse
+ * gets a 400 Bad Request response without reaching callback.
+ */
+class JsonBodyHttpHandler : public AbstractHttpHandler {
+ public:
+  JsonBodyHttpHandler(
+      LiveCapturableList* live_list, const SharedUvLoop& shared_loop,
+      const JsonBodyCallback& callback,
+      const JsonReaderConfig& config = JsonReaderConfig::default_instance(),
+      size_t min_async_size = kDefaultMinAsyncJsonSize);
+
+  void AsyncHandle(scoped_ptr<HttpRequest> request,
+                   const HttpResponseCallback& on_response) OVERRIDE;
+
+ protected:
+  ~JsonBodyHttpHandler();
+
+  scoped_ptr<google::protobuf::Message> CaptureLive() const OVERRIDE;
+
+ private:
+  friend class RefCounted<JsonBodyHttpHandler>;
+
+  static void OnBody(const JsonBodyCallback& callback,
+                     scoped_ptr<HttpRequest> request,
+                     const HttpResponseCallback& on_response,
+                     scoped_ptr<JsonValue> body, const Error& error);
+
+  SharedUvLoop shared_loop_;
+
+  JsonBodyCallback callback_;
+
+  JsonReaderConfig config_;
+
+  size_t min_async_size_;
+};
+
+typedef scoped_refptr<JsonBodyHttpHandler> SharedJsonBodyHttpHandler;
+
+}  // namespace pjcore
+
+#endif  // PJCORE_JSON_BODY_HANDLER_H_
@@ -0,0 +1,162 @@
+// JSON [de]serialization for protobuf + embedded HTTP server and client in C++.
+// Copyright (C) 2014 http://protojson.com/
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+
+#ifndef PJCORE_JSON_CODEC_H_
+#define PJCORE_JSON_CODEC_H_
+
+#include <string>
+#include <vector>
+
+#include "pjcore/third_party/chromium/string_piece.h"
+
+#include "pjcore/error.pb.h"
+#include "pjcore/json.pb.h"
+#include "pjcore/json_field_mask.h"
+#include "pjcore/json_reader.h"
+#include "pjcore/json_tokenizer.h"
+#include "pjcore/json_writer.h"
+#include "pjcore/logging.h"
+#include "pjcore/make_json_value.h"
+#include "pjcore/unbox_json_value.h"
+
+namespace pjcore {
+
+// protoc-gen-pjcore emits, next to each message type Message,
+//
+//   void WriteJson(const Message& message, JsonWriter* writer,
+//                  const JsonFieldMask* mask = NULL);
+//
+//   bool ReadJson(JsonTokenizer* tokenizer, Message* message, Error* error,
+//                 google::protobuf::RepeatedPtrField<JsonValue::Property>*
+//                     unknown_object_properties = NULL);
+//
+// which follow the mapping of MakeJsonValue and UnboxJsonValue without
+// reflection. The templates below drive them from and to JSON text.
+
+template <typename Message>
+void WriteGeneratedJson(
+    const Message& message, std::string* output,
+    const JsonWriterConfig& config = JsonWriterConfig::default_instance()) {
+  JsonWriter writer(output, config);
+  WriteJson(message, &writer);
+}
+
+template <typename Message>
+std::string WriteGeneratedJson(
+    const Message& message,
+    const JsonWriterConfig& config = JsonWriterConfig::default_instance()) {
+  std::string output;
+  WriteGeneratedJson(message, &output, config);
+  return output;
+}
+
+template <typename Message>
+void WriteGeneratedJson(
+    const Message& message, const JsonFieldMask& mask, std::string* output,
+    const JsonWriterConfig& config = JsonWriterConfig::default_instance()) {
+  JsonWriter writer(output, config);
+  WriteJson(message, &writer, mask.selects_all() ? NULL : &mask);
+}
+
+template <typename Message>
+std::string WriteGeneratedJson(
+    const Message& message, const JsonFieldMask& mask,
+    const JsonWriterConfig& config = JsonWriterConfig::default_instance()) {
+  std::string output;
+  WriteGeneratedJson(message, mask, &output, config);
+  return output;
+}
+
+template <typename Message>
+bool ReadGeneratedJson(
+    StringPiece str, Message* message, Error* error,
+    const JsonReaderConfig& config = JsonReaderConfig::default_instance(),
+    google::protobuf::RepeatedPtrField<JsonValue::Property>*
+        unknown_object_properties = NULL) {
+  PJCORE_CHECK(message);
+  message->Clear();
+  PJCORE_CHECK(error);
+  error->Clear();
+
+  JsonTokenizer tokenizer(str, config);
+
+  PJCORE_REQUIRE_CAUSE(
+      tokenizer.Next(error) &&
+          ReadJson(&tokenizer, message, error, unknown_object_properties) &&
+          tokenizer.Next(error),
+      "Failed to parse JSON string");
+
+  return true;
+}
+
+// Helpers called by generated code.
+
+// Reads an enum number from a string or a number, setting has_number to false
+// for strings that are neither, which UnboxJsonValue ignores.
+bool UnboxJsonEnumNumber(const JsonTokenizer& tokenizer, int32_t* number,
+                         bool* has_number, Error* error);
+
+bool UnboxJsonEnumNumber(const JsonValue& json_value, int32_t* number,
+                         bool* has_number, Error* error);
+
+// Takes the string at the current token instead of copying it.
+bool UnboxJsonString(JsonTokenizer* tokenizer, std::string* string_value,
+                     Error* error);
+
+bool UnboxJsonBytes(const JsonTokenizer& tokenizer, std::string* bytes,
+                    Error* error);
+
+bool UnboxJsonBytes(const JsonValue& json_value, std::string* bytes,
+                    Error* error);
+
+void WriteJsonBytes(StringPiece bytes, JsonWriter* writer);
+
+// Reads a message whose type has no generated codec through reflection.
+bool ReadJsonMessage(JsonTokenizer* tokenizer,
+                     google::protobuf::Message* message, Error* error,
+                     google::protobuf::RepeatedPtrField<JsonValue::Property>*
+                         unknown_object_properties);
+
+// Appends a property named name, taken, with the value at the current token.
+bool ReadJsonProperty(
+    JsonTokenizer* tokenizer, std::string* name,
+    google::protobuf::RepeatedPtrField<JsonValue::Property>* properties,
+    Error* error);
+
+// Orders properties as ReadJson does for object_properties.
+void SortJsonProperties(
+    const JsonReaderConfig& config,
+    google::protobuf::RepeatedPtrField<JsonValue::Property>* properties);
+
+// Sorts consumed_properties and moves them to unknown_object_properties.
+void AppendUnknownJsonProperties(
+    const JsonReaderConfig& config,
+    google::protobuf::RepeatedPtrField<JsonValue::Property>*
+        consumed_properties,
+    google::protobuf::RepeatedPtrField<JsonValue::Property>*
+        unknown_object_properties);
+
+// Computes the indices of the names that survive in the order ReadJson would
+// leave the corresponding properties.
+void OrderJsonNames(const JsonReaderConfig& config,
+                    const std::vector<std::string>& names,
+                    std::vector<size_t>* order);
+
+}  // namespace pjcore
+
+#endif  // PJCORE_JSON_CODEC_H_
@@ -0,0 +1,103 @@
+// JSON [de]serialization for protobuf + embedded HTTP server and client in C++.
+// Copyright (C) 2014 http://protojson.com/
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+
+#ifndef PJCORE_JSON_DELTA_HANDLER_H_
+#define PJCORE_JSON_DELTA_HANDLER_H_
+
+#include <deque>
+#include <string>
+
+#include "pjcore/abstract_http_handler.h"
+#include "pjcore/json.pb.h"
+
+namespace pjcore {
+
+const size_t kDefaultMaxJsonDeltaVersions = 16;
+
+/**
+ * Serves a versioned JSON document, answering conditional requests with
+ * JSON Patch deltas as in RFC 3229. Each response carries an ETag of the
+ * document version and a hash of its content, so tags issued by another
+ * instance never name the wrong document. A request whose If-None-Match
+ * names the current version gets 304 Not Modified. One that asks for deltas
+ * with A-IM: json-patch or Accept: application/json-patch+json and names a
+ * retained older version gets 226 IM Used with an uncacheable
+ * application/json-patch+json body. Any other request gets the full document.
+ */
+class JsonDeltaHttpHandler : public AbstractHttpHandler {
+ public:
+  JsonDeltaHttpHandler(LiveCapturableList* live_list,
+                       const JsonValue& document,
+                       size_t max_versions = kDefaultMaxJsonDeltaVersions);
+
+  uint64_t version() const { return versions_.back().version; }
+
+  const JsonValue& document() const { return versions_.back().document; }
+
+  size_t max_versions() const { return max_versions_; }
+
+  // Publishes a new version unless document equals the current one.
+  void Update(const JsonValue& document);
+
+  void MakeResponse(const HttpRequest& request, HttpResponse* response);
+
+  void AsyncHandle(scoped_ptr<HttpRequest> request,
+                   const HttpResponseCallback& on_response) OVERRIDE;
+
+ protected:
+  ~JsonDeltaHttpHandler();
+
+  scoped_ptr<google::protobuf::Message> CaptureLive() const OVERRIDE;
+
+ private:
+  friend class RefCounted<JsonDeltaHttpHandler>;
+
+  struct Version {
+    Version() : version(0), has_patch_content(false) {}
+
+    uint64_t version;
+
+    JsonValue document;
+
+    // Quoted version and content hash.
+    std::string entity_tag;
+
+    // Serialized patch to the current version, computed on first use.
+    std::string patch_content;
+
+    bool has_patch_content;
+  };
+
+  void PublishDocument();
+
+  Version* FindBaseVersion(const HttpRequest& request);
+
+  const std::string& GetPatchContent(Version* base);
+
+  size_t max_versions_;
+
+  std::deque<Version> versions_;
+
+  std::string document_content_;
+};
+
+typedef scoped_refptr<JsonDeltaHttpHandler> SharedJsonDeltaHttpHandler;
+
+}  // namespace pjcore
+
+#endif  // PJCORE_JSON_DELTA_HANDLER_H_
@@ -0,0 +1,88 @@
+// JSON [de]serialization for protobuf + embedded HTTP server and client in C++.
+// Copyright (C) 2014 http://protojson.com/
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+
+#ifndef PJCORE_JSON_DOCUMENT_H_
+#define PJCORE_JSON_DOCUMENT_H_
+
+#include <string>
+#include <vector>
+
+#include "pjcore/third_party/chromium/macros.h"
+#include "pjcore/third_party/chromium/scoped_ptr.h"
+#include "pjcore/third_party/chromium/string_piece.h"
+
+#include "pjcore/error.pb.h"
+#include "pjcore/json.pb.h"
+
+namespace pjcore {
+
+/**
+ * JSON value that keeps the text WriteJson produces for it and for each of
+ * its nested values. Changes go through MutableValue and RemoveValue, which
+ * drop the text of the changed value and of its containers only, so that
+ * after a small change GetJson rewrites the path to it and copies the rest.
+ */
+class JsonDocument {
+ public:
+  explicit JsonDocument(
+      const JsonWriterConfig& config = JsonWriterConfig::default_instance());
+
+  ~JsonDocument();
+
+  const JsonWriterConfig& config() const { return config_; }
+
+  const JsonValue& value() const { return value_; }
+
+  // Returns the value at an RFC 6901 JSON Pointer for changing, or NULL when
+  // the pointer does not resolve. A missing last property is added as null,
+  // in name order, and a last "-" appends a null array element. The pointer
+  // is invalid after the next GetJson, MutableValue or RemoveValue call.
+  // Objects stored through it must have their properties in name order
+  // without duplicates, as NormalizeJsonProperties leaves them, since
+  // properties are looked up by binary search.
+  JsonValue* MutableValue(StringPiece json_pointer, Error* error);
+
+  // Removes the property or array element at json_pointer.
+  bool RemoveValue(StringPiece json_pointer, Error* error);
+
+  // Equals WriteJson(value(), config()).
+  const std::string& GetJson();
+
+ private:
+  struct Node;
+
+  JsonValue* FindParent(const std::vector<std::string>& tokens, Node** node,
+                        Error* error);
+
+  void WriteNode(const JsonValue& value, size_t depth, size_t old_begin,
+                 Node* node, std::string* json);
+
+  JsonWriterConfig config_;
+
+  JsonValue value_;
+
+  scoped_ptr<Node> root_;
+
+  std::string json_;
+
+  DISALLOW_COPY_AND_ASSIGN(JsonDocument);
+};
+
+}  // namespace pjcore
+
+#endif  // PJCORE_JSON_DOCUMENT_H_
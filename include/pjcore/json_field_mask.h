@@ -0,0 +1,79 @@
+// JSON [de]serialization for protobuf + embedded HTTP server and client in C++.
+// Copyright (C) 2014 http://protojson.com/
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+
+#ifndef PJCORE_JSON_FIELD_MASK_H_
+#define PJCORE_JSON_FIELD_MASK_H_
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "pjcore/third_party/chromium/macros.h"
+#include "pjcore/third_party/chromium/string_piece.h"
+
+namespace pjcore {
+
+/**
+ * Tree of dotted field paths, such as "optional_message.optional_int32",
+ * selecting which fields are converted between messages and JSON. A mask
+ * without paths, like a path ending at a field, selects everything below it.
+ */
+class JsonFieldMask {
+ public:
+  JsonFieldMask();
+
+  // Adds the comma-separated paths, as in the JSON form of
+  // google.protobuf.FieldMask.
+  explicit JsonFieldMask(StringPiece paths);
+
+  ~JsonFieldMask();
+
+  void AddPath(StringPiece path);
+
+  bool selects_all() const { return children_.empty(); }
+
+  // Returns the mask for the value of the field named name, or NULL when the
+  // field is not selected.
+  const JsonFieldMask* Find(StringPiece name) const;
+
+ private:
+  typedef std::vector<std::pair<std::string, JsonFieldMask*> > ChildList;
+
+  void Clear();
+
+  ChildList children_;
+
+  DISALLOW_COPY_AND_ASSIGN(JsonFieldMask);
+};
+
+// Returns whether mask, where NULL selects everything, selects the field named
+// name, setting field_mask to the mask for its value.
+inline bool SelectJsonField(const JsonFieldMask* mask, StringPiece name,
+                            const JsonFieldMask** field_mask) {
+  if (!mask) {
+    *field_mask = NULL;
+    return true;
+  }
+
+  *field_mask = mask->Find(name);
+  return *field_mask != NULL;
+}
+
+}  // namespace pjcore
+
+#endif  // PJCORE_JSON_FIELD_MASK_H_
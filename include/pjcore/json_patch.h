@@ -0,0 +1,68 @@
+// JSON [de]serialization for protobuf + embedded HTTP server and client in C++.
+// Copyright (C) 2014 http://protojson.com/
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+
+#ifndef PJCORE_JSON_PATCH_H_
+#define PJCORE_JSON_PATCH_H_
+
+#include <string>
+#include <vector>
+
+#include "pjcore/third_party/chromium/string_piece.h"
+
+#include "pjcore/error.pb.h"
+#include "pjcore/json.pb.h"
+
+namespace pjcore {
+
+// Arrays whose differing middle parts exceed this many element pairs are
+// diffed position by position instead of by edit distance.
+const size_t kDefaultMaxJsonArrayDiffCells = 1 << 20;
+
+// Returns an RFC 6902 JSON Patch turning from into to. Objects with
+// normalized properties are diffed in linear time; others are normalized
+// first.
+JsonValue MakeJsonPatch(
+    const JsonValue& from, const JsonValue& to,
+    size_t max_array_diff_cells = kDefaultMaxJsonArrayDiffCells);
+
+// Applies an RFC 6902 JSON Patch in place. On failure target is left with
+// the operations preceding the failing one applied.
+bool ApplyJsonPatch(const JsonValue& patch, JsonValue* target, Error* error);
+
+// Returns an RFC 7386 Merge Patch turning from into to. Merge patches cannot
+// set properties to null, so such properties are removed instead.
+JsonValue MakeJsonMergePatch(const JsonValue& from, const JsonValue& to);
+
+void ApplyJsonMergePatch(const JsonValue& patch, JsonValue* target);
+
+// Appends an RFC 6901 JSON Pointer reference token, escaping '~' and '/'.
+void AppendJsonPointerToken(StringPiece token, std::string* json_pointer);
+
+// Splits an RFC 6901 JSON Pointer into unescaped reference tokens; the empty
+// pointer, referring to the whole value, has none.
+bool ParseJsonPointer(StringPiece json_pointer,
+                      std::vector<std::string>* tokens, Error* error);
+
+// Reads an array index no greater than max_index; "-" stands for max_index
+// when allow_end.
+bool ReadJsonPointerIndex(const std::string& token, int max_index,
+                          bool allow_end, int* index, Error* error);
+
+}  // namespace pjcore
+
+#endif  // PJCORE_JSON_PATCH_H_
@@ -18,8 +18,11 @@
 #ifndef PJCORE_JSON_PROPERTIES_H_
 #define PJCORE_JSON_PROPERTIES_H_
 
+#include <map>
 #include <string>
+#include <vector>
 
+#include "pjcore/third_party/chromium/macros.h"
 #include "pjcore/third_party/chromium/string_piece.h"
 
 #include "pjcore/json.pb.h"
@@ -103,6 +106,66 @@ void ClearJsonProperty(WithJsonProperties* mutable_object_value,
   ClearJsonProperty(mutable_object_value->mutable_object_properties(), name);
 }
 
+// Removes the properties with any of names in a single pass, keeping the order
+// of the rest.
+void ClearJsonProperties(JsonPropertyList* mutable_properties,
+                         const std::vector<std::string>& names);
+
+void ClearJsonProperties(JsonValue* mutable_object_value,
+                         const std::vector<std::string>& names);
+
+template <typename WithJsonProperties>
+void ClearJsonProperties(WithJsonProperties* mutable_object_value,
+                         const std::vector<std::string>& names) {
+  ClearJsonProperties(mutable_object_value->mutable_object_properties(),
+                      names);
+}
+
+/**
+ * Batch edit of object properties. SetJsonProperty and ClearJsonProperty scan
+ * the whole list on each call, so n of them cost O(n^2); Set() here appends
+ * and Clear() records the name, and Commit(), also run on destruction, sorts
+ * once and leaves the properties normalized, each name holding the value it
+ * was last set to. Properties with leading names instead come first, in the
+ * order of those names, ahead of the normalized rest.
+ */
+class JsonPropertyBuilder {
+ public:
+  explicit JsonPropertyBuilder(JsonPropertyList* mutable_properties);
+
+  explicit JsonPropertyBuilder(JsonValue* mutable_object_value);
+
+  JsonPropertyBuilder(JsonValue* mutable_object_value,
+                      const char* const* leading_names_begin,
+                      const char* const* leading_names_end);
+
+  ~JsonPropertyBuilder();
+
+  // Appends a property and returns its value, valid until Commit().
+  JsonValue* Add(StringPiece name);
+
+  template <typename Value>
+  void Set(StringPiece name, const Value& value) {
+    *Add(name) = MakeJsonValue(value);
+  }
+
+  // Removes the properties named name present or added so far.
+  void Clear(StringPiece name);
+
+  void Commit();
+
+ private:
+  JsonPropertyList* properties_;
+
+  const char* const* leading_names_begin_;
+  const char* const* leading_names_end_;
+
+  // Property count at the last Clear() of each name.
+  std::map<std::string, int> cleared_;
+
+  DISALLOW_COPY_AND_ASSIGN(JsonPropertyBuilder);
+};
+
 }  // namespace pjcore
 
 #endif  // PJCORE_JSON_PROPERTIES_H_
@@ -25,10 +25,16 @@
 
 namespace pjcore {
 
+class JsonTokenizer;
+
 bool ReadJson(
     StringPiece str, JsonValue* value, Error* error,
     const JsonReaderConfig& config = JsonReaderConfig::default_instance());
 
+// Reads the value starting at the current token, leaving the tokenizer at its
+// last token.
+bool ReadJson(JsonTokenizer* tokenizer, JsonValue* value, Error* error);
+
 }  // namespace pjcore
 
 #endif  // PJCORE_JSON_READER_H_
@@ -0,0 +1,144 @@
+// JSON [de]serialization for protobuf + embedded HTTP server and client in C++.
+// Copyright (C) 2014 http://protojson.com/
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+
+#ifndef PJCORE_JSON_SNAPSHOT_H_
+#define PJCORE_JSON_SNAPSHOT_H_
+
+#include <string>
+
+#include "pjcore/third_party/chromium/macros.h"
+#include "pjcore/third_party/chromium/string_piece.h"
+
+#include "pjcore/error.pb.h"
+#include "pjcore/json.pb.h"
+
+namespace pjcore {
+
+/**
+ * Compiles value into a snapshot: a flat image holding objects and arrays as
+ * tables of 64-bit references, object properties sorted by name, and every
+ * distinct string once. Snapshots are read in place by JsonSnapshot and use
+ * the byte order of the writing host. Duplicate property names keep the last
+ * value, as ReadJson does.
+ */
+void WriteJsonSnapshot(const JsonValue& value, std::string* snapshot);
+
+bool WriteJsonSnapshotFile(const JsonValue& value, const std::string& path,
+                           Error* error);
+
+/**
+ * Read-only view of a value within a snapshot, valid while the snapshot is.
+ * Accessors mirror JsonValue, returning defaults for mismatched types.
+ */
+class JsonSnapshotValue {
+ public:
+  JsonSnapshotValue() : data_(NULL), size_(0), ref_(0) {}
+
+  JsonValue::Type type() const;
+
+  bool bool_value() const;
+
+  int64_t signed_value() const;
+
+  uint64_t unsigned_value() const;
+
+  double double_value() const;
+
+  StringPiece string_value() const;
+
+  // Properties come in name order.
+  int object_properties_size() const;
+
+  StringPiece object_property_name(int index) const;
+
+  JsonSnapshotValue object_property_value(int index) const;
+
+  // Binary search by name; a missing property reads as null.
+  bool HasProperty(StringPiece name) const;
+
+  JsonSnapshotValue GetProperty(StringPiece name) const;
+
+  int array_elements_size() const;
+
+  JsonSnapshotValue array_elements(int index) const;
+
+ private:
+  friend class JsonSnapshot;
+
+  JsonSnapshotValue(const char* data, uint64_t size, uint64_t ref)
+      : data_(data), size_(size), ref_(ref) {}
+
+  uint64_t offset() const;
+
+  // Words out of bounds read as 0.
+  uint64_t ReadWord(uint64_t offset) const;
+
+  // Strings and tables out of bounds read as empty.
+  StringPiece ReadString(uint64_t offset) const;
+
+  int ReadCount(uint64_t entry_size) const;
+
+  int FindProperty(StringPiece name) const;
+
+  const char* data_;
+
+  uint64_t size_;
+
+  uint64_t ref_;
+};
+
+JsonValue MakeJsonValue(const JsonSnapshotValue& snapshot_value);
+
+/**
+ * Snapshot mapped from a file or attached to memory. The header is checked
+ * on attaching and every offset as it is read, so the values of a truncated
+ * or corrupt snapshot read as defaults instead of out of bounds.
+ */
+class JsonSnapshot {
+ public:
+  JsonSnapshot();
+
+  ~JsonSnapshot();
+
+  // Maps the file read-only, so its pages are shared between processes.
+  bool Open(const std::string& path, Error* error);
+
+  // data must outlive the snapshot.
+  bool Attach(StringPiece data, Error* error);
+
+  void Close();
+
+  bool is_open() const { return data_ != NULL; }
+
+  JsonSnapshotValue root() const;
+
+ private:
+  const char* data_;
+
+  size_t size_;
+
+  void* mapping_;
+
+  size_t mapping_size_;
+
+  DISALLOW_COPY_AND_ASSIGN(JsonSnapshot);
+};
+
+}  // namespace pjcore
+
+#endif  // PJCORE_JSON_SNAPSHOT_H_
@@ -0,0 +1,167 @@
+// JSON [de]serialization for protobuf + embedded HTTP server and client in C++.
+// Copyright (C) 2014 http://protojson.com/
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+#ifndef PJCORE_JSON_TOKENIZER_H_
+#define PJCORE_JSON_TOKENIZER_H_
+
+#include <string>
+#include <vector>
+
+#include "pjcore/third_party/chromium/macros.h"
+#include "pjcore/third_party/chromium/string_piece.h"
+
+#include "pjcore/error.pb.h"
+#include "pjcore/json.pb.h"
+
+namespace pjcore {
+
+/**
+ * Pull parser reading JSON text one token at a time, with the same syntax and
+ * error locations as ReadJson. Scalar tokens expose the accessors of JsonValue
+ * so that code written against one works with the other.
+ */
+class JsonTokenizer {
+ public:
+  enum Token {
+    TOKEN_NONE,
+    TOKEN_BEGIN_OBJECT,
+    TOKEN_END_OBJECT,
+    TOKEN_BEGIN_ARRAY,
+    TOKEN_END_ARRAY,
+    TOKEN_NAME,
+    TOKEN_NULL,
+    TOKEN_BOOL,
+    TOKEN_SIGNED,
+    TOKEN_UNSIGNED,
+    TOKEN_DOUBLE,
+    TOKEN_RAW_NUMBER,
+    TOKEN_STRING,
+    TOKEN_END
+  };
+
+  // config must outlive the tokenizer.
+  explicit JsonTokenizer(
+      StringPiece str,
+      const JsonReaderConfig& config = JsonReaderConfig::default_instance());
+
+  ~JsonTokenizer();
+
+  const JsonReaderConfig& config() const { return config_; }
+
+  const TextLocation& location() const { return location_; }
+
+  // Number of objects and arrays enclosing the current token.
+  size_t depth() const { return frames_.size(); }
+
+  // Reads the next token, on failure recording its location in error.
+  bool Next(Error* error);
+
+  // Reads past the end of the value starting at the current token.
+  bool SkipValue(Error* error);
+
+  Token token() const { return token_; }
+
+  // JsonValue::Type of the value starting at the current token.
+  JsonValue::Type type() const;
+
+  bool bool_value() const { return bool_value_; }
+
+  int64_t signed_value() const { return signed_value_; }
+
+  uint64_t unsigned_value() const { return unsigned_value_; }
+
+  double double_value() const { return double_value_; }
+
+  // Property name for TOKEN_NAME, value for TOKEN_STRING or number text for
+  // TOKEN_RAW_NUMBER.
+  const std::string& string_value() const { return string_value_; }
+
+  std::string* mutable_string_value() { return &string_value_; }
+
+ private:
+  enum State {
+    STATE_BEGIN,
+    STATE_VALUE,
+    STATE_NAME,
+    STATE_AFTER_VALUE,
+    STATE_END
+  };
+
+  struct Frame {
+    explicit Frame(bool an_is_object) : is_object(an_is_object), size(0) {}
+
+    bool is_object;
+
+    size_t size;
+  };
+
+  bool InternalNext(Error* error);
+
+  bool ReadByteOrderMark(Error* error);
+
+  bool ReadValue(Error* error);
+
+  bool ReadNumber(Error* error);
+
+  bool ReadRawNumber();
+
+  void AdvanceOne();
+
+  void Advance(size_t count);
+
+  bool ReadHexDigit(uint32_t* hex_digit, Error* error);
+
+  bool ReadHexDigits(size_t count, uint32_t* value, Error* error);
+
+  bool ReadChar(char expected, Error* error);
+
+  void ReadWhitespace();
+
+  bool ReadComment(Error* error);
+
+  bool ReadWhitespaceAndComments(Error* error);
+
+  bool ReadString(std::string* str, Error* error);
+
+  const JsonReaderConfig& config_;
+
+  TextLocation location_;
+
+  StringPiece remaining_;
+
+  State state_;
+
+  std::vector<Frame> frames_;
+
+  Token token_;
+
+  bool bool_value_;
+
+  int64_t signed_value_;
+
+  uint64_t unsigned_value_;
+
+  double double_value_;
+
+  std::string string_value_;
+
+  DISALLOW_COPY_AND_ASSIGN(JsonTokenizer);
+};
+
+}  // namespace pjcore
+
+#endif  // PJCORE_JSON_TOKENIZER_H_
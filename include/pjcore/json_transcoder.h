@@ -0,0 +1,62 @@
+// JSON [de]serialization for protobuf + embedded HTTP server and client in C++.
+// Copyright (C) 2014 http://protojson.com/
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+
+#ifndef PJCORE_JSON_TRANSCODER_H_
+#define PJCORE_JSON_TRANSCODER_H_
+
+#include <string>
+
+#include "google/protobuf/descriptor.h"
+
+#include "pjcore/third_party/chromium/string_piece.h"
+
+#include "pjcore/error.pb.h"
+#include "pjcore/json.pb.h"
+#include "pjcore/json_tokenizer.h"
+#include "pjcore/json_writer.h"
+
+namespace pjcore {
+
+// Appends to output the JSON that WriteJson(MakeJsonValue(message)) would
+// produce for the message of type descriptor serialized as wire, without
+// parsing it into a message. On failure output is left unspecified.
+bool TranscodeWireToJson(
+    StringPiece wire, const google::protobuf::Descriptor& descriptor,
+    std::string* output, Error* error,
+    const JsonWriterConfig& config = JsonWriterConfig::default_instance());
+
+bool TranscodeWireToJson(StringPiece wire,
+                         const google::protobuf::Descriptor& descriptor,
+                         JsonWriter* writer, Error* error);
+
+// Appends to wire the serialization of the message of type descriptor that
+// UnboxJsonValue would read from json, without building a JsonValue or a
+// message. On failure wire is left unspecified.
+bool TranscodeJsonToWire(
+    StringPiece json, const google::protobuf::Descriptor& descriptor,
+    std::string* wire, Error* error,
+    const JsonReaderConfig& config = JsonReaderConfig::default_instance());
+
+// Same as above, for the value starting at the current token.
+bool TranscodeJsonToWire(JsonTokenizer* tokenizer,
+                         const google::protobuf::Descriptor& descriptor,
+                         std::string* wire, Error* error);
+
+}  // namespace pjcore
+
+#endif  // PJCORE_JSON_TRANSCODER_H_
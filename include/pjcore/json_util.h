@@ -32,6 +32,37 @@ bool VerifyJsonType(const JsonValue& value, std::string* error);
 
 bool IsJsonNumber(const JsonValue& value);
 
+// TYPE_RAW_NUMBER values keep the JSON text of a number in string_value, as
+// read with raw_numbers in JsonReaderConfig.
+
+// Reads raw_number into the typed number ReadJson would have produced.
+bool ReadJsonRawNumber(StringPiece raw_number, JsonValue* number);
+
+// Returns value, or the number a TYPE_RAW_NUMBER value reads as, stored in
+// buffer.
+const JsonValue& ResolveJsonRawNumber(const JsonValue& value,
+                                      JsonValue* buffer);
+
+// Packed arrays keep elements that are numbers of the same type in
+// packed_signed_values, packed_unsigned_values or packed_double_values
+// instead of array_elements, at 8 bytes per element.
+
+bool IsPackedJsonArray(const JsonValue& value);
+
+// Counts the elements of an array, packed or not.
+int GetJsonArraySize(const JsonValue& value);
+
+// Returns the element at index of an array, stored in buffer when packed.
+const JsonValue& GetJsonArrayElement(const JsonValue& value, int index,
+                                     JsonValue* buffer);
+
+// Packs a non-empty array whose elements are numbers of the same type,
+// returning false and leaving other values unchanged.
+bool PackJsonArray(JsonValue* value);
+
+// Moves packed elements to array_elements, for code accessing them directly.
+void UnpackJsonArray(JsonValue* value);
+
 bool AreJsonValuesEqual(const JsonValue& left, const JsonValue& right,
                         std::string* optional_diff_path = NULL);
 
@@ -42,6 +73,25 @@ bool AreJsonValuesEqual(const LeftValue& left, const RightValue& right,
                             optional_diff_path);
 }
 
+// Structural hash, equal for identical values. Numbers that compare equal
+// hash alike whatever their types, and object properties hash alike in any
+// order.
+uint64_t HashJsonValue(const JsonValue& value);
+
+// Pieces of HashJsonValue for trees held outside JsonValue. An object hashes
+// as HashJsonObject of the sum of HashJsonObjectProperty over its properties.
+uint64_t HashJsonObjectProperty(StringPiece name, uint64_t value_hash);
+uint64_t HashJsonObject(int size, uint64_t property_hash_sum);
+uint64_t HashJsonArray(const uint64_t* element_hashes, int size);
+
+// Like AreJsonValuesEqual, but doubles must match exactly as HashJsonValue
+// requires.
+bool AreJsonValuesIdentical(const JsonValue& left, const JsonValue& right);
+
+// Rejects on mismatched HashJsonValue results before comparing deeply.
+bool AreJsonValuesIdentical(const JsonValue& left, uint64_t left_hash,
+                            const JsonValue& right, uint64_t right_hash);
+
 const std::string& GetRootJsonPath();
 void AppendJsonPathProperty(StringPiece property_name, std::string* json_path);
 void AppendJsonPathElement(int64_t element_index, std::string* json_path);
@@ -19,6 +19,11 @@
 #define PJCORE_JSON_WRITER_H_
 
 #include <string>
+#include <vector>
+
+#include "pjcore/third_party/chromium/macros.h"
+#include "pjcore/third_party/chromium/scoped_ptr.h"
+#include "pjcore/third_party/chromium/string_piece.h"
 
 #include "pjcore/json.pb.h"
 #include "pjcore/make_json_value.h"
@@ -38,6 +43,28 @@ std::string WriteJson(
   return WriteJson(MakeJsonValue(value), config);
 }
 
+void WriteJson(
+    const JsonValue& value, std::string* output,
+    const JsonWriterConfig& config = JsonWriterConfig::default_instance());
+
+template <typename Value>
+void WriteJson(
+    const Value& value, std::string* output,
+    const JsonWriterConfig& config = JsonWriterConfig::default_instance()) {
+  WriteJson(MakeJsonValue(value), output, config);
+}
+
+size_t ComputeJsonSize(
+    const JsonValue& value,
+    const JsonWriterConfig& config = JsonWriterConfig::default_instance());
+
+template <typename Value>
+size_t ComputeJsonSize(
+    const Value& value,
+    const JsonWriterConfig& config = JsonWriterConfig::default_instance()) {
+  return ComputeJsonSize(MakeJsonValue(value), config);
+}
+
 std::string WritePrettyJson(const JsonValue& value);
 
 template <typename Value>
@@ -45,6 +72,246 @@ std::string WritePrettyJson(const Value& value) {
   return WritePrettyJson(MakeJsonValue(value));
 }
 
+/**
+ * Produces the text of WriteJson a step at a time, so that writing a large
+ * value can be interleaved with other work on the same thread. value and
+ * config must outlive the writer and stay unchanged while it writes.
+ */
+class ResumableJsonWriter {
+ public:
+  explicit ResumableJsonWriter(
+      const JsonValue& value,
+      const JsonWriterConfig& config = JsonWriterConfig::default_instance());
+
+  ~ResumableJsonWriter();
+
+  bool done() const { return done_; }
+
+  // Appends whole values to output until it grows by at least step_size bytes
+  // or the text is complete, and returns done().
+  bool Step(size_t step_size, std::string* output);
+
+ private:
+  struct State;
+
+  scoped_ptr<State> state_;
+
+  bool begun_;
+
+  bool done_;
+
+  DISALLOW_COPY_AND_ASSIGN(ResumableJsonWriter);
+};
+
+const size_t kJsonWriterSinkChunkSize = 4096;
+
+/**
+ * Destination of JsonWriter output other than a string.
+ */
+class JsonWriterSink {
+ public:
+  virtual ~JsonWriterSink() {}
+
+  virtual void Append(StringPiece chunk) = 0;
+};
+
+/**
+ * Push writer producing the same text as WriteJson without building a
+ * JsonValue. Object members are written as Key() followed by one value.
+ * Calls out of nesting order fail assertions in a debug build (without
+ * NDEBUG defined).
+ */
+class JsonWriter {
+ public:
+  // config must outlive the writer.
+  explicit JsonWriter(
+      std::string* output,
+      const JsonWriterConfig& config = JsonWriterConfig::default_instance());
+
+  // sink and config must outlive the writer, which passes output on in
+  // chunks of about kJsonWriterSinkChunkSize bytes, the rest on Flush() or
+  // destruction.
+  explicit JsonWriter(
+      JsonWriterSink* sink,
+      const JsonWriterConfig& config = JsonWriterConfig::default_instance());
+
+  ~JsonWriter();
+
+  const JsonWriterConfig& config() const { return config_; }
+
+  // Passes buffered output on to the sink, if any.
+  void Flush();
+
+  void BeginObject();
+
+  void EndObject();
+
+  void BeginArray();
+
+  void EndArray();
+
+  void Key(StringPiece name);
+
+  void Null();
+
+  void Value(bool bool_value);
+
+  void Value(int32_t signed_value);
+
+  void Value(int64_t signed_value);
+
+#ifdef PJCORE_DISTINCT_LONG_LONG
+  void Value(long long int signed_value);  // NOLINT(runtime/int)
+#endif  // PJCORE_DISTINCT_LONG_LONG
+
+  void Value(uint32_t unsigned_value);
+
+  void Value(uint64_t unsigned_value);
+
+#ifdef PJCORE_DISTINCT_LONG_LONG
+  void Value(long long unsigned int unsigned_value);  // NOLINT(runtime/int)
+#endif  // PJCORE_DISTINCT_LONG_LONG
+
+  void Value(float double_value);
+
+  void Value(double double_value);
+
+  void Value(const char* string_value);
+
+  void Value(StringPiece string_value);
+
+  void Value(const JsonValue& value);
+
+ private:
+  struct Frame {
+    explicit Frame(bool an_is_object)
+        : is_object(an_is_object), size(0), has_key(false) {}
+
+    bool is_object;
+
+    size_t size;
+
+    // Whether Key() awaits its value, for nesting assertions.
+    bool has_key;
+  };
+
+  void Init();
+
+  void MaybeFlush();
+
+  void BeginMember();
+
+  void BeginValue();
+
+  void BeginContainer(bool is_object);
+
+  void EndContainer(char close);
+
+  const JsonWriterConfig& config_;
+
+  JsonWriterSink* sink_;
+
+  std::string buffer_;
+
+  std::string* output_;
+
+  std::vector<Frame> frames_;
+
+  // Whether a top-level value was begun, for nesting assertions.
+  bool has_root_;
+
+  std::string newline_indent_;
+
+  DISALLOW_COPY_AND_ASSIGN(JsonWriter);
+};
+
+// Writes value as WriteJson(value) would, without a JsonValue for strings and
+// numbers. WriteJsonObject and WriteJsonArray write their arguments this way.
+template <typename Value>
+void WriteJsonValue(const Value& value, JsonWriter* writer) {
+  writer->Value(MakeJsonValue(value));
+}
+
+inline void WriteJsonValue(bool bool_value, JsonWriter* writer) {
+  writer->Value(bool_value);
+}
+
+inline void WriteJsonValue(int32_t signed_value, JsonWriter* writer) {
+  writer->Value(signed_value);
+}
+
+inline void WriteJsonValue(int64_t signed_value, JsonWriter* writer) {
+  writer->Value(signed_value);
+}
+
+#ifdef PJCORE_DISTINCT_LONG_LONG
+inline void WriteJsonValue(long long int signed_value,  // NOLINT(runtime/int)
+                           JsonWriter* writer) {
+  writer->Value(signed_value);
+}
+#endif  // PJCORE_DISTINCT_LONG_LONG
+
+inline void WriteJsonValue(uint32_t unsigned_value, JsonWriter* writer) {
+  writer->Value(unsigned_value);
+}
+
+inline void WriteJsonValue(uint64_t unsigned_value, JsonWriter* writer) {
+  writer->Value(unsigned_value);
+}
+
+#ifdef PJCORE_DISTINCT_LONG_LONG
+inline void WriteJsonValue(
+    long long unsigned int unsigned_value,  // NOLINT(runtime/int)
+    JsonWriter* writer) {
+  writer->Value(unsigned_value);
+}
+#endif  // PJCORE_DISTINCT_LONG_LONG
+
+inline void WriteJsonValue(float double_value, JsonWriter* writer) {
+  writer->Value(double_value);
+}
+
+inline void WriteJsonValue(double double_value, JsonWriter* writer) {
+  writer->Value(double_value);
+}
+
+inline void WriteJsonValue(const char* string_value, JsonWriter* writer) {
+  writer->Value(string_value);
+}
+
+inline void WriteJsonValue(StringPiece string_value, JsonWriter* writer) {
+  writer->Value(string_value);
+}
+
+inline void WriteJsonValue(const std::string& string_value,
+                           JsonWriter* writer) {
+  writer->Value(StringPiece(string_value));
+}
+
+inline void WriteJsonValue(const JsonValue& value, JsonWriter* writer) {
+  writer->Value(value);
+}
+
+namespace internal {
+
+// Appends value as WriteJson writes it nested depth levels deep, indented
+// accordingly and with a byte order mark, if configured, only at depth 0.
+void WriteNestedJson(const JsonValue& value, size_t depth,
+                     const JsonWriterConfig& config, std::string* output);
+
+// Appends a property name as WriteJson writes it, quotes included.
+void WriteJsonName(StringPiece name, const JsonWriterConfig& config,
+                   std::string* output);
+
+// Appends the properties or elements [begin, end) of an object or unpacked
+// array as WriteJson writes them between its brackets, separators included.
+void WriteJsonMembers(const JsonValue& container, int begin, int end,
+                      const JsonWriterConfig& config, std::string* output);
+
+}  // namespace internal
+
 }  // namespace pjcore
 
+#include "pjcore/write_json_pump.h"
+
 #endif  // PJCORE_JSON_WRITER_H_
@@ -25,6 +25,8 @@
 
 namespace pjcore {
 
+class JsonFieldMask;
+
 const JsonValue& JsonNull();
 
 JsonValue JsonNaN();
@@ -61,6 +63,10 @@ const JsonValue& MakeJsonValue(const JsonValue& json_value);
 
 JsonValue MakeJsonValue(const google::protobuf::Message& message);
 
+// Converts only the fields selected by mask; other fields are never read.
+JsonValue MakeJsonValue(const google::protobuf::Message& message,
+                        const JsonFieldMask& mask);
+
 template <typename Value>
 JsonValue::Property MakeJsonProperty(StringPiece name, const Value& value) {
   JsonValue::Property property;
@@ -69,6 +75,41 @@ JsonValue::Property MakeJsonProperty(StringPiece name, const Value& value) {
   return property;
 }
 
+// Adds a property to json_object, swapping the value made from value into
+// place instead of copying it.
+template <typename Value>
+void AppendJsonProperty(StringPiece name, const Value& value,
+                        JsonValue* json_object) {
+  JsonValue::Property* property = json_object->add_object_properties();
+  name.CopyToString(property->mutable_name());
+  JsonValue json_value = MakeJsonValue(value);
+  property->mutable_value()->Swap(&json_value);
+}
+
+// Copies value, as C++03 cannot tell a nested MakeJsonObject or MakeJsonArray
+// temporary from a named value: each such nested container costs one deep
+// copy. Pass a JsonValue* instead to avoid it.
+void AppendJsonProperty(StringPiece name, const JsonValue& value,
+                        JsonValue* json_object);
+
+// Swaps *value into place instead of copying it, leaving it cleared.
+void AppendJsonProperty(StringPiece name, JsonValue* value,
+                        JsonValue* json_object);
+
+// Adds an element to json_array, swapping the value made from value into
+// place instead of copying it.
+template <typename Value>
+void AppendJsonElement(const Value& value, JsonValue* json_array) {
+  JsonValue json_value = MakeJsonValue(value);
+  json_array->add_array_elements()->Swap(&json_value);
+}
+
+// Copies value, as the JsonValue overload of AppendJsonProperty does.
+void AppendJsonElement(const JsonValue& value, JsonValue* json_array);
+
+// Swaps *value into place instead of copying it, leaving it cleared.
+void AppendJsonElement(JsonValue* value, JsonValue* json_array);
+
 JsonValue MakeJsonObject();
 
 JsonValue MakeJsonArray();
@@ -29,113 +29,126 @@
 namespace pjcore {
 
 template <typename Value1>
-JsonValue MakeJsonObject(StringPiece name_1, Value1 value_1) {
+JsonValue MakeJsonObject(StringPiece name_1, const Value1& value_1) {
   JsonValue json_object = MakeJsonObject();
-  *json_object.add_object_properties() = MakeJsonProperty(name_1, value_1);
+  json_object.mutable_object_properties()->Reserve(1);
+  AppendJsonProperty(name_1, value_1, &json_object);
   return json_object;
 }
 
 
 template <typename Value1, typename Value2>
-JsonValue MakeJsonObject(StringPiece name_1, Value1 value_1,
-    StringPiece name_2, Value2 value_2) {
+JsonValue MakeJsonObject(StringPiece name_1, const Value1& value_1,
+    StringPiece name_2, const Value2& value_2) {
   JsonValue json_object = MakeJsonObject();
-  *json_object.add_object_properties() = MakeJsonProperty(name_1, value_1);
-  *json_object.add_object_properties() = MakeJsonProperty(name_2, value_2);
+  json_object.mutable_object_properties()->Reserve(2);
+  AppendJsonProperty(name_1, value_1, &json_object);
+  AppendJsonProperty(name_2, value_2, &json_object);
   return json_object;
 }
 
 
 template <typename Value1, typename Value2, typename Value3>
-JsonValue MakeJsonObject(StringPiece name_1, Value1 value_1,
-    StringPiece name_2, Value2 value_2, StringPiece name_3, Value3 value_3) {
+JsonValue MakeJsonObject(StringPiece name_1, const Value1& value_1,
+    StringPiece name_2, const Value2& value_2, StringPiece name_3,
+    const Value3& value_3) {
   JsonValue json_object = MakeJsonObject();
-  *json_object.add_object_properties() = MakeJsonProperty(name_1, value_1);
-  *json_object.add_object_properties() = MakeJsonProperty(name_2, value_2);
-  *json_object.add_object_properties() = MakeJsonProperty(name_3, value_3);
+  json_object.mutable_object_properties()->Reserve(3);
+  AppendJsonProperty(name_1, value_1, &json_object);
+  AppendJsonProperty(name_2, value_2, &json_object);
+  AppendJsonProperty(name_3, value_3, &json_object);
   return json_object;
 }
 
 
 template <typename Value1, typename Value2, typename Value3, typename Value4>
-JsonValue MakeJsonObject(StringPiece name_1, Value1 value_1,
-    StringPiece name_2, Value2 value_2, StringPiece name_3, Value3 value_3,
-    StringPiece name_4, Value4 value_4) {
+JsonValue MakeJsonObject(StringPiece name_1, const Value1& value_1,
+    StringPiece name_2, const Value2& value_2, StringPiece name_3,
+    const Value3& value_3, StringPiece name_4, const Value4& value_4) {
   JsonValue json_object = MakeJsonObject();
-  *json_object.add_object_properties() = MakeJsonProperty(name_1, value_1);
-  *json_object.add_object_properties() = MakeJsonProperty(name_2, value_2);
-  *json_object.add_object_properties() = MakeJsonProperty(name_3, value_3);
-  *json_object.add_object_properties() = MakeJsonProperty(name_4, value_4);
+  json_object.mutable_object_properties()->Reserve(4);
+  AppendJsonProperty(name_1, value_1, &json_object);
+  AppendJsonProperty(name_2, value_2, &json_object);
+  AppendJsonProperty(name_3, value_3, &json_object);
+  AppendJsonProperty(name_4, value_4, &json_object);
   return json_object;
 }
 
 
 template <typename Value1, typename Value2, typename Value3, typename Value4,
     typename Value5>
-JsonValue MakeJsonObject(StringPiece name_1, Value1 value_1,
-    StringPiece name_2, Value2 value_2, StringPiece name_3, Value3 value_3,
-    StringPiece name_4, Value4 value_4, StringPiece name_5, Value5 value_5) {
+JsonValue MakeJsonObject(StringPiece name_1, const Value1& value_1,
+    StringPiece name_2, const Value2& value_2, StringPiece name_3,
+    const Value3& value_3, StringPiece name_4, const Value4& value_4,
+    StringPiece name_5, const Value5& value_5) {
   JsonValue json_object = MakeJsonObject();
-  *json_object.add_object_properties() = MakeJsonProperty(name_1, value_1);
-  *json_object.add_object_properties() = MakeJsonProperty(name_2, value_2);
-  *json_object.add_object_properties() = MakeJsonProperty(name_3, value_3);
-  *json_object.add_object_properties() = MakeJsonProperty(name_4, value_4);
-  *json_object.add_object_properties() = MakeJsonProperty(name_5, value_5);
+  json_object.mutable_object_properties()->Reserve(5);
+  AppendJsonProperty(name_1, value_1, &json_object);
+  AppendJsonProperty(name_2, value_2, &json_object);
+  AppendJsonProperty(name_3, value_3, &json_object);
+  AppendJsonProperty(name_4, value_4, &json_object);
+  AppendJsonProperty(name_5, value_5, &json_object);
   return json_object;
 }
 
 
 template <typename Value1, typename Value2, typename Value3, typename Value4,
     typename Value5, typename Value6>
-JsonValue MakeJsonObject(StringPiece name_1, Value1 value_1,
-    StringPiece name_2, Value2 value_2, StringPiece name_3, Value3 value_3,
-    StringPiece name_4, Value4 value_4, StringPiece name_5, Value5 value_5,
-    StringPiece name_6, Value6 value_6) {
+JsonValue MakeJsonObject(StringPiece name_1, const Value1& value_1,
+    StringPiece name_2, const Value2& value_2, StringPiece name_3,
+    const Value3& value_3, StringPiece name_4, const Value4& value_4,
+    StringPiece name_5, const Value5& value_5, StringPiece name_6,
+    const Value6& value_6) {
   JsonValue json_object = MakeJsonObject();
-  *json_object.add_object_properties() = MakeJsonProperty(name_1, value_1);
-  *json_object.add_object_properties() = MakeJsonProperty(name_2, value_2);
-  *json_object.add_object_properties() = MakeJsonProperty(name_3, value_3);
-  *json_object.add_object_properties() = MakeJsonProperty(name_4, value_4);
-  *json_object.add_object_properties() = MakeJsonProperty(name_5, value_5);
-  *json_object.add_object_properties() = MakeJsonProperty(name_6, value_6);
+  json_object.mutable_object_properties()->Reserve(6);
+  AppendJsonProperty(name_1, value_1, &json_object);
+  AppendJsonProperty(name_2, value_2, &json_object);
+  AppendJsonProperty(name_3, value_3, &json_object);
+  AppendJsonProperty(name_4, value_4, &json_object);
+  AppendJsonProperty(name_5, value_5, &json_object);
+  AppendJsonProperty(name_6, value_6, &json_object);
   return json_object;
 }
 
 
 template <typename Value1, typename Value2, typename Value3, typename Value4,
     typename Value5, typename Value6, typename Value7>
-JsonValue MakeJsonObject(StringPiece name_1, Value1 value_1,
-    StringPiece name_2, Value2 value_2, StringPiece name_3, Value3 value_3,
-    StringPiece name_4, Value4 value_4, StringPiece name_5, Value5 value_5,
-    StringPiece name_6, Value6 value_6, StringPiece name_7, Value7 value_7) {
+JsonValue MakeJsonObject(StringPiece name_1, const Value1& value_1,
+    StringPiece name_2, const Value2& value_2, StringPiece name_3,
+    const Value3& value_3, StringPiece name_4, const Value4& value_4,
+    StringPiece name_5, const Value5& value_5, StringPiece name_6,
+    const Value6& value_6, StringPiece name_7, const Value7& value_7) {
   JsonValue json_object = MakeJsonObject();
-  *json_object.add_object_properties() = MakeJsonProperty(name_1, value_1);
-  *json_object.add_object_properties() = MakeJsonProperty(name_2, value_2);
-  *json_object.add_object_properties() = MakeJsonProperty(name_3, value_3);
-  *json_object.add_object_properties() = MakeJsonProperty(name_4, value_4);
-  *json_object.add_object_properties() = MakeJsonProperty(name_5, value_5);
-  *json_object.add_object_properties() = MakeJsonProperty(name_6, value_6);
-  *json_object.add_object_properties() = MakeJsonProperty(name_7, value_7);
+  json_object.mutable_object_properties()->Reserve(7);
+  AppendJsonProperty(name_1, value_1, &json_object);
+  AppendJsonProperty(name_2, value_2, &json_object);
+  AppendJsonProperty(name_3, value_3, &json_object);
+  AppendJsonProperty(name_4, value_4, &json_object);
+  AppendJsonProperty(name_5, value_5, &json_object);
+  AppendJsonProperty(name_6, value_6, &json_object);
+  AppendJsonProperty(name_7, value_7, &json_object);
   return json_object;
 }
 
 
 template <typename Value1, typename Value2, typename Value3, typename Value4,
     typename Value5, typename Value6, typename Value7, typename Value8>
-JsonValue MakeJsonObject(StringPiece name_1, Value1 value_1,
-    StringPiece name_2, Value2 value_2, StringPiece name_3, Value3 value_3,
-    StringPiece name_4, Value4 value_4, StringPiece name_5, Value5 value_5,
-    StringPiece name_6, Value6 value_6, StringPiece name_7, Value7 value_7,
-    StringPiece name_8, Value8 value_8) {
+JsonValue MakeJsonObject(StringPiece name_1, const Value1& value_1,
+    StringPiece name_2, const Value2& value_2, StringPiece name_3,
+    const Value3& value_3, StringPiece name_4, const Value4& value_4,
+    StringPiece name_5, const Value5& value_5, StringPiece name_6,
+    const Value6& value_6, StringPiece name_7, const Value7& value_7,
+    StringPiece name_8, const Value8& value_8) {
   JsonValue json_object = MakeJsonObject();
-  *json_object.add_object_properties() = MakeJsonProperty(name_1, value_1);
-  *json_object.add_object_properties() = MakeJsonProperty(name_2, value_2);
-  *json_object.add_object_properties() = MakeJsonProperty(name_3, value_3);
-  *json_object.add_object_properties() = MakeJsonProperty(name_4, value_4);
-  *json_object.add_object_properties() = MakeJsonProperty(name_5, value_5);
-  *json_object.add_object_properties() = MakeJsonProperty(name_6, value_6);
-  *json_object.add_object_properties() = MakeJsonProperty(name_7, value_7);
-  *json_object.add_object_properties() = MakeJsonProperty(name_8, value_8);
+  json_object.mutable_object_properties()->Reserve(8);
+  AppendJsonProperty(name_1, value_1, &json_object);
+  AppendJsonProperty(name_2, value_2, &json_object);
+  AppendJsonProperty(name_3, value_3, &json_object);
+  AppendJsonProperty(name_4, value_4, &json_object);
+  AppendJsonProperty(name_5, value_5, &json_object);
+  AppendJsonProperty(name_6, value_6, &json_object);
+  AppendJsonProperty(name_7, value_7, &json_object);
+  AppendJsonProperty(name_8, value_8, &json_object);
   return json_object;
 }
 
@@ -143,21 +156,24 @@ JsonValue MakeJsonObject(StringPiece name_1, Value1 value_1,
 template <typename Value1, typename Value2, typename Value3, typename Value4,
     typename Value5, typename Value6, typename Value7, typename Value8,
     typename Value9>
-JsonValue MakeJsonObject(StringPiece name_1, Value1 value_1,
-    StringPiece name_2, Value2 value_2, StringPiece name_3, Value3 value_3,
-    StringPiece name_4, Value4 value_4, StringPiece name_5, Value5 value_5,
-    StringPiece name_6, Value6 value_6, StringPiece name_7, Value7 value_7,
-    StringPiece name_8, Value8 value_8, StringPiece name_9, Value9 value_9) {
+JsonValue MakeJsonObject(StringPiece name_1, const Value1& value_1,
+    StringPiece name_2, const Value2& value_2, StringPiece name_3,
+    const Value3& value_3, StringPiece name_4, const Value4& value_4,
+    StringPiece name_5, const Value5& value_5, StringPiece name_6,
+    const Value6& value_6, StringPiece name_7, const Value7& value_7,
+    StringPiece name_8, const Value8& value_8, StringPiece name_9,
+    const Value9& value_9) {
   JsonValue json_object = MakeJsonObject();
-  *json_object.add_object_properties() = MakeJsonProperty(name_1, value_1);
-  *json_object.add_object_properties() = MakeJsonProperty(name_2, value_2);
-  *json_object.add_object_properties() = MakeJsonProperty(name_3, value_3);
-  *json_object.add_object_properties() = MakeJsonProperty(name_4, value_4);
-  *json_object.add_object_properties() = MakeJsonProperty(name_5, value_5);
-  *json_object.add_object_properties() = MakeJsonProperty(name_6, value_6);
-  *json_object.add_object_properties() = MakeJsonProperty(name_7, value_7);
-  *json_object.add_object_properties() = MakeJsonProperty(name_8, value_8);
-  *json_object.add_object_properties() = MakeJsonProperty(name_9, value_9);
+  json_object.mutable_object_properties()->Reserve(9);
+  AppendJsonProperty(name_1, value_1, &json_object);
+  AppendJsonProperty(name_2, value_2, &json_object);
+  AppendJsonProperty(name_3, value_3, &json_object);
+  AppendJsonProperty(name_4, value_4, &json_object);
+  AppendJsonProperty(name_5, value_5, &json_object);
+  AppendJsonProperty(name_6, value_6, &json_object);
+  AppendJsonProperty(name_7, value_7, &json_object);
+  AppendJsonProperty(name_8, value_8, &json_object);
+  AppendJsonProperty(name_9, value_9, &json_object);
   return json_object;
 }
 
@@ -165,23 +181,25 @@ JsonValue MakeJsonObject(StringPiece name_1, Value1 value_1,
 template <typename Value1, typename Value2, typename Value3, typename Value4,
     typename Value5, typename Value6, typename Value7, typename Value8,
     typename Value9, typename Value10>
-JsonValue MakeJsonObject(StringPiece name_1, Value1 value_1,
-    StringPiece name_2, Value2 value_2, StringPiece name_3, Value3 value_3,
-    StringPiece name_4, Value4 value_4, StringPiece name_5, Value5 value_5,
-    StringPiece name_6, Value6 value_6, StringPiece name_7, Value7 value_7,
-    StringPiece name_8, Value8 value_8, StringPiece name_9, Value9 value_9,
-    StringPiece name_10, Value10 value_10) {
+JsonValue MakeJsonObject(StringPiece name_1, const Value1& value_1,
+    StringPiece name_2, const Value2& value_2, StringPiece name_3,
+    const Value3& value_3, StringPiece name_4, const Value4& value_4,
+    StringPiece name_5, const Value5& value_5, StringPiece name_6,
+    const Value6& value_6, StringPiece name_7, const Value7& value_7,
+    StringPiece name_8, const Value8& value_8, StringPiece name_9,
+    const Value9& value_9, StringPiece name_10, const Value10& value_10) {
   JsonValue json_object = MakeJsonObject();
-  *json_object.add_object_properties() = MakeJsonProperty(name_1, value_1);
-  *json_object.add_object_properties() = MakeJsonProperty(name_2, value_2);
-  *json_object.add_object_properties() = MakeJsonProperty(name_3, value_3);
-  *json_object.add_object_properties() = MakeJsonProperty(name_4, value_4);
-  *json_object.add_object_properties() = MakeJsonProperty(name_5, value_5);
-  *json_object.add_object_properties() = MakeJsonProperty(name_6, value_6);
-  *json_object.add_object_properties() = MakeJsonProperty(name_7, value_7);
-  *json_object.add_object_properties() = MakeJsonProperty(name_8, value_8);
-  *json_object.add_object_properties() = MakeJsonProperty(name_9, value_9);
-  *json_object.add_object_properties() = MakeJsonProperty(name_10, value_10);
+  json_object.mutable_object_properties()->Reserve(10);
+  AppendJsonProperty(name_1, value_1, &json_object);
+  AppendJsonProperty(name_2, value_2, &json_object);
+  AppendJsonProperty(name_3, value_3, &json_object);
+  AppendJsonProperty(name_4, value_4, &json_object);
+  AppendJsonProperty(name_5, value_5, &json_object);
+  AppendJsonProperty(name_6, value_6, &json_object);
+  AppendJsonProperty(name_7, value_7, &json_object);
+  AppendJsonProperty(name_8, value_8, &json_object);
+  AppendJsonProperty(name_9, value_9, &json_object);
+  AppendJsonProperty(name_10, value_10, &json_object);
   return json_object;
 }
 
@@ -189,25 +207,27 @@ JsonValue MakeJsonObject(StringPiece name_1, Value1 value_1,
 template <typename Value1, typename Value2, typename Value3, typename Value4,
     typename Value5, typename Value6, typename Value7, typename Value8,
     typename Value9, typename Value10, typename Value11>
-JsonValue MakeJsonObject(StringPiece name_1, Value1 value_1,
-    StringPiece name_2, Value2 value_2, StringPiece name_3, Value3 value_3,
-    StringPiece name_4, Value4 value_4, StringPiece name_5, Value5 value_5,
-    StringPiece name_6, Value6 value_6, StringPiece name_7, Value7 value_7,
-    StringPiece name_8, Value8 value_8, StringPiece name_9, Value9 value_9,
-    StringPiece name_10, Value10 value_10, StringPiece name_11,
-    Value11 value_11) {
+JsonValue MakeJsonObject(StringPiece name_1, const Value1& value_1,
+    StringPiece name_2, const Value2& value_2, StringPiece name_3,
+    const Value3& value_3, StringPiece name_4, const Value4& value_4,
+    StringPiece name_5, const Value5& value_5, StringPiece name_6,
+    const Value6& value_6, StringPiece name_7, const Value7& value_7,
+    StringPiece name_8, const Value8& value_8, StringPiece name_9,
+    const Value9& value_9, StringPiece name_10, const Value10& value_10,
+    StringPiece name_11, const Value11& value_11) {
   JsonValue json_object = MakeJsonObject();
-  *json_object.add_object_properties() = MakeJsonProperty(name_1, value_1);
-  *json_object.add_object_properties() = MakeJsonProperty(name_2, value_2);
-  *json_object.add_object_properties() = MakeJsonProperty(name_3, value_3);
-  *json_object.add_object_properties() = MakeJsonProperty(name_4, value_4);
-  *json_object.add_object_properties() = MakeJsonProperty(name_5, value_5);
-  *json_object.add_object_properties() = MakeJsonProperty(name_6, value_6);
-  *json_object.add_object_properties() = MakeJsonProperty(name_7, value_7);
-  *json_object.add_object_properties() = MakeJsonProperty(name_8, value_8);
-  *json_object.add_object_properties() = MakeJsonProperty(name_9, value_9);
-  *json_object.add_object_properties() = MakeJsonProperty(name_10, value_10);
-  *json_object.add_object_properties() = MakeJsonProperty(name_11, value_11);
+  json_object.mutable_object_properties()->Reserve(11);
+  AppendJsonProperty(name_1, value_1, &json_object);
+  AppendJsonProperty(name_2, value_2, &json_object);
+  AppendJsonProperty(name_3, value_3, &json_object);
+  AppendJsonProperty(name_4, value_4, &json_object);
+  AppendJsonProperty(name_5, value_5, &json_object);
+  AppendJsonProperty(name_6, value_6, &json_object);
+  AppendJsonProperty(name_7, value_7, &json_object);
+  AppendJsonProperty(name_8, value_8, &json_object);
+  AppendJsonProperty(name_9, value_9, &json_object);
+  AppendJsonProperty(name_10, value_10, &json_object);
+  AppendJsonProperty(name_11, value_11, &json_object);
   return json_object;
 }
 
@@ -215,26 +235,29 @@ JsonValue MakeJsonObject(StringPiece name_1, Value1 value_1,
 template <typename Value1, typename Value2, typename Value3, typename Value4,
     typename Value5, typename Value6, typename Value7, typename Value8,
     typename Value9, typename Value10, typename Value11, typename Value12>
-JsonValue MakeJsonObject(StringPiece name_1, Value1 value_1,
-    StringPiece name_2, Value2 value_2, StringPiece name_3, Value3 value_3,
-    StringPiece name_4, Value4 value_4, StringPiece name_5, Value5 value_5,
-    StringPiece name_6, Value6 value_6, StringPiece name_7, Value7 value_7,
-    StringPiece name_8, Value8 value_8, StringPiece name_9, Value9 value_9,
-    StringPiece name_10, Value10 value_10, StringPiece name_11,
-    Value11 value_11, StringPiece name_12, Value12 value_12) {
+JsonValue MakeJsonObject(StringPiece name_1, const Value1& value_1,
+    StringPiece name_2, const Value2& value_2, StringPiece name_3,
+    const Value3& value_3, StringPiece name_4, const Value4& value_4,
+    StringPiece name_5, const Value5& value_5, StringPiece name_6,
+    const Value6& value_6, StringPiece name_7, const Value7& value_7,
+    StringPiece name_8, const Value8& value_8, StringPiece name_9,
+    const Value9& value_9, StringPiece name_10, const Value10& value_10,
+    StringPiece name_11, const Value11& value_11, StringPiece name_12,
+    const Value12& value_12) {
   JsonValue json_object = MakeJsonObject();
-  *json_object.add_object_properties() = MakeJsonProperty(name_1, value_1);
-  *json_object.add_object_properties() = MakeJsonProperty(name_2, value_2);
-  *json_object.add_object_properties() = MakeJsonProperty(name_3, value_3);
-  *json_object.add_object_properties() = MakeJsonProperty(name_4, value_4);
-  *json_object.add_object_properties() = MakeJsonProperty(name_5, value_5);
-  *json_object.add_object_properties() = MakeJsonProperty(name_6, value_6);
-  *json_object.add_object_properties() = MakeJsonProperty(name_7, value_7);
-  *json_object.add_object_properties() = MakeJsonProperty(name_8, value_8);
-  *json_object.add_object_properties() = MakeJsonProperty(name_9, value_9);
-  *json_object.add_object_properties() = MakeJsonProperty(name_10, value_10);
-  *json_object.add_object_properties() = MakeJsonProperty(name_11, value_11);
-  *json_object.add_object_properties() = MakeJsonProperty(name_12, value_12);
+  json_object.mutable_object_properties()->Reserve(12);
+  AppendJsonProperty(name_1, value_1, &json_object);
+  AppendJsonProperty(name_2, value_2, &json_object);
+  AppendJsonProperty(name_3, value_3, &json_object);
+  AppendJsonProperty(name_4, value_4, &json_object);
+  AppendJsonProperty(name_5, value_5, &json_object);
+  AppendJsonProperty(name_6, value_6, &json_object);
+  AppendJsonProperty(name_7, value_7, &json_object);
+  AppendJsonProperty(name_8, value_8, &json_object);
+  AppendJsonProperty(name_9, value_9, &json_object);
+  AppendJsonProperty(name_10, value_10, &json_object);
+  AppendJsonProperty(name_11, value_11, &json_object);
+  AppendJsonProperty(name_12, value_12, &json_object);
   return json_object;
 }
 
@@ -243,28 +266,30 @@ template <typename Value1, typename Value2, typename Value3, typename Value4,
     typename Value5, typename Value6, typename Value7, typename Value8,
     typename Value9, typename Value10, typename Value11, typename Value12,
     typename Value13>
-JsonValue MakeJsonObject(StringPiece name_1, Value1 value_1,
-    StringPiece name_2, Value2 value_2, StringPiece name_3, Value3 value_3,
-    StringPiece name_4, Value4 value_4, StringPiece name_5, Value5 value_5,
-    StringPiece name_6, Value6 value_6, StringPiece name_7, Value7 value_7,
-    StringPiece name_8, Value8 value_8, StringPiece name_9, Value9 value_9,
-    StringPiece name_10, Value10 value_10, StringPiece name_11,
-    Value11 value_11, StringPiece name_12, Value12 value_12,
-    StringPiece name_13, Value13 value_13) {
+JsonValue MakeJsonObject(StringPiece name_1, const Value1& value_1,
+    StringPiece name_2, const Value2& value_2, StringPiece name_3,
+    const Value3& value_3, StringPiece name_4, const Value4& value_4,
+    StringPiece name_5, const Value5& value_5, StringPiece name_6,
+    const Value6& value_6, StringPiece name_7, const Value7& value_7,
+    StringPiece name_8, const Value8& value_8, StringPiece name_9,
+    const Value9& value_9, StringPiece name_10, const Value10& value_10,
+    StringPiece name_11, const Value11& value_11, StringPiece name_12,
+    const Value12& value_12, StringPiece name_13, const Value13& value_13) {
   JsonValue json_object = MakeJsonObject();
-  *json_object.add_object_properties() = MakeJsonProperty(name_1, value_1);
-  *json_object.add_object_properties() = MakeJsonProperty(name_2, value_2);
-  *json_object.add_object_properties() = MakeJsonProperty(name_3, value_3);
-  *json_object.add_object_properties() = MakeJsonProperty(name_4, value_4);
-  *json_object.add_object_properties() = MakeJsonProperty(name_5, value_5);
-  *json_object.add_object_properties() = MakeJsonProperty(name_6, value_6);
-  *json_object.add_object_properties() = MakeJsonProperty(name_7, value_7);
-  *json_object.add_object_properties() = MakeJsonProperty(name_8, value_8);
-  *json_object.add_object_properties() = MakeJsonProperty(name_9, value_9);
-  *json_object.add_object_properties() = MakeJsonProperty(name_10, value_10);
-  *json_object.add_object_properties() = MakeJsonProperty(name_11, value_11);
-  *json_object.add_object_properties() = MakeJsonProperty(name_12, value_12);
-  *json_object.add_object_properties() = MakeJsonProperty(name_13, value_13);
+  json_object.mutable_object_properties()->Reserve(13);
+  AppendJsonProperty(name_1, value_1, &json_object);
+  AppendJsonProperty(name_2, value_2, &json_object);
+  AppendJsonProperty(name_3, value_3, &json_object);
+  AppendJsonProperty(name_4, value_4, &json_object);
+  AppendJsonProperty(name_5, value_5, &json_object);
+  AppendJsonProperty(name_6, value_6, &json_object);
+  AppendJsonProperty(name_7, value_7, &json_object);
+  AppendJsonProperty(name_8, value_8, &json_object);
+  AppendJsonProperty(name_9, value_9, &json_object);
+  AppendJsonProperty(name_10, value_10, &json_object);
+  AppendJsonProperty(name_11, value_11, &json_object);
+  AppendJsonProperty(name_12, value_12, &json_object);
+  AppendJsonProperty(name_13, value_13, &json_object);
   return json_object;
 }
 
@@ -273,30 +298,32 @@ template <typename Value1, typename Value2, typename Value3, typename Value4,
     typename Value5, typename Value6, typename Value7, typename Value8,
     typename Value9, typename Value10, typename Value11, typename Value12,
     typename Value13, typename Value14>
-JsonValue MakeJsonObject(StringPiece name_1, Value1 value_1,
-    StringPiece name_2, Value2 value_2, StringPiece name_3, Value3 value_3,
-    StringPiece name_4, Value4 value_4, StringPiece name_5, Value5 value_5,
-    StringPiece name_6, Value6 value_6, StringPiece name_7, Value7 value_7,
-    StringPiece name_8, Value8 value_8, StringPiece name_9, Value9 value_9,
-    StringPiece name_10, Value10 value_10, StringPiece name_11,
-    Value11 value_11, StringPiece name_12, Value12 value_12,
-    StringPiece name_13, Value13 value_13, StringPiece name_14,
-    Value14 value_14) {
+JsonValue MakeJsonObject(StringPiece name_1, const Value1& value_1,
+    StringPiece name_2, const Value2& value_2, StringPiece name_3,
+    const Value3& value_3, StringPiece name_4, const Value4& value_4,
+    StringPiece name_5, const Value5& value_5, StringPiece name_6,
+    const Value6& value_6, StringPiece name_7, const Value7& value_7,
+    StringPiece name_8, const Value8& value_8, StringPiece name_9,
+    const Value9& value_9, StringPiece name_10, const Value10& value_10,
+    StringPiece name_11, const Value11& value_11, StringPiece name_12,
+    const Value12& value_12, StringPiece name_13, const Value13& value_13,
+    StringPiece name_14, const Value14& value_14) {
   JsonValue json_object = MakeJsonObject();
-  *json_object.add_object_properties() = MakeJsonProperty(name_1, value_1);
-  *json_object.add_object_properties() = MakeJsonProperty(name_2, value_2);
-  *json_object.add_object_properties() = MakeJsonProperty(name_3, value_3);
-  *json_object.add_object_properties() = MakeJsonProperty(name_4, value_4);
-  *json_object.add_object_properties() = MakeJsonProperty(name_5, value_5);
-  *json_object.add_object_properties() = MakeJsonProperty(name_6, value_6);
-  *json_object.add_object_properties() = MakeJsonProperty(name_7, value_7);
-  *json_object.add_object_properties() = MakeJsonProperty(name_8, value_8);
-  *json_object.add_object_properties() = MakeJsonProperty(name_9, value_9);
-  *json_object.add_object_properties() = MakeJsonProperty(name_10, value_10);
-  *json_object.add_object_properties() = MakeJsonProperty(name_11, value_11);
-  *json_object.add_object_properties() = MakeJsonProperty(name_12, value_12);
-  *json_object.add_object_properties() = MakeJsonProperty(name_13, value_13);
-  *json_object.add_object_properties() = MakeJsonProperty(name_14, value_14);
+  json_object.mutable_object_properties()->Reserve(14);
+  AppendJsonProperty(name_1, value_1, &json_object);
+  AppendJsonProperty(name_2, value_2, &json_object);
+  AppendJsonProperty(name_3, value_3, &json_object);
+  AppendJsonProperty(name_4, value_4, &json_object);
+  AppendJsonProperty(name_5, value_5, &json_object);
+  AppendJsonProperty(name_6, value_6, &json_object);
+  AppendJsonProperty(name_7, value_7, &json_object);
+  AppendJsonProperty(name_8, value_8, &json_object);
+  AppendJsonProperty(name_9, value_9, &json_object);
+  AppendJsonProperty(name_10, value_10, &json_object);
+  AppendJsonProperty(name_11, value_11, &json_object);
+  AppendJsonProperty(name_12, value_12, &json_object);
+  AppendJsonProperty(name_13, value_13, &json_object);
+  AppendJsonProperty(name_14, value_14, &json_object);
   return json_object;
 }
 
@@ -305,31 +332,34 @@ template <typename Value1, typename Value2, typename Value3, typename Value4,
     typename Value5, typename Value6, typename Value7, typename Value8,
     typename Value9, typename Value10, typename Value11, typename Value12,
     typename Value13, typename Value14, typename Value15>
-JsonValue MakeJsonObject(StringPiece name_1, Value1 value_1,
-    StringPiece name_2, Value2 value_2, StringPiece name_3, Value3 value_3,
-    StringPiece name_4, Value4 value_4, StringPiece name_5, Value5 value_5,
-    StringPiece name_6, Value6 value_6, StringPiece name_7, Value7 value_7,
-    StringPiece name_8, Value8 value_8, StringPiece name_9, Value9 value_9,
-    StringPiece name_10, Value10 value_10, StringPiece name_11,
-    Value11 value_11, StringPiece name_12, Value12 value_12,
-    StringPiece name_13, Value13 value_13, StringPiece name_14,
-    Value14 value_14, StringPiece name_15, Value15 value_15) {
+JsonValue MakeJsonObject(StringPiece name_1, const Value1& value_1,
+    StringPiece name_2, const Value2& value_2, StringPiece name_3,
+    const Value3& value_3, StringPiece name_4, const Value4& value_4,
+    StringPiece name_5, const Value5& value_5, StringPiece name_6,
+    const Value6& value_6, StringPiece name_7, const Value7& value_7,
+    StringPiece name_8, const Value8& value_8, StringPiece name_9,
+    const Value9& value_9, StringPiece name_10, const Value10& value_10,
+    StringPiece name_11, const Value11& value_11, StringPiece name_12,
+    const Value12& value_12, StringPiece name_13, const Value13& value_13,
+    StringPiece name_14, const Value14& value_14, StringPiece name_15,
+    const Value15& value_15) {
   JsonValue json_object = MakeJsonObject();
-  *json_object.add_object_properties() = MakeJsonProperty(name_1, value_1);
-  *json_object.add_object_properties() = MakeJsonProperty(name_2, value_2);
-  *json_object.add_object_properties() = MakeJsonProperty(name_3, value_3);
-  *json_object.add_object_properties() = MakeJsonProperty(name_4, value_4);
-  *json_object.add_object_properties() = MakeJsonProperty(name_5, value_5);
-  *json_object.add_object_properties() = MakeJsonProperty(name_6, value_6);
-  *json_object.add_object_properties() = MakeJsonProperty(name_7, value_7);
-  *json_object.add_object_properties() = MakeJsonProperty(name_8, value_8);
-  *json_object.add_object_properties() = MakeJsonProperty(name_9, value_9);
-  *json_object.add_object_properties() = MakeJsonProperty(name_10, value_10);
-  *json_object.add_object_properties() = MakeJsonProperty(name_11, value_11);
-  *json_object.add_object_properties() = MakeJsonProperty(name_12, value_12);
-  *json_object.add_object_properties() = MakeJsonProperty(name_13, value_13);
-  *json_object.add_object_properties() = MakeJsonProperty(name_14, value_14);
-  *json_object.add_object_properties() = MakeJsonProperty(name_15, value_15);
+  json_object.mutable_object_properties()->Reserve(15);
+  AppendJsonProperty(name_1, value_1, &json_object);
+  AppendJsonProperty(name_2, value_2, &json_object);
+  AppendJsonProperty(name_3, value_3, &json_object);
+  AppendJsonProperty(name_4, value_4, &json_object);
+  AppendJsonProperty(name_5, value_5, &json_object);
+  AppendJsonProperty(name_6, value_6, &json_object);
+  AppendJsonProperty(name_7, value_7, &json_object);
+  AppendJsonProperty(name_8, value_8, &json_object);
+  AppendJsonProperty(name_9, value_9, &json_object);
+  AppendJsonProperty(name_10, value_10, &json_object);
+  AppendJsonProperty(name_11, value_11, &json_object);
+  AppendJsonProperty(name_12, value_12, &json_object);
+  AppendJsonProperty(name_13, value_13, &json_object);
+  AppendJsonProperty(name_14, value_14, &json_object);
+  AppendJsonProperty(name_15, value_15, &json_object);
   return json_object;
 }
 
@@ -338,33 +368,35 @@ template <typename Value1, typename Value2, typename Value3, typename Value4,
     typename Value5, typename Value6, typename Value7, typename Value8,
     typename Value9, typename Value10, typename Value11, typename Value12,
     typename Value13, typename Value14, typename Value15, typename Value16>
-JsonValue MakeJsonObject(StringPiece name_1, Value1 value_1,
-    StringPiece name_2, Value2 value_2, StringPiece name_3, Value3 value_3,
-    StringPiece name_4, Value4 value_4, StringPiece name_5, Value5 value_5,
-    StringPiece name_6, Value6 value_6, StringPiece name_7, Value7 value_7,
-    StringPiece name_8, Value8 value_8, StringPiece name_9, Value9 value_9,
-    StringPiece name_10, Value10 value_10, StringPiece name_11,
-    Value11 value_11, StringPiece name_12, Value12 value_12,
-    StringPiece name_13, Value13 value_13, StringPiece name_14,
-    Value14 value_14, StringPiece name_15, Value15 value_15,
-    StringPiece name_16, Value16 value_16) {
+JsonValue MakeJsonObject(StringPiece name_1, const Value1& value_1,
+    StringPiece name_2, const Value2& value_2, StringPiece name_3,
+    const Value3& value_3, StringPiece name_4, const Value4& value_4,
+    StringPiece name_5, const Value5& value_5, StringPiece name_6,
+    const Value6& value_6, StringPiece name_7, const Value7& value_7,
+    StringPiece name_8, const Value8& value_8, StringPiece name_9,
+    const Value9& value_9, StringPiece name_10, const Value10& value_10,
+    StringPiece name_11, const Value11& value_11, StringPiece name_12,
+    const Value12& value_12, StringPiece name_13, const Value13& value_13,
+    StringPiece name_14, const Value14& value_14, StringPiece name_15,
+    const Value15& value_15, StringPiece name_16, const Value16& value_16) {
   JsonValue json_object = MakeJsonObject();
-  *json_object.add_object_properties() = MakeJsonProperty(name_1, value_1);
-  *json_object.add_object_properties() = MakeJsonProperty(name_2, value_2);
-  *json_object.add_object_properties() = MakeJsonProperty(name_3, value_3);
-  *json_object.add_object_properties() = MakeJsonProperty(name_4, value_4);
-  *json_object.add_object_properties() = MakeJsonProperty(name_5, value_5);
-  *json_object.add_object_properties() = MakeJsonProperty(name_6, value_6);
-  *json_object.add_object_properties() = MakeJsonProperty(name_7, value_7);
-  *json_object.add_object_properties() = MakeJsonProperty(name_8, value_8);
-  *json_object.add_object_properties() = MakeJsonProperty(name_9, value_9);
-  *json_object.add_object_properties() = MakeJsonProperty(name_10, value_10);
-  *json_object.add_object_properties() = MakeJsonProperty(name_11, value_11);
-  *json_object.add_object_properties() = MakeJsonProperty(name_12, value_12);
-  *json_object.add_object_properties() = MakeJsonProperty(name_13, value_13);
-  *json_object.add_object_properties() = MakeJsonProperty(name_14, value_14);
-  *json_object.add_object_properties() = MakeJsonProperty(name_15, value_15);
-  *json_object.add_object_properties() = MakeJsonProperty(name_16, value_16);
+  json_object.mutable_object_properties()->Reserve(16);
+  AppendJsonProperty(name_1, value_1, &json_object);
+  AppendJsonProperty(name_2, value_2, &json_object);
+  AppendJsonProperty(name_3, value_3, &json_object);
+  AppendJsonProperty(name_4, value_4, &json_object);
+  AppendJsonProperty(name_5, value_5, &json_object);
+  AppendJsonProperty(name_6, value_6, &json_object);
+  AppendJsonProperty(name_7, value_7, &json_object);
+  AppendJsonProperty(name_8, value_8, &json_object);
+  AppendJsonProperty(name_9, value_9, &json_object);
+  AppendJsonProperty(name_10, value_10, &json_object);
+  AppendJsonProperty(name_11, value_11, &json_object);
+  AppendJsonProperty(name_12, value_12, &json_object);
+  AppendJsonProperty(name_13, value_13, &json_object);
+  AppendJsonProperty(name_14, value_14, &json_object);
+  AppendJsonProperty(name_15, value_15, &json_object);
+  AppendJsonProperty(name_16, value_16, &json_object);
   return json_object;
 }
 
@@ -374,35 +406,37 @@ template <typename Value1, typename Value2, typename Value3, typename Value4,
     typename Value9, typename Value10, typename Value11, typename Value12,
     typename Value13, typename Value14, typename Value15, typename Value16,
     typename Value17>
-JsonValue MakeJsonObject(StringPiece name_1, Value1 value_1,
-    StringPiece name_2, Value2 value_2, StringPiece name_3, Value3 value_3,
-    StringPiece name_4, Value4 value_4, StringPiece name_5, Value5 value_5,
-    StringPiece name_6, Value6 value_6, StringPiece name_7, Value7 value_7,
-    StringPiece name_8, Value8 value_8, StringPiece name_9, Value9 value_9,
-    StringPiece name_10, Value10 value_10, StringPiece name_11,
-    Value11 value_11, StringPiece name_12, Value12 value_12,
-    StringPiece name_13, Value13 value_13, StringPiece name_14,
-    Value14 value_14, StringPiece name_15, Value15 value_15,
-    StringPiece name_16, Value16 value_16, StringPiece name_17,
-    Value17 value_17) {
+JsonValue MakeJsonObject(StringPiece name_1, const Value1& value_1,
+    StringPiece name_2, const Value2& value_2, StringPiece name_3,
+    const Value3& value_3, StringPiece name_4, const Value4& value_4,
+    StringPiece name_5, const Value5& value_5, StringPiece name_6,
+    const Value6& value_6, StringPiece name_7, const Value7& value_7,
+    StringPiece name_8, const Value8& value_8, StringPiece name_9,
+    const Value9& value_9, StringPiece name_10, const Value10& value_10,
+    StringPiece name_11, const Value11& value_11, StringPiece name_12,
+    const Value12& value_12, StringPiece name_13, const Value13& value_13,
+    StringPiece name_14, const Value14& value_14, StringPiece name_15,
+    const Value15& value_15, StringPiece name_16, const Value16& value_16,
+    StringPiece name_17, const Value17& value_17) {
   JsonValue json_object = MakeJsonObject();
-  *json_object.add_object_properties() = MakeJsonProperty(name_1, value_1);
-  *json_object.add_object_properties() = MakeJsonProperty(name_2, value_2);
-  *json_object.add_object_properties() = MakeJsonProperty(name_3, value_3);
-  *json_object.add_object_properties() = MakeJsonProperty(name_4, value_4);
-  *json_object.add_object_properties() = MakeJsonProperty(name_5, value_5);
-  *json_object.add_object_properties() = MakeJsonProperty(name_6, value_6);
-  *json_object.add_object_properties() = MakeJsonProperty(name_7, value_7);
-  *json_object.add_object_properties() = MakeJsonProperty(name_8, value_8);
-  *json_object.add_object_properties() = MakeJsonProperty(name_9, value_9);
-  *json_object.add_object_properties() = MakeJsonProperty(name_10, value_10);
-  *json_object.add_object_properties() = MakeJsonProperty(name_11, value_11);
-  *json_object.add_object_properties() = MakeJsonProperty(name_12, value_12);
-  *json_object.add_object_properties() = MakeJsonProperty(name_13, value_13);
-  *json_object.add_object_properties() = MakeJsonProperty(name_14, value_14);
-  *json_object.add_object_properties() = MakeJsonProperty(name_15, value_15);
-  *json_object.add_object_properties() = MakeJsonProperty(name_16, value_16);
-  *json_object.add_object_properties() = MakeJsonProperty(name_17, value_17);
+  json_object.mutable_object_properties()->Reserve(17);
+  AppendJsonProperty(name_1, value_1, &json_object);
+  AppendJsonProperty(name_2, value_2, &json_object);
+  AppendJsonProperty(name_3, value_3, &json_object);
+  AppendJsonProperty(name_4, value_4, &json_object);
+  AppendJsonProperty(name_5, value_5, &json_object);
+  AppendJsonProperty(name_6, value_6, &json_object);
+  AppendJsonProperty(name_7, value_7, &json_object);
+  AppendJsonProperty(name_8, value_8, &json_object);
+  AppendJsonProperty(name_9, value_9, &json_object);
+  AppendJsonProperty(name_10, value_10, &json_object);
+  AppendJsonProperty(name_11, value_11, &json_object);
+  AppendJsonProperty(name_12, value_12, &json_object);
+  AppendJsonProperty(name_13, value_13, &json_object);
+  AppendJsonProperty(name_14, value_14, &json_object);
+  AppendJsonProperty(name_15, value_15, &json_object);
+  AppendJsonProperty(name_16, value_16, &json_object);
+  AppendJsonProperty(name_17, value_17, &json_object);
   return json_object;
 }
 
@@ -412,36 +446,39 @@ template <typename Value1, typename Value2, typename Value3, typename Value4,
     typename Value9, typename Value10, typename Value11, typename Value12,
     typename Value13, typename Value14, typename Value15, typename Value16,
     typename Value17, typename Value18>
-JsonValue MakeJsonObject(StringPiece name_1, Value1 value_1,
-    StringPiece name_2, Value2 value_2, StringPiece name_3, Value3 value_3,
-    StringPiece name_4, Value4 value_4, StringPiece name_5, Value5 value_5,
-    StringPiece name_6, Value6 value_6, StringPiece name_7, Value7 value_7,
-    StringPiece name_8, Value8 value_8, StringPiece name_9, Value9 value_9,
-    StringPiece name_10, Value10 value_10, StringPiece name_11,
-    Value11 value_11, StringPiece name_12, Value12 value_12,
-    StringPiece name_13, Value13 value_13, StringPiece name_14,
-    Value14 value_14, StringPiece name_15, Value15 value_15,
-    StringPiece name_16, Value16 value_16, StringPiece name_17,
-    Value17 value_17, StringPiece name_18, Value18 value_18) {
+JsonValue MakeJsonObject(StringPiece name_1, const Value1& value_1,
+    StringPiece name_2, const Value2& value_2, StringPiece name_3,
+    const Value3& value_3, StringPiece name_4, const Value4& value_4,
+    StringPiece name_5, const Value5& value_5, StringPiece name_6,
+    const Value6& value_6, StringPiece name_7, const Value7& value_7,
+    StringPiece name_8, const Value8& value_8, StringPiece name_9,
+    const Value9& value_9, StringPiece name_10, const Value10& value_10,
+    StringPiece name_11, const Value11& value_11, StringPiece name_12,
+    const Value12& value_12, StringPiece name_13, const Value13& value_13,
+    StringPiece name_14, const Value14& value_14, StringPiece name_15,
+    const Value15& value_15, StringPiece name_16, const Value16& value_16,
+    StringPiece name_17, const Value17& value_17, StringPiece name_18,
+    const Value18& value_18) {
   JsonValue json_object = MakeJsonObject();
-  *json_object.add_object_properties() = MakeJsonProperty(name_1, value_1);
-  *json_object.add_object_properties() = MakeJsonProperty(name_2, value_2);
-  *json_object.add_object_properties() = MakeJsonProperty(name_3, value_3);
-  *json_object.add_object_properties() = MakeJsonProperty(name_4, value_4);
-  *json_object.add_object_properties() = MakeJsonProperty(name_5, value_5);
-  *json_object.add_object_properties() = MakeJsonProperty(name_6, value_6);
-  *json_object.add_object_properties() = MakeJsonProperty(name_7, value_7);
-  *json_object.add_object_properties() = MakeJsonProperty(name_8, value_8);
-  *json_object.add_object_properties() = MakeJsonProperty(name_9, value_9);
-  *json_object.add_object_properties() = MakeJsonProperty(name_10, value_10);
-  *json_object.add_object_properties() = MakeJsonProperty(name_11, value_11);
-  *json_object.add_object_properties() = MakeJsonProperty(name_12, value_12);
-  *json_object.add_object_properties() = MakeJsonProperty(name_13, value_13);
-  *json_object.add_object_properties() = MakeJsonProperty(name_14, value_14);
-  *json_object.add_object_properties() = MakeJsonProperty(name_15, value_15);
-  *json_object.add_object_properties() = MakeJsonProperty(name_16, value_16);
-  *json_object.add_object_properties() = MakeJsonProperty(name_17, value_17);
-  *json_object.add_object_properties() = MakeJsonProperty(name_18, value_18);
+  json_object.mutable_object_properties()->Reserve(18);
+  AppendJsonProperty(name_1, value_1, &json_object);
+  AppendJsonProperty(name_2, value_2, &json_object);
+  AppendJsonProperty(name_3, value_3, &json_object);
+  AppendJsonProperty(name_4, value_4, &json_object);
+  AppendJsonProperty(name_5, value_5, &json_object);
+  AppendJsonProperty(name_6, value_6, &json_object);
+  AppendJsonProperty(name_7, value_7, &json_object);
+  AppendJsonProperty(name_8, value_8, &json_object);
+  AppendJsonProperty(name_9, value_9, &json_object);
+  AppendJsonProperty(name_10, value_10, &json_object);
+  AppendJsonProperty(name_11, value_11, &json_object);
+  AppendJsonProperty(name_12, value_12, &json_object);
+  AppendJsonProperty(name_13, value_13, &json_object);
+  AppendJsonProperty(name_14, value_14, &json_object);
+  AppendJsonProperty(name_15, value_15, &json_object);
+  AppendJsonProperty(name_16, value_16, &json_object);
+  AppendJsonProperty(name_17, value_17, &json_object);
+  AppendJsonProperty(name_18, value_18, &json_object);
   return json_object;
 }
 
@@ -451,38 +488,40 @@ template <typename Value1, typename Value2, typename Value3, typename Value4,
     typename Value9, typename Value10, typename Value11, typename Value12,
     typename Value13, typename Value14, typename Value15, typename Value16,
     typename Value17, typename Value18, typename Value19>
-JsonValue MakeJsonObject(StringPiece name_1, Value1 value_1,
-    StringPiece name_2, Value2 value_2, StringPiece name_3, Value3 value_3,
-    StringPiece name_4, Value4 value_4, StringPiece name_5, Value5 value_5,
-    StringPiece name_6, Value6 value_6, StringPiece name_7, Value7 value_7,
-    StringPiece name_8, Value8 value_8, StringPiece name_9, Value9 value_9,
-    StringPiece name_10, Value10 value_10, StringPiece name_11,
-    Value11 value_11, StringPiece name_12, Value12 value_12,
-    StringPiece name_13, Value13 value_13, StringPiece name_14,
-    Value14 value_14, StringPiece name_15, Value15 value_15,
-    StringPiece name_16, Value16 value_16, StringPiece name_17,
-    Value17 value_17, StringPiece name_18, Value18 value_18,
-    StringPiece name_19, Value19 value_19) {
+JsonValue MakeJsonObject(StringPiece name_1, const Value1& value_1,
+    StringPiece name_2, const Value2& value_2, StringPiece name_3,
+    const Value3& value_3, StringPiece name_4, const Value4& value_4,
+    StringPiece name_5, const Value5& value_5, StringPiece name_6,
+    const Value6& value_6, StringPiece name_7, const Value7& value_7,
+    StringPiece name_8, const Value8& value_8, StringPiece name_9,
+    const Value9& value_9, StringPiece name_10, const Value10& value_10,
+    StringPiece name_11, const Value11& value_11, StringPiece name_12,
+    const Value12& value_12, StringPiece name_13, const Value13& value_13,
+    StringPiece name_14, const Value14& value_14, StringPiece name_15,
+    const Value15& value_15, StringPiece name_16, const Value16& value_16,
+    StringPiece name_17, const Value17& value_17, StringPiece name_18,
+    const Value18& value_18, StringPiece name_19, const Value19& value_19) {
   JsonValue json_object = MakeJsonObject();
-  *json_object.add_object_properties() = MakeJsonProperty(name_1, value_1);
-  *json_object.add_object_properties() = MakeJsonProperty(name_2, value_2);
-  *json_object.add_object_properties() = MakeJsonProperty(name_3, value_3);
-  *json_object.add_object_properties() = MakeJsonProperty(name_4, value_4);
-  *json_object.add_object_properties() = MakeJsonProperty(name_5, value_5);
-  *json_object.add_object_properties() = MakeJsonProperty(name_6, value_6);
-  *json_object.add_object_properties() = MakeJsonProperty(name_7, value_7);
-  *json_object.add_object_properties() = MakeJsonProperty(name_8, value_8);
-  *json_object.add_object_properties() = MakeJsonProperty(name_9, value_9);
-  *json_object.add_object_properties() = MakeJsonProperty(name_10, value_10);
-  *json_object.add_object_properties() = MakeJsonProperty(name_11, value_11);
-  *json_object.add_object_properties() = MakeJsonProperty(name_12, value_12);
-  *json_object.add_object_properties() = MakeJsonProperty(name_13, value_13);
-  *json_object.add_object_properties() = MakeJsonProperty(name_14, value_14);
-  *json_object.add_object_properties() = MakeJsonProperty(name_15, value_15);
-  *json_object.add_object_properties() = MakeJsonProperty(name_16, value_16);
-  *json_object.add_object_properties() = MakeJsonProperty(name_17, value_17);
-  *json_object.add_object_properties() = MakeJsonProperty(name_18, value_18);
-  *json_object.add_object_properties() = MakeJsonProperty(name_19, value_19);
+  json_object.mutable_object_properties()->Reserve(19);
+  AppendJsonProperty(name_1, value_1, &json_object);
+  AppendJsonProperty(name_2, value_2, &json_object);
+  AppendJsonProperty(name_3, value_3, &json_object);
+  AppendJsonProperty(name_4, value_4, &json_object);
+  AppendJsonProperty(name_5, value_5, &json_object);
+  AppendJsonProperty(name_6, value_6, &json_object);
+  AppendJsonProperty(name_7, value_7, &json_object);
+  AppendJsonProperty(name_8, value_8, &json_object);
+  AppendJsonProperty(name_9, value_9, &json_object);
+  AppendJsonProperty(name_10, value_10, &json_object);
+  AppendJsonProperty(name_11, value_11, &json_object);
+  AppendJsonProperty(name_12, value_12, &json_object);
+  AppendJsonProperty(name_13, value_13, &json_object);
+  AppendJsonProperty(name_14, value_14, &json_object);
+  AppendJsonProperty(name_15, value_15, &json_object);
+  AppendJsonProperty(name_16, value_16, &json_object);
+  AppendJsonProperty(name_17, value_17, &json_object);
+  AppendJsonProperty(name_18, value_18, &json_object);
+  AppendJsonProperty(name_19, value_19, &json_object);
   return json_object;
 }
 
@@ -492,142 +531,155 @@ template <typename Value1, typename Value2, typename Value3, typename Value4,
     typename Value9, typename Value10, typename Value11, typename Value12,
     typename Value13, typename Value14, typename Value15, typename Value16,
     typename Value17, typename Value18, typename Value19, typename Value20>
-JsonValue MakeJsonObject(StringPiece name_1, Value1 value_1,
-    StringPiece name_2, Value2 value_2, StringPiece name_3, Value3 value_3,
-    StringPiece name_4, Value4 value_4, StringPiece name_5, Value5 value_5,
-    StringPiece name_6, Value6 value_6, StringPiece name_7, Value7 value_7,
-    StringPiece name_8, Value8 value_8, StringPiece name_9, Value9 value_9,
-    StringPiece name_10, Value10 value_10, StringPiece name_11,
-    Value11 value_11, StringPiece name_12, Value12 value_12,
-    StringPiece name_13, Value13 value_13, StringPiece name_14,
-    Value14 value_14, StringPiece name_15, Value15 value_15,
-    StringPiece name_16, Value16 value_16, StringPiece name_17,
-    Value17 value_17, StringPiece name_18, Value18 value_18,
-    StringPiece name_19, Value19 value_19, StringPiece name_20,
-    Value20 value_20) {
+JsonValue MakeJsonObject(StringPiece name_1, const Value1& value_1,
+    StringPiece name_2, const Value2& value_2, StringPiece name_3,
+    const Value3& value_3, StringPiece name_4, const Value4& value_4,
+    StringPiece name_5, const Value5& value_5, StringPiece name_6,
+    const Value6& value_6, StringPiece name_7, const Value7& value_7,
+    StringPiece name_8, const Value8& value_8, StringPiece name_9,
+    const Value9& value_9, StringPiece name_10, const Value10& value_10,
+    StringPiece name_11, const Value11& value_11, StringPiece name_12,
+    const Value12& value_12, StringPiece name_13, const Value13& value_13,
+    StringPiece name_14, const Value14& value_14, StringPiece name_15,
+    const Value15& value_15, StringPiece name_16, const Value16& value_16,
+    StringPiece name_17, const Value17& value_17, StringPiece name_18,
+    const Value18& value_18, StringPiece name_19, const Value19& value_19,
+    StringPiece name_20, const Value20& value_20) {
   JsonValue json_object = MakeJsonObject();
-  *json_object.add_object_properties() = MakeJsonProperty(name_1, value_1);
-  *json_object.add_object_properties() = MakeJsonProperty(name_2, value_2);
-  *json_object.add_object_properties() = MakeJsonProperty(name_3, value_3);
-  *json_object.add_object_properties() = MakeJsonProperty(name_4, value_4);
-  *json_object.add_object_properties() = MakeJsonProperty(name_5, value_5);
-  *json_object.add_object_properties() = MakeJsonProperty(name_6, value_6);
-  *json_object.add_object_properties() = MakeJsonProperty(name_7, value_7);
-  *json_object.add_object_properties() = MakeJsonProperty(name_8, value_8);
-  *json_object.add_object_properties() = MakeJsonProperty(name_9, value_9);
-  *json_object.add_object_properties() = MakeJsonProperty(name_10, value_10);
-  *json_object.add_object_properties() = MakeJsonProperty(name_11, value_11);
-  *json_object.add_object_properties() = MakeJsonProperty(name_12, value_12);
-  *json_object.add_object_properties() = MakeJsonProperty(name_13, value_13);
-  *json_object.add_object_properties() = MakeJsonProperty(name_14, value_14);
-  *json_object.add_object_properties() = MakeJsonProperty(name_15, value_15);
-  *json_object.add_object_properties() = MakeJsonProperty(name_16, value_16);
-  *json_object.add_object_properties() = MakeJsonProperty(name_17, value_17);
-  *json_object.add_object_properties() = MakeJsonProperty(name_18, value_18);
-  *json_object.add_object_properties() = MakeJsonProperty(name_19, value_19);
-  *json_object.add_object_properties() = MakeJsonProperty(name_20, value_20);
+  json_object.mutable_object_properties()->Reserve(20);
+  AppendJsonProperty(name_1, value_1, &json_object);
+  AppendJsonProperty(name_2, value_2, &json_object);
+  AppendJsonProperty(name_3, value_3, &json_object);
+  AppendJsonProperty(name_4, value_4, &json_object);
+  AppendJsonProperty(name_5, value_5, &json_object);
+  AppendJsonProperty(name_6, value_6, &json_object);
+  AppendJsonProperty(name_7, value_7, &json_object);
+  AppendJsonProperty(name_8, value_8, &json_object);
+  AppendJsonProperty(name_9, value_9, &json_object);
+  AppendJsonProperty(name_10, value_10, &json_object);
+  AppendJsonProperty(name_11, value_11, &json_object);
+  AppendJsonProperty(name_12, value_12, &json_object);
+  AppendJsonProperty(name_13, value_13, &json_object);
+  AppendJsonProperty(name_14, value_14, &json_object);
+  AppendJsonProperty(name_15, value_15, &json_object);
+  AppendJsonProperty(name_16, value_16, &json_object);
+  AppendJsonProperty(name_17, value_17, &json_object);
+  AppendJsonProperty(name_18, value_18, &json_object);
+  AppendJsonProperty(name_19, value_19, &json_object);
+  AppendJsonProperty(name_20, value_20, &json_object);
   return json_object;
 }
 
 
 template <typename Value1>
-JsonValue MakeJsonArray(Value1 value_1) {
+JsonValue MakeJsonArray(const Value1& value_1) {
   JsonValue json_array = MakeJsonArray();
-  *json_array.add_array_elements() = MakeJsonValue(value_1);
+  json_array.mutable_array_elements()->Reserve(1);
+  AppendJsonElement(value_1, &json_array);
   return json_array;
 }
 
 
 template <typename Value1, typename Value2>
-JsonValue MakeJsonArray(Value1 value_1, Value2 value_2) {
+JsonValue MakeJsonArray(const Value1& value_1, const Value2& value_2) {
   JsonValue json_array = MakeJsonArray();
-  *json_array.add_array_elements() = MakeJsonValue(value_1);
-  *json_array.add_array_elements() = MakeJsonValue(value_2);
+  json_array.mutable_array_elements()->Reserve(2);
+  AppendJsonElement(value_1, &json_array);
+  AppendJsonElement(value_2, &json_array);
   return json_array;
 }
 
 
 template <typename Value1, typename Value2, typename Value3>
-JsonValue MakeJsonArray(Value1 value_1, Value2 value_2, Value3 value_3) {
+JsonValue MakeJsonArray(const Value1& value_1, const Value2& value_2,
+    const Value3& value_3) {
   JsonValue json_array = MakeJsonArray();
-  *json_array.add_array_elements() = MakeJsonValue(value_1);
-  *json_array.add_array_elements() = MakeJsonValue(value_2);
-  *json_array.add_array_elements() = MakeJsonValue(value_3);
+  json_array.mutable_array_elements()->Reserve(3);
+  AppendJsonElement(value_1, &json_array);
+  AppendJsonElement(value_2, &json_array);
+  AppendJsonElement(value_3, &json_array);
   return json_array;
 }
 
 
 template <typename Value1, typename Value2, typename Value3, typename Value4>
-JsonValue MakeJsonArray(Value1 value_1, Value2 value_2, Value3 value_3,
-    Value4 value_4) {
+JsonValue MakeJsonArray(const Value1& value_1, const Value2& value_2,
+    const Value3& value_3, const Value4& value_4) {
   JsonValue json_array = MakeJsonArray();
-  *json_array.add_array_elements() = MakeJsonValue(value_1);
-  *json_array.add_array_elements() = MakeJsonValue(value_2);
-  *json_array.add_array_elements() = MakeJsonValue(value_3);
-  *json_array.add_array_elements() = MakeJsonValue(value_4);
+  json_array.mutable_array_elements()->Reserve(4);
+  AppendJsonElement(value_1, &json_array);
+  AppendJsonElement(value_2, &json_array);
+  AppendJsonElement(value_3, &json_array);
+  AppendJsonElement(value_4, &json_array);
   return json_array;
 }
 
 
 template <typename Value1, typename Value2, typename Value3, typename Value4,
     typename Value5>
-JsonValue MakeJsonArray(Value1 value_1, Value2 value_2, Value3 value_3,
-    Value4 value_4, Value5 value_5) {
+JsonValue MakeJsonArray(const Value1& value_1, const Value2& value_2,
+    const Value3& value_3, const Value4& value_4, const Value5& value_5) {
   JsonValue json_array = MakeJsonArray();
-  *json_array.add_array_elements() = MakeJsonValue(value_1);
-  *json_array.add_array_elements() = MakeJsonValue(value_2);
-  *json_array.add_array_elements() = MakeJsonValue(value_3);
-  *json_array.add_array_elements() = MakeJsonValue(value_4);
-  *json_array.add_array_elements() = MakeJsonValue(value_5);
+  json_array.mutable_array_elements()->Reserve(5);
+  AppendJsonElement(value_1, &json_array);
+  AppendJsonElement(value_2, &json_array);
+  AppendJsonElement(value_3, &json_array);
+  AppendJsonElement(value_4, &json_array);
+  AppendJsonElement(value_5, &json_array);
   return json_array;
 }
 
 
 template <typename Value1, typename Value2, typename Value3, typename Value4,
     typename Value5, typename Value6>
-JsonValue MakeJsonArray(Value1 value_1, Value2 value_2, Value3 value_3,
-    Value4 value_4, Value5 value_5, Value6 value_6) {
+JsonValue MakeJsonArray(const Value1& value_1, const Value2& value_2,
+    const Value3& value_3, const Value4& value_4, const Value5& value_5,
+    const Value6& value_6) {
   JsonValue json_array = MakeJsonArray();
-  *json_array.add_array_elements() = MakeJsonValue(value_1);
-  *json_array.add_array_elements() = MakeJsonValue(value_2);
-  *json_array.add_array_elements() = MakeJsonValue(value_3);
-  *json_array.add_array_elements() = MakeJsonValue(value_4);
-  *json_array.add_array_elements() = MakeJsonValue(value_5);
-  *json_array.add_array_elements() = MakeJsonValue(value_6);
+  json_array.mutable_array_elements()->Reserve(6);
+  AppendJsonElement(value_1, &json_array);
+  AppendJsonElement(value_2, &json_array);
+  AppendJsonElement(value_3, &json_array);
+  AppendJsonElement(value_4, &json_array);
+  AppendJsonElement(value_5, &json_array);
+  AppendJsonElement(value_6, &json_array);
   return json_array;
 }
 
 
 template <typename Value1, typename Value2, typename Value3, typename Value4,
     typename Value5, typename Value6, typename Value7>
-JsonValue MakeJsonArray(Value1 value_1, Value2 value_2, Value3 value_3,
-    Value4 value_4, Value5 value_5, Value6 value_6, Value7 value_7) {
+JsonValue MakeJsonArray(const Value1& value_1, const Value2& value_2,
+    const Value3& value_3, const Value4& value_4, const Value5& value_5,
+    const Value6& value_6, const Value7& value_7) {
   JsonValue json_array = MakeJsonArray();
-  *json_array.add_array_elements() = MakeJsonValue(value_1);
-  *json_array.add_array_elements() = MakeJsonValue(value_2);
-  *json_array.add_array_elements() = MakeJsonValue(value_3);
-  *json_array.add_array_elements() = MakeJsonValue(value_4);
-  *json_array.add_array_elements() = MakeJsonValue(value_5);
-  *json_array.add_array_elements() = MakeJsonValue(value_6);
-  *json_array.add_array_elements() = MakeJsonValue(value_7);
+  json_array.mutable_array_elements()->Reserve(7);
+  AppendJsonElement(value_1, &json_array);
+  AppendJsonElement(value_2, &json_array);
+  AppendJsonElement(value_3, &json_array);
+  AppendJsonElement(value_4, &json_array);
+  AppendJsonElement(value_5, &json_array);
+  AppendJsonElement(value_6, &json_array);
+  AppendJsonElement(value_7, &json_array);
   return json_array;
 }
 
 
 template <typename Value1, typename Value2, typename Value3, typename Value4,
     typename Value5, typename Value6, typename Value7, typename Value8>
-JsonValue MakeJsonArray(Value1 value_1, Value2 value_2, Value3 value_3,
-    Value4 value_4, Value5 value_5, Value6 value_6, Value7 value_7,
-    Value8 value_8) {
+JsonValue MakeJsonArray(const Value1& value_1, const Value2& value_2,
+    const Value3& value_3, const Value4& value_4, const Value5& value_5,
+    const Value6& value_6, const Value7& value_7, const Value8& value_8) {
   JsonValue json_array = MakeJsonArray();
-  *json_array.add_array_elements() = MakeJsonValue(value_1);
-  *json_array.add_array_elements() = MakeJsonValue(value_2);
-  *json_array.add_array_elements() = MakeJsonValue(value_3);
-  *json_array.add_array_elements() = MakeJsonValue(value_4);
-  *json_array.add_array_elements() = MakeJsonValue(value_5);
-  *json_array.add_array_elements() = MakeJsonValue(value_6);
-  *json_array.add_array_elements() = MakeJsonValue(value_7);
-  *json_array.add_array_elements() = MakeJsonValue(value_8);
+  json_array.mutable_array_elements()->Reserve(8);
+  AppendJsonElement(value_1, &json_array);
+  AppendJsonElement(value_2, &json_array);
+  AppendJsonElement(value_3, &json_array);
+  AppendJsonElement(value_4, &json_array);
+  AppendJsonElement(value_5, &json_array);
+  AppendJsonElement(value_6, &json_array);
+  AppendJsonElement(value_7, &json_array);
+  AppendJsonElement(value_8, &json_array);
   return json_array;
 }
 
@@ -635,19 +687,21 @@ JsonValue MakeJsonArray(Value1 value_1, Value2 value_2, Value3 value_3,
 template <typename Value1, typename Value2, typename Value3, typename Value4,
     typename Value5, typename Value6, typename Value7, typename Value8,
     typename Value9>
-JsonValue MakeJsonArray(Value1 value_1, Value2 value_2, Value3 value_3,
-    Value4 value_4, Value5 value_5, Value6 value_6, Value7 value_7,
-    Value8 value_8, Value9 value_9) {
+JsonValue MakeJsonArray(const Value1& value_1, const Value2& value_2,
+    const Value3& value_3, const Value4& value_4, const Value5& value_5,
+    const Value6& value_6, const Value7& value_7, const Value8& value_8,
+    const Value9& value_9) {
   JsonValue json_array = MakeJsonArray();
-  *json_array.add_array_elements() = MakeJsonValue(value_1);
-  *json_array.add_array_elements() = MakeJsonValue(value_2);
-  *json_array.add_array_elements() = MakeJsonValue(value_3);
-  *json_array.add_array_elements() = MakeJsonValue(value_4);
-  *json_array.add_array_elements() = MakeJsonValue(value_5);
-  *json_array.add_array_elements() = MakeJsonValue(value_6);
-  *json_array.add_array_elements() = MakeJsonValue(value_7);
-  *json_array.add_array_elements() = MakeJsonValue(value_8);
-  *json_array.add_array_elements() = MakeJsonValue(value_9);
+  json_array.mutable_array_elements()->Reserve(9);
+  AppendJsonElement(value_1, &json_array);
+  AppendJsonElement(value_2, &json_array);
+  AppendJsonElement(value_3, &json_array);
+  AppendJsonElement(value_4, &json_array);
+  AppendJsonElement(value_5, &json_array);
+  AppendJsonElement(value_6, &json_array);
+  AppendJsonElement(value_7, &json_array);
+  AppendJsonElement(value_8, &json_array);
+  AppendJsonElement(value_9, &json_array);
   return json_array;
 }
 
@@ -655,20 +709,22 @@ JsonValue MakeJsonArray(Value1 value_1, Value2 value_2, Value3 value_3,
 template <typename Value1, typename Value2, typename Value3, typename Value4,
     typename Value5, typename Value6, typename Value7, typename Value8,
     typename Value9, typename Value10>
-JsonValue MakeJsonArray(Value1 value_1, Value2 value_2, Value3 value_3,
-    Value4 value_4, Value5 value_5, Value6 value_6, Value7 value_7,
-    Value8 value_8, Value9 value_9, Value10 value_10) {
+JsonValue MakeJsonArray(const Value1& value_1, const Value2& value_2,
+    const Value3& value_3, const Value4& value_4, const Value5& value_5,
+    const Value6& value_6, const Value7& value_7, const Value8& value_8,
+    const Value9& value_9, const Value10& value_10) {
   JsonValue json_array = MakeJsonArray();
-  *json_array.add_array_elements() = MakeJsonValue(value_1);
-  *json_array.add_array_elements() = MakeJsonValue(value_2);
-  *json_array.add_array_elements() = MakeJsonValue(value_3);
-  *json_array.add_array_elements() = MakeJsonValue(value_4);
-  *json_array.add_array_elements() = MakeJsonValue(value_5);
-  *json_array.add_array_elements() = MakeJsonValue(value_6);
-  *json_array.add_array_elements() = MakeJsonValue(value_7);
-  *json_array.add_array_elements() = MakeJsonValue(value_8);
-  *json_array.add_array_elements() = MakeJsonValue(value_9);
-  *json_array.add_array_elements() = MakeJsonValue(value_10);
+  json_array.mutable_array_elements()->Reserve(10);
+  AppendJsonElement(value_1, &json_array);
+  AppendJsonElement(value_2, &json_array);
+  AppendJsonElement(value_3, &json_array);
+  AppendJsonElement(value_4, &json_array);
+  AppendJsonElement(value_5, &json_array);
+  AppendJsonElement(value_6, &json_array);
+  AppendJsonElement(value_7, &json_array);
+  AppendJsonElement(value_8, &json_array);
+  AppendJsonElement(value_9, &json_array);
+  AppendJsonElement(value_10, &json_array);
   return json_array;
 }
 
@@ -676,21 +732,23 @@ JsonValue MakeJsonArray(Value1 value_1, Value2 value_2, Value3 value_3,
 template <typename Value1, typename Value2, typename Value3, typename Value4,
     typename Value5, typename Value6, typename Value7, typename Value8,
     typename Value9, typename Value10, typename Value11>
-JsonValue MakeJsonArray(Value1 value_1, Value2 value_2, Value3 value_3,
-    Value4 value_4, Value5 value_5, Value6 value_6, Value7 value_7,
-    Value8 value_8, Value9 value_9, Value10 value_10, Value11 value_11) {
+JsonValue MakeJsonArray(const Value1& value_1, const Value2& value_2,
+    const Value3& value_3, const Value4& value_4, const Value5& value_5,
+    const Value6& value_6, const Value7& value_7, const Value8& value_8,
+    const Value9& value_9, const Value10& value_10, const Value11& value_11) {
   JsonValue json_array = MakeJsonArray();
-  *json_array.add_array_elements() = MakeJsonValue(value_1);
-  *json_array.add_array_elements() = MakeJsonValue(value_2);
-  *json_array.add_array_elements() = MakeJsonValue(value_3);
-  *json_array.add_array_elements() = MakeJsonValue(value_4);
-  *json_array.add_array_elements() = MakeJsonValue(value_5);
-  *json_array.add_array_elements() = MakeJsonValue(value_6);
-  *json_array.add_array_elements() = MakeJsonValue(value_7);
-  *json_array.add_array_elements() = MakeJsonValue(value_8);
-  *json_array.add_array_elements() = MakeJsonValue(value_9);
-  *json_array.add_array_elements() = MakeJsonValue(value_10);
-  *json_array.add_array_elements() = MakeJsonValue(value_11);
+  json_array.mutable_array_elements()->Reserve(11);
+  AppendJsonElement(value_1, &json_array);
+  AppendJsonElement(value_2, &json_array);
+  AppendJsonElement(value_3, &json_array);
+  AppendJsonElement(value_4, &json_array);
+  AppendJsonElement(value_5, &json_array);
+  AppendJsonElement(value_6, &json_array);
+  AppendJsonElement(value_7, &json_array);
+  AppendJsonElement(value_8, &json_array);
+  AppendJsonElement(value_9, &json_array);
+  AppendJsonElement(value_10, &json_array);
+  AppendJsonElement(value_11, &json_array);
   return json_array;
 }
 
@@ -698,23 +756,25 @@ JsonValue MakeJsonArray(Value1 value_1, Value2 value_2, Value3 value_3,
 template <typename Value1, typename Value2, typename Value3, typename Value4,
     typename Value5, typename Value6, typename Value7, typename Value8,
     typename Value9, typename Value10, typename Value11, typename Value12>
-JsonValue MakeJsonArray(Value1 value_1, Value2 value_2, Value3 value_3,
-    Value4 value_4, Value5 value_5, Value6 value_6, Value7 value_7,
-    Value8 value_8, Value9 value_9, Value10 value_10, Value11 value_11,
-    Value12 value_12) {
+JsonValue MakeJsonArray(const Value1& value_1, const Value2& value_2,
+    const Value3& value_3, const Value4& value_4, const Value5& value_5,
+    const Value6& value_6, const Value7& value_7, const Value8& value_8,
+    const Value9& value_9, const Value10& value_10, const Value11& value_11,
+    const Value12& value_12) {
   JsonValue json_array = MakeJsonArray();
-  *json_array.add_array_elements() = MakeJsonValue(value_1);
-  *json_array.add_array_elements() = MakeJsonValue(value_2);
-  *json_array.add_array_elements() = MakeJsonValue(value_3);
-  *json_array.add_array_elements() = MakeJsonValue(value_4);
-  *json_array.add_array_elements() = MakeJsonValue(value_5);
-  *json_array.add_array_elements() = MakeJsonValue(value_6);
-  *json_array.add_array_elements() = MakeJsonValue(value_7);
-  *json_array.add_array_elements() = MakeJsonValue(value_8);
-  *json_array.add_array_elements() = MakeJsonValue(value_9);
-  *json_array.add_array_elements() = MakeJsonValue(value_10);
-  *json_array.add_array_elements() = MakeJsonValue(value_11);
-  *json_array.add_array_elements() = MakeJsonValue(value_12);
+  json_array.mutable_array_elements()->Reserve(12);
+  AppendJsonElement(value_1, &json_array);
+  AppendJsonElement(value_2, &json_array);
+  AppendJsonElement(value_3, &json_array);
+  AppendJsonElement(value_4, &json_array);
+  AppendJsonElement(value_5, &json_array);
+  AppendJsonElement(value_6, &json_array);
+  AppendJsonElement(value_7, &json_array);
+  AppendJsonElement(value_8, &json_array);
+  AppendJsonElement(value_9, &json_array);
+  AppendJsonElement(value_10, &json_array);
+  AppendJsonElement(value_11, &json_array);
+  AppendJsonElement(value_12, &json_array);
   return json_array;
 }
 
@@ -723,24 +783,26 @@ template <typename Value1, typename Value2, typename Value3, typename Value4,
     typename Value5, typename Value6, typename Value7, typename Value8,
     typename Value9, typename Value10, typename Value11, typename Value12,
     typename Value13>
-JsonValue MakeJsonArray(Value1 value_1, Value2 value_2, Value3 value_3,
-    Value4 value_4, Value5 value_5, Value6 value_6, Value7 value_7,
-    Value8 value_8, Value9 value_9, Value10 value_10, Value11 value_11,
-    Value12 value_12, Value13 value_13) {
+JsonValue MakeJsonArray(const Value1& value_1, const Value2& value_2,
+    const Value3& value_3, const Value4& value_4, const Value5& value_5,
+    const Value6& value_6, const Value7& value_7, const Value8& value_8,
+    const Value9& value_9, const Value10& value_10, const Value11& value_11,
+    const Value12& value_12, const Value13& value_13) {
   JsonValue json_array = MakeJsonArray();
-  *json_array.add_array_elements() = MakeJsonValue(value_1);
-  *json_array.add_array_elements() = MakeJsonValue(value_2);
-  *json_array.add_array_elements() = MakeJsonValue(value_3);
-  *json_array.add_array_elements() = MakeJsonValue(value_4);
-  *json_array.add_array_elements() = MakeJsonValue(value_5);
-  *json_array.add_array_elements() = MakeJsonValue(value_6);
-  *json_array.add_array_elements() = MakeJsonValue(value_7);
-  *json_array.add_array_elements() = MakeJsonValue(value_8);
-  *json_array.add_array_elements() = MakeJsonValue(value_9);
-  *json_array.add_array_elements() = MakeJsonValue(value_10);
-  *json_array.add_array_elements() = MakeJsonValue(value_11);
-  *json_array.add_array_elements() = MakeJsonValue(value_12);
-  *json_array.add_array_elements() = MakeJsonValue(value_13);
+  json_array.mutable_array_elements()->Reserve(13);
+  AppendJsonElement(value_1, &json_array);
+  AppendJsonElement(value_2, &json_array);
+  AppendJsonElement(value_3, &json_array);
+  AppendJsonElement(value_4, &json_array);
+  AppendJsonElement(value_5, &json_array);
+  AppendJsonElement(value_6, &json_array);
+  AppendJsonElement(value_7, &json_array);
+  AppendJsonElement(value_8, &json_array);
+  AppendJsonElement(value_9, &json_array);
+  AppendJsonElement(value_10, &json_array);
+  AppendJsonElement(value_11, &json_array);
+  AppendJsonElement(value_12, &json_array);
+  AppendJsonElement(value_13, &json_array);
   return json_array;
 }
 
@@ -749,25 +811,28 @@ template <typename Value1, typename Value2, typename Value3, typename Value4,
     typename Value5, typename Value6, typename Value7, typename Value8,
     typename Value9, typename Value10, typename Value11, typename Value12,
     typename Value13, typename Value14>
-JsonValue MakeJsonArray(Value1 value_1, Value2 value_2, Value3 value_3,
-    Value4 value_4, Value5 value_5, Value6 value_6, Value7 value_7,
-    Value8 value_8, Value9 value_9, Value10 value_10, Value11 value_11,
-    Value12 value_12, Value13 value_13, Value14 value_14) {
+JsonValue MakeJsonArray(const Value1& value_1, const Value2& value_2,
+    const Value3& value_3, const Value4& value_4, const Value5& value_5,
+    const Value6& value_6, const Value7& value_7, const Value8& value_8,
+    const Value9& value_9, const Value10& value_10, const Value11& value_11,
+    const Value12& value_12, const Value13& value_13,
+    const Value14& value_14) {
   JsonValue json_array = MakeJsonArray();
-  *json_array.add_array_elements() = MakeJsonValue(value_1);
-  *json_array.add_array_elements() = MakeJsonValue(value_2);
-  *json_array.add_array_elements() = MakeJsonValue(value_3);
-  *json_array.add_array_elements() = MakeJsonValue(value_4);
-  *json_array.add_array_elements() = MakeJsonValue(value_5);
-  *json_array.add_array_elements() = MakeJsonValue(value_6);
-  *json_array.add_array_elements() = MakeJsonValue(value_7);
-  *json_array.add_array_elements() = MakeJsonValue(value_8);
-  *json_array.add_array_elements() = MakeJsonValue(value_9);
-  *json_array.add_array_elements() = MakeJsonValue(value_10);
-  *json_array.add_array_elements() = MakeJsonValue(value_11);
-  *json_array.add_array_elements() = MakeJsonValue(value_12);
-  *json_array.add_array_elements() = MakeJsonValue(value_13);
-  *json_array.add_array_elements() = MakeJsonValue(value_14);
+  json_array.mutable_array_elements()->Reserve(14);
+  AppendJsonElement(value_1, &json_array);
+  AppendJsonElement(value_2, &json_array);
+  AppendJsonElement(value_3, &json_array);
+  AppendJsonElement(value_4, &json_array);
+  AppendJsonElement(value_5, &json_array);
+  AppendJsonElement(value_6, &json_array);
+  AppendJsonElement(value_7, &json_array);
+  AppendJsonElement(value_8, &json_array);
+  AppendJsonElement(value_9, &json_array);
+  AppendJsonElement(value_10, &json_array);
+  AppendJsonElement(value_11, &json_array);
+  AppendJsonElement(value_12, &json_array);
+  AppendJsonElement(value_13, &json_array);
+  AppendJsonElement(value_14, &json_array);
   return json_array;
 }
 
@@ -776,26 +841,29 @@ template <typename Value1, typename Value2, typename Value3, typename Value4,
     typename Value5, typename Value6, typename Value7, typename Value8,
     typename Value9, typename Value10, typename Value11, typename Value12,
     typename Value13, typename Value14, typename Value15>
-JsonValue MakeJsonArray(Value1 value_1, Value2 value_2, Value3 value_3,
-    Value4 value_4, Value5 value_5, Value6 value_6, Value7 value_7,
-    Value8 value_8, Value9 value_9, Value10 value_10, Value11 value_11,
-    Value12 value_12, Value13 value_13, Value14 value_14, Value15 value_15) {
+JsonValue MakeJsonArray(const Value1& value_1, const Value2& value_2,
+    const Value3& value_3, const Value4& value_4, const Value5& value_5,
+    const Value6& value_6, const Value7& value_7, const Value8& value_8,
+    const Value9& value_9, const Value10& value_10, const Value11& value_11,
+    const Value12& value_12, const Value13& value_13, const Value14& value_14,
+    const Value15& value_15) {
   JsonValue json_array = MakeJsonArray();
-  *json_array.add_array_elements() = MakeJsonValue(value_1);
-  *json_array.add_array_elements() = MakeJsonValue(value_2);
-  *json_array.add_array_elements() = MakeJsonValue(value_3);
-  *json_array.add_array_elements() = MakeJsonValue(value_4);
-  *json_array.add_array_elements() = MakeJsonValue(value_5);
-  *json_array.add_array_elements() = MakeJsonValue(value_6);
-  *json_array.add_array_elements() = MakeJsonValue(value_7);
-  *json_array.add_array_elements() = MakeJsonValue(value_8);
-  *json_array.add_array_elements() = MakeJsonValue(value_9);
-  *json_array.add_array_elements() = MakeJsonValue(value_10);
-  *json_array.add_array_elements() = MakeJsonValue(value_11);
-  *json_array.add_array_elements() = MakeJsonValue(value_12);
-  *json_array.add_array_elements() = MakeJsonValue(value_13);
-  *json_array.add_array_elements() = MakeJsonValue(value_14);
-  *json_array.add_array_elements() = MakeJsonValue(value_15);
+  json_array.mutable_array_elements()->Reserve(15);
+  AppendJsonElement(value_1, &json_array);
+  AppendJsonElement(value_2, &json_array);
+  AppendJsonElement(value_3, &json_array);
+  AppendJsonElement(value_4, &json_array);
+  AppendJsonElement(value_5, &json_array);
+  AppendJsonElement(value_6, &json_array);
+  AppendJsonElement(value_7, &json_array);
+  AppendJsonElement(value_8, &json_array);
+  AppendJsonElement(value_9, &json_array);
+  AppendJsonElement(value_10, &json_array);
+  AppendJsonElement(value_11, &json_array);
+  AppendJsonElement(value_12, &json_array);
+  AppendJsonElement(value_13, &json_array);
+  AppendJsonElement(value_14, &json_array);
+  AppendJsonElement(value_15, &json_array);
   return json_array;
 }
 
@@ -804,28 +872,30 @@ template <typename Value1, typename Value2, typename Value3, typename Value4,
     typename Value5, typename Value6, typename Value7, typename Value8,
     typename Value9, typename Value10, typename Value11, typename Value12,
     typename Value13, typename Value14, typename Value15, typename Value16>
-JsonValue MakeJsonArray(Value1 value_1, Value2 value_2, Value3 value_3,
-    Value4 value_4, Value5 value_5, Value6 value_6, Value7 value_7,
-    Value8 value_8, Value9 value_9, Value10 value_10, Value11 value_11,
-    Value12 value_12, Value13 value_13, Value14 value_14, Value15 value_15,
-    Value16 value_16) {
+JsonValue MakeJsonArray(const Value1& value_1, const Value2& value_2,
+    const Value3& value_3, const Value4& value_4, const Value5& value_5,
+    const Value6& value_6, const Value7& value_7, const Value8& value_8,
+    const Value9& value_9, const Value10& value_10, const Value11& value_11,
+    const Value12& value_12, const Value13& value_13, const Value14& value_14,
+    const Value15& value_15, const Value16& value_16) {
   JsonValue json_array = MakeJsonArray();
-  *json_array.add_array_elements() = MakeJsonValue(value_1);
-  *json_array.add_array_elements() = MakeJsonValue(value_2);
-  *json_array.add_array_elements() = MakeJsonValue(value_3);
-  *json_array.add_array_elements() = MakeJsonValue(value_4);
-  *json_array.add_array_elements() = MakeJsonValue(value_5);
-  *json_array.add_array_elements() = MakeJsonValue(value_6);
-  *json_array.add_array_elements() = MakeJsonValue(value_7);
-  *json_array.add_array_elements() = MakeJsonValue(value_8);
-  *json_array.add_array_elements() = MakeJsonValue(value_9);
-  *json_array.add_array_elements() = MakeJsonValue(value_10);
-  *json_array.add_array_elements() = MakeJsonValue(value_11);
-  *json_array.add_array_elements() = MakeJsonValue(value_12);
-  *json_array.add_array_elements() = MakeJsonValue(value_13);
-  *json_array.add_array_elements() = MakeJsonValue(value_14);
-  *json_array.add_array_elements() = MakeJsonValue(value_15);
-  *json_array.add_array_elements() = MakeJsonValue(value_16);
+  json_array.mutable_array_elements()->Reserve(16);
+  AppendJsonElement(value_1, &json_array);
+  AppendJsonElement(value_2, &json_array);
+  AppendJsonElement(value_3, &json_array);
+  AppendJsonElement(value_4, &json_array);
+  AppendJsonElement(value_5, &json_array);
+  AppendJsonElement(value_6, &json_array);
+  AppendJsonElement(value_7, &json_array);
+  AppendJsonElement(value_8, &json_array);
+  AppendJsonElement(value_9, &json_array);
+  AppendJsonElement(value_10, &json_array);
+  AppendJsonElement(value_11, &json_array);
+  AppendJsonElement(value_12, &json_array);
+  AppendJsonElement(value_13, &json_array);
+  AppendJsonElement(value_14, &json_array);
+  AppendJsonElement(value_15, &json_array);
+  AppendJsonElement(value_16, &json_array);
   return json_array;
 }
 
@@ -835,29 +905,32 @@ template <typename Value1, typename Value2, typename Value3, typename Value4,
     typename Value9, typename Value10, typename Value11, typename Value12,
     typename Value13, typename Value14, typename Value15, typename Value16,
     typename Value17>
-JsonValue MakeJsonArray(Value1 value_1, Value2 value_2, Value3 value_3,
-    Value4 value_4, Value5 value_5, Value6 value_6, Value7 value_7,
-    Value8 value_8, Value9 value_9, Value10 value_10, Value11 value_11,
-    Value12 value_12, Value13 value_13, Value14 value_14, Value15 value_15,
-    Value16 value_16, Value17 value_17) {
+JsonValue MakeJsonArray(const Value1& value_1, const Value2& value_2,
+    const Value3& value_3, const Value4& value_4, const Value5& value_5,
+    const Value6& value_6, const Value7& value_7, const Value8& value_8,
+    const Value9& value_9, const Value10& value_10, const Value11& value_11,
+    const Value12& value_12, const Value13& value_13, const Value14& value_14,
+    const Value15& value_15, const Value16& value_16,
+    const Value17& value_17) {
   JsonValue json_array = MakeJsonArray();
-  *json_array.add_array_elements() = MakeJsonValue(value_1);
-  *json_array.add_array_elements() = MakeJsonValue(value_2);
-  *json_array.add_array_elements() = MakeJsonValue(value_3);
-  *json_array.add_array_elements() = MakeJsonValue(value_4);
-  *json_array.add_array_elements() = MakeJsonValue(value_5);
-  *json_array.add_array_elements() = MakeJsonValue(value_6);
-  *json_array.add_array_elements() = MakeJsonValue(value_7);
-  *json_array.add_array_elements() = MakeJsonValue(value_8);
-  *json_array.add_array_elements() = MakeJsonValue(value_9);
-  *json_array.add_array_elements() = MakeJsonValue(value_10);
-  *json_array.add_array_elements() = MakeJsonValue(value_11);
-  *json_array.add_array_elements() = MakeJsonValue(value_12);
-  *json_array.add_array_elements() = MakeJsonValue(value_13);
-  *json_array.add_array_elements() = MakeJsonValue(value_14);
-  *json_array.add_array_elements() = MakeJsonValue(value_15);
-  *json_array.add_array_elements() = MakeJsonValue(value_16);
-  *json_array.add_array_elements() = MakeJsonValue(value_17);
+  json_array.mutable_array_elements()->Reserve(17);
+  AppendJsonElement(value_1, &json_array);
+  AppendJsonElement(value_2, &json_array);
+  AppendJsonElement(value_3, &json_array);
+  AppendJsonElement(value_4, &json_array);
+  AppendJsonElement(value_5, &json_array);
+  AppendJsonElement(value_6, &json_array);
+  AppendJsonElement(value_7, &json_array);
+  AppendJsonElement(value_8, &json_array);
+  AppendJsonElement(value_9, &json_array);
+  AppendJsonElement(value_10, &json_array);
+  AppendJsonElement(value_11, &json_array);
+  AppendJsonElement(value_12, &json_array);
+  AppendJsonElement(value_13, &json_array);
+  AppendJsonElement(value_14, &json_array);
+  AppendJsonElement(value_15, &json_array);
+  AppendJsonElement(value_16, &json_array);
+  AppendJsonElement(value_17, &json_array);
   return json_array;
 }
 
@@ -867,30 +940,33 @@ template <typename Value1, typename Value2, typename Value3, typename Value4,
     typename Value9, typename Value10, typename Value11, typename Value12,
     typename Value13, typename Value14, typename Value15, typename Value16,
     typename Value17, typename Value18>
-JsonValue MakeJsonArray(Value1 value_1, Value2 value_2, Value3 value_3,
-    Value4 value_4, Value5 value_5, Value6 value_6, Value7 value_7,
-    Value8 value_8, Value9 value_9, Value10 value_10, Value11 value_11,
-    Value12 value_12, Value13 value_13, Value14 value_14, Value15 value_15,
-    Value16 value_16, Value17 value_17, Value18 value_18) {
+JsonValue MakeJsonArray(const Value1& value_1, const Value2& value_2,
+    const Value3& value_3, const Value4& value_4, const Value5& value_5,
+    const Value6& value_6, const Value7& value_7, const Value8& value_8,
+    const Value9& value_9, const Value10& value_10, const Value11& value_11,
+    const Value12& value_12, const Value13& value_13, const Value14& value_14,
+    const Value15& value_15, const Value16& value_16, const Value17& value_17,
+    const Value18& value_18) {
   JsonValue json_array = MakeJsonArray();
-  *json_array.add_array_elements() = MakeJsonValue(value_1);
-  *json_array.add_array_elements() = MakeJsonValue(value_2);
-  *json_array.add_array_elements() = MakeJsonValue(value_3);
-  *json_array.add_array_elements() = MakeJsonValue(value_4);
-  *json_array.add_array_elements() = MakeJsonValue(value_5);
-  *json_array.add_array_elements() = MakeJsonValue(value_6);
-  *json_array.add_array_elements() = MakeJsonValue(value_7);
-  *json_array.add_array_elements() = MakeJsonValue(value_8);
-  *json_array.add_array_elements() = MakeJsonValue(value_9);
-  *json_array.add_array_elements() = MakeJsonValue(value_10);
-  *json_array.add_array_elements() = MakeJsonValue(value_11);
-  *json_array.add_array_elements() = MakeJsonValue(value_12);
-  *json_array.add_array_elements() = MakeJsonValue(value_13);
-  *json_array.add_array_elements() = MakeJsonValue(value_14);
-  *json_array.add_array_elements() = MakeJsonValue(value_15);
-  *json_array.add_array_elements() = MakeJsonValue(value_16);
-  *json_array.add_array_elements() = MakeJsonValue(value_17);
-  *json_array.add_array_elements() = MakeJsonValue(value_18);
+  json_array.mutable_array_elements()->Reserve(18);
+  AppendJsonElement(value_1, &json_array);
+  AppendJsonElement(value_2, &json_array);
+  AppendJsonElement(value_3, &json_array);
+  AppendJsonElement(value_4, &json_array);
+  AppendJsonElement(value_5, &json_array);
+  AppendJsonElement(value_6, &json_array);
+  AppendJsonElement(value_7, &json_array);
+  AppendJsonElement(value_8, &json_array);
+  AppendJsonElement(value_9, &json_array);
+  AppendJsonElement(value_10, &json_array);
+  AppendJsonElement(value_11, &json_array);
+  AppendJsonElement(value_12, &json_array);
+  AppendJsonElement(value_13, &json_array);
+  AppendJsonElement(value_14, &json_array);
+  AppendJsonElement(value_15, &json_array);
+  AppendJsonElement(value_16, &json_array);
+  AppendJsonElement(value_17, &json_array);
+  AppendJsonElement(value_18, &json_array);
   return json_array;
 }
 
@@ -900,31 +976,34 @@ template <typename Value1, typename Value2, typename Value3, typename Value4,
     typename Value9, typename Value10, typename Value11, typename Value12,
     typename Value13, typename Value14, typename Value15, typename Value16,
     typename Value17, typename Value18, typename Value19>
-JsonValue MakeJsonArray(Value1 value_1, Value2 value_2, Value3 value_3,
-    Value4 value_4, Value5 value_5, Value6 value_6, Value7 value_7,
-    Value8 value_8, Value9 value_9, Value10 value_10, Value11 value_11,
-    Value12 value_12, Value13 value_13, Value14 value_14, Value15 value_15,
-    Value16 value_16, Value17 value_17, Value18 value_18, Value19 value_19) {
+JsonValue MakeJsonArray(const Value1& value_1, const Value2& value_2,
+    const Value3& value_3, const Value4& value_4, const Value5& value_5,
+    const Value6& value_6, const Value7& value_7, const Value8& value_8,
+    const Value9& value_9, const Value10& value_10, const Value11& value_11,
+    const Value12& value_12, const Value13& value_13, const Value14& value_14,
+    const Value15& value_15, const Value16& value_16, const Value17& value_17,
+    const Value18& value_18, const Value19& value_19) {
   JsonValue json_array = MakeJsonArray();
-  *json_array.add_array_elements() = MakeJsonValue(value_1);
-  *json_array.add_array_elements() = MakeJsonValue(value_2);
-  *json_array.add_array_elements() = MakeJsonValue(value_3);
-  *json_array.add_array_elements() = MakeJsonValue(value_4);
-  *json_array.add_array_elements() = MakeJsonValue(value_5);
-  *json_array.add_array_elements() = MakeJsonValue(value_6);
-  *json_array.add_array_elements() = MakeJsonValue(value_7);
-  *json_array.add_array_elements() = MakeJsonValue(value_8);
-  *json_array.add_array_elements() = MakeJsonValue(value_9);
-  *json_array.add_array_elements() = MakeJsonValue(value_10);
-  *json_array.add_array_elements() = MakeJsonValue(value_11);
-  *json_array.add_array_elements() = MakeJsonValue(value_12);
-  *json_array.add_array_elements() = MakeJsonValue(value_13);
-  *json_array.add_array_elements() = MakeJsonValue(value_14);
-  *json_array.add_array_elements() = MakeJsonValue(value_15);
-  *json_array.add_array_elements() = MakeJsonValue(value_16);
-  *json_array.add_array_elements() = MakeJsonValue(value_17);
-  *json_array.add_array_elements() = MakeJsonValue(value_18);
-  *json_array.add_array_elements() = MakeJsonValue(value_19);
+  json_array.mutable_array_elements()->Reserve(19);
+  AppendJsonElement(value_1, &json_array);
+  AppendJsonElement(value_2, &json_array);
+  AppendJsonElement(value_3, &json_array);
+  AppendJsonElement(value_4, &json_array);
+  AppendJsonElement(value_5, &json_array);
+  AppendJsonElement(value_6, &json_array);
+  AppendJsonElement(value_7, &json_array);
+  AppendJsonElement(value_8, &json_array);
+  AppendJsonElement(value_9, &json_array);
+  AppendJsonElement(value_10, &json_array);
+  AppendJsonElement(value_11, &json_array);
+  AppendJsonElement(value_12, &json_array);
+  AppendJsonElement(value_13, &json_array);
+  AppendJsonElement(value_14, &json_array);
+  AppendJsonElement(value_15, &json_array);
+  AppendJsonElement(value_16, &json_array);
+  AppendJsonElement(value_17, &json_array);
+  AppendJsonElement(value_18, &json_array);
+  AppendJsonElement(value_19, &json_array);
   return json_array;
 }
 
@@ -934,33 +1013,36 @@ template <typename Value1, typename Value2, typename Value3, typename Value4,
     typename Value9, typename Value10, typename Value11, typename Value12,
     typename Value13, typename Value14, typename Value15, typename Value16,
     typename Value17, typename Value18, typename Value19, typename Value20>
-JsonValue MakeJsonArray(Value1 value_1, Value2 value_2, Value3 value_3,
-    Value4 value_4, Value5 value_5, Value6 value_6, Value7 value_7,
-    Value8 value_8, Value9 value_9, Value10 value_10, Value11 value_11,
-    Value12 value_12, Value13 value_13, Value14 value_14, Value15 value_15,
-    Value16 value_16, Value17 value_17, Value18 value_18, Value19 value_19,
-    Value20 value_20) {
+JsonValue MakeJsonArray(const Value1& value_1, const Value2& value_2,
+    const Value3& value_3, const Value4& value_4, const Value5& value_5,
+    const Value6& value_6, const Value7& value_7, const Value8& value_8,
+    const Value9& value_9, const Value10& value_10, const Value11& value_11,
+    const Value12& value_12, const Value13& value_13, const Value14& value_14,
+    const Value15& value_15, const Value16& value_16, const Value17& value_17,
+    const Value18& value_18, const Value19& value_19,
+    const Value20& value_20) {
   JsonValue json_array = MakeJsonArray();
-  *json_array.add_array_elements() = MakeJsonValue(value_1);
-  *json_array.add_array_elements() = MakeJsonValue(value_2);
-  *json_array.add_array_elements() = MakeJsonValue(value_3);
-  *json_array.add_array_elements() = MakeJsonValue(value_4);
-  *json_array.add_array_elements() = MakeJsonValue(value_5);
-  *json_array.add_array_elements() = MakeJsonValue(value_6);
-  *json_array.add_array_elements() = MakeJsonValue(value_7);
-  *json_array.add_array_elements() = MakeJsonValue(value_8);
-  *json_array.add_array_elements() = MakeJsonValue(value_9);
-  *json_array.add_array_elements() = MakeJsonValue(value_10);
-  *json_array.add_array_elements() = MakeJsonValue(value_11);
-  *json_array.add_array_elements() = MakeJsonValue(value_12);
-  *json_array.add_array_elements() = MakeJsonValue(value_13);
-  *json_array.add_array_elements() = MakeJsonValue(value_14);
-  *json_array.add_array_elements() = MakeJsonValue(value_15);
-  *json_array.add_array_elements() = MakeJsonValue(value_16);
-  *json_array.add_array_elements() = MakeJsonValue(value_17);
-  *json_array.add_array_elements() = MakeJsonValue(value_18);
-  *json_array.add_array_elements() = MakeJsonValue(value_19);
-  *json_array.add_array_elements() = MakeJsonValue(value_20);
+  json_array.mutable_array_elements()->Reserve(20);
+  AppendJsonElement(value_1, &json_array);
+  AppendJsonElement(value_2, &json_array);
+  AppendJsonElement(value_3, &json_array);
+  AppendJsonElement(value_4, &json_array);
+  AppendJsonElement(value_5, &json_array);
+  AppendJsonElement(value_6, &json_array);
+  AppendJsonElement(value_7, &json_array);
+  AppendJsonElement(value_8, &json_array);
+  AppendJsonElement(value_9, &json_array);
+  AppendJsonElement(value_10, &json_array);
+  AppendJsonElement(value_11, &json_array);
+  AppendJsonElement(value_12, &json_array);
+  AppendJsonElement(value_13, &json_array);
+  AppendJsonElement(value_14, &json_array);
+  AppendJsonElement(value_15, &json_array);
+  AppendJsonElement(value_16, &json_array);
+  AppendJsonElement(value_17, &json_array);
+  AppendJsonElement(value_18, &json_array);
+  AppendJsonElement(value_19, &json_array);
+  AppendJsonElement(value_20, &json_array);
   return json_array;
 }
 
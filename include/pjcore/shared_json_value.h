@@ -0,0 +1,152 @@
+// JSON [de]serialization for protobuf + embedded HTTP server and client in C++.
+// Copyright (C) 2014 http://protojson.com/
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+
+#ifndef PJCORE_SHARED_JSON_VALUE_H_
+#define PJCORE_SHARED_JSON_VALUE_H_
+
+#include <map>
+#include <string>
+
+#include "pjcore/third_party/chromium/macros.h"
+#include "pjcore/third_party/chromium/ref_counted.h"
+#include "pjcore/third_party/chromium/string_piece.h"
+
+#include "pjcore/json.pb.h"
+#include "pjcore/make_json_value.h"
+
+namespace pjcore {
+
+/**
+ * Immutable JSON tree whose copies share nodes. Copying is O(1), and the
+ * Mutable* methods copy only the shared nodes on the path to the change.
+ * Converts to and from JsonValue at API boundaries. Properties are kept
+ * normalized as by NormalizeJsonProperties, so lookups are binary searches.
+ */
+class SharedJsonValue {
+ public:
+  // Null value.
+  SharedJsonValue();
+
+  explicit SharedJsonValue(const JsonValue& value);
+
+  // Moves strings out of value instead of copying them, leaving it cleared.
+  explicit SharedJsonValue(JsonValue* value);
+
+  SharedJsonValue(const SharedJsonValue& other);
+
+  ~SharedJsonValue();
+
+  SharedJsonValue& operator=(const SharedJsonValue& other);
+
+  JsonValue::Type type() const;
+
+  bool bool_value() const;
+
+  int64_t signed_value() const;
+
+  uint64_t unsigned_value() const;
+
+  double double_value() const;
+
+  const std::string& string_value() const;
+
+  int object_properties_size() const;
+
+  const std::string& object_property_name(int index) const;
+
+  const SharedJsonValue& object_property_value(int index) const;
+
+  bool HasProperty(StringPiece name) const;
+
+  // Returns null for a missing property, like GetJsonProperty.
+  const SharedJsonValue& GetProperty(StringPiece name) const;
+
+  int array_elements_size() const;
+
+  const SharedJsonValue& array_elements(int index) const;
+
+  // Adds a null property when missing. Requires TYPE_OBJECT.
+  SharedJsonValue* MutableProperty(StringPiece name);
+
+  void ClearProperty(StringPiece name);
+
+  SharedJsonValue* MutableArrayElement(int index);
+
+  SharedJsonValue* AddArrayElement();
+
+  // Whether both values refer to the same node, as after copying.
+  bool IsSharedWith(const SharedJsonValue& other) const;
+
+  void CopyTo(JsonValue* value) const;
+
+ private:
+  friend class SharedJsonValueInterner;
+
+  class Node;
+
+  const Node& node() const;
+
+  Node* mutable_node();
+
+  scoped_refptr<Node> node_;
+};
+
+const SharedJsonValue& SharedJsonNull();
+
+SharedJsonValue MakeSharedJsonObject();
+
+SharedJsonValue MakeSharedJsonArray();
+
+template <typename Value>
+SharedJsonValue MakeSharedJsonValue(const Value& value) {
+  return SharedJsonValue(MakeJsonValue(value));
+}
+
+JsonValue MakeJsonValue(const SharedJsonValue& value);
+
+/**
+ * Hash-consing table: values interned by one interner share a single node
+ * for every distinct subtree, so interned subtrees are identical exactly
+ * when IsSharedWith. Number types are kept, so 1 and 1.0 stay distinct.
+ */
+class SharedJsonValueInterner {
+ public:
+  SharedJsonValueInterner();
+
+  ~SharedJsonValueInterner();
+
+  SharedJsonValue Intern(const JsonValue& value);
+
+  // Number of distinct nodes.
+  size_t size() const { return nodes_.size(); }
+
+  void Clear();
+
+ private:
+  typedef std::multimap<uint64_t, SharedJsonValue> NodeMap;
+
+  SharedJsonValue InternRecursive(const JsonValue& value, uint64_t* hash);
+
+  NodeMap nodes_;
+
+  DISALLOW_COPY_AND_ASSIGN(SharedJsonValueInterner);
+};
+
+}  // namespace pjcore
+
+#endif  // PJCORE_SHARED_JSON_VALUE_H_
@@ -25,6 +25,10 @@
 
 namespace pjcore {
 
+class JsonFieldMask;
+
+class JsonTokenizer;
+
 bool UnboxJsonValue(const JsonValue& json_value, bool* bool_value,
                     Error* error);
 
@@ -57,11 +61,58 @@ bool UnboxJsonValue(const JsonValue& json_value, double* double_value,
 bool UnboxJsonValue(const JsonValue& json_value, std::string* string_value,
                     Error* error);
 
+// Same as above, but for the scalar value at the current token.
+bool UnboxJsonValue(const JsonTokenizer& tokenizer, bool* bool_value,
+                    Error* error);
+
+bool UnboxJsonValue(const JsonTokenizer& tokenizer, int32_t* signed_value,
+                    Error* error);
+
+bool UnboxJsonValue(const JsonTokenizer& tokenizer, int64_t* signed_value,
+                    Error* error);
+
+bool UnboxJsonValue(const JsonTokenizer& tokenizer, uint32_t* unsigned_value,
+                    Error* error);
+
+bool UnboxJsonValue(const JsonTokenizer& tokenizer, uint64_t* unsigned_value,
+                    Error* error);
+
+bool UnboxJsonValue(const JsonTokenizer& tokenizer, float* float_value,
+                    Error* error);
+
+bool UnboxJsonValue(const JsonTokenizer& tokenizer, double* double_value,
+                    Error* error);
+
+bool UnboxJsonValue(const JsonTokenizer& tokenizer, std::string* string_value,
+                    Error* error);
+
 bool UnboxJsonValue(const JsonValue& json_value,
                     google::protobuf::Message* message, Error* error,
                     google::protobuf::RepeatedPtrField<JsonValue::Property>*
                         unknown_object_properties = NULL);
 
+// Same as above, but steals strings and subtrees from consumed_json_value
+// instead of copying them. On return, consumed_json_value is left cleared on
+// success, or in an unspecified but valid state on failure.
+bool UnboxJsonValue(JsonValue* consumed_json_value,
+                    google::protobuf::Message* message, Error* error,
+                    google::protobuf::RepeatedPtrField<JsonValue::Property>*
+                        unknown_object_properties = NULL);
+
+// Same as above, but skips properties outside mask, which are neither unboxed
+// nor reported as unknown.
+bool UnboxJsonValue(const JsonValue& json_value,
+                    google::protobuf::Message* message, Error* error,
+                    const JsonFieldMask& mask,
+                    google::protobuf::RepeatedPtrField<JsonValue::Property>*
+                        unknown_object_properties = NULL);
+
+bool UnboxJsonValue(JsonValue* consumed_json_value,
+                    google::protobuf::Message* message, Error* error,
+                    const JsonFieldMask& mask,
+                    google::protobuf::RepeatedPtrField<JsonValue::Property>*
+                        unknown_object_properties = NULL);
+
 bool UnboxJsonValue(const JsonValue& json_value, JsonValue* json_value_copy,
                     Error* error);
 
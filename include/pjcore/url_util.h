@@ -27,8 +27,19 @@
 
 namespace pjcore {
 
+// Also decodes the query into parameters unless decode_parameters is false,
+// for callers that route on the path alone and call ParseUrlParameters or
+// GetUrlParameter only when they need the query.
 bool ParseUrl(StringPiece url, bool is_connect, ParsedUrl* parsed_url,
-              Error* error);
+              Error* error, bool decode_parameters = true);
+
+// Decodes query into parameters, skipping those that fail to decode or have
+// empty names, as ParseUrl does.
+void ParseUrlParameters(ParsedUrl* parsed_url);
+
+// Decodes the value of the first parameter of query named name, as
+// ParseUrlParameters would, without decoding the other parameters.
+bool GetUrlParameter(StringPiece query, StringPiece name, std::string* value);
 
 bool EncodeUri(StringPiece uri, std::string* encoded_uri);
 bool DecodeUri(StringPiece encoded_uri, std::string* uri);
@@ -0,0 +1,271 @@
+// This file was GENERATED by command:
+//     pump.py write_json_pump.h.pump
+// DO NOT EDIT BY HAND!!!
+
+// JSON [de]serialization for protobuf + embedded HTTP server and client in C++.
+// Copyright (C) 2014 http://protojson.com/
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+#ifndef PJCORE_WRITE_JSON_PUMP_H_
+#define PJCORE_WRITE_JSON_PUMP_H_
+
+#include <string>
+
+#include "pjcore/json_writer.h"
+
+namespace pjcore {
+
+template <typename Value1>
+void WriteJsonObject(JsonWriter* writer, StringPiece name_1,
+    const Value1& value_1) {
+  writer->BeginObject();
+  writer->Key(name_1);
+  WriteJsonValue(value_1, writer);
+  writer->EndObject();
+}
+
+
+template <typename Value1>
+std::string WriteJsonObject(StringPiece name_1, const Value1& value_1) {
+  std::string output;
+  JsonWriter writer(&output);
+  WriteJsonObject(&writer, name_1, value_1);
+  return output;
+}
+
+
+template <typename Value1, typename Value2>
+void WriteJsonObject(JsonWriter* writer, StringPiece name_1,
+    const Value1& value_1, StringPiece name_2, const Value2& value_2) {
+  writer->BeginObject();
+  writer->Key(name_1);
+  WriteJsonValue(value_1, writer);
+  writer->Key(name_2);
+  WriteJsonValue(value_2, writer);
+  writer->EndObject();
+}
+
+
+template <typename Value1, typename Value2>
+std::string WriteJsonObject(StringPiece name_1, const Value1& value_1,
+    StringPiece name_2, const Value2& value_2) {
+  std::string output;
+  JsonWriter writer(&output);
+  WriteJsonObject(&writer, name_1, value_1, name_2, value_2);
+  return output;
+}
+
+
+template <typename Value1, typename Value2, typename Value3>
+void WriteJsonObject(JsonWriter* writer, StringPiece name_1,
+    const Value1& value_1, StringPiece name_2, const Value2& value_2,
+    StringPiece name_3, const Value3& value_3) {
+  writer->BeginObject();
+  writer->Key(name_1);
+  WriteJsonValue(value_1, writer);
+  writer->Key(name_2);
+  WriteJsonValue(value_2, writer);
+  writer->Key(name_3);
+  WriteJsonValue(value_3, writer);
+  writer->EndObject();
+}
+
+
+template <typename Value1, typename Value2, typename Value3>
+std::string WriteJsonObject(StringPiece name_1, const Value1& value_1,
+    StringPiece name_2, const Value2& value_2, StringPiece name_3,
+    const Value3& value_3) {
+  std::string output;
+  JsonWriter writer(&output);
+  WriteJsonObject(&writer, name_1, value_1, name_2, value_2, name_3, value_3);
+  return output;
+}
+
+
+template <typename Value1, typename Value2, typename Value3, typename Value4>
+void WriteJsonObject(JsonWriter* writer, StringPiece name_1,
+    const Value1& value_1, StringPiece name_2, const Value2& value_2,
+    StringPiece name_3, const Value3& value_3, StringPiece name_4,
+    const Value4& value_4) {
+  writer->BeginObject();
+  writer->Key(name_1);
+  WriteJsonValue(value_1, writer);
+  writer->Key(name_2);
+  WriteJsonValue(value_2, writer);
+  writer->Key(name_3);
+  WriteJsonValue(value_3, writer);
+  writer->Key(name_4);
+  WriteJsonValue(value_4, writer);
+  writer->EndObject();
+}
+
+
+template <typename Value1, typename Value2, typename Value3, typename Value4>
+std::string WriteJsonObject(StringPiece name_1, const Value1& value_1,
+    StringPiece name_2, const Value2& value_2, StringPiece name_3,
+    const Value3& value_3, StringPiece name_4, const Value4& value_4) {
+  std::string output;
+  JsonWriter writer(&output);
+  WriteJsonObject(&writer, name_1, value_1, name_2, value_2, name_3, value_3,
+    name_4, value_4);
+  return output;
+}
+
+
+template <typename Value1, typename Value2, typename Value3, typename Value4,
+    typename Value5>
+void WriteJsonObject(JsonWriter* writer, StringPiece name_1,
+    const Value1& value_1, StringPiece name_2, const Value2& value_2,
+    StringPiece name_3, const Value3& value_3, StringPiece name_4,
+    const Value4& value_4, StringPiece name_5, const Value5& value_5) {
+  writer->BeginObject();
+  writer->Key(name_1);
+  WriteJsonValue(value_1, writer);
+  writer->Key(name_2);
+  WriteJsonValue(value_2, writer);
+  writer->Key(name_3);
+  WriteJsonValue(value_3, writer);
+  writer->Key(name_4);
+  WriteJsonValue(value_4, writer);
+  writer->Key(name_5);
+  WriteJsonValue(value_5, writer);
+  writer->EndObject();
+}
+
+
+template <typename Value1, typename Value2, typename Value3, typename Value4,
+    typename Value5>
+std::string WriteJsonObject(StringPiece name_1, const Value1& value_1,
+    StringPiece name_2, const Value2& value_2, StringPiece name_3,
+    const Value3& value_3, StringPiece name_4, const Value4& value_4,
+    StringPiece name_5, const Value5& value_5) {
+  std::string output;
+  JsonWriter writer(&output);
+  WriteJsonObject(&writer, name_1, value_1, name_2, value_2, name_3, value_3,
+    name_4, value_4, name_5, value_5);
+  return output;
+}
+
+
+template <typename Value1>
+void WriteJsonArray(JsonWriter* writer, const Value1& value_1) {
+  writer->BeginArray();
+  WriteJsonValue(value_1, writer);
+  writer->EndArray();
+}
+
+
+template <typename Value1>
+std::string WriteJsonArray(const Value1& value_1) {
+  std::string output;
+  JsonWriter writer(&output);
+  WriteJsonArray(&writer, value_1);
+  return output;
+}
+
+
+template <typename Value1, typename Value2>
+void WriteJsonArray(JsonWriter* writer, const Value1& value_1,
+    const Value2& value_2) {
+  writer->BeginArray();
+  WriteJsonValue(value_1, writer);
+  WriteJsonValue(value_2, writer);
+  writer->EndArray();
+}
+
+
+template <typename Value1, typename Value2>
+std::string WriteJsonArray(const Value1& value_1, const Value2& value_2) {
+  std::string output;
+  JsonWriter writer(&output);
+  WriteJsonArray(&writer, value_1, value_2);
+  return output;
+}
+
+
+template <typename Value1, typename Value2, typename Value3>
+void WriteJsonArray(JsonWriter* writer, const Value1& value_1,
+    const Value2& value_2, const Value3& value_3) {
+  writer->BeginArray();
+  WriteJsonValue(value_1, writer);
+  WriteJsonValue(value_2, writer);
+  WriteJsonValue(value_3, writer);
+  writer->EndArray();
+}
+
+
+template <typename Value1, typename Value2, typename Value3>
+std::string WriteJsonArray(const Value1& value_1, const Value2& value_2,
+    const Value3& value_3) {
+  std::string output;
+  JsonWriter writer(&output);
+  WriteJsonArray(&writer, value_1, value_2, value_3);
+  return output;
+}
+
+
+template <typename Value1, typename Value2, typename Value3, typename Value4>
+void WriteJsonArray(JsonWriter* writer, const Value1& value_1,
+    const Value2& value_2, const Value3& value_3, const Value4& value_4) {
+  writer->BeginArray();
+  WriteJsonValue(value_1, writer);
+  WriteJsonValue(value_2, writer);
+  WriteJsonValue(value_3, writer);
+  WriteJsonValue(value_4, writer);
+  writer->EndArray();
+}
+
+
+template <typename Value1, typename Value2, typename Value3, typename Value4>
+std::string WriteJsonArray(const Value1& value_1, const Value2& value_2,
+    const Value3& value_3, const Value4& value_4) {
+  std::string output;
+  JsonWriter writer(&output);
+  WriteJsonArray(&writer, value_1, value_2, value_3, value_4);
+  return output;
+}
+
+
+template <typename Value1, typename Value2, typename Value3, typename Value4,
+    typename Value5>
+void WriteJsonArray(JsonWriter* writer, const Value1& value_1,
+    const Value2& value_2, const Value3& value_3, const Value4& value_4,
+    const Value5& value_5) {
+  writer->BeginArray();
+  WriteJsonValue(value_1, writer);
+  WriteJsonValue(value_2, writer);
+  WriteJsonValue(value_3, writer);
+  WriteJsonValue(value_4, writer);
+  WriteJsonValue(value_5, writer);
+  writer->EndArray();
+}
+
+
+template <typename Value1, typename Value2, typename Value3, typename Value4,
+    typename Value5>
+std::string WriteJsonArray(const Value1& value_1, const Value2& value_2,
+    const Value3& value_3, const Value4& value_4, const Value5& value_5) {
+  std::string output;
+  JsonWriter writer(&output);
+  WriteJsonArray(&writer, value_1, value_2, value_3, value_4, value_5);
+  return output;
+}
+
+
+
+}  // namespace pjcore
+
+#endif  // PJCORE_WRITE_JSON_PUMP_H_
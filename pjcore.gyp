@@ -191,6 +191,23 @@
       ],
     },
 
+    {
+      'target_name': 'protoc-gen-pjcore',
+      'type': 'executable',
+      'include_dirs': [
+        'include',
+        'src',
+        'external/protobuf/src',
+      ],
+      'dependencies': [
+        'protobuf',
+      ],
+      'sources': [
+        'src/protoc_gen_pjcore/json_codec_generator.cc',
+        'src/protoc_gen_pjcore/main.cc',
+      ],
+    },
+
     {
       'target_name': 'pjcore',
       'type': 'static_library',
@@ -220,6 +237,8 @@
         'src/pjcore/abstract_http_server_core.cc',
         'src/pjcore/abstract_uv.cc',
         'src/pjcore/auto_callback.cc',
+        'src/pjcore/base_64_simd.cc',
+        'src/pjcore/char_set_simd.cc',
         'src/pjcore/errno_description.cc',
         'src/pjcore/error.pb.cc',
         'src/pjcore/error_util.cc',
@@ -238,8 +257,21 @@
         'src/pjcore/http_server_transaction.cc',
         'src/pjcore/http_util.cc',
         'src/pjcore/idle_logger.cc',
+        'src/pjcore/json_async.cc',
+        'src/pjcore/json_binary.cc',
+        'src/pjcore/json_binding.cc',
+        'src/pjcore/json_body_handler.cc',
+        'src/pjcore/json_codec.cc',
+        'src/pjcore/json_delta_handler.cc',
+        'src/pjcore/json_document.cc',
+        'src/pjcore/json_field_mask.cc',
+        'src/pjcore/json_parallel_writer.cc',
+        'src/pjcore/json_patch.cc',
         'src/pjcore/json_properties.cc',
         'src/pjcore/json_reader.cc',
+        'src/pjcore/json_snapshot.cc',
+        'src/pjcore/json_tokenizer.cc',
+        'src/pjcore/json_transcoder.cc',
         'src/pjcore/json_util.cc',
         'src/pjcore/json.pb.cc',
         'src/pjcore/json_writer.cc',
@@ -255,7 +287,9 @@
         'src/pjcore/number_util.cc',
         'src/pjcore/shared_addr_info_list.cc',
         'src/pjcore/shared_future.cc',
+        'src/pjcore/shared_json_value.cc',
         'src/pjcore/shared_uv_loop.cc',
+        'src/pjcore/simd_level.cc',
         'src/pjcore/string_piece_util.cc',
         'src/pjcore/text_location.cc',
         'src/pjcore/third_party/chromium/atomicops_internals_x86_gcc.cc',
@@ -308,8 +342,20 @@
         'src/pjcore_test/http_server_core_test.cc',
         'src/pjcore_test/http_server_test.cc',
         'src/pjcore_test/http_server_transaction_test.cc',
+        'src/pjcore_test/json_async_test.cc',
+        'src/pjcore_test/json_binary_test.cc',
+        'src/pjcore_test/json_binding_test.cc',
+        'src/pjcore_test/json_body_handler_test.cc',
+        'src/pjcore_test/json_codec_test.cc',
+        'src/pjcore_test/json_delta_handler_test.cc',
+        'src/pjcore_test/json_document_test.cc',
+        'src/pjcore_test/json_field_mask_test.cc',
+        'src/pjcore_test/json_parallel_writer_test.cc',
+        'src/pjcore_test/json_patch_test.cc',
         'src/pjcore_test/json_properties_test.cc',
         'src/pjcore_test/json_reader_test.cc',
+        'src/pjcore_test/json_snapshot_test.cc',
+        'src/pjcore_test/json_transcoder_test.cc',
         'src/pjcore_test/json_util_test.cc',
         'src/pjcore_test/json_writer_test.cc',
         'src/pjcore_test/live_capturable_test.cc',
@@ -325,8 +371,11 @@
         'src/pjcore_test/name_value_util_test.cc',
         'src/pjcore_test/number_util_test.cc',
         'src/pjcore_test/parse_url_test.cc',
+        'src/pjcore_test/read_json_or_die.cc',
+        'src/pjcore_test/shared_json_value_test.cc',
         'src/pjcore_test/shared_uv_loop_test.cc',
         'src/pjcore_test/test_message.pb.cc',
+        'src/pjcore_test/test_message.pjcore.cc',
         'src/pjcore_test/text_location_test.cc',
         'src/pjcore_test/unbox_json_value_message_test.cc',
         'src/pjcore_test/unbox_json_value_test.cc',
@@ -374,6 +423,28 @@
       ],
     },
 
+    {
+      'target_name': 'benchmark_make_json_value',
+      'type': 'executable',
+      'dependencies': [
+        'pjcore',
+        'protobuf',
+        'external/libuv/uv.gyp:libuv',
+        'external/http-parser/http_parser.gyp:http_parser',
+      ],
+      'include_dirs': [
+        'include',
+        'src',
+        'external/protobuf/src',
+        'external/libuv/include',
+        'external/http-parser',
+      ],
+      'sources': [
+        'benchmark/make_json_value/make_json_value.cc',
+        'src/pjcore_test/test_message.pb.cc',
+      ],
+    },
+
     {
       'target_name': 'use_case_output_json',
       'type': 'executable',
@@ -5,8 +5,10 @@ set -e
 if [ "$(uname -s)" == "Darwin" ]
 then
   PROTOC=./build/Debug/protoc
+  PROTOC_GEN_PJCORE=./build/Debug/protoc-gen-pjcore
 else
   PROTOC=./out/Debug/protoc
+  PROTOC_GEN_PJCORE=./out/Debug/protoc-gen-pjcore
 fi
 
 find include src -type f -name '*.proto' |
@@ -21,6 +23,13 @@ do
   fi
 done
 
+for PROTO_FILE in src/pjcore_test/test_message.proto
+do
+  echo Running protoc-gen-pjcore for $PROTO_FILE
+  $PROTOC --plugin=protoc-gen-pjcore=$PROTOC_GEN_PJCORE \
+    --proto_path=include --proto_path=src --pjcore_out=src $PROTO_FILE
+done
+
 find use_cases -type f -name '*.proto' |
 while read PROTO_FILE
 do
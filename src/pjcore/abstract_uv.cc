@@ -92,6 +92,10 @@ class RealUv : public AbstractUv {
   uint64_t timer_get_repeat(const uv_timer_t* handle) {
     return ::uv_timer_get_repeat(handle);
   }
+  int thread_create(uv_thread_t* tid, void (*entry)(void* arg), void* arg) {
+    return ::uv_thread_create(tid, entry, arg);
+  }
+  int thread_join(uv_thread_t* tid) { return ::uv_thread_join(tid); }
   int getaddrinfo(uv_loop_t* loop, uv_getaddrinfo_t* req,
                   uv_getaddrinfo_cb getaddrinfo_cb, const char* node,
                   const char* service, const struct addrinfo* hints) {
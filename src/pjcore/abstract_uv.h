@@ -60,6 +60,9 @@ class AbstractUv {
   virtual int timer_again(uv_timer_t* handle) = 0;
   virtual void timer_set_repeat(uv_timer_t* handle, uint64_t repeat) = 0;
   virtual uint64_t timer_get_repeat(const uv_timer_t* handle) = 0;
+  virtual int thread_create(uv_thread_t* tid, void (*entry)(void* arg),
+                            void* arg) = 0;
+  virtual int thread_join(uv_thread_t* tid) = 0;
   virtual int getaddrinfo(uv_loop_t* loop, uv_getaddrinfo_t* req,
                           uv_getaddrinfo_cb getaddrinfo_cb, const char* node,
                           const char* service,
@@ -0,0 +1,294 @@
+// JSON [de]serialization for protobuf + embedded HTTP server and client in C++.
+// Copyright (C) 2014 http://protojson.com/
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+#include "pjcore/base_64_simd.h"
+
+#include "pjcore/simd_level.h"
+
+#if defined(PJCORE_SIMD)
+#include <immintrin.h>
+#endif
+
+namespace pjcore {
+
+#if defined(PJCORE_SIMD)
+
+namespace {
+
+// Encoding and decoding follow W. Mula and D. Lemire, "Faster Base64 Encoding
+// and Decoding Using AVX2 Instructions", ACM TWEB 12(3), 2018.
+
+__attribute__((target("ssse3"))) __m128i
+EncodeBase64Block128(__m128i input) {
+  // Spreads bytes [3k, 3k + 1, 3k + 2] of the input over 32-bit lane k.
+  __m128i spread = _mm_shuffle_epi8(
+      input, _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+
+  __m128i indices = _mm_or_si128(
+      _mm_mulhi_epu16(_mm_and_si128(spread, _mm_set1_epi32(0x0fc0fc00)),
+                      _mm_set1_epi32(0x04000040)),
+      _mm_mullo_epi16(_mm_and_si128(spread, _mm_set1_epi32(0x003f03f0)),
+                      _mm_set1_epi32(0x01000010)));
+
+  __m128i ranges = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+  ranges = _mm_or_si128(
+      ranges, _mm_and_si128(_mm_cmpgt_epi8(_mm_set1_epi8(26), indices),
+                            _mm_set1_epi8(13)));
+
+  const __m128i offsets =
+      _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                    '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                    '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+
+  return _mm_add_epi8(_mm_shuffle_epi8(offsets, ranges), indices);
+}
+
+// Returns false if the block contains a non-digit, otherwise leaves the 12
+// decoded bytes in the low part of *output.
+__attribute__((target("ssse3"))) bool DecodeBase64Block128(__m128i input,
+                                                             __m128i* output) {
+  const __m128i nibble_mask = _mm_set1_epi8(0x0f);
+
+  __m128i high_nibbles =
+      _mm_and_si128(_mm_srli_epi32(input, 4), nibble_mask);
+  __m128i low_nibbles = _mm_and_si128(input, nibble_mask);
+
+  const __m128i low_classes =
+      _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+                    0x11, 0x13, 0x1a, 0x1b, 0x1b, 0x1b, 0x1a);
+  const __m128i high_classes =
+      _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10,
+                    0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+
+  __m128i invalid =
+      _mm_and_si128(_mm_shuffle_epi8(low_classes, low_nibbles),
+                    _mm_shuffle_epi8(high_classes, high_nibbles));
+  if (_mm_movemask_epi8(_mm_cmpeq_epi8(invalid, _mm_setzero_si128())) !=
+      0xffff) {
+    return false;
+  }
+
+  const __m128i shifts = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0,
+                                       0, 0, 0, 0, 0, 0, 0);
+
+  __m128i values = _mm_add_epi8(
+      input, _mm_shuffle_epi8(
+                 shifts, _mm_add_epi8(_mm_cmpeq_epi8(input, _mm_set1_epi8('/')),
+                                      high_nibbles)));
+
+  __m128i packed = _mm_madd_epi16(
+      _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140)),
+      _mm_set1_epi32(0x00011000));
+
+  *output = _mm_shuffle_epi8(packed,
+                             _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13,
+                                           12, -1, -1, -1, -1));
+  return true;
+}
+
+__attribute__((target("ssse3"))) size_t WriteBase64Ssse3(
+    const uint8_t* binary, size_t binary_length, char* base_64) {
+  const uint8_t* p = binary;
+  char* q = base_64;
+
+  // Each block reads 16 bytes and consumes 12 of them.
+  while (binary_length - (p - binary) >= 16) {
+    __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(q),
+                     EncodeBase64Block128(input));
+    p += 12;
+    q += 16;
+  }
+
+  return p - binary;
+}
+
+__attribute__((target("ssse3"))) size_t ReadBase64Ssse3(
+    const char* base_64, size_t base_64_length, uint8_t* binary) {
+  const char* p = base_64;
+  uint8_t* q = binary;
+
+  // Each block writes 16 bytes of which 12 are kept, so at least 8 more
+  // digits must follow to keep the store inside the output.
+  while (base_64_length - (p - base_64) >= 24) {
+    __m128i output;
+    if (!DecodeBase64Block128(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)), &output)) {
+      break;
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(q), output);
+    p += 16;
+    q += 12;
+  }
+
+  return p - base_64;
+}
+
+__attribute__((target("avx2"))) size_t WriteBase64Avx2(const uint8_t* binary,
+                                                       size_t binary_length,
+                                                       char* base_64) {
+  const uint8_t* p = binary;
+  char* q = base_64;
+
+  const __m256i spread_shuffle = _mm256_setr_epi8(
+      1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10, 1, 0, 2, 1, 4, 3, 5,
+      4, 7, 6, 8, 7, 10, 9, 11, 10);
+  const __m256i offsets = _mm256_setr_epi8(
+      'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+      '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0,
+      'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+      '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+
+  // Each block reads 28 bytes, 12 per lane, and consumes 24 of them.
+  while (binary_length - (p - binary) >= 28) {
+    __m256i input = _mm256_inserti128_si256(
+        _mm256_castsi128_si256(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(p))),
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 12)), 1);
+
+    __m256i spread = _mm256_shuffle_epi8(input, spread_shuffle);
+
+    __m256i indices = _mm256_or_si256(
+        _mm256_mulhi_epu16(
+            _mm256_and_si256(spread, _mm256_set1_epi32(0x0fc0fc00)),
+            _mm256_set1_epi32(0x04000040)),
+        _mm256_mullo_epi16(
+            _mm256_and_si256(spread, _mm256_set1_epi32(0x003f03f0)),
+            _mm256_set1_epi32(0x01000010)));
+
+    __m256i ranges = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+    ranges = _mm256_or_si256(
+        ranges,
+        _mm256_and_si256(_mm256_cmpgt_epi8(_mm256_set1_epi8(26), indices),
+                         _mm256_set1_epi8(13)));
+
+    _mm256_storeu_si256(
+        reinterpret_cast<__m256i*>(q),
+        _mm256_add_epi8(_mm256_shuffle_epi8(offsets, ranges), indices));
+    p += 24;
+    q += 32;
+  }
+
+  return (p - binary) +
+         WriteBase64Ssse3(p, binary_length - (p - binary), q);
+}
+
+__attribute__((target("avx2"))) size_t ReadBase64Avx2(const char* base_64,
+                                                      size_t base_64_length,
+                                                      uint8_t* binary) {
+  const char* p = base_64;
+  uint8_t* q = binary;
+
+  const __m256i nibble_mask = _mm256_set1_epi8(0x0f);
+  const __m256i low_classes = _mm256_setr_epi8(
+      0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1a,
+      0x1b, 0x1b, 0x1b, 0x1a, 0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+      0x11, 0x11, 0x13, 0x1a, 0x1b, 0x1b, 0x1b, 0x1a);
+  const __m256i high_classes = _mm256_setr_epi8(
+      0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10,
+      0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+      0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+  const __m256i shifts = _mm256_setr_epi8(
+      0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0, 0, 16, 19, 4,
+      -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+  const __m256i pack_shuffle = _mm256_setr_epi8(
+      2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1, 2, 1, 0, 6, 5,
+      4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+
+  // Each block writes 32 bytes of which 24 are kept, so at least 12 more
+  // digits must follow to keep the store inside the output.
+  while (base_64_length - (p - base_64) >= 44) {
+    __m256i input = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+
+    __m256i high_nibbles =
+        _mm256_and_si256(_mm256_srli_epi32(input, 4), nibble_mask);
+    __m256i low_nibbles = _mm256_and_si256(input, nibble_mask);
+
+    if (!_mm256_testz_si256(_mm256_shuffle_epi8(low_classes, low_nibbles),
+                            _mm256_shuffle_epi8(high_classes, high_nibbles))) {
+      break;
+    }
+
+    __m256i values = _mm256_add_epi8(
+        input,
+        _mm256_shuffle_epi8(
+            shifts,
+            _mm256_add_epi8(_mm256_cmpeq_epi8(input, _mm256_set1_epi8('/')),
+                            high_nibbles)));
+
+    __m256i packed = _mm256_madd_epi16(
+        _mm256_maddubs_epi16(values, _mm256_set1_epi32(0x01400140)),
+        _mm256_set1_epi32(0x00011000));
+
+    packed = _mm256_permutevar8x32_epi32(
+        _mm256_shuffle_epi8(packed, pack_shuffle),
+        _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7));
+
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(q), packed);
+    p += 32;
+    q += 24;
+  }
+
+  return (p - base_64) +
+         ReadBase64Ssse3(p, base_64_length - (p - base_64), q);
+}
+
+}  // unnamed namespace
+
+size_t WriteBase64Simd(const uint8_t* binary, size_t binary_length,
+                       char* base_64) {
+  switch (GetSimdLevel()) {
+    case SIMD_LEVEL_AVX2:
+      return WriteBase64Avx2(binary, binary_length, base_64);
+
+    case SIMD_LEVEL_SSSE3:
+      return WriteBase64Ssse3(binary, binary_length, base_64);
+
+    default:
+      return 0;
+  }
+}
+
+size_t ReadBase64Simd(const char* base_64, size_t base_64_length,
+                      uint8_t* binary) {
+  switch (GetSimdLevel()) {
+    case SIMD_LEVEL_AVX2:
+      return ReadBase64Avx2(base_64, base_64_length, binary);
+
+    case SIMD_LEVEL_SSSE3:
+      return ReadBase64Ssse3(base_64, base_64_length, binary);
+
+    default:
+      return 0;
+  }
+}
+
+#else  // defined(PJCORE_SIMD)
+
+size_t WriteBase64Simd(const uint8_t* binary, size_t binary_length,
+                       char* base_64) {
+  return 0;
+}
+
+size_t ReadBase64Simd(const char* base_64, size_t base_64_length,
+                      uint8_t* binary) {
+  return 0;
+}
+
+#endif  // defined(PJCORE_SIMD)
+
+}  // namespace pjcore
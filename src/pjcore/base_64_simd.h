@@ -0,0 +1,46 @@
+// JSON [de]serialization for protobuf + embedded HTTP server and client in C++.
+// Copyright (C) 2014 http://protojson.com/
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+#ifndef PJCORE_BASE_64_SIMD_H_
+#define PJCORE_BASE_64_SIMD_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace pjcore {
+
+/**
+ * Encodes the longest prefix of binary the widest available vector unit can
+ * handle in whole 3-byte segments, writing 4 digits per segment to base_64.
+ * Returns the number of bytes consumed, always a multiple of 3 and possibly 0.
+ */
+size_t WriteBase64Simd(const uint8_t* binary, size_t binary_length,
+                       char* base_64);
+
+/**
+ * Decodes the longest prefix of base_64, which must not contain padding, that
+ * the widest available vector unit can handle in whole 4-digit segments.
+ * Stops before the first block containing a non-digit so that the caller
+ * reports it. Writes at most base_64_length / 4 * 3 bytes to binary. Returns
+ * the number of digits consumed, always a multiple of 4 and possibly 0.
+ */
+size_t ReadBase64Simd(const char* base_64, size_t base_64_length,
+                      uint8_t* binary);
+
+}  // namespace pjcore
+
+#endif  // PJCORE_BASE_64_SIMD_H_
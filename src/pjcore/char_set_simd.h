@@ -0,0 +1,60 @@
+// JSON [de]serialization for protobuf + embedded HTTP server and client in C++.
+// Copyright (C) 2014 http://protojson.com/
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+
+#ifndef PJCORE_CHAR_SET_SIMD_H_
+#define PJCORE_CHAR_SET_SIMD_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+namespace pjcore {
+
+/**
+ * Set of ASCII characters in the form the vector units test membership in:
+ * bit h of low_nibble_bits[l] stands for character 16 * h + l. Bytes of
+ * 0x80 and above are never members.
+ */
+struct SimdCharSet {
+  uint8_t low_nibble_bits[16];
+};
+
+template <typename Predicate>
+SimdCharSet MakeSimdCharSet(const Predicate& predicate) {
+  SimdCharSet set;
+  memset(set.low_nibble_bits, 0, sizeof(set.low_nibble_bits));
+  for (int ch = 0; ch < 0x80; ++ch) {
+    if (predicate(static_cast<char>(ch))) {
+      set.low_nibble_bits[ch & 0xf] |= static_cast<uint8_t>(1 << (ch >> 4));
+    }
+  }
+  return set;
+}
+
+/**
+ * Returns the length of a prefix of str made of members of set, scanning
+ * whole blocks of the widest available vector unit. The result stops at the
+ * first non-member in a block, or leaves a remainder shorter than a block to
+ * the caller, and is 0 without a vector unit.
+ */
+size_t SkipCharSetSimd(const char* str, size_t length,
+                       const SimdCharSet& set);
+
+}  // namespace pjcore
+
+#endif  // PJCORE_CHAR_SET_SIMD_H_
@@ -131,7 +131,7 @@ void protobuf_AddDesc_pjcore_2ferror_2eproto() {
     "\t\022+\n\rtext_location\030\r \001(\0132\024.pjcore.TextLo"
     "cation\0225\n\021object_properties\030\016 \003(\0132\032.pjco"
     "re.JsonValue.Property\022\034\n\005cause\030\017 \001(\0132\r.p"
-    "jcore.Error*\304\014\n\016HttpStatusCode\022\035\n\031HTTP_S"
+    "jcore.Error*\343\014\n\016HttpStatusCode\022\035\n\031HTTP_S"
     "TATUS_CODE_CONTINUE\020d\022(\n$HTTP_STATUS_COD"
     "E_SWITCHING_PROTOCOLS\020e\022\030\n\023HTTP_STATUS_C"
     "ODE_OK\020\310\001\022\035\n\030HTTP_STATUS_CODE_CREATED\020\311\001"
@@ -139,39 +139,40 @@ void protobuf_AddDesc_pjcore_2ferror_2eproto() {
     "_STATUS_CODE_NON_AUTHORITATIVE_INFORMATI"
     "ON\020\313\001\022 \n\033HTTP_STATUS_CODE_NO_CONTENT\020\314\001\022"
     "#\n\036HTTP_STATUS_CODE_RESET_CONTENT\020\315\001\022%\n "
-    "HTTP_STATUS_CODE_PARTIAL_CONTENT\020\316\001\022&\n!H"
-    "TTP_STATUS_CODE_MULTIPLE_CHOICES\020\254\002\022\'\n\"H"
-    "TTP_STATUS_CODE_MOVED_PERMANENTLY\020\255\002\022\033\n\026"
-    "HTTP_STATUS_CODE_FOUND\020\256\002\022\037\n\032HTTP_STATUS"
-    "_CODE_SEE_OTHER\020\257\002\022\"\n\035HTTP_STATUS_CODE_N"
-    "OT_MODIFIED\020\260\002\022\037\n\032HTTP_STATUS_CODE_USE_P"
-    "ROXY\020\261\002\022\036\n\031HTTP_STATUS_CODE__UNUSED_\020\262\002\022"
-    "(\n#HTTP_STATUS_CODE_TEMPORARY_REDIRECT\020\263"
-    "\002\022!\n\034HTTP_STATUS_CODE_BAD_REQUEST\020\220\003\022\"\n\035"
-    "HTTP_STATUS_CODE_UNAUTHORIZED\020\221\003\022&\n!HTTP"
-    "_STATUS_CODE_PAYMENT_REQUIRED\020\222\003\022\037\n\032HTTP"
-    "_STATUS_CODE_FORBIDDEN\020\223\003\022\037\n\032HTTP_STATUS"
-    "_CODE_NOT_FOUND\020\224\003\022(\n#HTTP_STATUS_CODE_M"
-    "ETHOD_NOT_ALLOWED\020\225\003\022$\n\037HTTP_STATUS_CODE"
-    "_NOT_ACCEPTABLE\020\226\003\0223\n.HTTP_STATUS_CODE_P"
-    "ROXY_AUTHENTICATION_REQUIRED\020\227\003\022%\n HTTP_"
-    "STATUS_CODE_REQUEST_TIMEOUT\020\230\003\022\036\n\031HTTP_S"
-    "TATUS_CODE_CONFLICT\020\231\003\022\032\n\025HTTP_STATUS_CO"
-    "DE_GONE\020\232\003\022%\n HTTP_STATUS_CODE_LENGTH_RE"
-    "QUIRED\020\233\003\022)\n$HTTP_STATUS_CODE_PRECONDITI"
-    "ON_FAILED\020\234\003\022.\n)HTTP_STATUS_CODE_REQUEST"
-    "_ENTITY_TOO_LARGE\020\235\003\022*\n%HTTP_STATUS_CODE"
-    "_REQUEST_URI_TOO_LONG\020\236\003\022,\n\'HTTP_STATUS_"
-    "CODE_UNSUPPORTED_MEDIA_TYPE\020\237\003\0225\n0HTTP_S"
-    "TATUS_CODE_REQUESTED_RANGE_NOT_SATISFIAB"
-    "LE\020\240\003\022(\n#HTTP_STATUS_CODE_EXPECTATION_FA"
-    "ILED\020\241\003\022+\n&HTTP_STATUS_CODE_INTERNAL_SER"
-    "VER_ERROR\020\364\003\022%\n HTTP_STATUS_CODE_NOT_IMP"
-    "LEMENTED\020\365\003\022!\n\034HTTP_STATUS_CODE_BAD_GATE"
-    "WAY\020\366\003\022)\n$HTTP_STATUS_CODE_SERVICE_UNAVA"
-    "ILABLE\020\367\003\022%\n HTTP_STATUS_CODE_GATEWAY_TI"
-    "MEOUT\020\370\003\0220\n+HTTP_STATUS_CODE_HTTP_VERSIO"
-    "N_NOT_SUPPORTED\020\371\003", 2178);
+    "HTTP_STATUS_CODE_PARTIAL_CONTENT\020\316\001\022\035\n\030H"
+    "TTP_STATUS_CODE_IM_USED\020\342\001\022&\n!HTTP_STATU"
+    "S_CODE_MULTIPLE_CHOICES\020\254\002\022\'\n\"HTTP_STATU"
+    "S_CODE_MOVED_PERMANENTLY\020\255\002\022\033\n\026HTTP_STAT"
+    "US_CODE_FOUND\020\256\002\022\037\n\032HTTP_STATUS_CODE_SEE"
+    "_OTHER\020\257\002\022\"\n\035HTTP_STATUS_CODE_NOT_MODIFI"
+    "ED\020\260\002\022\037\n\032HTTP_STATUS_CODE_USE_PROXY\020\261\002\022\036"
+    "\n\031HTTP_STATUS_CODE__UNUSED_\020\262\002\022(\n#HTTP_S"
+    "TATUS_CODE_TEMPORARY_REDIRECT\020\263\002\022!\n\034HTTP"
+    "_STATUS_CODE_BAD_REQUEST\020\220\003\022\"\n\035HTTP_STAT"
+    "US_CODE_UNAUTHORIZED\020\221\003\022&\n!HTTP_STATUS_C"
+    "ODE_PAYMENT_REQUIRED\020\222\003\022\037\n\032HTTP_STATUS_C"
+    "ODE_FORBIDDEN\020\223\003\022\037\n\032HTTP_STATUS_CODE_NOT"
+    "_FOUND\020\224\003\022(\n#HTTP_STATUS_CODE_METHOD_NOT"
+    "_ALLOWED\020\225\003\022$\n\037HTTP_STATUS_CODE_NOT_ACCE"
+    "PTABLE\020\226\003\0223\n.HTTP_STATUS_CODE_PROXY_AUTH"
+    "ENTICATION_REQUIRED\020\227\003\022%\n HTTP_STATUS_CO"
+    "DE_REQUEST_TIMEOUT\020\230\003\022\036\n\031HTTP_STATUS_COD"
+    "E_CONFLICT\020\231\003\022\032\n\025HTTP_STATUS_CODE_GONE\020\232"
+    "\003\022%\n HTTP_STATUS_CODE_LENGTH_REQUIRED\020\233\003"
+    "\022)\n$HTTP_STATUS_CODE_PRECONDITION_FAILED"
+    "\020\234\003\022.\n)HTTP_STATUS_CODE_REQUEST_ENTITY_T"
+    "OO_LARGE\020\235\003\022*\n%HTTP_STATUS_CODE_REQUEST_"
+    "URI_TOO_LONG\020\236\003\022,\n\'HTTP_STATUS_CODE_UNSU"
+    "PPORTED_MEDIA_TYPE\020\237\003\0225\n0HTTP_STATUS_COD"
+    "E_REQUESTED_RANGE_NOT_SATISFIABLE\020\240\003\022(\n#"
+    "HTTP_STATUS_CODE_EXPECTATION_FAILED\020\241\003\022+"
+    "\n&HTTP_STATUS_CODE_INTERNAL_SERVER_ERROR"
+    "\020\364\003\022%\n HTTP_STATUS_CODE_NOT_IMPLEMENTED\020"
+    "\365\003\022!\n\034HTTP_STATUS_CODE_BAD_GATEWAY\020\366\003\022)\n"
+    "$HTTP_STATUS_CODE_SERVICE_UNAVAILABLE\020\367\003"
+    "\022%\n HTTP_STATUS_CODE_GATEWAY_TIMEOUT\020\370\003\022"
+    "0\n+HTTP_STATUS_CODE_HTTP_VERSION_NOT_SUP"
+    "PORTED\020\371\003", 2209);
   ::google::protobuf::MessageFactory::InternalRegisterGeneratedFile(
     "pjcore/error.proto", &protobuf_RegisterTypes);
   TextLocation::default_instance_ = new TextLocation();
@@ -202,6 +203,7 @@ bool HttpStatusCode_IsValid(int value) {
     case 204:
     case 205:
     case 206:
+    case 226:
     case 300:
     case 301:
     case 302:
@@ -77,6 +77,9 @@ const char* HttpReasonPhrase(HttpStatusCode status_code) {
     case HTTP_STATUS_CODE_PARTIAL_CONTENT:
       return "Partial Content";
 
+    case HTTP_STATUS_CODE_IM_USED:
+      return "IM Used";
+
     case HTTP_STATUS_CODE_MULTIPLE_CHOICES:
       return "Multiple Choices";
 
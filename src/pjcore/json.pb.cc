@@ -44,7 +44,7 @@ void protobuf_AssignDesc_pjcore_2fjson_2eproto() {
       "pjcore/json.proto");
   GOOGLE_CHECK(file != NULL);
   JsonValue_descriptor_ = file->message_type(0);
-  static const int JsonValue_offsets_[8] = {
+  static const int JsonValue_offsets_[11] = {
     GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(JsonValue, type_),
     GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(JsonValue, bool_value_),
     GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(JsonValue, signed_value_),
@@ -53,6 +53,9 @@ void protobuf_AssignDesc_pjcore_2fjson_2eproto() {
     GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(JsonValue, string_value_),
     GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(JsonValue, object_properties_),
     GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(JsonValue, array_elements_),
+    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(JsonValue, packed_signed_values_),
+    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(JsonValue, packed_unsigned_values_),
+    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(JsonValue, packed_double_values_),
   };
   JsonValue_reflection_ =
     ::google::protobuf::internal::GeneratedMessageReflection::NewGeneratedMessageReflection(
@@ -81,12 +84,14 @@ void protobuf_AssignDesc_pjcore_2fjson_2eproto() {
       GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(JsonValue_Property, _internal_metadata_));
   JsonValue_Type_descriptor_ = JsonValue_descriptor_->enum_type(0);
   JsonReaderConfig_descriptor_ = file->message_type(1);
-  static const int JsonReaderConfig_offsets_[5] = {
+  static const int JsonReaderConfig_offsets_[7] = {
     GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(JsonReaderConfig, disallow_comments_),
     GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(JsonReaderConfig, disallow_trailing_commas_),
     GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(JsonReaderConfig, properties_as_is_),
     GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(JsonReaderConfig, allow_control_characters_),
     GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(JsonReaderConfig, disallow_nan_and_infinity_),
+    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(JsonReaderConfig, pack_numeric_arrays_),
+    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(JsonReaderConfig, raw_numbers_),
   };
   JsonReaderConfig_reflection_ =
     ::google::protobuf::internal::GeneratedMessageReflection::NewGeneratedMessageReflection(
@@ -158,27 +163,31 @@ void protobuf_AddDesc_pjcore_2fjson_2eproto() {
   GOOGLE_PROTOBUF_VERIFY_VERSION;
 
   ::google::protobuf::DescriptorPool::InternalAddGeneratedFile(
-    "\n\021pjcore/json.proto\022\006pjcore\"\313\003\n\tJsonValu"
+    "\n\021pjcore/json.proto\022\006pjcore\"\274\004\n\tJsonValu"
     "e\022$\n\004type\030\001 \001(\0162\026.pjcore.JsonValue.Type\022"
     "\022\n\nbool_value\030\002 \001(\010\022\024\n\014signed_value\030\003 \001("
     "\003\022\026\n\016unsigned_value\030\004 \001(\004\022\024\n\014double_valu"
     "e\030\005 \001(\001\022\024\n\014string_value\030\006 \001(\t\0225\n\021object_"
     "properties\030\007 \003(\0132\032.pjcore.JsonValue.Prop"
     "erty\022)\n\016array_elements\030\010 \003(\0132\021.pjcore.Js"
-    "onValue\032:\n\010Property\022\014\n\004name\030\001 \001(\t\022 \n\005val"
-    "ue\030\002 \001(\0132\021.pjcore.JsonValue\"\213\001\n\004Type\022\r\n\t"
-    "TYPE_NULL\020\000\022\r\n\tTYPE_BOOL\020\001\022\017\n\013TYPE_SIGNE"
-    "D\020\002\022\021\n\rTYPE_UNSIGNED\020\003\022\017\n\013TYPE_DOUBLE\020\004\022"
-    "\017\n\013TYPE_STRING\020\005\022\017\n\013TYPE_OBJECT\020\006\022\016\n\nTYP"
-    "E_ARRAY\020\007\"\256\001\n\020JsonReaderConfig\022\031\n\021disall"
-    "ow_comments\030\001 \001(\010\022 \n\030disallow_trailing_c"
-    "ommas\030\002 \001(\010\022\030\n\020properties_as_is\030\003 \001(\010\022 \n"
-    "\030allow_control_characters\030\004 \001(\010\022!\n\031disal"
-    "low_nan_and_infinity\030\005 \001(\010\"\215\001\n\020JsonWrite"
-    "rConfig\022\037\n\027include_byte_order_mark\030\001 \001(\010"
-    "\022\026\n\016escape_unicode\030\002 \001(\010\022\r\n\005space\030\003 \001(\010\022"
-    "\016\n\006indent\030\004 \001(\r\022!\n\031null_for_nan_and_infi"
-    "nity\030\005 \001(\010", 810);
+    "onValue\022\034\n\024packed_signed_values\030\t \003(\003\022\036\n"
+    "\026packed_unsigned_values\030\n \003(\004\022\034\n\024packed_"
+    "double_values\030\013 \003(\001\032:\n\010Property\022\014\n\004name\030"
+    "\001 \001(\t\022 \n\005value\030\002 \001(\0132\021.pjcore.JsonValue\""
+    "\240\001\n\004Type\022\r\n\tTYPE_NULL\020\000\022\r\n\tTYPE_BOOL\020\001\022\017"
+    "\n\013TYPE_SIGNED\020\002\022\021\n\rTYPE_UNSIGNED\020\003\022\017\n\013TY"
+    "PE_DOUBLE\020\004\022\017\n\013TYPE_STRING\020\005\022\017\n\013TYPE_OBJ"
+    "ECT\020\006\022\016\n\nTYPE_ARRAY\020\007\022\023\n\017TYPE_RAW_NUMBER"
+    "\020\010\"\340\001\n\020JsonReaderConfig\022\031\n\021disallow_comm"
+    "ents\030\001 \001(\010\022 \n\030disallow_trailing_commas\030\002"
+    " \001(\010\022\030\n\020properties_as_is\030\003 \001(\010\022 \n\030allow_"
+    "control_characters\030\004 \001(\010\022!\n\031disallow_nan"
+    "_and_infinity\030\005 \001(\010\022\033\n\023pack_numeric_arra"
+    "ys\030\006 \001(\010\022\023\n\013raw_numbers\030\007 \001(\010\"\215\001\n\020JsonWr"
+    "iterConfig\022\037\n\027include_byte_order_mark\030\001 "
+    "\001(\010\022\026\n\016escape_unicode\030\002 \001(\010\022\r\n\005space\030\003 \001"
+    "(\010\022\016\n\006indent\030\004 \001(\r\022!\n\031null_for_nan_and_i"
+    "nfinity\030\005 \001(\010", 973);
   ::google::protobuf::MessageFactory::InternalRegisterGeneratedFile(
     "pjcore/json.proto", &protobuf_RegisterTypes);
   JsonValue::default_instance_ = new JsonValue();
@@ -225,6 +234,7 @@ bool JsonValue_Type_IsValid(int value) {
     case 5:
     case 6:
     case 7:
+    case 8:
       return true;
     default:
       return false;
@@ -240,6 +250,7 @@ const JsonValue_Type JsonValue::TYPE_DOUBLE;
 const JsonValue_Type JsonValue::TYPE_STRING;
 const JsonValue_Type JsonValue::TYPE_OBJECT;
 const JsonValue_Type JsonValue::TYPE_ARRAY;
+const JsonValue_Type JsonValue::TYPE_RAW_NUMBER;
 const JsonValue_Type JsonValue::Type_MIN;
 const JsonValue_Type JsonValue::Type_MAX;
 const int JsonValue::Type_ARRAYSIZE;
@@ -550,6 +561,9 @@ const int JsonValue::kDoubleValueFieldNumber;
 const int JsonValue::kStringValueFieldNumber;
 const int JsonValue::kObjectPropertiesFieldNumber;
 const int JsonValue::kArrayElementsFieldNumber;
+const int JsonValue::kPackedSignedValuesFieldNumber;
+const int JsonValue::kPackedUnsignedValuesFieldNumber;
+const int JsonValue::kPackedDoubleValuesFieldNumber;
 #endif  // !_MSC_VER
 
 JsonValue::JsonValue()
@@ -640,6 +654,9 @@ void JsonValue::Clear() {
 
   object_properties_.Clear();
   array_elements_.Clear();
+  packed_signed_values_.Clear();
+  packed_unsigned_values_.Clear();
+  packed_double_values_.Clear();
   ::memset(_has_bits_, 0, sizeof(_has_bits_));
   if (_internal_metadata_.have_unknown_fields()) {
     mutable_unknown_fields()->Clear();
@@ -776,6 +793,63 @@ bool JsonValue::MergePartialFromCodedStream(
           goto handle_unusual;
         }
         if (input->ExpectTag(66)) goto parse_array_elements;
+        if (input->ExpectTag(72)) goto parse_packed_signed_values;
+        break;
+      }
+
+      // repeated int64 packed_signed_values = 9;
+      case 9: {
+        if (tag == 72) {
+         parse_packed_signed_values:
+          DO_((::google::protobuf::internal::WireFormatLite::ReadRepeatedPrimitive<
+                   ::google::protobuf::int64, ::google::protobuf::internal::WireFormatLite::TYPE_INT64>(
+                 1, 72, input, this->mutable_packed_signed_values())));
+        } else if (tag == 74) {
+          DO_((::google::protobuf::internal::WireFormatLite::ReadPackedPrimitiveNoInline<
+                   ::google::protobuf::int64, ::google::protobuf::internal::WireFormatLite::TYPE_INT64>(
+                 input, this->mutable_packed_signed_values())));
+        } else {
+          goto handle_unusual;
+        }
+        if (input->ExpectTag(72)) goto parse_packed_signed_values;
+        if (input->ExpectTag(80)) goto parse_packed_unsigned_values;
+        break;
+      }
+
+      // repeated uint64 packed_unsigned_values = 10;
+      case 10: {
+        if (tag == 80) {
+         parse_packed_unsigned_values:
+          DO_((::google::protobuf::internal::WireFormatLite::ReadRepeatedPrimitive<
+                   ::google::protobuf::uint64, ::google::protobuf::internal::WireFormatLite::TYPE_UINT64>(
+                 1, 80, input, this->mutable_packed_unsigned_values())));
+        } else if (tag == 82) {
+          DO_((::google::protobuf::internal::WireFormatLite::ReadPackedPrimitiveNoInline<
+                   ::google::protobuf::uint64, ::google::protobuf::internal::WireFormatLite::TYPE_UINT64>(
+                 input, this->mutable_packed_unsigned_values())));
+        } else {
+          goto handle_unusual;
+        }
+        if (input->ExpectTag(80)) goto parse_packed_unsigned_values;
+        if (input->ExpectTag(89)) goto parse_packed_double_values;
+        break;
+      }
+
+      // repeated double packed_double_values = 11;
+      case 11: {
+        if (tag == 89) {
+         parse_packed_double_values:
+          DO_((::google::protobuf::internal::WireFormatLite::ReadRepeatedPrimitive<
+                   double, ::google::protobuf::internal::WireFormatLite::TYPE_DOUBLE>(
+                 1, 89, input, this->mutable_packed_double_values())));
+        } else if (tag == 90) {
+          DO_((::google::protobuf::internal::WireFormatLite::ReadPackedPrimitiveNoInline<
+                   double, ::google::protobuf::internal::WireFormatLite::TYPE_DOUBLE>(
+                 input, this->mutable_packed_double_values())));
+        } else {
+          goto handle_unusual;
+        }
+        if (input->ExpectTag(89)) goto parse_packed_double_values;
         if (input->ExpectAtEnd()) goto success;
         break;
       }
@@ -853,6 +927,24 @@ void JsonValue::SerializeWithCachedSizes(
       8, this->array_elements(i), output);
   }
 
+  // repeated int64 packed_signed_values = 9;
+  for (int i = 0; i < this->packed_signed_values_size(); i++) {
+    ::google::protobuf::internal::WireFormatLite::WriteInt64(
+      9, this->packed_signed_values(i), output);
+  }
+
+  // repeated uint64 packed_unsigned_values = 10;
+  for (int i = 0; i < this->packed_unsigned_values_size(); i++) {
+    ::google::protobuf::internal::WireFormatLite::WriteUInt64(
+      10, this->packed_unsigned_values(i), output);
+  }
+
+  // repeated double packed_double_values = 11;
+  for (int i = 0; i < this->packed_double_values_size(); i++) {
+    ::google::protobuf::internal::WireFormatLite::WriteDouble(
+      11, this->packed_double_values(i), output);
+  }
+
   if (_internal_metadata_.have_unknown_fields()) {
     ::google::protobuf::internal::WireFormat::SerializeUnknownFields(
         unknown_fields(), output);
@@ -914,6 +1006,24 @@ void JsonValue::SerializeWithCachedSizes(
         8, this->array_elements(i), target);
   }
 
+  // repeated int64 packed_signed_values = 9;
+  for (int i = 0; i < this->packed_signed_values_size(); i++) {
+    target = ::google::protobuf::internal::WireFormatLite::
+      WriteInt64ToArray(9, this->packed_signed_values(i), target);
+  }
+
+  // repeated uint64 packed_unsigned_values = 10;
+  for (int i = 0; i < this->packed_unsigned_values_size(); i++) {
+    target = ::google::protobuf::internal::WireFormatLite::
+      WriteUInt64ToArray(10, this->packed_unsigned_values(i), target);
+  }
+
+  // repeated double packed_double_values = 11;
+  for (int i = 0; i < this->packed_double_values_size(); i++) {
+    target = ::google::protobuf::internal::WireFormatLite::
+      WriteDoubleToArray(11, this->packed_double_values(i), target);
+  }
+
   if (_internal_metadata_.have_unknown_fields()) {
     target = ::google::protobuf::internal::WireFormat::SerializeUnknownFieldsToArray(
         unknown_fields(), target);
@@ -980,6 +1090,33 @@ int JsonValue::ByteSize() const {
         this->array_elements(i));
   }
 
+  // repeated int64 packed_signed_values = 9;
+  {
+    int data_size = 0;
+    for (int i = 0; i < this->packed_signed_values_size(); i++) {
+      data_size += ::google::protobuf::internal::WireFormatLite::
+        Int64Size(this->packed_signed_values(i));
+    }
+    total_size += 1 * this->packed_signed_values_size() + data_size;
+  }
+
+  // repeated uint64 packed_unsigned_values = 10;
+  {
+    int data_size = 0;
+    for (int i = 0; i < this->packed_unsigned_values_size(); i++) {
+      data_size += ::google::protobuf::internal::WireFormatLite::
+        UInt64Size(this->packed_unsigned_values(i));
+    }
+    total_size += 1 * this->packed_unsigned_values_size() + data_size;
+  }
+
+  // repeated double packed_double_values = 11;
+  {
+    int data_size = 0;
+    data_size = 8 * this->packed_double_values_size();
+    total_size += 1 * this->packed_double_values_size() + data_size;
+  }
+
   if (_internal_metadata_.have_unknown_fields()) {
     total_size +=
       ::google::protobuf::internal::WireFormat::ComputeUnknownFieldsSize(
@@ -1007,6 +1144,9 @@ void JsonValue::MergeFrom(const JsonValue& from) {
   if (GOOGLE_PREDICT_FALSE(&from == this)) MergeFromFail(__LINE__);
   object_properties_.MergeFrom(from.object_properties_);
   array_elements_.MergeFrom(from.array_elements_);
+  packed_signed_values_.MergeFrom(from.packed_signed_values_);
+  packed_unsigned_values_.MergeFrom(from.packed_unsigned_values_);
+  packed_double_values_.MergeFrom(from.packed_double_values_);
   if (from._has_bits_[0 / 32] & (0xffu << (0 % 32))) {
     if (from.has_type()) {
       set_type(from.type());
@@ -1063,6 +1203,9 @@ void JsonValue::InternalSwap(JsonValue* other) {
   string_value_.Swap(&other->string_value_);
   object_properties_.UnsafeArenaSwap(&other->object_properties_);
   array_elements_.UnsafeArenaSwap(&other->array_elements_);
+  packed_signed_values_.UnsafeArenaSwap(&other->packed_signed_values_);
+  packed_unsigned_values_.UnsafeArenaSwap(&other->packed_unsigned_values_);
+  packed_double_values_.UnsafeArenaSwap(&other->packed_double_values_);
   std::swap(_has_bits_[0], other->_has_bits_[0]);
   _internal_metadata_.Swap(&other->_internal_metadata_);
   std::swap(_cached_size_, other->_cached_size_);
@@ -1085,6 +1228,8 @@ const int JsonReaderConfig::kDisallowTrailingCommasFieldNumber;
 const int JsonReaderConfig::kPropertiesAsIsFieldNumber;
 const int JsonReaderConfig::kAllowControlCharactersFieldNumber;
 const int JsonReaderConfig::kDisallowNanAndInfinityFieldNumber;
+const int JsonReaderConfig::kPackNumericArraysFieldNumber;
+const int JsonReaderConfig::kRawNumbersFieldNumber;
 #endif  // !_MSC_VER
 
 JsonReaderConfig::JsonReaderConfig()
@@ -1111,6 +1256,8 @@ void JsonReaderConfig::SharedCtor() {
   properties_as_is_ = false;
   allow_control_characters_ = false;
   disallow_nan_and_infinity_ = false;
+  pack_numeric_arrays_ = false;
+  raw_numbers_ = false;
   ::memset(_has_bits_, 0, sizeof(_has_bits_));
 }
 
@@ -1160,8 +1307,8 @@ void JsonReaderConfig::Clear() {
     ::memset(&first, 0, n);                                \
   } while (0)
 
-  if (_has_bits_[0 / 32] & 31) {
-    ZR_(disallow_comments_, disallow_nan_and_infinity_);
+  if (_has_bits_[0 / 32] & 127) {
+    ZR_(disallow_comments_, raw_numbers_);
   }
 
 #undef OFFSET_OF_FIELD_
@@ -1253,6 +1400,36 @@ bool JsonReaderConfig::MergePartialFromCodedStream(
         } else {
           goto handle_unusual;
         }
+        if (input->ExpectTag(48)) goto parse_pack_numeric_arrays;
+        break;
+      }
+
+      // optional bool pack_numeric_arrays = 6;
+      case 6: {
+        if (tag == 48) {
+         parse_pack_numeric_arrays:
+          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
+                   bool, ::google::protobuf::internal::WireFormatLite::TYPE_BOOL>(
+                 input, &pack_numeric_arrays_)));
+          set_has_pack_numeric_arrays();
+        } else {
+          goto handle_unusual;
+        }
+        if (input->ExpectTag(56)) goto parse_raw_numbers;
+        break;
+      }
+
+      // optional bool raw_numbers = 7;
+      case 7: {
+        if (tag == 56) {
+         parse_raw_numbers:
+          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
+                   bool, ::google::protobuf::internal::WireFormatLite::TYPE_BOOL>(
+                 input, &raw_numbers_)));
+          set_has_raw_numbers();
+        } else {
+          goto handle_unusual;
+        }
         if (input->ExpectAtEnd()) goto success;
         break;
       }
@@ -1307,6 +1484,16 @@ void JsonReaderConfig::SerializeWithCachedSizes(
     ::google::protobuf::internal::WireFormatLite::WriteBool(5, this->disallow_nan_and_infinity(), output);
   }
 
+  // optional bool pack_numeric_arrays = 6;
+  if (has_pack_numeric_arrays()) {
+    ::google::protobuf::internal::WireFormatLite::WriteBool(6, this->pack_numeric_arrays(), output);
+  }
+
+  // optional bool raw_numbers = 7;
+  if (has_raw_numbers()) {
+    ::google::protobuf::internal::WireFormatLite::WriteBool(7, this->raw_numbers(), output);
+  }
+
   if (_internal_metadata_.have_unknown_fields()) {
     ::google::protobuf::internal::WireFormat::SerializeUnknownFields(
         unknown_fields(), output);
@@ -1342,6 +1529,16 @@ void JsonReaderConfig::SerializeWithCachedSizes(
     target = ::google::protobuf::internal::WireFormatLite::WriteBoolToArray(5, this->disallow_nan_and_infinity(), target);
   }
 
+  // optional bool pack_numeric_arrays = 6;
+  if (has_pack_numeric_arrays()) {
+    target = ::google::protobuf::internal::WireFormatLite::WriteBoolToArray(6, this->pack_numeric_arrays(), target);
+  }
+
+  // optional bool raw_numbers = 7;
+  if (has_raw_numbers()) {
+    target = ::google::protobuf::internal::WireFormatLite::WriteBoolToArray(7, this->raw_numbers(), target);
+  }
+
   if (_internal_metadata_.have_unknown_fields()) {
     target = ::google::protobuf::internal::WireFormat::SerializeUnknownFieldsToArray(
         unknown_fields(), target);
@@ -1353,7 +1550,7 @@ void JsonReaderConfig::SerializeWithCachedSizes(
 int JsonReaderConfig::ByteSize() const {
   int total_size = 0;
 
-  if (_has_bits_[0 / 32] & 31) {
+  if (_has_bits_[0 / 32] & 127) {
     // optional bool disallow_comments = 1;
     if (has_disallow_comments()) {
       total_size += 1 + 1;
@@ -1379,6 +1576,16 @@ int JsonReaderConfig::ByteSize() const {
       total_size += 1 + 1;
     }
 
+    // optional bool pack_numeric_arrays = 6;
+    if (has_pack_numeric_arrays()) {
+      total_size += 1 + 1;
+    }
+
+    // optional bool raw_numbers = 7;
+    if (has_raw_numbers()) {
+      total_size += 1 + 1;
+    }
+
   }
   if (_internal_metadata_.have_unknown_fields()) {
     total_size +=
@@ -1421,6 +1628,12 @@ void JsonReaderConfig::MergeFrom(const JsonReaderConfig& from) {
     if (from.has_disallow_nan_and_infinity()) {
       set_disallow_nan_and_infinity(from.disallow_nan_and_infinity());
     }
+    if (from.has_pack_numeric_arrays()) {
+      set_pack_numeric_arrays(from.pack_numeric_arrays());
+    }
+    if (from.has_raw_numbers()) {
+      set_raw_numbers(from.raw_numbers());
+    }
   }
   if (from._internal_metadata_.have_unknown_fields()) {
     mutable_unknown_fields()->MergeFrom(from.unknown_fields());
@@ -1454,6 +1667,8 @@ void JsonReaderConfig::InternalSwap(JsonReaderConfig* other) {
   std::swap(properties_as_is_, other->properties_as_is_);
   std::swap(allow_control_characters_, other->allow_control_characters_);
   std::swap(disallow_nan_and_infinity_, other->disallow_nan_and_infinity_);
+  std::swap(pack_numeric_arrays_, other->pack_numeric_arrays_);
+  std::swap(raw_numbers_, other->raw_numbers_);
   std::swap(_has_bits_[0], other->_has_bits_[0]);
   _internal_metadata_.Swap(&other->_internal_metadata_);
   std::swap(_cached_size_, other->_cached_size_);
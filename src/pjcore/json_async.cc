@@ -0,0 +1,207 @@
+// JSON [de]serialization for protobuf + embedded HTTP server and client in C++.
+// Copyright (C) 2014 http://protojson.com/
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+
+#include "pjcore/json_async.h"
+
+#include <string.h>
+
+#include <string>
+
+#include "pjcore/third_party/chromium/bind.h"
+#include "pjcore/third_party/chromium/bind_helpers.h"
+#include "pjcore/third_party/chromium/callback_helpers.h"
+
+#include "pjcore/json_reader.h"
+#include "pjcore/json_writer.h"
+#include "pjcore/logging.h"
+#include "pjcore/make_json_value.h"
+#include "pjcore/result_error_pair.h"
+#include "pjcore/shared_uv_loop-inl.h"
+#include "pjcore/uv_util.h"
+
+namespace pjcore {
+
+namespace {
+
+scoped_ptr<JsonValue> ReadJsonWork(StringPiece str,
+                                   const JsonReaderConfig& config,
+                                   Error* error) {
+  scoped_ptr<JsonValue> value(new JsonValue());
+  if (!ReadJson(str, value.get(), error, config)) {
+    return scoped_ptr<JsonValue>();
+  }
+  return value.Pass();
+}
+
+scoped_ptr<std::string> WriteJsonWork(const JsonValue* value,
+                                      const JsonWriterConfig& config,
+                                      Error* /* error */) {
+  scoped_ptr<std::string> str(new std::string());
+  WriteJson(*value, str.get(), config);
+  return str.Pass();
+}
+
+template <typename Result>
+void RunAsyncCallback(const SharedUvLoop& shared_loop, bool async,
+                      const Callback<Result(Error* error)>& thread_work,
+                      const Callback<void(Result result, const Error& error)>&
+                          on_work) {
+  if (async) {
+    shared_loop->AsyncCallback(thread_work, on_work);
+    return;
+  }
+
+  ResultErrorPair<Result> result_error_pair;
+  result_error_pair.Produce(thread_work);
+  result_error_pair.Consume(on_work);
+}
+
+class StepWriteContext : public LiveCapturable {
+ public:
+  StepWriteContext(const SharedUvLoop& shared_loop, const JsonValue& value,
+                   const JsonChunkCallback& on_chunk,
+                   const Closure& on_complete, const JsonWriterConfig& config,
+                   size_t step_size)
+      : LiveCapturable("pjcore::<unnamed>::StepWriteContext",
+                       shared_loop->live_list()),
+        shared_loop_(shared_loop),
+        on_chunk_(on_chunk),
+        on_complete_(on_complete),
+        config_(config),
+        writer_(value, config_),
+        step_size_(step_size) {
+    PJCORE_CHECK(shared_loop_);
+    PJCORE_CHECK(!on_chunk_.is_null());
+    PJCORE_CHECK(!on_complete_.is_null());
+
+    idle_handle_.reset(new uv_idle_t());
+    memset(idle_handle_.get(), 0, sizeof(*idle_handle_.get()));
+    idle_handle_->data = this;
+  }
+
+  void AsyncProcess() {
+    int idle_init_status =
+        shared_loop_->uv()->idle_init(shared_loop_->loop(), idle_handle_.get());
+    PJCORE_CHECK_EQ(0, idle_init_status);  // idle_init_status
+
+    int idle_start_status = shared_loop_->uv()->idle_start(
+        idle_handle_.get(), &StepWriteContext::StaticIdle);
+    PJCORE_CHECK_EQ(0, idle_start_status);  // idle_start_status
+  }
+
+ protected:
+  scoped_ptr<google::protobuf::Message> CaptureLive() const OVERRIDE {
+    scoped_ptr<JsonValue> live(new JsonValue(MakeJsonObject(
+        "shared_loop_ptr", reinterpret_cast<uint64_t>(shared_loop_.get()),
+        "step_size", step_size_)));
+    return scoped_ptr<google::protobuf::Message>(live.release());
+  }
+
+ private:
+  ~StepWriteContext() {
+    LogDestroy();
+    PJCORE_CHECK(on_complete_.is_null());
+  }
+
+  static void StaticIdle(uv_idle_t* handle) {
+    PJCORE_CHECK(handle);
+    StepWriteContext* context = static_cast<StepWriteContext*>(handle->data);
+    PJCORE_CHECK(context);
+    context->Idle();
+  }
+
+  void Idle() {
+    writer_.Step(step_size_, &chunk_);
+
+    if (!chunk_.empty()) {
+      on_chunk_.Run(chunk_);
+      chunk_.clear();
+    }
+
+    if (!writer_.done()) {
+      return;
+    }
+
+    AbstractUv* uv = shared_loop_->uv();
+
+    int idle_stop_status = uv->idle_stop(idle_handle_.get());
+    PJCORE_CHECK_EQ(0, idle_stop_status);  // idle_stop_status
+
+    CloseAndDeleteUvHandle(uv, idle_handle_.Pass());
+
+    ResetAndReturn(&on_complete_).Run();
+    delete this;
+  }
+
+  SharedUvLoop shared_loop_;
+
+  JsonChunkCallback on_chunk_;
+
+  Closure on_complete_;
+
+  JsonWriterConfig config_;
+
+  ResumableJsonWriter writer_;
+
+  size_t step_size_;
+
+  std::string chunk_;
+
+  scoped_ptr<uv_idle_t> idle_handle_;
+};
+
+}  // unnamed namespace
+
+void ReadJsonAsync(const SharedUvLoop& shared_loop, StringPiece str,
+                   const JsonValueCallback& on_value,
+                   const JsonReaderConfig& config, size_t min_async_size) {
+  PJCORE_CHECK(shared_loop);
+  PJCORE_CHECK(!on_value.is_null());
+
+  RunAsyncCallback<scoped_ptr<JsonValue> >(
+      shared_loop, str.size() >= min_async_size,
+      Bind(&ReadJsonWork, str, config), on_value);
+}
+
+void WriteJsonAsync(const SharedUvLoop& shared_loop,
+                    scoped_ptr<JsonValue> value,
+                    const JsonStringCallback& on_str,
+                    const JsonWriterConfig& config, size_t min_async_size) {
+  PJCORE_CHECK(shared_loop);
+  PJCORE_CHECK(value);
+  PJCORE_CHECK(!on_str.is_null());
+
+  bool async = static_cast<size_t>(value->ByteSize()) >= min_async_size;
+
+  RunAsyncCallback<scoped_ptr<std::string> >(
+      shared_loop, async, Bind(&WriteJsonWork, Owned(value.release()), config),
+      on_str);
+}
+
+void WriteJsonInSteps(const SharedUvLoop& shared_loop, const JsonValue& value,
+                      const JsonChunkCallback& on_chunk,
+                      const Closure& on_complete,
+                      const JsonWriterConfig& config, size_t step_size) {
+  PJCORE_CHECK(shared_loop);
+  PJCORE_CHECK_GT(step_size, 0u);
+
+  (new StepWriteContext(shared_loop, value, on_chunk, on_complete, config,
+                        step_size))->AsyncProcess();
+}
+
+}  // namespace pjcore
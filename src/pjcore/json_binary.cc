@@ -0,0 +1,935 @@
+// JSON [de]serialization for protobuf + embedded HTTP server and client in C++.
+// Copyright (C) 2014 http://protojson.com/
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+
+#include "pjcore/json_binary.h"
+
+#include <math.h>
+#include <string.h>
+
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "pjcore/logging.h"
+#include "pjcore/json_util.h"
+#include "pjcore/name_value_util.h"
+#include "pjcore/unbox_json_value.h"
+#include "pjcore/unicode.h"
+
+namespace pjcore {
+
+namespace {
+
+const uint64_t kMaxSigned =
+    static_cast<uint64_t>(std::numeric_limits<int64_t>::max());
+
+enum BinaryItemType {
+  BINARY_ITEM_NULL,
+  BINARY_ITEM_BOOL,
+  BINARY_ITEM_SIGNED,
+  BINARY_ITEM_UNSIGNED,
+  BINARY_ITEM_DOUBLE,
+  BINARY_ITEM_STRING,
+  BINARY_ITEM_OBJECT,
+  BINARY_ITEM_ARRAY,
+  BINARY_ITEM_BREAK
+};
+
+// Decoded header of a CBOR data item or a MessagePack object. Strings are
+// complete; containers are followed by their contents.
+struct BinaryItem {
+  BinaryItem()
+      : type(BINARY_ITEM_NULL),
+        bool_value(false),
+        signed_value(0),
+        unsigned_value(0),
+        double_value(0),
+        size(0),
+        indefinite(false) {}
+
+  BinaryItemType type;
+
+  bool bool_value;
+
+  int64_t signed_value;
+
+  uint64_t unsigned_value;
+
+  double double_value;
+
+  StringPiece string_value;
+
+  // Number of elements or properties, unless indefinite.
+  uint64_t size;
+
+  bool indefinite;
+};
+
+void AppendBigEndian(uint64_t value, size_t size, std::string* output) {
+  char bytes[8];
+  for (size_t index = size; index-- > 0; value >>= 8) {
+    bytes[index] = static_cast<char>(value & 0xff);
+  }
+  output->append(bytes, size);
+}
+
+uint64_t ReadBigEndian(const uint8_t* bytes, size_t size) {
+  uint64_t value = 0;
+  for (size_t index = 0; index < size; ++index) {
+    value = (value << 8) | bytes[index];
+  }
+  return value;
+}
+
+// Returns true and sets single when double_value is exactly representable
+// as a float, which includes infinities and NaN.
+bool IsSingle(double double_value, uint32_t* single) {
+  float float_value;
+  if (double_value != double_value) {
+    float_value = std::numeric_limits<float>::quiet_NaN();
+  } else if (fabs(double_value) <= std::numeric_limits<float>::max() ||
+             fabs(double_value) == std::numeric_limits<double>::infinity()) {
+    float_value = static_cast<float>(double_value);
+    if (float_value != double_value) {
+      return false;
+    }
+  } else {
+    return false;
+  }
+
+  memcpy(single, &float_value, sizeof(*single));
+  return true;
+}
+
+double ReadSingle(uint32_t single) {
+  float float_value;
+  memcpy(&float_value, &single, sizeof(float_value));
+  return float_value;
+}
+
+double ReadDouble(uint64_t bits) {
+  double double_value;
+  memcpy(&double_value, &bits, sizeof(double_value));
+  return double_value;
+}
+
+uint64_t GetDoubleBits(double double_value) {
+  uint64_t bits;
+  memcpy(&bits, &double_value, sizeof(bits));
+  return bits;
+}
+
+double ReadHalf(uint16_t half) {
+  int exponent = (half >> 10) & 0x1f;
+  int mantissa = half & 0x3ff;
+
+  double value;
+  if (exponent == 0) {
+    value = ldexp(static_cast<double>(mantissa), -24);
+  } else if (exponent != 31) {
+    value = ldexp(static_cast<double>(mantissa + 1024), exponent - 25);
+  } else if (mantissa == 0) {
+    value = std::numeric_limits<double>::infinity();
+  } else {
+    value = std::numeric_limits<double>::quiet_NaN();
+  }
+
+  return (half & 0x8000) ? -value : value;
+}
+
+class BinaryInput {
+ public:
+  explicit BinaryInput(StringPiece input)
+      : p_(reinterpret_cast<const uint8_t*>(input.data())),
+        end_(p_ + input.size()) {}
+
+  bool at_end() const { return p_ == end_; }
+
+  size_t remaining() const { return end_ - p_; }
+
+ protected:
+  bool ReadByte(uint8_t* byte, Error* error) {
+    PJCORE_REQUIRE(p_ != end_, "Unexpected end of input");
+    *byte = *p_++;
+    return true;
+  }
+
+  bool ReadUnsigned(size_t size, uint64_t* value, Error* error) {
+    PJCORE_REQUIRE(remaining() >= size, "Unexpected end of input");
+    *value = ReadBigEndian(p_, size);
+    p_ += size;
+    return true;
+  }
+
+  bool ReadBytes(uint64_t size, StringPiece* bytes, Error* error) {
+    PJCORE_REQUIRE(remaining() >= size, "Unexpected end of input");
+    *bytes = StringPiece(reinterpret_cast<const char*>(p_),
+                         static_cast<size_t>(size));
+    p_ += size;
+    return true;
+  }
+
+  const uint8_t* p_;
+
+  const uint8_t* end_;
+};
+
+class CborDecoder : public BinaryInput {
+ public:
+  explicit CborDecoder(StringPiece input) : BinaryInput(input) {}
+
+  bool Next(BinaryItem* item, Error* error);
+
+  // Consumes the break stop code ending an indefinite-length container.
+  bool SkipBreak() {
+    if (p_ != end_ && *p_ == 0xff) {
+      ++p_;
+      return true;
+    }
+    return false;
+  }
+
+ private:
+  bool ReadHead(uint8_t* major, uint8_t* additional, uint64_t* argument,
+                Error* error);
+
+  std::string chunks_;
+};
+
+bool CborDecoder::ReadHead(uint8_t* major, uint8_t* additional,
+                           uint64_t* argument, Error* error) {
+  uint8_t initial;
+  PJCORE_REQUIRE_SILENT(ReadByte(&initial, error), "Failed to read CBOR");
+
+  *major = initial >> 5;
+  *additional = initial & 0x1f;
+
+  if (*additional < 24) {
+    *argument = *additional;
+    return true;
+  }
+
+  switch (*additional) {
+    case 24:
+    case 25:
+    case 26:
+    case 27:
+      return ReadUnsigned(static_cast<size_t>(1) << (*additional - 24),
+                          argument, error);
+
+    case 31:
+      PJCORE_REQUIRE(*major >= 2 && *major != 6,
+                     "Unexpected indefinite length in CBOR");
+      *argument = 0;
+      return true;
+
+    default:
+      PJCORE_FAIL("Reserved additional information in CBOR");
+  }
+}
+
+bool CborDecoder::Next(BinaryItem* item, Error* error) {
+  uint8_t major;
+  uint8_t additional;
+  uint64_t argument;
+
+  // Tags carry no meaning for JSON values, so they are skipped.
+  do {
+    PJCORE_REQUIRE_SILENT(ReadHead(&major, &additional, &argument, error),
+                          "Failed to read CBOR");
+  } while (major == 6);
+
+  item->indefinite = (additional == 31);
+
+  switch (major) {
+    case 0:
+      if (argument <= kMaxSigned) {
+        item->type = BINARY_ITEM_SIGNED;
+        item->signed_value = static_cast<int64_t>(argument);
+      } else {
+        item->type = BINARY_ITEM_UNSIGNED;
+        item->unsigned_value = argument;
+      }
+      return true;
+
+    case 1:
+      PJCORE_REQUIRE(argument <= kMaxSigned, "CBOR integer out of range");
+      item->type = BINARY_ITEM_SIGNED;
+      item->signed_value = -1 - static_cast<int64_t>(argument);
+      return true;
+
+    case 2:
+      PJCORE_FAIL("CBOR byte strings are not supported");
+
+    case 3:
+      item->type = BINARY_ITEM_STRING;
+      if (!item->indefinite) {
+        return ReadBytes(argument, &item->string_value, error);
+      }
+
+      chunks_.clear();
+      while (!SkipBreak()) {
+        PJCORE_REQUIRE_SILENT(ReadHead(&major, &additional, &argument, error),
+                              "Failed to read CBOR string chunk");
+        PJCORE_REQUIRE(major == 3 && additional != 31,
+                       "Invalid CBOR string chunk");
+
+        StringPiece chunk;
+        PJCORE_REQUIRE_SILENT(ReadBytes(argument, &chunk, error),
+                              "Failed to read CBOR string chunk");
+        chunk.AppendToString(&chunks_);
+      }
+      item->string_value = chunks_;
+      return true;
+
+    case 4:
+      item->type = BINARY_ITEM_ARRAY;
+      item->size = argument;
+      return true;
+
+    case 5:
+      item->type = BINARY_ITEM_OBJECT;
+      item->size = argument;
+      return true;
+
+    default:
+      break;
+  }
+
+  switch (additional) {
+    case 20:
+    case 21:
+      item->type = BINARY_ITEM_BOOL;
+      item->bool_value = (additional == 21);
+      return true;
+
+    case 22:
+    case 23:
+      item->type = BINARY_ITEM_NULL;
+      return true;
+
+    case 25:
+      item->type = BINARY_ITEM_DOUBLE;
+      item->double_value = ReadHalf(static_cast<uint16_t>(argument));
+      return true;
+
+    case 26:
+      item->type = BINARY_ITEM_DOUBLE;
+      item->double_value = ReadSingle(static_cast<uint32_t>(argument));
+      return true;
+
+    case 27:
+      item->type = BINARY_ITEM_DOUBLE;
+      item->double_value = ReadDouble(argument);
+      return true;
+
+    case 31:
+      item->type = BINARY_ITEM_BREAK;
+      return true;
+
+    default:
+      PJCORE_FAIL("Unsupported CBOR simple value");
+  }
+}
+
+class MsgPackDecoder : public BinaryInput {
+ public:
+  explicit MsgPackDecoder(StringPiece input) : BinaryInput(input) {}
+
+  bool Next(BinaryItem* item, Error* error);
+
+  bool SkipBreak() { return false; }
+
+ private:
+  bool ReadString(size_t size_size, BinaryItem* item, Error* error) {
+    uint64_t size;
+    PJCORE_REQUIRE_SILENT(ReadUnsigned(size_size, &size, error),
+                          "Failed to read MessagePack string size");
+    item->type = BINARY_ITEM_STRING;
+    return ReadBytes(size, &item->string_value, error);
+  }
+
+  bool ReadContainer(BinaryItemType type, size_t size_size, BinaryItem* item,
+                     Error* error) {
+    item->type = type;
+    return ReadUnsigned(size_size, &item->size, error);
+  }
+
+  bool ReadSigned(size_t size, BinaryItem* item, Error* error) {
+    uint64_t bits;
+    PJCORE_REQUIRE_SILENT(ReadUnsigned(size, &bits, error),
+                          "Failed to read MessagePack integer");
+
+    // Sign-extends from the given number of bytes.
+    uint64_t sign = static_cast<uint64_t>(1) << (size * 8 - 1);
+    item->type = BINARY_ITEM_SIGNED;
+    item->signed_value = static_cast<int64_t>((bits ^ sign) - sign);
+    return true;
+  }
+};
+
+bool MsgPackDecoder::Next(BinaryItem* item, Error* error) {
+  uint8_t initial;
+  PJCORE_REQUIRE_SILENT(ReadByte(&initial, error),
+                        "Failed to read MessagePack");
+
+  item->indefinite = false;
+
+  if (initial < 0x80) {
+    item->type = BINARY_ITEM_SIGNED;
+    item->signed_value = initial;
+    return true;
+  }
+
+  if (initial >= 0xe0) {
+    item->type = BINARY_ITEM_SIGNED;
+    item->signed_value = static_cast<int64_t>(initial) - 0x100;
+    return true;
+  }
+
+  switch (initial & 0xf0) {
+    case 0x80:
+      item->type = BINARY_ITEM_OBJECT;
+      item->size = initial & 0x0f;
+      return true;
+
+    case 0x90:
+      item->type = BINARY_ITEM_ARRAY;
+      item->size = initial & 0x0f;
+      return true;
+
+    case 0xa0:
+    case 0xb0:
+      item->type = BINARY_ITEM_STRING;
+      return ReadBytes(initial & 0x1f, &item->string_value, error);
+
+    default:
+      break;
+  }
+
+  uint64_t bits;
+
+  switch (initial) {
+    case 0xc0:
+      item->type = BINARY_ITEM_NULL;
+      return true;
+
+    case 0xc2:
+    case 0xc3:
+      item->type = BINARY_ITEM_BOOL;
+      item->bool_value = (initial == 0xc3);
+      return true;
+
+    case 0xca:
+      PJCORE_REQUIRE_SILENT(ReadUnsigned(4, &bits, error),
+                            "Failed to read MessagePack float");
+      item->type = BINARY_ITEM_DOUBLE;
+      item->double_value = ReadSingle(static_cast<uint32_t>(bits));
+      return true;
+
+    case 0xcb:
+      PJCORE_REQUIRE_SILENT(ReadUnsigned(8, &bits, error),
+                            "Failed to read MessagePack float");
+      item->type = BINARY_ITEM_DOUBLE;
+      item->double_value = ReadDouble(bits);
+      return true;
+
+    case 0xcc:
+    case 0xcd:
+    case 0xce:
+    case 0xcf:
+      item->type = BINARY_ITEM_UNSIGNED;
+      return ReadUnsigned(static_cast<size_t>(1) << (initial - 0xcc),
+                          &item->unsigned_value, error);
+
+    case 0xd0:
+    case 0xd1:
+    case 0xd2:
+    case 0xd3:
+      return ReadSigned(static_cast<size_t>(1) << (initial - 0xd0), item,
+                        error);
+
+    case 0xd9:
+    case 0xda:
+    case 0xdb:
+      return ReadString(static_cast<size_t>(1) << (initial - 0xd9), item,
+                        error);
+
+    case 0xdc:
+    case 0xdd:
+      return ReadContainer(BINARY_ITEM_ARRAY, initial == 0xdc ? 2 : 4, item,
+                           error);
+
+    case 0xde:
+    case 0xdf:
+      return ReadContainer(BINARY_ITEM_OBJECT, initial == 0xde ? 2 : 4, item,
+                           error);
+
+    case 0xc4:
+    case 0xc5:
+    case 0xc6:
+      PJCORE_FAIL("MessagePack binary values are not supported");
+
+    default:
+      PJCORE_FAIL("Unsupported MessagePack type");
+  }
+}
+
+struct BinaryContainer {
+  BinaryContainer(JsonValue* a_value, uint64_t a_remaining, bool an_indefinite)
+      : value(a_value), remaining(a_remaining), indefinite(an_indefinite) {}
+
+  JsonValue* value;
+
+  uint64_t remaining;
+
+  bool indefinite;
+};
+
+void FinishBinaryContainer(JsonValue* container,
+                           const JsonReaderConfig& config) {
+  if (container->type() == JsonValue::TYPE_OBJECT) {
+    if (!config.properties_as_is()) {
+      StableSortAndRemoveDuplicatesByName(
+          container->mutable_object_properties());
+    }
+  } else if (config.pack_numeric_arrays()) {
+    PackJsonArray(container);
+  }
+}
+
+// Builds value the way ReadJson(JsonTokenizer*, ...) does, keeping open
+// containers on an explicit stack so that nesting depth is not bounded by
+// the call stack.
+template <typename Decoder>
+bool ReadBinary(Decoder* decoder, JsonValue* value, Error* error,
+                const JsonReaderConfig& config) {
+  std::vector<BinaryContainer> containers;
+  JsonValue* target = value;
+  BinaryItem item;
+
+  for (;;) {
+    PJCORE_REQUIRE_SILENT(decoder->Next(&item, error), "Failed to read value");
+
+    switch (item.type) {
+      case BINARY_ITEM_NULL:
+        target->set_type(JsonValue::TYPE_NULL);
+        break;
+
+      case BINARY_ITEM_BOOL:
+        target->set_type(JsonValue::TYPE_BOOL);
+        target->set_bool_value(item.bool_value);
+        break;
+
+      case BINARY_ITEM_SIGNED:
+        target->set_type(JsonValue::TYPE_SIGNED);
+        target->set_signed_value(item.signed_value);
+        break;
+
+      case BINARY_ITEM_UNSIGNED:
+        target->set_type(JsonValue::TYPE_UNSIGNED);
+        target->set_unsigned_value(item.unsigned_value);
+        break;
+
+      case BINARY_ITEM_DOUBLE:
+        PJCORE_REQUIRE(!config.disallow_nan_and_infinity() ||
+                           (item.double_value == item.double_value &&
+                            item.double_value !=
+                                std::numeric_limits<double>::infinity() &&
+                            item.double_value !=
+                                -std::numeric_limits<double>::infinity()),
+                       "NaN and Infinity are disallowed");
+        target->set_type(JsonValue::TYPE_DOUBLE);
+        target->set_double_value(item.double_value);
+        break;
+
+      case BINARY_ITEM_STRING:
+        // As ReadJson does, so that WriteJson emits valid UTF-8.
+        PJCORE_REQUIRE(Unicode::IsStructurallyValidUtf8(item.string_value),
+                       "Invalid UTF-8 in string");
+        target->set_type(JsonValue::TYPE_STRING);
+        item.string_value.CopyToString(target->mutable_string_value());
+        break;
+
+      case BINARY_ITEM_OBJECT:
+      case BINARY_ITEM_ARRAY:
+        // Each element takes at least one byte, which bounds bogus sizes.
+        PJCORE_REQUIRE(item.indefinite || item.size <= decoder->remaining(),
+                       "Container size exceeds input");
+        target->set_type(item.type == BINARY_ITEM_OBJECT
+                             ? JsonValue::TYPE_OBJECT
+                             : JsonValue::TYPE_ARRAY);
+        containers.push_back(
+            BinaryContainer(target, item.size, item.indefinite));
+        break;
+
+      default:
+        PJCORE_FAIL("Value expected");
+    }
+
+    for (;;) {
+      if (containers.empty()) {
+        return true;
+      }
+
+      BinaryContainer& container = containers.back();
+      if (container.indefinite ? decoder->SkipBreak()
+                               : container.remaining == 0) {
+        FinishBinaryContainer(container.value, config);
+        containers.pop_back();
+        continue;
+      }
+
+      --container.remaining;
+
+      if (container.value->type() == JsonValue::TYPE_ARRAY) {
+        target = container.value->add_array_elements();
+        break;
+      }
+
+      JsonValue::Property* property =
+          container.value->add_object_properties();
+
+      PJCORE_REQUIRE_SILENT(decoder->Next(&item, error),
+                            "Failed to read property name");
+      PJCORE_REQUIRE(item.type == BINARY_ITEM_STRING,
+                     "Property name must be a string");
+      PJCORE_REQUIRE(Unicode::IsStructurallyValidUtf8(item.string_value),
+                     "Invalid UTF-8 in property name");
+      item.string_value.CopyToString(property->mutable_name());
+
+      target = property->mutable_value();
+      break;
+    }
+  }
+}
+
+void AppendCborHead(uint8_t major, uint64_t argument, std::string* output) {
+  uint8_t initial = static_cast<uint8_t>(major << 5);
+
+  if (argument < 24) {
+    output->push_back(static_cast<char>(initial | argument));
+  } else if (argument <= 0xff) {
+    output->push_back(static_cast<char>(initial | 24));
+    AppendBigEndian(argument, 1, output);
+  } else if (argument <= 0xffff) {
+    output->push_back(static_cast<char>(initial | 25));
+    AppendBigEndian(argument, 2, output);
+  } else if (argument <= 0xffffffff) {
+    output->push_back(static_cast<char>(initial | 26));
+    AppendBigEndian(argument, 4, output);
+  } else {
+    output->push_back(static_cast<char>(initial | 27));
+    AppendBigEndian(argument, 8, output);
+  }
+}
+
+void AppendCborSigned(int64_t signed_value, std::string* output) {
+  if (signed_value >= 0) {
+    AppendCborHead(0, static_cast<uint64_t>(signed_value), output);
+  } else {
+    AppendCborHead(1, ~static_cast<uint64_t>(signed_value), output);
+  }
+}
+
+void AppendCborDouble(double double_value, std::string* output) {
+  uint32_t single;
+  if (IsSingle(double_value, &single)) {
+    output->push_back('\xfa');
+    AppendBigEndian(single, 4, output);
+  } else {
+    output->push_back('\xfb');
+    AppendBigEndian(GetDoubleBits(double_value), 8, output);
+  }
+}
+
+void AppendCborString(StringPiece str, std::string* output) {
+  AppendCborHead(3, str.size(), output);
+  str.AppendToString(output);
+}
+
+void AppendMsgPackSigned(int64_t signed_value, std::string* output) {
+  if (signed_value >= -32 && signed_value < 0x80) {
+    output->push_back(static_cast<char>(signed_value));
+  } else if (signed_value >= -0x80 && signed_value < 0x80) {
+    output->push_back('\xd0');
+    AppendBigEndian(static_cast<uint64_t>(signed_value), 1, output);
+  } else if (signed_value >= -0x8000 && signed_value < 0x8000) {
+    output->push_back('\xd1');
+    AppendBigEndian(static_cast<uint64_t>(signed_value), 2, output);
+  } else if (signed_value >= -0x80000000LL && signed_value < 0x80000000LL) {
+    output->push_back('\xd2');
+    AppendBigEndian(static_cast<uint64_t>(signed_value), 4, output);
+  } else {
+    output->push_back('\xd3');
+    AppendBigEndian(static_cast<uint64_t>(signed_value), 8, output);
+  }
+}
+
+// Always uses the unsigned formats, even where a fixint would be shorter, so
+// that TYPE_UNSIGNED survives the round trip.
+void AppendMsgPackUnsigned(uint64_t unsigned_value, std::string* output) {
+  if (unsigned_value <= 0xff) {
+    output->push_back('\xcc');
+    AppendBigEndian(unsigned_value, 1, output);
+  } else if (unsigned_value <= 0xffff) {
+    output->push_back('\xcd');
+    AppendBigEndian(unsigned_value, 2, output);
+  } else if (unsigned_value <= 0xffffffff) {
+    output->push_back('\xce');
+    AppendBigEndian(unsigned_value, 4, output);
+  } else {
+    output->push_back('\xcf');
+    AppendBigEndian(unsigned_value, 8, output);
+  }
+}
+
+void AppendMsgPackDouble(double double_value, std::string* output) {
+  uint32_t single;
+  if (IsSingle(double_value, &single)) {
+    output->push_back('\xca');
+    AppendBigEndian(single, 4, output);
+  } else {
+    output->push_back('\xcb');
+    AppendBigEndian(GetDoubleBits(double_value), 8, output);
+  }
+}
+
+// Appends the header of a string, array or map given its fix format (holding
+// up to fix_limit - 1 entries) and its 8-bit, 16-bit and 32-bit formats, with
+// the 8-bit one absent for containers.
+void AppendMsgPackSize(uint8_t fix, size_t fix_limit, char format_8,
+                       char format_16, size_t size, std::string* output) {
+  if (size < fix_limit) {
+    output->push_back(static_cast<char>(fix | size));
+  } else if (format_8 && size <= 0xff) {
+    output->push_back(format_8);
+    AppendBigEndian(size, 1, output);
+  } else if (size <= 0xffff) {
+    output->push_back(format_16);
+    AppendBigEndian(size, 2, output);
+  } else {
+    output->push_back(static_cast<char>(format_16 + 1));
+    AppendBigEndian(size, 4, output);
+  }
+}
+
+void AppendMsgPackString(StringPiece str, std::string* output) {
+  AppendMsgPackSize(0xa0, 32, '\xd9', '\xda', str.size(), output);
+  str.AppendToString(output);
+}
+
+void WriteCborRecursive(const JsonValue& value, std::string* output) {
+  switch (value.type()) {
+    case JsonValue::TYPE_NULL:
+      output->push_back('\xf6');
+      break;
+
+    case JsonValue::TYPE_BOOL:
+      output->push_back(value.bool_value() ? '\xf5' : '\xf4');
+      break;
+
+    case JsonValue::TYPE_SIGNED:
+      AppendCborSigned(value.signed_value(), output);
+      break;
+
+    case JsonValue::TYPE_UNSIGNED:
+      AppendCborHead(0, value.unsigned_value(), output);
+      break;
+
+    case JsonValue::TYPE_DOUBLE:
+      AppendCborDouble(value.double_value(), output);
+      break;
+
+    case JsonValue::TYPE_RAW_NUMBER: {
+      JsonValue buffer;
+      WriteCborRecursive(ResolveJsonRawNumber(value, &buffer), output);
+      break;
+    }
+
+    case JsonValue::TYPE_STRING:
+      AppendCborString(value.string_value(), output);
+      break;
+
+    case JsonValue::TYPE_OBJECT:
+      AppendCborHead(5, value.object_properties_size(), output);
+      for (int index = 0; index < value.object_properties_size(); ++index) {
+        const JsonValue::Property& property = value.object_properties(index);
+        AppendCborString(property.name(), output);
+        WriteCborRecursive(property.value(), output);
+      }
+      break;
+
+    case JsonValue::TYPE_ARRAY:
+      AppendCborHead(4, GetJsonArraySize(value), output);
+      for (int index = 0; index < value.packed_signed_values_size(); ++index) {
+        AppendCborSigned(value.packed_signed_values(index), output);
+      }
+      for (int index = 0; index < value.packed_unsigned_values_size();
+           ++index) {
+        AppendCborHead(0, value.packed_unsigned_values(index), output);
+      }
+      for (int index = 0; index < value.packed_double_values_size(); ++index) {
+        AppendCborDouble(value.packed_double_values(index), output);
+      }
+      for (int index = 0; index < value.array_elements_size(); ++index) {
+        WriteCborRecursive(value.array_elements(index), output);
+      }
+      break;
+  }
+}
+
+void WriteMsgPackRecursive(const JsonValue& value, std::string* output) {
+  switch (value.type()) {
+    case JsonValue::TYPE_NULL:
+      output->push_back('\xc0');
+      break;
+
+    case JsonValue::TYPE_BOOL:
+      output->push_back(value.bool_value() ? '\xc3' : '\xc2');
+      break;
+
+    case JsonValue::TYPE_SIGNED:
+      AppendMsgPackSigned(value.signed_value(), output);
+      break;
+
+    case JsonValue::TYPE_UNSIGNED:
+      AppendMsgPackUnsigned(value.unsigned_value(), output);
+      break;
+
+    case JsonValue::TYPE_DOUBLE:
+      AppendMsgPackDouble(value.double_value(), output);
+      break;
+
+    case JsonValue::TYPE_RAW_NUMBER: {
+      JsonValue buffer;
+      WriteMsgPackRecursive(ResolveJsonRawNumber(value, &buffer), output);
+      break;
+    }
+
+    case JsonValue::TYPE_STRING:
+      AppendMsgPackString(value.string_value(), output);
+      break;
+
+    case JsonValue::TYPE_OBJECT:
+      AppendMsgPackSize(0x80, 16, 0, '\xde', value.object_properties_size(),
+                        output);
+      for (int index = 0; index < value.object_properties_size(); ++index) {
+        const JsonValue::Property& property = value.object_properties(index);
+        AppendMsgPackString(property.name(), output);
+        WriteMsgPackRecursive(property.value(), output);
+      }
+      break;
+
+    case JsonValue::TYPE_ARRAY:
+      AppendMsgPackSize(0x90, 16, 0, '\xdc', GetJsonArraySize(value), output);
+      for (int index = 0; index < value.packed_signed_values_size(); ++index) {
+        AppendMsgPackSigned(value.packed_signed_values(index), output);
+      }
+      for (int index = 0; index < value.packed_unsigned_values_size();
+           ++index) {
+        AppendMsgPackUnsigned(value.packed_unsigned_values(index), output);
+      }
+      for (int index = 0; index < value.packed_double_values_size(); ++index) {
+        AppendMsgPackDouble(value.packed_double_values(index), output);
+      }
+      for (int index = 0; index < value.array_elements_size(); ++index) {
+        WriteMsgPackRecursive(value.array_elements(index), output);
+      }
+      break;
+  }
+}
+
+}  // unnamed namespace
+
+std::string WriteCbor(const JsonValue& value) {
+  std::string cbor;
+  WriteCbor(value, &cbor);
+  return cbor;
+}
+
+void WriteCbor(const JsonValue& value, std::string* output) {
+  PJCORE_CHECK(output);
+  WriteCborRecursive(value, output);
+}
+
+bool ReadCbor(StringPiece cbor, JsonValue* value, Error* error,
+              const JsonReaderConfig& config) {
+  PJCORE_CHECK(value);
+  value->Clear();
+  PJCORE_CHECK(error);
+  error->Clear();
+
+  CborDecoder decoder(cbor);
+
+  PJCORE_REQUIRE_CAUSE(ReadBinary(&decoder, value, error, config),
+                       "Failed to parse CBOR");
+  PJCORE_REQUIRE(decoder.at_end(), "Unexpected data after CBOR item");
+
+  return true;
+}
+
+bool ReadCbor(StringPiece cbor, google::protobuf::Message* message,
+              Error* error) {
+  PJCORE_CHECK(message);
+
+  JsonValue value;
+  PJCORE_REQUIRE_SILENT(ReadCbor(cbor, &value, error), "Failed to read CBOR");
+
+  return UnboxJsonValue(&value, message, error);
+}
+
+std::string WriteMsgPack(const JsonValue& value) {
+  std::string msg_pack;
+  WriteMsgPack(value, &msg_pack);
+  return msg_pack;
+}
+
+void WriteMsgPack(const JsonValue& value, std::string* output) {
+  PJCORE_CHECK(output);
+  WriteMsgPackRecursive(value, output);
+}
+
+bool ReadMsgPack(StringPiece msg_pack, JsonValue* value, Error* error,
+                 const JsonReaderConfig& config) {
+  PJCORE_CHECK(value);
+  value->Clear();
+  PJCORE_CHECK(error);
+  error->Clear();
+
+  MsgPackDecoder decoder(msg_pack);
+
+  PJCORE_REQUIRE_CAUSE(ReadBinary(&decoder, value, error, config),
+                       "Failed to parse MessagePack");
+  PJCORE_REQUIRE(decoder.at_end(), "Unexpected data after MessagePack object");
+
+  return true;
+}
+
+bool ReadMsgPack(StringPiece msg_pack, google::protobuf::Message* message,
+                 Error* error) {
+  PJCORE_CHECK(message);
+
+  JsonValue value;
+  PJCORE_REQUIRE_SILENT(ReadMsgPack(msg_pack, &value, error),
+                        "Failed to read MessagePack");
+
+  return UnboxJsonValue(&value, message, error);
+}
+
+}  // namespace pjcore
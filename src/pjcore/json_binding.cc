@@ -0,0 +1,170 @@
+// JSON [de]serialization for protobuf + embedded HTTP server and client in C++.
+// Copyright (C) 2014 http://protojson.com/
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+
+#include "pjcore/json_binding.h"
+
+#include "pjcore/json_codec.h"
+#include "pjcore/unbox_json_value.h"
+
+namespace pjcore {
+
+void WriteJson(bool bool_value, JsonWriter* writer) {
+  writer->Value(bool_value);
+}
+
+void WriteJson(int32_t signed_value, JsonWriter* writer) {
+  writer->Value(signed_value);
+}
+
+void WriteJson(int64_t signed_value, JsonWriter* writer) {
+  writer->Value(signed_value);
+}
+
+#ifdef PJCORE_DISTINCT_LONG_LONG
+void WriteJson(long long int signed_value,  // NOLINT(runtime/int)
+               JsonWriter* writer) {
+  writer->Value(signed_value);
+}
+#endif  // PJCORE_DISTINCT_LONG_LONG
+
+void WriteJson(uint32_t unsigned_value, JsonWriter* writer) {
+  writer->Value(unsigned_value);
+}
+
+void WriteJson(uint64_t unsigned_value, JsonWriter* writer) {
+  writer->Value(unsigned_value);
+}
+
+#ifdef PJCORE_DISTINCT_LONG_LONG
+void WriteJson(long long unsigned int unsigned_value,  // NOLINT(runtime/int)
+               JsonWriter* writer) {
+  writer->Value(unsigned_value);
+}
+#endif  // PJCORE_DISTINCT_LONG_LONG
+
+void WriteJson(float float_value, JsonWriter* writer) {
+  writer->Value(float_value);
+}
+
+void WriteJson(double double_value, JsonWriter* writer) {
+  writer->Value(double_value);
+}
+
+void WriteJson(const std::string& string_value, JsonWriter* writer) {
+  writer->Value(StringPiece(string_value));
+}
+
+void WriteJson(const JsonValue& value, JsonWriter* writer) {
+  writer->Value(value);
+}
+
+bool ReadJson(JsonTokenizer* tokenizer, bool* bool_value, Error* error) {
+  PJCORE_CHECK(tokenizer);
+  return UnboxJsonValue(*tokenizer, bool_value, error);
+}
+
+bool ReadJson(JsonTokenizer* tokenizer, int32_t* signed_value, Error* error) {
+  PJCORE_CHECK(tokenizer);
+  return UnboxJsonValue(*tokenizer, signed_value, error);
+}
+
+bool ReadJson(JsonTokenizer* tokenizer, int64_t* signed_value, Error* error) {
+  PJCORE_CHECK(tokenizer);
+  return UnboxJsonValue(*tokenizer, signed_value, error);
+}
+
+#ifdef PJCORE_DISTINCT_LONG_LONG
+bool ReadJson(JsonTokenizer* tokenizer,
+              long long int* signed_value,  // NOLINT(runtime/int)
+              Error* error) {
+  PJCORE_CHECK(tokenizer);
+  PJCORE_CHECK(signed_value);
+
+  int64_t candidate;
+  bool result = UnboxJsonValue(*tokenizer, &candidate, error);
+  *signed_value = candidate;
+  return result;
+}
+#endif  // PJCORE_DISTINCT_LONG_LONG
+
+bool ReadJson(JsonTokenizer* tokenizer, uint32_t* unsigned_value,
+              Error* error) {
+  PJCORE_CHECK(tokenizer);
+  return UnboxJsonValue(*tokenizer, unsigned_value, error);
+}
+
+bool ReadJson(JsonTokenizer* tokenizer, uint64_t* unsigned_value,
+              Error* error) {
+  PJCORE_CHECK(tokenizer);
+  return UnboxJsonValue(*tokenizer, unsigned_value, error);
+}
+
+#ifdef PJCORE_DISTINCT_LONG_LONG
+bool ReadJson(JsonTokenizer* tokenizer,
+              long long unsigned int* unsigned_value,  // NOLINT(runtime/int)
+              Error* error) {
+  PJCORE_CHECK(tokenizer);
+  PJCORE_CHECK(unsigned_value);
+
+  uint64_t candidate;
+  bool result = UnboxJsonValue(*tokenizer, &candidate, error);
+  *unsigned_value = candidate;
+  return result;
+}
+#endif  // PJCORE_DISTINCT_LONG_LONG
+
+bool ReadJson(JsonTokenizer* tokenizer, float* float_value, Error* error) {
+  PJCORE_CHECK(tokenizer);
+  return UnboxJsonValue(*tokenizer, float_value, error);
+}
+
+bool ReadJson(JsonTokenizer* tokenizer, double* double_value, Error* error) {
+  PJCORE_CHECK(tokenizer);
+  return UnboxJsonValue(*tokenizer, double_value, error);
+}
+
+bool ReadJson(JsonTokenizer* tokenizer, std::string* string_value,
+              Error* error) {
+  return UnboxJsonString(tokenizer, string_value, error);
+}
+
+bool ReadJson(JsonTokenizer* tokenizer, std::vector<bool>* value,
+              Error* error) {
+  PJCORE_CHECK(tokenizer);
+  PJCORE_CHECK(value);
+  value->clear();
+  PJCORE_CHECK(error);
+  error->Clear();
+
+  PJCORE_REQUIRE(tokenizer->token() == JsonTokenizer::TOKEN_BEGIN_ARRAY,
+                 "Array expected");
+
+  for (;;) {
+    PJCORE_REQUIRE_SILENT(tokenizer->Next(error), "Failed to read element");
+    if (tokenizer->token() == JsonTokenizer::TOKEN_END_ARRAY) {
+      return true;
+    }
+
+    bool element;
+    PJCORE_REQUIRE_SILENT(UnboxJsonValue(*tokenizer, &element, error),
+                          "Failed to read element");
+    value->push_back(element);
+  }
+}
+
+}  // namespace pjcore
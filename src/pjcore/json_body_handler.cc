@@ -0,0 +1,90 @@
+// JSON [de]serialization for protobuf + embedded HTTP server and client in C++.
+// Copyright (C) 2014 http://protojson.com/
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+
+#include "pjcore/json_body_handler.h"
+
+#include "pjcore/third_party/chromium/bind.h"
+#include "pjcore/third_party/chromium/bind_helpers.h"
+
+#include "pjcore/error_util.h"
+#include "pjcore/logging.h"
+#include "pjcore/make_json_value.h"
+
+namespace pjcore {
+
+JsonBodyHttpHandler::JsonBodyHttpHandler(LiveCapturableList* live_list,
+                                         const SharedUvLoop& shared_loop,
+                                         const JsonBodyCallback& callback,
+                                         const JsonReaderConfig& config,
+                                         size_t min_async_size)
+    : AbstractHttpHandler("pjcore::JsonBodyHttpHandler", live_list),
+      shared_loop_(shared_loop),
+      callback_(callback),
+      config_(config),
+      min_async_size_(min_async_size) {
+  PJCORE_CHECK(shared_loop_);
+  PJCORE_CHECK(!callback_.is_null());
+}
+
+void JsonBodyHttpHandler::AsyncHandle(
+    scoped_ptr<HttpRequest> request, const HttpResponseCallback& on_response) {
+  PJCORE_CHECK(request);
+  PJCORE_CHECK(!on_response.is_null());
+
+  if (request->content().empty()) {
+    callback_.Run(request.Pass(), scoped_ptr<JsonValue>(), on_response);
+    return;
+  }
+
+  // The content stays with the request, which the callback owns until it
+  // runs.
+  StringPiece content(request->content());
+
+  ReadJsonAsync(shared_loop_, content,
+                Bind(&JsonBodyHttpHandler::OnBody, callback_,
+                     Passed(&request), on_response),
+                config_, min_async_size_);
+}
+
+JsonBodyHttpHandler::~JsonBodyHttpHandler() { LogDestroy(); }
+
+scoped_ptr<google::protobuf::Message> JsonBodyHttpHandler::CaptureLive()
+    const {
+  scoped_ptr<JsonValue> live(new JsonValue(MakeJsonObject(
+      "shared_loop_ptr", reinterpret_cast<uint64_t>(shared_loop_.get()),
+      "min_async_size", min_async_size_)));
+  return scoped_ptr<google::protobuf::Message>(live.release());
+}
+
+void JsonBodyHttpHandler::OnBody(const JsonBodyCallback& callback,
+                                 scoped_ptr<HttpRequest> request,
+                                 const HttpResponseCallback& on_response,
+                                 scoped_ptr<JsonValue> body,
+                                 const Error& error) {
+  if (!body) {
+    scoped_ptr<HttpResponse> response(new HttpResponse());
+    response->set_status_code(HTTP_STATUS_CODE_BAD_REQUEST);
+    response->set_content(ErrorToString(error, false));
+    on_response.Run(response.Pass(), Error());
+    return;
+  }
+
+  callback.Run(request.Pass(), body.Pass(), on_response);
+}
+
+}  // namespace pjcore
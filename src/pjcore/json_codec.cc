@@ -0,0 +1,211 @@
+// JSON [de]serialization for protobuf + embedded HTTP server and client in C++.
+// Copyright (C) 2014 http://protojson.com/
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+
+#include "pjcore/json_codec.h"
+
+#include <algorithm>
+
+#include "pjcore/name_value_util.h"
+#include "pjcore/number_util.h"
+#include "pjcore/string_piece_util.h"
+
+namespace pjcore {
+
+namespace {
+
+template <typename Source>
+bool UnboxEnumNumberSource(const Source& json_value, int32_t* number,
+                           bool* has_number, Error* error) {
+  PJCORE_CHECK(number);
+  *number = 0;
+  PJCORE_CHECK(has_number);
+  *has_number = false;
+  PJCORE_CHECK(error);
+  error->Clear();
+
+  if (json_value.type() == JsonValue::TYPE_STRING) {
+    *has_number = ReadNumber(json_value.string_value(), number);
+    return true;
+  }
+
+  PJCORE_REQUIRE(UnboxJsonValue(json_value, number, error),
+                 "Invalid enum json_value");
+  *has_number = true;
+  return true;
+}
+
+template <typename Source>
+bool UnboxBytesSource(const Source& json_value, std::string* bytes,
+                      Error* error) {
+  PJCORE_CHECK(bytes);
+  bytes->clear();
+  PJCORE_CHECK(error);
+  error->Clear();
+
+  PJCORE_REQUIRE(json_value.type() == JsonValue::TYPE_STRING,
+                 "Type not mapped to string");
+
+  PJCORE_REQUIRE_SILENT(ReadBase64(json_value.string_value(), bytes, error),
+                        "Invalid Base64");
+  return true;
+}
+
+struct NameIndexLess {
+  explicit NameIndexLess(const std::vector<std::string>& a_names)
+      : names(a_names) {}
+
+  bool operator()(size_t left, size_t right) const {
+    return names[left] < names[right];
+  }
+
+  const std::vector<std::string>& names;
+};
+
+}  // unnamed namespace
+
+bool UnboxJsonEnumNumber(const JsonTokenizer& tokenizer, int32_t* number,
+                         bool* has_number, Error* error) {
+  return UnboxEnumNumberSource(tokenizer, number, has_number, error);
+}
+
+bool UnboxJsonEnumNumber(const JsonValue& json_value, int32_t* number,
+                         bool* has_number, Error* error) {
+  return UnboxEnumNumberSource(json_value, number, has_number, error);
+}
+
+bool UnboxJsonString(JsonTokenizer* tokenizer, std::string* string_value,
+                     Error* error) {
+  PJCORE_CHECK(tokenizer);
+  PJCORE_CHECK(string_value);
+  string_value->clear();
+  PJCORE_CHECK(error);
+  error->Clear();
+
+  PJCORE_REQUIRE(tokenizer->token() == JsonTokenizer::TOKEN_STRING,
+                 "Type not mapped to string");
+
+  string_value->swap(*tokenizer->mutable_string_value());
+  return true;
+}
+
+bool UnboxJsonBytes(const JsonTokenizer& tokenizer, std::string* bytes,
+                    Error* error) {
+  return UnboxBytesSource(tokenizer, bytes, error);
+}
+
+bool UnboxJsonBytes(const JsonValue& json_value, std::string* bytes,
+                    Error* error) {
+  return UnboxBytesSource(json_value, bytes, error);
+}
+
+void WriteJsonBytes(StringPiece bytes, JsonWriter* writer) {
+  PJCORE_CHECK(writer);
+  writer->Value(StringPiece(WriteBase64(bytes)));
+}
+
+bool ReadJsonMessage(JsonTokenizer* tokenizer,
+                     google::protobuf::Message* message, Error* error,
+                     google::protobuf::RepeatedPtrField<JsonValue::Property>*
+                         unknown_object_properties) {
+  PJCORE_CHECK(tokenizer);
+  PJCORE_CHECK(message);
+  PJCORE_CHECK(error);
+
+  JsonValue json_value;
+  PJCORE_REQUIRE_SILENT(ReadJson(tokenizer, &json_value, error),
+                        "Failed to read value");
+
+  return UnboxJsonValue(&json_value, message, error,
+                        unknown_object_properties);
+}
+
+bool ReadJsonProperty(
+    JsonTokenizer* tokenizer, std::string* name,
+    google::protobuf::RepeatedPtrField<JsonValue::Property>* properties,
+    Error* error) {
+  PJCORE_CHECK(tokenizer);
+  PJCORE_CHECK(name);
+  PJCORE_CHECK(properties);
+  PJCORE_CHECK(error);
+
+  JsonValue::Property* property = properties->Add();
+  property->mutable_name()->swap(*name);
+
+  PJCORE_REQUIRE_SILENT(ReadJson(tokenizer, property->mutable_value(), error),
+                        "Failed to read value");
+  return true;
+}
+
+void SortJsonProperties(
+    const JsonReaderConfig& config,
+    google::protobuf::RepeatedPtrField<JsonValue::Property>* properties) {
+  PJCORE_CHECK(properties);
+
+  if (!config.properties_as_is()) {
+    StableSortAndRemoveDuplicatesByName(properties);
+  }
+}
+
+void AppendUnknownJsonProperties(
+    const JsonReaderConfig& config,
+    google::protobuf::RepeatedPtrField<JsonValue::Property>*
+        consumed_properties,
+    google::protobuf::RepeatedPtrField<JsonValue::Property>*
+        unknown_object_properties) {
+  PJCORE_CHECK(consumed_properties);
+  PJCORE_CHECK(unknown_object_properties);
+
+  SortJsonProperties(config, consumed_properties);
+
+  unknown_object_properties->Reserve(unknown_object_properties->size() +
+                                     consumed_properties->size());
+  for (google::protobuf::RepeatedPtrField<JsonValue::Property>::iterator it =
+           consumed_properties->begin();
+       it != consumed_properties->end(); ++it) {
+    unknown_object_properties->Add()->Swap(&*it);
+  }
+  consumed_properties->Clear();
+}
+
+void OrderJsonNames(const JsonReaderConfig& config,
+                    const std::vector<std::string>& names,
+                    std::vector<size_t>* order) {
+  PJCORE_CHECK(order);
+  order->resize(names.size());
+  for (size_t index = 0; index < names.size(); ++index) {
+    (*order)[index] = index;
+  }
+
+  if (config.properties_as_is()) {
+    return;
+  }
+
+  NameIndexLess less(names);
+  std::stable_sort(order->begin(), order->end(), less);
+
+  std::vector<size_t>::iterator end = order->begin();
+  for (std::vector<size_t>::const_iterator it = order->begin();
+       it != order->end(); ++it) {
+    if (end == order->begin() || names[*(end - 1)] != names[*it]) {
+      *end++ = *it;
+    }
+  }
+  order->erase(end, order->end());
+}
+
+}  // namespace pjcore
@@ -0,0 +1,282 @@
+// JSON [de]serialization for protobuf + embedded HTTP server and client in C++.
+// Copyright (C) 2014 http://protojson.com/
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+
+#include "pjcore/json_delta_handler.h"
+
+#include <strings.h>
+
+#include <deque>
+#include <string>
+
+#include "pjcore/json_patch.h"
+#include "pjcore/json_properties.h"
+#include "pjcore/json_util.h"
+#include "pjcore/json_writer.h"
+#include "pjcore/logging.h"
+#include "pjcore/make_json_value.h"
+#include "pjcore/number_util.h"
+
+namespace pjcore {
+
+namespace {
+
+const char kJsonContentType[] = "application/json";
+
+const char kJsonPatchContentType[] = "application/json-patch+json";
+
+const char kJsonPatchInstanceManipulation[] = "json-patch";
+
+bool AreEqualIgnoringCase(StringPiece left, StringPiece right) {
+  return left.size() == right.size() &&
+         strncasecmp(left.data(), right.data(), left.size()) == 0;
+}
+
+StringPiece TrimSpaces(StringPiece str) {
+  while (!str.empty() && (str[0] == ' ' || str[0] == '\t')) {
+    str.remove_prefix(1);
+  }
+
+  while (!str.empty() &&
+         (str[str.size() - 1] == ' ' || str[str.size() - 1] == '\t')) {
+    str.remove_suffix(1);
+  }
+
+  return str;
+}
+
+// Whether the comma-separated header value lists token, ignoring parameters.
+bool HasHeaderToken(StringPiece list, StringPiece token) {
+  while (!list.empty()) {
+    size_t comma = list.find(',');
+    StringPiece item = list.substr(0, comma);
+    list = (comma == StringPiece::npos) ? StringPiece()
+                                        : list.substr(comma + 1);
+
+    if (AreEqualIgnoringCase(TrimSpaces(item.substr(0, item.find(';'))),
+                            token)) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+bool AcceptsJsonPatch(const HttpRequest& request) {
+  for (int index = 0; index < request.headers_size(); ++index) {
+    const HttpHeader& header = request.headers(index);
+    if ((AreEqualIgnoringCase(header.name(), "A-IM") &&
+         HasHeaderToken(header.value(), kJsonPatchInstanceManipulation)) ||
+        (AreEqualIgnoringCase(header.name(), "Accept") &&
+         HasHeaderToken(header.value(), kJsonPatchContentType))) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void AppendHex(uint64_t value, std::string* str) {
+  static const char kHexDigits[] = "0123456789abcdef";
+  for (int shift = 60; shift >= 0; shift -= 4) {
+    str->push_back(kHexDigits[(value >> shift) & 0xf]);
+  }
+}
+
+void AddResponseHeader(StringPiece name, StringPiece value,
+                       HttpResponse* response) {
+  HttpHeader* header = response->add_headers();
+  name.CopyToString(header->mutable_name());
+  value.CopyToString(header->mutable_value());
+}
+
+}  // unnamed namespace
+
+JsonDeltaHttpHandler::JsonDeltaHttpHandler(LiveCapturableList* live_list,
+                                           const JsonValue& document,
+                                           size_t max_versions)
+    : AbstractHttpHandler("pjcore::JsonDeltaHttpHandler", live_list),
+      max_versions_(max_versions) {
+  PJCORE_CHECK_GE(max_versions_, 1u);
+
+  versions_.push_back(Version());
+  versions_.back().document = document;
+  NormalizeJsonProperties(&versions_.back().document);
+  PublishDocument();
+}
+
+void JsonDeltaHttpHandler::Update(const JsonValue& document) {
+  JsonValue normalized(document);
+  NormalizeJsonProperties(&normalized);
+
+  if (AreJsonValuesIdentical(normalized, versions_.back().document)) {
+    return;
+  }
+
+  uint64_t next_version = versions_.back().version + 1;
+
+  versions_.push_back(Version());
+  versions_.back().version = next_version;
+  versions_.back().document.Swap(&normalized);
+
+  while (versions_.size() > max_versions_) {
+    versions_.pop_front();
+  }
+
+  // Cached patches lead to the previous version.
+  for (std::deque<Version>::iterator it = versions_.begin();
+       it != versions_.end(); ++it) {
+    it->patch_content.clear();
+    it->has_patch_content = false;
+  }
+
+  PublishDocument();
+}
+
+void JsonDeltaHttpHandler::MakeResponse(const HttpRequest& request,
+                                        HttpResponse* response) {
+  PJCORE_CHECK(response);
+  response->Clear();
+
+  AddResponseHeader("ETag", versions_.back().entity_tag, response);
+  AddResponseHeader("Vary", "A-IM, Accept", response);
+
+  Version* base = FindBaseVersion(request);
+
+  if (base == &versions_.back()) {
+    response->set_status_code(HTTP_STATUS_CODE_NOT_MODIFIED);
+    return;
+  }
+
+  // Deltas go only to clients that ask for them, and must not be cached as
+  // the document.
+  if (base && AcceptsJsonPatch(request)) {
+    const std::string& patch_content = GetPatchContent(base);
+    if (patch_content.size() < document_content_.size()) {
+      response->set_status_code(HTTP_STATUS_CODE_IM_USED);
+      AddResponseHeader("IM", kJsonPatchInstanceManipulation, response);
+      AddResponseHeader("Cache-Control", "no-store", response);
+      AddResponseHeader("Content-Type", kJsonPatchContentType, response);
+      response->set_content(patch_content);
+      return;
+    }
+  }
+
+  response->set_status_code(HTTP_STATUS_CODE_OK);
+  AddResponseHeader("Content-Type", kJsonContentType, response);
+  response->set_content(document_content_);
+}
+
+void JsonDeltaHttpHandler::AsyncHandle(
+    scoped_ptr<HttpRequest> request, const HttpResponseCallback& on_response) {
+  PJCORE_CHECK(request);
+  PJCORE_CHECK(!on_response.is_null());
+
+  scoped_ptr<HttpResponse> response(new HttpResponse());
+  MakeResponse(*request, response.get());
+
+  on_response.Run(response.Pass(), Error());
+}
+
+JsonDeltaHttpHandler::~JsonDeltaHttpHandler() { LogDestroy(); }
+
+scoped_ptr<google::protobuf::Message> JsonDeltaHttpHandler::CaptureLive()
+    const {
+  scoped_ptr<JsonValue> live(new JsonValue(MakeJsonObject(
+      "version", version(), "first_retained_version",
+      versions_.front().version, "max_versions", max_versions_,
+      "document_size", document_content_.size())));
+  return scoped_ptr<google::protobuf::Message>(live.release());
+}
+
+void JsonDeltaHttpHandler::PublishDocument() {
+  Version* current = &versions_.back();
+
+  document_content_.clear();
+  WriteJson(current->document, &document_content_);
+
+  current->entity_tag = "\"";
+  AppendNumber(current->version, &current->entity_tag);
+  current->entity_tag.push_back('-');
+  AppendHex(HashJsonValue(current->document), &current->entity_tag);
+  current->entity_tag.push_back('"');
+}
+
+JsonDeltaHttpHandler::Version* JsonDeltaHttpHandler::FindBaseVersion(
+    const HttpRequest& request) {
+  Version* base = NULL;
+
+  for (int header_index = 0; header_index < request.headers_size();
+       ++header_index) {
+    const HttpHeader& header = request.headers(header_index);
+    if (!AreEqualIgnoringCase(header.name(), "If-None-Match")) {
+      continue;
+    }
+
+    StringPiece list(header.value());
+    while (!list.empty()) {
+      size_t comma = list.find(',');
+      StringPiece entity_tag = TrimSpaces(list.substr(0, comma));
+      list = (comma == StringPiece::npos) ? StringPiece()
+                                          : list.substr(comma + 1);
+
+      if (entity_tag == "*") {
+        return &versions_.back();
+      }
+
+      // Weak tags name the same versions as strong ones.
+      if (entity_tag.starts_with("W/")) {
+        entity_tag.remove_prefix(2);
+      }
+
+      size_t dash = entity_tag.find('-');
+      uint64_t tag_version;
+      if (dash == StringPiece::npos ||
+          !ReadNumber(entity_tag.substr(1, dash - 1), &tag_version) ||
+          tag_version < versions_.front().version ||
+          tag_version > versions_.back().version) {
+        continue;
+      }
+
+      // Versions are consecutive, so the tag maps directly to an index. The
+      // content hash must match too.
+      Version* candidate = &versions_[tag_version - versions_.front().version];
+      if (entity_tag != candidate->entity_tag) {
+        continue;
+      }
+      if (!base || base->version < candidate->version) {
+        base = candidate;
+      }
+    }
+  }
+
+  return base;
+}
+
+const std::string& JsonDeltaHttpHandler::GetPatchContent(Version* base) {
+  PJCORE_CHECK(base);
+
+  if (!base->has_patch_content) {
+    WriteJson(MakeJsonPatch(base->document, document()),
+              &base->patch_content);
+    base->has_patch_content = true;
+  }
+
+  return base->patch_content;
+}
+
+}  // namespace pjcore
@@ -0,0 +1,351 @@
+// JSON [de]serialization for protobuf + embedded HTTP server and client in C++.
+// Copyright (C) 2014 http://protojson.com/
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+
+#include "pjcore/json_document.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "pjcore/json_patch.h"
+#include "pjcore/json_properties.h"
+#include "pjcore/json_util.h"
+#include "pjcore/json_writer.h"
+#include "pjcore/logging.h"
+#include "pjcore/unicode.h"
+
+namespace pjcore {
+
+struct JsonDocument::Node {
+  Node() : offset(0), length(0), dirty(true) {}
+
+  ~Node() { ClearChildren(); }
+
+  void ClearChildren() {
+    for (std::vector<Node*>::iterator it = children.begin();
+         it != children.end(); ++it) {
+      delete *it;
+    }
+    children.clear();
+  }
+
+  // Of the text within the text of the container, or of the document.
+  size_t offset;
+
+  size_t length;
+
+  // Whether the text is to be rewritten.
+  bool dirty;
+
+  // One per member of a written object or unpacked array, none otherwise.
+  std::vector<Node*> children;
+};
+
+namespace {
+
+int GetMemberCount(const JsonValue& value) {
+  switch (value.type()) {
+    case JsonValue::TYPE_OBJECT:
+      return value.object_properties_size();
+
+    case JsonValue::TYPE_ARRAY:
+      return IsPackedJsonArray(value) ? 0 : value.array_elements_size();
+
+    default:
+      return 0;
+  }
+}
+
+bool LessPropertyName(const JsonValue::Property& property,
+                      const std::string& name) {
+  return property.name() < name;
+}
+
+// Returns the index of the first property of object not named before name.
+int LowerBoundPropertyIndex(const JsonValue& object, const std::string& name) {
+  return static_cast<int>(std::lower_bound(object.object_properties().begin(),
+                                           object.object_properties().end(),
+                                           name, &LessPropertyName) -
+                          object.object_properties().begin());
+}
+
+int FindPropertyIndex(const JsonValue& object, const std::string& name) {
+  int index = LowerBoundPropertyIndex(object, name);
+  if (index < object.object_properties_size() &&
+      object.object_properties(index).name() == name) {
+    return index;
+  }
+  return -1;
+}
+
+}  // unnamed namespace
+
+JsonDocument::JsonDocument(const JsonWriterConfig& config)
+    : config_(config), root_(new Node()) {}
+
+JsonDocument::~JsonDocument() {}
+
+JsonValue* JsonDocument::MutableValue(StringPiece json_pointer,
+                                      Error* error) {
+  PJCORE_CHECK(error);
+  error->Clear();
+
+  std::vector<std::string> tokens;
+  PJCORE_NULL_REQUIRE_SILENT(ParseJsonPointer(json_pointer, &tokens, error),
+                             "Failed to parse JSON Pointer");
+
+  JsonValue* target = &value_;
+  Node* node = root_.get();
+
+  if (!tokens.empty()) {
+    target = FindParent(tokens, &node, error);
+    PJCORE_NULL_REQUIRE_SILENT(target, "Failed to find parent");
+
+    const std::string& token = tokens.back();
+    bool inserted = false;
+    int index = 0;
+
+    if (target->type() == JsonValue::TYPE_OBJECT) {
+      index = LowerBoundPropertyIndex(*target, token);
+      if (index == target->object_properties_size() ||
+          target->object_properties(index).name() != token) {
+        target->add_object_properties()->set_name(token);
+        for (int moved = target->object_properties_size() - 1; moved > index;
+             --moved) {
+          target->mutable_object_properties()->SwapElements(moved - 1, moved);
+        }
+        inserted = true;
+      }
+      target = target->mutable_object_properties(index)->mutable_value();
+    } else if (target->type() == JsonValue::TYPE_ARRAY) {
+      UnpackJsonArray(target);
+      PJCORE_NULL_REQUIRE_SILENT(
+          ReadJsonPointerIndex(token, target->array_elements_size(), true,
+                               &index, error),
+          "Failed to read array index");
+      if (index == target->array_elements_size()) {
+        target->add_array_elements();
+        inserted = true;
+      }
+      target = target->mutable_array_elements(index);
+    } else {
+      PJCORE_NULL_FAIL("Object or array expected");
+    }
+
+    if (node && !node->children.empty()) {
+      if (inserted) {
+        node->children.insert(node->children.begin() + index, new Node());
+      }
+      node = node->children[index];
+    } else {
+      node = NULL;
+    }
+  }
+
+  // The caller may change the value at will, so nothing within is kept.
+  if (node) {
+    node->ClearChildren();
+    node->dirty = true;
+  }
+
+  return target;
+}
+
+bool JsonDocument::RemoveValue(StringPiece json_pointer, Error* error) {
+  PJCORE_CHECK(error);
+  error->Clear();
+
+  std::vector<std::string> tokens;
+  PJCORE_REQUIRE_SILENT(ParseJsonPointer(json_pointer, &tokens, error),
+                        "Failed to parse JSON Pointer");
+  PJCORE_REQUIRE(!tokens.empty(), "Cannot remove the whole value");
+
+  Node* node = NULL;
+  JsonValue* parent = FindParent(tokens, &node, error);
+  PJCORE_REQUIRE_SILENT(parent, "Failed to find parent");
+
+  const std::string& token = tokens.back();
+  int index = 0;
+
+  if (parent->type() == JsonValue::TYPE_OBJECT) {
+    index = FindPropertyIndex(*parent, token);
+    PJCORE_REQUIRE(index >= 0, "Missing property");
+
+    JsonPropertyList* properties = parent->mutable_object_properties();
+    for (int moved = index; moved + 1 < properties->size(); ++moved) {
+      properties->SwapElements(moved, moved + 1);
+    }
+    properties->RemoveLast();
+  } else if (parent->type() == JsonValue::TYPE_ARRAY) {
+    UnpackJsonArray(parent);
+    PJCORE_REQUIRE_SILENT(
+        ReadJsonPointerIndex(token, parent->array_elements_size() - 1, false,
+                             &index, error),
+        "Failed to read array index");
+
+    google::protobuf::RepeatedPtrField<JsonValue>* elements =
+        parent->mutable_array_elements();
+    for (int moved = index; moved + 1 < elements->size(); ++moved) {
+      elements->SwapElements(moved, moved + 1);
+    }
+    elements->RemoveLast();
+  } else {
+    PJCORE_FAIL("Object or array expected");
+  }
+
+  if (node && !node->children.empty()) {
+    delete node->children[index];
+    node->children.erase(node->children.begin() + index);
+  }
+
+  return true;
+}
+
+const std::string& JsonDocument::GetJson() {
+  if (root_->dirty) {
+    std::string json;
+    json.reserve(json_.size());
+    WriteNode(value_, 0, 0, root_.get(), &json);
+    json_.swap(json);
+  }
+
+  return json_;
+}
+
+// Marks the containers on the way dirty. node is left NULL below the written
+// containers.
+JsonValue* JsonDocument::FindParent(const std::vector<std::string>& tokens,
+                                    Node** node, Error* error) {
+  PJCORE_CHECK(node);
+
+  JsonValue* target = &value_;
+  *node = root_.get();
+  (*node)->dirty = true;
+
+  for (size_t token_index = 0; token_index + 1 < tokens.size();
+       ++token_index) {
+    const std::string& token = tokens[token_index];
+    int index = 0;
+
+    if (target->type() == JsonValue::TYPE_OBJECT) {
+      index = FindPropertyIndex(*target, token);
+      PJCORE_NULL_REQUIRE(index >= 0, "Missing property");
+      target = target->mutable_object_properties(index)->mutable_value();
+    } else if (target->type() == JsonValue::TYPE_ARRAY) {
+      UnpackJsonArray(target);
+      PJCORE_NULL_REQUIRE_SILENT(
+          ReadJsonPointerIndex(token, target->array_elements_size() - 1, false,
+                               &index, error),
+          "Failed to read array index");
+      target = target->mutable_array_elements(index);
+    } else {
+      PJCORE_NULL_FAIL("Object or array expected");
+    }
+
+    if (*node && !(*node)->children.empty()) {
+      *node = (*node)->children[index];
+      (*node)->dirty = true;
+    } else {
+      *node = NULL;
+    }
+  }
+
+  PJCORE_NULL_REQUIRE(target->type() == JsonValue::TYPE_OBJECT ||
+                          target->type() == JsonValue::TYPE_ARRAY,
+                      "Object or array expected");
+
+  return target;
+}
+
+// Copies clean text from json_, where the text of node began at old_begin.
+void JsonDocument::WriteNode(const JsonValue& value, size_t depth,
+                             size_t old_begin, Node* node, std::string* json) {
+  size_t begin = json->size();
+
+  if (!node->dirty) {
+    json->append(json_, old_begin, node->length);
+    return;
+  }
+
+  int member_count = GetMemberCount(value);
+  if (!member_count) {
+    node->ClearChildren();
+    internal::WriteNestedJson(value, depth, config_, json);
+  } else {
+    if (node->children.size() != static_cast<size_t>(member_count)) {
+      node->ClearChildren();
+      for (int index = 0; index < member_count; ++index) {
+        node->children.push_back(new Node());
+      }
+    }
+
+    if (config_.include_byte_order_mark() && !depth) {
+      StringPiece byte_order_mark = Unicode::ByteOrderMarkUtf8();
+      json->append(byte_order_mark.data(), byte_order_mark.size());
+    }
+
+    bool is_object = value.type() == JsonValue::TYPE_OBJECT;
+    json->push_back(is_object ? '{' : '[');
+
+    std::string newline_indent;
+    if (config_.indent()) {
+      newline_indent.resize(1 + (depth + 1) * config_.indent(), ' ');
+      newline_indent[0] = '\n';
+    }
+
+    for (int index = 0; index < member_count; ++index) {
+      if (index > 0) {
+        json->push_back(',');
+      }
+      if (config_.indent()) {
+        json->append(newline_indent);
+      } else if (index != 0 && config_.space()) {
+        json->push_back(' ');
+      }
+
+      const JsonValue* member = NULL;
+      if (is_object) {
+        const JsonValue::Property& property = value.object_properties(index);
+        internal::WriteJsonName(property.name(), config_, json);
+        json->push_back(':');
+        if (config_.space()) {
+          json->push_back(' ');
+        }
+        member = &property.value();
+      } else {
+        member = &value.array_elements(index);
+      }
+
+      Node* child = node->children[index];
+      size_t child_old_begin = old_begin + child->offset;
+      child->offset = json->size() - begin;
+      WriteNode(*member, depth + 1, child_old_begin, child, json);
+    }
+
+    if (config_.indent()) {
+      newline_indent.resize(1 + depth * config_.indent());
+      json->append(newline_indent);
+    }
+    json->push_back(is_object ? '}' : ']');
+  }
+
+  node->length = json->size() - begin;
+  node->dirty = false;
+}
+
+}  // namespace pjcore
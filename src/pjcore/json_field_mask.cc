@@ -0,0 +1,108 @@
+// JSON [de]serialization for protobuf + embedded HTTP server and client in C++.
+// Copyright (C) 2014 http://protojson.com/
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+
+#include "pjcore/json_field_mask.h"
+
+#include <algorithm>
+
+namespace pjcore {
+
+namespace {
+
+struct ChildNameLess {
+  bool operator()(const std::pair<std::string, JsonFieldMask*>& child,
+                  StringPiece name) const {
+    return StringPiece(child.first) < name;
+  }
+};
+
+}  // unnamed namespace
+
+JsonFieldMask::JsonFieldMask() {}
+
+JsonFieldMask::JsonFieldMask(StringPiece paths) {
+  while (!paths.empty()) {
+    size_t comma = paths.find(',');
+    StringPiece path = paths.substr(0, comma);
+    if (!path.empty()) {
+      AddPath(path);
+    }
+    if (comma == StringPiece::npos) {
+      break;
+    }
+    paths.remove_prefix(comma + 1);
+  }
+}
+
+JsonFieldMask::~JsonFieldMask() { Clear(); }
+
+void JsonFieldMask::AddPath(StringPiece path) {
+  JsonFieldMask* node = this;
+
+  for (;;) {
+    size_t dot = path.find('.');
+    StringPiece name = path.substr(0, dot);
+
+    ChildList::iterator it =
+        std::lower_bound(node->children_.begin(), node->children_.end(), name,
+                         ChildNameLess());
+
+    if (it != node->children_.end() && StringPiece(it->first) == name) {
+      if (it->second->selects_all()) {
+        // A shorter path already selects everything below.
+        return;
+      }
+    } else {
+      it = node->children_.insert(
+          it, std::make_pair(name.as_string(), new JsonFieldMask()));
+    }
+
+    node = it->second;
+
+    if (dot == StringPiece::npos) {
+      node->Clear();
+      return;
+    }
+    path.remove_prefix(dot + 1);
+  }
+}
+
+const JsonFieldMask* JsonFieldMask::Find(StringPiece name) const {
+  if (selects_all()) {
+    return this;
+  }
+
+  ChildList::const_iterator it = std::lower_bound(
+      children_.begin(), children_.end(), name, ChildNameLess());
+
+  if (it == children_.end() || StringPiece(it->first) != name) {
+    return NULL;
+  }
+
+  return it->second;
+}
+
+void JsonFieldMask::Clear() {
+  for (ChildList::iterator it = children_.begin(); it != children_.end();
+       ++it) {
+    delete it->second;
+  }
+  children_.clear();
+}
+
+}  // namespace pjcore
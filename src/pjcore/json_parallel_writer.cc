@@ -0,0 +1,185 @@
+// JSON [de]serialization for protobuf + embedded HTTP server and client in C++.
+// Copyright (C) 2014 http://protojson.com/
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+
+#include "pjcore/json_parallel_writer.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "pjcore/abstract_uv.h"
+#include "pjcore/json_parallel_writer_internal.h"
+#include "pjcore/json_util.h"
+#include "pjcore/json_writer.h"
+#include "pjcore/logging.h"
+#include "pjcore/unicode.h"
+
+namespace pjcore {
+
+namespace {
+
+struct Piece {
+  Piece() : container(NULL), begin(0), end(0), config(NULL) {}
+
+  const JsonValue* container;
+
+  int begin;
+
+  int end;
+
+  const JsonWriterConfig* config;
+
+  std::string output;
+
+  uv_thread_t thread;
+};
+
+void WritePiece(void* arg) {
+  Piece* piece = static_cast<Piece*>(arg);
+  PJCORE_CHECK(piece);
+  internal::WriteJsonMembers(*piece->container, piece->begin, piece->end,
+                             *piece->config, &piece->output);
+}
+
+int GetMemberCount(const JsonValue& value) {
+  switch (value.type()) {
+    case JsonValue::TYPE_OBJECT:
+      return value.object_properties_size();
+
+    case JsonValue::TYPE_ARRAY:
+      return IsPackedJsonArray(value) ? 0 : value.array_elements_size();
+
+    default:
+      return 0;
+  }
+}
+
+// Valid after ByteSize() of the container.
+int GetCachedMemberSize(const JsonValue& container, int index) {
+  return container.type() == JsonValue::TYPE_OBJECT
+             ? container.object_properties(index).GetCachedSize()
+             : container.array_elements(index).GetCachedSize();
+}
+
+}  // unnamed namespace
+
+void WriteJsonParallel(const JsonValue& value, std::string* output,
+                       const JsonWriterConfig& config, size_t thread_count,
+                       size_t min_parallel_size, AbstractUv* uv) {
+  PJCORE_CHECK(output);
+  PJCORE_CHECK(uv);
+
+  int member_count = GetMemberCount(value);
+  if (thread_count < 2 || member_count < 2 ||
+      static_cast<size_t>(value.ByteSize()) < min_parallel_size) {
+    WriteJson(value, output, config);
+    return;
+  }
+
+  std::string type_error;
+  PJCORE_CHECK(VerifyJsonType(value, &type_error));  // type_error
+
+  size_t piece_count =
+      std::min(thread_count, static_cast<size_t>(member_count));
+  std::vector<Piece> pieces(piece_count);
+
+  // Splits the members by their encoded sizes, cached by ByteSize() above.
+  uint64_t total_size = 0;
+  for (int index = 0; index < member_count; ++index) {
+    total_size += GetCachedMemberSize(value, index);
+  }
+
+  uint64_t cumulative_size = 0;
+  int begin = 0;
+  for (size_t piece_index = 0; piece_index < piece_count; ++piece_index) {
+    Piece& piece = pieces[piece_index];
+    piece.container = &value;
+    piece.config = &config;
+    piece.begin = begin;
+
+    // Leaves at least one member for each of the remaining pieces.
+    int max_end =
+        member_count - static_cast<int>(piece_count - piece_index) + 1;
+    uint64_t target_size = total_size * (piece_index + 1) / piece_count;
+    int end = begin;
+    do {
+      cumulative_size += GetCachedMemberSize(value, end);
+      ++end;
+    } while (end < max_end && cumulative_size < target_size);
+
+    piece.end = end;
+    begin = end;
+  }
+  pieces.back().end = member_count;
+
+  for (size_t piece_index = 1; piece_index < piece_count; ++piece_index) {
+    int thread_create_status = uv->thread_create(
+        &pieces[piece_index].thread, &WritePiece, &pieces[piece_index]);
+    PJCORE_CHECK_EQ(0, thread_create_status);  // thread_create_status
+  }
+
+  WritePiece(&pieces[0]);
+
+  for (size_t piece_index = 1; piece_index < piece_count; ++piece_index) {
+    int thread_join_status = uv->thread_join(&pieces[piece_index].thread);
+    PJCORE_CHECK_EQ(0, thread_join_status);  // thread_join_status
+  }
+
+  bool is_object = value.type() == JsonValue::TYPE_OBJECT;
+
+  // Byte order mark, brackets and the final newline.
+  size_t total_length = output->size() + 6;
+  for (size_t piece_index = 0; piece_index < piece_count; ++piece_index) {
+    total_length += pieces[piece_index].output.size();
+  }
+  output->reserve(total_length);
+
+  if (config.include_byte_order_mark()) {
+    StringPiece byte_order_mark = Unicode::ByteOrderMarkUtf8();
+    output->append(byte_order_mark.data(), byte_order_mark.size());
+  }
+
+  output->push_back(is_object ? '{' : '[');
+
+  for (size_t piece_index = 0; piece_index < piece_count; ++piece_index) {
+    output->append(pieces[piece_index].output);
+  }
+
+  if (config.indent()) {
+    output->push_back('\n');
+  }
+  output->push_back(is_object ? '}' : ']');
+}
+
+void WriteJsonParallel(const JsonValue& value, std::string* output,
+                       const JsonWriterConfig& config, size_t thread_count,
+                       size_t min_parallel_size) {
+  WriteJsonParallel(value, output, config, thread_count, min_parallel_size,
+                    GetRealUv());
+}
+
+std::string WriteJsonParallel(const JsonValue& value,
+                              const JsonWriterConfig& config,
+                              size_t thread_count, size_t min_parallel_size) {
+  std::string output;
+  WriteJsonParallel(value, &output, config, thread_count, min_parallel_size,
+                    GetRealUv());
+  return output;
+}
+
+}  // namespace pjcore
@@ -0,0 +1,36 @@
+// JSON [de]serialization for protobuf + embedded HTTP server and client in C++.
+// Copyright (C) 2014 http://protojson.com/
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+#ifndef PJCORE_JSON_PARALLEL_WRITER_INTERNAL_H_
+#define PJCORE_JSON_PARALLEL_WRITER_INTERNAL_H_
+
+#include <string>
+
+#include "pjcore/json.pb.h"
+
+namespace pjcore {
+
+class AbstractUv;
+
+// WriteJsonParallel creating and joining its threads through uv.
+void WriteJsonParallel(const JsonValue& value, std::string* output,
+                       const JsonWriterConfig& config, size_t thread_count,
+                       size_t min_parallel_size, AbstractUv* uv);
+
+}  // namespace pjcore
+
+#endif  // PJCORE_JSON_PARALLEL_WRITER_INTERNAL_H_
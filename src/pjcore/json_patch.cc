@@ -0,0 +1,688 @@
+// JSON [de]serialization for protobuf + embedded HTTP server and client in C++.
+// Copyright (C) 2014 http://protojson.com/
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+
+#include "pjcore/json_patch.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "pjcore/json_properties.h"
+#include "pjcore/json_util.h"
+#include "pjcore/logging.h"
+#include "pjcore/make_json_value.h"
+#include "pjcore/name_value_util.h"
+#include "pjcore/number_util.h"
+#include "pjcore/third_party/chromium/macros.h"
+
+#ifdef min
+#undef min
+#endif
+
+namespace pjcore {
+
+namespace {
+
+typedef google::protobuf::RepeatedPtrField<JsonValue> JsonElementList;
+
+const JsonElementList& GetUnpackedElements(const JsonValue& array,
+                                           JsonValue* buffer) {
+  if (!IsPackedJsonArray(array)) {
+    return array.array_elements();
+  }
+
+  *buffer = array;
+  UnpackJsonArray(buffer);
+  return buffer->array_elements();
+}
+
+void AppendJsonPointerIndex(int index, std::string* json_pointer) {
+  json_pointer->push_back('/');
+  AppendNumber(index, json_pointer);
+}
+
+class JsonPatchBuilder {
+ public:
+  JsonPatchBuilder(size_t max_array_diff_cells, JsonValue* patch)
+      : max_array_diff_cells_(max_array_diff_cells), patch_(patch) {}
+
+  void Diff(const JsonValue& from, const JsonValue& to, std::string* path);
+
+ private:
+  void DiffObjects(const JsonValue& from, const JsonValue& to,
+                   std::string* path);
+
+  void DiffArrays(const JsonValue& from, const JsonValue& to,
+                  std::string* path);
+
+  void DiffElement(const JsonValue& from, const JsonValue& to, int index,
+                   std::string* path);
+
+  void AddOperation(const char* op, const std::string& path,
+                    const JsonValue* value);
+
+  size_t max_array_diff_cells_;
+
+  JsonValue* patch_;
+
+  DISALLOW_COPY_AND_ASSIGN(JsonPatchBuilder);
+};
+
+void JsonPatchBuilder::Diff(const JsonValue& from, const JsonValue& to,
+                            std::string* path) {
+  if (from.type() == JsonValue::TYPE_OBJECT &&
+      to.type() == JsonValue::TYPE_OBJECT) {
+    DiffObjects(from, to, path);
+  } else if (from.type() == JsonValue::TYPE_ARRAY &&
+             to.type() == JsonValue::TYPE_ARRAY) {
+    DiffArrays(from, to, path);
+  } else if (!AreJsonValuesIdentical(from, to)) {
+    AddOperation("replace", *path, &to);
+  }
+}
+
+void JsonPatchBuilder::DiffObjects(const JsonValue& from, const JsonValue& to,
+                                   std::string* path) {
+  size_t path_length = path->size();
+
+  google::protobuf::RepeatedPtrField<JsonValue::Property>::const_iterator
+      from_it = from.object_properties().begin(),
+      to_it = to.object_properties().begin();
+
+  while (from_it != from.object_properties().end() ||
+         to_it != to.object_properties().end()) {
+    if (to_it == to.object_properties().end() ||
+        (from_it != from.object_properties().end() &&
+         from_it->name() < to_it->name())) {
+      AppendJsonPointerToken(from_it->name(), path);
+      AddOperation("remove", *path, NULL);
+      ++from_it;
+    } else if (from_it == from.object_properties().end() ||
+               to_it->name() < from_it->name()) {
+      AppendJsonPointerToken(to_it->name(), path);
+      AddOperation("add", *path, &to_it->value());
+      ++to_it;
+    } else {
+      AppendJsonPointerToken(from_it->name(), path);
+      Diff(from_it->value(), to_it->value(), path);
+      ++from_it;
+      ++to_it;
+    }
+    path->resize(path_length);
+  }
+}
+
+void JsonPatchBuilder::DiffArrays(const JsonValue& from, const JsonValue& to,
+                                  std::string* path) {
+  JsonValue from_buffer;
+  const JsonElementList& from_elements =
+      GetUnpackedElements(from, &from_buffer);
+  JsonValue to_buffer;
+  const JsonElementList& to_elements = GetUnpackedElements(to, &to_buffer);
+
+  int from_size = from_elements.size();
+  int to_size = to_elements.size();
+
+  std::vector<uint64_t> from_hashes(from_size);
+  for (int index = 0; index < from_size; ++index) {
+    from_hashes[index] = HashJsonValue(from_elements.Get(index));
+  }
+
+  std::vector<uint64_t> to_hashes(to_size);
+  for (int index = 0; index < to_size; ++index) {
+    to_hashes[index] = HashJsonValue(to_elements.Get(index));
+  }
+
+  // Only the differing middle parts are diffed.
+  int prefix = 0;
+  while (prefix < from_size && prefix < to_size &&
+         AreJsonValuesIdentical(from_elements.Get(prefix), from_hashes[prefix],
+                                to_elements.Get(prefix), to_hashes[prefix])) {
+    ++prefix;
+  }
+
+  int suffix = 0;
+  while (suffix < from_size - prefix && suffix < to_size - prefix &&
+         AreJsonValuesIdentical(from_elements.Get(from_size - 1 - suffix),
+                                from_hashes[from_size - 1 - suffix],
+                                to_elements.Get(to_size - 1 - suffix),
+                                to_hashes[to_size - 1 - suffix])) {
+    ++suffix;
+  }
+
+  int from_count = from_size - prefix - suffix;
+  int to_count = to_size - prefix - suffix;
+
+  if (from_count && to_count &&
+      static_cast<size_t>(from_count) >
+          max_array_diff_cells_ / static_cast<size_t>(to_count)) {
+    int common_count = std::min(from_count, to_count);
+    for (int offset = 0; offset < common_count; ++offset) {
+      DiffElement(from_elements.Get(prefix + offset),
+                  to_elements.Get(prefix + offset), prefix + offset, path);
+    }
+
+    size_t path_length = path->size();
+    for (int offset = from_count - 1; offset >= common_count; --offset) {
+      AppendJsonPointerIndex(prefix + offset, path);
+      AddOperation("remove", *path, NULL);
+      path->resize(path_length);
+    }
+    for (int offset = common_count; offset < to_count; ++offset) {
+      AppendJsonPointerIndex(prefix + offset, path);
+      AddOperation("add", *path, &to_elements.Get(prefix + offset));
+      path->resize(path_length);
+    }
+    return;
+  }
+
+  // Edit distances between the first from_index elements of the middle of
+  // from and the first to_index elements of the middle of to.
+  int stride = to_count + 1;
+  std::vector<int> distances((from_count + 1) * stride);
+  for (int from_index = 0; from_index <= from_count; ++from_index) {
+    for (int to_index = 0; to_index <= to_count; ++to_index) {
+      int* distance = &distances[from_index * stride + to_index];
+      if (!from_index || !to_index) {
+        *distance = from_index + to_index;
+        continue;
+      }
+
+      int substitution =
+          distances[(from_index - 1) * stride + to_index - 1] +
+          !AreJsonValuesIdentical(
+              from_elements.Get(prefix + from_index - 1),
+              from_hashes[prefix + from_index - 1],
+              to_elements.Get(prefix + to_index - 1),
+              to_hashes[prefix + to_index - 1]);
+      int removal = distances[(from_index - 1) * stride + to_index] + 1;
+      int addition = distances[from_index * stride + to_index - 1] + 1;
+      *distance = std::min(substitution, std::min(removal, addition));
+    }
+  }
+
+  // Walking back from the end keeps the indices of operations valid: before
+  // each step the array holds the first from_index elements of from, then
+  // the last elements of to.
+  size_t path_length = path->size();
+  int from_index = from_count;
+  int to_index = to_count;
+  while (from_index || to_index) {
+    int distance = distances[from_index * stride + to_index];
+
+    if (from_index && to_index &&
+        distance == distances[(from_index - 1) * stride + to_index - 1] +
+                        !AreJsonValuesIdentical(
+                            from_elements.Get(prefix + from_index - 1),
+                            from_hashes[prefix + from_index - 1],
+                            to_elements.Get(prefix + to_index - 1),
+                            to_hashes[prefix + to_index - 1])) {
+      DiffElement(from_elements.Get(prefix + from_index - 1),
+                  to_elements.Get(prefix + to_index - 1),
+                  prefix + from_index - 1, path);
+      --from_index;
+      --to_index;
+    } else if (from_index &&
+               distance == distances[(from_index - 1) * stride + to_index] +
+                               1) {
+      AppendJsonPointerIndex(prefix + from_index - 1, path);
+      AddOperation("remove", *path, NULL);
+      path->resize(path_length);
+      --from_index;
+    } else {
+      AppendJsonPointerIndex(prefix + from_index, path);
+      AddOperation("add", *path, &to_elements.Get(prefix + to_index - 1));
+      path->resize(path_length);
+      --to_index;
+    }
+  }
+}
+
+void JsonPatchBuilder::DiffElement(const JsonValue& from, const JsonValue& to,
+                                   int index, std::string* path) {
+  size_t path_length = path->size();
+  AppendJsonPointerIndex(index, path);
+  Diff(from, to, path);
+  path->resize(path_length);
+}
+
+void JsonPatchBuilder::AddOperation(const char* op, const std::string& path,
+                                    const JsonValue* value) {
+  JsonValue* operation = patch_->add_array_elements();
+  operation->set_type(JsonValue::TYPE_OBJECT);
+  SetJsonProperty(operation, "op", op);
+  SetJsonProperty(operation, "path", path);
+  if (value) {
+    SetJsonProperty(operation, "value", *value);
+  }
+}
+
+}  // unnamed namespace
+
+bool ParseJsonPointer(StringPiece json_pointer,
+                      std::vector<std::string>* tokens, Error* error) {
+  tokens->clear();
+  if (json_pointer.empty()) {
+    return true;
+  }
+
+  PJCORE_REQUIRE(json_pointer[0] == '/', "JSON Pointer must start with /");
+
+  tokens->push_back(std::string());
+  for (size_t offset = 1; offset < json_pointer.size(); ++offset) {
+    switch (json_pointer[offset]) {
+      case '/':
+        tokens->push_back(std::string());
+        break;
+
+      case '~':
+        PJCORE_REQUIRE(offset + 1 < json_pointer.size() &&
+                           (json_pointer[offset + 1] == '0' ||
+                            json_pointer[offset + 1] == '1'),
+                       "Invalid JSON Pointer escape");
+        ++offset;
+        tokens->back().push_back(json_pointer[offset] == '0' ? '~' : '/');
+        break;
+
+      default:
+        tokens->back().push_back(json_pointer[offset]);
+        break;
+    }
+  }
+
+  return true;
+}
+
+bool ReadJsonPointerIndex(const std::string& token, int max_index,
+                          bool allow_end, int* index, Error* error) {
+  if (allow_end && token == "-") {
+    *index = max_index;
+    return true;
+  }
+
+  PJCORE_REQUIRE(!token.empty() && token.size() <= 10 &&
+                     (token.size() == 1 || token[0] != '0'),
+                 "Invalid array index");
+
+  int64_t value = 0;
+  for (size_t offset = 0; offset < token.size(); ++offset) {
+    PJCORE_REQUIRE(token[offset] >= '0' && token[offset] <= '9',
+                   "Invalid array index");
+    value = value * 10 + (token[offset] - '0');
+  }
+
+  PJCORE_REQUIRE(value <= max_index, "Array index out of range");
+
+  *index = static_cast<int>(value);
+  return true;
+}
+
+namespace {
+
+JsonValue* FindJsonPointerTarget(JsonValue* root,
+                                 const std::vector<std::string>& tokens,
+                                 size_t token_count, Error* error) {
+  JsonValue* target = root;
+
+  for (size_t token_index = 0; token_index < token_count; ++token_index) {
+    const std::string& token = tokens[token_index];
+
+    if (target->type() == JsonValue::TYPE_OBJECT) {
+      JsonValue::Property* property =
+          FindByName(target->mutable_object_properties(), token);
+      PJCORE_NULL_REQUIRE(property, "Missing property");
+      target = property->mutable_value();
+    } else if (target->type() == JsonValue::TYPE_ARRAY) {
+      UnpackJsonArray(target);
+      int index;
+      PJCORE_NULL_REQUIRE_SILENT(
+          ReadJsonPointerIndex(token, target->array_elements_size() - 1,
+                               false, &index, error),
+          "Failed to read array index");
+      target = target->mutable_array_elements(index);
+    } else {
+      PJCORE_NULL_FAIL("Object or array expected");
+    }
+  }
+
+  return target;
+}
+
+// Inserts a missing property in name order, keeping normalized objects
+// normalized.
+JsonValue* InsertJsonProperty(JsonValue* object, const std::string& name) {
+  std::pair<JsonValue::Property*, bool> insert_result =
+      InsertName(object->mutable_object_properties(), name);
+
+  if (insert_result.second) {
+    int index = object->object_properties_size() - 1;
+    while (index > 0 && name < object->object_properties(index - 1).name()) {
+      object->mutable_object_properties()->SwapElements(index - 1, index);
+      --index;
+    }
+    return object->mutable_object_properties(index)->mutable_value();
+  }
+
+  return insert_result.first->mutable_value();
+}
+
+bool AddJsonPointerValue(const std::vector<std::string>& tokens,
+                         JsonValue* value, JsonValue* root, Error* error) {
+  if (tokens.empty()) {
+    root->Swap(value);
+    return true;
+  }
+
+  JsonValue* parent =
+      FindJsonPointerTarget(root, tokens, tokens.size() - 1, error);
+  PJCORE_REQUIRE_SILENT(parent, "Failed to find parent");
+
+  const std::string& token = tokens.back();
+
+  if (parent->type() == JsonValue::TYPE_OBJECT) {
+    InsertJsonProperty(parent, token)->Swap(value);
+  } else if (parent->type() == JsonValue::TYPE_ARRAY) {
+    UnpackJsonArray(parent);
+    int index;
+    PJCORE_REQUIRE_SILENT(
+        ReadJsonPointerIndex(token, parent->array_elements_size(), true,
+                             &index, error),
+        "Failed to read array index");
+    parent->add_array_elements()->Swap(value);
+    for (int moved = parent->array_elements_size() - 1; moved > index;
+         --moved) {
+      parent->mutable_array_elements()->SwapElements(moved - 1, moved);
+    }
+  } else {
+    PJCORE_FAIL("Object or array expected");
+  }
+
+  return true;
+}
+
+bool RemoveJsonPointerValue(const std::vector<std::string>& tokens,
+                            JsonValue* removed, JsonValue* root,
+                            Error* error) {
+  PJCORE_REQUIRE(!tokens.empty(), "Cannot remove the root");
+
+  JsonValue* parent =
+      FindJsonPointerTarget(root, tokens, tokens.size() - 1, error);
+  PJCORE_REQUIRE_SILENT(parent, "Failed to find parent");
+
+  const std::string& token = tokens.back();
+
+  if (parent->type() == JsonValue::TYPE_OBJECT) {
+    google::protobuf::RepeatedPtrField<JsonValue::Property>* properties =
+        parent->mutable_object_properties();
+    int index = 0;
+    while (index < properties->size() &&
+           properties->Get(index).name() != token) {
+      ++index;
+    }
+    PJCORE_REQUIRE(index < properties->size(), "Missing property");
+
+    removed->Swap(properties->Mutable(index)->mutable_value());
+    for (; index + 1 < properties->size(); ++index) {
+      properties->SwapElements(index, index + 1);
+    }
+    properties->RemoveLast();
+  } else if (parent->type() == JsonValue::TYPE_ARRAY) {
+    UnpackJsonArray(parent);
+    int index;
+    PJCORE_REQUIRE_SILENT(
+        ReadJsonPointerIndex(token, parent->array_elements_size() - 1, false,
+                             &index, error),
+        "Failed to read array index");
+
+    JsonElementList* elements = parent->mutable_array_elements();
+    removed->Swap(elements->Mutable(index));
+    for (; index + 1 < elements->size(); ++index) {
+      elements->SwapElements(index, index + 1);
+    }
+    elements->RemoveLast();
+  } else {
+    PJCORE_FAIL("Object or array expected");
+  }
+
+  return true;
+}
+
+bool ApplyJsonPatchOperation(const JsonValue& operation, JsonValue* target,
+                             Error* error) {
+  PJCORE_REQUIRE(operation.type() == JsonValue::TYPE_OBJECT,
+                 "Operation must be an object");
+
+  const JsonValue& op = GetJsonProperty(operation, "op");
+  PJCORE_REQUIRE(op.type() == JsonValue::TYPE_STRING,
+                 "Operation must have string op");
+
+  const JsonValue& path = GetJsonProperty(operation, "path");
+  PJCORE_REQUIRE(path.type() == JsonValue::TYPE_STRING,
+                 "Operation must have string path");
+
+  std::vector<std::string> tokens;
+  PJCORE_REQUIRE_SILENT(ParseJsonPointer(path.string_value(), &tokens, error),
+                        "Invalid path");
+
+  if (op.string_value() == "add" || op.string_value() == "replace" ||
+      op.string_value() == "test") {
+    PJCORE_REQUIRE(HasJsonProperty(operation, "value"),
+                   "Operation must have value");
+    const JsonValue& value = GetJsonProperty(operation, "value");
+
+    if (op.string_value() == "add") {
+      JsonValue added(value);
+      return AddJsonPointerValue(tokens, &added, target, error);
+    }
+
+    JsonValue* existing =
+        FindJsonPointerTarget(target, tokens, tokens.size(), error);
+    PJCORE_REQUIRE_SILENT(existing, "Failed to find path");
+
+    if (op.string_value() == "replace") {
+      *existing = value;
+    } else {
+      PJCORE_REQUIRE(AreJsonValuesEqual(*existing, value), "Test failed");
+    }
+    return true;
+  }
+
+  if (op.string_value() == "remove") {
+    JsonValue removed;
+    return RemoveJsonPointerValue(tokens, &removed, target, error);
+  }
+
+  if (op.string_value() == "move" || op.string_value() == "copy") {
+    const JsonValue& from = GetJsonProperty(operation, "from");
+    PJCORE_REQUIRE(from.type() == JsonValue::TYPE_STRING,
+                   "Operation must have string from");
+
+    std::vector<std::string> from_tokens;
+    PJCORE_REQUIRE_SILENT(
+        ParseJsonPointer(from.string_value(), &from_tokens, error),
+        "Invalid from");
+
+    JsonValue value;
+    if (op.string_value() == "move") {
+      PJCORE_REQUIRE(
+          from_tokens.size() >= tokens.size() ||
+              !std::equal(from_tokens.begin(), from_tokens.end(),
+                          tokens.begin()),
+          "Cannot move a value into itself");
+      PJCORE_REQUIRE_SILENT(
+          RemoveJsonPointerValue(from_tokens, &value, target, error),
+          "Failed to remove from");
+    } else {
+      const JsonValue* existing =
+          FindJsonPointerTarget(target, from_tokens, from_tokens.size(), error);
+      PJCORE_REQUIRE_SILENT(existing, "Failed to find from");
+      value = *existing;
+    }
+
+    return AddJsonPointerValue(tokens, &value, target, error);
+  }
+
+  PJCORE_FAIL("Unknown op");
+}
+
+}  // unnamed namespace
+
+JsonValue MakeJsonPatch(const JsonValue& from, const JsonValue& to,
+                        size_t max_array_diff_cells) {
+  JsonValue patch = MakeJsonArray();
+  JsonPatchBuilder builder(max_array_diff_cells, &patch);
+  std::string path;
+
+  if (AreJsonPropertiesNormalized(from) && AreJsonPropertiesNormalized(to)) {
+    builder.Diff(from, to, &path);
+  } else {
+    JsonValue normalized_from(from);
+    NormalizeJsonProperties(&normalized_from);
+    JsonValue normalized_to(to);
+    NormalizeJsonProperties(&normalized_to);
+    builder.Diff(normalized_from, normalized_to, &path);
+  }
+
+  return patch;
+}
+
+bool ApplyJsonPatch(const JsonValue& patch, JsonValue* target, Error* error) {
+  PJCORE_CHECK(target);
+  PJCORE_CHECK(error);
+  error->Clear();
+
+  PJCORE_REQUIRE(patch.type() == JsonValue::TYPE_ARRAY,
+                 "JSON Patch must be an array");
+
+  for (JsonElementList::const_iterator it = patch.array_elements().begin();
+       it != patch.array_elements().end(); ++it) {
+    PJCORE_REQUIRE_CAUSE(ApplyJsonPatchOperation(*it, target, error),
+                         "Failed to apply JSON Patch operation");
+  }
+
+  return true;
+}
+
+static void MakeJsonMergePatchRecursive(const JsonValue& from,
+                                        const JsonValue& to,
+                                        JsonValue* patch) {
+  if (from.type() != JsonValue::TYPE_OBJECT ||
+      to.type() != JsonValue::TYPE_OBJECT) {
+    *patch = to;
+    return;
+  }
+
+  patch->set_type(JsonValue::TYPE_OBJECT);
+
+  google::protobuf::RepeatedPtrField<JsonValue::Property>::const_iterator
+      from_it = from.object_properties().begin(),
+      to_it = to.object_properties().begin();
+
+  while (from_it != from.object_properties().end() ||
+         to_it != to.object_properties().end()) {
+    if (to_it == to.object_properties().end() ||
+        (from_it != from.object_properties().end() &&
+         from_it->name() < to_it->name())) {
+      *patch->add_object_properties() =
+          MakeJsonProperty(from_it->name(), JsonNull());
+      ++from_it;
+    } else if (from_it == from.object_properties().end() ||
+               to_it->name() < from_it->name()) {
+      if (to_it->value().type() != JsonValue::TYPE_NULL) {
+        *patch->add_object_properties() = *to_it;
+      }
+      ++to_it;
+    } else {
+      if (to_it->value().type() == JsonValue::TYPE_NULL) {
+        if (from_it->value().type() != JsonValue::TYPE_NULL) {
+          *patch->add_object_properties() =
+              MakeJsonProperty(from_it->name(), JsonNull());
+        }
+      } else if (!AreJsonValuesIdentical(from_it->value(), to_it->value())) {
+        JsonValue::Property* property = patch->add_object_properties();
+        property->set_name(to_it->name());
+        MakeJsonMergePatchRecursive(from_it->value(), to_it->value(),
+                                    property->mutable_value());
+      }
+      ++from_it;
+      ++to_it;
+    }
+  }
+}
+
+JsonValue MakeJsonMergePatch(const JsonValue& from, const JsonValue& to) {
+  JsonValue patch;
+
+  if (AreJsonPropertiesNormalized(from) && AreJsonPropertiesNormalized(to)) {
+    MakeJsonMergePatchRecursive(from, to, &patch);
+  } else {
+    JsonValue normalized_from(from);
+    NormalizeJsonProperties(&normalized_from);
+    JsonValue normalized_to(to);
+    NormalizeJsonProperties(&normalized_to);
+    MakeJsonMergePatchRecursive(normalized_from, normalized_to, &patch);
+  }
+
+  return patch;
+}
+
+void ApplyJsonMergePatch(const JsonValue& patch, JsonValue* target) {
+  PJCORE_CHECK(target);
+
+  if (patch.type() != JsonValue::TYPE_OBJECT) {
+    *target = patch;
+    return;
+  }
+
+  if (target->type() != JsonValue::TYPE_OBJECT) {
+    *target = MakeJsonObject();
+  }
+
+  for (google::protobuf::RepeatedPtrField<JsonValue::Property>::const_iterator
+           it = patch.object_properties().begin();
+       it != patch.object_properties().end(); ++it) {
+    if (it->value().type() == JsonValue::TYPE_NULL) {
+      ClearJsonProperty(target, it->name());
+    } else {
+      ApplyJsonMergePatch(it->value(), InsertJsonProperty(target, it->name()));
+    }
+  }
+}
+
+void AppendJsonPointerToken(StringPiece token, std::string* json_pointer) {
+  PJCORE_CHECK(json_pointer);
+  json_pointer->push_back('/');
+
+  for (size_t offset = 0; offset < token.size(); ++offset) {
+    switch (token[offset]) {
+      case '~':
+        json_pointer->append("~0");
+        break;
+
+      case '/':
+        json_pointer->append("~1");
+        break;
+
+      default:
+        json_pointer->push_back(token[offset]);
+        break;
+    }
+  }
+}
+
+}  // namespace pjcore
@@ -17,11 +17,13 @@
 
 #include "pjcore/json_properties.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "pjcore/logging.h"
 #include "pjcore/json_util.h"
 #include "pjcore/name_value_util.h"
+#include "pjcore/unique_keep_last.h"
 
 namespace pjcore {
 
@@ -200,4 +202,176 @@ void ClearJsonProperty(JsonValue* mutable_object_value, StringPiece name) {
   ClearJsonProperty(mutable_object_value->mutable_object_properties(), name);
 }
 
+void ClearJsonProperties(JsonPropertyList* mutable_properties,
+                         const std::vector<std::string>& names) {
+  PJCORE_CHECK(mutable_properties);
+
+  std::vector<std::string> sorted_names(names);
+  std::sort(sorted_names.begin(), sorted_names.end());
+
+  int from = 0;
+  int to = from;
+  while (from < mutable_properties->size()) {
+    if (!std::binary_search(sorted_names.begin(), sorted_names.end(),
+                            mutable_properties->Get(from).name())) {
+      mutable_properties->SwapElements(from, to);
+      ++to;
+    }
+    ++from;
+  }
+  while (to < mutable_properties->size()) {
+    mutable_properties->RemoveLast();
+  }
+}
+
+void ClearJsonProperties(JsonValue* mutable_object_value,
+                         const std::vector<std::string>& names) {
+  PJCORE_CHECK_EQ(JsonValue::TYPE_OBJECT, mutable_object_value->type());
+  ClearJsonProperties(mutable_object_value->mutable_object_properties(),
+                      names);
+}
+
+namespace {
+
+// Orders property indices by rank when given, then by name, then by index.
+class LessByPropertyName {
+ public:
+  LessByPropertyName(const JsonPropertyList& properties,
+                     const std::vector<int>& ranks)
+      : properties_(properties), ranks_(ranks) {}
+
+  bool operator()(int left, int right) const {
+    if (!ranks_.empty() && ranks_[left] != ranks_[right]) {
+      return ranks_[left] < ranks_[right];
+    }
+    const std::string& left_name = properties_.Get(left).name();
+    const std::string& right_name = properties_.Get(right).name();
+    return left_name < right_name ||
+           (left_name == right_name && left < right);
+  }
+
+ private:
+  const JsonPropertyList& properties_;
+  const std::vector<int>& ranks_;
+};
+
+class EqualToByPropertyName {
+ public:
+  explicit EqualToByPropertyName(const JsonPropertyList& properties)
+      : properties_(properties) {}
+
+  bool operator()(int left, int right) const {
+    return properties_.Get(left).name() == properties_.Get(right).name();
+  }
+
+ private:
+  const JsonPropertyList& properties_;
+};
+
+}  // unnamed namespace
+
+JsonPropertyBuilder::JsonPropertyBuilder(JsonPropertyList* mutable_properties)
+    : properties_(mutable_properties),
+      leading_names_begin_(NULL),
+      leading_names_end_(NULL) {
+  PJCORE_CHECK(properties_);
+}
+
+JsonPropertyBuilder::JsonPropertyBuilder(JsonValue* mutable_object_value)
+    : properties_(NULL), leading_names_begin_(NULL), leading_names_end_(NULL) {
+  PJCORE_CHECK(mutable_object_value);
+  PJCORE_CHECK_EQ(JsonValue::TYPE_OBJECT, mutable_object_value->type());
+  properties_ = mutable_object_value->mutable_object_properties();
+}
+
+JsonPropertyBuilder::JsonPropertyBuilder(
+    JsonValue* mutable_object_value, const char* const* leading_names_begin,
+    const char* const* leading_names_end)
+    : properties_(NULL),
+      leading_names_begin_(leading_names_begin),
+      leading_names_end_(leading_names_end) {
+  PJCORE_CHECK(mutable_object_value);
+  PJCORE_CHECK_EQ(JsonValue::TYPE_OBJECT, mutable_object_value->type());
+  properties_ = mutable_object_value->mutable_object_properties();
+}
+
+JsonPropertyBuilder::~JsonPropertyBuilder() { Commit(); }
+
+JsonValue* JsonPropertyBuilder::Add(StringPiece name) {
+  JsonValue::Property* property = properties_->Add();
+  property->set_name(name.data(), name.size());
+  return property->mutable_value();
+}
+
+void JsonPropertyBuilder::Clear(StringPiece name) {
+  cleared_[name.as_string()] = properties_->size();
+}
+
+void JsonPropertyBuilder::Commit() {
+  int size = properties_->size();
+
+  std::vector<int> order(size);
+  for (int index = 0; index < size; ++index) {
+    order[index] = index;
+  }
+
+  // Leading names rank by position, the rest after them all.
+  std::vector<int> ranks;
+  if (leading_names_begin_ != leading_names_end_) {
+    int rest_rank = static_cast<int>(leading_names_end_ - leading_names_begin_);
+    ranks.resize(size, rest_rank);
+    for (int index = 0; index < size; ++index) {
+      const std::string& name = properties_->Get(index).name();
+      for (const char* const* it = leading_names_begin_;
+           it != leading_names_end_; ++it) {
+        if (name == *it) {
+          ranks[index] = static_cast<int>(it - leading_names_begin_);
+          break;
+        }
+      }
+    }
+  }
+
+  std::sort(order.begin(), order.end(),
+            LessByPropertyName(*properties_, ranks));
+  order.erase(unique_keep_last(order.begin(), order.end(),
+                               EqualToByPropertyName(*properties_)),
+              order.end());
+
+  if (!cleared_.empty()) {
+    std::vector<int>::iterator kept = order.begin();
+    for (std::vector<int>::const_iterator it = order.begin();
+         it != order.end(); ++it) {
+      std::map<std::string, int>::const_iterator cleared =
+          cleared_.find(properties_->Get(*it).name());
+      if (cleared == cleared_.end() || cleared->second <= *it) {
+        *kept++ = *it;
+      }
+    }
+    order.erase(kept, order.end());
+    cleared_.clear();
+  }
+
+  // Moves the kept properties to the front in order, tracking where the
+  // displaced ones go.
+  std::vector<int> position(size);
+  std::vector<int> original(size);
+  for (int index = 0; index < size; ++index) {
+    position[index] = index;
+    original[index] = index;
+  }
+  for (int index = 0; index < static_cast<int>(order.size()); ++index) {
+    int from = position[order[index]];
+    properties_->SwapElements(index, from);
+    position[original[index]] = from;
+    original[from] = original[index];
+    position[order[index]] = index;
+    original[index] = order[index];
+  }
+
+  while (properties_->size() > static_cast<int>(order.size())) {
+    properties_->RemoveLast();
+  }
+}
+
 }  // namespace pjcore
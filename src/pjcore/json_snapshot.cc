@@ -0,0 +1,617 @@
+// JSON [de]serialization for protobuf + embedded HTTP server and client in C++.
+// Copyright (C) 2014 http://protojson.com/
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+
+#include "pjcore/json_snapshot.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif  // _WIN32
+
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "pjcore/errno_description.h"
+#include "pjcore/json_properties.h"
+#include "pjcore/json_util.h"
+#include "pjcore/logging.h"
+#include "pjcore/make_json_value.h"
+
+namespace pjcore {
+
+namespace {
+
+// Header: magic, byte order mark, total size and root reference.
+const char kSnapshotMagic[8] = {'P', 'J', 'S', 'N', 'A', 'P', '\0', '\1'};
+
+const uint64_t kSnapshotByteOrderMark = 0x0102030405060708ULL;
+
+const uint64_t kSnapshotHeaderSize = 32;
+
+// A reference holds a tag in its low four bits and either a byte offset of
+// the referenced data or, for small integers, the value itself above them.
+enum SnapshotTag {
+  SNAPSHOT_TAG_NULL = 0,
+  SNAPSHOT_TAG_FALSE = 1,
+  SNAPSHOT_TAG_TRUE = 2,
+  SNAPSHOT_TAG_SMALL_SIGNED = 3,
+  SNAPSHOT_TAG_SIGNED = 4,
+  SNAPSHOT_TAG_UNSIGNED = 5,
+  SNAPSHOT_TAG_DOUBLE = 6,
+  SNAPSHOT_TAG_STRING = 7,
+  SNAPSHOT_TAG_OBJECT = 8,
+  SNAPSHOT_TAG_ARRAY = 9
+};
+
+const int kSnapshotTagBits = 4;
+
+const int64_t kMaxSmallSigned = (static_cast<int64_t>(1) << 59) - 1;
+
+const int64_t kMinSmallSigned = -(static_cast<int64_t>(1) << 59);
+
+uint64_t MakeSnapshotRef(uint64_t offset, SnapshotTag tag) {
+  return (offset << kSnapshotTagBits) | tag;
+}
+
+SnapshotTag GetSnapshotTag(uint64_t ref) {
+  return static_cast<SnapshotTag>(ref & ((1 << kSnapshotTagBits) - 1));
+}
+
+bool IsPropertyNameLess(const JsonValue::Property* left,
+                        const JsonValue::Property* right) {
+  return left->name() < right->name();
+}
+
+// Lays values out children first, so that every reference points backwards.
+class JsonSnapshotWriter {
+ public:
+  explicit JsonSnapshotWriter(std::string* snapshot) : snapshot_(snapshot) {}
+
+  uint64_t Write(const JsonValue& value);
+
+ private:
+  void AppendWord(uint64_t word) {
+    snapshot_->append(reinterpret_cast<const char*>(&word), sizeof(word));
+  }
+
+  uint64_t AppendScalar(uint64_t bits, SnapshotTag tag) {
+    uint64_t offset = snapshot_->size();
+    AppendWord(bits);
+    return MakeSnapshotRef(offset, tag);
+  }
+
+  uint64_t WriteString(StringPiece str);
+
+  std::string* snapshot_;
+
+  // Offsets of pooled strings, which point into the value being written.
+  std::map<StringPiece, uint64_t> string_offsets_;
+
+  DISALLOW_COPY_AND_ASSIGN(JsonSnapshotWriter);
+};
+
+uint64_t JsonSnapshotWriter::WriteString(StringPiece str) {
+  std::map<StringPiece, uint64_t>::iterator it = string_offsets_.find(str);
+  if (it != string_offsets_.end()) {
+    return it->second;
+  }
+
+  // Strings are NUL-terminated and padded to keep words aligned.
+  uint64_t offset = snapshot_->size();
+  AppendWord(str.size());
+  str.AppendToString(snapshot_);
+  snapshot_->append(8 - str.size() % 8, '\0');
+
+  string_offsets_.insert(std::make_pair(str, offset));
+  return offset;
+}
+
+uint64_t JsonSnapshotWriter::Write(const JsonValue& value) {
+  switch (value.type()) {
+    case JsonValue::TYPE_NULL:
+      return SNAPSHOT_TAG_NULL;
+
+    case JsonValue::TYPE_BOOL:
+      return value.bool_value() ? SNAPSHOT_TAG_TRUE : SNAPSHOT_TAG_FALSE;
+
+    case JsonValue::TYPE_SIGNED:
+      if (value.signed_value() >= kMinSmallSigned &&
+          value.signed_value() <= kMaxSmallSigned) {
+        return (static_cast<uint64_t>(value.signed_value())
+                << kSnapshotTagBits) |
+               SNAPSHOT_TAG_SMALL_SIGNED;
+      }
+      return AppendScalar(static_cast<uint64_t>(value.signed_value()),
+                          SNAPSHOT_TAG_SIGNED);
+
+    case JsonValue::TYPE_UNSIGNED:
+      return AppendScalar(value.unsigned_value(), SNAPSHOT_TAG_UNSIGNED);
+
+    case JsonValue::TYPE_DOUBLE: {
+      uint64_t bits;
+      double double_value = value.double_value();
+      memcpy(&bits, &double_value, sizeof(bits));
+      return AppendScalar(bits, SNAPSHOT_TAG_DOUBLE);
+    }
+
+    case JsonValue::TYPE_RAW_NUMBER: {
+      JsonValue buffer;
+      return Write(ResolveJsonRawNumber(value, &buffer));
+    }
+
+    case JsonValue::TYPE_STRING:
+      return MakeSnapshotRef(WriteString(value.string_value()),
+                             SNAPSHOT_TAG_STRING);
+
+    case JsonValue::TYPE_OBJECT: {
+      std::vector<const JsonValue::Property*> properties;
+      properties.reserve(value.object_properties_size());
+      for (int index = 0; index < value.object_properties_size(); ++index) {
+        properties.push_back(&value.object_properties(index));
+      }
+
+      if (!AreJsonPropertiesNormalized(value)) {
+        std::stable_sort(properties.begin(), properties.end(),
+                         IsPropertyNameLess);
+
+        // Keeps the last of equally named properties.
+        std::vector<const JsonValue::Property*> unique;
+        for (size_t index = 0; index < properties.size(); ++index) {
+          if (!unique.empty() &&
+              unique.back()->name() == properties[index]->name()) {
+            unique.back() = properties[index];
+          } else {
+            unique.push_back(properties[index]);
+          }
+        }
+        properties.swap(unique);
+      }
+
+      std::vector<uint64_t> table;
+      table.reserve(properties.size() * 2);
+      for (size_t index = 0; index < properties.size(); ++index) {
+        table.push_back(WriteString(properties[index]->name()));
+        table.push_back(Write(properties[index]->value()));
+      }
+
+      uint64_t offset = snapshot_->size();
+      AppendWord(properties.size());
+      for (size_t index = 0; index < table.size(); ++index) {
+        AppendWord(table[index]);
+      }
+      return MakeSnapshotRef(offset, SNAPSHOT_TAG_OBJECT);
+    }
+
+    case JsonValue::TYPE_ARRAY: {
+      int size = GetJsonArraySize(value);
+
+      std::vector<uint64_t> table;
+      table.reserve(size);
+      JsonValue buffer;
+      for (int index = 0; index < size; ++index) {
+        table.push_back(Write(GetJsonArrayElement(value, index, &buffer)));
+      }
+
+      uint64_t offset = snapshot_->size();
+      AppendWord(table.size());
+      for (size_t index = 0; index < table.size(); ++index) {
+        AppendWord(table[index]);
+      }
+      return MakeSnapshotRef(offset, SNAPSHOT_TAG_ARRAY);
+    }
+  }
+
+  return SNAPSHOT_TAG_NULL;
+}
+
+}  // unnamed namespace
+
+void WriteJsonSnapshot(const JsonValue& value, std::string* snapshot) {
+  PJCORE_CHECK(snapshot);
+  snapshot->assign(kSnapshotHeaderSize, '\0');
+
+  JsonSnapshotWriter writer(snapshot);
+  uint64_t root = writer.Write(value);
+
+  uint64_t header[4];
+  memcpy(&header[0], kSnapshotMagic, sizeof(header[0]));
+  header[1] = kSnapshotByteOrderMark;
+  header[2] = snapshot->size();
+  header[3] = root;
+  memcpy(&(*snapshot)[0], header, sizeof(header));
+}
+
+bool WriteJsonSnapshotFile(const JsonValue& value, const std::string& path,
+                           Error* error) {
+  PJCORE_CHECK(error);
+  error->Clear();
+
+  std::string snapshot;
+  WriteJsonSnapshot(value, &snapshot);
+
+  FILE* file = fopen(path.c_str(), "wb");
+  if (!file) {
+    error->set_system_errno(CurrentErrno());
+    PJCORE_FAIL("Failed to create snapshot file");
+  }
+
+  bool written = fwrite(snapshot.data(), 1, snapshot.size(), file) ==
+                 snapshot.size();
+  if (!written) {
+    error->set_system_errno(CurrentErrno());
+  }
+
+  bool closed = (fclose(file) == 0);
+  if (written && !closed) {
+    error->set_system_errno(CurrentErrno());
+  }
+
+  PJCORE_REQUIRE(written && closed, "Failed to write snapshot file");
+
+  return true;
+}
+
+JsonValue::Type JsonSnapshotValue::type() const {
+  switch (GetSnapshotTag(ref_)) {
+    case SNAPSHOT_TAG_FALSE:
+    case SNAPSHOT_TAG_TRUE:
+      return JsonValue::TYPE_BOOL;
+
+    case SNAPSHOT_TAG_SMALL_SIGNED:
+    case SNAPSHOT_TAG_SIGNED:
+      return JsonValue::TYPE_SIGNED;
+
+    case SNAPSHOT_TAG_UNSIGNED:
+      return JsonValue::TYPE_UNSIGNED;
+
+    case SNAPSHOT_TAG_DOUBLE:
+      return JsonValue::TYPE_DOUBLE;
+
+    case SNAPSHOT_TAG_STRING:
+      return JsonValue::TYPE_STRING;
+
+    case SNAPSHOT_TAG_OBJECT:
+      return JsonValue::TYPE_OBJECT;
+
+    case SNAPSHOT_TAG_ARRAY:
+      return JsonValue::TYPE_ARRAY;
+
+    default:
+      return JsonValue::TYPE_NULL;
+  }
+}
+
+bool JsonSnapshotValue::bool_value() const {
+  return GetSnapshotTag(ref_) == SNAPSHOT_TAG_TRUE;
+}
+
+int64_t JsonSnapshotValue::signed_value() const {
+  switch (GetSnapshotTag(ref_)) {
+    case SNAPSHOT_TAG_SMALL_SIGNED:
+      // Arithmetic shift restores the sign.
+      return static_cast<int64_t>(ref_) >> kSnapshotTagBits;
+
+    case SNAPSHOT_TAG_SIGNED:
+      return static_cast<int64_t>(ReadWord(offset()));
+
+    default:
+      return 0;
+  }
+}
+
+uint64_t JsonSnapshotValue::unsigned_value() const {
+  return GetSnapshotTag(ref_) == SNAPSHOT_TAG_UNSIGNED ? ReadWord(offset())
+                                                       : 0;
+}
+
+double JsonSnapshotValue::double_value() const {
+  if (GetSnapshotTag(ref_) != SNAPSHOT_TAG_DOUBLE) {
+    return 0;
+  }
+
+  uint64_t bits = ReadWord(offset());
+  double double_value;
+  memcpy(&double_value, &bits, sizeof(double_value));
+  return double_value;
+}
+
+StringPiece JsonSnapshotValue::string_value() const {
+  if (GetSnapshotTag(ref_) != SNAPSHOT_TAG_STRING) {
+    return StringPiece();
+  }
+
+  return ReadString(offset());
+}
+
+int JsonSnapshotValue::object_properties_size() const {
+  return GetSnapshotTag(ref_) == SNAPSHOT_TAG_OBJECT ? ReadCount(16) : 0;
+}
+
+StringPiece JsonSnapshotValue::object_property_name(int index) const {
+  PJCORE_CHECK_GE(index, 0);
+  PJCORE_CHECK_LT(index, object_properties_size());
+
+  return ReadString(ReadWord(offset() + 8 + index * 16));
+}
+
+JsonSnapshotValue JsonSnapshotValue::object_property_value(int index) const {
+  PJCORE_CHECK_GE(index, 0);
+  PJCORE_CHECK_LT(index, object_properties_size());
+
+  return JsonSnapshotValue(data_, size_,
+                           ReadWord(offset() + 16 + index * 16));
+}
+
+bool JsonSnapshotValue::HasProperty(StringPiece name) const {
+  return FindProperty(name) >= 0;
+}
+
+JsonSnapshotValue JsonSnapshotValue::GetProperty(StringPiece name) const {
+  int index = FindProperty(name);
+  return index >= 0 ? object_property_value(index) : JsonSnapshotValue();
+}
+
+int JsonSnapshotValue::array_elements_size() const {
+  return GetSnapshotTag(ref_) == SNAPSHOT_TAG_ARRAY ? ReadCount(8) : 0;
+}
+
+JsonSnapshotValue JsonSnapshotValue::array_elements(int index) const {
+  PJCORE_CHECK_GE(index, 0);
+  PJCORE_CHECK_LT(index, array_elements_size());
+
+  return JsonSnapshotValue(data_, size_, ReadWord(offset() + 8 + index * 8));
+}
+
+uint64_t JsonSnapshotValue::offset() const {
+  return ref_ >> kSnapshotTagBits;
+}
+
+uint64_t JsonSnapshotValue::ReadWord(uint64_t offset) const {
+  if (offset > size_ || size_ - offset < 8) {
+    return 0;
+  }
+
+  uint64_t word;
+  memcpy(&word, data_ + offset, sizeof(word));
+  return word;
+}
+
+StringPiece JsonSnapshotValue::ReadString(uint64_t offset) const {
+  uint64_t length = ReadWord(offset);
+  if (!length || size_ - offset - 8 < length) {
+    return StringPiece();
+  }
+
+  return StringPiece(data_ + offset + 8, static_cast<size_t>(length));
+}
+
+int JsonSnapshotValue::ReadCount(uint64_t entry_size) const {
+  uint64_t count = ReadWord(offset());
+  if (!count || (size_ - offset() - 8) / entry_size < count ||
+      count > static_cast<uint64_t>(std::numeric_limits<int>::max())) {
+    return 0;
+  }
+
+  return static_cast<int>(count);
+}
+
+int JsonSnapshotValue::FindProperty(StringPiece name) const {
+  int low = 0;
+  int high = object_properties_size();
+
+  while (low < high) {
+    int middle = low + (high - low) / 2;
+    int comparison = object_property_name(middle).compare(name);
+    if (comparison == 0) {
+      return middle;
+    } else if (comparison < 0) {
+      low = middle + 1;
+    } else {
+      high = middle;
+    }
+  }
+
+  return -1;
+}
+
+namespace {
+
+// Builds the value in place, so that nested values are not copied per level.
+void MakeJsonValueOut(const JsonSnapshotValue& snapshot_value,
+                      JsonValue* value) {
+  switch (snapshot_value.type()) {
+    case JsonValue::TYPE_NULL:
+      value->set_type(JsonValue::TYPE_NULL);
+      break;
+
+    case JsonValue::TYPE_BOOL:
+      value->set_type(JsonValue::TYPE_BOOL);
+      value->set_bool_value(snapshot_value.bool_value());
+      break;
+
+    case JsonValue::TYPE_SIGNED:
+      value->set_type(JsonValue::TYPE_SIGNED);
+      value->set_signed_value(snapshot_value.signed_value());
+      break;
+
+    case JsonValue::TYPE_UNSIGNED:
+      value->set_type(JsonValue::TYPE_UNSIGNED);
+      value->set_unsigned_value(snapshot_value.unsigned_value());
+      break;
+
+    case JsonValue::TYPE_DOUBLE:
+      value->set_type(JsonValue::TYPE_DOUBLE);
+      value->set_double_value(snapshot_value.double_value());
+      break;
+
+    case JsonValue::TYPE_STRING:
+      value->set_type(JsonValue::TYPE_STRING);
+      snapshot_value.string_value().CopyToString(
+          value->mutable_string_value());
+      break;
+
+    case JsonValue::TYPE_OBJECT: {
+      value->set_type(JsonValue::TYPE_OBJECT);
+      int size = snapshot_value.object_properties_size();
+      value->mutable_object_properties()->Reserve(size);
+      for (int index = 0; index < size; ++index) {
+        JsonValue::Property* property = value->add_object_properties();
+        snapshot_value.object_property_name(index).CopyToString(
+            property->mutable_name());
+        MakeJsonValueOut(snapshot_value.object_property_value(index),
+                         property->mutable_value());
+      }
+      break;
+    }
+
+    case JsonValue::TYPE_ARRAY: {
+      value->set_type(JsonValue::TYPE_ARRAY);
+      int size = snapshot_value.array_elements_size();
+      value->mutable_array_elements()->Reserve(size);
+      for (int index = 0; index < size; ++index) {
+        MakeJsonValueOut(snapshot_value.array_elements(index),
+                         value->add_array_elements());
+      }
+      break;
+    }
+
+    case JsonValue::TYPE_RAW_NUMBER:
+      // Snapshots store raw numbers converted.
+      value->set_type(JsonValue::TYPE_NULL);
+      break;
+  }
+}
+
+}  // unnamed namespace
+
+JsonValue MakeJsonValue(const JsonSnapshotValue& snapshot_value) {
+  JsonValue value;
+  MakeJsonValueOut(snapshot_value, &value);
+  return value;
+}
+
+JsonSnapshot::JsonSnapshot()
+    : data_(NULL), size_(0), mapping_(NULL), mapping_size_(0) {}
+
+JsonSnapshot::~JsonSnapshot() { Close(); }
+
+bool JsonSnapshot::Open(const std::string& path, Error* error) {
+  PJCORE_CHECK(error);
+  error->Clear();
+
+  Close();
+
+#ifdef _WIN32
+  PJCORE_FAIL("Snapshot mapping is not supported");
+#else   // _WIN32
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    error->set_system_errno(CurrentErrno());
+    PJCORE_FAIL("Failed to open snapshot file");
+  }
+
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) != 0) {
+    error->set_system_errno(CurrentErrno());
+    close(fd);
+    PJCORE_FAIL("Failed to stat snapshot file");
+  }
+
+  if (file_stat.st_size < static_cast<off_t>(kSnapshotHeaderSize)) {
+    close(fd);
+    PJCORE_FAIL("Snapshot file too small");
+  }
+
+  size_t size = static_cast<size_t>(file_stat.st_size);
+  void* mapping = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+  if (mapping == MAP_FAILED) {
+    error->set_system_errno(CurrentErrno());
+    close(fd);
+    PJCORE_FAIL("Failed to map snapshot file");
+  }
+
+  // The mapping stays valid after the descriptor is closed.
+  close(fd);
+
+  if (!Attach(StringPiece(static_cast<const char*>(mapping), size), error)) {
+    munmap(mapping, size);
+    PJCORE_FAIL_SILENT("Failed to attach snapshot file");
+  }
+
+  mapping_ = mapping;
+  mapping_size_ = size;
+  return true;
+#endif  // _WIN32
+}
+
+bool JsonSnapshot::Attach(StringPiece data, Error* error) {
+  PJCORE_CHECK(error);
+  error->Clear();
+
+  Close();
+
+  PJCORE_REQUIRE(data.size() >= kSnapshotHeaderSize, "Snapshot too small");
+  PJCORE_REQUIRE(memcmp(data.data(), kSnapshotMagic, sizeof(kSnapshotMagic)) ==
+                     0,
+                 "Not a snapshot");
+
+  uint64_t header[4];
+  memcpy(header, data.data(), sizeof(header));
+  PJCORE_REQUIRE(header[1] == kSnapshotByteOrderMark,
+                 "Snapshot written with different byte order");
+  PJCORE_REQUIRE(header[2] == data.size(), "Mismatched snapshot size");
+  PJCORE_REQUIRE(GetSnapshotTag(header[3]) <= SNAPSHOT_TAG_ARRAY &&
+                     (GetSnapshotTag(header[3]) < SNAPSHOT_TAG_SIGNED ||
+                      (header[3] >> kSnapshotTagBits) < data.size()),
+                 "Invalid snapshot root");
+
+  data_ = data.data();
+  size_ = data.size();
+  return true;
+}
+
+void JsonSnapshot::Close() {
+#ifndef _WIN32
+  if (mapping_) {
+    munmap(mapping_, mapping_size_);
+  }
+#endif  // _WIN32
+
+  data_ = NULL;
+  size_ = 0;
+  mapping_ = NULL;
+  mapping_size_ = 0;
+}
+
+JsonSnapshotValue JsonSnapshot::root() const {
+  PJCORE_CHECK(data_);
+
+  uint64_t root;
+  memcpy(&root, data_ + 3 * sizeof(root), sizeof(root));
+  return JsonSnapshotValue(data_, size_, root);
+}
+
+}  // namespace pjcore
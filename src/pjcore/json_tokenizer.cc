@@ -0,0 +1,633 @@
+// JSON [de]serialization for protobuf + embedded HTTP server and client in C++.
+// Copyright (C) 2014 http://protojson.com/
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+#include "pjcore/json_tokenizer.h"
+
+#include <functional>
+#include <limits>
+#include <string>
+
+#include "pjcore/logging.h"
+#include "pjcore/number_util.h"
+#include "pjcore/text_location.h"
+#include "pjcore/string_piece_util.h"
+#include "pjcore/unicode.h"
+
+#ifdef min
+#undef min
+#endif
+
+#ifdef max
+#undef max
+#endif
+
+namespace pjcore {
+
+JsonTokenizer::JsonTokenizer(StringPiece str, const JsonReaderConfig& config)
+    : config_(config),
+      location_(MakeTextLocation(0, 1, 1)),
+      remaining_(str),
+      state_(STATE_BEGIN),
+      token_(TOKEN_NONE),
+      bool_value_(false),
+      signed_value_(0),
+      unsigned_value_(0),
+      double_value_(0) {}
+
+JsonTokenizer::~JsonTokenizer() {}
+
+JsonValue::Type JsonTokenizer::type() const {
+  switch (token_) {
+    case TOKEN_BEGIN_OBJECT:
+      return JsonValue::TYPE_OBJECT;
+
+    case TOKEN_BEGIN_ARRAY:
+      return JsonValue::TYPE_ARRAY;
+
+    case TOKEN_BOOL:
+      return JsonValue::TYPE_BOOL;
+
+    case TOKEN_SIGNED:
+      return JsonValue::TYPE_SIGNED;
+
+    case TOKEN_UNSIGNED:
+      return JsonValue::TYPE_UNSIGNED;
+
+    case TOKEN_DOUBLE:
+      return JsonValue::TYPE_DOUBLE;
+
+    case TOKEN_RAW_NUMBER:
+      return JsonValue::TYPE_RAW_NUMBER;
+
+    case TOKEN_NAME:
+    case TOKEN_STRING:
+      return JsonValue::TYPE_STRING;
+
+    default:
+      return JsonValue::TYPE_NULL;
+  }
+}
+
+bool JsonTokenizer::Next(Error* error) {
+  PJCORE_CHECK(error);
+  error->Clear();
+
+  if (!InternalNext(error)) {
+    token_ = TOKEN_NONE;
+    *error->mutable_text_location() = location_;
+    PJCORE_FAIL_SILENT("Failed to complete reading");
+  }
+
+  return true;
+}
+
+bool JsonTokenizer::SkipValue(Error* error) {
+  PJCORE_CHECK(error);
+
+  if (token_ != TOKEN_BEGIN_OBJECT && token_ != TOKEN_BEGIN_ARRAY) {
+    return true;
+  }
+
+  size_t target_depth = depth() - 1;
+
+  do {
+    PJCORE_REQUIRE_SILENT(Next(error), "Failed to skip value");
+  } while (depth() > target_depth);
+
+  return true;
+}
+
+bool JsonTokenizer::InternalNext(Error* error) {
+  for (;;) {
+    switch (state_) {
+      case STATE_BEGIN:
+        PJCORE_REQUIRE_SILENT(ReadByteOrderMark(error),
+                              "Failed to read byte order mark");
+        state_ = STATE_VALUE;
+        continue;
+
+      case STATE_VALUE:
+        PJCORE_REQUIRE_SILENT(ReadWhitespaceAndComments(error),
+                              "Failed to read whitespace and/or comments");
+
+        PJCORE_REQUIRE(!remaining_.empty(), "Value expected");
+
+        if (remaining_[0] == ']') {
+          PJCORE_REQUIRE(!frames_.empty() && !frames_.back().is_object,
+                         "Not in a list of array items, unexpected bracket");
+          if (frames_.back().size) {
+            PJCORE_REQUIRE(!config_.disallow_trailing_commas(),
+                           "Trailing commas disallowed");
+          }
+          AdvanceOne();
+          frames_.pop_back();
+          token_ = TOKEN_END_ARRAY;
+          state_ = STATE_AFTER_VALUE;
+          return true;
+        }
+
+        if (!frames_.empty() && !frames_.back().is_object) {
+          ++frames_.back().size;
+        }
+
+        return ReadValue(error);
+
+      case STATE_NAME:
+        PJCORE_REQUIRE_SILENT(ReadWhitespaceAndComments(error),
+                              "Failed to read whitespace and/or comments");
+
+        PJCORE_REQUIRE(!remaining_.empty(), "Property name expected");
+
+        if (remaining_[0] == '}') {
+          if (frames_.back().size) {
+            PJCORE_REQUIRE(!config_.disallow_trailing_commas(),
+                           "Trailing commas disallowed");
+          }
+          AdvanceOne();
+          frames_.pop_back();
+          token_ = TOKEN_END_OBJECT;
+          state_ = STATE_AFTER_VALUE;
+          return true;
+        }
+
+        PJCORE_REQUIRE_SILENT(ReadString(&string_value_, error),
+                              "Failed to read property name");
+
+        PJCORE_REQUIRE_SILENT(ReadWhitespaceAndComments(error),
+                              "Failed to read whitespace and/or comments");
+        PJCORE_REQUIRE(ReadChar(':', error), "Colon expected");
+
+        ++frames_.back().size;
+        token_ = TOKEN_NAME;
+        state_ = STATE_VALUE;
+        return true;
+
+      case STATE_AFTER_VALUE:
+        PJCORE_REQUIRE_SILENT(ReadWhitespaceAndComments(error),
+                              "Failed to read whitespace and/or comments");
+
+        if (frames_.empty()) {
+          PJCORE_REQUIRE(remaining_.empty(), "End expected");
+          token_ = TOKEN_END;
+          state_ = STATE_END;
+          return true;
+        }
+
+        if (!remaining_.empty() && remaining_[0] == ',') {
+          AdvanceOne();
+          state_ = frames_.back().is_object ? STATE_NAME : STATE_VALUE;
+          continue;
+        }
+
+        if (frames_.back().is_object) {
+          PJCORE_REQUIRE(ReadChar('}', error),
+                         "Close bracket or comma expected");
+          token_ = TOKEN_END_OBJECT;
+        } else {
+          PJCORE_REQUIRE(ReadChar(']', error), "Close brace or comma expected");
+          token_ = TOKEN_END_ARRAY;
+        }
+        frames_.pop_back();
+        return true;
+
+      case STATE_END:
+        token_ = TOKEN_END;
+        return true;
+    }
+  }
+}
+
+bool JsonTokenizer::ReadByteOrderMark(Error* error) {
+  if (remaining_.starts_with(Unicode::ByteOrderMarkUtf8())) {
+    Advance(Unicode::ByteOrderMarkUtf8().length());
+  } else {
+    PJCORE_REQUIRE(
+        !remaining_.starts_with(Unicode::ByteOrderMarkUtf32BigEndian()),
+        "Big-Endian UTF-32 not supported, only UTF-8");
+    PJCORE_REQUIRE(
+        !remaining_.starts_with(Unicode::ByteOrderMarkUtf32LittleEndian()),
+        "Little-Endian UTF-32 not supported, only UTF-8");
+    PJCORE_REQUIRE(
+        !remaining_.starts_with(Unicode::ByteOrderMarkUtf16BigEndian()),
+        "Big-Endian UTF-16 not supported, only UTF-8");
+    PJCORE_REQUIRE(
+        !remaining_.starts_with(Unicode::ByteOrderMarkUtf16LittleEndian()),
+        "Little-Endian UTF-16 not supported, only UTF-8");
+  }
+
+  return true;
+}
+
+bool JsonTokenizer::ReadValue(Error* error) {
+  state_ = STATE_AFTER_VALUE;
+
+  if (remaining_[0] == '{') {
+    AdvanceOne();
+    frames_.push_back(Frame(true));
+    token_ = TOKEN_BEGIN_OBJECT;
+    state_ = STATE_NAME;
+  } else if (remaining_[0] == '[') {
+    AdvanceOne();
+    frames_.push_back(Frame(false));
+    token_ = TOKEN_BEGIN_ARRAY;
+    state_ = STATE_VALUE;
+  } else if (remaining_[0] == '"') {
+    token_ = TOKEN_STRING;
+    PJCORE_REQUIRE_SILENT(ReadString(&string_value_, error),
+                          "Failed to read string");
+  } else if (remaining_[0] == 'n' && remaining_.starts_with("null")) {
+    token_ = TOKEN_NULL;
+    Advance(4);
+  } else if (remaining_[0] == 't' && remaining_.starts_with("true")) {
+    token_ = TOKEN_BOOL;
+    bool_value_ = true;
+    Advance(4);
+  } else if (remaining_[0] == 'f' && remaining_.starts_with("false")) {
+    token_ = TOKEN_BOOL;
+    bool_value_ = false;
+    Advance(5);
+  } else if (remaining_.length() >= 3 &&
+             (remaining_[0] == 'N' || remaining_[0] == 'n') &&
+             (remaining_[1] == 'A' || remaining_[1] == 'a') &&
+             (remaining_[2] == 'N' || remaining_[2] == 'n')) {
+    PJCORE_REQUIRE(!config_.disallow_nan_and_infinity(), "NaN disallowed");
+    token_ = TOKEN_DOUBLE;
+    double_value_ = std::numeric_limits<double>::quiet_NaN();
+    Advance(3);
+  } else {
+    PJCORE_REQUIRE_SILENT(ReadNumber(error), "Failed to read number");
+  }
+
+  return true;
+}
+
+bool JsonTokenizer::ReadNumber(Error* error) {
+  size_t optional_minus = (remaining_[0] == '-') ? 1 : 0;
+  if (remaining_.length() >= optional_minus + 3 &&
+      (remaining_[optional_minus + 0] == 'I' ||
+       remaining_[optional_minus + 0] == 'i') &&
+      (remaining_[optional_minus + 1] == 'N' ||
+       remaining_[optional_minus + 1] == 'n') &&
+      (remaining_[optional_minus + 2] == 'F' ||
+       remaining_[optional_minus + 2] == 'f')) {
+    PJCORE_REQUIRE(!config_.disallow_nan_and_infinity(),
+                   "Infinity disallowed");
+    token_ = TOKEN_DOUBLE;
+    double_value_ = optional_minus ? -std::numeric_limits<double>::infinity()
+                                   : std::numeric_limits<double>::infinity();
+    Advance(optional_minus + 3);
+    if (remaining_.length() >= 5 &&
+        (remaining_[0] == 'I' || remaining_[0] == 'i') &&
+        (remaining_[1] == 'N' || remaining_[1] == 'n') &&
+        (remaining_[2] == 'I' || remaining_[2] == 'i') &&
+        (remaining_[3] == 'T' || remaining_[3] == 't') &&
+        (remaining_[4] == 'Y' || remaining_[4] == 'y')) {
+      Advance(5);
+    }
+    return true;
+  }
+
+  if (config_.raw_numbers() && ReadRawNumber()) {
+    return true;
+  }
+
+  size_t number_length = 0;
+  if (optional_minus) {
+    PJCORE_REQUIRE(remaining_.length() < 3 || remaining_[1] != '0' ||
+                       !IsDigit::eval(remaining_[2]),
+                   "Invalid number with leading zeroes");
+    number_length = ReadNumberPrefix(remaining_, &signed_value_);
+    if (number_length) {
+      token_ = TOKEN_SIGNED;
+    }
+  } else if (IsDigit::eval(remaining_[0])) {
+    PJCORE_REQUIRE(remaining_.length() < 2 || remaining_[0] != '0' ||
+                       !IsDigit::eval(remaining_[1]),
+                   "Invalid number with leading zeroes");
+    number_length = ReadNumberPrefix(remaining_, &unsigned_value_);
+    if (number_length) {
+      if (unsigned_value_ <=
+          static_cast<uint64_t>(std::numeric_limits<int64_t>::max())) {
+        token_ = TOKEN_SIGNED;
+        signed_value_ = static_cast<int64_t>(unsigned_value_);
+      } else {
+        token_ = TOKEN_UNSIGNED;
+      }
+    }
+  }
+
+  if (!number_length ||
+      (number_length < remaining_.length() &&
+       (remaining_[number_length] == 'e' || remaining_[number_length] == 'E' ||
+        remaining_[number_length] == '.'))) {
+    token_ = TOKEN_NONE;
+    PJCORE_REQUIRE(remaining_[0] == '-' || IsDigit::eval(remaining_[0]),
+                   "Invalid value");
+    number_length = ReadNumberPrefix(remaining_, &double_value_);
+    PJCORE_REQUIRE(number_length, "Invalid number");
+    token_ = TOKEN_DOUBLE;
+  }
+
+  Advance(number_length);
+  return true;
+}
+
+// Scans -?(0|[1-9][0-9]*)(\.[0-9]+)?([eE][+-]?[0-9]+)? without converting it,
+// leaving anything else to ReadNumber and its errors.
+bool JsonTokenizer::ReadRawNumber() {
+  const char* begin = remaining_.data();
+  const char* end = begin + remaining_.length();
+  const char* p = begin;
+
+  if (p != end && *p == '-') {
+    ++p;
+  }
+
+  if (p == end || !IsDigit::eval(*p)) {
+    return false;
+  }
+
+  if (*p == '0') {
+    ++p;
+  } else {
+    while (p != end && IsDigit::eval(*p)) {
+      ++p;
+    }
+  }
+
+  if (p != end && *p == '.') {
+    ++p;
+    if (p == end || !IsDigit::eval(*p)) {
+      return false;
+    }
+    while (p != end && IsDigit::eval(*p)) {
+      ++p;
+    }
+  }
+
+  if (p != end && (*p == 'e' || *p == 'E')) {
+    ++p;
+    if (p != end && (*p == '+' || *p == '-')) {
+      ++p;
+    }
+    if (p == end || !IsDigit::eval(*p)) {
+      return false;
+    }
+    while (p != end && IsDigit::eval(*p)) {
+      ++p;
+    }
+  }
+
+  if (p != end && (IsDigit::eval(*p) || *p == '.' || *p == 'e' ||
+                   *p == 'E' || *p == '+' || *p == '-')) {
+    return false;
+  }
+
+  token_ = TOKEN_RAW_NUMBER;
+  string_value_.assign(begin, p - begin);
+  Advance(p - begin);
+  return true;
+}
+
+void JsonTokenizer::AdvanceOne() {
+  assert(!remaining_.empty());
+  AdvanceTextLocation(&location_, remaining_[0]);
+  remaining_.remove_prefix(1);
+}
+
+void JsonTokenizer::Advance(size_t count) {
+  assert(count <= remaining_.length());
+  AdvanceTextLocation(&location_, remaining_.substr(0, count));
+  remaining_.remove_prefix(count);
+}
+
+bool JsonTokenizer::ReadHexDigit(uint32_t* hex_digit, Error* error) {
+  assert(hex_digit);
+
+  PJCORE_REQUIRE(!remaining_.empty(), "Hex digit expected");
+
+  PJCORE_REQUIRE(IsHexDigit::eval(remaining_[0]), "Hex digit expected");
+
+  *hex_digit = pjcore::ReadHexDigit(remaining_[0]);
+
+  AdvanceOne();
+
+  return true;
+}
+
+bool JsonTokenizer::ReadHexDigits(size_t count, uint32_t* value,
+                                  Error* error) {
+  assert(value);
+
+  *value = 0;
+
+  uint32_t result = 0;
+
+  while (count--) {
+    uint32_t hex_digit;
+    PJCORE_REQUIRE_SILENT(ReadHexDigit(&hex_digit, error), "Invalid hex digit");
+    result = (result << 4) | hex_digit;
+  }
+
+  *value = result;
+  return true;
+}
+
+bool JsonTokenizer::ReadChar(char expected, Error* error) {
+  PJCORE_REQUIRE(!remaining_.empty() && remaining_[0] == expected,
+                 std::string("Character '") + expected + "' expected");
+  AdvanceOne();
+  return true;
+}
+
+void JsonTokenizer::ReadWhitespace() {
+  Advance(MatchingPrefixLength(remaining_, IsWhitespace()));
+}
+
+bool JsonTokenizer::ReadComment(Error* error) {
+  if (remaining_[0] == '#' || remaining_.starts_with("//")) {
+    // Read the rest of the line after # or //.
+    size_t remaining_line_length =
+        MatchingPrefixLength(remaining_, std::not1(IsNewline()));
+
+    // Read the newline character, too.
+    if (remaining_line_length < remaining_.length()) {
+      ++remaining_line_length;
+    }
+
+    Advance(remaining_line_length);
+    return true;
+  }
+
+  PJCORE_REQUIRE(remaining_.starts_with("/*"),
+                 "Comment beginning with // or /* expected");
+
+  size_t offset = 2;
+
+  for (;;) {
+    PJCORE_REQUIRE(offset < remaining_.length(),
+                   "Unterminated multi-line comment");
+    if (remaining_[offset++] == '*') {
+      PJCORE_REQUIRE(offset < remaining_.length(),
+                     "Unterminated multi-line comment");
+      if (remaining_[offset] == '/') {
+        Advance(offset + 1);
+        return true;
+      }
+    }
+  }
+}
+
+bool JsonTokenizer::ReadWhitespaceAndComments(Error* error) {
+  ReadWhitespace();
+
+  if (config_.disallow_comments()) {
+    return true;
+  }
+
+  while (!remaining_.empty() &&
+         (remaining_[0] == '/' || remaining_[0] == '#')) {
+    PJCORE_REQUIRE(ReadComment(error), "Invalid comment");
+    ReadWhitespace();
+  }
+
+  return true;
+}
+
+bool JsonTokenizer::ReadString(std::string* str, Error* error) {
+  assert(str);
+
+  str->clear();
+
+  TextLocation begin_location = location_;
+
+  PJCORE_REQUIRE(ReadChar('"', error), "Invalid string");
+
+  for (;;) {
+    PJCORE_REQUIRE(!remaining_.empty(), "Unterminated string");
+
+    switch (remaining_[0]) {
+      case '"': {
+        AdvanceOne();
+
+        if (!Unicode::IsStructurallyValidUtf8(*str)) {
+          location_ = begin_location;
+          PJCORE_FAIL("Structurally invalid Unicode string");
+        }
+
+        return true;
+      }
+
+      case '\n':
+        PJCORE_REQUIRE(config_.allow_control_characters(),
+                       "String ending with double quotes expected");
+        str->push_back(remaining_[0]);
+        AdvanceOne();
+        break;
+
+      case '\\':
+        AdvanceOne();
+
+        PJCORE_REQUIRE(!remaining_.empty(), "Unterminated escape sequence");
+
+        switch (remaining_[0]) {
+          case '"':
+          case '\\':
+          case '/':
+            str->push_back(remaining_[0]);
+            AdvanceOne();
+            break;
+
+          case 'b':
+            str->push_back('\b');
+            AdvanceOne();
+            break;
+
+          case 'f':
+            str->push_back('\f');
+            AdvanceOne();
+            break;
+
+          case 'n':
+            str->push_back('\n');
+            AdvanceOne();
+            break;
+
+          case 'r':
+            str->push_back('\r');
+            AdvanceOne();
+            break;
+
+          case 't':
+            str->push_back('\t');
+            AdvanceOne();
+            break;
+
+          case 'u': {
+            AdvanceOne();
+            uint32_t code_point;
+            PJCORE_REQUIRE_SILENT(ReadHexDigits(4, &code_point, error),
+                                  "Invalid hex sequence");
+
+            if (Unicode::IsHighSurrogate(code_point)) {
+              uint32_t high_surrogate = code_point;
+
+              uint32_t low_surrogate;
+              PJCORE_REQUIRE(ReadChar('\\', error) && ReadChar('u', error) &&
+                                 ReadHexDigits(4, &low_surrogate, error),
+                             "Invalid Unicode escape sequence");
+
+              PJCORE_REQUIRE(Unicode::IsLowSurrogate(low_surrogate),
+                             "Low-surrogate code point expected");
+
+              PJCORE_REQUIRE(Unicode::DecodeSurrogatePair(
+                                 high_surrogate, low_surrogate, &code_point),
+                             "Invalid surrogate pair");
+            }
+
+            Unicode::WriteCodePointBuffer buffer;
+            StringPiece code_point_str =
+                Unicode::WriteCodePointToBuffer(code_point, &buffer);
+
+            PJCORE_REQUIRE(!code_point_str.empty(),
+                           std::string("Invalid Unicode code point ") +
+                               WriteNumber(code_point));
+
+            code_point_str.AppendToString(str);
+            break;
+          }
+
+          default:
+            PJCORE_FAIL("Invalid escape sequence");
+        }
+        break;
+
+      default:
+        PJCORE_REQUIRE(
+            config_.allow_control_characters() ||
+                !IsUnicodeControl::eval(remaining_[0]),
+            std::string("Invalid control character \\x") +
+                WriteNumber(static_cast<uint8_t>(remaining_[0]), 2));
+
+        str->push_back(remaining_[0]);
+        AdvanceOne();
+        break;
+    }
+  }
+}
+
+}  // namespace pjcore
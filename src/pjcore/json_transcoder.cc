@@ -0,0 +1,874 @@
+// JSON [de]serialization for protobuf + embedded HTTP server and client in C++.
+// Copyright (C) 2014 http://protojson.com/
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+
+#include "pjcore/json_transcoder.h"
+
+#include <algorithm>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "google/protobuf/io/coded_stream.h"
+#include "google/protobuf/wire_format_lite.h"
+
+#include "pjcore/json_codec.h"
+#include "pjcore/logging.h"
+#include "pjcore/make_json_value.h"
+#include "pjcore/unbox_json_value.h"
+
+#define OBJECT_PROPERTIES_STR "object_properties"
+
+namespace pjcore {
+
+using google::protobuf::Descriptor;
+using google::protobuf::EnumValueDescriptor;
+using google::protobuf::FieldDescriptor;
+using google::protobuf::FileDescriptor;
+using google::protobuf::RepeatedPtrField;
+using google::protobuf::internal::WireFormatLite;
+using google::protobuf::io::CodedInputStream;
+
+namespace {
+
+// Same as the default recursion limit of CodedInputStream.
+const int kMaxWireDepth = 100;
+
+// Field value found in the wire format, either a number or, for
+// length-delimited wire types, a payload.
+struct WireRecord {
+  int field_index;
+
+  bool is_length_delimited;
+
+  google::protobuf::uint64 number;
+
+  StringPiece data;
+};
+
+struct WireRecordFieldLess {
+  bool operator()(const WireRecord& left, const WireRecord& right) const {
+    return left.field_index < right.field_index;
+  }
+};
+
+bool IsObjectPropertiesField(const FieldDescriptor& field) {
+  return field.is_repeated() &&
+         field.cpp_type() == FieldDescriptor::CPPTYPE_MESSAGE &&
+         field.message_type() == JsonValue::Property::descriptor() &&
+         field.name() == OBJECT_PROPERTIES_STR;
+}
+
+bool IsPackable(const FieldDescriptor& field) {
+  return field.is_repeated() &&
+         field.cpp_type() != FieldDescriptor::CPPTYPE_STRING &&
+         field.cpp_type() != FieldDescriptor::CPPTYPE_MESSAGE;
+}
+
+// Whether the field is only present when not equal to its default.
+bool HasImplicitPresence(const FieldDescriptor& field) {
+  return field.file()->syntax() == FileDescriptor::SYNTAX_PROTO3 &&
+         !field.containing_oneof() &&
+         field.cpp_type() != FieldDescriptor::CPPTYPE_MESSAGE;
+}
+
+WireFormatLite::WireType GetWireType(const FieldDescriptor& field) {
+  return WireFormatLite::WireTypeForFieldType(
+      static_cast<WireFormatLite::FieldType>(field.type()));
+}
+
+bool IsValidEnumNumber(const FieldDescriptor& field,
+                       google::protobuf::uint64 number) {
+  return field.enum_type()->FindValueByNumber(static_cast<int32_t>(number)) !=
+         NULL;
+}
+
+bool WriteMessage(StringPiece wire, const Descriptor& descriptor,
+                  JsonWriter* writer, Error* error, int depth);
+
+// Collects the known fields of wire in declaration order, dropping what the
+// protobuf parser would treat as unknown or overwrite.
+bool ScanWire(StringPiece wire, const Descriptor& descriptor,
+              std::vector<WireRecord>* records, Error* error) {
+  PJCORE_CHECK(records);
+  records->clear();
+  PJCORE_CHECK(error);
+  error->Clear();
+
+  CodedInputStream input(reinterpret_cast<const uint8_t*>(wire.data()),
+                         static_cast<int>(wire.size()));
+
+  std::vector<int> oneof_field_indices(descriptor.oneof_decl_count(), -1);
+
+  for (;;) {
+    google::protobuf::uint32 tag = input.ReadTag();
+    if (!tag) {
+      PJCORE_REQUIRE(input.ConsumedEntireMessage(), "Invalid wire tag");
+      break;
+    }
+
+    const FieldDescriptor* field =
+        descriptor.FindFieldByNumber(WireFormatLite::GetTagFieldNumber(tag));
+
+    WireRecord record;
+    record.field_index = -1;
+    record.is_length_delimited = false;
+    record.number = 0;
+
+    WireFormatLite::WireType wire_type = WireFormatLite::GetTagWireType(tag);
+    switch (wire_type) {
+      case WireFormatLite::WIRETYPE_VARINT:
+        PJCORE_REQUIRE(input.ReadVarint64(&record.number), "Truncated varint");
+        break;
+
+      case WireFormatLite::WIRETYPE_FIXED64:
+        PJCORE_REQUIRE(input.ReadLittleEndian64(&record.number),
+                       "Truncated fixed64");
+        break;
+
+      case WireFormatLite::WIRETYPE_FIXED32: {
+        google::protobuf::uint32 number;
+        PJCORE_REQUIRE(input.ReadLittleEndian32(&number), "Truncated fixed32");
+        record.number = number;
+        break;
+      }
+
+      case WireFormatLite::WIRETYPE_LENGTH_DELIMITED: {
+        google::protobuf::uint32 length;
+        PJCORE_REQUIRE(input.ReadVarint32(&length), "Truncated length");
+        int offset = input.CurrentPosition();
+        PJCORE_REQUIRE(input.Skip(static_cast<int>(length)),
+                       "Truncated length-delimited field");
+        record.is_length_delimited = true;
+        record.data = wire.substr(offset, length);
+        break;
+      }
+
+      case WireFormatLite::WIRETYPE_START_GROUP:
+        PJCORE_REQUIRE(!field, "Groups are not supported");
+        PJCORE_REQUIRE(WireFormatLite::SkipField(&input, tag),
+                       "Invalid group");
+        continue;
+
+      default:
+        PJCORE_FAIL("Invalid wire type");
+    }
+
+    if (!field) {
+      continue;
+    }
+
+    if (wire_type != GetWireType(*field) &&
+        !(record.is_length_delimited && IsPackable(*field))) {
+      continue;
+    }
+
+    if (field->cpp_type() == FieldDescriptor::CPPTYPE_ENUM &&
+        !record.is_length_delimited &&
+        !IsValidEnumNumber(*field, record.number)) {
+      continue;
+    }
+
+    record.field_index = field->index();
+    records->push_back(record);
+
+    if (field->containing_oneof()) {
+      oneof_field_indices[field->containing_oneof()->index()] = field->index();
+    }
+  }
+
+  if (!oneof_field_indices.empty()) {
+    size_t kept = 0;
+    for (size_t index = 0; index < records->size(); ++index) {
+      const FieldDescriptor& field =
+          *descriptor.field((*records)[index].field_index);
+      if (field.containing_oneof() &&
+          oneof_field_indices[field.containing_oneof()->index()] !=
+              field.index()) {
+        continue;
+      }
+      (*records)[kept++] = (*records)[index];
+    }
+    records->resize(kept);
+  }
+
+  std::stable_sort(records->begin(), records->end(), WireRecordFieldLess());
+  return true;
+}
+
+void WriteScalar(const FieldDescriptor& field, google::protobuf::uint64 number,
+                 JsonWriter* writer) {
+  switch (field.type()) {
+    case FieldDescriptor::TYPE_INT32:
+    case FieldDescriptor::TYPE_SFIXED32:
+      writer->Value(static_cast<int32_t>(number));
+      break;
+
+    case FieldDescriptor::TYPE_SINT32:
+      writer->Value(static_cast<int32_t>(WireFormatLite::ZigZagDecode32(
+          static_cast<google::protobuf::uint32>(number))));
+      break;
+
+    case FieldDescriptor::TYPE_INT64:
+    case FieldDescriptor::TYPE_SFIXED64:
+      writer->Value(static_cast<int64_t>(number));
+      break;
+
+    case FieldDescriptor::TYPE_SINT64:
+      writer->Value(
+          static_cast<int64_t>(WireFormatLite::ZigZagDecode64(number)));
+      break;
+
+    case FieldDescriptor::TYPE_UINT32:
+    case FieldDescriptor::TYPE_FIXED32:
+      writer->Value(static_cast<uint32_t>(number));
+      break;
+
+    case FieldDescriptor::TYPE_UINT64:
+    case FieldDescriptor::TYPE_FIXED64:
+      writer->Value(static_cast<uint64_t>(number));
+      break;
+
+    case FieldDescriptor::TYPE_DOUBLE:
+      writer->Value(WireFormatLite::DecodeDouble(number));
+      break;
+
+    case FieldDescriptor::TYPE_FLOAT:
+      writer->Value(WireFormatLite::DecodeFloat(
+          static_cast<google::protobuf::uint32>(number)));
+      break;
+
+    case FieldDescriptor::TYPE_BOOL:
+      writer->Value(number != 0);
+      break;
+
+    case FieldDescriptor::TYPE_ENUM:
+      writer->Value(StringPiece(
+          field.enum_type()
+              ->FindValueByNumber(static_cast<int32_t>(number))
+              ->name()));
+      break;
+
+    default:
+      PJCORE_CHECK(false);  // field.type()
+  }
+}
+
+// Writes the elements of a repeated number, bool or enum field, or only counts
+// them when writer is NULL.
+bool WriteRepeatedScalars(const WireRecord* begin, const WireRecord* end,
+                          const FieldDescriptor& field, JsonWriter* writer,
+                          size_t* count, Error* error) {
+  PJCORE_CHECK(count);
+  *count = 0;
+  PJCORE_CHECK(error);
+
+  bool is_enum = field.cpp_type() == FieldDescriptor::CPPTYPE_ENUM;
+
+  for (const WireRecord* record = begin; record != end; ++record) {
+    if (!record->is_length_delimited) {
+      ++*count;
+      if (writer) {
+        WriteScalar(field, record->number, writer);
+      }
+      continue;
+    }
+
+    CodedInputStream input(
+        reinterpret_cast<const uint8_t*>(record->data.data()),
+        static_cast<int>(record->data.size()));
+
+    while (input.CurrentPosition() < static_cast<int>(record->data.size())) {
+      google::protobuf::uint64 number;
+      switch (GetWireType(field)) {
+        case WireFormatLite::WIRETYPE_VARINT:
+          PJCORE_REQUIRE(input.ReadVarint64(&number), "Truncated varint");
+          break;
+
+        case WireFormatLite::WIRETYPE_FIXED64:
+          PJCORE_REQUIRE(input.ReadLittleEndian64(&number),
+                         "Truncated fixed64");
+          break;
+
+        case WireFormatLite::WIRETYPE_FIXED32: {
+          google::protobuf::uint32 fixed32;
+          PJCORE_REQUIRE(input.ReadLittleEndian32(&fixed32),
+                         "Truncated fixed32");
+          number = fixed32;
+          break;
+        }
+
+        default:
+          PJCORE_FAIL("Invalid packed wire type");
+      }
+
+      if (is_enum && !IsValidEnumNumber(field, number)) {
+        continue;
+      }
+
+      ++*count;
+      if (writer) {
+        WriteScalar(field, number, writer);
+      }
+    }
+  }
+
+  return true;
+}
+
+// Writes the message merged from the payloads of records.
+bool WriteMergedMessage(const WireRecord* begin, const WireRecord* end,
+                        const Descriptor& descriptor, JsonWriter* writer,
+                        Error* error, int depth) {
+  if (end - begin == 1) {
+    return WriteMessage(begin->data, descriptor, writer, error, depth);
+  }
+
+  // Concatenated serializations parse as the merged message.
+  std::string merged;
+  for (const WireRecord* record = begin; record != end; ++record) {
+    record->data.AppendToString(&merged);
+  }
+  return WriteMessage(merged, descriptor, writer, error, depth);
+}
+
+bool WriteField(const WireRecord* begin, const WireRecord* end,
+                const FieldDescriptor& field, JsonWriter* writer, Error* error,
+                int depth) {
+  PJCORE_CHECK(begin != end);
+  PJCORE_CHECK(writer);
+  PJCORE_CHECK(error);
+
+  if (!field.is_repeated()) {
+    const WireRecord& last = end[-1];
+
+    if (HasImplicitPresence(field) && !last.number && last.data.empty()) {
+      return true;
+    }
+
+    writer->Key(field.name());
+
+    switch (field.cpp_type()) {
+      case FieldDescriptor::CPPTYPE_STRING:
+        if (field.type() == FieldDescriptor::TYPE_STRING) {
+          writer->Value(last.data);
+        } else {
+          WriteJsonBytes(last.data, writer);
+        }
+        return true;
+
+      case FieldDescriptor::CPPTYPE_MESSAGE:
+        PJCORE_REQUIRE_SILENT(
+            WriteMergedMessage(begin, end, *field.message_type(), writer,
+                               error, depth + 1),
+            "Failed to transcode message");
+        return true;
+
+      default:
+        WriteScalar(field, last.number, writer);
+        return true;
+    }
+  }
+
+  if (IsObjectPropertiesField(field)) {
+    JsonValue::Property property;
+    for (const WireRecord* record = begin; record != end; ++record) {
+      PJCORE_REQUIRE(
+          property.ParseFromArray(record->data.data(),
+                                  static_cast<int>(record->data.size())),
+          "Failed to parse object property");
+      writer->Key(property.name());
+      writer->Value(property.value());
+    }
+    return true;
+  }
+
+  if (IsPackable(field)) {
+    size_t count;
+    PJCORE_REQUIRE_SILENT(
+        WriteRepeatedScalars(begin, end, field, NULL, &count, error),
+        "Failed to read packed field");
+    if (!count) {
+      return true;
+    }
+
+    writer->Key(field.name());
+    writer->BeginArray();
+    PJCORE_CHECK(
+        WriteRepeatedScalars(begin, end, field, writer, &count, error));
+    writer->EndArray();
+    return true;
+  }
+
+  writer->Key(field.name());
+  writer->BeginArray();
+  for (const WireRecord* record = begin; record != end; ++record) {
+    if (field.cpp_type() == FieldDescriptor::CPPTYPE_MESSAGE) {
+      PJCORE_REQUIRE_SILENT(WriteMessage(record->data, *field.message_type(),
+                                         writer, error, depth + 1),
+                            "Failed to transcode message");
+    } else if (field.type() == FieldDescriptor::TYPE_STRING) {
+      writer->Value(record->data);
+    } else {
+      WriteJsonBytes(record->data, writer);
+    }
+  }
+  writer->EndArray();
+  return true;
+}
+
+bool WriteMessage(StringPiece wire, const Descriptor& descriptor,
+                  JsonWriter* writer, Error* error, int depth) {
+  PJCORE_REQUIRE(depth < kMaxWireDepth, "Message nesting too deep");
+
+  if (&descriptor == JsonValue::descriptor()) {
+    JsonValue json_value;
+    PJCORE_REQUIRE(
+        json_value.ParseFromArray(wire.data(), static_cast<int>(wire.size())),
+        "Failed to parse JsonValue");
+    writer->Value(json_value);
+    return true;
+  }
+
+  std::vector<WireRecord> records;
+  PJCORE_REQUIRE_SILENT(ScanWire(wire, descriptor, &records, error),
+                        "Failed to read wire format");
+
+  writer->BeginObject();
+
+  size_t begin = 0;
+  while (begin < records.size()) {
+    size_t end = begin + 1;
+    while (end < records.size() &&
+           records[end].field_index == records[begin].field_index) {
+      ++end;
+    }
+
+    PJCORE_REQUIRE_SILENT(
+        WriteField(&records[0] + begin, &records[0] + end,
+                   *descriptor.field(records[begin].field_index), writer,
+                   error, depth),
+        "Failed to transcode field");
+
+    begin = end;
+  }
+
+  writer->EndObject();
+  return true;
+}
+
+void AppendVarint(google::protobuf::uint64 number, std::string* wire) {
+  while (number >= 0x80) {
+    wire->push_back(static_cast<char>(number | 0x80));
+    number >>= 7;
+  }
+  wire->push_back(static_cast<char>(number));
+}
+
+void AppendFixed(google::protobuf::uint64 number, size_t size,
+                 std::string* wire) {
+  for (size_t index = 0; index < size; ++index) {
+    wire->push_back(static_cast<char>(number >> (8 * index)));
+  }
+}
+
+void AppendTag(const FieldDescriptor& field, WireFormatLite::WireType wire_type,
+               std::string* wire) {
+  AppendVarint(WireFormatLite::MakeTag(field.number(), wire_type), wire);
+}
+
+void AppendLengthDelimited(const FieldDescriptor& field, StringPiece data,
+                           std::string* wire) {
+  AppendTag(field, WireFormatLite::WIRETYPE_LENGTH_DELIMITED, wire);
+  AppendVarint(data.size(), wire);
+  data.AppendToString(wire);
+}
+
+// Appends the non-message value of field unboxed from json_value, omitting the
+// tag for elements of packed fields.
+template <typename Source>
+bool AppendScalar(const Source& json_value, const FieldDescriptor& field,
+                  bool with_tag, std::string* wire, Error* error) {
+  google::protobuf::uint64 number = 0;
+
+  switch (field.cpp_type()) {
+    case FieldDescriptor::CPPTYPE_INT32: {
+      int32_t unboxed;
+      PJCORE_REQUIRE_SILENT(UnboxJsonValue(json_value, &unboxed, error),
+                            "Failed to unbox int32_t");
+      number = field.type() == FieldDescriptor::TYPE_SINT32
+                   ? WireFormatLite::ZigZagEncode32(unboxed)
+                   : static_cast<google::protobuf::uint64>(
+                         static_cast<int64_t>(unboxed));
+      break;
+    }
+
+    case FieldDescriptor::CPPTYPE_INT64: {
+      int64_t unboxed;
+      PJCORE_REQUIRE_SILENT(UnboxJsonValue(json_value, &unboxed, error),
+                            "Failed to unbox int64_t");
+      number = field.type() == FieldDescriptor::TYPE_SINT64
+                   ? WireFormatLite::ZigZagEncode64(unboxed)
+                   : static_cast<google::protobuf::uint64>(unboxed);
+      break;
+    }
+
+    case FieldDescriptor::CPPTYPE_UINT32: {
+      uint32_t unboxed;
+      PJCORE_REQUIRE_SILENT(UnboxJsonValue(json_value, &unboxed, error),
+                            "Failed to unbox uint32_t");
+      number = unboxed;
+      break;
+    }
+
+    case FieldDescriptor::CPPTYPE_UINT64: {
+      uint64_t unboxed;
+      PJCORE_REQUIRE_SILENT(UnboxJsonValue(json_value, &unboxed, error),
+                            "Failed to unbox uint64_t");
+      number = unboxed;
+      break;
+    }
+
+    case FieldDescriptor::CPPTYPE_DOUBLE: {
+      double unboxed;
+      PJCORE_REQUIRE_SILENT(UnboxJsonValue(json_value, &unboxed, error),
+                            "Failed to unbox double");
+      number = WireFormatLite::EncodeDouble(unboxed);
+      break;
+    }
+
+    case FieldDescriptor::CPPTYPE_FLOAT: {
+      float unboxed;
+      PJCORE_REQUIRE_SILENT(UnboxJsonValue(json_value, &unboxed, error),
+                            "Failed to unbox float");
+      number = WireFormatLite::EncodeFloat(unboxed);
+      break;
+    }
+
+    case FieldDescriptor::CPPTYPE_BOOL: {
+      bool unboxed;
+      PJCORE_REQUIRE_SILENT(UnboxJsonValue(json_value, &unboxed, error),
+                            "Failed to unbox bool");
+      number = unboxed ? 1 : 0;
+      break;
+    }
+
+    case FieldDescriptor::CPPTYPE_ENUM: {
+      const EnumValueDescriptor* enum_value = NULL;
+      if (json_value.type() == JsonValue::TYPE_STRING) {
+        enum_value =
+            field.enum_type()->FindValueByName(json_value.string_value());
+      }
+      if (!enum_value) {
+        int32_t enum_number;
+        bool has_number;
+        PJCORE_REQUIRE_SILENT(UnboxJsonEnumNumber(json_value, &enum_number,
+                                                  &has_number, error),
+                              "Failed to unbox enum");
+        if (has_number) {
+          enum_value = field.enum_type()->FindValueByNumber(enum_number);
+        }
+      }
+      if (!enum_value) {
+        // Ignored, as by UnboxJsonValue.
+        return true;
+      }
+      number = static_cast<google::protobuf::uint64>(
+          static_cast<int64_t>(enum_value->number()));
+      break;
+    }
+
+    case FieldDescriptor::CPPTYPE_STRING: {
+      std::string unboxed;
+      if (field.type() == FieldDescriptor::TYPE_STRING) {
+        PJCORE_REQUIRE_SILENT(UnboxJsonValue(json_value, &unboxed, error),
+                              "Failed to unbox string");
+      } else {
+        PJCORE_REQUIRE_SILENT(UnboxJsonBytes(json_value, &unboxed, error),
+                              "Failed to unbox string");
+      }
+      AppendLengthDelimited(field, unboxed, wire);
+      return true;
+    }
+
+    default:
+      PJCORE_CHECK(false);  // field.cpp_type()
+  }
+
+  WireFormatLite::WireType wire_type = GetWireType(field);
+  if (with_tag) {
+    AppendTag(field, wire_type, wire);
+  }
+
+  switch (wire_type) {
+    case WireFormatLite::WIRETYPE_VARINT:
+      AppendVarint(number, wire);
+      break;
+
+    case WireFormatLite::WIRETYPE_FIXED64:
+      AppendFixed(number, 8, wire);
+      break;
+
+    case WireFormatLite::WIRETYPE_FIXED32:
+      AppendFixed(number, 4, wire);
+      break;
+
+    default:
+      PJCORE_CHECK(false);  // wire_type
+  }
+
+  return true;
+}
+
+bool AppendObject(JsonTokenizer* tokenizer, const Descriptor& descriptor,
+                  std::string* wire, Error* error);
+
+bool AppendMessage(JsonTokenizer* tokenizer, const FieldDescriptor& field,
+                   std::string* wire, Error* error) {
+  std::string nested;
+  PJCORE_REQUIRE(AppendObject(tokenizer, *field.message_type(), &nested, error),
+                 "Failed to unbox message");
+  AppendLengthDelimited(field, nested, wire);
+  return true;
+}
+
+// Appends the entries of a repeated message field given as an object keyed by
+// their name field.
+bool AppendNamedEntries(JsonTokenizer* tokenizer, const FieldDescriptor& field,
+                        const FieldDescriptor& name_field, std::string* wire,
+                        Error* error) {
+  PJCORE_REQUIRE(!name_field.is_repeated() &&
+                     name_field.cpp_type() != FieldDescriptor::CPPTYPE_MESSAGE,
+                 "Unsupported name field");
+
+  std::vector<std::string> entries;
+  std::vector<std::string> names;
+  std::set<std::string> seen_names;
+
+  for (;;) {
+    PJCORE_REQUIRE_SILENT(tokenizer->Next(error), "Failed to read property");
+    if (tokenizer->token() == JsonTokenizer::TOKEN_END_OBJECT) {
+      break;
+    }
+    names.push_back(std::string());
+    names.back().swap(*tokenizer->mutable_string_value());
+    PJCORE_REQUIRE_SILENT(tokenizer->Next(error), "Failed to read value");
+    if (!tokenizer->config().properties_as_is() &&
+        !seen_names.insert(names.back()).second) {
+      names.pop_back();
+      PJCORE_REQUIRE_SILENT(tokenizer->SkipValue(error),
+                            "Failed to skip value");
+      continue;
+    }
+    entries.push_back(std::string());
+    PJCORE_REQUIRE_SILENT(
+        AppendObject(tokenizer, *field.message_type(), &entries.back(), error),
+        "Failed to parse message JSON");
+  }
+
+  std::vector<size_t> order;
+  OrderJsonNames(tokenizer->config(), names, &order);
+
+  for (std::vector<size_t>::const_iterator it = order.begin();
+       it != order.end(); ++it) {
+    // Appended last, the name overrides any name in the entry itself.
+    PJCORE_REQUIRE_SILENT(AppendScalar(MakeJsonValue(names[*it]), name_field,
+                                       true, &entries[*it], error),
+                          "Failed to parse field JSON");
+    AppendLengthDelimited(field, entries[*it], wire);
+  }
+
+  return true;
+}
+
+bool AppendField(JsonTokenizer* tokenizer, const FieldDescriptor& field,
+                 std::string* wire, Error* error) {
+  if (tokenizer->token() == JsonTokenizer::TOKEN_NULL) {
+    // Clears the field, which was not appended yet.
+    return true;
+  }
+
+  if (!field.is_repeated()) {
+    if (field.cpp_type() == FieldDescriptor::CPPTYPE_MESSAGE) {
+      return AppendMessage(tokenizer, field, wire, error);
+    }
+    return AppendScalar(*tokenizer, field, true, wire, error);
+  }
+
+  if (tokenizer->token() == JsonTokenizer::TOKEN_BEGIN_ARRAY) {
+    bool is_packed = field.is_packed();
+    std::string packed;
+
+    for (;;) {
+      PJCORE_REQUIRE_SILENT(tokenizer->Next(error), "Failed to read value");
+      if (tokenizer->token() == JsonTokenizer::TOKEN_END_ARRAY) {
+        break;
+      }
+      if (field.cpp_type() == FieldDescriptor::CPPTYPE_MESSAGE) {
+        PJCORE_REQUIRE_SILENT(AppendMessage(tokenizer, field, wire, error),
+                              "Failed to append message");
+      } else {
+        PJCORE_REQUIRE_SILENT(AppendScalar(*tokenizer, field, !is_packed,
+                                           is_packed ? &packed : wire, error),
+                              "Failed to append value");
+      }
+    }
+
+    if (!packed.empty()) {
+      AppendLengthDelimited(field, packed, wire);
+    }
+    return true;
+  }
+
+  const FieldDescriptor* name_field = NULL;
+  if (tokenizer->token() == JsonTokenizer::TOKEN_BEGIN_OBJECT &&
+      field.cpp_type() == FieldDescriptor::CPPTYPE_MESSAGE) {
+    name_field = field.message_type()->FindFieldByName("name");
+  }
+
+  if (!name_field) {
+    PJCORE_FAIL(
+        "Array expected for repeated field, or object if repeated message "
+        "has field name");
+  }
+
+  return AppendNamedEntries(tokenizer, field, *name_field, wire, error);
+}
+
+bool AppendObject(JsonTokenizer* tokenizer, const Descriptor& descriptor,
+                  std::string* wire, Error* error) {
+  PJCORE_CHECK(tokenizer);
+  PJCORE_CHECK(wire);
+  PJCORE_CHECK(error);
+  error->Clear();
+
+  if (&descriptor == JsonValue::descriptor()) {
+    JsonValue json_value;
+    PJCORE_REQUIRE_SILENT(ReadJson(tokenizer, &json_value, error),
+                          "Failed to read value");
+    json_value.AppendToString(wire);
+    return true;
+  }
+
+  PJCORE_REQUIRE(tokenizer->token() == JsonTokenizer::TOKEN_BEGIN_OBJECT,
+                 std::string("Value is not an object: ") +
+                     JsonValue::Type_Name(tokenizer->type()));
+
+  const FieldDescriptor* object_properties_field =
+      descriptor.FindFieldByName(OBJECT_PROPERTIES_STR);
+  if (object_properties_field &&
+      !IsObjectPropertiesField(*object_properties_field)) {
+    object_properties_field = NULL;
+  }
+
+  RepeatedPtrField<JsonValue::Property> object_properties;
+  std::vector<bool> seen(descriptor.field_count(), false);
+  std::string name;
+
+  for (;;) {
+    PJCORE_REQUIRE_SILENT(tokenizer->Next(error), "Failed to read property");
+    if (tokenizer->token() == JsonTokenizer::TOKEN_END_OBJECT) {
+      break;
+    }
+    name.swap(*tokenizer->mutable_string_value());
+    PJCORE_REQUIRE_SILENT(tokenizer->Next(error), "Failed to read value");
+
+    const FieldDescriptor* field = descriptor.FindFieldByName(name);
+
+    if (!field) {
+      if (object_properties_field) {
+        PJCORE_REQUIRE_SILENT(
+            ReadJsonProperty(tokenizer, &name, &object_properties, error),
+            "Failed to read value");
+      } else {
+        PJCORE_REQUIRE_SILENT(tokenizer->SkipValue(error),
+                              "Failed to skip value");
+      }
+      continue;
+    }
+
+    if (!tokenizer->config().properties_as_is()) {
+      if (seen[field->index()]) {
+        PJCORE_REQUIRE_SILENT(tokenizer->SkipValue(error),
+                              "Failed to skip value");
+        continue;
+      }
+      seen[field->index()] = true;
+    }
+
+    PJCORE_REQUIRE_SILENT(AppendField(tokenizer, *field, wire, error),
+                          "Failed to parse field JSON");
+  }
+
+  if (object_properties.size()) {
+    SortJsonProperties(tokenizer->config(), &object_properties);
+    for (RepeatedPtrField<JsonValue::Property>::const_iterator it =
+             object_properties.begin();
+         it != object_properties.end(); ++it) {
+      AppendLengthDelimited(*object_properties_field, it->SerializeAsString(),
+                            wire);
+    }
+  }
+
+  return true;
+}
+
+}  // unnamed namespace
+
+bool TranscodeWireToJson(StringPiece wire, const Descriptor& descriptor,
+                         std::string* output, Error* error,
+                         const JsonWriterConfig& config) {
+  PJCORE_CHECK(output);
+
+  JsonWriter writer(output, config);
+  return TranscodeWireToJson(wire, descriptor, &writer, error);
+}
+
+bool TranscodeWireToJson(StringPiece wire, const Descriptor& descriptor,
+                         JsonWriter* writer, Error* error) {
+  PJCORE_CHECK(writer);
+  PJCORE_CHECK(error);
+  error->Clear();
+
+  return WriteMessage(wire, descriptor, writer, error, 0);
+}
+
+bool TranscodeJsonToWire(StringPiece json, const Descriptor& descriptor,
+                         std::string* wire, Error* error,
+                         const JsonReaderConfig& config) {
+  PJCORE_CHECK(wire);
+  PJCORE_CHECK(error);
+  error->Clear();
+
+  JsonTokenizer tokenizer(json, config);
+
+  PJCORE_REQUIRE_CAUSE(
+      tokenizer.Next(error) &&
+          TranscodeJsonToWire(&tokenizer, descriptor, wire, error) &&
+          tokenizer.Next(error),
+      "Failed to parse JSON string");
+
+  return true;
+}
+
+bool TranscodeJsonToWire(JsonTokenizer* tokenizer,
+                         const Descriptor& descriptor, std::string* wire,
+                         Error* error) {
+  return AppendObject(tokenizer, descriptor, wire, error);
+}
+
+}  // namespace pjcore
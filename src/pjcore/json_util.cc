@@ -17,15 +17,19 @@
 
 #include "pjcore/json_util.h"
 
+#include <string.h>
+
 #include <algorithm>
 #include <limits>
 #include <utility>
+#include <vector>
 
 #include "pjcore/logging.h"
 #include "pjcore/make_json_value.h"
 #include "pjcore/name_value_util.h"
 #include "pjcore/number_util.h"
 #include "pjcore/repeated_field_util.h"
+#include "pjcore/string_piece_util.h"
 #include "pjcore/third_party/chromium/macros.h"
 #include "pjcore/third_party/gtest/are_almost_equal.h"
 #include "pjcore/unique_keep_last.h"
@@ -62,6 +66,7 @@ bool VerifyJsonType(const JsonValue& value, std::string* error) {
         {&JsonValue::has_string_value, "No string_value for TYPE_STRING"},
         {&JsonValue::has_type, ""},
         {&JsonValue::has_type, ""},
+        {&JsonValue::has_string_value, "No string_value for TYPE_RAW_NUMBER"},
     };
 
   if (value.has_type()) {
@@ -77,7 +82,8 @@ bool VerifyJsonType(const JsonValue& value, std::string* error) {
   }
 
   if (value.has_string_value()) {
-    PJCORE_REQUIRE_STRING(value.type() == JsonValue::TYPE_STRING,
+    PJCORE_REQUIRE_STRING(value.type() == JsonValue::TYPE_STRING ||
+                              value.type() == JsonValue::TYPE_RAW_NUMBER,
                           std::string("Unexpected string_value for ") +
                               JsonValue_Type_Name(value.type()));
   }
@@ -106,6 +112,20 @@ bool VerifyJsonType(const JsonValue& value, std::string* error) {
                               JsonValue_Type_Name(value.type()));
   }
 
+  if (IsPackedJsonArray(value)) {
+    PJCORE_REQUIRE_STRING(value.type() == JsonValue::TYPE_ARRAY,
+                          std::string("Unexpected packed values for ") +
+                              JsonValue_Type_Name(value.type()));
+
+    PJCORE_REQUIRE_STRING(
+        !value.array_elements_size() &&
+            (value.packed_signed_values_size() != 0) +
+                    (value.packed_unsigned_values_size() != 0) +
+                    (value.packed_double_values_size() != 0) ==
+                1,
+        "Mixed packed values");
+  }
+
   if (value.object_properties_size()) {
     PJCORE_REQUIRE_STRING(value.type() == JsonValue::TYPE_OBJECT,
                           std::string("Unexpected object_properties for ") +
@@ -124,14 +144,186 @@ bool VerifyJsonType(const JsonValue& value, std::string* error) {
 bool IsJsonNumber(const JsonValue& value) {
   return value.type() == JsonValue::TYPE_SIGNED ||
          value.type() == JsonValue::TYPE_UNSIGNED ||
-         value.type() == JsonValue::TYPE_DOUBLE;
+         value.type() == JsonValue::TYPE_DOUBLE ||
+         value.type() == JsonValue::TYPE_RAW_NUMBER;
 }
 
-bool IsJsonNumber(const JsonValue& value);
+bool ReadJsonRawNumber(StringPiece raw_number, JsonValue* number) {
+  PJCORE_CHECK(number);
+  number->Clear();
+
+  // Rejects leading zeroes, as ReadJson does.
+  size_t optional_minus = (!raw_number.empty() && raw_number[0] == '-') ? 1 : 0;
+  if (raw_number.length() >= optional_minus + 2 &&
+      raw_number[optional_minus] == '0' &&
+      IsDigit::eval(raw_number[optional_minus + 1])) {
+    return false;
+  }
+
+  if (optional_minus) {
+    int64_t signed_value;
+    if (ReadNumber(raw_number, &signed_value)) {
+      number->set_type(JsonValue::TYPE_SIGNED);
+      number->set_signed_value(signed_value);
+      return true;
+    }
+  } else {
+    uint64_t unsigned_value;
+    if (ReadNumber(raw_number, &unsigned_value)) {
+      if (unsigned_value <=
+          static_cast<uint64_t>(std::numeric_limits<int64_t>::max())) {
+        number->set_type(JsonValue::TYPE_SIGNED);
+        number->set_signed_value(static_cast<int64_t>(unsigned_value));
+      } else {
+        number->set_type(JsonValue::TYPE_UNSIGNED);
+        number->set_unsigned_value(unsigned_value);
+      }
+      return true;
+    }
+  }
+
+  double double_value;
+  if (ReadNumber(raw_number, &double_value)) {
+    number->set_type(JsonValue::TYPE_DOUBLE);
+    number->set_double_value(double_value);
+    return true;
+  }
+
+  return false;
+}
+
+const JsonValue& ResolveJsonRawNumber(const JsonValue& value,
+                                      JsonValue* buffer) {
+  PJCORE_CHECK(buffer);
+
+  if (value.type() != JsonValue::TYPE_RAW_NUMBER) {
+    return value;
+  }
+
+  if (!ReadJsonRawNumber(value.string_value(), buffer)) {
+    buffer->set_type(JsonValue::TYPE_NULL);
+  }
+  return *buffer;
+}
+
+bool IsPackedJsonArray(const JsonValue& value) {
+  return value.packed_signed_values_size() ||
+         value.packed_unsigned_values_size() ||
+         value.packed_double_values_size();
+}
+
+int GetJsonArraySize(const JsonValue& value) {
+  return value.array_elements_size() + value.packed_signed_values_size() +
+         value.packed_unsigned_values_size() +
+         value.packed_double_values_size();
+}
+
+const JsonValue& GetJsonArrayElement(const JsonValue& value, int index,
+                                     JsonValue* buffer) {
+  PJCORE_CHECK(buffer);
+
+  if (value.packed_signed_values_size()) {
+    buffer->set_type(JsonValue::TYPE_SIGNED);
+    buffer->set_signed_value(value.packed_signed_values(index));
+    return *buffer;
+  }
+
+  if (value.packed_unsigned_values_size()) {
+    buffer->set_type(JsonValue::TYPE_UNSIGNED);
+    buffer->set_unsigned_value(value.packed_unsigned_values(index));
+    return *buffer;
+  }
+
+  if (value.packed_double_values_size()) {
+    buffer->set_type(JsonValue::TYPE_DOUBLE);
+    buffer->set_double_value(value.packed_double_values(index));
+    return *buffer;
+  }
+
+  return value.array_elements(index);
+}
+
+bool PackJsonArray(JsonValue* value) {
+  PJCORE_CHECK(value);
+
+  if (IsPackedJsonArray(*value)) {
+    return true;
+  }
+
+  if (value->type() != JsonValue::TYPE_ARRAY ||
+      !value->array_elements_size()) {
+    return false;
+  }
+
+  JsonValue::Type type = value->array_elements(0).type();
+  if (type != JsonValue::TYPE_SIGNED && type != JsonValue::TYPE_UNSIGNED &&
+      type != JsonValue::TYPE_DOUBLE) {
+    return false;
+  }
+
+  for (google::protobuf::RepeatedPtrField<JsonValue>::const_iterator it =
+           value->array_elements().begin();
+       it != value->array_elements().end(); ++it) {
+    if (it->type() != type) {
+      return false;
+    }
+  }
+
+  for (google::protobuf::RepeatedPtrField<JsonValue>::const_iterator it =
+           value->array_elements().begin();
+       it != value->array_elements().end(); ++it) {
+    switch (type) {
+      case JsonValue::TYPE_SIGNED:
+        value->add_packed_signed_values(it->signed_value());
+        break;
+
+      case JsonValue::TYPE_UNSIGNED:
+        value->add_packed_unsigned_values(it->unsigned_value());
+        break;
+
+      default:
+        value->add_packed_double_values(it->double_value());
+        break;
+    }
+  }
+
+  value->clear_array_elements();
+  return true;
+}
+
+void UnpackJsonArray(JsonValue* value) {
+  PJCORE_CHECK(value);
+
+  if (!IsPackedJsonArray(*value)) {
+    return;
+  }
+
+  int size = GetJsonArraySize(*value);
+  value->mutable_array_elements()->Reserve(size);
+
+  JsonValue buffer;
+  for (int index = 0; index < size; ++index) {
+    value->add_array_elements()->CopyFrom(
+        GetJsonArrayElement(*value, index, &buffer));
+  }
+
+  value->clear_packed_signed_values();
+  value->clear_packed_unsigned_values();
+  value->clear_packed_double_values();
+}
 
 static bool AreJsonValuesEqualRecursive(const JsonValue& left,
-                                        const JsonValue& right,
+                                        const JsonValue& right, bool exact,
                                         std::string* optional_diff_path) {
+  if (left.type() == JsonValue::TYPE_RAW_NUMBER ||
+      right.type() == JsonValue::TYPE_RAW_NUMBER) {
+    JsonValue left_buffer;
+    JsonValue right_buffer;
+    return AreJsonValuesEqualRecursive(
+        ResolveJsonRawNumber(left, &left_buffer),
+        ResolveJsonRawNumber(right, &right_buffer), exact, optional_diff_path);
+  }
+
   switch (left.type()) {
     case JsonValue::TYPE_NULL:
       return right.type() == JsonValue::TYPE_NULL;
@@ -215,6 +407,8 @@ static bool AreJsonValuesEqualRecursive(const JsonValue& left,
             return right.double_value() != right.double_value();
           } else if (right.double_value() != right.double_value()) {
             return false;
+          } else if (exact) {
+            return left.double_value() == right.double_value();
           } else {
             return AreAlmostEqual(left.double_value(), right.double_value());
           }
@@ -252,7 +446,7 @@ static bool AreJsonValuesEqualRecursive(const JsonValue& left,
           AppendJsonPathProperty(left_it->name(), optional_diff_path);
         }
         if (!AreJsonValuesEqualRecursive(left_it->value(), right_it->value(),
-                                         optional_diff_path)) {
+                                         exact, optional_diff_path)) {
           return false;
         }
         if (optional_diff_path) {
@@ -272,37 +466,41 @@ static bool AreJsonValuesEqualRecursive(const JsonValue& left,
       return true;
     }
 
-    case JsonValue::TYPE_ARRAY:
+    case JsonValue::TYPE_ARRAY: {
       if (right.type() != JsonValue::TYPE_ARRAY) {
         return false;
       }
 
-      for (int index = 0; index < std::min(left.array_elements_size(),
-                                           right.array_elements_size());
-           ++index) {
+      int left_size = GetJsonArraySize(left);
+      int right_size = GetJsonArraySize(right);
+      JsonValue left_buffer;
+      JsonValue right_buffer;
+
+      for (int index = 0; index < std::min(left_size, right_size); ++index) {
         size_t previous_path_length = 0;
         if (optional_diff_path) {
           previous_path_length = optional_diff_path->length();
           AppendJsonPathElement(index, optional_diff_path);
         }
-        if (!AreJsonValuesEqualRecursive(left.array_elements(index),
-                                         right.array_elements(index),
-                                         optional_diff_path)) {
+        if (!AreJsonValuesEqualRecursive(
+                GetJsonArrayElement(left, index, &left_buffer),
+                GetJsonArrayElement(right, index, &right_buffer), exact,
+                optional_diff_path)) {
           return false;
         }
         if (optional_diff_path) {
           optional_diff_path->resize(previous_path_length);
         }
       }
-      if (left.array_elements_size() != right.array_elements_size()) {
+      if (left_size != right_size) {
         if (optional_diff_path) {
-          AppendJsonPathElement(
-              std::min(left.array_elements_size(), right.array_elements_size()),
-              optional_diff_path);
+          AppendJsonPathElement(std::min(left_size, right_size),
+                                optional_diff_path);
         }
         return false;
       }
       return true;
+    }
 
     case JsonValue::TYPE_BOOL:
       return left.bool_value() == right.bool_value();
@@ -318,7 +516,147 @@ bool AreJsonValuesEqual(const JsonValue& left, const JsonValue& right,
     *optional_diff_path = GetRootJsonPath();
   }
 
-  return AreJsonValuesEqualRecursive(left, right, optional_diff_path);
+  return AreJsonValuesEqualRecursive(left, right, false, optional_diff_path);
+}
+
+namespace {
+
+const uint64_t kNullHashSeed = 0x6a09e667f3bcc908ull;
+const uint64_t kBoolHashSeed = 0xbb67ae8584caa73bull;
+const uint64_t kNonNegativeHashSeed = 0x3c6ef372fe94f82bull;
+const uint64_t kNegativeHashSeed = 0xa54ff53a5f1d36f1ull;
+const uint64_t kDoubleHashSeed = 0x510e527fade682d1ull;
+const uint64_t kStringHashSeed = 0x9b05688c2b3e6c1full;
+const uint64_t kObjectHashSeed = 0x1f83d9abfb41bd6bull;
+const uint64_t kArrayHashSeed = 0x5be0cd19137e2179ull;
+
+// Finalizer of SplitMix64.
+uint64_t MixJsonHash(uint64_t hash) {
+  hash = (hash ^ (hash >> 30)) * 0xbf58476d1ce4e5b9ull;
+  hash = (hash ^ (hash >> 27)) * 0x94d049bb133111ebull;
+  return hash ^ (hash >> 31);
+}
+
+uint64_t HashJsonString(StringPiece str) {
+  // FNV-1a.
+  uint64_t hash = 0xcbf29ce484222325ull;
+  for (size_t index = 0; index < str.size(); ++index) {
+    hash ^= static_cast<uint8_t>(str[index]);
+    hash *= 0x100000001b3ull;
+  }
+  return MixJsonHash(hash ^ kStringHashSeed);
+}
+
+uint64_t HashJsonSigned(int64_t signed_value) {
+  return MixJsonHash(static_cast<uint64_t>(signed_value) ^
+                     (signed_value < 0 ? kNegativeHashSeed
+                                       : kNonNegativeHashSeed));
+}
+
+uint64_t HashJsonUnsigned(uint64_t unsigned_value) {
+  return MixJsonHash(unsigned_value ^ kNonNegativeHashSeed);
+}
+
+// Hashes integral doubles as the integers they compare equal to.
+uint64_t HashJsonDouble(double double_value) {
+  if (double_value != double_value) {
+    return MixJsonHash(kDoubleHashSeed);
+  }
+
+  if (double_value >= -9223372036854775808.0 &&
+      double_value < 9223372036854775808.0) {
+    int64_t signed_value = static_cast<int64_t>(double_value);
+    if (static_cast<double>(signed_value) == double_value) {
+      return HashJsonSigned(signed_value);
+    }
+  } else if (double_value >= 0 && double_value < 18446744073709551616.0) {
+    return HashJsonUnsigned(static_cast<uint64_t>(double_value));
+  }
+
+  uint64_t bits;
+  memcpy(&bits, &double_value, sizeof(bits));
+  return MixJsonHash(bits ^ kDoubleHashSeed);
+}
+
+}  // unnamed namespace
+
+uint64_t HashJsonObjectProperty(StringPiece name, uint64_t value_hash) {
+  return MixJsonHash(HashJsonString(name) ^ MixJsonHash(value_hash));
+}
+
+uint64_t HashJsonObject(int size, uint64_t property_hash_sum) {
+  return MixJsonHash(kObjectHashSeed + size + property_hash_sum);
+}
+
+uint64_t HashJsonArray(const uint64_t* element_hashes, int size) {
+  uint64_t hash = kArrayHashSeed + size;
+  for (int index = 0; index < size; ++index) {
+    hash = MixJsonHash(hash) + element_hashes[index];
+  }
+  return MixJsonHash(hash);
+}
+
+uint64_t HashJsonValue(const JsonValue& value) {
+  switch (value.type()) {
+    case JsonValue::TYPE_NULL:
+      return MixJsonHash(kNullHashSeed);
+
+    case JsonValue::TYPE_BOOL:
+      return MixJsonHash(kBoolHashSeed + value.bool_value());
+
+    case JsonValue::TYPE_SIGNED:
+      return HashJsonSigned(value.signed_value());
+
+    case JsonValue::TYPE_UNSIGNED:
+      return HashJsonUnsigned(value.unsigned_value());
+
+    case JsonValue::TYPE_DOUBLE:
+      return HashJsonDouble(value.double_value());
+
+    case JsonValue::TYPE_RAW_NUMBER: {
+      JsonValue buffer;
+      return HashJsonValue(ResolveJsonRawNumber(value, &buffer));
+    }
+
+    case JsonValue::TYPE_STRING:
+      return HashJsonString(value.string_value());
+
+    case JsonValue::TYPE_OBJECT: {
+      uint64_t property_hash_sum = 0;
+      for (google::protobuf::RepeatedPtrField<
+               JsonValue::Property>::const_iterator it =
+               value.object_properties().begin();
+           it != value.object_properties().end(); ++it) {
+        property_hash_sum +=
+            HashJsonObjectProperty(it->name(), HashJsonValue(it->value()));
+      }
+      return HashJsonObject(value.object_properties_size(), property_hash_sum);
+    }
+
+    case JsonValue::TYPE_ARRAY: {
+      int size = GetJsonArraySize(value);
+      std::vector<uint64_t> element_hashes(size);
+      JsonValue buffer;
+      for (int index = 0; index < size; ++index) {
+        element_hashes[index] =
+            HashJsonValue(GetJsonArrayElement(value, index, &buffer));
+      }
+      return HashJsonArray(size ? &element_hashes[0] : NULL, size);
+    }
+
+    default:
+      PJCORE_CHECK(false);  // value.type()
+      return 0;
+  }
+}
+
+bool AreJsonValuesIdentical(const JsonValue& left, const JsonValue& right) {
+  return AreJsonValuesEqualRecursive(left, right, true, NULL);
+}
+
+bool AreJsonValuesIdentical(const JsonValue& left, uint64_t left_hash,
+                            const JsonValue& right, uint64_t right_hash) {
+  return left_hash == right_hash && AreJsonValuesIdentical(left, right);
 }
 
 const std::string& GetRootJsonPath() { return kRootJsonPath; }
@@ -17,6 +17,9 @@
 
 #include "pjcore/json_writer.h"
 
+#include <assert.h>
+#include <string.h>
+
 #include <limits>
 #include <stack>
 #include <string>
@@ -33,159 +36,257 @@ namespace pjcore {
 namespace {
 
 struct Source {
-  explicit Source(const JsonValue* a_value = NULL)
-      : value(a_value), index(-1) {}
+  explicit Source(const JsonValue* a_value = NULL, int a_packed_index = -1)
+      : value(a_value), packed_index(a_packed_index), index(-1) {}
 
   const JsonValue* value;
 
+  // Element of the packed array value to write in place of value, or -1.
+  int packed_index;
+
   int index;
 };
 
-class Context {
+class SizeCounter {
  public:
-  Context(const JsonWriterConfig& config, const JsonValue& value,
-          std::string* output)
-      : config_(config), value_(value), output_(output) {
-    PJCORE_CHECK(output_);
-    output_->clear();
-  }
+  SizeCounter() : size_(0) {}
+
+  size_t size() const { return size_; }
+
+  void push_back(char ch) { ++size_; }
+
+  void append(const char* str) { size_ += strlen(str); }
 
-  void Complete();
+  void append(const char* str, size_t length) { size_ += length; }
+
+  void append(const std::string& str) { size_ += str.size(); }
 
  private:
-  Source& source() { return source_stack_.top(); }
+  size_t size_;
+};
 
-  void Indent() {
-    newline_indent_.resize(newline_indent_.size() + config_.indent(), ' ');
-  }
+template <typename Output>
+void WriteFourHexDigits(uint32_t value, Output* output) {
+  output->push_back(WriteHexDigit(value >> 12));
+  output->push_back(WriteHexDigit((value >> 8) & 0xf));
+  output->push_back(WriteHexDigit((value >> 4) & 0xf));
+  output->push_back(WriteHexDigit(value & 0xf));
+}
 
-  void Outdent() {
-    newline_indent_.resize(newline_indent_.size() - config_.indent());
-  }
+template <typename Output, typename Number>
+void WriteJsonNumber(Number value, Output* output) {
+  WriteNumberBuffer buffer;
+  StringPiece number_str = WriteNumberToBuffer(value, &buffer);
+  output->append(number_str.data(), number_str.size());
+}
 
-  void WriteFourHexDigits(uint32_t value) {
-    output_->push_back(WriteHexDigit(value >> 12));
-    output_->push_back(WriteHexDigit((value >> 8) & 0xf));
-    output_->push_back(WriteHexDigit((value >> 4) & 0xf));
-    output_->push_back(WriteHexDigit(value & 0xf));
+template <typename Output>
+void WriteJsonDouble(double value, bool null_for_nan_and_infinity,
+                     Output* output) {
+  if (value != value) {
+    if (null_for_nan_and_infinity) {
+      output->append("null", 4);
+    } else {
+      output->append("NaN", 3);
+    }
+  } else if (value == std::numeric_limits<double>::infinity()) {
+    if (null_for_nan_and_infinity) {
+      output->append("null", 4);
+    } else {
+      output->append("Infinity", 8);
+    }
+  } else if (value == -std::numeric_limits<double>::infinity()) {
+    if (null_for_nan_and_infinity) {
+      output->append("null", 4);
+    } else {
+      output->append("-Infinity", 9);
+    }
+  } else {
+    WriteJsonNumber(value, output);
   }
+}
 
-  void WriteHumanStrings(StringPiece str) {}
+template <typename Output>
+void WriteJsonString(StringPiece str, bool escape_unicode, Output* output) {
+  output->push_back('"');
 
-  void WriteString(StringPiece str) {
-    output_->push_back('"');
+  size_t offset = 0;
 
-    size_t offset = 0;
+  while (offset < str.length()) {
+    switch (str[offset]) {
+      case '"':
+        output->append("\\\"");
+        ++offset;
+        break;
 
-    while (offset < str.length()) {
-      switch (str[offset]) {
-        case '"':
-          output_->append("\\\"");
-          ++offset;
-          break;
+      case '\\':
+        output->append("\\\\");
+        ++offset;
+        break;
 
-        case '\\':
-          output_->append("\\\\");
-          ++offset;
-          break;
+      case '/':
+        output->append("\\/");
+        ++offset;
+        break;
 
-        case '/':
-          output_->append("\\/");
-          ++offset;
-          break;
+      case '\b':
+        output->append("\\b");
+        ++offset;
+        break;
 
-        case '\b':
-          output_->append("\\b");
-          ++offset;
-          break;
+      case '\n':
+        output->append("\\n");
+        ++offset;
+        break;
 
-        case '\n':
-          output_->append("\\n");
-          ++offset;
-          break;
+      case '\f':
+        output->append("\\f");
+        ++offset;
+        break;
 
-        case '\f':
-          output_->append("\\f");
-          ++offset;
-          break;
+      case '\r':
+        output->append("\\r");
+        ++offset;
+        break;
 
-        case '\r':
-          output_->append("\\r");
-          ++offset;
-          break;
+      case '\t':
+        output->append("\\t");
+        ++offset;
+        break;
 
-        case '\t':
-          output_->append("\\t");
+      default:
+        if (!escape_unicode || static_cast<uint8_t>(str[offset]) < 0x80) {
+          output->push_back(str[offset]);
           ++offset;
-          break;
+        } else {
+          Unicode::CodePoint code_point;
+          size_t code_point_length =
+              Unicode::ReadCodePointPrefix(str.substr(offset), &code_point);
 
-        default:
-          if (!config_.escape_unicode() ||
-              static_cast<uint8_t>(str[offset]) < 0x80) {
-            output_->push_back(str[offset]);
+          if (!code_point_length) {
+            output->push_back(str[offset]);
             ++offset;
           } else {
-            Unicode::CodePoint code_point;
-            size_t code_point_length =
-                Unicode::ReadCodePointPrefix(str.substr(offset), &code_point);
-
-            if (!code_point_length) {
-              output_->push_back(str[offset]);
-              ++offset;
+            if (!Unicode::IsSurrogatePair(code_point)) {
+              output->append("\\u");
+              WriteFourHexDigits(code_point, output);
             } else {
-              if (!Unicode::IsSurrogatePair(code_point)) {
-                output_->append("\\u");
-                WriteFourHexDigits(code_point);
+              Unicode::CodePoint high_surrogate;
+              Unicode::CodePoint low_surrogate;
+
+              if (!Unicode::EncodeSurrogatePair(code_point, &high_surrogate,
+                                                &low_surrogate)) {
+                output->append(str.data() + offset, code_point_length);
               } else {
-                Unicode::CodePoint high_surrogate;
-                Unicode::CodePoint low_surrogate;
-
-                if (!Unicode::EncodeSurrogatePair(code_point, &high_surrogate,
-                                                  &low_surrogate)) {
-                  output_->append(str.data() + offset, code_point_length);
-                } else {
-                  output_->append("\\u");
-                  WriteFourHexDigits(high_surrogate);
-
-                  output_->append("\\u");
-                  WriteFourHexDigits(low_surrogate);
-                }
-              }
+                output->append("\\u");
+                WriteFourHexDigits(high_surrogate, output);
 
-              offset += code_point_length;
+                output->append("\\u");
+                WriteFourHexDigits(low_surrogate, output);
+              }
             }
+
+            offset += code_point_length;
           }
-          break;
-      }
+        }
+        break;
     }
+  }
+
+  output->push_back('"');
+}
+
+template <typename Output>
+class Context {
+ public:
+  // depth is the nesting level of value, for indentation.
+  Context(const JsonWriterConfig& config, const JsonValue& value,
+          Output* output, size_t depth = 0)
+      : config_(config), value_(value), output_(output), depth_(depth) {}
 
-    output_->push_back('"');
+  void set_output(Output* output) { output_ = output; }
+
+  // Writes the byte order mark, if any, and readies the value.
+  void Begin();
+
+  // Writes whole values until the output grows by at least step_size bytes,
+  // returning false, or the value is complete, returning true.
+  bool Continue(size_t step_size);
+
+  void Complete() {
+    Begin();
+    Continue(std::numeric_limits<size_t>::max());
   }
 
+ private:
+  Source& source() { return source_stack_.top(); }
+
+  void Indent() {
+    newline_indent_.resize(newline_indent_.size() + config_.indent(), ' ');
+  }
+
+  void Outdent() {
+    newline_indent_.resize(newline_indent_.size() - config_.indent());
+  }
+
+  void WriteString(StringPiece str) {
+    WriteJsonString(str, config_.escape_unicode(), output_);
+  }
+
+  void WritePackedElement(const JsonValue& value, int index);
+
   const JsonWriterConfig& config_;
 
   const JsonValue& value_;
 
-  std::string* output_;
+  Output* output_;
+
+  size_t depth_;
 
   std::stack<Source> source_stack_;
 
   std::string newline_indent_;
 };
 
-void Context::Complete() {
-  output_->clear();
+template <typename Output>
+void Context<Output>::WritePackedElement(const JsonValue& value, int index) {
+  if (value.packed_signed_values_size()) {
+    WriteJsonNumber(value.packed_signed_values(index), output_);
+  } else if (value.packed_unsigned_values_size()) {
+    WriteJsonNumber(value.packed_unsigned_values(index), output_);
+  } else {
+    WriteJsonDouble(value.packed_double_values(index),
+                    config_.null_for_nan_and_infinity(), output_);
+  }
+}
 
-  if (config_.include_byte_order_mark()) {
-    Unicode::ByteOrderMarkUtf8().AppendToString(output_);
+template <typename Output>
+void Context<Output>::Begin() {
+  PJCORE_CHECK(output_);
+
+  if (config_.include_byte_order_mark() && !depth_) {
+    StringPiece byte_order_mark = Unicode::ByteOrderMarkUtf8();
+    output_->append(byte_order_mark.data(), byte_order_mark.size());
   }
 
   source_stack_.push(Source(&value_));
   if (config_.indent()) {
     newline_indent_ = "\n";
+    newline_indent_.resize(1 + depth_ * config_.indent(), ' ');
   }
+}
+
+template <typename Output>
+bool Context<Output>::Continue(size_t step_size) {
+  PJCORE_CHECK(output_);
+
+  size_t begin_size = output_->size();
+
+  while (!source_stack_.empty()) {
+    if (output_->size() - begin_size >= step_size) {
+      return false;
+    }
 
-  for (;;) {
     std::string type_error;
     PJCORE_CHECK(VerifyJsonType(*source().value, &type_error));  // type_error
 
@@ -199,37 +300,20 @@ void Context::Complete() {
         break;
 
       case JsonValue::TYPE_SIGNED:
-        output_->append(WriteNumber(source().value->signed_value()));
+        WriteJsonNumber(source().value->signed_value(), output_);
         break;
 
       case JsonValue::TYPE_UNSIGNED:
-        output_->append(WriteNumber(source().value->unsigned_value()));
+        WriteJsonNumber(source().value->unsigned_value(), output_);
         break;
 
       case JsonValue::TYPE_DOUBLE:
-        if (source().value->double_value() != source().value->double_value()) {
-          if (config_.null_for_nan_and_infinity()) {
-            output_->append("null", 4);
-          } else {
-            output_->append("NaN", 3);
-          }
-        } else if (source().value->double_value() ==
-                   std::numeric_limits<double>::infinity()) {
-          if (config_.null_for_nan_and_infinity()) {
-            output_->append("null", 4);
-          } else {
-            output_->append("Infinity", 8);
-          }
-        } else if (source().value->double_value() ==
-                   -std::numeric_limits<double>::infinity()) {
-          if (config_.null_for_nan_and_infinity()) {
-            output_->append("null", 4);
-          } else {
-            output_->append("-Infinity", 9);
-          }
-        } else {
-          output_->append(WriteNumber(source().value->double_value()));
-        }
+        WriteJsonDouble(source().value->double_value(),
+                        config_.null_for_nan_and_infinity(), output_);
+        break;
+
+      case JsonValue::TYPE_RAW_NUMBER:
+        output_->append(source().value->string_value());
         break;
 
       case JsonValue::TYPE_OBJECT:
@@ -245,7 +329,10 @@ void Context::Complete() {
         break;
 
       case JsonValue::TYPE_ARRAY:
-        if (Empty(source().value->array_elements())) {
+        if (source().packed_index >= 0) {
+          WritePackedElement(*source().value, source().packed_index);
+        } else if (!IsPackedJsonArray(*source().value) &&
+                   Empty(source().value->array_elements())) {
           output_->append("[]");
         } else {
           output_->push_back('[');
@@ -257,7 +344,7 @@ void Context::Complete() {
         break;
 
       case JsonValue::TYPE_BOOL:
-        output_->append(WriteNumber(source().value->bool_value()));
+        WriteJsonNumber(source().value->bool_value(), output_);
         break;
 
       default:
@@ -268,7 +355,7 @@ void Context::Complete() {
       source_stack_.pop();
 
       if (source_stack_.empty()) {
-        return;
+        break;
       }
 
       if (source().value->type() == JsonValue::TYPE_OBJECT) {
@@ -298,7 +385,7 @@ void Context::Complete() {
         }
       } else {
         PJCORE_CHECK_EQ(JsonValue::TYPE_ARRAY, source().value->type());
-        if (++source().index >= source().value->array_elements_size()) {
+        if (++source().index >= GetJsonArraySize(*source().value)) {
           if (config_.indent()) {
             Outdent();
             output_->append(newline_indent_);
@@ -313,25 +400,376 @@ void Context::Complete() {
           } else if (source().index != 0 && config_.space()) {
             output_->push_back(' ');
           }
-          source_stack_.push(
-              Source(&source().value->array_elements(source().index)));
+          if (IsPackedJsonArray(*source().value)) {
+            source_stack_.push(Source(source().value, source().index));
+          } else {
+            source_stack_.push(
+                Source(&source().value->array_elements(source().index)));
+          }
           break;
         }
       }
     }
   }
+
+  return true;
 }
 
 }  // unnamed namespace
 
 std::string WriteJson(const JsonValue& value, const JsonWriterConfig& config) {
   std::string str;
+  WriteJson(value, &str, config);
+  return str;
+}
 
-  Context context(config, value, &str);
+void WriteJson(const JsonValue& value, std::string* output,
+               const JsonWriterConfig& config) {
+  Context<std::string> context(config, value, output);
 
   context.Complete();
+}
 
-  return str;
+namespace internal {
+
+void WriteNestedJson(const JsonValue& value, size_t depth,
+                     const JsonWriterConfig& config, std::string* output) {
+  Context<std::string> context(config, value, output, depth);
+  context.Complete();
+}
+
+void WriteJsonName(StringPiece name, const JsonWriterConfig& config,
+                   std::string* output) {
+  WriteJsonString(name, config.escape_unicode(), output);
+}
+
+void WriteJsonMembers(const JsonValue& container, int begin, int end,
+                      const JsonWriterConfig& config, std::string* output) {
+  PJCORE_CHECK(output);
+
+  bool is_object = container.type() == JsonValue::TYPE_OBJECT;
+  PJCORE_CHECK(is_object || (container.type() == JsonValue::TYPE_ARRAY &&
+                             !IsPackedJsonArray(container)));
+
+  std::string newline_indent;
+  if (config.indent()) {
+    newline_indent.resize(1 + config.indent(), ' ');
+    newline_indent[0] = '\n';
+  }
+
+  for (int index = begin; index < end; ++index) {
+    if (index > 0) {
+      output->push_back(',');
+    }
+    if (config.indent()) {
+      output->append(newline_indent);
+    } else if (index != 0 && config.space()) {
+      output->push_back(' ');
+    }
+
+    const JsonValue* member = NULL;
+    if (is_object) {
+      const JsonValue::Property& property = container.object_properties(index);
+      WriteJsonString(property.name(), config.escape_unicode(), output);
+      output->push_back(':');
+      if (config.space()) {
+        output->push_back(' ');
+      }
+      member = &property.value();
+    } else {
+      member = &container.array_elements(index);
+    }
+
+    Context<std::string> context(config, *member, output, 1);
+    context.Complete();
+  }
+}
+
+}  // namespace internal
+
+size_t ComputeJsonSize(const JsonValue& value,
+                       const JsonWriterConfig& config) {
+  SizeCounter counter;
+
+  Context<SizeCounter> context(config, value, &counter);
+
+  context.Complete();
+
+  return counter.size();
+}
+
+struct ResumableJsonWriter::State {
+  State(const JsonValue& value, const JsonWriterConfig& config)
+      : context(config, value, NULL) {}
+
+  Context<std::string> context;
+};
+
+ResumableJsonWriter::ResumableJsonWriter(const JsonValue& value,
+                                         const JsonWriterConfig& config)
+    : state_(new State(value, config)), begun_(false), done_(false) {}
+
+ResumableJsonWriter::~ResumableJsonWriter() {}
+
+bool ResumableJsonWriter::Step(size_t step_size, std::string* output) {
+  PJCORE_CHECK(output);
+
+  if (done_) {
+    return true;
+  }
+
+  state_->context.set_output(output);
+
+  if (!begun_) {
+    state_->context.Begin();
+    begun_ = true;
+  }
+
+  done_ = state_->context.Continue(step_size);
+
+  state_->context.set_output(NULL);
+
+  return done_;
+}
+
+JsonWriter::JsonWriter(std::string* output, const JsonWriterConfig& config)
+    : config_(config), sink_(NULL), output_(output), has_root_(false) {
+  PJCORE_CHECK(output_);
+
+  Init();
+}
+
+JsonWriter::JsonWriter(JsonWriterSink* sink, const JsonWriterConfig& config)
+    : config_(config), sink_(sink), output_(&buffer_), has_root_(false) {
+  PJCORE_CHECK(sink_);
+
+  buffer_.reserve(2 * kJsonWriterSinkChunkSize);
+  Init();
+}
+
+JsonWriter::~JsonWriter() { Flush(); }
+
+void JsonWriter::Flush() {
+  if (sink_ && !buffer_.empty()) {
+    sink_->Append(buffer_);
+    buffer_.clear();
+  }
+}
+
+void JsonWriter::BeginObject() { BeginContainer(true); }
+
+void JsonWriter::EndObject() { EndContainer('}'); }
+
+void JsonWriter::BeginArray() { BeginContainer(false); }
+
+void JsonWriter::EndArray() { EndContainer(']'); }
+
+void JsonWriter::Key(StringPiece name) {
+  PJCORE_CHECK(!frames_.empty() && frames_.back().is_object);
+  assert(!frames_.back().has_key);
+
+  MaybeFlush();
+  BeginMember();
+  frames_.back().has_key = true;
+  WriteJsonString(name, config_.escape_unicode(), output_);
+  output_->push_back(':');
+  if (config_.space()) {
+    output_->push_back(' ');
+  }
+}
+
+void JsonWriter::Null() {
+  BeginValue();
+  output_->append("null", 4);
+}
+
+void JsonWriter::Value(bool bool_value) {
+  BeginValue();
+  WriteJsonNumber(bool_value, output_);
+}
+
+void JsonWriter::Value(int32_t signed_value) {
+  BeginValue();
+  WriteJsonNumber(static_cast<int64_t>(signed_value), output_);
+}
+
+void JsonWriter::Value(int64_t signed_value) {
+  BeginValue();
+  WriteJsonNumber(signed_value, output_);
+}
+
+#ifdef PJCORE_DISTINCT_LONG_LONG
+void JsonWriter::Value(long long int signed_value) {  // NOLINT(runtime/int)
+  Value(static_cast<int64_t>(signed_value));
+}
+#endif  // PJCORE_DISTINCT_LONG_LONG
+
+void JsonWriter::Value(uint32_t unsigned_value) {
+  BeginValue();
+  WriteJsonNumber(static_cast<uint64_t>(unsigned_value), output_);
+}
+
+void JsonWriter::Value(uint64_t unsigned_value) {
+  BeginValue();
+  WriteJsonNumber(unsigned_value, output_);
+}
+
+#ifdef PJCORE_DISTINCT_LONG_LONG
+void JsonWriter::Value(
+    long long unsigned int unsigned_value) {  // NOLINT(runtime/int)
+  Value(static_cast<uint64_t>(unsigned_value));
+}
+#endif  // PJCORE_DISTINCT_LONG_LONG
+
+void JsonWriter::Value(float double_value) {
+  Value(static_cast<double>(double_value));
+}
+
+void JsonWriter::Value(double double_value) {
+  BeginValue();
+  WriteJsonDouble(double_value, config_.null_for_nan_and_infinity(), output_);
+}
+
+void JsonWriter::Value(const char* string_value) {
+  Value(StringPiece(string_value));
+}
+
+void JsonWriter::Value(StringPiece string_value) {
+  BeginValue();
+  WriteJsonString(string_value, config_.escape_unicode(), output_);
+}
+
+void JsonWriter::Value(const JsonValue& value) {
+  switch (value.type()) {
+    case JsonValue::TYPE_NULL:
+      Null();
+      break;
+
+    case JsonValue::TYPE_STRING:
+      Value(StringPiece(value.string_value()));
+      break;
+
+    case JsonValue::TYPE_SIGNED:
+      Value(static_cast<int64_t>(value.signed_value()));
+      break;
+
+    case JsonValue::TYPE_UNSIGNED:
+      Value(static_cast<uint64_t>(value.unsigned_value()));
+      break;
+
+    case JsonValue::TYPE_DOUBLE:
+      Value(value.double_value());
+      break;
+
+    case JsonValue::TYPE_RAW_NUMBER:
+      BeginValue();
+      output_->append(value.string_value());
+      break;
+
+    case JsonValue::TYPE_OBJECT:
+      BeginObject();
+      for (google::protobuf::RepeatedPtrField<
+               JsonValue::Property>::const_iterator it =
+               value.object_properties().begin();
+           it != value.object_properties().end(); ++it) {
+        Key(it->name());
+        Value(it->value());
+      }
+      EndObject();
+      break;
+
+    case JsonValue::TYPE_ARRAY:
+      BeginArray();
+      for (google::protobuf::RepeatedPtrField<JsonValue>::const_iterator it =
+               value.array_elements().begin();
+           it != value.array_elements().end(); ++it) {
+        Value(*it);
+      }
+      for (int index = 0; index < value.packed_signed_values_size(); ++index) {
+        Value(static_cast<int64_t>(value.packed_signed_values(index)));
+      }
+      for (int index = 0; index < value.packed_unsigned_values_size();
+           ++index) {
+        Value(static_cast<uint64_t>(value.packed_unsigned_values(index)));
+      }
+      for (int index = 0; index < value.packed_double_values_size(); ++index) {
+        Value(value.packed_double_values(index));
+      }
+      EndArray();
+      break;
+
+    case JsonValue::TYPE_BOOL:
+      Value(value.bool_value());
+      break;
+
+    default:
+      PJCORE_CHECK(false);  // value.type()
+  }
+}
+
+void JsonWriter::Init() {
+  if (config_.include_byte_order_mark()) {
+    StringPiece byte_order_mark = Unicode::ByteOrderMarkUtf8();
+    output_->append(byte_order_mark.data(), byte_order_mark.size());
+  }
+
+  if (config_.indent()) {
+    newline_indent_ = "\n";
+  }
+}
+
+void JsonWriter::MaybeFlush() {
+  if (buffer_.size() >= kJsonWriterSinkChunkSize) {
+    Flush();
+  }
+}
+
+void JsonWriter::BeginMember() {
+  Frame& frame = frames_.back();
+  if (frame.size > 0) {
+    output_->push_back(',');
+  }
+  if (config_.indent()) {
+    output_->append(newline_indent_);
+  } else if (frame.size > 0 && config_.space()) {
+    output_->push_back(' ');
+  }
+  ++frame.size;
+}
+
+void JsonWriter::BeginValue() {
+  MaybeFlush();
+
+  if (frames_.empty()) {
+    assert(!has_root_);
+    has_root_ = true;
+  } else if (frames_.back().is_object) {
+    assert(frames_.back().has_key);
+    frames_.back().has_key = false;
+  } else {
+    BeginMember();
+  }
+}
+
+void JsonWriter::BeginContainer(bool is_object) {
+  BeginValue();
+  output_->push_back(is_object ? '{' : '[');
+  frames_.push_back(Frame(is_object));
+  newline_indent_.resize(newline_indent_.size() + config_.indent(), ' ');
+}
+
+void JsonWriter::EndContainer(char close) {
+  PJCORE_CHECK(!frames_.empty() &&
+               frames_.back().is_object == (close == '}'));
+  assert(!frames_.back().has_key);
+
+  MaybeFlush();
+  newline_indent_.resize(newline_indent_.size() - config_.indent());
+  if (config_.indent() && frames_.back().size > 0) {
+    output_->append(newline_indent_);
+  }
+  output_->push_back(close);
+  frames_.pop_back();
 }
 
 std::string WritePrettyJson(const JsonValue& value) {
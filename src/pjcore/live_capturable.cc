@@ -20,7 +20,6 @@
 #include <inttypes.h>
 #include <stdint.h>
 
-#include <algorithm>
 #include <string>
 #include <typeinfo>
 
@@ -85,40 +84,27 @@ void LiveCapturable::CaptureLiveJsonOut(JsonValue* live_json) const {
 
   LiveCapturableList::ConsiderHexifyPtrRecursive(live_json);
 
-  JsonPropertyList live_properties;
+  static const char* const kLiveNames[] = {"live_id", "live_class", "live_ptr",
+                                           "live_parent_id", "live_parent_ptr"};
+  JsonPropertyBuilder live_properties(
+      live_json, kLiveNames,
+      kLiveNames + sizeof(kLiveNames) / sizeof(kLiveNames[0]));
 
   if (live_id_ != LiveCapturableList::kNullId) {
-    SetJsonProperty(&live_properties, "live_id", live_id_);
+    live_properties.Set("live_id", live_id_);
   }
 
-  SetJsonProperty(&live_properties, "live_class", live_class_);
+  live_properties.Set("live_class", live_class_);
 
-  SetJsonProperty(&live_properties, "live_ptr",
-                  LiveCapturableList::HexifyPtr(this));
+  live_properties.Set("live_ptr", LiveCapturableList::HexifyPtr(this));
 
   if (live_parent_id_) {
-    SetJsonProperty(&live_properties, "live_parent_id", live_parent_id_);
+    live_properties.Set("live_parent_id", live_parent_id_);
   }
 
   if (live_parent_ptr_) {
-    SetJsonProperty(&live_properties, "live_parent_ptr",
-                    LiveCapturableList::HexifyPtr(live_parent_ptr_));
-  }
-
-  for (int index = 0; index < live_properties.size(); ++index) {
-    live_json->mutable_object_properties()->Add();
-  }
-
-  for (int index = live_json->object_properties_size();
-       index > live_properties.size(); --index) {
-    live_json->mutable_object_properties()->SwapElements(
-        index - live_properties.size() - 1, index - 1);
-  }
-
-  for (int index = 0; index < live_properties.size(); ++index) {
-    using std::swap;
-    swap(*live_json->mutable_object_properties(index),
-         *live_properties.Mutable(index));
+    live_properties.Set("live_parent_ptr",
+                        LiveCapturableList::HexifyPtr(live_parent_ptr_));
   }
 }
 
@@ -107,6 +107,28 @@ const JsonValue& MakeJsonValue(const JsonValue& json_value) {
   return json_value;
 }
 
+void AppendJsonProperty(StringPiece name, const JsonValue& value,
+                        JsonValue* json_object) {
+  JsonValue::Property* property = json_object->add_object_properties();
+  name.CopyToString(property->mutable_name());
+  property->mutable_value()->CopyFrom(value);
+}
+
+void AppendJsonProperty(StringPiece name, JsonValue* value,
+                        JsonValue* json_object) {
+  JsonValue::Property* property = json_object->add_object_properties();
+  name.CopyToString(property->mutable_name());
+  property->mutable_value()->Swap(value);
+}
+
+void AppendJsonElement(const JsonValue& value, JsonValue* json_array) {
+  json_array->add_array_elements()->CopyFrom(value);
+}
+
+void AppendJsonElement(JsonValue* value, JsonValue* json_array) {
+  json_array->add_array_elements()->Swap(value);
+}
+
 JsonValue MakeJsonObject() {
   JsonValue json_value;
   json_value.set_type(JsonValue::TYPE_OBJECT);
@@ -17,7 +17,10 @@
 
 #include "pjcore/make_json_value.h"
 
+#include <string>
+
 #include "pjcore/logging.h"
+#include "pjcore/json_field_mask.h"
 #include "pjcore/json_util.h"
 #include "pjcore/number_util.h"
 #include "pjcore/string_piece_util.h"
@@ -35,130 +38,227 @@ using google::protobuf::EnumValueDescriptor;
 using google::protobuf::FieldDescriptor;
 using google::protobuf::Message;
 using google::protobuf::Reflection;
+using google::protobuf::RepeatedField;
 using google::protobuf::RepeatedPtrField;
 
 namespace {
 
-void MakeJsonValueOut(const Message& message, JsonValue* value);
+void MakeJsonValueOut(const Message& message, const JsonFieldMask* mask,
+                      JsonValue* value);
+
+void SignedToJsonOut(int64_t signed_value, JsonValue* value) {
+  value->set_type(JsonValue::TYPE_SIGNED);
+  value->set_signed_value(signed_value);
+}
+
+void UnsignedToJsonOut(uint64_t unsigned_value, JsonValue* value) {
+  value->set_type(JsonValue::TYPE_UNSIGNED);
+  value->set_unsigned_value(unsigned_value);
+}
+
+void DoubleToJsonOut(double double_value, JsonValue* value) {
+  value->set_type(JsonValue::TYPE_DOUBLE);
+  value->set_double_value(double_value);
+}
+
+void BoolToJsonOut(bool bool_value, JsonValue* value) {
+  value->set_type(JsonValue::TYPE_BOOL);
+  value->set_bool_value(bool_value);
+}
+
+void StringToJsonOut(const std::string& string_value, JsonValue* value) {
+  value->set_type(JsonValue::TYPE_STRING);
+  value->set_string_value(string_value);
+}
+
+void BytesToJsonOut(const std::string& bytes_value, JsonValue* value) {
+  value->set_type(JsonValue::TYPE_STRING);
+  std::string base_64 = WriteBase64(bytes_value);
+  value->mutable_string_value()->swap(base_64);
+}
+
+inline void NumberToJsonOut(google::protobuf::int32 number, JsonValue* value) {
+  SignedToJsonOut(number, value);
+}
+
+inline void NumberToJsonOut(google::protobuf::int64 number, JsonValue* value) {
+  SignedToJsonOut(number, value);
+}
+
+inline void NumberToJsonOut(google::protobuf::uint32 number, JsonValue* value) {
+  UnsignedToJsonOut(number, value);
+}
+
+inline void NumberToJsonOut(google::protobuf::uint64 number, JsonValue* value) {
+  UnsignedToJsonOut(number, value);
+}
+
+inline void NumberToJsonOut(double number, JsonValue* value) {
+  DoubleToJsonOut(number, value);
+}
+
+inline void NumberToJsonOut(float number, JsonValue* value) {
+  DoubleToJsonOut(number, value);
+}
+
+inline void NumberToJsonOut(bool number, JsonValue* value) {
+  BoolToJsonOut(number, value);
+}
+
+template <typename Number>
+void RepeatedNumbersToJsonOut(const RepeatedField<Number>& numbers,
+                              JsonValue* value) {
+  RepeatedPtrField<JsonValue>* elements = value->mutable_array_elements();
+  elements->Reserve(numbers.size());
+
+  for (typename RepeatedField<Number>::const_iterator it = numbers.begin();
+       it != numbers.end(); ++it) {
+    NumberToJsonOut(*it, elements->Add());
+  }
+}
 
 void FieldToJsonOut(const Message& message, const Reflection& reflection,
-                    const FieldDescriptor& field, JsonValue* value) {
+                    const FieldDescriptor& field, const JsonFieldMask* mask,
+                    JsonValue* value) {
   PJCORE_CHECK(value);
 
   if (!field.is_repeated()) {
     switch (field.cpp_type()) {
       case FieldDescriptor::CPPTYPE_INT32:  // TYPE_INT32, TYPE_SINT32,
                                             // TYPE_SFIXED32
-        *value = MakeJsonValue(reflection.GetInt32(message, &field));
+        SignedToJsonOut(reflection.GetInt32(message, &field), value);
         break;
 
       case FieldDescriptor::CPPTYPE_INT64:  // TYPE_INT64, TYPE_SINT64,
                                             // TYPE_SFIXED64
-        *value = MakeJsonValue(reflection.GetInt64(message, &field));
+        SignedToJsonOut(reflection.GetInt64(message, &field), value);
         break;
 
       case FieldDescriptor::CPPTYPE_UINT32:  // TYPE_UINT32, TYPE_FIXED32
-        *value = MakeJsonValue(reflection.GetUInt32(message, &field));
+        UnsignedToJsonOut(reflection.GetUInt32(message, &field), value);
         break;
 
       case FieldDescriptor::CPPTYPE_UINT64:  // TYPE_UINT64, TYPE_FIXED64
-        *value = MakeJsonValue(reflection.GetUInt64(message, &field));
+        UnsignedToJsonOut(reflection.GetUInt64(message, &field), value);
         break;
 
       case FieldDescriptor::CPPTYPE_DOUBLE:  // TYPE_DOUBLE
-        *value = MakeJsonValue(reflection.GetDouble(message, &field));
+        DoubleToJsonOut(reflection.GetDouble(message, &field), value);
         break;
 
       case FieldDescriptor::CPPTYPE_FLOAT:  // TYPE_FLOAT
-        *value = MakeJsonValue(reflection.GetFloat(message, &field));
+        DoubleToJsonOut(reflection.GetFloat(message, &field), value);
         break;
 
       case FieldDescriptor::CPPTYPE_BOOL:  // TYPE_BOOL
-        *value = MakeJsonValue(reflection.GetBool(message, &field));
+        BoolToJsonOut(reflection.GetBool(message, &field), value);
         break;
 
       case FieldDescriptor::CPPTYPE_ENUM:  // TYPE_ENUM
-        *value = MakeJsonValue(reflection.GetEnum(message, &field)->name());
+        StringToJsonOut(reflection.GetEnum(message, &field)->name(), value);
         break;
 
-      case FieldDescriptor::CPPTYPE_STRING:  // TYPE_STRING, TYPE_BYTES
+      case FieldDescriptor::CPPTYPE_STRING: {  // TYPE_STRING, TYPE_BYTES
+        std::string scratch;
+        const std::string& string_value =
+            reflection.GetStringReference(message, &field, &scratch);
         if (field.type() == FieldDescriptor::TYPE_STRING) {
-          *value = MakeJsonValue(reflection.GetString(message, &field));
+          StringToJsonOut(string_value, value);
         } else {
-          *value =
-              MakeJsonValue(WriteBase64(reflection.GetString(message, &field)));
+          BytesToJsonOut(string_value, value);
         }
         break;
+      }
 
       case FieldDescriptor::CPPTYPE_MESSAGE:  // TYPE_MESSAGE, TYPE_GROUP
-        *value = MakeJsonValue(reflection.GetMessage(message, &field));
+        MakeJsonValueOut(reflection.GetMessage(message, &field), mask, value);
         break;
 
       default:
         PJCORE_CHECK(false);  // fied.cpp_type()
     }
   } else {
-    int field_size = reflection.FieldSize(message, &field);
     value->set_type(JsonValue::TYPE_ARRAY);
-    value->mutable_array_elements()->Reserve(field_size);
-    for (int field_index = 0; field_index < field_size; ++field_index) {
-      switch (field.cpp_type()) {
-        case FieldDescriptor::CPPTYPE_INT32:  // TYPE_INT32, TYPE_SINT32,
-                                              // TYPE_SFIXED32
-          *value->add_array_elements() = MakeJsonValue(
-              reflection.GetRepeatedInt32(message, &field, field_index));
-          break;
 
-        case FieldDescriptor::CPPTYPE_INT64:  // TYPE_INT64, TYPE_SINT64,
-                                              // TYPE_SFIXED64
-          *value->add_array_elements() = MakeJsonValue(
-              reflection.GetRepeatedInt64(message, &field, field_index));
-          break;
+    switch (field.cpp_type()) {
+      case FieldDescriptor::CPPTYPE_INT32:  // TYPE_INT32, TYPE_SINT32,
+                                            // TYPE_SFIXED32
+        RepeatedNumbersToJsonOut(
+            reflection.GetRepeatedField<google::protobuf::int32>(message,
+                                                                 &field),
+            value);
+        return;
 
-        case FieldDescriptor::CPPTYPE_UINT32:  // TYPE_UINT32, TYPE_FIXED32
-          *value->add_array_elements() = MakeJsonValue(
-              reflection.GetRepeatedUInt32(message, &field, field_index));
-          break;
+      case FieldDescriptor::CPPTYPE_INT64:  // TYPE_INT64, TYPE_SINT64,
+                                            // TYPE_SFIXED64
+        RepeatedNumbersToJsonOut(
+            reflection.GetRepeatedField<google::protobuf::int64>(message,
+                                                                 &field),
+            value);
+        return;
 
-        case FieldDescriptor::CPPTYPE_UINT64:  // TYPE_UINT64, TYPE_FIXED64
-          *value->add_array_elements() = MakeJsonValue(
-              reflection.GetRepeatedUInt64(message, &field, field_index));
-          break;
+      case FieldDescriptor::CPPTYPE_UINT32:  // TYPE_UINT32, TYPE_FIXED32
+        RepeatedNumbersToJsonOut(
+            reflection.GetRepeatedField<google::protobuf::uint32>(message,
+                                                                  &field),
+            value);
+        return;
 
-        case FieldDescriptor::CPPTYPE_DOUBLE:  // TYPE_DOUBLE
-          *value->add_array_elements() = MakeJsonValue(
-              reflection.GetRepeatedDouble(message, &field, field_index));
-          break;
+      case FieldDescriptor::CPPTYPE_UINT64:  // TYPE_UINT64, TYPE_FIXED64
+        RepeatedNumbersToJsonOut(
+            reflection.GetRepeatedField<google::protobuf::uint64>(message,
+                                                                  &field),
+            value);
+        return;
 
-        case FieldDescriptor::CPPTYPE_FLOAT:  // TYPE_FLOAT
-          *value->add_array_elements() = MakeJsonValue(
-              reflection.GetRepeatedFloat(message, &field, field_index));
-          break;
+      case FieldDescriptor::CPPTYPE_DOUBLE:  // TYPE_DOUBLE
+        RepeatedNumbersToJsonOut(
+            reflection.GetRepeatedField<double>(message, &field), value);
+        return;
 
-        case FieldDescriptor::CPPTYPE_BOOL:  // TYPE_BOOL
-          *value->add_array_elements() = MakeJsonValue(
-              reflection.GetRepeatedBool(message, &field, field_index));
-          break;
+      case FieldDescriptor::CPPTYPE_FLOAT:  // TYPE_FLOAT
+        RepeatedNumbersToJsonOut(
+            reflection.GetRepeatedField<float>(message, &field), value);
+        return;
 
+      case FieldDescriptor::CPPTYPE_BOOL:  // TYPE_BOOL
+        RepeatedNumbersToJsonOut(
+            reflection.GetRepeatedField<bool>(message, &field), value);
+        return;
+
+      default:
+        break;
+    }
+
+    int field_size = reflection.FieldSize(message, &field);
+    value->mutable_array_elements()->Reserve(field_size);
+    std::string scratch;
+    for (int field_index = 0; field_index < field_size; ++field_index) {
+      JsonValue* element = value->add_array_elements();
+
+      switch (field.cpp_type()) {
         case FieldDescriptor::CPPTYPE_ENUM:  // TYPE_ENUM
-          *value->add_array_elements() = MakeJsonValue(
-              reflection.GetRepeatedEnum(message, &field, field_index)->name());
+          StringToJsonOut(
+              reflection.GetRepeatedEnum(message, &field, field_index)->name(),
+              element);
           break;
 
-        case FieldDescriptor::CPPTYPE_STRING:  // TYPE_STRING, TYPE_BYTES
+        case FieldDescriptor::CPPTYPE_STRING: {  // TYPE_STRING, TYPE_BYTES
+          const std::string& string_value =
+              reflection.GetRepeatedStringReference(message, &field,
+                                                    field_index, &scratch);
           if (field.type() == FieldDescriptor::TYPE_STRING) {
-            *value->add_array_elements() = MakeJsonValue(
-                reflection.GetRepeatedString(message, &field, field_index));
+            StringToJsonOut(string_value, element);
           } else {
-            *value->add_array_elements() = MakeJsonValue(WriteBase64(
-                reflection.GetRepeatedString(message, &field, field_index)));
+            BytesToJsonOut(string_value, element);
           }
           break;
+        }
 
         case FieldDescriptor::CPPTYPE_MESSAGE:  // TYPE_MESSAGE, TYPE_GROUP
           MakeJsonValueOut(
               reflection.GetRepeatedMessage(message, &field, field_index),
-              value->add_array_elements());
+              mask, element);
           break;
 
         default:
@@ -168,7 +268,8 @@ void FieldToJsonOut(const Message& message, const Reflection& reflection,
   }
 }
 
-void MakeJsonValueOut(const Message& message, JsonValue* value) {
+void MakeJsonValueOut(const Message& message, const JsonFieldMask* mask,
+                      JsonValue* value) {
   PJCORE_CHECK(value);
   value->Clear();
 
@@ -193,22 +294,30 @@ void MakeJsonValueOut(const Message& message, JsonValue* value) {
       continue;
     }
 
+    const JsonFieldMask* field_mask;
+
     if (field.is_repeated() &&
         field.cpp_type() == FieldDescriptor::CPPTYPE_MESSAGE &&
         field.message_type() == JsonValue::Property::descriptor() &&
         StringPiece(field.name()) == StringPiece(OBJECT_PROPERTIES_STR)) {
       int field_size = reflection.FieldSize(message, &field);
+      value->mutable_object_properties()->Reserve(
+          value->object_properties_size() + field_size);
       for (int index = 0; index < field_size; ++index) {
-        *value->add_object_properties() =
+        const JsonValue::Property& object_property =
             static_cast<const JsonValue::Property&>(
                 reflection.GetRepeatedMessage(message, &field, index));
+        if (SelectJsonField(mask, object_property.name(), &field_mask)) {
+          *value->add_object_properties() = object_property;
+        }
       }
-    } else {
+    } else if (SelectJsonField(mask, field.name(), &field_mask)) {
       JsonValue::Property* property = value->add_object_properties();
 
       property->set_name(field.name());
 
-      FieldToJsonOut(message, reflection, field, property->mutable_value());
+      FieldToJsonOut(message, reflection, field, field_mask,
+                     property->mutable_value());
     }
   }
 }
@@ -217,7 +326,13 @@ void MakeJsonValueOut(const Message& message, JsonValue* value) {
 
 JsonValue MakeJsonValue(const Message& message) {
   JsonValue value;
-  MakeJsonValueOut(message, &value);
+  MakeJsonValueOut(message, NULL, &value);
+  return value;
+}
+
+JsonValue MakeJsonValue(const Message& message, const JsonFieldMask& mask) {
+  JsonValue value;
+  MakeJsonValueOut(message, mask.selects_all() ? NULL : &mask, &value);
   return value;
 }
 
@@ -0,0 +1,608 @@
+// JSON [de]serialization for protobuf + embedded HTTP server and client in C++.
+// Copyright (C) 2014 http://protojson.com/
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+
+#include "pjcore/shared_json_value.h"
+
+#include <string.h>
+
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "pjcore/json_properties.h"
+#include "pjcore/json_util.h"
+#include "pjcore/logging.h"
+
+namespace pjcore {
+
+class SharedJsonValue::Node : public RefCountedThreadSafe<Node> {
+ public:
+  Node()
+      : type(JsonValue::TYPE_NULL),
+        bool_value(false),
+        signed_value(0),
+        unsigned_value(0),
+        double_value(0) {}
+
+  // Shallow: children stay shared with other.
+  Node(const Node& other)
+      : RefCountedThreadSafe<Node>(),
+        type(other.type),
+        bool_value(other.bool_value),
+        signed_value(other.signed_value),
+        unsigned_value(other.unsigned_value),
+        double_value(other.double_value),
+        string_value(other.string_value),
+        object_properties(other.object_properties),
+        array_elements(other.array_elements) {}
+
+  JsonValue::Type type;
+
+  bool bool_value;
+
+  int64_t signed_value;
+
+  uint64_t unsigned_value;
+
+  double double_value;
+
+  std::string string_value;
+
+  std::vector<std::pair<std::string, SharedJsonValue> > object_properties;
+
+  std::vector<SharedJsonValue> array_elements;
+
+ private:
+  friend class RefCountedThreadSafe<Node>;
+
+  ~Node() {}
+
+  void operator=(const Node&);
+};
+
+namespace {
+
+typedef std::vector<std::pair<std::string, SharedJsonValue> >
+    SharedPropertyList;
+
+bool IsPropertyNameLess(const SharedPropertyList::value_type& left,
+                        const SharedPropertyList::value_type& right) {
+  return left.first < right.first;
+}
+
+bool IsPropertyNameLessThan(const SharedPropertyList::value_type& property,
+                            StringPiece name) {
+  return StringPiece(property.first) < name;
+}
+
+bool IsPropertyNameEqual(const SharedPropertyList::value_type& left,
+                         const SharedPropertyList::value_type& right) {
+  return left.first == right.first;
+}
+
+// Sorts properties by name and keeps the first of duplicate names, as
+// NormalizeJsonProperties does.
+void NormalizeSharedProperties(SharedPropertyList* properties) {
+  std::stable_sort(properties->begin(), properties->end(),
+                   IsPropertyNameLess);
+  properties->erase(std::unique(properties->begin(), properties->end(),
+                                IsPropertyNameEqual),
+                    properties->end());
+}
+
+// Orders the indices of properties by name, then by index, so that the first
+// of duplicate names comes first.
+class LessByPropertyIndexName {
+ public:
+  explicit LessByPropertyIndexName(const JsonPropertyList& properties)
+      : properties_(properties) {}
+
+  bool operator()(int left, int right) const {
+    const std::string& left_name = properties_.Get(left).name();
+    const std::string& right_name = properties_.Get(right).name();
+    return left_name < right_name ||
+           (left_name == right_name && left < right);
+  }
+
+ private:
+  const JsonPropertyList& properties_;
+};
+
+class EqualToByPropertyIndexName {
+ public:
+  explicit EqualToByPropertyIndexName(const JsonPropertyList& properties)
+      : properties_(properties) {}
+
+  bool operator()(int left, int right) const {
+    return properties_.Get(left).name() == properties_.Get(right).name();
+  }
+
+ private:
+  const JsonPropertyList& properties_;
+};
+
+// Indices of the properties NormalizeJsonProperties would keep, in order.
+std::vector<int> GetNormalizedPropertyOrder(
+    const JsonPropertyList& properties) {
+  std::vector<int> order(properties.size());
+  for (int index = 0; index < properties.size(); ++index) {
+    order[index] = index;
+  }
+
+  for (int index = 1; index < properties.size(); ++index) {
+    if (!(properties.Get(index - 1).name() < properties.Get(index).name())) {
+      std::sort(order.begin(), order.end(),
+                LessByPropertyIndexName(properties));
+      order.erase(std::unique(order.begin(), order.end(),
+                              EqualToByPropertyIndexName(properties)),
+                  order.end());
+      break;
+    }
+  }
+
+  return order;
+}
+
+SharedPropertyList::const_iterator FindSharedProperty(
+    const SharedPropertyList& properties, StringPiece name) {
+  SharedPropertyList::const_iterator it = std::lower_bound(
+      properties.begin(), properties.end(), name, IsPropertyNameLessThan);
+  return it != properties.end() && StringPiece(it->first) == name
+             ? it
+             : properties.end();
+}
+
+}  // unnamed namespace
+
+SharedJsonValue::SharedJsonValue() {}
+
+SharedJsonValue::SharedJsonValue(const JsonValue& value) {
+  if (value.type() == JsonValue::TYPE_NULL) {
+    return;
+  }
+
+  Node* node = mutable_node();
+  node->type = value.type();
+  node->bool_value = value.bool_value();
+  node->signed_value = value.signed_value();
+  node->unsigned_value = value.unsigned_value();
+  node->double_value = value.double_value();
+  node->string_value = value.string_value();
+
+  node->object_properties.reserve(value.object_properties_size());
+  for (google::protobuf::RepeatedPtrField<JsonValue::Property>::const_iterator
+           it = value.object_properties().begin();
+       it != value.object_properties().end(); ++it) {
+    node->object_properties.push_back(
+        std::make_pair(it->name(), SharedJsonValue(it->value())));
+  }
+  NormalizeSharedProperties(&node->object_properties);
+
+  int array_size = GetJsonArraySize(value);
+  node->array_elements.reserve(array_size);
+  JsonValue buffer;
+  for (int index = 0; index < array_size; ++index) {
+    node->array_elements.push_back(
+        SharedJsonValue(GetJsonArrayElement(value, index, &buffer)));
+  }
+}
+
+SharedJsonValue::SharedJsonValue(JsonValue* value) {
+  PJCORE_CHECK(value);
+
+  if (value->type() == JsonValue::TYPE_NULL) {
+    value->Clear();
+    return;
+  }
+
+  UnpackJsonArray(value);
+
+  Node* node = mutable_node();
+  node->type = value->type();
+  node->bool_value = value->bool_value();
+  node->signed_value = value->signed_value();
+  node->unsigned_value = value->unsigned_value();
+  node->double_value = value->double_value();
+  node->string_value.swap(*value->mutable_string_value());
+
+  node->object_properties.resize(value->object_properties_size());
+  for (int index = 0; index < value->object_properties_size(); ++index) {
+    JsonValue::Property* property = value->mutable_object_properties(index);
+    node->object_properties[index].first.swap(*property->mutable_name());
+    node->object_properties[index].second =
+        SharedJsonValue(property->mutable_value());
+  }
+  NormalizeSharedProperties(&node->object_properties);
+
+  node->array_elements.reserve(value->array_elements_size());
+  for (int index = 0; index < value->array_elements_size(); ++index) {
+    node->array_elements.push_back(
+        SharedJsonValue(value->mutable_array_elements(index)));
+  }
+
+  value->Clear();
+}
+
+SharedJsonValue::SharedJsonValue(const SharedJsonValue& other)
+    : node_(other.node_) {}
+
+SharedJsonValue::~SharedJsonValue() {}
+
+SharedJsonValue& SharedJsonValue::operator=(const SharedJsonValue& other) {
+  node_ = other.node_;
+  return *this;
+}
+
+JsonValue::Type SharedJsonValue::type() const { return node().type; }
+
+bool SharedJsonValue::bool_value() const { return node().bool_value; }
+
+int64_t SharedJsonValue::signed_value() const { return node().signed_value; }
+
+uint64_t SharedJsonValue::unsigned_value() const {
+  return node().unsigned_value;
+}
+
+double SharedJsonValue::double_value() const { return node().double_value; }
+
+const std::string& SharedJsonValue::string_value() const {
+  return node().string_value;
+}
+
+int SharedJsonValue::object_properties_size() const {
+  return static_cast<int>(node().object_properties.size());
+}
+
+const std::string& SharedJsonValue::object_property_name(int index) const {
+  return node().object_properties.at(index).first;
+}
+
+const SharedJsonValue& SharedJsonValue::object_property_value(
+    int index) const {
+  return node().object_properties.at(index).second;
+}
+
+bool SharedJsonValue::HasProperty(StringPiece name) const {
+  PJCORE_CHECK_EQ(JsonValue::TYPE_OBJECT, type());
+
+  const SharedPropertyList& properties = node().object_properties;
+  return FindSharedProperty(properties, name) != properties.end();
+}
+
+const SharedJsonValue& SharedJsonValue::GetProperty(StringPiece name) const {
+  PJCORE_CHECK_EQ(JsonValue::TYPE_OBJECT, type());
+
+  const SharedPropertyList& properties = node().object_properties;
+  SharedPropertyList::const_iterator it = FindSharedProperty(properties, name);
+  return it != properties.end() ? it->second : SharedJsonNull();
+}
+
+int SharedJsonValue::array_elements_size() const {
+  return static_cast<int>(node().array_elements.size());
+}
+
+const SharedJsonValue& SharedJsonValue::array_elements(int index) const {
+  return node().array_elements.at(index);
+}
+
+SharedJsonValue* SharedJsonValue::MutableProperty(StringPiece name) {
+  PJCORE_CHECK_EQ(JsonValue::TYPE_OBJECT, type());
+
+  SharedPropertyList* properties = &mutable_node()->object_properties;
+  SharedPropertyList::iterator it = std::lower_bound(
+      properties->begin(), properties->end(), name, IsPropertyNameLessThan);
+  if (it == properties->end() || !(StringPiece(it->first) == name)) {
+    it = properties->insert(
+        it, std::make_pair(name.as_string(), SharedJsonValue()));
+  }
+  return &it->second;
+}
+
+void SharedJsonValue::ClearProperty(StringPiece name) {
+  PJCORE_CHECK_EQ(JsonValue::TYPE_OBJECT, type());
+
+  if (!HasProperty(name)) {
+    return;
+  }
+
+  SharedPropertyList* properties = &mutable_node()->object_properties;
+  properties->erase(std::lower_bound(properties->begin(), properties->end(),
+                                     name, IsPropertyNameLessThan));
+}
+
+SharedJsonValue* SharedJsonValue::MutableArrayElement(int index) {
+  PJCORE_CHECK_EQ(JsonValue::TYPE_ARRAY, type());
+  return &mutable_node()->array_elements.at(index);
+}
+
+SharedJsonValue* SharedJsonValue::AddArrayElement() {
+  PJCORE_CHECK_EQ(JsonValue::TYPE_ARRAY, type());
+
+  std::vector<SharedJsonValue>* elements = &mutable_node()->array_elements;
+  elements->push_back(SharedJsonValue());
+  return &elements->back();
+}
+
+bool SharedJsonValue::IsSharedWith(const SharedJsonValue& other) const {
+  return node_.get() == other.node_.get();
+}
+
+void SharedJsonValue::CopyTo(JsonValue* value) const {
+  PJCORE_CHECK(value);
+  value->Clear();
+
+  const Node& source = node();
+  value->set_type(source.type);
+
+  switch (source.type) {
+    case JsonValue::TYPE_NULL:
+      break;
+
+    case JsonValue::TYPE_BOOL:
+      value->set_bool_value(source.bool_value);
+      break;
+
+    case JsonValue::TYPE_SIGNED:
+      value->set_signed_value(source.signed_value);
+      break;
+
+    case JsonValue::TYPE_UNSIGNED:
+      value->set_unsigned_value(source.unsigned_value);
+      break;
+
+    case JsonValue::TYPE_DOUBLE:
+      value->set_double_value(source.double_value);
+      break;
+
+    case JsonValue::TYPE_STRING:
+    case JsonValue::TYPE_RAW_NUMBER:
+      value->set_string_value(source.string_value);
+      break;
+
+    case JsonValue::TYPE_OBJECT:
+      value->mutable_object_properties()->Reserve(
+          static_cast<int>(source.object_properties.size()));
+      for (size_t index = 0; index < source.object_properties.size();
+           ++index) {
+        JsonValue::Property* property = value->add_object_properties();
+        property->set_name(source.object_properties[index].first);
+        source.object_properties[index].second.CopyTo(
+            property->mutable_value());
+      }
+      break;
+
+    case JsonValue::TYPE_ARRAY:
+      value->mutable_array_elements()->Reserve(
+          static_cast<int>(source.array_elements.size()));
+      for (size_t index = 0; index < source.array_elements.size(); ++index) {
+        source.array_elements[index].CopyTo(value->add_array_elements());
+      }
+      break;
+
+    default:
+      PJCORE_CHECK(false);  // source.type
+  }
+}
+
+const SharedJsonValue::Node& SharedJsonValue::node() const {
+  if (node_.get()) {
+    return *node_;
+  }
+
+  static const Node* const null_node = new Node();
+  return *null_node;
+}
+
+SharedJsonValue::Node* SharedJsonValue::mutable_node() {
+  if (!node_.get()) {
+    node_ = new Node();
+  } else if (!node_->HasOneRef()) {
+    node_ = new Node(*node_);
+  }
+  return node_.get();
+}
+
+const SharedJsonValue& SharedJsonNull() {
+  static const SharedJsonValue* const null_value = new SharedJsonValue();
+  return *null_value;
+}
+
+SharedJsonValue MakeSharedJsonObject() {
+  return SharedJsonValue(MakeJsonObject());
+}
+
+SharedJsonValue MakeSharedJsonArray() {
+  return SharedJsonValue(MakeJsonArray());
+}
+
+JsonValue MakeJsonValue(const SharedJsonValue& value) {
+  JsonValue json_value;
+  value.CopyTo(&json_value);
+  return json_value;
+}
+
+namespace {
+
+// Compares values whose children are interned, so children match only when
+// they share nodes.
+bool AreInternedValuesSame(const SharedJsonValue& left,
+                           const SharedJsonValue& right) {
+  if (left.type() != right.type()) {
+    return false;
+  }
+
+  switch (left.type()) {
+    case JsonValue::TYPE_NULL:
+      return true;
+
+    case JsonValue::TYPE_BOOL:
+      return left.bool_value() == right.bool_value();
+
+    case JsonValue::TYPE_SIGNED:
+      return left.signed_value() == right.signed_value();
+
+    case JsonValue::TYPE_UNSIGNED:
+      return left.unsigned_value() == right.unsigned_value();
+
+    case JsonValue::TYPE_DOUBLE: {
+      // Bitwise, so that -0 and 0 are kept apart.
+      double left_double = left.double_value();
+      double right_double = right.double_value();
+      return !memcmp(&left_double, &right_double, sizeof(left_double));
+    }
+
+    case JsonValue::TYPE_STRING:
+    case JsonValue::TYPE_RAW_NUMBER:
+      return left.string_value() == right.string_value();
+
+    case JsonValue::TYPE_OBJECT:
+      if (left.object_properties_size() != right.object_properties_size()) {
+        return false;
+      }
+      for (int index = 0; index < left.object_properties_size(); ++index) {
+        if (left.object_property_name(index) !=
+                right.object_property_name(index) ||
+            !left.object_property_value(index).IsSharedWith(
+                right.object_property_value(index))) {
+          return false;
+        }
+      }
+      return true;
+
+    case JsonValue::TYPE_ARRAY:
+      if (left.array_elements_size() != right.array_elements_size()) {
+        return false;
+      }
+      for (int index = 0; index < left.array_elements_size(); ++index) {
+        if (!left.array_elements(index).IsSharedWith(
+                right.array_elements(index))) {
+          return false;
+        }
+      }
+      return true;
+
+    default:
+      PJCORE_CHECK(false);  // left.type()
+      return false;
+  }
+}
+
+}  // unnamed namespace
+
+SharedJsonValueInterner::SharedJsonValueInterner() {}
+
+SharedJsonValueInterner::~SharedJsonValueInterner() {}
+
+SharedJsonValue SharedJsonValueInterner::Intern(const JsonValue& value) {
+  uint64_t hash;
+  return InternRecursive(value, &hash);
+}
+
+void SharedJsonValueInterner::Clear() { nodes_.clear(); }
+
+SharedJsonValue SharedJsonValueInterner::InternRecursive(
+    const JsonValue& value, uint64_t* hash) {
+  if (value.type() == JsonValue::TYPE_NULL) {
+    *hash = HashJsonValue(value);
+    return SharedJsonValue();
+  }
+
+  SharedJsonValue interned;
+  SharedJsonValue::Node* node = interned.mutable_node();
+  node->type = value.type();
+
+  switch (value.type()) {
+    case JsonValue::TYPE_OBJECT: {
+      // Hashes only the properties kept, so that objects equal after
+      // normalization intern together.
+      std::vector<int> order =
+          GetNormalizedPropertyOrder(value.object_properties());
+      node->object_properties.reserve(order.size());
+      uint64_t property_hash_sum = 0;
+      for (size_t index = 0; index < order.size(); ++index) {
+        const JsonValue::Property& property =
+            value.object_properties(order[index]);
+        uint64_t value_hash;
+        node->object_properties.push_back(std::make_pair(
+            property.name(), InternRecursive(property.value(), &value_hash)));
+        property_hash_sum +=
+            HashJsonObjectProperty(property.name(), value_hash);
+      }
+      *hash = HashJsonObject(static_cast<int>(order.size()),
+                             property_hash_sum);
+      break;
+    }
+
+    case JsonValue::TYPE_ARRAY: {
+      int size = GetJsonArraySize(value);
+      node->array_elements.reserve(size);
+      std::vector<uint64_t> element_hashes(size);
+      JsonValue buffer;
+      for (int index = 0; index < size; ++index) {
+        node->array_elements.push_back(
+            InternRecursive(GetJsonArrayElement(value, index, &buffer),
+                            &element_hashes[index]));
+      }
+      *hash = HashJsonArray(size ? &element_hashes[0] : NULL, size);
+      break;
+    }
+
+    case JsonValue::TYPE_BOOL:
+      node->bool_value = value.bool_value();
+      *hash = HashJsonValue(value);
+      break;
+
+    case JsonValue::TYPE_SIGNED:
+      node->signed_value = value.signed_value();
+      *hash = HashJsonValue(value);
+      break;
+
+    case JsonValue::TYPE_UNSIGNED:
+      node->unsigned_value = value.unsigned_value();
+      *hash = HashJsonValue(value);
+      break;
+
+    case JsonValue::TYPE_DOUBLE:
+      node->double_value = value.double_value();
+      *hash = HashJsonValue(value);
+      break;
+
+    case JsonValue::TYPE_STRING:
+    case JsonValue::TYPE_RAW_NUMBER:
+      node->string_value = value.string_value();
+      *hash = HashJsonValue(value);
+      break;
+
+    default:
+      PJCORE_CHECK(false);  // value.type()
+  }
+
+  std::pair<NodeMap::const_iterator, NodeMap::const_iterator> range =
+      nodes_.equal_range(*hash);
+  for (NodeMap::const_iterator it = range.first; it != range.second; ++it) {
+    if (AreInternedValuesSame(it->second, interned)) {
+      return it->second;
+    }
+  }
+
+  nodes_.insert(std::make_pair(*hash, interned));
+  return interned;
+}
+
+}  // namespace pjcore
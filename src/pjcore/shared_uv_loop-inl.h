@@ -22,6 +22,8 @@
 
 #include <uv.h>
 
+#include "pjcore/abstract_uv.h"
+#include "pjcore/live_util.h"
 #include "pjcore/logging.h"
 #include "pjcore/live_uv.pb.h"
 #include "pjcore/shared_future-inl.h"
@@ -0,0 +1,52 @@
+// JSON [de]serialization for protobuf + embedded HTTP server and client in C++.
+// Copyright (C) 2014 http://protojson.com/
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+
+#include "pjcore/simd_level.h"
+
+namespace pjcore {
+
+#if defined(PJCORE_SIMD)
+
+namespace {
+
+SimdLevel DetectSimdLevel() {
+  __builtin_cpu_init();
+
+  if (__builtin_cpu_supports("avx2")) {
+    return SIMD_LEVEL_AVX2;
+  } else if (__builtin_cpu_supports("ssse3")) {
+    return SIMD_LEVEL_SSSE3;
+  } else {
+    return SIMD_LEVEL_NONE;
+  }
+}
+
+}  // unnamed namespace
+
+SimdLevel GetSimdLevel() {
+  static const SimdLevel level = DetectSimdLevel();
+  return level;
+}
+
+#else  // defined(PJCORE_SIMD)
+
+SimdLevel GetSimdLevel() { return SIMD_LEVEL_NONE; }
+
+#endif  // defined(PJCORE_SIMD)
+
+}  // namespace pjcore
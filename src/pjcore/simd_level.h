@@ -0,0 +1,42 @@
+// JSON [de]serialization for protobuf + embedded HTTP server and client in C++.
+// Copyright (C) 2014 http://protojson.com/
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+
+#ifndef PJCORE_SIMD_LEVEL_H_
+#define PJCORE_SIMD_LEVEL_H_
+
+#include "pjcore/third_party/chromium/build_config.h"
+
+// Kernels are compiled with per-function target attributes and selected at
+// run time, so the library itself keeps building for the baseline x86.
+#if defined(ARCH_CPU_X86_FAMILY) &&                        \
+    (defined(__clang__) ||                                 \
+     (defined(__GNUC__) &&                                 \
+      (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))))
+#define PJCORE_SIMD 1
+#endif
+
+namespace pjcore {
+
+enum SimdLevel { SIMD_LEVEL_NONE, SIMD_LEVEL_SSSE3, SIMD_LEVEL_AVX2 };
+
+// The widest vector unit the kernels may use on this CPU, detected once.
+SimdLevel GetSimdLevel();
+
+}  // namespace pjcore
+
+#endif  // PJCORE_SIMD_LEVEL_H_
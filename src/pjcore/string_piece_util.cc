@@ -19,11 +19,42 @@
 
 #include <string>
 
+#include "pjcore/base_64_simd.h"
 #include "pjcore/logging.h"
 #include "pjcore/error.pb.h"
 
 namespace pjcore {
 
+namespace {
+
+// Maps characters to Base64 digit values, or to 0xff for non-digits.
+const uint8_t kBase64DigitValues[256] = {
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x3e, 0xff, 0xff, 0xff, 0x3f,
+    0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3a, 0x3b, 0x3c, 0x3d, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06,
+    0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0x10, 0x11, 0x12,
+    0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f, 0x20, 0x21, 0x22, 0x23, 0x24,
+    0x25, 0x26, 0x27, 0x28, 0x29, 0x2a, 0x2b, 0x2c, 0x2d, 0x2e, 0x2f, 0x30,
+    0x31, 0x32, 0x33, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff,
+};
+
+}  // unnamed namespace
+
 StringPiece MemMove(void* target, StringPiece source) {
   return StringPiece(
       static_cast<char*>(memmove(target, source.data(), source.size())),
@@ -109,42 +140,50 @@ bool ReadHexBlob(StringPiece hex_blob, std::string* binary, Error* error) {
 
 std::string WriteBase64(StringPiece binary) {
   std::string base_64((binary.length() + 2) / 3 * 4, '\0');
+  if (binary.empty()) {
+    return base_64;
+  }
 
   const uint8_t* bytes = reinterpret_cast<const uint8_t*>(binary.data());
-
-  size_t segment;
-  for (segment = 0; segment < binary.length() / 3; ++segment) {
-    uint32_t value = (static_cast<uint32_t>(bytes[segment * 3]) << 16) |
-                     (static_cast<uint32_t>(bytes[segment * 3 + 1]) << 8) |
-                     static_cast<uint32_t>(bytes[segment * 3 + 2]);
-    base_64[segment * 4] = WriteBase64Digit(value >> 18);
-    base_64[segment * 4 + 1] = WriteBase64Digit((value >> 12) & 0x3f);
-    base_64[segment * 4 + 2] = WriteBase64Digit((value >> 6) & 0x3f);
-    base_64[segment * 4 + 3] = WriteBase64Digit(value & 0x3f);
+  const uint8_t* bytes_end = bytes + binary.length();
+  char* digits = &base_64[0];
+
+  size_t vector_length = WriteBase64Simd(bytes, binary.length(), digits);
+  bytes += vector_length;
+  digits += vector_length / 3 * 4;
+
+  for (; bytes_end - bytes >= 3; bytes += 3, digits += 4) {
+    uint32_t value = (static_cast<uint32_t>(bytes[0]) << 16) |
+                     (static_cast<uint32_t>(bytes[1]) << 8) |
+                     static_cast<uint32_t>(bytes[2]);
+    digits[0] = WriteBase64Digit(value >> 18);
+    digits[1] = WriteBase64Digit((value >> 12) & 0x3f);
+    digits[2] = WriteBase64Digit((value >> 6) & 0x3f);
+    digits[3] = WriteBase64Digit(value & 0x3f);
   }
 
-  switch (binary.length() % 3) {
+  switch (bytes_end - bytes) {
     case 0:
       break;
 
     case 1: {
-      uint32_t value = (static_cast<uint32_t>(bytes[segment * 3]) << 16);
-      base_64[segment * 4] = WriteBase64Digit(value >> 18);
-      base_64[segment * 4 + 1] = WriteBase64Digit((value >> 12) & 0x3f);
-      base_64[segment * 4 + 2] = '=';
-      base_64[segment * 4 + 3] = '=';
+      uint32_t value = (static_cast<uint32_t>(bytes[0]) << 16);
+      digits[0] = WriteBase64Digit(value >> 18);
+      digits[1] = WriteBase64Digit((value >> 12) & 0x3f);
+      digits[2] = '=';
+      digits[3] = '=';
       break;
     }
 
     case 2: {
-      uint32_t value = (static_cast<uint32_t>(bytes[segment * 3]) << 16) |
-                       (static_cast<uint32_t>(bytes[segment * 3 + 1]) << 8);
-      base_64[segment * 4] = WriteBase64Digit(value >> 18);
-      base_64[segment * 4 + 1] = WriteBase64Digit((value >> 12) & 0x3f);
-      base_64[segment * 4 + 2] = WriteBase64Digit((value >> 6) & 0x3f);
-      base_64[segment * 4 + 3] = '=';
+      uint32_t value = (static_cast<uint32_t>(bytes[0]) << 16) |
+                       (static_cast<uint32_t>(bytes[1]) << 8);
+      digits[0] = WriteBase64Digit(value >> 18);
+      digits[1] = WriteBase64Digit((value >> 12) & 0x3f);
+      digits[2] = WriteBase64Digit((value >> 6) & 0x3f);
+      digits[3] = '=';
       break;
-    } break;
+    }
   }
 
   return base_64;
@@ -163,27 +202,34 @@ bool ReadBase64(StringPiece base_64, std::string* binary, Error* error) {
     padding_length = (base_64[base_64.length() - 2] == '=') ? 2 : 1;
   }
 
-  binary->assign((base_64.length() + 3) / 4 * 3 - padding_length, '\0');
-
-  size_t segment;
-  for (segment = 0; segment < binary->length() / 3; ++segment) {
-    PJCORE_REQUIRE(IsBase64Digit::eval(base_64[segment * 4]) &&
-                       IsBase64Digit::eval(base_64[segment * 4 + 1]) &&
-                       IsBase64Digit::eval(base_64[segment * 4 + 2]) &&
-                       IsBase64Digit::eval(base_64[segment * 4 + 3]),
-                   "Invalid Base64 digit");
-
-    uint32_t value =
-        (static_cast<uint32_t>(ReadBase64Digit(base_64[segment * 4])) << 18) |
-        (static_cast<uint32_t>(ReadBase64Digit(base_64[segment * 4 + 1]))
-         << 12) |
-        (static_cast<uint32_t>(ReadBase64Digit(base_64[segment * 4 + 2]))
-         << 6) |
-        static_cast<uint32_t>(ReadBase64Digit(base_64[segment * 4 + 3]));
-
-    (*binary)[segment * 3] = static_cast<char>(value >> 16);
-    (*binary)[segment * 3 + 1] = static_cast<char>((value >> 8) & 0xff);
-    (*binary)[segment * 3 + 2] = static_cast<char>(value & 0xff);
+  binary->resize(base_64.length() / 4 * 3 - padding_length);
+  if (base_64.empty()) {
+    return true;
+  }
+
+  const uint8_t* digits = reinterpret_cast<const uint8_t*>(base_64.data());
+  uint8_t* bytes = reinterpret_cast<uint8_t*>(&(*binary)[0]);
+
+  // The last segment is decoded separately when padded.
+  size_t full_length = base_64.length() - (padding_length ? 4 : 0);
+  const uint8_t* full_end = digits + full_length;
+
+  size_t vector_length = ReadBase64Simd(base_64.data(), full_length, bytes);
+  digits += vector_length;
+  bytes += vector_length / 4 * 3;
+
+  for (; digits != full_end; digits += 4, bytes += 3) {
+    uint32_t a = kBase64DigitValues[digits[0]];
+    uint32_t b = kBase64DigitValues[digits[1]];
+    uint32_t c = kBase64DigitValues[digits[2]];
+    uint32_t d = kBase64DigitValues[digits[3]];
+    PJCORE_REQUIRE(((a | b | c | d) & 0x80) == 0, "Invalid Base64 digit");
+
+    uint32_t value = (a << 18) | (b << 12) | (c << 6) | d;
+
+    bytes[0] = static_cast<uint8_t>(value >> 16);
+    bytes[1] = static_cast<uint8_t>((value >> 8) & 0xff);
+    bytes[2] = static_cast<uint8_t>(value & 0xff);
   }
 
   switch (padding_length) {
@@ -191,35 +237,27 @@ bool ReadBase64(StringPiece base_64, std::string* binary, Error* error) {
       break;
 
     case 1: {
-      PJCORE_REQUIRE(IsBase64Digit::eval(base_64[segment * 4]) &&
-                         IsBase64Digit::eval(base_64[segment * 4 + 1]) &&
-                         IsBase64Digit::eval(base_64[segment * 4 + 2]),
-                     "Invalid Base64 digit");
-
-      uint32_t value =
-          (static_cast<uint32_t>(ReadBase64Digit(base_64[segment * 4])) << 18) |
-          (static_cast<uint32_t>(ReadBase64Digit(base_64[segment * 4 + 1]))
-           << 12) |
-          (static_cast<uint32_t>(ReadBase64Digit(base_64[segment * 4 + 2]))
-           << 6);
-
-      (*binary)[segment * 3] = static_cast<char>(value >> 16);
-      (*binary)[segment * 3 + 1] = static_cast<char>((value >> 8) & 0xff);
+      uint32_t a = kBase64DigitValues[digits[0]];
+      uint32_t b = kBase64DigitValues[digits[1]];
+      uint32_t c = kBase64DigitValues[digits[2]];
+      PJCORE_REQUIRE(((a | b | c) & 0x80) == 0, "Invalid Base64 digit");
+
+      uint32_t value = (a << 18) | (b << 12) | (c << 6);
+
+      bytes[0] = static_cast<uint8_t>(value >> 16);
+      bytes[1] = static_cast<uint8_t>((value >> 8) & 0xff);
       PJCORE_REQUIRE((value & 0xff) == 0, "Non-zero Base64 trailing sequence");
       break;
     }
 
     case 2: {
-      PJCORE_REQUIRE(IsBase64Digit::eval(base_64[segment * 4]) &&
-                         IsBase64Digit::eval(base_64[segment * 4 + 1]),
-                     "Invalid Base64 digit");
+      uint32_t a = kBase64DigitValues[digits[0]];
+      uint32_t b = kBase64DigitValues[digits[1]];
+      PJCORE_REQUIRE(((a | b) & 0x80) == 0, "Invalid Base64 digit");
 
-      uint32_t value =
-          (static_cast<uint32_t>(ReadBase64Digit(base_64[segment * 4])) << 18) |
-          (static_cast<uint32_t>(ReadBase64Digit(base_64[segment * 4 + 1]))
-           << 12);
+      uint32_t value = (a << 18) | (b << 12);
 
-      (*binary)[segment * 3] = static_cast<char>(value >> 16);
+      bytes[0] = static_cast<uint8_t>(value >> 16);
       PJCORE_REQUIRE(((value >> 8) & 0xff) == 0,
                      "Non-zero Base64 trailing sequence");
       PJCORE_REQUIRE((value & 0xff) == 0, "Non-zero Base64 trailing sequence");
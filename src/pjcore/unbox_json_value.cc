@@ -19,6 +19,8 @@
 
 #include <limits>
 
+#include "pjcore/json_tokenizer.h"
+#include "pjcore/json_util.h"
 #include "pjcore/logging.h"
 #include "pjcore/number_util.h"
 
@@ -32,8 +34,20 @@
 
 namespace pjcore {
 
-bool UnboxJsonValue(const JsonValue& json_value, bool* bool_value,
-                    Error* error) {
+namespace {
+
+template <typename Source>
+bool UnboxSource(const Source& json_value, int64_t* signed_value, Error* error);
+
+template <typename Source>
+bool UnboxSource(const Source& json_value, uint64_t* unsigned_value,
+                 Error* error);
+
+template <typename Source>
+bool UnboxSource(const Source& json_value, double* double_value, Error* error);
+
+template <typename Source>
+bool UnboxSource(const Source& json_value, bool* bool_value, Error* error) {
   PJCORE_CHECK(bool_value);
   *bool_value = false;
   PJCORE_CHECK(error);
@@ -61,20 +75,28 @@ bool UnboxJsonValue(const JsonValue& json_value, bool* bool_value,
       *bool_value = json_value.bool_value();
       return true;
 
+    case JsonValue::TYPE_RAW_NUMBER: {
+      JsonValue number;
+      PJCORE_REQUIRE(ReadJsonRawNumber(json_value.string_value(), &number),
+                     "Invalid raw number");
+      return UnboxSource(number, bool_value, error);
+    }
+
     default:
       PJCORE_FAIL("Type not mapped to bool");
   }
 }
 
-bool UnboxJsonValue(const JsonValue& json_value, int32_t* signed_value,
-                    Error* error) {
+template <typename Source>
+bool UnboxSource(const Source& json_value, int32_t* signed_value,
+                 Error* error) {
   PJCORE_CHECK(signed_value);
   *signed_value = 0;
   PJCORE_CHECK(error);
   error->Clear();
 
   int64_t candidate;
-  PJCORE_REQUIRE_SILENT(UnboxJsonValue(json_value, &candidate, error),
+  PJCORE_REQUIRE_SILENT(UnboxSource(json_value, &candidate, error),
                         "Invalid value for int64_t");
 
   PJCORE_REQUIRE(candidate <= std::numeric_limits<int32_t>::max(),
@@ -87,8 +109,9 @@ bool UnboxJsonValue(const JsonValue& json_value, int32_t* signed_value,
   return true;
 }
 
-bool UnboxJsonValue(const JsonValue& json_value, int64_t* signed_value,
-                    Error* error) {
+template <typename Source>
+bool UnboxSource(const Source& json_value, int64_t* signed_value,
+                 Error* error) {
   PJCORE_CHECK(signed_value);
   *signed_value = 0;
   PJCORE_CHECK(error);
@@ -137,38 +160,29 @@ bool UnboxJsonValue(const JsonValue& json_value, int64_t* signed_value,
       *signed_value = json_value.bool_value() ? 1 : 0;
       return true;
 
+    case JsonValue::TYPE_RAW_NUMBER: {
+      JsonValue number;
+      PJCORE_REQUIRE(ReadJsonRawNumber(json_value.string_value(), &number),
+                     "Invalid raw number");
+      return UnboxSource(number, signed_value, error);
+    }
+
     default:
       PJCORE_FAIL("Type not mapped to int64_t");
   }
   return true;
 }
 
-#ifdef PJCORE_DISTINCT_LONG_LONG
-bool UnboxJsonValue(const JsonValue& json_value,
-                    long long int* signed_value,  // NOLINT(runtime/int)
-                    Error* error) {
-  PJCORE_CHECK(signed_value);
-  *signed_value = 0;
-
-  int64_t candidate;
-  PJCORE_REQUIRE_SILENT(UnboxJsonValue(json_value, &candidate, error),
-                        "Invalid value for int64_t");
-
-  *signed_value = static_cast<long long int>(  // NOLINT(runtime/int)
-      candidate);
-  return true;
-}
-#endif  // PJCORE_DISTINCT_LONG_LONG
-
-bool UnboxJsonValue(const JsonValue& json_value, uint32_t* unsigned_value,
-                    Error* error) {
+template <typename Source>
+bool UnboxSource(const Source& json_value, uint32_t* unsigned_value,
+                 Error* error) {
   PJCORE_CHECK(unsigned_value);
   *unsigned_value = 0;
   PJCORE_CHECK(error);
   error->Clear();
 
   uint64_t candidate;
-  PJCORE_REQUIRE_SILENT(UnboxJsonValue(json_value, &candidate, error),
+  PJCORE_REQUIRE_SILENT(UnboxSource(json_value, &candidate, error),
                         "Invalid value for uint64_t");
 
   PJCORE_REQUIRE(candidate <= std::numeric_limits<uint32_t>::max(),
@@ -178,8 +192,9 @@ bool UnboxJsonValue(const JsonValue& json_value, uint32_t* unsigned_value,
   return true;
 }
 
-bool UnboxJsonValue(const JsonValue& json_value, uint64_t* unsigned_value,
-                    Error* error) {
+template <typename Source>
+bool UnboxSource(const Source& json_value, uint64_t* unsigned_value,
+                 Error* error) {
   PJCORE_CHECK(unsigned_value);
   *unsigned_value = 0;
   PJCORE_CHECK(error);
@@ -221,46 +236,35 @@ bool UnboxJsonValue(const JsonValue& json_value, uint64_t* unsigned_value,
       *unsigned_value = json_value.bool_value() ? 1 : 0;
       return true;
 
+    case JsonValue::TYPE_RAW_NUMBER: {
+      JsonValue number;
+      PJCORE_REQUIRE(ReadJsonRawNumber(json_value.string_value(), &number),
+                     "Invalid raw number");
+      return UnboxSource(number, unsigned_value, error);
+    }
+
     default:
       PJCORE_FAIL("Type not mapped to uint64_t");
   }
 }
 
-#ifdef PJCORE_DISTINCT_LONG_LONG
-bool UnboxJsonValue(const JsonValue& json_value,
-                    long long unsigned int*  // NOLINT(runtime/int)
-                    unsigned_value,
-                    Error* error) {
-  PJCORE_CHECK(unsigned_value);
-  *unsigned_value = 0;
-
-  uint64_t candidate;
-  PJCORE_REQUIRE_SILENT(UnboxJsonValue(json_value, &candidate, error),
-                        "Invalid value for uint64_t");
-
-  *unsigned_value = static_cast<long long unsigned int>(  // NOLINT(runtime/int)
-      candidate);
-  return true;
-}
-#endif  // PJCORE_DISTINCT_LONG_LONG
-
-bool UnboxJsonValue(const JsonValue& json_value, float* float_value,
-                    Error* error) {
+template <typename Source>
+bool UnboxSource(const Source& json_value, float* float_value, Error* error) {
   PJCORE_CHECK(float_value);
   *float_value = 0;
   PJCORE_CHECK(error);
   error->Clear();
 
   double candidate;
-  PJCORE_REQUIRE_SILENT(UnboxJsonValue(json_value, &candidate, error),
+  PJCORE_REQUIRE_SILENT(UnboxSource(json_value, &candidate, error),
                         "Invalid value for double");
 
   *float_value = static_cast<float>(candidate);
   return true;
 }
 
-bool UnboxJsonValue(const JsonValue& json_value, double* double_value,
-                    Error* error) {
+template <typename Source>
+bool UnboxSource(const Source& json_value, double* double_value, Error* error) {
   PJCORE_CHECK(double_value);
   *double_value = 0;
   PJCORE_CHECK(error);
@@ -288,13 +292,21 @@ bool UnboxJsonValue(const JsonValue& json_value, double* double_value,
       *double_value = json_value.bool_value() ? 1 : 0;
       return true;
 
+    case JsonValue::TYPE_RAW_NUMBER: {
+      JsonValue number;
+      PJCORE_REQUIRE(ReadJsonRawNumber(json_value.string_value(), &number),
+                     "Invalid raw number");
+      return UnboxSource(number, double_value, error);
+    }
+
     default:
       PJCORE_FAIL("Type not mapped to double");
   }
 }
 
-bool UnboxJsonValue(const JsonValue& json_value, std::string* string_value,
-                    Error* error) {
+template <typename Source>
+bool UnboxSource(const Source& json_value, std::string* string_value,
+                 Error* error) {
   PJCORE_CHECK(string_value);
   string_value->clear();
   PJCORE_CHECK(error);
@@ -310,6 +322,123 @@ bool UnboxJsonValue(const JsonValue& json_value, std::string* string_value,
   }
 }
 
+}  // unnamed namespace
+
+bool UnboxJsonValue(const JsonValue& json_value, bool* bool_value,
+                    Error* error) {
+  return UnboxSource(json_value, bool_value, error);
+}
+
+bool UnboxJsonValue(const JsonTokenizer& tokenizer, bool* bool_value,
+                    Error* error) {
+  return UnboxSource(tokenizer, bool_value, error);
+}
+
+bool UnboxJsonValue(const JsonValue& json_value, int32_t* signed_value,
+                    Error* error) {
+  return UnboxSource(json_value, signed_value, error);
+}
+
+bool UnboxJsonValue(const JsonTokenizer& tokenizer, int32_t* signed_value,
+                    Error* error) {
+  return UnboxSource(tokenizer, signed_value, error);
+}
+
+bool UnboxJsonValue(const JsonValue& json_value, int64_t* signed_value,
+                    Error* error) {
+  return UnboxSource(json_value, signed_value, error);
+}
+
+bool UnboxJsonValue(const JsonTokenizer& tokenizer, int64_t* signed_value,
+                    Error* error) {
+  return UnboxSource(tokenizer, signed_value, error);
+}
+
+#ifdef PJCORE_DISTINCT_LONG_LONG
+bool UnboxJsonValue(const JsonValue& json_value,
+                    long long int* signed_value,  // NOLINT(runtime/int)
+                    Error* error) {
+  PJCORE_CHECK(signed_value);
+  *signed_value = 0;
+
+  int64_t candidate;
+  PJCORE_REQUIRE_SILENT(UnboxJsonValue(json_value, &candidate, error),
+                        "Invalid value for int64_t");
+
+  *signed_value = static_cast<long long int>(  // NOLINT(runtime/int)
+      candidate);
+  return true;
+}
+#endif  // PJCORE_DISTINCT_LONG_LONG
+
+bool UnboxJsonValue(const JsonValue& json_value, uint32_t* unsigned_value,
+                    Error* error) {
+  return UnboxSource(json_value, unsigned_value, error);
+}
+
+bool UnboxJsonValue(const JsonTokenizer& tokenizer, uint32_t* unsigned_value,
+                    Error* error) {
+  return UnboxSource(tokenizer, unsigned_value, error);
+}
+
+bool UnboxJsonValue(const JsonValue& json_value, uint64_t* unsigned_value,
+                    Error* error) {
+  return UnboxSource(json_value, unsigned_value, error);
+}
+
+bool UnboxJsonValue(const JsonTokenizer& tokenizer, uint64_t* unsigned_value,
+                    Error* error) {
+  return UnboxSource(tokenizer, unsigned_value, error);
+}
+
+#ifdef PJCORE_DISTINCT_LONG_LONG
+bool UnboxJsonValue(const JsonValue& json_value,
+                    long long unsigned int*  // NOLINT(runtime/int)
+                    unsigned_value,
+                    Error* error) {
+  PJCORE_CHECK(unsigned_value);
+  *unsigned_value = 0;
+
+  uint64_t candidate;
+  PJCORE_REQUIRE_SILENT(UnboxJsonValue(json_value, &candidate, error),
+                        "Invalid value for uint64_t");
+
+  *unsigned_value = static_cast<long long unsigned int>(  // NOLINT(runtime/int)
+      candidate);
+  return true;
+}
+#endif  // PJCORE_DISTINCT_LONG_LONG
+
+bool UnboxJsonValue(const JsonValue& json_value, float* float_value,
+                    Error* error) {
+  return UnboxSource(json_value, float_value, error);
+}
+
+bool UnboxJsonValue(const JsonTokenizer& tokenizer, float* float_value,
+                    Error* error) {
+  return UnboxSource(tokenizer, float_value, error);
+}
+
+bool UnboxJsonValue(const JsonValue& json_value, double* double_value,
+                    Error* error) {
+  return UnboxSource(json_value, double_value, error);
+}
+
+bool UnboxJsonValue(const JsonTokenizer& tokenizer, double* double_value,
+                    Error* error) {
+  return UnboxSource(tokenizer, double_value, error);
+}
+
+bool UnboxJsonValue(const JsonValue& json_value, std::string* string_value,
+                    Error* error) {
+  return UnboxSource(json_value, string_value, error);
+}
+
+bool UnboxJsonValue(const JsonTokenizer& tokenizer, std::string* string_value,
+                    Error* error) {
+  return UnboxSource(tokenizer, string_value, error);
+}
+
 bool UnboxJsonValue(const JsonValue& json_value, JsonValue* json_value_copy,
                     Error* error) {
   PJCORE_CHECK(json_value_copy);
@@ -17,6 +17,8 @@
 
 #include "pjcore/unbox_json_value.h"
 
+#include "pjcore/json_field_mask.h"
+#include "pjcore/json_util.h"
 #include "pjcore/logging.h"
 #include "pjcore/make_json_value.h"
 #include "pjcore/number_util.h"
@@ -35,6 +37,18 @@ using google::protobuf::RepeatedPtrField;
 
 namespace {
 
+bool UnboxMessage(const JsonValue& json_value,
+                  google::protobuf::Message* message, Error* error,
+                  const JsonFieldMask* mask,
+                  google::protobuf::RepeatedPtrField<JsonValue::Property>*
+                      unknown_object_properties);
+
+bool ConsumeMessage(JsonValue* consumed_json_value,
+                    google::protobuf::Message* message, Error* error,
+                    const JsonFieldMask* mask,
+                    google::protobuf::RepeatedPtrField<JsonValue::Property>*
+                        unknown_object_properties);
+
 bool UnboxEnum(const JsonValue& json_value, const FieldDescriptor& field,
                const google::protobuf::EnumValueDescriptor** enum_value,
                Error* error) {
@@ -67,9 +81,30 @@ bool UnboxEnum(const JsonValue& json_value, const FieldDescriptor& field,
   }
 }
 
+template <typename Number>
+bool UnboxRepeatedNumbers(const JsonValue& json_value,
+                          google::protobuf::RepeatedField<Number>* numbers,
+                          const char* failure_description, Error* error) {
+  int size = GetJsonArraySize(json_value);
+  numbers->Reserve(numbers->size() + size);
+
+  JsonValue buffer;
+  for (int index = 0; index < size; ++index) {
+    Number unboxed;
+    PJCORE_REQUIRE_SILENT(
+        UnboxJsonValue(GetJsonArrayElement(json_value, index, &buffer),
+                       &unboxed, error),
+        failure_description);
+    numbers->AddAlreadyReserved(unboxed);
+  }
+
+  return true;
+}
+
 bool UnboxField(const JsonValue& json_value, const Reflection& reflection,
                 const FieldDescriptor& field,
                 google::protobuf::Message* message, Error* error,
+                const JsonFieldMask* mask,
                 google::protobuf::RepeatedPtrField<JsonValue::Property>*
                     unknown_object_properties) {
   PJCORE_CHECK(message);
@@ -169,9 +204,9 @@ bool UnboxField(const JsonValue& json_value, const Reflection& reflection,
       } break;
 
       case FieldDescriptor::CPPTYPE_MESSAGE:  // TYPE_MESSAGE, TYPE_GROUP
-        PJCORE_REQUIRE(UnboxJsonValue(json_value, reflection.MutableMessage(
-                                                      message, &field),
-                                      error, unknown_object_properties),
+        PJCORE_REQUIRE(UnboxMessage(json_value,
+                                    reflection.MutableMessage(message, &field),
+                                    error, mask, unknown_object_properties),
                        "Failed to unbox message");
         break;
 
@@ -180,70 +215,64 @@ bool UnboxField(const JsonValue& json_value, const Reflection& reflection,
     }
   } else {
     if (json_value.type() == JsonValue::TYPE_ARRAY) {
-      for (google::protobuf::RepeatedPtrField<JsonValue>::const_iterator it =
-               json_value.array_elements().begin();
-           it != json_value.array_elements().end(); ++it) {
-        switch (field.cpp_type()) {
-          case FieldDescriptor::CPPTYPE_INT32:  // TYPE_INT32, TYPE_SINT32,
-                                                // TYPE_SFIXED32
-            {
-              int32_t unboxed;
-              PJCORE_REQUIRE_SILENT(UnboxJsonValue(*it, &unboxed, error),
-                                    "Failed to unbox int32_t");
-              reflection.AddInt32(message, &field, unboxed);
-            }
-            break;
-
-          case FieldDescriptor::CPPTYPE_INT64:  // TYPE_INT64, TYPE_SINT64,
-                                                // TYPE_SFIXED64
-            {
-              int64_t unboxed;
-              PJCORE_REQUIRE_SILENT(UnboxJsonValue(*it, &unboxed, error),
-                                    "Failed to unbox int64_t");
-              reflection.AddInt64(message, &field, unboxed);
-            }
-            break;
-
-          case FieldDescriptor::CPPTYPE_UINT32:  // TYPE_UINT32, TYPE_FIXED32
-          {
-            uint32_t unboxed;
-            PJCORE_REQUIRE_SILENT(UnboxJsonValue(*it, &unboxed, error),
-                                  "Failed to unbox uint32_t");
-            reflection.AddUInt32(message, &field, unboxed);
-          } break;
-
-          case FieldDescriptor::CPPTYPE_UINT64:  // TYPE_UINT64, TYPE_FIXED64
-          {
-            uint64_t unboxed;
-            PJCORE_REQUIRE_SILENT(UnboxJsonValue(*it, &unboxed, error),
-                                  "Failed to unbox uint64_t");
-            reflection.AddUInt64(message, &field, unboxed);
-          } break;
-
-          case FieldDescriptor::CPPTYPE_DOUBLE:  // TYPE_DOUBLE
-          {
-            double unboxed;
-            PJCORE_REQUIRE_SILENT(UnboxJsonValue(*it, &unboxed, error),
-                                  "Failed to unbox double");
-            reflection.AddDouble(message, &field, unboxed);
-          } break;
-
-          case FieldDescriptor::CPPTYPE_FLOAT:  // TYPE_FLOAT
-          {
-            float unboxed;
-            PJCORE_REQUIRE_SILENT(UnboxJsonValue(*it, &unboxed, error),
-                                  "Failed to unbox float");
-            reflection.AddFloat(message, &field, unboxed);
-          } break;
-
-          case FieldDescriptor::CPPTYPE_BOOL:  // TYPE_BOOL
-          {
-            bool unboxed;
-            PJCORE_REQUIRE_SILENT(UnboxJsonValue(*it, &unboxed, error),
-                                  "Failed to unbox bool");
-            reflection.AddBool(message, &field, unboxed);
-          } break;
+      switch (field.cpp_type()) {
+        case FieldDescriptor::CPPTYPE_INT32:  // TYPE_INT32, TYPE_SINT32,
+                                              // TYPE_SFIXED32
+          return UnboxRepeatedNumbers(
+              json_value,
+              reflection.MutableRepeatedField<google::protobuf::int32>(
+                  message, &field),
+              "Failed to unbox int32_t", error);
+
+        case FieldDescriptor::CPPTYPE_INT64:  // TYPE_INT64, TYPE_SINT64,
+                                              // TYPE_SFIXED64
+          return UnboxRepeatedNumbers(
+              json_value,
+              reflection.MutableRepeatedField<google::protobuf::int64>(
+                  message, &field),
+              "Failed to unbox int64_t", error);
+
+        case FieldDescriptor::CPPTYPE_UINT32:  // TYPE_UINT32, TYPE_FIXED32
+          return UnboxRepeatedNumbers(
+              json_value,
+              reflection.MutableRepeatedField<google::protobuf::uint32>(
+                  message, &field),
+              "Failed to unbox uint32_t", error);
+
+        case FieldDescriptor::CPPTYPE_UINT64:  // TYPE_UINT64, TYPE_FIXED64
+          return UnboxRepeatedNumbers(
+              json_value,
+              reflection.MutableRepeatedField<google::protobuf::uint64>(
+                  message, &field),
+              "Failed to unbox uint64_t", error);
+
+        case FieldDescriptor::CPPTYPE_DOUBLE:  // TYPE_DOUBLE
+          return UnboxRepeatedNumbers(
+              json_value, reflection.MutableRepeatedField<double>(message,
+                                                                  &field),
+              "Failed to unbox double", error);
+
+        case FieldDescriptor::CPPTYPE_FLOAT:  // TYPE_FLOAT
+          return UnboxRepeatedNumbers(
+              json_value, reflection.MutableRepeatedField<float>(message,
+                                                                 &field),
+              "Failed to unbox float", error);
+
+        case FieldDescriptor::CPPTYPE_BOOL:  // TYPE_BOOL
+          return UnboxRepeatedNumbers(
+              json_value, reflection.MutableRepeatedField<bool>(message,
+                                                                &field),
+              "Failed to unbox bool", error);
+
+        default:
+          break;
+      }
 
+      int size = GetJsonArraySize(json_value);
+      JsonValue buffer;
+      for (int index = 0; index < size; ++index) {
+        const JsonValue* it = &GetJsonArrayElement(json_value, index, &buffer);
+        switch (field.cpp_type()) {
           case FieldDescriptor::CPPTYPE_ENUM:  // TYPE_ENUM
           {
             const google::protobuf::EnumValueDescriptor* unboxed;
@@ -272,8 +301,8 @@ bool UnboxField(const JsonValue& json_value, const Reflection& reflection,
 
           case FieldDescriptor::CPPTYPE_MESSAGE:  // TYPE_MESSAGE, TYPE_GROUP
             PJCORE_REQUIRE(
-                UnboxJsonValue(*it, reflection.AddMessage(message, &field),
-                               error, unknown_object_properties),
+                UnboxMessage(*it, reflection.AddMessage(message, &field), error,
+                             mask, unknown_object_properties),
                 "Failed to unbox message");
             break;
 
@@ -304,12 +333,18 @@ bool UnboxField(const JsonValue& json_value, const Reflection& reflection,
         google::protobuf::Message* target =
             reflection.AddMessage(message, &field);
 
-        PJCORE_REQUIRE_SILENT(UnboxJsonValue(it->value(), target, error),
-                              "Failed to parse message JSON");
+        PJCORE_REQUIRE_SILENT(
+            UnboxMessage(it->value(), target, error, mask, NULL),
+            "Failed to parse message JSON");
+
+        const JsonFieldMask* name_mask;
+        if (!SelectJsonField(mask, repeated_name_field->name(), &name_mask)) {
+          continue;
+        }
 
         PJCORE_REQUIRE_SILENT(
             UnboxField(MakeJsonValue(it->name()), *target->GetReflection(),
-                       *repeated_name_field, target, error,
+                       *repeated_name_field, target, error, name_mask,
                        unknown_object_properties),
             "Failed to parse field JSON");
       }
@@ -320,12 +355,137 @@ bool UnboxField(const JsonValue& json_value, const Reflection& reflection,
   return true;
 }
 
-}  // unnamed namespace
+bool ConsumeString(JsonValue* json_value, const FieldDescriptor& field,
+                   std::string* unboxed, Error* error) {
+  PJCORE_CHECK(json_value);
+  PJCORE_CHECK(unboxed);
+  PJCORE_CHECK(error);
 
-bool UnboxJsonValue(const JsonValue& json_value,
-                    google::protobuf::Message* message, Error* error,
-                    google::protobuf::RepeatedPtrField<JsonValue::Property>*
-                        unknown_object_properties) {
+  if (json_value->type() != JsonValue::TYPE_STRING) {
+    PJCORE_REQUIRE_SILENT(UnboxJsonValue(*json_value, unboxed, error),
+                          "Failed to unbox string");
+    if (field.type() == FieldDescriptor::TYPE_STRING) {
+      return true;
+    }
+    json_value->set_type(JsonValue::TYPE_STRING);
+    unboxed->swap(*json_value->mutable_string_value());
+  }
+
+  if (field.type() == FieldDescriptor::TYPE_STRING) {
+    unboxed->swap(*json_value->mutable_string_value());
+  } else {
+    PJCORE_REQUIRE_SILENT(
+        ReadBase64(json_value->string_value(), unboxed, error),
+        "Invalid Base64");
+  }
+
+  return true;
+}
+
+bool ConsumeField(JsonValue* json_value, const Reflection& reflection,
+                  const FieldDescriptor& field,
+                  google::protobuf::Message* message, Error* error,
+                  const JsonFieldMask* mask,
+                  google::protobuf::RepeatedPtrField<JsonValue::Property>*
+                      unknown_object_properties) {
+  PJCORE_CHECK(json_value);
+  PJCORE_CHECK(message);
+  PJCORE_CHECK(error);
+
+  if (json_value->type() == JsonValue::TYPE_NULL ||
+      (field.cpp_type() != FieldDescriptor::CPPTYPE_STRING &&
+       field.cpp_type() != FieldDescriptor::CPPTYPE_MESSAGE)) {
+    return UnboxField(*json_value, reflection, field, message, error, mask,
+                      unknown_object_properties);
+  }
+
+  if (!field.is_repeated()) {
+    if (field.cpp_type() == FieldDescriptor::CPPTYPE_STRING) {
+      // Reflection offers no mutable access to a singular string, so the
+      // unboxed string is copied once here.
+      std::string unboxed;
+      PJCORE_REQUIRE_SILENT(ConsumeString(json_value, field, &unboxed, error),
+                            "Failed to unbox string");
+      reflection.SetString(message, &field, unboxed);
+    } else {
+      PJCORE_REQUIRE(
+          ConsumeMessage(json_value, reflection.MutableMessage(message, &field),
+                         error, mask, unknown_object_properties),
+          "Failed to unbox message");
+    }
+    return true;
+  }
+
+  if (json_value->type() == JsonValue::TYPE_ARRAY) {
+    UnpackJsonArray(json_value);
+    for (google::protobuf::RepeatedPtrField<JsonValue>::iterator it =
+             json_value->mutable_array_elements()->begin();
+         it != json_value->mutable_array_elements()->end(); ++it) {
+      if (field.cpp_type() == FieldDescriptor::CPPTYPE_STRING) {
+        google::protobuf::RepeatedPtrField<std::string>* repeated =
+            reflection.MutableRepeatedPtrField<std::string>(message, &field);
+        if (!ConsumeString(&*it, field, repeated->Add(), error)) {
+          repeated->RemoveLast();
+          PJCORE_FAIL_SILENT("Failed to unbox string");
+        }
+      } else {
+        PJCORE_REQUIRE(
+            ConsumeMessage(&*it, reflection.AddMessage(message, &field), error,
+                           mask, unknown_object_properties),
+            "Failed to unbox message");
+      }
+    }
+    return true;
+  }
+
+  if (json_value->type() != JsonValue::TYPE_OBJECT ||
+      field.cpp_type() != FieldDescriptor::CPPTYPE_MESSAGE) {
+    return UnboxField(*json_value, reflection, field, message, error, mask,
+                      unknown_object_properties);
+  }
+
+  const FieldDescriptor* repeated_name_field =
+      field.message_type()->FindFieldByName("name");
+
+  if (!repeated_name_field) {
+    return UnboxField(*json_value, reflection, field, message, error, mask,
+                      unknown_object_properties);
+  }
+
+  JsonValue name_value;
+  for (google::protobuf::RepeatedPtrField<JsonValue::Property>::iterator it =
+           json_value->mutable_object_properties()->begin();
+       it != json_value->mutable_object_properties()->end(); ++it) {
+    google::protobuf::Message* target = reflection.AddMessage(message, &field);
+
+    PJCORE_REQUIRE_SILENT(
+        ConsumeMessage(it->mutable_value(), target, error, mask, NULL),
+        "Failed to parse message JSON");
+
+    const JsonFieldMask* name_mask;
+    if (!SelectJsonField(mask, repeated_name_field->name(), &name_mask)) {
+      continue;
+    }
+
+    name_value.Clear();
+    name_value.set_type(JsonValue::TYPE_STRING);
+    name_value.mutable_string_value()->swap(*it->mutable_name());
+
+    PJCORE_REQUIRE_SILENT(
+        ConsumeField(&name_value, *target->GetReflection(),
+                     *repeated_name_field, target, error, name_mask,
+                     unknown_object_properties),
+        "Failed to parse field JSON");
+  }
+
+  return true;
+}
+
+bool UnboxMessage(const JsonValue& json_value,
+                  google::protobuf::Message* message, Error* error,
+                  const JsonFieldMask* mask,
+                  google::protobuf::RepeatedPtrField<JsonValue::Property>*
+                      unknown_object_properties) {
   PJCORE_CHECK(message);
   message->Clear();
   PJCORE_CHECK(error);
@@ -354,6 +514,11 @@ bool UnboxJsonValue(const JsonValue& json_value,
   for (google::protobuf::RepeatedPtrField<JsonValue::Property>::const_iterator
            it = json_value.object_properties().begin();
        it != json_value.object_properties().end(); ++it) {
+    const JsonFieldMask* field_mask;
+    if (!SelectJsonField(mask, it->name(), &field_mask)) {
+      continue;
+    }
+
     const FieldDescriptor* field = descriptor->FindFieldByName(it->name());
 
     if (!field) {
@@ -384,12 +549,127 @@ bool UnboxJsonValue(const JsonValue& json_value,
       continue;
     }
 
-    PJCORE_REQUIRE_SILENT(UnboxField(it->value(), reflection, *field, message,
-                                     error, unknown_object_properties),
-                          "Failed to parse field JSON");
+    PJCORE_REQUIRE_SILENT(
+        UnboxField(it->value(), reflection, *field, message, error, field_mask,
+                   unknown_object_properties),
+        "Failed to parse field JSON");
+  }
+
+  return true;
+}
+
+bool ConsumeMessage(JsonValue* consumed_json_value,
+                    google::protobuf::Message* message, Error* error,
+                    const JsonFieldMask* mask,
+                    google::protobuf::RepeatedPtrField<JsonValue::Property>*
+                        unknown_object_properties) {
+  PJCORE_CHECK(consumed_json_value);
+  PJCORE_CHECK(message);
+  message->Clear();
+  PJCORE_CHECK(error);
+  error->Clear();
+
+  const Descriptor* descriptor = message->GetDescriptor();
+
+  if (descriptor == JsonValue::descriptor()) {
+    static_cast<JsonValue*>(message)->Swap(consumed_json_value);
+    consumed_json_value->Clear();
+    return true;
+  }
+
+  PJCORE_REQUIRE(consumed_json_value->type() == JsonValue::TYPE_OBJECT,
+                 std::string("Value is not an object: ") +
+                     JsonValue::Type_Name(consumed_json_value->type()));
+
+  const Reflection& reflection = *message->GetReflection();
+
+  bool considered_object_properties = false;
+  const FieldDescriptor* object_properties_field = NULL;
+
+  for (google::protobuf::RepeatedPtrField<JsonValue::Property>::iterator it =
+           consumed_json_value->mutable_object_properties()->begin();
+       it != consumed_json_value->mutable_object_properties()->end(); ++it) {
+    const JsonFieldMask* field_mask;
+    if (!SelectJsonField(mask, it->name(), &field_mask)) {
+      continue;
+    }
+
+    const FieldDescriptor* field = descriptor->FindFieldByName(it->name());
+
+    if (!field) {
+      if (!considered_object_properties) {
+        considered_object_properties = true;
+        const FieldDescriptor* candidate =
+            descriptor->FindFieldByName(OBJECT_PROPERTIES_STR);
+        if (candidate) {
+          if (candidate->is_repeated() &&
+              candidate->cpp_type() == FieldDescriptor::CPPTYPE_MESSAGE &&
+              candidate->message_type() == JsonValue::Property::descriptor()) {
+            object_properties_field = candidate;
+          }
+        }
+      }
+
+      if (object_properties_field) {
+        google::protobuf::Message* object_property =
+            reflection.AddMessage(message, object_properties_field);
+        PJCORE_CHECK(object_property->GetDescriptor() ==
+                     JsonValue::Property::descriptor());
+
+        static_cast<JsonValue::Property*>(object_property)->Swap(&*it);
+      } else if (unknown_object_properties) {
+        unknown_object_properties->Add()->Swap(&*it);
+      }
+
+      continue;
+    }
+
+    PJCORE_REQUIRE_SILENT(
+        ConsumeField(it->mutable_value(), reflection, *field, message, error,
+                     field_mask, unknown_object_properties),
+        "Failed to parse field JSON");
   }
 
+  consumed_json_value->Clear();
   return true;
 }
 
+}  // unnamed namespace
+
+bool UnboxJsonValue(const JsonValue& json_value,
+                    google::protobuf::Message* message, Error* error,
+                    google::protobuf::RepeatedPtrField<JsonValue::Property>*
+                        unknown_object_properties) {
+  return UnboxMessage(json_value, message, error, NULL,
+                      unknown_object_properties);
+}
+
+bool UnboxJsonValue(const JsonValue& json_value,
+                    google::protobuf::Message* message, Error* error,
+                    const JsonFieldMask& mask,
+                    google::protobuf::RepeatedPtrField<JsonValue::Property>*
+                        unknown_object_properties) {
+  return UnboxMessage(json_value, message, error,
+                      mask.selects_all() ? NULL : &mask,
+                      unknown_object_properties);
+}
+
+bool UnboxJsonValue(JsonValue* consumed_json_value,
+                    google::protobuf::Message* message, Error* error,
+                    google::protobuf::RepeatedPtrField<JsonValue::Property>*
+                        unknown_object_properties) {
+  return ConsumeMessage(consumed_json_value, message, error, NULL,
+                        unknown_object_properties);
+}
+
+bool UnboxJsonValue(JsonValue* consumed_json_value,
+                    google::protobuf::Message* message, Error* error,
+                    const JsonFieldMask& mask,
+                    google::protobuf::RepeatedPtrField<JsonValue::Property>*
+                        unknown_object_properties) {
+  return ConsumeMessage(consumed_json_value, message, error,
+                        mask.selects_all() ? NULL : &mask,
+                        unknown_object_properties);
+}
+
 }  // namespace pjcore
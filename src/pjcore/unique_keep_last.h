@@ -39,6 +39,8 @@ ForwardIterator unique_keep_last(ForwardIterator begin, ForwardIterator end,
       if (!predicate(*same, *next)) {
         swap(*begin++, *same);
       }
+      same = next;
+      ++next;
     }
     swap(*begin++, *same);
   }
@@ -19,8 +19,11 @@
 
 #include <http_parser.h>
 
+#include <string.h>
+
 #include <algorithm>
 
+#include "pjcore/char_set_simd.h"
 #include "pjcore/logging.h"
 #include "pjcore/number_util.h"
 #include "pjcore/repeated_field_util.h"
@@ -30,7 +33,7 @@
 namespace pjcore {
 
 bool ParseUrl(StringPiece url, bool is_connect, ParsedUrl* parsed_url,
-              Error* error) {
+              Error* error, bool decode_parameters) {
   PJCORE_CHECK(parsed_url);
   parsed_url->Clear();
   PJCORE_CHECK(error);
@@ -65,39 +68,99 @@ bool ParseUrl(StringPiece url, bool is_connect, ParsedUrl* parsed_url,
     parsed_url->set_port(result.port);
   }
 
-  if (!parsed_url->query().empty()) {
-    std::string query = parsed_url->query();
-    std::replace(query.begin(), query.end(), '+', ' ');
-    StringPiece remaining(query);
-
-    for (;;) {
-      size_t pair_delim = remaining.find('&');
-      StringPiece pair = (pair_delim == StringPiece::npos)
-                             ? remaining
-                             : remaining.substr(0, pair_delim);
-
-      size_t delim = pair.find('=');
-
-      if (delim != StringPiece::npos) {
-        UrlParameter parameter;
-        if (DecodeUriComponent(pair.substr(0, delim),
-                               parameter.mutable_name()) &&
-            !parameter.name().empty() &&
-            DecodeUriComponent(pair.substr(delim + 1),
-                               parameter.mutable_value())) {
-          *parsed_url->add_parameters() = parameter;
-        }
-      }
+  if (decode_parameters) {
+    ParseUrlParameters(parsed_url);
+  }
 
-      if (pair_delim == StringPiece::npos) {
-        break;
-      }
+  return true;
+}
 
-      remaining.remove_prefix(pair_delim + 1);
+namespace {
+
+// Splits the next name=value pair off remaining, skipping pairs without '='.
+bool NextQueryPair(StringPiece* remaining, StringPiece* name,
+                   StringPiece* value) {
+  while (!remaining->empty()) {
+    size_t pair_delim = remaining->find('&');
+    StringPiece pair = remaining->substr(0, pair_delim);
+    if (pair_delim == StringPiece::npos) {
+      remaining->clear();
+    } else {
+      remaining->remove_prefix(pair_delim + 1);
+    }
+
+    size_t delim = pair.find('=');
+    if (delim != StringPiece::npos) {
+      *name = pair.substr(0, delim);
+      *value = pair.substr(delim + 1);
+      return true;
     }
   }
 
-  return true;
+  return false;
+}
+
+// Decodes a parameter name or value, where '+' stands for a space.
+bool DecodeQueryComponent(StringPiece component, std::string* decoded) {
+  if (component.find('+') == StringPiece::npos) {
+    return DecodeUriComponent(component, decoded);
+  }
+
+  std::string spaced;
+  component.CopyToString(&spaced);
+  std::replace(spaced.begin(), spaced.end(), '+', ' ');
+  return DecodeUriComponent(spaced, decoded);
+}
+
+}  // unnamed namespace
+
+void ParseUrlParameters(ParsedUrl* parsed_url) {
+  PJCORE_CHECK(parsed_url);
+  parsed_url->clear_parameters();
+
+  StringPiece remaining(parsed_url->query());
+  StringPiece name;
+  StringPiece value;
+
+  while (NextQueryPair(&remaining, &name, &value)) {
+    UrlParameter parameter;
+    if (DecodeQueryComponent(name, parameter.mutable_name()) &&
+        !parameter.name().empty() &&
+        DecodeQueryComponent(value, parameter.mutable_value())) {
+      parsed_url->add_parameters()->Swap(&parameter);
+    }
+  }
+}
+
+bool GetUrlParameter(StringPiece query, StringPiece name,
+                     std::string* value) {
+  PJCORE_CHECK(value);
+  value->clear();
+
+  if (name.empty()) {
+    return false;
+  }
+
+  StringPiece remaining(query);
+  StringPiece pair_name;
+  StringPiece pair_value;
+  std::string decoded_name;
+
+  while (NextQueryPair(&remaining, &pair_name, &pair_value)) {
+    // Names without escapes are compared as they are.
+    bool is_match =
+        pair_name.find_first_of("%+") == StringPiece::npos
+            ? pair_name == name && Unicode::IsStructurallyValidUtf8(pair_name)
+            : DecodeQueryComponent(pair_name, &decoded_name) &&
+                  StringPiece(decoded_name) == name;
+
+    if (is_match && DecodeQueryComponent(pair_value, value)) {
+      return true;
+    }
+  }
+
+  value->clear();
+  return false;
 }
 
 namespace {
@@ -113,14 +176,26 @@ bool Encode(StringPiece str, const Predicate& is_unescaped,
 
   PJCORE_REQUIRE_SILENT(Unicode::IsStructurallyValidUtf8(str), "Invalid UTF-8");
 
-  for (size_t offset = 0; offset < str.length(); ++offset) {
-    if (is_unescaped(str[offset])) {
-      encoded->push_back(str[offset]);
-    } else {
+  static const SimdCharSet unescaped_set = MakeSimdCharSet(is_unescaped);
+
+  encoded->reserve(str.length());
+
+  size_t offset = 0;
+  while (offset < str.length()) {
+    size_t end = offset + SkipCharSetSimd(str.data() + offset,
+                                          str.length() - offset, unescaped_set);
+    while (end < str.length() && is_unescaped(str[end])) {
+      ++end;
+    }
+    encoded->append(str.data() + offset, end - offset);
+    offset = end;
+
+    if (offset < str.length()) {
       uint8_t value = static_cast<uint8_t>(str[offset]);
       encoded->push_back('%');
       encoded->push_back(WriteHexDigit(value >> 4));
       encoded->push_back(WriteHexDigit(value & 0xf));
+      ++offset;
     }
   }
 
@@ -133,28 +208,49 @@ PJCORE_CHAR_PREDICATE(IsUnescapedForEncodeUri, IsUriReserved::eval(ch) ||
 PJCORE_CHAR_PREDICATE(IsUnescapedForEncodeUriComponent,
                       IsUriUnescaped::eval(ch));
 
+struct HexDigitValues {
+  HexDigitValues() {
+    memset(values, -1, sizeof(values));
+    for (int ch = 0; ch < 0x100; ++ch) {
+      if (IsHexDigit::eval(static_cast<char>(ch))) {
+        values[ch] = static_cast<int8_t>(ReadHexDigit(static_cast<char>(ch)));
+      }
+    }
+  }
+
+  // -1 for non-digits.
+  int8_t values[0x100];
+};
+
 template <typename Predicate>
 bool Decode(StringPiece str, const Predicate& is_reserved,
             std::string* unencoded) {
   PJCORE_CHECK(unencoded);
   unencoded->clear();
 
-  size_t offset = 0;
+  static const HexDigitValues hex_digit_values;
 
-  while (offset < str.length()) {
-    if (str[offset] != '%') {
-      unencoded->push_back(str[offset]);
-      ++offset;
-    } else {
-      PJCORE_REQUIRE_SILENT(str.length() - offset >= 3,
-                            "Unterminated percent escape");
-      PJCORE_REQUIRE_SILENT(IsHexDigit::eval(str[offset + 1]) &&
-                                IsHexDigit::eval(str[offset + 2]),
-                            "Invalid percent sequence");
-      unencoded->push_back(static_cast<char>(
-          ReadHexDigit(str[offset + 1]) << 4 | ReadHexDigit(str[offset + 2])));
-      offset += 3;
+  unencoded->reserve(str.length());
+
+  const char* begin = str.data();
+  const char* end = begin + str.length();
+
+  while (begin < end) {
+    const char* percent =
+        static_cast<const char*>(memchr(begin, '%', end - begin));
+    if (!percent) {
+      unencoded->append(begin, end - begin);
+      break;
     }
+
+    unencoded->append(begin, percent - begin);
+
+    PJCORE_REQUIRE_SILENT(end - percent >= 3, "Unterminated percent escape");
+    int high = hex_digit_values.values[static_cast<uint8_t>(percent[1])];
+    int low = hex_digit_values.values[static_cast<uint8_t>(percent[2])];
+    PJCORE_REQUIRE_SILENT(high >= 0 && low >= 0, "Invalid percent sequence");
+    unencoded->push_back(static_cast<char>(high << 4 | low));
+    begin = percent + 3;
   }
 
   PJCORE_REQUIRE_SILENT(Unicode::IsStructurallyValidUtf8(*unencoded),
@@ -20,6 +20,7 @@
 #include "pjcore/error_util.h"
 #include "pjcore/logging.h"
 #include "pjcore/string_piece_util.h"
+#include "pjcore/third_party/chromium/macros.h"
 
 namespace pjcore {
 
@@ -62,4 +63,83 @@ TEST(Base64, ReadFailure) {
   EXPECT_FALSE(ReadBase64("YXN1cmU", &unencoded, &error));
   EXPECT_FALSE(ReadBase64("c3VyZS+=", &unencoded, &error));
 }
+
+namespace {
+
+std::string MakeBinary(size_t length) {
+  std::string binary;
+  uint32_t state = 12345;
+  for (size_t index = 0; index < length; ++index) {
+    state = state * 1103515245 + 12345;
+    binary.push_back(static_cast<char>(state >> 16));
+  }
+  return binary;
+}
+
+std::string WriteBase64Slowly(StringPiece binary) {
+  std::string base_64;
+  uint32_t bits = 0;
+  int bit_count = 0;
+  for (size_t index = 0; index < binary.length(); ++index) {
+    bits = (bits << 8) | static_cast<uint8_t>(binary[index]);
+    bit_count += 8;
+    while (bit_count >= 6) {
+      bit_count -= 6;
+      base_64.push_back(WriteBase64Digit((bits >> bit_count) & 0x3f));
+    }
+  }
+  if (bit_count) {
+    base_64.push_back(WriteBase64Digit((bits << (6 - bit_count)) & 0x3f));
+  }
+  while (base_64.length() % 4) {
+    base_64.push_back('=');
+  }
+  return base_64;
+}
+
+}  // unnamed namespace
+
+TEST(Base64, RoundTripLong) {
+  for (size_t length = 0; length < 300; ++length) {
+    std::string binary = MakeBinary(length);
+    std::string base_64 = WriteBase64(binary);
+    EXPECT_EQ(WriteBase64Slowly(binary), base_64) << length;
+
+    std::string unencoded;
+    Error error;
+    EXPECT_TRUE(ReadBase64(base_64, &unencoded, &error))
+        << length << " " << ErrorToString(error);
+    EXPECT_EQ(binary, unencoded) << length;
+  }
+}
+
+TEST(Base64, ReadAllDigits) {
+  std::string base_64 =
+      "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+  base_64 += base_64;
+
+  std::string unencoded;
+  Error error;
+  EXPECT_TRUE(ReadBase64(base_64, &unencoded, &error)) << ErrorToString(error);
+  EXPECT_EQ(base_64, WriteBase64(unencoded));
+}
+
+TEST(Base64, ReadFailureLong) {
+  std::string base_64 = WriteBase64(MakeBinary(150));
+  const char kInvalid[] = {'-', '_', ' ', '\0', '\x80', '\xff', '@', '['};
+
+  GlobalLogOverride global_log_override;
+  for (size_t position = 0; position < base_64.length(); ++position) {
+    for (size_t index = 0; index < ARRAYSIZE_UNSAFE(kInvalid); ++index) {
+      std::string corrupted = base_64;
+      corrupted[position] = kInvalid[index];
+
+      std::string unencoded;
+      Error error;
+      EXPECT_FALSE(ReadBase64(corrupted, &unencoded, &error)) << position;
+      EXPECT_EQ("Invalid Base64 digit", error.description()) << position;
+    }
+  }
+}
+
 }  // namespace pjcore
@@ -0,0 +1,145 @@
+// JSON [de]serialization for protobuf + embedded HTTP server and client in C++.
+// Copyright (C) 2014 http://protojson.com/
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+
+#include "pjcore/json_async.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "pjcore/third_party/chromium/bind.h"
+
+#include "pjcore/logging.h"
+#include "pjcore/json_util.h"
+#include "pjcore/json_writer.h"
+#include "pjcore/make_json_value.h"
+#include "pjcore/shared_future-inl.h"
+
+#include "pjcore_test/is_gmock_verbose.h"
+
+namespace pjcore {
+
+namespace {
+
+void AppendChunk(std::vector<std::string>* chunks, StringPiece chunk) {
+  PJCORE_CHECK(chunks);
+  chunks->push_back(chunk.as_string());
+}
+
+}  // unnamed namespace
+
+TEST(JsonAsync, ReadJsonAsync) {
+  LiveCapturableList live_list(IsGmockVerbose());
+
+  SharedUvLoop shared_loop = CreateUvLoop(&live_list);
+  ASSERT_TRUE(shared_loop);
+
+  SharedFuture future = shared_loop->CreateFuture();
+
+  ResultErrorPair<scoped_ptr<JsonValue> > inline_pair;
+  ReadJsonAsync(shared_loop, "[1, \"alpha\"]",
+                future->CreateCallback(&inline_pair));
+  // Small inputs complete before returning.
+  ASSERT_TRUE(inline_pair.result_);
+  EXPECT_TRUE(AreJsonValuesEqual(MakeJsonArray(1, "alpha"),
+                                 *inline_pair.result_));
+
+  std::string str = WriteJson(MakeJsonObject("beta", MakeJsonArray(2, 3)));
+  ResultErrorPair<scoped_ptr<JsonValue> > async_pair;
+  ReadJsonAsync(shared_loop, str, future->CreateCallback(&async_pair),
+                JsonReaderConfig::default_instance(), 0);
+
+  ResultErrorPair<scoped_ptr<JsonValue> > error_pair;
+  ReadJsonAsync(shared_loop, "[1,", future->CreateCallback(&error_pair),
+                JsonReaderConfig::default_instance(), 0);
+
+  {
+    GlobalLogOverride global_log_override;
+    future->Wait();
+  }
+
+  ASSERT_TRUE(async_pair.result_);
+  EXPECT_TRUE(AreJsonValuesEqual(MakeJsonObject("beta", MakeJsonArray(2, 3)),
+                                 *async_pair.result_));
+
+  EXPECT_FALSE(error_pair.result_);
+  EXPECT_EQ("Failed to parse JSON string", error_pair.error_.description());
+}
+
+TEST(JsonAsync, WriteJsonAsync) {
+  LiveCapturableList live_list(IsGmockVerbose());
+
+  SharedUvLoop shared_loop = CreateUvLoop(&live_list);
+  ASSERT_TRUE(shared_loop);
+
+  SharedFuture future = shared_loop->CreateFuture();
+
+  ResultErrorPair<scoped_ptr<std::string> > inline_pair;
+  WriteJsonAsync(shared_loop,
+                 scoped_ptr<JsonValue>(new JsonValue(MakeJsonArray(1, 2))),
+                 future->CreateCallback(&inline_pair));
+  ASSERT_TRUE(inline_pair.result_);
+  EXPECT_EQ("[1,2]", *inline_pair.result_);
+
+  ResultErrorPair<scoped_ptr<std::string> > async_pair;
+  WriteJsonAsync(
+      shared_loop,
+      scoped_ptr<JsonValue>(new JsonValue(MakeJsonObject("gamma", true))),
+      future->CreateCallback(&async_pair),
+      JsonWriterConfig::default_instance(), 0);
+
+  future->Wait();
+
+  ASSERT_TRUE(async_pair.result_);
+  EXPECT_EQ("{\"gamma\":true}", *async_pair.result_);
+}
+
+TEST(JsonAsync, WriteJsonInSteps) {
+  LiveCapturableList live_list(IsGmockVerbose());
+
+  SharedUvLoop shared_loop = CreateUvLoop(&live_list);
+  ASSERT_TRUE(shared_loop);
+
+  JsonValue value = MakeJsonArray();
+  for (int index = 0; index < 1000; ++index) {
+    AppendJsonElement(MakeJsonObject("alpha", index, "beta", "gamma"),
+                      &value);
+  }
+
+  SharedFuture future = shared_loop->CreateFuture();
+
+  std::vector<std::string> chunks;
+  WriteJsonInSteps(shared_loop, value, Bind(&AppendChunk, &chunks),
+                   future->CreateClosure(),
+                   JsonWriterConfig::default_instance(), 1000);
+  // Nothing is written before the loop runs.
+  EXPECT_TRUE(chunks.empty());
+
+  future->Wait();
+
+  EXPECT_LT(10u, chunks.size());
+
+  std::string str;
+  for (size_t index = 0; index < chunks.size(); ++index) {
+    str += chunks[index];
+  }
+  EXPECT_EQ(WriteJson(value), str);
+}
+
+}  // namespace pjcore
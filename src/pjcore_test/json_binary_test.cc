@@ -0,0 +1,336 @@
+// JSON [de]serialization for protobuf + embedded HTTP server and client in C++.
+// Copyright (C) 2014 http://protojson.com/
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+
+#include "pjcore/json_binary.h"
+
+#include <gtest/gtest.h>
+
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "pjcore/error_util.h"
+#include "pjcore/json_util.h"
+#include "pjcore/json_writer.h"
+#include "pjcore/logging.h"
+#include "pjcore/number_util.h"
+#include "pjcore/string_piece_util.h"
+#include "pjcore_test/read_json_or_die.h"
+#include "pjcore_test/test_message.pb.h"
+
+namespace pjcore {
+
+namespace {
+
+std::string ReadHexBlobOrDie(StringPiece hex_blob) {
+  std::string binary;
+  Error error;
+  PJCORE_CHECK(ReadHexBlob(hex_blob, &binary, &error));  // error
+  return binary;
+}
+
+// Values covering every type and every size class of both encodings.
+std::vector<JsonValue> MakeTestValues() {
+  std::vector<JsonValue> values;
+
+  const char* const kJsonValues[] = {
+      "null", "true", "false", "0", "23", "24", "-24", "-25", "127", "128",
+      "-32", "-33", "-128", "-129", "255", "256", "32767", "32768", "-32768",
+      "-32769", "65535", "65536", "2147483647", "2147483648", "-2147483648",
+      "-2147483649", "4294967295", "4294967296", "9223372036854775807",
+      "-9223372036854775808", "18446744073709551615", "0.0", "-0.0", "1.5",
+      "0.1", "1e300", "-1e-300", "3.4028234663852886e38", "NaN", "Infinity",
+      "-Infinity", "\"\"", "\"alpha\"", "\"\\u00fc\\u0000\"", "[]", "{}",
+      "[1,[2,[3,{\"a\":[]}]]]",
+      "{\"a\":{\"b\":{\"c\":null}},\"d\":[true,\"e\",-1.25]}"};
+
+  for (size_t index = 0; index < sizeof(kJsonValues) / sizeof(kJsonValues[0]);
+       ++index) {
+    values.push_back(ReadJsonOrDie(kJsonValues[index]));
+  }
+
+  values.push_back(MakeJsonValue(static_cast<uint32_t>(0)));
+  values.push_back(MakeJsonValue(static_cast<uint64_t>(300)));
+
+  const size_t kSizes[] = {15, 16, 23, 24, 31, 32, 255, 256, 65535, 65536};
+  for (size_t index = 0; index < sizeof(kSizes) / sizeof(kSizes[0]); ++index) {
+    values.push_back(MakeJsonValue(std::string(kSizes[index], 'x')));
+
+    JsonValue array = MakeJsonArray();
+    JsonValue object = MakeJsonObject();
+    for (size_t element = 0; element < kSizes[index]; ++element) {
+      *array.add_array_elements() = MakeJsonValue(element % 3 ? 1.5 : -7.0);
+
+      JsonValue::Property* property = object.add_object_properties();
+      *property->mutable_name() = WriteNumber(element, 6);
+      *property->mutable_value() = MakeJsonValue(element);
+    }
+    values.push_back(array);
+    values.push_back(object);
+  }
+
+  return values;
+}
+
+// CBOR turns small unsigned values into signed ones, as ReadJson does.
+JsonValue CanonicalizeIntegers(const JsonValue& value) {
+  JsonValue result(value);
+  UnpackJsonArray(&result);
+
+  switch (result.type()) {
+    case JsonValue::TYPE_UNSIGNED:
+      if (result.unsigned_value() <=
+          static_cast<uint64_t>(std::numeric_limits<int64_t>::max())) {
+        result = MakeJsonValue(static_cast<int64_t>(result.unsigned_value()));
+      }
+      break;
+
+    case JsonValue::TYPE_OBJECT:
+      for (int index = 0; index < result.object_properties_size(); ++index) {
+        *result.mutable_object_properties(index)->mutable_value() =
+            CanonicalizeIntegers(result.object_properties(index).value());
+      }
+      break;
+
+    case JsonValue::TYPE_ARRAY:
+      for (int index = 0; index < result.array_elements_size(); ++index) {
+        *result.mutable_array_elements(index) =
+            CanonicalizeIntegers(result.array_elements(index));
+      }
+      break;
+
+    default:
+      break;
+  }
+
+  return result;
+}
+
+::testing::AssertionResult TestReadCbor(StringPiece hex,
+                                        StringPiece expected_json) {
+  JsonValue value;
+  Error error;
+  if (!ReadCbor(ReadHexBlobOrDie(hex), &value, &error)) {
+    return ::testing::AssertionFailure() << ErrorToString(error);
+  }
+
+  if (!AreJsonValuesEqual(ReadJsonOrDie(expected_json), value)) {
+    return ::testing::AssertionFailure() << WriteJson(value);
+  }
+
+  return ::testing::AssertionSuccess();
+}
+
+::testing::AssertionResult TestReadFailure(bool msg_pack, StringPiece hex) {
+  JsonValue value;
+  Error error;
+
+  GlobalLogOverride global_log_override;
+  std::string binary = ReadHexBlobOrDie(hex);
+  if (msg_pack ? ReadMsgPack(binary, &value, &error)
+               : ReadCbor(binary, &value, &error)) {
+    return ::testing::AssertionFailure() << "Unexpected success: "
+                                         << WriteJson(value);
+  }
+
+  return ::testing::AssertionSuccess();
+}
+
+}  // unnamed namespace
+
+TEST(JsonBinary, CborRoundTrip) {
+  std::vector<JsonValue> values = MakeTestValues();
+  for (size_t index = 0; index < values.size(); ++index) {
+    JsonValue value;
+    Error error;
+    ASSERT_TRUE(ReadCbor(WriteCbor(values[index]), &value, &error))
+        << index << ": " << ErrorToString(error);
+    EXPECT_EQ(CanonicalizeIntegers(values[index]).SerializeAsString(),
+              value.SerializeAsString())
+        << index << ": " << WriteJson(value);
+  }
+}
+
+TEST(JsonBinary, MsgPackRoundTrip) {
+  std::vector<JsonValue> values = MakeTestValues();
+  for (size_t index = 0; index < values.size(); ++index) {
+    JsonValue value;
+    Error error;
+    ASSERT_TRUE(ReadMsgPack(WriteMsgPack(values[index]), &value, &error))
+        << index << ": " << ErrorToString(error);
+    EXPECT_EQ(values[index].SerializeAsString(), value.SerializeAsString())
+        << index << ": " << WriteJson(value);
+  }
+}
+
+TEST(JsonBinary, WriteCbor) {
+  // Examples from RFC 7049 Appendix A.
+  EXPECT_EQ("00", WriteHexBlob(WriteCbor(0)));
+  EXPECT_EQ("17", WriteHexBlob(WriteCbor(23)));
+  EXPECT_EQ("1818", WriteHexBlob(WriteCbor(24)));
+  EXPECT_EQ("1903e8", WriteHexBlob(WriteCbor(1000)));
+  EXPECT_EQ("1b000000e8d4a51000",
+            WriteHexBlob(WriteCbor(static_cast<int64_t>(1000000000000LL))));
+  EXPECT_EQ("1bffffffffffffffff",
+            WriteHexBlob(WriteCbor(std::numeric_limits<uint64_t>::max())));
+  EXPECT_EQ("29", WriteHexBlob(WriteCbor(-10)));
+  EXPECT_EQ("3903e7", WriteHexBlob(WriteCbor(-1000)));
+  EXPECT_EQ("fb3ff199999999999a", WriteHexBlob(WriteCbor(1.1)));
+  EXPECT_EQ("fa47c35000", WriteHexBlob(WriteCbor(100000.0)));
+  EXPECT_EQ("fa7f800000", WriteHexBlob(WriteCbor(JsonInfinity())));
+  EXPECT_EQ("fb7e37e43c8800759c", WriteHexBlob(WriteCbor(1.0e300)));
+  EXPECT_EQ("f4f5f6", WriteHexBlob(WriteCbor(false) + WriteCbor(true) +
+                                   WriteCbor(JsonNull())));
+  EXPECT_EQ("62c3bc", WriteHexBlob(WriteCbor("\xc3\xbc")));
+  EXPECT_EQ("8301820203820405",
+            WriteHexBlob(WriteCbor(ReadJsonOrDie("[1,[2,3],[4,5]]"))));
+  EXPECT_EQ("a26161016162820203",
+            WriteHexBlob(WriteCbor(ReadJsonOrDie("{\"a\":1,\"b\":[2,3]}"))));
+
+  JsonValue packed = MakeJsonArray(1, 2, 3);
+  ASSERT_TRUE(PackJsonArray(&packed));
+  EXPECT_EQ("83010203", WriteHexBlob(WriteCbor(packed)));
+}
+
+TEST(JsonBinary, ReadCbor) {
+  EXPECT_TRUE(TestReadCbor("1903e8", "1000"));
+  EXPECT_TRUE(TestReadCbor("3863", "-100"));
+  EXPECT_TRUE(TestReadCbor("f93e00", "1.5"));
+  EXPECT_TRUE(TestReadCbor("f90001", "5.960464477539063e-8"));
+  EXPECT_TRUE(TestReadCbor("f9c400", "-4.0"));
+  EXPECT_TRUE(TestReadCbor("f97c00", "Infinity"));
+  EXPECT_TRUE(TestReadCbor("f9fc00", "-Infinity"));
+  EXPECT_TRUE(TestReadCbor("f97e00", "NaN"));
+  EXPECT_TRUE(TestReadCbor("f7", "null"));
+  EXPECT_TRUE(TestReadCbor("7f657374726561646d696e67ff", "\"streaming\""));
+  EXPECT_TRUE(TestReadCbor("9fff", "[]"));
+  EXPECT_TRUE(TestReadCbor("9f018202039f0405ffff", "[1,[2,3],[4,5]]"));
+  EXPECT_TRUE(
+      TestReadCbor("bf61610161629f0203ffff", "{\"a\":1,\"b\":[2,3]}"));
+  EXPECT_TRUE(TestReadCbor(
+      "c074323031332d30332d32315432303a30343a30305a",
+      "\"2013-03-21T20:04:00Z\""));
+  EXPECT_TRUE(TestReadCbor("a2616201616102", "{\"a\":2,\"b\":1}"));
+}
+
+TEST(JsonBinary, ReadCborFailure) {
+  EXPECT_TRUE(TestReadFailure(false, ""));
+  EXPECT_TRUE(TestReadFailure(false, "1903"));
+  EXPECT_TRUE(TestReadFailure(false, "0000"));
+  EXPECT_TRUE(TestReadFailure(false, "3bffffffffffffffff"));
+  EXPECT_TRUE(TestReadFailure(false, "4161"));
+  EXPECT_TRUE(TestReadFailure(false, "62c3"));
+  EXPECT_TRUE(TestReadFailure(false, "a10101"));
+  EXPECT_TRUE(TestReadFailure(false, "ff"));
+  EXPECT_TRUE(TestReadFailure(false, "8201ff"));
+  EXPECT_TRUE(TestReadFailure(false, "1f"));
+  EXPECT_TRUE(TestReadFailure(false, "1c"));
+  EXPECT_TRUE(TestReadFailure(false, "f8ff"));
+  EXPECT_TRUE(TestReadFailure(false, "9affffffff"));
+  EXPECT_TRUE(TestReadFailure(false, "7f6161"));
+  EXPECT_TRUE(TestReadFailure(false, "7f01ff"));
+  EXPECT_TRUE(TestReadFailure(false, "62c328"));
+  EXPECT_TRUE(TestReadFailure(false, "a162c32801"));
+}
+
+TEST(JsonBinary, WriteMsgPack) {
+  EXPECT_EQ("7f", WriteHexBlob(WriteMsgPack(127)));
+  EXPECT_EQ("d10080", WriteHexBlob(WriteMsgPack(128)));
+  EXPECT_EQ("ff", WriteHexBlob(WriteMsgPack(-1)));
+  EXPECT_EQ("e0", WriteHexBlob(WriteMsgPack(-32)));
+  EXPECT_EQ("d0df", WriteHexBlob(WriteMsgPack(-33)));
+  EXPECT_EQ("cc05", WriteHexBlob(WriteMsgPack(static_cast<uint32_t>(5))));
+  EXPECT_EQ("ca3fc00000", WriteHexBlob(WriteMsgPack(1.5)));
+  EXPECT_EQ("cb3fb999999999999a", WriteHexBlob(WriteMsgPack(0.1)));
+  EXPECT_EQ("c0c3c2", WriteHexBlob(WriteMsgPack(JsonNull()) +
+                                   WriteMsgPack(true) + WriteMsgPack(false)));
+  EXPECT_EQ("a161", WriteHexBlob(WriteMsgPack("a")));
+  EXPECT_EQ("d920", WriteHexBlob(WriteMsgPack(std::string(32, ' ')))
+                        .substr(0, 4));
+  EXPECT_EQ("9201a0",
+            WriteHexBlob(WriteMsgPack(ReadJsonOrDie("[1,\"\"]"))));
+  EXPECT_EQ("81a16101",
+            WriteHexBlob(WriteMsgPack(ReadJsonOrDie("{\"a\":1}"))));
+}
+
+TEST(JsonBinary, ReadMsgPackFailure) {
+  EXPECT_TRUE(TestReadFailure(true, ""));
+  EXPECT_TRUE(TestReadFailure(true, "c1"));
+  EXPECT_TRUE(TestReadFailure(true, "cd00"));
+  EXPECT_TRUE(TestReadFailure(true, "c40161"));
+  EXPECT_TRUE(TestReadFailure(true, "d40100"));
+  EXPECT_TRUE(TestReadFailure(true, "8101a0"));
+  EXPECT_TRUE(TestReadFailure(true, "a2"));
+  EXPECT_TRUE(TestReadFailure(true, "dd7fffffff"));
+  EXPECT_TRUE(TestReadFailure(true, "0000"));
+  EXPECT_TRUE(TestReadFailure(true, "a2c328"));
+  EXPECT_TRUE(TestReadFailure(true, "81a2c32801"));
+}
+
+TEST(JsonBinary, ReaderConfig) {
+  JsonReaderConfig config;
+  config.set_pack_numeric_arrays(true);
+
+  JsonValue value;
+  Error error;
+  ASSERT_TRUE(ReadMsgPack(ReadHexBlobOrDie("93010203"), &value, &error,
+                          config));
+  EXPECT_TRUE(IsPackedJsonArray(value));
+
+  config.Clear();
+  config.set_disallow_nan_and_infinity(true);
+  EXPECT_TRUE(ReadCbor(WriteCbor(1.5), &value, &error, config));
+  {
+    GlobalLogOverride global_log_override;
+    EXPECT_FALSE(ReadCbor(WriteCbor(JsonNaN()), &value, &error, config));
+    EXPECT_FALSE(ReadMsgPack(WriteMsgPack(JsonInfinity()), &value, &error,
+                             config));
+  }
+
+  config.Clear();
+  config.set_properties_as_is(true);
+  std::string msg_pack = ReadHexBlobOrDie("82a16202a16101");
+  ASSERT_TRUE(ReadMsgPack(msg_pack, &value, &error, config));
+  EXPECT_EQ("{\"b\":2,\"a\":1}", WriteJson(value));
+  ASSERT_TRUE(ReadMsgPack(msg_pack, &value, &error));
+  EXPECT_EQ("{\"a\":1,\"b\":2}", WriteJson(value));
+}
+
+TEST(JsonBinary, Message) {
+  TestMessage message;
+  message.set_optional_int32(-5);
+  message.set_optional_uint64(std::numeric_limits<uint64_t>::max());
+  message.set_optional_double(0.1);
+  message.set_optional_string("alpha");
+  message.set_optional_bytes("\x01\x02");
+  message.mutable_optional_message()->add_repeated_float(1.5f);
+  message.add_repeated_enum(TestMessage::TEST_BETA);
+
+  TestMessage parsed;
+  Error error;
+  ASSERT_TRUE(ReadCbor(WriteCbor(message), &parsed, &error))
+      << ErrorToString(error);
+  EXPECT_EQ(message.SerializeAsString(), parsed.SerializeAsString());
+
+  parsed.Clear();
+  ASSERT_TRUE(ReadMsgPack(WriteMsgPack(message), &parsed, &error))
+      << ErrorToString(error);
+  EXPECT_EQ(message.SerializeAsString(), parsed.SerializeAsString());
+}
+
+}  // namespace pjcore
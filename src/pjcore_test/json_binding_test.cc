@@ -0,0 +1,204 @@
+// JSON [de]serialization for protobuf + embedded HTTP server and client in C++.
+// Copyright (C) 2014 http://protojson.com/
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+
+#include "pjcore/json_binding.h"
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "pjcore_test/test_message.pjcore.h"
+#include "pjcore/error_util.h"
+#include "pjcore/make_json_value.h"
+
+namespace {
+
+struct TestPoint {
+  TestPoint() : x(0), y(0) {}
+
+  TestPoint(int32_t an_x, int32_t a_y) : x(an_x), y(a_y) {}
+
+  int32_t x;
+
+  int32_t y;
+};
+
+struct TestShape {
+  TestShape() : closed(false), scale(1) {}
+
+  std::string name;
+
+  std::vector<TestPoint> points;
+
+  std::map<std::string, std::vector<double> > layers;
+
+  pjcore::JsonOptional<std::string> comment;
+
+  bool closed;
+
+  float scale;
+
+  uint64_t id;
+
+  std::vector<bool> flags;
+
+  pjcore::JsonValue extra;
+
+  pjcore::TestMessage message;
+};
+
+}  // unnamed namespace
+
+PJCORE_JSON_BINDING(TestPoint,
+                    PJCORE_JSON_FIELD(x)
+                    PJCORE_JSON_FIELD(y))
+
+PJCORE_JSON_BINDING(TestShape,
+                    PJCORE_JSON_FIELD(name)
+                    PJCORE_JSON_FIELD(points)
+                    PJCORE_JSON_FIELD(layers)
+                    PJCORE_JSON_FIELD(comment)
+                    PJCORE_JSON_FIELD(closed)
+                    PJCORE_JSON_FIELD(scale)
+                    PJCORE_JSON_NAMED_FIELD(id, "shape_id")
+                    PJCORE_JSON_FIELD(flags)
+                    PJCORE_JSON_FIELD(extra)
+                    PJCORE_JSON_FIELD(message))
+
+namespace pjcore {
+
+namespace {
+
+TestShape MakeTestShape() {
+  TestShape shape;
+  shape.name = "triangle \"1\"";
+  shape.points.push_back(TestPoint(0, 0));
+  shape.points.push_back(TestPoint(3, -4));
+  shape.layers["alpha"].push_back(0.5);
+  shape.layers["beta"];
+  shape.closed = true;
+  shape.scale = 2.5f;
+  shape.id = 18446744073709551615ull;
+  shape.flags.push_back(true);
+  shape.flags.push_back(false);
+  shape.extra = MakeJsonObject("gamma", MakeJsonArray(1, "delta"));
+  shape.message.set_optional_int32(7);
+  return shape;
+}
+
+JsonValue MakeTestShapeJson() {
+  return MakeJsonObject(
+      "name", "triangle \"1\"", "points",
+      MakeJsonArray(MakeJsonObject("x", 0, "y", 0),
+                    MakeJsonObject("x", 3, "y", -4)),
+      "layers", MakeJsonObject("alpha", MakeJsonArray(0.5), "beta",
+                               MakeJsonArray()),
+      "closed", true, "scale", 2.5, "shape_id", 18446744073709551615ull,
+      "flags", MakeJsonArray(true, false), "extra",
+      MakeJsonObject("gamma", MakeJsonArray(1, "delta")), "message",
+      MakeJsonObject("optional_int32", 7));
+}
+
+}  // unnamed namespace
+
+TEST(JsonBinding, Write) {
+  EXPECT_EQ(WriteJson(MakeTestShapeJson()), WriteBoundJson(MakeTestShape()));
+
+  TestShape shape = MakeTestShape();
+  shape.comment = JsonOptional<std::string>("epsilon");
+  EXPECT_NE(std::string::npos,
+            WriteBoundJson(shape).find(
+                "\"beta\":[]},\"comment\":\"epsilon\",\"closed\":true"));
+}
+
+TEST(JsonBinding, RoundTrip) {
+  TestShape shape;
+  Error error;
+  ASSERT_TRUE(
+      ReadBoundJson(WriteBoundJson(MakeTestShape()), &shape, &error))
+      << ErrorToString(error);
+
+  EXPECT_EQ(WriteBoundJson(MakeTestShape()), WriteBoundJson(shape));
+  EXPECT_EQ(2u, shape.points.size());
+  EXPECT_EQ(-4, shape.points[1].y);
+  EXPECT_FALSE(shape.comment.has_value());
+  EXPECT_EQ(18446744073709551615ull, shape.id);
+  EXPECT_EQ(7, shape.message.optional_int32());
+}
+
+TEST(JsonBinding, Read) {
+  TestShape shape;
+  Error error;
+  ASSERT_TRUE(ReadBoundJson(
+      "{\"points\": [{\"x\": 1, \"z\": [2]}], \"name\": \"alpha\","
+      " \"name\": \"beta\", \"scale\": null, \"comment\": \"gamma\","
+      " \"unknown\": {\"delta\": [1, 2]}}",
+      &shape, &error)) << ErrorToString(error);
+
+  EXPECT_EQ("alpha", shape.name);
+  ASSERT_EQ(1u, shape.points.size());
+  EXPECT_EQ(1, shape.points[0].x);
+  EXPECT_EQ(0, shape.points[0].y);
+  EXPECT_EQ(0, shape.scale);
+  ASSERT_TRUE(shape.comment.has_value());
+  EXPECT_EQ("gamma", shape.comment.value());
+
+  JsonReaderConfig properties_as_is;
+  properties_as_is.set_properties_as_is(true);
+  ASSERT_TRUE(ReadBoundJson("{\"name\": \"alpha\", \"name\": \"beta\"}",
+                            &shape, &error, properties_as_is));
+  EXPECT_EQ("beta", shape.name);
+  EXPECT_TRUE(shape.points.empty());
+}
+
+TEST(JsonBinding, Containers) {
+  std::map<std::string, std::vector<JsonOptional<int64_t> > > value;
+  Error error;
+  ASSERT_TRUE(ReadBoundJson("{\"alpha\": [1, null], \"beta\": []}", &value,
+                            &error)) << ErrorToString(error);
+
+  ASSERT_EQ(2u, value.size());
+  ASSERT_EQ(2u, value["alpha"].size());
+  EXPECT_EQ(1, value["alpha"][0].value());
+  EXPECT_FALSE(value["alpha"][1].has_value());
+  EXPECT_EQ("{\"alpha\":[1,null],\"beta\":[]}", WriteBoundJson(value));
+
+  std::vector<TestPoint> points;
+  ASSERT_TRUE(ReadBoundJson("[{\"y\": 2}]", &points, &error));
+  ASSERT_EQ(1u, points.size());
+  EXPECT_EQ(2, points[0].y);
+}
+
+TEST(JsonBinding, ReadFailure) {
+  TestShape shape;
+  Error error;
+
+  {
+    GlobalLogOverride global_log_override;
+    EXPECT_FALSE(ReadBoundJson("[]", &shape, &error));
+    EXPECT_FALSE(ReadBoundJson("{\"points\": {}}", &shape, &error));
+    EXPECT_FALSE(ReadBoundJson("{\"points\": [{\"x\": \"y\"}]}", &shape,
+                               &error));
+    EXPECT_FALSE(ReadBoundJson("{\"flags\": [true, []]}", &shape, &error));
+    EXPECT_FALSE(ReadBoundJson("{\"scale\": 1", &shape, &error));
+  }
+}
+
+}  // namespace pjcore
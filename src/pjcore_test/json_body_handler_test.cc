@@ -0,0 +1,165 @@
+// JSON [de]serialization for protobuf + embedded HTTP server and client in C++.
+// Copyright (C) 2014 http://protojson.com/
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+#include "pjcore/json_body_handler.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "pjcore/third_party/chromium/bind.h"
+#include "pjcore/third_party/chromium/bind_helpers.h"
+
+#include "pjcore/logging.h"
+#include "pjcore/json_util.h"
+#include "pjcore/json_writer.h"
+#include "pjcore/make_json_value.h"
+#include "pjcore/shared_future-inl.h"
+
+#include "pjcore_test/is_gmock_verbose.h"
+
+namespace pjcore {
+
+namespace {
+
+class JsonBodySink {
+ public:
+  JsonBodySink() : call_count_(0) {}
+
+  // Echoes the request content with 200 OK.
+  void Handle(scoped_ptr<HttpRequest> request, scoped_ptr<JsonValue> body,
+              const HttpResponseCallback& on_response) {
+    ++call_count_;
+    body_ = body.Pass();
+
+    scoped_ptr<HttpResponse> response(new HttpResponse());
+    response->set_status_code(HTTP_STATUS_CODE_OK);
+    response->set_content(request->content());
+    on_response.Run(response.Pass(), Error());
+  }
+
+  int call_count_;
+
+  scoped_ptr<JsonValue> body_;
+};
+
+class JsonBodyHttpHandlerTest : public ::testing::Test {
+ public:
+  JsonBodyHttpHandlerTest()
+      : live_list_(new LiveCapturableList(IsGmockVerbose())),
+        shared_loop_(CreateUvLoop(live_list_.get())) {}
+
+  SharedJsonBodyHttpHandler CreateHandler(size_t min_async_size) {
+    return SharedJsonBodyHttpHandler(new JsonBodyHttpHandler(
+        live_list_.get(), shared_loop_,
+        Bind(&JsonBodySink::Handle, Unretained(&sink_)),
+        JsonReaderConfig::default_instance(), min_async_size));
+  }
+
+  static scoped_ptr<HttpRequest> MakeRequest(StringPiece content) {
+    scoped_ptr<HttpRequest> request(new HttpRequest());
+    content.CopyToString(request->mutable_content());
+    return request.Pass();
+  }
+
+  scoped_ptr<LiveCapturableList> live_list_;
+
+  SharedUvLoop shared_loop_;
+
+  JsonBodySink sink_;
+};
+
+}  // unnamed namespace
+
+TEST_F(JsonBodyHttpHandlerTest, EmptyBody) {
+  ASSERT_TRUE(shared_loop_);
+  SharedJsonBodyHttpHandler handler = CreateHandler(kDefaultMinAsyncJsonSize);
+  SharedFuture future = shared_loop_->CreateFuture();
+
+  ResultErrorPair<scoped_ptr<HttpResponse> > pair;
+  handler->AsyncHandle(MakeRequest(""), future->CreateCallback(&pair));
+  future->Wait();
+
+  EXPECT_EQ(1, sink_.call_count_);
+  EXPECT_FALSE(sink_.body_);
+  ASSERT_TRUE(pair.result_);
+  EXPECT_EQ(HTTP_STATUS_CODE_OK, pair.result_->status_code());
+}
+
+TEST_F(JsonBodyHttpHandlerTest, SmallBody) {
+  ASSERT_TRUE(shared_loop_);
+  SharedJsonBodyHttpHandler handler = CreateHandler(kDefaultMinAsyncJsonSize);
+  SharedFuture future = shared_loop_->CreateFuture();
+
+  ResultErrorPair<scoped_ptr<HttpResponse> > pair;
+  handler->AsyncHandle(MakeRequest("[1, \"alpha\"]"),
+                       future->CreateCallback(&pair));
+  // Small bodies are parsed before returning.
+  EXPECT_EQ(1, sink_.call_count_);
+  future->Wait();
+
+  ASSERT_TRUE(sink_.body_);
+  EXPECT_TRUE(AreJsonValuesEqual(MakeJsonArray(1, "alpha"), *sink_.body_));
+  ASSERT_TRUE(pair.result_);
+  EXPECT_EQ(HTTP_STATUS_CODE_OK, pair.result_->status_code());
+  EXPECT_EQ("[1, \"alpha\"]", pair.result_->content());
+}
+
+TEST_F(JsonBodyHttpHandlerTest, LargeBody) {
+  ASSERT_TRUE(shared_loop_);
+  JsonValue value = MakeJsonArray();
+  for (int index = 0; index < 1000; ++index) {
+    *value.add_array_elements() = MakeJsonObject("index", index);
+  }
+  std::string content = WriteJson(value);
+
+  SharedJsonBodyHttpHandler handler = CreateHandler(content.size() - 1);
+  SharedFuture future = shared_loop_->CreateFuture();
+
+  ResultErrorPair<scoped_ptr<HttpResponse> > pair;
+  handler->AsyncHandle(MakeRequest(content), future->CreateCallback(&pair));
+  // Parsed on the thread pool, so the callback runs on the loop later.
+  EXPECT_EQ(0, sink_.call_count_);
+  future->Wait();
+
+  EXPECT_EQ(1, sink_.call_count_);
+  ASSERT_TRUE(sink_.body_);
+  EXPECT_TRUE(AreJsonValuesEqual(value, *sink_.body_));
+  ASSERT_TRUE(pair.result_);
+  EXPECT_EQ(HTTP_STATUS_CODE_OK, pair.result_->status_code());
+  EXPECT_EQ(content, pair.result_->content());
+}
+
+TEST_F(JsonBodyHttpHandlerTest, MalformedBody) {
+  ASSERT_TRUE(shared_loop_);
+  SharedJsonBodyHttpHandler handler = CreateHandler(kDefaultMinAsyncJsonSize);
+  SharedFuture future = shared_loop_->CreateFuture();
+
+  ResultErrorPair<scoped_ptr<HttpResponse> > pair;
+  {
+    GlobalLogOverride global_log_override;
+    handler->AsyncHandle(MakeRequest("[1,"), future->CreateCallback(&pair));
+    future->Wait();
+  }
+
+  EXPECT_EQ(0, sink_.call_count_);
+  ASSERT_TRUE(pair.result_);
+  EXPECT_EQ(HTTP_STATUS_CODE_BAD_REQUEST, pair.result_->status_code());
+  EXPECT_FALSE(pair.result_->content().empty());
+}
+
+}  // namespace pjcore
@@ -0,0 +1,294 @@
+// JSON [de]serialization for protobuf + embedded HTTP server and client in C++.
+// Copyright (C) 2014 http://protojson.com/
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+#include "pjcore/json_codec.h"
+
+#include <gtest/gtest.h>
+
+#include <limits>
+#include <string>
+
+#include "pjcore_test/test_message.pjcore.h"
+#include "pjcore/error_util.h"
+#include "pjcore/json_util.h"
+
+namespace pjcore {
+
+namespace {
+
+std::vector<JsonWriterConfig> GetWriterConfigs() {
+  std::vector<JsonWriterConfig> configs(4);
+  configs[1].set_indent(2);
+  configs[1].set_space(true);
+  configs[2].set_escape_unicode(true);
+  configs[3].set_null_for_nan_and_infinity(true);
+  return configs;
+}
+
+template <typename Message>
+::testing::AssertionResult TestWrite(const Message& message) {
+  std::vector<JsonWriterConfig> configs = GetWriterConfigs();
+  for (size_t index = 0; index < configs.size(); ++index) {
+    std::string expected = WriteJson(MakeJsonValue(message), configs[index]);
+    std::string actual = WriteGeneratedJson(message, configs[index]);
+    if (actual != expected) {
+      return ::testing::AssertionFailure()
+             << "Config " << index << ": " << actual << " != " << expected;
+    }
+  }
+  return ::testing::AssertionSuccess();
+}
+
+template <typename Message>
+::testing::AssertionResult TestRead(
+    StringPiece str,
+    const JsonReaderConfig& config = JsonReaderConfig::default_instance()) {
+  Message expected;
+  Error expected_error;
+  JsonValue expected_unknown = MakeJsonObject();
+  JsonValue json_value;
+  bool expected_success =
+      ReadJson(str, &json_value, &expected_error, config) &&
+      UnboxJsonValue(json_value, &expected, &expected_error,
+                     expected_unknown.mutable_object_properties());
+
+  Message actual;
+  Error actual_error;
+  JsonValue actual_unknown = MakeJsonObject();
+  bool actual_success =
+      ReadGeneratedJson(str, &actual, &actual_error, config,
+                        actual_unknown.mutable_object_properties());
+
+  if (actual_success != expected_success) {
+    return ::testing::AssertionFailure()
+           << str << ": generated "
+           << (actual_success ? "succeeded" : ErrorToString(actual_error))
+           << ", reflective "
+           << (expected_success ? "succeeded" : ErrorToString(expected_error));
+  }
+
+  if (!expected_success) {
+    return ::testing::AssertionSuccess();
+  }
+
+  if (actual.SerializeAsString() != expected.SerializeAsString()) {
+    return ::testing::AssertionFailure() << str << ": " << actual.DebugString()
+                                         << " != " << expected.DebugString();
+  }
+
+  std::string diff_path;
+  if (!AreJsonValuesEqual(actual_unknown, expected_unknown, &diff_path)) {
+    return ::testing::AssertionFailure()
+           << str << ": unknown properties differ at " << diff_path << ": "
+           << WriteJson(actual_unknown)
+           << " != " << WriteJson(expected_unknown);
+  }
+
+  return ::testing::AssertionSuccess();
+}
+
+TestMessage MakeFullTestMessage() {
+  TestMessage message;
+  message.set_optional_int32(-12);
+  message.set_optional_int64(std::numeric_limits<int64_t>::min());
+  message.set_optional_uint32(34);
+  message.set_optional_uint64(std::numeric_limits<uint64_t>::max());
+  message.set_optional_double(0.25);
+  message.set_optional_float(1.5f);
+  message.set_optional_bool(true);
+  message.set_optional_enum(TestMessage::TEST_BETA);
+  message.set_optional_string("a\"b\\c\xd0\xb4\t");
+  message.set_optional_bytes(std::string("\0\xff\x10", 3));
+  message.mutable_optional_message()->set_optional_int32(5);
+
+  message.add_repeated_int32(1);
+  message.add_repeated_int32(-2);
+  message.add_repeated_int64(3);
+  message.add_repeated_uint32(4);
+  message.add_repeated_uint64(5);
+  message.add_repeated_double(std::numeric_limits<double>::infinity());
+  message.add_repeated_double(-0.5);
+  message.add_repeated_float(std::numeric_limits<float>::quiet_NaN());
+  message.add_repeated_bool(false);
+  message.add_repeated_enum(TestMessage::TEST_ALPHA);
+  message.add_repeated_string("");
+  message.add_repeated_string("x");
+  message.add_repeated_bytes("xyz");
+  message.add_repeated_message();
+  message.add_repeated_message()->add_repeated_string("nested");
+  return message;
+}
+
+}  // unnamed namespace
+
+TEST(JsonCodec, WriteEmpty) {
+  EXPECT_TRUE(TestWrite(TestMessage()));
+  EXPECT_TRUE(TestWrite(TestMessageWithObjectProperties()));
+  EXPECT_TRUE(TestWrite(TestMessageWithStringMap()));
+}
+
+TEST(JsonCodec, WriteFull) { EXPECT_TRUE(TestWrite(MakeFullTestMessage())); }
+
+TEST(JsonCodec, WriteObjectProperties) {
+  TestMessageWithObjectProperties message;
+  JsonValue::Property* property = message.add_object_properties();
+  property->set_name("z");
+  *property->mutable_value() = MakeJsonArray(1, "two", MakeJsonObject());
+  property = message.add_object_properties();
+  property->set_name("a");
+  *property->mutable_value() = MakeJsonValue(true);
+
+  EXPECT_TRUE(TestWrite(message));
+}
+
+TEST(JsonCodec, WriteMap) {
+  TestMessageWithIntMap message;
+  TestMessageWithIntMap::Entry* entry = message.add_entries();
+  entry->set_name(7);
+  entry->set_data("seven");
+
+  EXPECT_TRUE(TestWrite(message));
+}
+
+TEST(JsonCodec, WriteMasked) {
+  TestMessage message = MakeFullTestMessage();
+  JsonFieldMask mask(
+      "optional_int32,optional_message.optional_int32,"
+      "repeated_message.repeated_string,repeated_enum");
+
+  EXPECT_EQ(WriteJson(MakeJsonValue(message, mask)),
+            WriteGeneratedJson(message, mask));
+  EXPECT_EQ(WriteGeneratedJson(message),
+            WriteGeneratedJson(message, JsonFieldMask()));
+
+  TestMessageWithObjectProperties with_properties;
+  *with_properties.add_object_properties() = MakeJsonProperty("alpha", 1);
+  *with_properties.add_object_properties() = MakeJsonProperty("beta", 2);
+  EXPECT_EQ("{\"alpha\":1}",
+            WriteGeneratedJson(with_properties, JsonFieldMask("alpha")));
+}
+
+TEST(JsonCodec, RoundTrip) {
+  TestMessage message = MakeFullTestMessage();
+  message.mutable_repeated_double()->RemoveLast();
+  message.clear_repeated_float();
+
+  TestMessage read;
+  Error error;
+  ASSERT_TRUE(ReadGeneratedJson(WriteGeneratedJson(message), &read, &error))
+      << ErrorToString(error);
+  EXPECT_EQ(message.SerializeAsString(), read.SerializeAsString());
+}
+
+TEST(JsonCodec, ReadScalars) {
+  EXPECT_TRUE(TestRead<TestMessage>("{}"));
+  EXPECT_TRUE(TestRead<TestMessage>(
+      "{\"optional_int32\": -5, \"optional_int64\": \"-9007199254740993\","
+      " \"optional_uint32\": 7.0, \"optional_uint64\": 18446744073709551615,"
+      " \"optional_double\": 1e300, \"optional_float\": \"2.5\","
+      " \"optional_bool\": false, \"optional_string\": \"\\u0434\"}"));
+  EXPECT_TRUE(TestRead<TestMessage>("{\"optional_int32\": 2147483648}"));
+  EXPECT_TRUE(TestRead<TestMessage>("{\"optional_uint32\": -1}"));
+  EXPECT_TRUE(TestRead<TestMessage>("{\"optional_bool\": 1}"));
+  EXPECT_TRUE(TestRead<TestMessage>("{\"optional_string\": 1}"));
+  EXPECT_TRUE(TestRead<TestMessage>("{\"optional_int32\": null}"));
+}
+
+TEST(JsonCodec, ReadEnum) {
+  EXPECT_TRUE(TestRead<TestMessage>("{\"optional_enum\": \"TEST_BETA\"}"));
+  EXPECT_TRUE(TestRead<TestMessage>("{\"optional_enum\": 1}"));
+  EXPECT_TRUE(TestRead<TestMessage>("{\"optional_enum\": \"2\"}"));
+  EXPECT_TRUE(TestRead<TestMessage>("{\"optional_enum\": \"3\"}"));
+  EXPECT_TRUE(TestRead<TestMessage>("{\"optional_enum\": 3}"));
+  EXPECT_TRUE(TestRead<TestMessage>("{\"optional_enum\": \"GAMMA\"}"));
+  EXPECT_TRUE(TestRead<TestMessage>("{\"optional_enum\": true}"));
+  EXPECT_TRUE(TestRead<TestMessage>(
+      "{\"repeated_enum\": [\"TEST_ALPHA\", 2, \"1\", 7, \"x\"]}"));
+}
+
+TEST(JsonCodec, ReadBytes) {
+  EXPECT_TRUE(TestRead<TestMessage>("{\"optional_bytes\": \"AP8Q\"}"));
+  EXPECT_TRUE(TestRead<TestMessage>("{\"optional_bytes\": \"AP8\"}"));
+  EXPECT_TRUE(TestRead<TestMessage>("{\"repeated_bytes\": [\"\", \"eHl6\"]}"));
+}
+
+TEST(JsonCodec, ReadRepeated) {
+  EXPECT_TRUE(TestRead<TestMessage>(
+      "{\"repeated_int32\": [1, -2], \"repeated_double\": [0.5, 3],"
+      " \"repeated_string\": [\"a\", \"b\"], \"repeated_message\":"
+      " [{}, {\"optional_int32\": 1}]}"));
+  EXPECT_TRUE(TestRead<TestMessage>("{\"repeated_int32\": 1}"));
+  EXPECT_TRUE(TestRead<TestMessage>("{\"repeated_int32\": [1, \"x\"]}"));
+  EXPECT_TRUE(TestRead<TestMessage>("{\"repeated_int32\": null}"));
+  EXPECT_TRUE(TestRead<TestMessage>("{\"repeated_message\": {}}"));
+}
+
+TEST(JsonCodec, ReadDuplicates) {
+  EXPECT_TRUE(TestRead<TestMessage>(
+      "{\"optional_int32\": 1, \"optional_int32\": 2}"));
+  EXPECT_TRUE(TestRead<TestMessage>(
+      "{\"optional_int32\": 1, \"optional_int32\": \"bad\"}"));
+
+  JsonReaderConfig as_is;
+  as_is.set_properties_as_is(true);
+  EXPECT_TRUE(TestRead<TestMessage>(
+      "{\"optional_int32\": 1, \"optional_int32\": 2}", as_is));
+}
+
+TEST(JsonCodec, ReadUnknown) {
+  EXPECT_TRUE(TestRead<TestMessage>(
+      "{\"zeta\": [1, {\"b\": 2, \"a\": 3}], \"alpha\": null,"
+      " \"zeta\": false, \"optional_int32\": 4}"));
+  EXPECT_TRUE(TestRead<TestMessage>(
+      "{\"optional_message\": {\"inner\": 1}, \"outer\": 2}"));
+
+  JsonReaderConfig as_is;
+  as_is.set_properties_as_is(true);
+  EXPECT_TRUE(
+      TestRead<TestMessage>("{\"b\": 1, \"a\": 2, \"b\": 3}", as_is));
+}
+
+TEST(JsonCodec, ReadObjectProperties) {
+  EXPECT_TRUE(TestRead<TestMessageWithObjectProperties>(
+      "{\"z\": [1, 2], \"a\": {\"y\": 1, \"x\": 2}, \"a\": 3}"));
+  EXPECT_TRUE(TestRead<TestMessageWithObjectProperties>(
+      "{\"object_properties\": [{\"name\": \"a\", \"value\": 1}]}"));
+}
+
+TEST(JsonCodec, ReadMap) {
+  EXPECT_TRUE(TestRead<TestMessageWithStringMap>(
+      "{\"entries\": {\"b\": {\"data\": 1}, \"a\": {\"data\": 2},"
+      " \"b\": {\"data\": 3}}}"));
+  EXPECT_TRUE(TestRead<TestMessageWithStringMap>(
+      "{\"entries\": [{\"name\": \"a\", \"data\": 1}]}"));
+  EXPECT_TRUE(TestRead<TestMessageWithStringMap>(
+      "{\"entries\": {\"a\": {\"data\": 1, \"extra\": 2}}}"));
+  EXPECT_TRUE(TestRead<TestMessageWithIntMap>(
+      "{\"entries\": {\"10\": {\"data\": \"ten\"}, \"9\": {}}}"));
+  EXPECT_TRUE(
+      TestRead<TestMessageWithIntMap>("{\"entries\": {\"x\": {}}}"));
+}
+
+TEST(JsonCodec, ReadFailure) {
+  EXPECT_TRUE(TestRead<TestMessage>("[]"));
+  EXPECT_TRUE(TestRead<TestMessage>("null"));
+  EXPECT_TRUE(TestRead<TestMessage>("{\"optional_int32\": }"));
+  EXPECT_TRUE(TestRead<TestMessage>("{} {}"));
+  EXPECT_TRUE(TestRead<TestMessage>("{\"optional_message\": 1}"));
+}
+
+}  // namespace pjcore
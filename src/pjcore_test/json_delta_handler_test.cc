@@ -0,0 +1,250 @@
+// JSON [de]serialization for protobuf + embedded HTTP server and client in C++.
+// Copyright (C) 2014 http://protojson.com/
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+
+#include "pjcore/json_delta_handler.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "pjcore/error_util.h"
+#include "pjcore/json_patch.h"
+#include "pjcore/json_properties.h"
+#include "pjcore/json_reader.h"
+#include "pjcore/json_util.h"
+#include "pjcore/logging.h"
+#include "pjcore/make_json_value.h"
+#include "pjcore/unbox_json_value.h"
+
+namespace pjcore {
+
+namespace {
+
+class JsonDeltaHttpHandlerTest : public ::testing::Test {
+ public:
+  JsonDeltaHttpHandlerTest()
+      : live_list_(new LiveCapturableList(false)),
+        handler_(new JsonDeltaHttpHandler(
+            live_list_.get(),
+            MakeJsonObject("items", MakeJsonArray(1, 2, 3), "title",
+                           std::string(200, 'x')),
+            3)) {}
+
+  // Sends header_value, if any, as a header named header_name, and the
+  // If-None-Match header if_none_match, if any.
+  HttpResponse Get(StringPiece if_none_match, StringPiece header_name = "",
+                   StringPiece header_value = "") {
+    HttpRequest request;
+    if (!if_none_match.empty()) {
+      HttpHeader* header = request.add_headers();
+      header->set_name("if-none-match");
+      if_none_match.CopyToString(header->mutable_value());
+    }
+    if (!header_value.empty()) {
+      HttpHeader* header = request.add_headers();
+      header_name.CopyToString(header->mutable_name());
+      header_value.CopyToString(header->mutable_value());
+    }
+
+    HttpResponse response;
+    handler_->MakeResponse(request, &response);
+    return response;
+  }
+
+  HttpResponse GetDelta(StringPiece if_none_match) {
+    return Get(if_none_match, "A-IM", "json-patch");
+  }
+
+  std::string GetEntityTag() { return GetHeader(Get(""), "ETag"); }
+
+  static std::string GetHeader(const HttpResponse& response,
+                               StringPiece name) {
+    for (int index = 0; index < response.headers_size(); ++index) {
+      if (response.headers(index).name() == name) {
+        return response.headers(index).value();
+      }
+    }
+    return std::string();
+  }
+
+  void UpdateItems(int last) {
+    JsonValue document(handler_->document());
+    *GetMutableJsonProperty(&document, "items")->add_array_elements() =
+        MakeJsonValue(last);
+    handler_->Update(document);
+  }
+
+  scoped_ptr<LiveCapturableList> live_list_;
+
+  SharedJsonDeltaHttpHandler handler_;
+};
+
+}  // unnamed namespace
+
+TEST_F(JsonDeltaHttpHandlerTest, FullDocument) {
+  HttpResponse response = Get("");
+  EXPECT_EQ(HTTP_STATUS_CODE_OK, response.status_code());
+  std::string entity_tag = GetHeader(response, "ETag");
+  EXPECT_EQ(0u, entity_tag.find("\"0-"));
+  EXPECT_EQ("A-IM, Accept", GetHeader(response, "Vary"));
+  EXPECT_EQ("application/json", GetHeader(response, "Content-Type"));
+
+  JsonValue document;
+  Error error;
+  ASSERT_TRUE(ReadJson(response.content(), &document, &error));
+  EXPECT_TRUE(AreJsonValuesEqual(handler_->document(), document));
+
+  EXPECT_EQ(HTTP_STATUS_CODE_OK, GetDelta("\"17\"").status_code());
+  EXPECT_EQ(HTTP_STATUS_CODE_OK, GetDelta("0").status_code());
+  // A bare version is not enough to name the document.
+  EXPECT_EQ(HTTP_STATUS_CODE_OK, GetDelta("\"0\"").status_code());
+}
+
+TEST_F(JsonDeltaHttpHandlerTest, EntityTag) {
+  std::string entity_tag = GetEntityTag();
+
+  // Another instance at the same version with other content has another tag.
+  SharedJsonDeltaHttpHandler other(
+      new JsonDeltaHttpHandler(live_list_.get(), MakeJsonArray(1), 3));
+  HttpResponse other_response;
+  other->MakeResponse(HttpRequest(), &other_response);
+  EXPECT_NE(entity_tag, GetHeader(other_response, "ETag"));
+
+  // The same content has the same tag.
+  SharedJsonDeltaHttpHandler same(
+      new JsonDeltaHttpHandler(live_list_.get(), handler_->document(), 3));
+  HttpResponse same_response;
+  same->MakeResponse(HttpRequest(), &same_response);
+  EXPECT_EQ(entity_tag, GetHeader(same_response, "ETag"));
+}
+
+TEST_F(JsonDeltaHttpHandlerTest, NotModified) {
+  std::string entity_tag = GetEntityTag();
+  handler_->Update(handler_->document());
+  EXPECT_EQ(0u, handler_->version());
+  EXPECT_EQ(entity_tag, GetEntityTag());
+
+  EXPECT_EQ(HTTP_STATUS_CODE_NOT_MODIFIED, Get(entity_tag).status_code());
+  EXPECT_EQ(HTTP_STATUS_CODE_NOT_MODIFIED,
+            Get("W/" + entity_tag).status_code());
+  EXPECT_EQ(HTTP_STATUS_CODE_NOT_MODIFIED,
+            Get("\"5\", " + entity_tag).status_code());
+  EXPECT_EQ(HTTP_STATUS_CODE_NOT_MODIFIED, Get("*").status_code());
+  EXPECT_EQ(HTTP_STATUS_CODE_NOT_MODIFIED,
+            GetDelta(entity_tag).status_code());
+  EXPECT_TRUE(Get(entity_tag).content().empty());
+}
+
+TEST_F(JsonDeltaHttpHandlerTest, Delta) {
+  JsonValue base(handler_->document());
+  std::string base_entity_tag = GetEntityTag();
+
+  UpdateItems(4);
+  std::string middle_entity_tag = GetEntityTag();
+  UpdateItems(5);
+  EXPECT_EQ(2u, handler_->version());
+
+  HttpResponse response = GetDelta(base_entity_tag);
+  EXPECT_EQ(HTTP_STATUS_CODE_IM_USED, response.status_code());
+  EXPECT_EQ(GetEntityTag(), GetHeader(response, "ETag"));
+  EXPECT_EQ("json-patch", GetHeader(response, "IM"));
+  EXPECT_EQ("no-store", GetHeader(response, "Cache-Control"));
+  EXPECT_EQ("A-IM, Accept", GetHeader(response, "Vary"));
+  EXPECT_EQ("application/json-patch+json",
+            GetHeader(response, "Content-Type"));
+
+  JsonValue patch;
+  Error error;
+  ASSERT_TRUE(ReadJson(response.content(), &patch, &error));
+  EXPECT_EQ(2, patch.array_elements_size());
+  ASSERT_TRUE(ApplyJsonPatch(patch, &base, &error));
+  EXPECT_TRUE(AreJsonValuesEqual(handler_->document(), base));
+
+  // The newest matching version is used as the base.
+  ASSERT_TRUE(ReadJson(
+      GetDelta(base_entity_tag + ", " + middle_entity_tag).content(), &patch,
+      &error));
+  EXPECT_EQ(1, patch.array_elements_size());
+
+  // Accepting the patch media type asks for deltas too.
+  EXPECT_EQ(HTTP_STATUS_CODE_IM_USED,
+            Get(base_entity_tag, "Accept",
+                "application/json, application/json-patch+json")
+                .status_code());
+  EXPECT_EQ(HTTP_STATUS_CODE_IM_USED,
+            Get(base_entity_tag, "a-im", "vcdiff, JSON-Patch;q=0.5")
+                .status_code());
+}
+
+TEST_F(JsonDeltaHttpHandlerTest, DeltaResponseRoundTrip) {
+  std::string base_entity_tag = GetEntityTag();
+  UpdateItems(4);
+
+  HttpResponse response = GetDelta(base_entity_tag);
+  ASSERT_EQ(HTTP_STATUS_CODE_IM_USED, response.status_code());
+
+  // Logging and live capture convert responses through reflection.
+  JsonValue json_value = MakeJsonValue(response);
+  EXPECT_EQ("HTTP_STATUS_CODE_IM_USED",
+            GetJsonProperty(json_value, "status_code").string_value());
+
+  HttpResponse unboxed;
+  Error error;
+  ASSERT_TRUE(UnboxJsonValue(json_value, &unboxed, &error))
+      << ErrorToString(error);
+  EXPECT_EQ(response.SerializeAsString(), unboxed.SerializeAsString());
+}
+
+TEST_F(JsonDeltaHttpHandlerTest, PlainConditionalRequest) {
+  std::string base_entity_tag = GetEntityTag();
+  UpdateItems(4);
+
+  // Without A-IM or Accept asking for it, a stale tag gets the document.
+  HttpResponse response = Get(base_entity_tag);
+  EXPECT_EQ(HTTP_STATUS_CODE_OK, response.status_code());
+  EXPECT_EQ("application/json", GetHeader(response, "Content-Type"));
+  EXPECT_EQ("", GetHeader(response, "Cache-Control"));
+  EXPECT_EQ(HTTP_STATUS_CODE_OK,
+            Get(base_entity_tag, "Accept", "application/json").status_code());
+}
+
+TEST_F(JsonDeltaHttpHandlerTest, Retention) {
+  std::string first_entity_tag = GetEntityTag();
+  UpdateItems(4);
+  std::string second_entity_tag = GetEntityTag();
+  UpdateItems(5);
+  UpdateItems(6);
+
+  EXPECT_EQ("application/json",
+            GetHeader(GetDelta(first_entity_tag), "Content-Type"));
+  EXPECT_EQ("application/json-patch+json",
+            GetHeader(GetDelta(second_entity_tag), "Content-Type"));
+}
+
+TEST_F(JsonDeltaHttpHandlerTest, LargePatch) {
+  std::string base_entity_tag = GetEntityTag();
+  handler_->Update(MakeJsonArray(1, 2));
+
+  // Replacing the whole document is no smaller than the document itself.
+  HttpResponse response = GetDelta(base_entity_tag);
+  EXPECT_EQ(HTTP_STATUS_CODE_OK, response.status_code());
+  EXPECT_EQ("application/json", GetHeader(response, "Content-Type"));
+  EXPECT_EQ("[1,2]", response.content());
+}
+
+}  // namespace pjcore
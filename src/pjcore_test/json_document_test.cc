@@ -0,0 +1,139 @@
+// JSON [de]serialization for protobuf + embedded HTTP server and client in C++.
+// Copyright (C) 2014 http://protojson.com/
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+
+#include "pjcore/json_document.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "pjcore/json_writer.h"
+#include "pjcore/logging.h"
+#include "pjcore/make_json_value.h"
+#include "pjcore_test/read_json_or_die.h"
+
+namespace pjcore {
+
+namespace {
+
+::testing::AssertionResult IsJsonCurrent(JsonDocument* document) {
+  std::string expected = WriteJson(document->value(), document->config());
+  const std::string& actual = document->GetJson();
+  if (actual != expected) {
+    return ::testing::AssertionFailure() << actual << " instead of "
+                                         << expected;
+  }
+  return ::testing::AssertionSuccess();
+}
+
+void TestEdits(const JsonWriterConfig& config) {
+  JsonDocument document(config);
+  EXPECT_TRUE(IsJsonCurrent(&document));
+
+  Error error;
+  JsonValue* root = document.MutableValue("", &error);
+  ASSERT_TRUE(root);
+  *root = ReadJsonOrDie(
+      "{\"alpha\": {\"beta\": [1, 2, 3], \"gamma\": [{\"delta\": \"a/b\"}, "
+      "[], {}]}, \"epsilon\": null, \"zeta\": [[true], [false]]}");
+  EXPECT_TRUE(IsJsonCurrent(&document));
+  // Unchanged.
+  EXPECT_TRUE(IsJsonCurrent(&document));
+
+  JsonValue* delta = document.MutableValue("/alpha/gamma/0/delta", &error);
+  ASSERT_TRUE(delta);
+  *delta = MakeJsonValue("\xCE\xB1");
+  EXPECT_TRUE(IsJsonCurrent(&document));
+
+  // Unpacks the array.
+  ASSERT_TRUE(document.MutableValue("/alpha/beta/1", &error));
+  document.MutableValue("/alpha/beta/1", &error)->set_signed_value(-2);
+  EXPECT_TRUE(IsJsonCurrent(&document));
+
+  *document.MutableValue("/alpha/gamma/1/-", &error) = MakeJsonArray(4, 5);
+  *document.MutableValue("/alpha/gamma/0", &error) = MakeJsonObject("eta", 6);
+  EXPECT_TRUE(IsJsonCurrent(&document));
+
+  *document.MutableValue("/alpha/gamma/2/theta", &error) = MakeJsonValue(7);
+  *document.MutableValue("/alpha/beta/0", &error) = MakeJsonObject();
+  *document.MutableValue("/alpha/beta/0/iota", &error) = MakeJsonArray();
+  EXPECT_TRUE(IsJsonCurrent(&document));
+
+  *document.MutableValue("/alpha/beta/0/iota/-", &error) = MakeJsonValue(8);
+  *document.MutableValue("/alpha/delta", &error) = MakeJsonValue(9);
+  *document.MutableValue("/zeta/0", &error) = MakeJsonValue("kappa");
+  // Inserted in name order.
+  const JsonValue& alpha = document.value().object_properties(0).value();
+  EXPECT_EQ("delta", alpha.object_properties(1).name());
+  // Found rather than added again.
+  EXPECT_EQ(9, document.MutableValue("/alpha/delta", &error)->signed_value());
+  EXPECT_EQ(3, alpha.object_properties_size());
+  EXPECT_TRUE(IsJsonCurrent(&document));
+
+  EXPECT_TRUE(document.RemoveValue("/alpha/gamma/1", &error));
+  EXPECT_TRUE(document.RemoveValue("/epsilon", &error));
+  EXPECT_TRUE(IsJsonCurrent(&document));
+
+  EXPECT_TRUE(document.RemoveValue("/zeta/1/0", &error));
+  EXPECT_TRUE(document.RemoveValue("/alpha/beta/0/iota/0", &error));
+  EXPECT_TRUE(IsJsonCurrent(&document));
+
+  EXPECT_TRUE(document.RemoveValue("/alpha", &error));
+  EXPECT_TRUE(document.RemoveValue("/zeta", &error));
+  EXPECT_TRUE(IsJsonCurrent(&document));
+  EXPECT_TRUE(document.GetJson().find("{}") != std::string::npos);
+}
+
+}  // unnamed namespace
+
+TEST(JsonDocument, GetJson) {
+  TestEdits(JsonWriterConfig::default_instance());
+
+  JsonWriterConfig space;
+  space.set_space(true);
+  TestEdits(space);
+
+  JsonWriterConfig indent;
+  indent.set_indent(2);
+  indent.set_include_byte_order_mark(true);
+  indent.set_escape_unicode(true);
+  TestEdits(indent);
+}
+
+TEST(JsonDocument, Errors) {
+  JsonDocument document;
+  Error error;
+  *document.MutableValue("", &error) =
+      MakeJsonObject("alpha", MakeJsonArray(1, 2), "beta", "gamma");
+  ASSERT_TRUE(IsJsonCurrent(&document));
+
+  {
+    GlobalLogOverride global_log_override;
+    EXPECT_FALSE(document.MutableValue("alpha", &error));
+    EXPECT_FALSE(document.MutableValue("/delta/0", &error));
+    EXPECT_FALSE(document.MutableValue("/alpha/3", &error));
+    EXPECT_FALSE(document.MutableValue("/beta/0", &error));
+    EXPECT_FALSE(document.RemoveValue("", &error));
+    EXPECT_FALSE(document.RemoveValue("/delta", &error));
+    EXPECT_FALSE(document.RemoveValue("/alpha/-", &error));
+  }
+
+  EXPECT_EQ("{\"alpha\":[1,2],\"beta\":\"gamma\"}", document.GetJson());
+}
+
+}  // namespace pjcore
@@ -0,0 +1,182 @@
+// JSON [de]serialization for protobuf + embedded HTTP server and client in C++.
+// Copyright (C) 2014 http://protojson.com/
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+
+#include "pjcore/json_field_mask.h"
+
+#include <gtest/gtest.h>
+
+#include "pjcore_test/test_message.pb.h"
+#include "pjcore/error_util.h"
+#include "pjcore/json_util.h"
+#include "pjcore/json_writer.h"
+#include "pjcore/make_json_value.h"
+#include "pjcore/unbox_json_value.h"
+
+namespace pjcore {
+
+namespace {
+
+TestMessage MakeTestMessage() {
+  TestMessage message;
+  message.set_optional_int32(1);
+  message.set_optional_string("two");
+  message.mutable_optional_message()->set_optional_int32(3);
+  message.mutable_optional_message()->set_optional_bool(true);
+  message.add_repeated_message()->set_optional_int32(4);
+  message.add_repeated_message()->set_optional_string("five");
+  return message;
+}
+
+}  // unnamed namespace
+
+TEST(JsonFieldMask, Empty) {
+  JsonFieldMask mask;
+  EXPECT_TRUE(mask.selects_all());
+  EXPECT_EQ(&mask, mask.Find("anything"));
+
+  JsonFieldMask blank_mask(",,");
+  EXPECT_TRUE(blank_mask.selects_all());
+}
+
+TEST(JsonFieldMask, Paths) {
+  JsonFieldMask mask("alpha.beta,gamma,alpha.delta.epsilon");
+  EXPECT_FALSE(mask.selects_all());
+  EXPECT_EQ(NULL, mask.Find("beta"));
+  EXPECT_EQ(NULL, mask.Find("alph"));
+
+  const JsonFieldMask* gamma = mask.Find("gamma");
+  ASSERT_TRUE(gamma);
+  EXPECT_TRUE(gamma->selects_all());
+
+  const JsonFieldMask* alpha = mask.Find("alpha");
+  ASSERT_TRUE(alpha);
+  EXPECT_FALSE(alpha->selects_all());
+  EXPECT_TRUE(alpha->Find("beta"));
+  EXPECT_EQ(NULL, alpha->Find("gamma"));
+
+  const JsonFieldMask* delta = alpha->Find("delta");
+  ASSERT_TRUE(delta);
+  EXPECT_FALSE(delta->selects_all());
+  EXPECT_TRUE(delta->Find("epsilon"));
+}
+
+TEST(JsonFieldMask, ShorterPathWins) {
+  JsonFieldMask mask("alpha.beta");
+  mask.AddPath("alpha");
+  mask.AddPath("alpha.gamma");
+
+  const JsonFieldMask* alpha = mask.Find("alpha");
+  ASSERT_TRUE(alpha);
+  EXPECT_TRUE(alpha->selects_all());
+}
+
+TEST(JsonFieldMask, SelectJsonField) {
+  JsonFieldMask all;
+  const JsonFieldMask* field_mask = &all;
+  EXPECT_TRUE(SelectJsonField(NULL, "alpha", &field_mask));
+  EXPECT_EQ(NULL, field_mask);
+
+  JsonFieldMask mask("alpha");
+  EXPECT_TRUE(SelectJsonField(&mask, "alpha", &field_mask));
+  EXPECT_TRUE(field_mask && field_mask->selects_all());
+  EXPECT_FALSE(SelectJsonField(&mask, "beta", &field_mask));
+}
+
+TEST(JsonFieldMask, MakeJsonValue) {
+  TestMessage message = MakeTestMessage();
+
+  EXPECT_TRUE(AreJsonValuesEqual(MakeJsonValue(message),
+                                 MakeJsonValue(message, JsonFieldMask())));
+
+  EXPECT_EQ(
+      "{\"optional_string\":\"two\","
+      "\"optional_message\":{\"optional_bool\":true},"
+      "\"repeated_message\":[{\"optional_int32\":4},{}]}",
+      WriteJson(MakeJsonValue(
+          message, JsonFieldMask("optional_string,"
+                                 "optional_message.optional_bool,"
+                                 "repeated_message.optional_int32,"
+                                 "optional_uint32"))));
+}
+
+TEST(JsonFieldMask, MakeJsonValueObjectProperties) {
+  TestMessageWithObjectProperties message;
+  *message.add_object_properties() = MakeJsonProperty("alpha", 1);
+  *message.add_object_properties() = MakeJsonProperty("beta", 2);
+
+  EXPECT_EQ("{\"beta\":2}",
+            WriteJson(MakeJsonValue(message, JsonFieldMask("beta"))));
+}
+
+TEST(JsonFieldMask, UnboxJsonValue) {
+  JsonValue json_value = MakeJsonValue(MakeTestMessage());
+  *json_value.add_object_properties() = MakeJsonProperty("unknown", 6);
+
+  TestMessage expected;
+  expected.set_optional_string("two");
+  expected.mutable_optional_message()->set_optional_bool(true);
+  expected.add_repeated_message()->set_optional_int32(4);
+  expected.add_repeated_message();
+
+  JsonFieldMask mask(
+      "optional_string,optional_message.optional_bool,"
+      "repeated_message.optional_int32");
+
+  TestMessage unboxed;
+  Error error;
+  JsonValue unknown = MakeJsonObject();
+  ASSERT_TRUE(UnboxJsonValue(json_value, &unboxed, &error, mask,
+                             unknown.mutable_object_properties()))
+      << ErrorToString(error);
+  EXPECT_EQ(expected.SerializeAsString(), unboxed.SerializeAsString());
+  EXPECT_EQ(0, unknown.object_properties_size());
+
+  TestMessage consumed;
+  ASSERT_TRUE(UnboxJsonValue(&json_value, &consumed, &error, mask))
+      << ErrorToString(error);
+  EXPECT_EQ(expected.SerializeAsString(), consumed.SerializeAsString());
+}
+
+TEST(JsonFieldMask, UnboxJsonValueSkipsInvalid) {
+  JsonValue json_value =
+      MakeJsonObject("optional_int32", "invalid", "optional_bool", true);
+
+  TestMessage unboxed;
+  Error error;
+  ASSERT_TRUE(UnboxJsonValue(json_value, &unboxed, &error,
+                             JsonFieldMask("optional_bool")))
+      << ErrorToString(error);
+  EXPECT_FALSE(unboxed.has_optional_int32());
+  EXPECT_TRUE(unboxed.optional_bool());
+}
+
+TEST(JsonFieldMask, UnboxJsonValueNamedEntries) {
+  JsonValue json_value = MakeJsonObject(
+      "entries", MakeJsonObject("alpha", MakeJsonObject("data", 1)));
+
+  TestMessageWithStringMap unboxed;
+  Error error;
+  ASSERT_TRUE(UnboxJsonValue(json_value, &unboxed, &error,
+                             JsonFieldMask("entries.data")))
+      << ErrorToString(error);
+  ASSERT_EQ(1, unboxed.entries_size());
+  EXPECT_FALSE(unboxed.entries(0).has_name());
+  EXPECT_EQ(1, unboxed.entries(0).data());
+}
+
+}  // namespace pjcore
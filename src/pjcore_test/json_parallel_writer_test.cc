@@ -0,0 +1,105 @@
+// JSON [de]serialization for protobuf + embedded HTTP server and client in C++.
+// Copyright (C) 2014 http://protojson.com/
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+
+#include "pjcore/json_parallel_writer.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "pjcore/json_parallel_writer_internal.h"
+#include "pjcore/json_writer.h"
+#include "pjcore/make_json_value.h"
+#include "pjcore/number_util.h"
+#include "pjcore_test/mock_uv_base.h"
+
+namespace pjcore {
+
+namespace {
+
+void ExpectSameAsWriteJson(const JsonValue& value,
+                           const JsonWriterConfig& config) {
+  for (size_t thread_count = 1; thread_count <= 5; ++thread_count) {
+    std::string output = "prefix";
+    WriteJsonParallel(value, &output, config, thread_count, 0);
+    EXPECT_EQ("prefix" + WriteJson(value, config), output);
+  }
+}
+
+void ExpectSameAsWriteJson(const JsonValue& value) {
+  ExpectSameAsWriteJson(value, JsonWriterConfig::default_instance());
+
+  JsonWriterConfig space_config;
+  space_config.set_space(true);
+  ExpectSameAsWriteJson(value, space_config);
+
+  JsonWriterConfig indent_config;
+  indent_config.set_indent(2);
+  indent_config.set_include_byte_order_mark(true);
+  ExpectSameAsWriteJson(value, indent_config);
+}
+
+}  // unnamed namespace
+
+TEST(JsonParallelWriter, WriteJsonParallel) {
+  JsonValue array;
+  array.set_type(JsonValue::TYPE_ARRAY);
+  for (int index = 0; index < 10; ++index) {
+    *array.add_array_elements() = MakeJsonObject(
+        "index", index, "name", "element " + WriteNumber(index),
+        "values", MakeJsonArray(index, "\xCE\xB1", MakeJsonArray()));
+  }
+  ExpectSameAsWriteJson(array);
+
+  JsonValue object;
+  object.set_type(JsonValue::TYPE_OBJECT);
+  for (int index = 0; index < 7; ++index) {
+    JsonValue::Property* property = object.add_object_properties();
+    property->set_name("property" + WriteNumber(index));
+    *property->mutable_value() = array.array_elements(index);
+  }
+  ExpectSameAsWriteJson(object);
+
+  // Written serially.
+  ExpectSameAsWriteJson(MakeJsonArray(1));
+  ExpectSameAsWriteJson(MakeJsonArray(1, 2, 3));
+  ExpectSameAsWriteJson(MakeJsonObject());
+  ExpectSameAsWriteJson(MakeJsonValue("alpha"));
+
+  EXPECT_EQ("[1,\"2\",[]]",
+            WriteJsonParallel(MakeJsonArray(1, "2", MakeJsonArray()),
+                              JsonWriterConfig::default_instance(), 3, 0));
+}
+
+TEST(JsonParallelWriter, NoThreadsWhenSerial) {
+  // Fails on any thread_create.
+  MockUvBase uv;
+
+  JsonValue value = MakeJsonArray(1, "2", MakeJsonArray());
+  std::string output;
+  WriteJsonParallel(value, &output, JsonWriterConfig::default_instance(), 3,
+                    kDefaultMinParallelJsonSize, &uv);
+  EXPECT_EQ(WriteJson(value), output);
+
+  output.clear();
+  WriteJsonParallel(value, &output, JsonWriterConfig::default_instance(), 1, 0,
+                    &uv);
+  EXPECT_EQ(WriteJson(value), output);
+}
+
+}  // namespace pjcore
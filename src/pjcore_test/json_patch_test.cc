@@ -0,0 +1,300 @@
+// JSON [de]serialization for protobuf + embedded HTTP server and client in C++.
+// Copyright (C) 2014 http://protojson.com/
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+
+#include "pjcore/json_patch.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "pjcore/error_util.h"
+#include "pjcore/json_properties.h"
+#include "pjcore/json_reader.h"
+#include "pjcore/json_util.h"
+#include "pjcore/json_writer.h"
+#include "pjcore/logging.h"
+#include "pjcore_test/read_json_or_die.h"
+
+namespace pjcore {
+
+namespace {
+
+::testing::AssertionResult TestPatchRoundTrip(
+    StringPiece from_str, StringPiece to_str,
+    int expected_operation_count = -1,
+    size_t max_array_diff_cells = kDefaultMaxJsonArrayDiffCells) {
+  JsonValue from = ReadJsonOrDie(from_str);
+  JsonValue to = ReadJsonOrDie(to_str);
+
+  JsonValue patch = MakeJsonPatch(from, to, max_array_diff_cells);
+  if (expected_operation_count >= 0 &&
+      patch.array_elements_size() != expected_operation_count) {
+    return ::testing::AssertionFailure() << "Unexpected patch "
+                                         << WriteJson(patch);
+  }
+
+  JsonValue patched(from);
+  Error error;
+  if (!ApplyJsonPatch(patch, &patched, &error)) {
+    return ::testing::AssertionFailure() << ErrorToString(error) << " for "
+                                         << WriteJson(patch);
+  }
+
+  std::string diff_path;
+  if (!AreJsonValuesEqual(patched, to, &diff_path)) {
+    return ::testing::AssertionFailure()
+           << "Difference at " << diff_path << ": " << WriteJson(patched)
+           << " after " << WriteJson(patch);
+  }
+
+  JsonValue merge_patched(from);
+  ApplyJsonMergePatch(MakeJsonMergePatch(from, to), &merge_patched);
+  if (!AreJsonValuesEqual(merge_patched, to, &diff_path)) {
+    return ::testing::AssertionFailure()
+           << "Merge difference at " << diff_path << ": "
+           << WriteJson(merge_patched);
+  }
+
+  return ::testing::AssertionSuccess();
+}
+
+::testing::AssertionResult TestApply(StringPiece target_str,
+                                     StringPiece patch_str,
+                                     StringPiece expected_str) {
+  JsonValue target = ReadJsonOrDie(target_str);
+  Error error;
+  if (!ApplyJsonPatch(ReadJsonOrDie(patch_str), &target, &error)) {
+    return ::testing::AssertionFailure() << ErrorToString(error);
+  }
+
+  if (!AreJsonValuesEqual(target, ReadJsonOrDie(expected_str))) {
+    return ::testing::AssertionFailure() << WriteJson(target);
+  }
+
+  return ::testing::AssertionSuccess();
+}
+
+::testing::AssertionResult TestApplyFailure(StringPiece target_str,
+                                            StringPiece patch_str) {
+  JsonValue target = ReadJsonOrDie(target_str);
+  Error error;
+
+  GlobalLogOverride global_log_override;
+  if (ApplyJsonPatch(ReadJsonOrDie(patch_str), &target, &error)) {
+    return ::testing::AssertionFailure() << "Unexpected success: "
+                                         << WriteJson(target);
+  }
+
+  return ::testing::AssertionSuccess();
+}
+
+}  // unnamed namespace
+
+TEST(JsonPatch, AppendJsonPointerToken) {
+  std::string json_pointer;
+  AppendJsonPointerToken("alpha", &json_pointer);
+  AppendJsonPointerToken("a/b~c", &json_pointer);
+  AppendJsonPointerToken("", &json_pointer);
+  EXPECT_EQ("/alpha/a~1b~0c/", json_pointer);
+}
+
+TEST(JsonPatch, Scalars) {
+  EXPECT_TRUE(TestPatchRoundTrip("1", "1", 0));
+  EXPECT_TRUE(TestPatchRoundTrip("1", "1.0", 0));
+  EXPECT_TRUE(TestPatchRoundTrip("1", "2", 1));
+  EXPECT_TRUE(TestPatchRoundTrip("null", "\"alpha\"", 1));
+  EXPECT_TRUE(TestPatchRoundTrip("[1]", "{\"alpha\":1}", 1));
+}
+
+TEST(JsonPatch, Objects) {
+  EXPECT_TRUE(TestPatchRoundTrip("{}", "{}", 0));
+  EXPECT_TRUE(TestPatchRoundTrip("{\"alpha\":1}", "{\"beta\":1}", 2));
+  EXPECT_TRUE(TestPatchRoundTrip(
+      "{\"alpha\":1,\"beta\":{\"gamma\":[1,2],\"delta\":true},\"zeta\":3}",
+      "{\"alpha\":1,\"beta\":{\"gamma\":[1,2,3],\"delta\":true},\"eta\":3}",
+      3));
+  EXPECT_TRUE(TestPatchRoundTrip("{\"a/b\":1,\"c~d\":2}", "{\"a/b\":2}", 2));
+
+  JsonReaderConfig properties_as_is;
+  properties_as_is.set_properties_as_is(true);
+  JsonValue from;
+  JsonValue to;
+  Error error;
+  ASSERT_TRUE(ReadJson("{\"beta\":1,\"alpha\":2}", &from, &error,
+                       properties_as_is));
+  ASSERT_TRUE(ReadJson("{\"beta\":1,\"alpha\":3}", &to, &error,
+                       properties_as_is));
+  EXPECT_EQ("[{\"op\":\"replace\",\"path\":\"\\/alpha\",\"value\":3}]",
+            WriteJson(MakeJsonPatch(from, to)));
+}
+
+TEST(JsonPatch, Arrays) {
+  EXPECT_TRUE(TestPatchRoundTrip("[]", "[]", 0));
+  EXPECT_TRUE(TestPatchRoundTrip("[]", "[1,2,3]", 3));
+  EXPECT_TRUE(TestPatchRoundTrip("[1,2,3]", "[]", 3));
+  EXPECT_TRUE(TestPatchRoundTrip("[1,2,3,4]", "[1,3,4,5]", 2));
+  EXPECT_TRUE(TestPatchRoundTrip("[1,2,3,4]", "[0,1,2,3,4]", 1));
+  EXPECT_TRUE(TestPatchRoundTrip("[1,2,3,4]", "[4,3,2,1]", 4));
+  EXPECT_TRUE(TestPatchRoundTrip(
+      "[{\"id\":1},{\"id\":2,\"x\":[1]},{\"id\":3}]",
+      "[{\"id\":1},{\"id\":2,\"x\":[1,2]},{\"id\":3},{\"id\":4}]", 2));
+  EXPECT_TRUE(TestPatchRoundTrip("[\"a\",\"b\",\"c\",\"d\",\"e\"]",
+                                 "[\"b\",\"x\",\"d\",\"y\"]"));
+
+  EXPECT_EQ("[{\"op\":\"remove\",\"path\":\"\\/1\"}]",
+            WriteJson(MakeJsonPatch(ReadJsonOrDie("[1,2,3]"),
+                                    ReadJsonOrDie("[1,3]"))));
+}
+
+TEST(JsonPatch, ArraySizeLimit) {
+  EXPECT_TRUE(TestPatchRoundTrip("[1,2,3,4]", "[9,1,2,3]", 2, 1000));
+  EXPECT_TRUE(TestPatchRoundTrip("[1,2,3,4]", "[9,1,2,3]", 4, 3));
+  EXPECT_TRUE(TestPatchRoundTrip("[1,2,3,4,5]", "[9,1,2]", -1, 1));
+  EXPECT_TRUE(TestPatchRoundTrip("[1,2]", "[9,8,7,6,5]", -1, 1));
+}
+
+TEST(JsonPatch, PackedArrays) {
+  JsonValue from = MakeJsonArray(1, 2, 3);
+  PJCORE_CHECK(PackJsonArray(&from));
+  JsonValue to = MakeJsonArray(1, 3, 4);
+  PJCORE_CHECK(PackJsonArray(&to));
+
+  JsonValue patch = MakeJsonPatch(from, to);
+  EXPECT_EQ(2, patch.array_elements_size());
+
+  Error error;
+  ASSERT_TRUE(ApplyJsonPatch(patch, &from, &error));
+  EXPECT_TRUE(AreJsonValuesEqual(to, from));
+}
+
+TEST(JsonPatch, Apply) {
+  EXPECT_TRUE(TestApply(
+      "{\"foo\":\"bar\"}",
+      "[{\"op\":\"add\",\"path\":\"/baz\",\"value\":\"qux\"}]",
+      "{\"baz\":\"qux\",\"foo\":\"bar\"}"));
+  EXPECT_TRUE(TestApply(
+      "{\"foo\":[\"bar\",\"baz\"]}",
+      "[{\"op\":\"add\",\"path\":\"/foo/1\",\"value\":\"qux\"}]",
+      "{\"foo\":[\"bar\",\"qux\",\"baz\"]}"));
+  EXPECT_TRUE(TestApply("{\"foo\":[\"bar\"]}",
+                        "[{\"op\":\"add\",\"path\":\"/foo/-\",\"value\":1}]",
+                        "{\"foo\":[\"bar\",1]}"));
+  EXPECT_TRUE(TestApply("{\"baz\":\"qux\",\"foo\":\"bar\"}",
+                        "[{\"op\":\"remove\",\"path\":\"/baz\"}]",
+                        "{\"foo\":\"bar\"}"));
+  EXPECT_TRUE(TestApply("{\"foo\":[\"bar\",\"qux\",\"baz\"]}",
+                        "[{\"op\":\"remove\",\"path\":\"/foo/1\"}]",
+                        "{\"foo\":[\"bar\",\"baz\"]}"));
+  EXPECT_TRUE(TestApply(
+      "{\"baz\":\"qux\",\"foo\":\"bar\"}",
+      "[{\"op\":\"replace\",\"path\":\"/baz\",\"value\":\"boo\"}]",
+      "{\"baz\":\"boo\",\"foo\":\"bar\"}"));
+  EXPECT_TRUE(TestApply(
+      "{\"foo\":{\"bar\":\"baz\",\"waldo\":\"fred\"},\"qux\":{\"corge\":1}}",
+      "[{\"op\":\"move\",\"from\":\"/foo/waldo\",\"path\":\"/qux/thud\"}]",
+      "{\"foo\":{\"bar\":\"baz\"},\"qux\":{\"corge\":1,\"thud\":\"fred\"}}"));
+  EXPECT_TRUE(TestApply(
+      "{\"foo\":[\"all\",\"grass\",\"cows\",\"eat\"]}",
+      "[{\"op\":\"move\",\"from\":\"/foo/1\",\"path\":\"/foo/3\"}]",
+      "{\"foo\":[\"all\",\"cows\",\"eat\",\"grass\"]}"));
+  EXPECT_TRUE(TestApply(
+      "{\"foo\":{\"bar\":1}}",
+      "[{\"op\":\"copy\",\"from\":\"/foo\",\"path\":\"/baz\"}]",
+      "{\"baz\":{\"bar\":1},\"foo\":{\"bar\":1}}"));
+  EXPECT_TRUE(TestApply(
+      "{\"baz\":\"qux\",\"foo\":[\"a\",2,\"c\"]}",
+      "[{\"op\":\"test\",\"path\":\"/baz\",\"value\":\"qux\"},"
+      "{\"op\":\"test\",\"path\":\"/foo/1\",\"value\":2}]",
+      "{\"baz\":\"qux\",\"foo\":[\"a\",2,\"c\"]}"));
+  EXPECT_TRUE(TestApply("{\"foo\":1}",
+                        "[{\"op\":\"replace\",\"path\":\"\",\"value\":[2]}]",
+                        "[2]"));
+}
+
+TEST(JsonPatch, ApplyFailure) {
+  EXPECT_TRUE(TestApplyFailure("{}", "{}"));
+  EXPECT_TRUE(TestApplyFailure("{}", "[{\"path\":\"/a\"}]"));
+  EXPECT_TRUE(TestApplyFailure("{}", "[{\"op\":\"jump\",\"path\":\"/a\"}]"));
+  EXPECT_TRUE(TestApplyFailure("{}", "[{\"op\":\"add\",\"path\":\"/a\"}]"));
+  EXPECT_TRUE(
+      TestApplyFailure("{}", "[{\"op\":\"add\",\"path\":\"a\",\"value\":1}]"));
+  EXPECT_TRUE(TestApplyFailure(
+      "{}", "[{\"op\":\"add\",\"path\":\"/a/b\",\"value\":1}]"));
+  EXPECT_TRUE(TestApplyFailure("{}", "[{\"op\":\"remove\",\"path\":\"/a\"}]"));
+  EXPECT_TRUE(
+      TestApplyFailure("[1]", "[{\"op\":\"remove\",\"path\":\"\\/1\"}]"));
+  EXPECT_TRUE(
+      TestApplyFailure("[1,2]", "[{\"op\":\"remove\",\"path\":\"/01\"}]"));
+  EXPECT_TRUE(
+      TestApplyFailure("[1]", "[{\"op\":\"remove\",\"path\":\"/-\"}]"));
+  EXPECT_TRUE(TestApplyFailure(
+      "[1]", "[{\"op\":\"add\",\"path\":\"/2\",\"value\":1}]"));
+  EXPECT_TRUE(TestApplyFailure(
+      "{\"a\":1}", "[{\"op\":\"test\",\"path\":\"/a\",\"value\":2}]"));
+  EXPECT_TRUE(TestApplyFailure(
+      "{\"a\":{\"b\":1}}",
+      "[{\"op\":\"move\",\"from\":\"/a\",\"path\":\"/a/c\"}]"));
+  EXPECT_TRUE(TestApplyFailure("{\"a~b\":1}",
+                               "[{\"op\":\"remove\",\"path\":\"/a~b\"}]"));
+}
+
+TEST(JsonMergePatch, Apply) {
+  // Examples from RFC 7386 Appendix A.
+  const char* const kCases[][3] = {
+      {"{\"a\":\"b\"}", "{\"a\":\"c\"}", "{\"a\":\"c\"}"},
+      {"{\"a\":\"b\"}", "{\"b\":\"c\"}", "{\"a\":\"b\",\"b\":\"c\"}"},
+      {"{\"a\":\"b\"}", "{\"a\":null}", "{}"},
+      {"{\"a\":\"b\",\"b\":\"c\"}", "{\"a\":null}", "{\"b\":\"c\"}"},
+      {"{\"a\":[\"b\"]}", "{\"a\":\"c\"}", "{\"a\":\"c\"}"},
+      {"{\"a\":\"c\"}", "{\"a\":[\"b\"]}", "{\"a\":[\"b\"]}"},
+      {"{\"a\":{\"b\":\"c\"}}", "{\"a\":{\"b\":\"d\",\"c\":null}}",
+       "{\"a\":{\"b\":\"d\"}}"},
+      {"{\"a\":[{\"b\":\"c\"}]}", "{\"a\":[1]}", "{\"a\":[1]}"},
+      {"[\"a\",\"b\"]", "[\"c\",\"d\"]", "[\"c\",\"d\"]"},
+      {"{\"a\":\"b\"}", "[\"c\"]", "[\"c\"]"},
+      {"{\"a\":\"foo\"}", "null", "null"},
+      {"{\"a\":\"foo\"}", "\"bar\"", "\"bar\""},
+      {"{\"e\":null}", "{\"a\":1}", "{\"a\":1,\"e\":null}"},
+      {"[1,2]", "{\"a\":\"b\",\"c\":null}", "{\"a\":\"b\"}"},
+      {"{}", "{\"a\":{\"bb\":{\"ccc\":null}}}", "{\"a\":{\"bb\":{}}}"}};
+
+  for (size_t index = 0; index < sizeof(kCases) / sizeof(kCases[0]);
+       ++index) {
+    JsonValue target = ReadJsonOrDie(kCases[index][0]);
+    ApplyJsonMergePatch(ReadJsonOrDie(kCases[index][1]), &target);
+    EXPECT_TRUE(AreJsonValuesEqual(ReadJsonOrDie(kCases[index][2]), target))
+        << index << ": " << WriteJson(target);
+  }
+}
+
+TEST(JsonMergePatch, Make) {
+  EXPECT_EQ("{\"alpha\":null,\"beta\":{\"gamma\":2},\"delta\":[3]}",
+            WriteJson(MakeJsonMergePatch(
+                ReadJsonOrDie("{\"alpha\":1,\"beta\":{\"gamma\":1,\"eta\":1},"
+                              "\"delta\":[1]}"),
+                ReadJsonOrDie("{\"beta\":{\"gamma\":2,\"eta\":1},"
+                              "\"delta\":[3]}"))));
+
+  // Null properties cannot be set by a merge patch, so they are removed.
+  JsonValue target = ReadJsonOrDie("{\"alpha\":1}");
+  ApplyJsonMergePatch(
+      MakeJsonMergePatch(target, ReadJsonOrDie("{\"alpha\":null}")), &target);
+  EXPECT_EQ("{}", WriteJson(target));
+}
+
+}  // namespace pjcore
@@ -19,7 +19,11 @@
 
 #include <gtest/gtest.h>
 
+#include <string>
+#include <vector>
+
 #include "pjcore/json_util.h"
+#include "pjcore/number_util.h"
 
 namespace pjcore {
 
@@ -172,4 +176,83 @@ TEST(JsonProperties, ClearJsonProperty) {
   // TODO(pjcore): implement
 }
 
+TEST(JsonProperties, ClearJsonProperties) {
+  JsonValue object = MakeJsonObject("gamma", 1, "alpha", 2, "beta", 3,
+                                    "alpha", 4, "delta", 5);
+
+  std::vector<std::string> names;
+  names.push_back("epsilon");
+  names.push_back("alpha");
+  names.push_back("delta");
+  ClearJsonProperties(&object, names);
+
+  std::string diff_path;
+  EXPECT_TRUE(AreJsonValuesEqual(MakeJsonObject("gamma", 1, "beta", 3),
+                                 object, &diff_path))
+      << diff_path;
+}
+
+TEST(JsonPropertyBuilder, Commit) {
+  JsonValue object = MakeJsonObject("delta", 1, "beta", 2, "alpha", 3);
+
+  {
+    JsonPropertyBuilder builder(&object);
+    builder.Set("gamma", 4);
+    builder.Set("beta", 5);
+    builder.Clear("alpha");
+    builder.Set("gamma", 6);
+    builder.Clear("delta");
+    builder.Set("delta", 7);
+    builder.Clear("epsilon");
+    *builder.Add("alpha") = MakeJsonArray(8);
+  }
+
+  std::string diff_path;
+  EXPECT_TRUE(AreJsonValuesEqual(
+      MakeJsonObject("alpha", MakeJsonArray(8), "beta", 5, "delta", 7,
+                     "gamma", 6),
+      object, &diff_path)) << diff_path;
+  EXPECT_TRUE(AreJsonPropertiesNormalized(object));
+
+  JsonPropertyList properties;
+  JsonPropertyBuilder builder(&properties);
+  for (int index = 9999; index >= 0; --index) {
+    builder.Set(WriteNumber(index % 5000), index);
+  }
+  builder.Commit();
+
+  ASSERT_EQ(5000, properties.size());
+  EXPECT_TRUE(AreJsonPropertiesNormalized(properties));
+  EXPECT_EQ("0", properties.Get(0).name());
+  EXPECT_EQ(0, properties.Get(0).value().signed_value());
+  EXPECT_EQ("999", properties.Get(4999).name());
+  EXPECT_EQ(999, properties.Get(4999).value().signed_value());
+
+  builder.Clear("1234");
+  builder.Commit();
+  EXPECT_EQ(4999, properties.size());
+}
+
+TEST(JsonPropertyBuilder, LeadingNames) {
+  static const char* const kLeadingNames[] = {"zeta", "epsilon", "eta"};
+
+  JsonValue object = MakeJsonObject("delta", 1, "epsilon", 2, "alpha", 3);
+  {
+    JsonPropertyBuilder builder(
+        &object, kLeadingNames,
+        kLeadingNames + sizeof(kLeadingNames) / sizeof(kLeadingNames[0]));
+    builder.Set("zeta", 4);
+    builder.Set("beta", 5);
+    builder.Set("epsilon", 6);
+  }
+
+  ASSERT_EQ(5, object.object_properties_size());
+  EXPECT_EQ("zeta", object.object_properties(0).name());
+  EXPECT_EQ("epsilon", object.object_properties(1).name());
+  EXPECT_EQ(6, object.object_properties(1).value().signed_value());
+  EXPECT_EQ("alpha", object.object_properties(2).name());
+  EXPECT_EQ("beta", object.object_properties(3).name());
+  EXPECT_EQ("delta", object.object_properties(4).name());
+}
+
 }  // namespace pjcore
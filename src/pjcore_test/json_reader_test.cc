@@ -388,6 +388,85 @@ TEST(JsonReader, PropertiesAsIs) {
                               properties_as_is));
 }
 
+TEST(JsonReader, PackNumericArrays) {
+  JsonReaderConfig pack_numeric_arrays;
+  pack_numeric_arrays.set_pack_numeric_arrays(true);
+
+  const char* const kJsons[] = {
+      "[]", "[1,2,3]", "[-1,18446744073709551615]", "[18446744073709551615,1]",
+      "[0.5,1.5,1e300]", "[1,2.5]", "[1,\"alpha\",2]", "[\"alpha\",1,2]",
+      "{\"alpha\":[1,2],\"beta\":[[3,4],[5.5],[]]}"};
+
+  for (size_t index = 0; index < sizeof(kJsons) / sizeof(kJsons[0]); ++index) {
+    JsonValue expected;
+    JsonValue actual;
+    Error error;
+    ASSERT_TRUE(ReadJson(kJsons[index], &expected, &error));
+    ASSERT_TRUE(ReadJson(kJsons[index], &actual, &error, pack_numeric_arrays));
+
+    std::string type_error;
+    EXPECT_TRUE(VerifyJsonType(actual, &type_error)) << type_error;
+    EXPECT_TRUE(AreJsonValuesEqual(expected, actual)) << kJsons[index];
+    EXPECT_EQ(WriteJson(expected), WriteJson(actual));
+    EXPECT_EQ(WritePrettyJson(expected), WritePrettyJson(actual));
+    EXPECT_EQ(ComputeJsonSize(expected), ComputeJsonSize(actual));
+  }
+
+  JsonValue value;
+  Error error;
+  ASSERT_TRUE(ReadJson("[1,2,3]", &value, &error, pack_numeric_arrays));
+  EXPECT_EQ(0, value.array_elements_size());
+  EXPECT_EQ(3, value.packed_signed_values_size());
+
+  ASSERT_TRUE(ReadJson("[1,2.5]", &value, &error, pack_numeric_arrays));
+  EXPECT_FALSE(IsPackedJsonArray(value));
+  EXPECT_EQ(2, value.array_elements_size());
+}
+
+TEST(JsonReader, RawNumbers) {
+  JsonReaderConfig raw_numbers;
+  raw_numbers.set_raw_numbers(true);
+
+  const char* const kJsons[] = {
+      "0", "-0", "123", "-123", "18446744073709551615", "1.5", "-0.25",
+      "1e400", "1.000000000000000000001", "2.5E-3", "[1,2.0,3e0]",
+      "{\"alpha\":12345678901234567890123,\"beta\":[-1.0]}"};
+
+  for (size_t index = 0; index < sizeof(kJsons) / sizeof(kJsons[0]); ++index) {
+    JsonValue expected;
+    JsonValue actual;
+    Error error;
+    ASSERT_TRUE(ReadJson(kJsons[index], &expected, &error));
+    ASSERT_TRUE(ReadJson(kJsons[index], &actual, &error, raw_numbers));
+
+    std::string type_error;
+    EXPECT_TRUE(VerifyJsonType(actual, &type_error)) << type_error;
+    EXPECT_TRUE(AreJsonValuesEqual(expected, actual)) << kJsons[index];
+    EXPECT_EQ(kJsons[index], WriteJson(actual));
+    EXPECT_EQ(ComputeJsonSize(actual), WriteJson(actual).size());
+  }
+
+  JsonValue value;
+  Error error;
+  ASSERT_TRUE(ReadJson("1.000000000000000000001", &value, &error, raw_numbers));
+  EXPECT_EQ(JsonValue::TYPE_RAW_NUMBER, value.type());
+  EXPECT_EQ("1.000000000000000000001", value.string_value());
+
+  JsonReaderConfig pack_raw_numbers(raw_numbers);
+  pack_raw_numbers.set_pack_numeric_arrays(true);
+  ASSERT_TRUE(ReadJson("[1,2,3]", &value, &error, pack_raw_numbers));
+  EXPECT_FALSE(IsPackedJsonArray(value));
+  EXPECT_EQ("[1,2,3]", WriteJson(value));
+
+  EXPECT_TRUE(TestReadSuccess("NaN", JsonNaN(), raw_numbers));
+  EXPECT_TRUE(
+      TestReadSuccess("-Infinity", JsonNegativeInfinity(), raw_numbers));
+
+  EXPECT_TRUE(TestReadFailure("01", 0, "Invalid number with leading zeroes",
+                              raw_numbers));
+  EXPECT_TRUE(TestReadFailure("-", 0, "Invalid number", raw_numbers));
+}
+
 TEST(JsonReader, ControlCharacters) {
   JsonReaderConfig allow_control_characters;
   allow_control_characters.set_allow_control_characters(true);
@@ -0,0 +1,189 @@
+// JSON [de]serialization for protobuf + embedded HTTP server and client in C++.
+// Copyright (C) 2014 http://protojson.com/
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+
+#include "pjcore/json_snapshot.h"
+
+#include <gtest/gtest.h>
+#include <stdio.h>
+#include <unistd.h>
+
+#include <limits>
+#include <string>
+
+#include "pjcore/error_util.h"
+#include "pjcore/json_reader.h"
+#include "pjcore/json_util.h"
+#include "pjcore/json_writer.h"
+#include "pjcore/logging.h"
+#include "pjcore_test/read_json_or_die.h"
+
+namespace pjcore {
+
+namespace {
+
+const char kTestJson[] =
+    "{\"name\":\"alpha\",\"count\":-3,\"big\":-1152921504606846977,"
+    "\"huge\":18446744073709551615,\"ratio\":0.25,\"flags\":[true,false,null],"
+    "\"nested\":{\"name\":\"alpha\",\"items\":[{\"id\":1},{\"id\":2}]},"
+    "\"empty\":{},\"none\":[],\"text\":\"\"}";
+
+}  // unnamed namespace
+
+TEST(JsonSnapshot, RoundTrip) {
+  const char* const kJsonValues[] = {
+      "null", "true", "0", "-1", "1152921504606846975", "1152921504606846976",
+      "-1152921504606846976", "-9223372036854775808", "NaN", "-0.0",
+      "\"12345678\"", "[]", "{}", kTestJson};
+
+  for (size_t index = 0; index < sizeof(kJsonValues) / sizeof(kJsonValues[0]);
+       ++index) {
+    JsonValue value = ReadJsonOrDie(kJsonValues[index]);
+
+    std::string data;
+    WriteJsonSnapshot(value, &data);
+
+    JsonSnapshot snapshot;
+    Error error;
+    ASSERT_TRUE(snapshot.Attach(data, &error)) << ErrorToString(error);
+    JsonValue read = MakeJsonValue(snapshot.root());
+    EXPECT_TRUE(AreJsonValuesIdentical(value, read))
+        << kJsonValues[index] << ": " << WriteJson(read);
+  }
+}
+
+TEST(JsonSnapshot, Navigation) {
+  std::string data;
+  WriteJsonSnapshot(ReadJsonOrDie(kTestJson), &data);
+
+  JsonSnapshot snapshot;
+  Error error;
+  ASSERT_TRUE(snapshot.Attach(data, &error));
+  JsonSnapshotValue root = snapshot.root();
+
+  EXPECT_EQ(JsonValue::TYPE_OBJECT, root.type());
+  EXPECT_EQ(10, root.object_properties_size());
+  EXPECT_EQ("big", root.object_property_name(0));
+  EXPECT_EQ("text", root.object_property_name(9));
+
+  EXPECT_EQ("alpha", root.GetProperty("name").string_value());
+  EXPECT_EQ(-3, root.GetProperty("count").signed_value());
+  EXPECT_EQ(-1152921504606846977LL, root.GetProperty("big").signed_value());
+  EXPECT_EQ(std::numeric_limits<uint64_t>::max(),
+            root.GetProperty("huge").unsigned_value());
+  EXPECT_EQ(0.25, root.GetProperty("ratio").double_value());
+  EXPECT_TRUE(root.GetProperty("flags").array_elements(0).bool_value());
+  EXPECT_EQ(JsonValue::TYPE_NULL,
+            root.GetProperty("flags").array_elements(2).type());
+  EXPECT_EQ(2, root.GetProperty("nested")
+                   .GetProperty("items")
+                   .array_elements(1)
+                   .GetProperty("id")
+                   .signed_value());
+  EXPECT_TRUE(root.HasProperty("empty"));
+  EXPECT_FALSE(root.HasProperty("missing"));
+  EXPECT_FALSE(root.HasProperty("nam"));
+  EXPECT_EQ(JsonValue::TYPE_NULL, root.GetProperty("missing").type());
+  EXPECT_EQ(0, root.GetProperty("name").array_elements_size());
+  EXPECT_EQ("", root.GetProperty("count").string_value());
+
+  // Equal strings are pooled.
+  EXPECT_EQ(root.GetProperty("name").string_value().data(),
+            root.GetProperty("nested").GetProperty("name").string_value()
+                .data());
+}
+
+TEST(JsonSnapshot, UnsortedProperties) {
+  JsonReaderConfig properties_as_is;
+  properties_as_is.set_properties_as_is(true);
+  JsonValue value;
+  Error error;
+  ASSERT_TRUE(ReadJson("{\"b\":1,\"a\":2,\"b\":3}", &value, &error,
+                       properties_as_is));
+
+  std::string data;
+  WriteJsonSnapshot(value, &data);
+
+  JsonSnapshot snapshot;
+  ASSERT_TRUE(snapshot.Attach(data, &error));
+  EXPECT_EQ("{\"a\":2,\"b\":3}", WriteJson(MakeJsonValue(snapshot.root())));
+}
+
+TEST(JsonSnapshot, AttachFailure) {
+  std::string data;
+  WriteJsonSnapshot(ReadJsonOrDie("[1]"), &data);
+
+  GlobalLogOverride global_log_override;
+  JsonSnapshot snapshot;
+  Error error;
+  EXPECT_FALSE(snapshot.Attach(StringPiece(data).substr(0, 16), &error));
+  EXPECT_FALSE(snapshot.Attach(StringPiece(data).substr(0, 40), &error));
+  EXPECT_FALSE(snapshot.Attach(data + "x", &error));
+
+  std::string corrupt(data);
+  corrupt[0] = 'X';
+  EXPECT_FALSE(snapshot.Attach(corrupt, &error));
+  EXPECT_FALSE(snapshot.is_open());
+}
+
+TEST(JsonSnapshot, CorruptContents) {
+  std::string data;
+  WriteJsonSnapshot(ReadJsonOrDie(kTestJson), &data);
+
+  // Every word past the header in turn points far out of bounds.
+  for (size_t offset = 32; offset + 8 <= data.size(); offset += 8) {
+    std::string corrupt(data);
+    for (size_t byte = 0; byte < 8; ++byte) {
+      corrupt[offset + byte] = byte == 7 ? '\x0f' : '\xff';
+    }
+
+    JsonSnapshot snapshot;
+    Error error;
+    ASSERT_TRUE(snapshot.Attach(corrupt, &error));
+    JsonValue value = MakeJsonValue(snapshot.root());
+    EXPECT_EQ(JsonValue::TYPE_OBJECT, value.type());
+    snapshot.root().GetProperty("nested").GetProperty("name").string_value();
+  }
+}
+
+TEST(JsonSnapshot, File) {
+  char path[] = "/tmp/json_snapshot_test_XXXXXX";
+  int fd = mkstemp(path);
+  ASSERT_GE(fd, 0);
+  close(fd);
+
+  Error error;
+  ASSERT_TRUE(WriteJsonSnapshotFile(ReadJsonOrDie(kTestJson), path, &error))
+      << ErrorToString(error);
+
+  JsonSnapshot snapshot;
+  ASSERT_TRUE(snapshot.Open(path, &error)) << ErrorToString(error);
+  unlink(path);
+
+  EXPECT_TRUE(snapshot.is_open());
+  EXPECT_TRUE(AreJsonValuesEqual(ReadJsonOrDie(kTestJson),
+                                 MakeJsonValue(snapshot.root())));
+
+  snapshot.Close();
+  EXPECT_FALSE(snapshot.is_open());
+
+  GlobalLogOverride global_log_override;
+  EXPECT_FALSE(snapshot.Open(path, &error));
+  EXPECT_TRUE(error.has_system_errno());
+}
+
+}  // namespace pjcore
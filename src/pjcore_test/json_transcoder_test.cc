@@ -0,0 +1,364 @@
+// JSON [de]serialization for protobuf + embedded HTTP server and client in C++.
+// Copyright (C) 2014 http://protojson.com/
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+
+#include "pjcore/json_transcoder.h"
+
+#include <gtest/gtest.h>
+
+#include <limits>
+#include <string>
+
+#include "google/protobuf/descriptor.pb.h"
+#include "google/protobuf/dynamic_message.h"
+
+#include "pjcore_test/test_message.pb.h"
+#include "pjcore/error_util.h"
+#include "pjcore/third_party/chromium/scoped_ptr.h"
+#include "pjcore/json_reader.h"
+#include "pjcore/unbox_json_value.h"
+
+namespace pjcore {
+
+using google::protobuf::DescriptorProto;
+using google::protobuf::DynamicMessageFactory;
+using google::protobuf::FieldDescriptorProto;
+using google::protobuf::FileDescriptorProto;
+using google::protobuf::Message;
+using google::protobuf::Reflection;
+
+namespace {
+
+::testing::AssertionResult TestWireToJson(const Message& message,
+                                          StringPiece wire) {
+  std::vector<JsonWriterConfig> configs(3);
+  configs[1].set_indent(2);
+  configs[1].set_space(true);
+  configs[2].set_null_for_nan_and_infinity(true);
+
+  scoped_ptr<Message> parsed(message.New());
+  if (!parsed->ParseFromArray(wire.data(), static_cast<int>(wire.size()))) {
+    std::string actual;
+    Error error;
+    if (TranscodeWireToJson(wire, *message.GetDescriptor(), &actual, &error)) {
+      return ::testing::AssertionFailure() << "Transcoded invalid wire";
+    }
+    return ::testing::AssertionSuccess();
+  }
+
+  for (size_t index = 0; index < configs.size(); ++index) {
+    std::string expected = WriteJson(MakeJsonValue(*parsed), configs[index]);
+
+    std::string actual;
+    Error error;
+    if (!TranscodeWireToJson(wire, *message.GetDescriptor(), &actual, &error,
+                             configs[index])) {
+      return ::testing::AssertionFailure() << ErrorToString(error);
+    }
+
+    if (actual != expected) {
+      return ::testing::AssertionFailure()
+             << "Config " << index << ": " << actual << " != " << expected;
+    }
+  }
+
+  return ::testing::AssertionSuccess();
+}
+
+::testing::AssertionResult TestWireToJson(const Message& message) {
+  return TestWireToJson(message, message.SerializeAsString());
+}
+
+::testing::AssertionResult TestJsonToWire(
+    const Message& prototype, StringPiece str,
+    const JsonReaderConfig& config = JsonReaderConfig::default_instance()) {
+  scoped_ptr<Message> expected(prototype.New());
+  Error expected_error;
+  JsonValue json_value;
+  bool expected_success = ReadJson(str, &json_value, &expected_error, config) &&
+                          UnboxJsonValue(json_value, expected.get(),
+                                         &expected_error);
+
+  std::string wire;
+  Error actual_error;
+  bool actual_success = TranscodeJsonToWire(str, *prototype.GetDescriptor(),
+                                            &wire, &actual_error, config);
+
+  if (actual_success != expected_success) {
+    return ::testing::AssertionFailure()
+           << str << ": transcoded "
+           << (actual_success ? "succeeded" : ErrorToString(actual_error))
+           << ", reflective "
+           << (expected_success ? "succeeded" : ErrorToString(expected_error));
+  }
+
+  if (!expected_success) {
+    return ::testing::AssertionSuccess();
+  }
+
+  scoped_ptr<Message> actual(prototype.New());
+  if (!actual->ParseFromString(wire)) {
+    return ::testing::AssertionFailure() << str << ": invalid wire format";
+  }
+
+  if (actual->SerializeAsString() != expected->SerializeAsString()) {
+    return ::testing::AssertionFailure() << str << ": "
+                                         << actual->DebugString()
+                                         << " != " << expected->DebugString();
+  }
+
+  return ::testing::AssertionSuccess();
+}
+
+TestMessage MakeFullTestMessage() {
+  TestMessage message;
+  message.set_optional_int32(-12);
+  message.set_optional_int64(std::numeric_limits<int64_t>::min());
+  message.set_optional_uint32(34);
+  message.set_optional_uint64(std::numeric_limits<uint64_t>::max());
+  message.set_optional_double(0.25);
+  message.set_optional_float(1.5f);
+  message.set_optional_bool(true);
+  message.set_optional_enum(TestMessage::TEST_BETA);
+  message.set_optional_string("a\"b\\c\xd0\xb4\t");
+  message.set_optional_bytes(std::string("\0\xff\x10", 3));
+  message.mutable_optional_message()->set_optional_int32(5);
+
+  message.add_repeated_int32(1);
+  message.add_repeated_int32(-2);
+  message.add_repeated_int64(3);
+  message.add_repeated_uint32(4);
+  message.add_repeated_uint64(5);
+  message.add_repeated_double(std::numeric_limits<double>::infinity());
+  message.add_repeated_double(-0.5);
+  message.add_repeated_float(2.5f);
+  message.add_repeated_bool(false);
+  message.add_repeated_enum(TestMessage::TEST_ALPHA);
+  message.add_repeated_string("");
+  message.add_repeated_string("x");
+  message.add_repeated_bytes("xyz");
+  message.add_repeated_message();
+  message.add_repeated_message()->add_repeated_string("nested");
+  return message;
+}
+
+void AddField(const char* name, int number, FieldDescriptorProto::Type type,
+              FieldDescriptorProto::Label label, DescriptorProto* message) {
+  FieldDescriptorProto* field = message->add_field();
+  field->set_name(name);
+  field->set_number(number);
+  field->set_type(type);
+  field->set_label(label);
+}
+
+// Builds a message type using the wire types absent from TestMessage.
+const google::protobuf::Descriptor* BuildWireTypes(
+    google::protobuf::DescriptorPool* pool, const char* syntax) {
+  FileDescriptorProto file;
+  file.set_name(std::string("wire_types_") + syntax + ".proto");
+  file.set_package("pjcore_test");
+  file.set_syntax(syntax);
+
+  DescriptorProto* message = file.add_message_type();
+  message->set_name(std::string("WireTypes_") + syntax);
+
+  const FieldDescriptorProto::Label optional =
+      FieldDescriptorProto::LABEL_OPTIONAL;
+  const FieldDescriptorProto::Label repeated =
+      FieldDescriptorProto::LABEL_REPEATED;
+
+  AddField("sint32_value", 1, FieldDescriptorProto::TYPE_SINT32, optional,
+           message);
+  AddField("sint64_value", 2, FieldDescriptorProto::TYPE_SINT64, optional,
+           message);
+  AddField("fixed32_value", 3, FieldDescriptorProto::TYPE_FIXED32, optional,
+           message);
+  AddField("fixed64_value", 4, FieldDescriptorProto::TYPE_FIXED64, optional,
+           message);
+  AddField("sfixed32_value", 5, FieldDescriptorProto::TYPE_SFIXED32, optional,
+           message);
+  AddField("sfixed64_value", 6, FieldDescriptorProto::TYPE_SFIXED64, optional,
+           message);
+  AddField("string_value", 7, FieldDescriptorProto::TYPE_STRING, optional,
+           message);
+  AddField("packed_sint32", 8, FieldDescriptorProto::TYPE_SINT32, repeated,
+           message);
+  AddField("packed_double", 9, FieldDescriptorProto::TYPE_DOUBLE, repeated,
+           message);
+  AddField("packed_bool", 10, FieldDescriptorProto::TYPE_BOOL, repeated,
+           message);
+  AddField("choice_int32", 11, FieldDescriptorProto::TYPE_INT32, optional,
+           message);
+  AddField("choice_string", 12, FieldDescriptorProto::TYPE_STRING, optional,
+           message);
+
+  for (int index = 7; index < 10; ++index) {
+    message->mutable_field(index)->mutable_options()->set_packed(true);
+  }
+
+  message->add_oneof_decl()->set_name("choice");
+  message->mutable_field(10)->set_oneof_index(0);
+  message->mutable_field(11)->set_oneof_index(0);
+
+  return pool->BuildFile(file)->message_type(0);
+}
+
+void FillWireTypes(Message* message) {
+  const google::protobuf::Descriptor* descriptor = message->GetDescriptor();
+  const Reflection* reflection = message->GetReflection();
+
+  reflection->SetInt32(message, descriptor->field(0), -7);
+  reflection->SetInt64(message, descriptor->field(1),
+                       std::numeric_limits<int64_t>::min());
+  reflection->SetUInt32(message, descriptor->field(2), 0xfffffffe);
+  reflection->SetUInt64(message, descriptor->field(3), 1);
+  reflection->SetInt32(message, descriptor->field(4), -1);
+  reflection->SetInt64(message, descriptor->field(5), -2);
+  reflection->SetString(message, descriptor->field(6), "text");
+  reflection->AddInt32(message, descriptor->field(7), -1);
+  reflection->AddInt32(message, descriptor->field(7), 2);
+  reflection->AddDouble(message, descriptor->field(8), 0.5);
+  reflection->AddBool(message, descriptor->field(9), true);
+  reflection->AddBool(message, descriptor->field(9), false);
+  reflection->SetInt32(message, descriptor->field(10), 3);
+  reflection->SetString(message, descriptor->field(11), "chosen");
+}
+
+}  // unnamed namespace
+
+TEST(JsonTranscoder, WireToJson) {
+  EXPECT_TRUE(TestWireToJson(TestMessage()));
+  EXPECT_TRUE(TestWireToJson(MakeFullTestMessage()));
+
+  TestMessageWithObjectProperties with_object_properties;
+  JsonValue::Property* property =
+      with_object_properties.add_object_properties();
+  property->set_name("a");
+  *property->mutable_value() = MakeJsonArray(1, "b");
+  EXPECT_TRUE(TestWireToJson(with_object_properties));
+
+  TestMessageWithStringMap with_string_map;
+  with_string_map.add_entries()->set_name("a");
+  with_string_map.add_entries()->set_data(2);
+  EXPECT_TRUE(TestWireToJson(with_string_map));
+}
+
+TEST(JsonTranscoder, WireToJsonMerges) {
+  TestMessage first = MakeFullTestMessage();
+  TestMessage second;
+  second.set_optional_int32(7);
+  second.set_optional_enum(TestMessage::TEST_ALPHA);
+  second.mutable_optional_message()->set_optional_string("merged");
+  second.add_repeated_int32(3);
+
+  EXPECT_TRUE(TestWireToJson(
+      TestMessage(), first.SerializeAsString() + second.SerializeAsString()));
+}
+
+TEST(JsonTranscoder, WireToJsonUnexpected) {
+  // Unknown field, mismatched wire type, unknown enum value and unknown group.
+  EXPECT_TRUE(TestWireToJson(TestMessage(),
+                             std::string("\xa0\x06\x01\x0a\x01x\x08\x05"
+                                         "\x40\x07\x40\x01\x40\x09\xab\x01"
+                                         "\x08\x01\xac\x01",
+                                         20)));
+
+  EXPECT_TRUE(TestWireToJson(TestMessage(), std::string("\x08", 1)));
+  EXPECT_TRUE(TestWireToJson(TestMessage(), std::string("\x4a\x05x", 3)));
+  EXPECT_TRUE(TestWireToJson(TestMessage(), std::string("\x00\x00", 2)));
+}
+
+TEST(JsonTranscoder, WireToJsonWireTypes) {
+  google::protobuf::DescriptorPool pool;
+  DynamicMessageFactory factory(&pool);
+
+  const char* kSyntaxes[] = {"proto2", "proto3"};
+  for (size_t index = 0; index < ARRAYSIZE_UNSAFE(kSyntaxes); ++index) {
+    scoped_ptr<Message> message(
+        factory.GetPrototype(BuildWireTypes(&pool, kSyntaxes[index]))->New());
+    EXPECT_TRUE(TestWireToJson(*message));
+    EXPECT_TRUE(TestWireToJson(*message, std::string("\x08\x00\x3a\x00", 4)));
+
+    FillWireTypes(message.get());
+    EXPECT_TRUE(TestWireToJson(*message));
+
+    // Unpacked elements of packed fields.
+    EXPECT_TRUE(TestWireToJson(*message,
+                               message->SerializeAsString() + "\x40\x03"));
+  }
+}
+
+TEST(JsonTranscoder, JsonToWire) {
+  TestMessage prototype;
+
+  EXPECT_TRUE(TestJsonToWire(prototype, "{}"));
+  EXPECT_TRUE(TestJsonToWire(prototype, WriteJson(MakeFullTestMessage())));
+  EXPECT_TRUE(TestJsonToWire(
+      prototype,
+      "{\"optional_int32\": -5, \"optional_int64\": \"-9007199254740993\","
+      " \"optional_uint32\": 7.0, \"optional_uint64\": 18446744073709551615,"
+      " \"optional_double\": 1e300, \"optional_float\": \"2.5\","
+      " \"optional_bool\": false, \"optional_string\": \"\\u0434\"}"));
+  EXPECT_TRUE(TestJsonToWire(prototype, "{\"optional_int32\": null}"));
+  EXPECT_TRUE(TestJsonToWire(
+      prototype, "{\"repeated_enum\": [\"TEST_ALPHA\", 2, \"1\", 7, \"x\"]}"));
+  EXPECT_TRUE(TestJsonToWire(prototype, "{\"optional_enum\": \"GAMMA\"}"));
+  EXPECT_TRUE(TestJsonToWire(prototype, "{\"optional_bytes\": \"AP8Q\"}"));
+  EXPECT_TRUE(TestJsonToWire(
+      prototype, "{\"optional_int32\": 1, \"optional_int32\": 2}"));
+  EXPECT_TRUE(TestJsonToWire(
+      prototype, "{\"optional_message\": {\"inner\": 1}, \"outer\": 2}"));
+
+  EXPECT_TRUE(TestJsonToWire(
+      TestMessageWithObjectProperties(),
+      "{\"z\": [1, 2], \"a\": {\"y\": 1, \"x\": 2}, \"a\": 3}"));
+  EXPECT_TRUE(TestJsonToWire(
+      TestMessageWithStringMap(),
+      "{\"entries\": {\"b\": {\"data\": 1}, \"a\": {\"data\": 2},"
+      " \"b\": {\"data\": 3}}}"));
+  EXPECT_TRUE(TestJsonToWire(
+      TestMessageWithIntMap(),
+      "{\"entries\": {\"10\": {\"data\": \"ten\"}, \"9\": {}}}"));
+}
+
+TEST(JsonTranscoder, JsonToWireFailure) {
+  TestMessage prototype;
+
+  EXPECT_TRUE(TestJsonToWire(prototype, "[]"));
+  EXPECT_TRUE(TestJsonToWire(prototype, "{} {}"));
+  EXPECT_TRUE(TestJsonToWire(prototype, "{\"optional_int32\": 2147483648}"));
+  EXPECT_TRUE(TestJsonToWire(prototype, "{\"optional_bytes\": \"AP8\"}"));
+  EXPECT_TRUE(TestJsonToWire(prototype, "{\"optional_message\": 1}"));
+  EXPECT_TRUE(TestJsonToWire(prototype, "{\"repeated_int32\": 1}"));
+  EXPECT_TRUE(TestJsonToWire(TestMessageWithIntMap(),
+                             "{\"entries\": {\"x\": {}}}"));
+}
+
+TEST(JsonTranscoder, JsonToWireWireTypes) {
+  google::protobuf::DescriptorPool pool;
+  DynamicMessageFactory factory(&pool);
+
+  const char* kSyntaxes[] = {"proto2", "proto3"};
+  for (size_t index = 0; index < ARRAYSIZE_UNSAFE(kSyntaxes); ++index) {
+    scoped_ptr<Message> message(
+        factory.GetPrototype(BuildWireTypes(&pool, kSyntaxes[index]))->New());
+    FillWireTypes(message.get());
+    EXPECT_TRUE(TestJsonToWire(*message, WriteJson(MakeJsonValue(*message))));
+  }
+}
+
+}  // namespace pjcore
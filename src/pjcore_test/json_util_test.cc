@@ -19,6 +19,8 @@
 
 #include <gtest/gtest.h>
 
+#include <limits>
+
 #include "pjcore/logging.h"
 
 namespace pjcore {
@@ -85,6 +87,68 @@ TEST(VerifyJsonType, Invalid) {
   }
 }
 
+TEST(VerifyJsonType, Packed) {
+  std::string error;
+
+  GlobalLogOverride global_log_override;
+
+  JsonValue value = MakeJsonArray();
+  value.add_packed_signed_values(1);
+  EXPECT_TRUE(VerifyJsonType(value, &error));
+
+  value.add_packed_double_values(2.5);
+  EXPECT_FALSE(VerifyJsonType(value, &error));
+
+  value.clear_packed_double_values();
+  *value.add_array_elements() = MakeJsonValue(3);
+  EXPECT_FALSE(VerifyJsonType(value, &error));
+
+  value = MakeJsonValue(1);
+  value.add_packed_signed_values(1);
+  EXPECT_FALSE(VerifyJsonType(value, &error));
+}
+
+TEST(PackJsonArray, Test) {
+  JsonValue value = MakeJsonArray(1, 2, 3);
+  EXPECT_TRUE(PackJsonArray(&value));
+  EXPECT_TRUE(IsPackedJsonArray(value));
+  EXPECT_EQ(0, value.array_elements_size());
+  EXPECT_EQ(3, value.packed_signed_values_size());
+  EXPECT_EQ(3, GetJsonArraySize(value));
+  EXPECT_TRUE(AreJsonValuesEqual(MakeJsonArray(1, 2, 3), value));
+
+  JsonValue buffer;
+  EXPECT_TRUE(
+      AreJsonValuesEqual(MakeJsonValue(2), GetJsonArrayElement(value, 1,
+                                                               &buffer)));
+
+  UnpackJsonArray(&value);
+  EXPECT_FALSE(IsPackedJsonArray(value));
+  EXPECT_EQ(3, value.array_elements_size());
+  EXPECT_TRUE(AreJsonValuesEqual(MakeJsonArray(1, 2, 3), value));
+
+  value = MakeJsonArray(0.5, 1.5);
+  EXPECT_TRUE(PackJsonArray(&value));
+  EXPECT_EQ(2, value.packed_double_values_size());
+
+  value = MakeJsonArray(18446744073709551615ull);
+  EXPECT_TRUE(PackJsonArray(&value));
+  EXPECT_EQ(1, value.packed_unsigned_values_size());
+
+  value = MakeJsonArray(1, 2.5);
+  EXPECT_FALSE(PackJsonArray(&value));
+  EXPECT_EQ(2, value.array_elements_size());
+
+  value = MakeJsonArray(1, "alpha");
+  EXPECT_FALSE(PackJsonArray(&value));
+
+  value = MakeJsonArray();
+  EXPECT_FALSE(PackJsonArray(&value));
+
+  value = MakeJsonValue(1);
+  EXPECT_FALSE(PackJsonArray(&value));
+}
+
 TEST(IsJsonNumber, Test) {
   EXPECT_FALSE(IsJsonNumber(JsonNull()));
   EXPECT_FALSE(IsJsonNumber(MakeJsonValue(true)));
@@ -199,6 +263,115 @@ TEST(AreJsonValuesEqual, ArrayValue) {
   EXPECT_FALSE(AreJsonValuesEqual(MakeJsonArray(1, 2), MakeJsonArray(2, 1)));
 
   EXPECT_FALSE(AreJsonValuesEqual(MakeJsonArray(1, 2), JsonNull()));
+
+  JsonValue packed = MakeJsonArray(1, 2);
+  PJCORE_CHECK(PackJsonArray(&packed));
+  EXPECT_TRUE(AreJsonValuesEqual(MakeJsonArray(1, 2), packed));
+  EXPECT_TRUE(AreJsonValuesEqual(packed, MakeJsonArray(1, 2)));
+  EXPECT_FALSE(AreJsonValuesEqual(packed, MakeJsonArray(1, 2, 3)));
+
+  std::string diff_path;
+  EXPECT_FALSE(AreJsonValuesEqual(packed, MakeJsonArray(1, 3), &diff_path));
+  EXPECT_EQ("$[1]", diff_path);
+}
+
+TEST(HashJsonValue, Numbers) {
+  EXPECT_EQ(HashJsonValue(MakeJsonValue(1)),
+            HashJsonValue(MakeJsonValue(1ull)));
+  EXPECT_EQ(HashJsonValue(MakeJsonValue(1)),
+            HashJsonValue(MakeJsonValue(1.0)));
+  EXPECT_EQ(HashJsonValue(MakeJsonValue(-5)),
+            HashJsonValue(MakeJsonValue(-5.0)));
+  EXPECT_EQ(HashJsonValue(MakeJsonValue(0)),
+            HashJsonValue(MakeJsonValue(-0.0)));
+  EXPECT_EQ(HashJsonValue(MakeJsonValue(18446744073709549568ull)),
+            HashJsonValue(MakeJsonValue(18446744073709549568.0)));
+  EXPECT_EQ(HashJsonValue(JsonNaN()), HashJsonValue(JsonNaN()));
+
+  EXPECT_NE(HashJsonValue(MakeJsonValue(1)), HashJsonValue(MakeJsonValue(2)));
+  EXPECT_NE(HashJsonValue(MakeJsonValue(-1)),
+            HashJsonValue(MakeJsonValue(18446744073709551615ull)));
+  EXPECT_NE(HashJsonValue(MakeJsonValue(1)),
+            HashJsonValue(MakeJsonValue(1.5)));
+  EXPECT_NE(HashJsonValue(MakeJsonValue(1)), HashJsonValue(MakeJsonValue("1")));
+  EXPECT_NE(HashJsonValue(MakeJsonValue(true)),
+            HashJsonValue(MakeJsonValue(false)));
+}
+
+TEST(ResolveJsonRawNumber, Test) {
+  JsonValue raw_number;
+  raw_number.set_type(JsonValue::TYPE_RAW_NUMBER);
+  raw_number.set_string_value("18446744073709551615");
+
+  JsonValue buffer;
+  const JsonValue& resolved = ResolveJsonRawNumber(raw_number, &buffer);
+  EXPECT_EQ(JsonValue::TYPE_UNSIGNED, resolved.type());
+  EXPECT_EQ(18446744073709551615ull, resolved.unsigned_value());
+
+  EXPECT_EQ(&buffer, &resolved);
+
+  JsonValue signed_value = MakeJsonValue(-5);
+  EXPECT_EQ(&signed_value, &ResolveJsonRawNumber(signed_value, &buffer));
+
+  EXPECT_TRUE(AreJsonValuesEqual(MakeJsonValue(18446744073709551615ull),
+                                 raw_number));
+  EXPECT_EQ(HashJsonValue(MakeJsonValue(18446744073709551615ull)),
+            HashJsonValue(raw_number));
+
+  raw_number.set_string_value("2.50");
+  EXPECT_TRUE(AreJsonValuesIdentical(MakeJsonValue(2.5), raw_number));
+  EXPECT_EQ(HashJsonValue(MakeJsonValue(2.5)), HashJsonValue(raw_number));
+
+  JsonValue number;
+  EXPECT_TRUE(ReadJsonRawNumber("-1e2", &number));
+  EXPECT_EQ(JsonValue::TYPE_DOUBLE, number.type());
+  EXPECT_EQ(-100.0, number.double_value());
+
+  EXPECT_TRUE(ReadJsonRawNumber("-9223372036854775808", &number));
+  EXPECT_EQ(JsonValue::TYPE_SIGNED, number.type());
+  EXPECT_EQ(std::numeric_limits<int64_t>::min(), number.signed_value());
+
+  EXPECT_TRUE(ReadJsonRawNumber("9223372036854775808", &number));
+  EXPECT_EQ(JsonValue::TYPE_UNSIGNED, number.type());
+  EXPECT_EQ(9223372036854775808ull, number.unsigned_value());
+
+  EXPECT_FALSE(ReadJsonRawNumber("\"1\"", &number));
+  EXPECT_FALSE(ReadJsonRawNumber("1x", &number));
+  EXPECT_FALSE(ReadJsonRawNumber("-01", &number));
+  EXPECT_FALSE(ReadJsonRawNumber("", &number));
+}
+
+TEST(HashJsonValue, Containers) {
+  EXPECT_EQ(HashJsonValue(MakeJsonObject("alpha", 1, "beta", 2)),
+            HashJsonValue(MakeJsonObject("beta", 2.0, "alpha", 1)));
+  EXPECT_NE(HashJsonValue(MakeJsonObject("alpha", 1, "beta", 2)),
+            HashJsonValue(MakeJsonObject("alpha", 2, "beta", 1)));
+  EXPECT_NE(HashJsonValue(MakeJsonObject()), HashJsonValue(MakeJsonArray()));
+
+  EXPECT_NE(HashJsonValue(MakeJsonArray(1, 2)),
+            HashJsonValue(MakeJsonArray(2, 1)));
+  EXPECT_NE(HashJsonValue(MakeJsonArray(MakeJsonArray(1), 2)),
+            HashJsonValue(MakeJsonArray(1, MakeJsonArray(2))));
+
+  JsonValue packed = MakeJsonArray(1, 2, 3);
+  PJCORE_CHECK(PackJsonArray(&packed));
+  EXPECT_EQ(HashJsonValue(MakeJsonArray(1, 2, 3)), HashJsonValue(packed));
+}
+
+TEST(AreJsonValuesIdentical, Test) {
+  EXPECT_TRUE(AreJsonValuesIdentical(MakeJsonArray(1, 2.5, "alpha"),
+                                     MakeJsonArray(1ull, 2.5, "alpha")));
+  EXPECT_TRUE(AreJsonValuesIdentical(JsonNaN(), JsonNaN()));
+  EXPECT_FALSE(AreJsonValuesIdentical(MakeJsonValue(0.1 + 0.2),
+                                      MakeJsonValue(0.3)));
+  EXPECT_TRUE(AreJsonValuesEqual(MakeJsonValue(0.1 + 0.2), MakeJsonValue(0.3)));
+
+  JsonValue left = MakeJsonObject("alpha", MakeJsonArray(1, 2));
+  JsonValue right = MakeJsonObject("alpha", MakeJsonArray(1, 2.0));
+  EXPECT_TRUE(AreJsonValuesIdentical(left, HashJsonValue(left), right,
+                                     HashJsonValue(right)));
+  EXPECT_FALSE(AreJsonValuesIdentical(left, HashJsonValue(left), right,
+                                      HashJsonValue(left) + 1));
 }
 
 TEST(StripQuotesUnescapeTabsAndSlashes, Test) {
@@ -19,9 +19,15 @@
 
 #include <gtest/gtest.h>
 
+#include <limits>
+#include <string>
+#include <vector>
+
 #include "pjcore/error_util.h"
 #include "pjcore/json_reader.h"
 #include "pjcore/json_util.h"
+#include "pjcore/third_party/chromium/compiler_specific.h"
+#include "pjcore/third_party/chromium/macros.h"
 
 namespace pjcore {
 
@@ -49,6 +55,28 @@ template <typename Value>
   return ::testing::AssertionSuccess();
 }
 
+class ChunkSink : public JsonWriterSink {
+ public:
+  ChunkSink() {}
+
+  virtual void Append(StringPiece chunk) OVERRIDE {
+    chunks.push_back(chunk.as_string());
+  }
+
+  std::string Join() const {
+    std::string joined;
+    for (size_t index = 0; index < chunks.size(); ++index) {
+      joined += chunks[index];
+    }
+    return joined;
+  }
+
+  std::vector<std::string> chunks;
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(ChunkSink);
+};
+
 }  // unnamed namespace
 
 TEST(JsonWriter, Null) { EXPECT_EQ("null", WriteJson(JsonNull())); }
@@ -253,4 +281,240 @@ TEST(JsonWriter, NaNAndInfinity) {
             WriteJson(JsonNegativeInfinity(), null_for_nan_and_infinity));
 }
 
+TEST(JsonWriter, AppendToOutput) {
+  std::string output("[");
+
+  WriteJson(MakeJsonObject("alpha", "beta"), &output);
+  output.push_back(',');
+  WriteJson(7, &output);
+  output.push_back(']');
+
+  EXPECT_EQ("[{\"alpha\":\"beta\"},7]", output);
+
+  output.clear();
+  size_t capacity = output.capacity();
+  WriteJson(true, &output);
+  EXPECT_EQ("true", output);
+  EXPECT_EQ(capacity, output.capacity());
+}
+
+TEST(JsonWriter, ComputeJsonSize) {
+  JsonValue value = MakeJsonObject(
+      "alpha", MakeJsonArray(1, -2, 3.5, 18446744073709551615ull),
+      "beta", MakeJsonObject("gamma", "\"/\\\b\f\n\r\t",
+                             "delta", "\xf0\x9d\x84\x9e\xe4\xbd\xa0"),
+      "epsilon", MakeJsonArray(JsonNull(), true, false, JsonNaN(),
+                               JsonInfinity(), JsonNegativeInfinity()),
+      "zeta", MakeJsonObject(), "eta", MakeJsonArray());
+
+  JsonWriterConfig configs[6];
+  configs[1].set_space(true);
+  configs[2].set_indent(3);
+  configs[3].set_space(true);
+  configs[3].set_indent(kJsonPrettyIndent);
+  configs[4].set_escape_unicode(true);
+  configs[4].set_include_byte_order_mark(true);
+  configs[5].set_null_for_nan_and_infinity(true);
+
+  for (size_t index = 0; index < sizeof(configs) / sizeof(configs[0]);
+       ++index) {
+    EXPECT_EQ(WriteJson(value, configs[index]).size(),
+              ComputeJsonSize(value, configs[index]))
+        << index;
+  }
+
+  EXPECT_EQ(4u, ComputeJsonSize(JsonNull()));
+  EXPECT_EQ(7u, ComputeJsonSize("alpha"));
+}
+
+TEST(JsonWriter, ResumableJsonWriter) {
+  JsonValue value = MakeJsonObject(
+      "alpha", MakeJsonArray(1, -2, 3.5, 18446744073709551615ull),
+      "beta", MakeJsonObject("gamma", "\"/\\\b\f\n\r\t",
+                             "delta", MakeJsonArray(MakeJsonArray())),
+      "epsilon", MakeJsonArray(JsonNull(), true, false), "zeta",
+      MakeJsonObject());
+
+  JsonWriterConfig configs[3];
+  configs[1].set_space(true);
+  configs[1].set_indent(kJsonPrettyIndent);
+  configs[2].set_include_byte_order_mark(true);
+
+  for (size_t index = 0; index < sizeof(configs) / sizeof(configs[0]);
+       ++index) {
+    ResumableJsonWriter writer(value, configs[index]);
+    std::string output;
+    size_t steps = 0;
+    size_t previous_size = 0;
+    while (!writer.Step(1, &output)) {
+      EXPECT_LT(previous_size, output.size()) << index;
+      previous_size = output.size();
+      ++steps;
+    }
+    EXPECT_TRUE(writer.done());
+    EXPECT_TRUE(writer.Step(1, &output));
+    EXPECT_EQ(WriteJson(value, configs[index]), output) << index;
+    EXPECT_LT(10u, steps) << index;
+
+    ResumableJsonWriter whole_writer(value, configs[index]);
+    output.clear();
+    EXPECT_TRUE(whole_writer.Step(std::numeric_limits<size_t>::max(),
+                                  &output));
+    EXPECT_EQ(WriteJson(value, configs[index]), output) << index;
+  }
+}
+
+TEST(JsonWriter, ResumableJsonWriterPackedArray) {
+  JsonValue value = MakeJsonArray();
+  for (int index = 0; index < 100; ++index) {
+    AppendJsonElement(index * 1000, &value);
+  }
+  ASSERT_TRUE(PackJsonArray(&value));
+
+  JsonWriterConfig configs[2];
+  configs[1].set_indent(kJsonPrettyIndent);
+
+  for (size_t index = 0; index < sizeof(configs) / sizeof(configs[0]);
+       ++index) {
+    ResumableJsonWriter writer(value, configs[index]);
+    std::string output;
+    size_t steps = 0;
+    while (!writer.Step(1, &output)) {
+      ++steps;
+    }
+    EXPECT_EQ(WriteJson(value, configs[index]), output) << index;
+    // Each packed element is a step of its own.
+    EXPECT_LE(100u, steps) << index;
+  }
+}
+
+TEST(JsonWriter, PushWriter) {
+  JsonValue value = MakeJsonObject(
+      "alpha", MakeJsonArray(1, -2, 3.5, 18446744073709551615ull),
+      "beta", MakeJsonObject("gamma", "\"/\\\b", "delta", MakeJsonArray()),
+      "epsilon", MakeJsonArray(JsonNull(), true, JsonNaN()));
+
+  JsonWriterConfig configs[4];
+  configs[1].set_space(true);
+  configs[2].set_space(true);
+  configs[2].set_indent(kJsonPrettyIndent);
+  configs[3].set_include_byte_order_mark(true);
+  configs[3].set_null_for_nan_and_infinity(true);
+
+  for (size_t index = 0; index < sizeof(configs) / sizeof(configs[0]);
+       ++index) {
+    std::string output;
+    JsonWriter writer(&output, configs[index]);
+    writer.BeginObject();
+    writer.Key("alpha");
+    writer.BeginArray();
+    writer.Value(1);
+    writer.Value(-2);
+    writer.Value(3.5);
+    writer.Value(18446744073709551615ull);
+    writer.EndArray();
+    writer.Key("beta");
+    writer.Value(value.object_properties(1).value());
+    writer.Key("epsilon");
+    writer.BeginArray();
+    writer.Null();
+    writer.Value(true);
+    writer.Value(std::numeric_limits<double>::quiet_NaN());
+    writer.EndArray();
+    writer.EndObject();
+
+    EXPECT_EQ(WriteJson(value, configs[index]), output) << index;
+  }
+}
+
+TEST(JsonWriter, Sink) {
+  JsonValue value = MakeJsonArray();
+  for (int index = 0; index < 1000; ++index) {
+    value.add_array_elements()->CopyFrom(
+        MakeJsonObject("alpha", index, "beta", "gamma delta epsilon"));
+  }
+
+  JsonWriterConfig config;
+  config.set_indent(kJsonPrettyIndent);
+  config.set_include_byte_order_mark(true);
+
+  ChunkSink sink;
+  {
+    JsonWriter writer(&sink, config);
+    writer.Value(value);
+    writer.Flush();
+    EXPECT_EQ(WriteJson(value, config), sink.Join());
+  }
+
+  EXPECT_LT(1u, sink.chunks.size());
+  for (size_t index = 0; index < sink.chunks.size(); ++index) {
+    EXPECT_GE(kJsonWriterSinkChunkSize + 64, sink.chunks[index].size());
+  }
+
+  sink.chunks.clear();
+  {
+    JsonWriter writer(&sink);
+    writer.BeginObject();
+    writer.Key("alpha");
+    writer.Value(1);
+    writer.EndObject();
+    EXPECT_TRUE(sink.chunks.empty());
+  }
+  EXPECT_EQ("{\"alpha\":1}", sink.Join());
+}
+
+TEST(JsonWriter, WriteJsonObjectAndArray) {
+  std::string gamma("gamma");
+
+  EXPECT_EQ(WriteJson(MakeJsonObject("alpha", 1, "beta", -2.5, "gamma\n",
+                                     gamma, "delta", MakeJsonArray(true),
+                                     "epsilon", 18446744073709551615ull)),
+            WriteJsonObject("alpha", 1, "beta", -2.5, "gamma\n", gamma,
+                            "delta", MakeJsonArray(true), "epsilon",
+                            18446744073709551615ull));
+
+  EXPECT_EQ(WriteJson(MakeJsonArray(JsonNull(), false, "\"", 3.5f)),
+            WriteJsonArray(JsonNull(), false, "\"", 3.5f));
+
+  JsonWriterConfig config;
+  config.set_indent(kJsonPrettyIndent);
+  std::string output;
+  JsonWriter writer(&output, config);
+  WriteJsonArray(&writer, 1, MakeJsonObject("alpha", 2));
+  EXPECT_EQ(WriteJson(MakeJsonArray(1, MakeJsonObject("alpha", 2)), config),
+            output);
+}
+
+#ifndef NDEBUG
+TEST(JsonWriter, NestingAssertions) {
+  std::string output;
+
+  {
+    JsonWriter writer(&output);
+    writer.BeginObject();
+    EXPECT_DEATH(writer.Value(1), "");
+  }
+
+  {
+    JsonWriter writer(&output);
+    writer.BeginObject();
+    writer.Key("alpha");
+    EXPECT_DEATH(writer.Key("beta"), "");
+    EXPECT_DEATH(writer.EndObject(), "");
+  }
+
+  {
+    JsonWriter writer(&output);
+    writer.Value(1);
+    EXPECT_DEATH(writer.Value(2), "");
+  }
+
+  {
+    JsonWriter writer(&output);
+    writer.BeginArray();
+    EXPECT_DEATH(writer.EndObject(), "");
+  }
+}
+#endif  // NDEBUG
+
 }  // namespace pjcore
@@ -104,4 +104,34 @@ TEST(MakeJsonValue, ArrayValue) {
   ASSERT_EQ(true, value.array_elements(1).bool_value());
 }
 
+TEST(MakeJsonValue, AppendProperty) {
+  JsonValue value = MakeJsonObject();
+  AppendJsonProperty("alpha", "beta", &value);
+  AppendJsonProperty("gamma", MakeJsonArray(1, 2), &value);
+
+  EXPECT_TRUE(AreJsonValuesEqual(
+      MakeJsonObject("alpha", "beta", "gamma", MakeJsonArray(1, 2)), value));
+
+  JsonValue array = MakeJsonArray();
+  AppendJsonElement(std::string("delta"), &array);
+  AppendJsonElement(JsonNull(), &array);
+
+  EXPECT_TRUE(AreJsonValuesEqual(MakeJsonArray("delta", JsonNull()), array));
+}
+
+TEST(MakeJsonValue, SwapNested) {
+  JsonValue nested_array = MakeJsonArray(1, 2);
+  JsonValue nested_object = MakeJsonObject("alpha", "beta");
+
+  JsonValue value = MakeJsonObject("gamma", &nested_array, "delta",
+                                   MakeJsonArray(&nested_object, 3));
+
+  EXPECT_TRUE(AreJsonValuesEqual(
+      MakeJsonObject("gamma", MakeJsonArray(1, 2), "delta",
+                     MakeJsonArray(MakeJsonObject("alpha", "beta"), 3)),
+      value));
+  EXPECT_TRUE(AreJsonValuesEqual(JsonNull(), nested_array));
+  EXPECT_TRUE(AreJsonValuesEqual(JsonNull(), nested_object));
+}
+
 }  // namespace pjcore
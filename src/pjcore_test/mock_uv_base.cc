@@ -173,6 +173,18 @@ uint64_t MockUvBase::timer_get_repeat(const uv_timer_t* /* handle */) {
   return 0;
 }
 
+int MockUvBase::thread_create(uv_thread_t* /* tid */,
+                              void (* /* entry */)(void* arg),
+                              void* /* arg */) {
+  PJCORE_FATALITY("No mock for uv_thread_create");
+  return 0;
+}
+
+int MockUvBase::thread_join(uv_thread_t* /* tid */) {
+  PJCORE_FATALITY("No mock for uv_thread_join");
+  return 0;
+}
+
 int MockUvBase::getaddrinfo(uv_loop_t* /* loop */, uv_getaddrinfo_t* /* req */,
                             uv_getaddrinfo_cb /* getaddrinfo_cb */,
                             const char* /* node */, const char* /* service */,
@@ -57,6 +57,9 @@ class MockUvBase : public AbstractUv {
   int timer_again(uv_timer_t* handle) OVERRIDE;
   void timer_set_repeat(uv_timer_t* handle, uint64_t repeat) OVERRIDE;
   uint64_t timer_get_repeat(const uv_timer_t* handle) OVERRIDE;
+  int thread_create(uv_thread_t* tid, void (*entry)(void* arg),
+                    void* arg) OVERRIDE;
+  int thread_join(uv_thread_t* tid) OVERRIDE;
   int getaddrinfo(uv_loop_t* loop, uv_getaddrinfo_t* req,
                   uv_getaddrinfo_cb getaddrinfo_cb, const char* node,
                   const char* service, const struct addrinfo* hints) OVERRIDE;
@@ -17,6 +17,8 @@
 
 #include <gtest/gtest.h>
 
+#include <string>
+
 #include "pjcore_test/url_parser_test_message.h"
 
 #include "pjcore/url_util.h"
@@ -257,4 +259,142 @@ TEST(ParseUrl, FormFeedInUrl) {
   EXPECT_TRUE(TestMessage(UrlParserTestMessage::kFormFeedInUrl));
 }
 
+TEST(EncodeUri, Short) {
+  std::string encoded;
+  EXPECT_TRUE(EncodeUriComponent("az-_.!~*'()AZ09", &encoded));
+  EXPECT_EQ("az-_.!~*'()AZ09", encoded);
+  EXPECT_TRUE(EncodeUriComponent("a b/c?d=\xCE\xB1", &encoded));
+  EXPECT_EQ("a%20b%2fc%3fd%3d%ce%b1", encoded);
+  EXPECT_TRUE(EncodeUri("http://host/a b?c=d#e", &encoded));
+  EXPECT_EQ("http://host/a%20b?c=d#e", encoded);
+
+  GlobalLogOverride global_log_override;
+  EXPECT_FALSE(EncodeUriComponent("\xCE", &encoded));
+}
+
+TEST(DecodeUri, Short) {
+  std::string decoded;
+  EXPECT_TRUE(DecodeUriComponent("a%20b%2Fc%3fd+e%ce%B1", &decoded));
+  EXPECT_EQ("a b/c?d+e\xCE\xB1", decoded);
+  EXPECT_TRUE(DecodeUri("http://host/a%20b?c=d#e", &decoded));
+  EXPECT_EQ("http://host/a b?c=d#e", decoded);
+
+  GlobalLogOverride global_log_override;
+  EXPECT_FALSE(DecodeUriComponent("a%", &decoded));
+  EXPECT_FALSE(DecodeUriComponent("a%2", &decoded));
+  EXPECT_FALSE(DecodeUriComponent("a%2g", &decoded));
+  EXPECT_FALSE(DecodeUriComponent("a%ce", &decoded));
+}
+
+TEST(EncodeUri, Long) {
+  // An odd length puts escapes at every offset within vector blocks.
+  const std::string segment = "Search-terms_and.more~ (\xCE\xB1/\xCE\xB2)";
+  const std::string encoded_component_segment =
+      "Search-terms_and.more~%20(%ce%b1%2f%ce%b2)";
+  const std::string encoded_uri_segment =
+      "Search-terms_and.more~%20(%ce%b1/%ce%b2)";
+
+  std::string str;
+  std::string expected_component;
+  std::string expected_uri;
+  for (int count = 0; count < 100; ++count) {
+    str += segment;
+    expected_component += encoded_component_segment;
+    expected_uri += encoded_uri_segment;
+  }
+
+  std::string encoded;
+  EXPECT_TRUE(EncodeUriComponent(str, &encoded));
+  EXPECT_EQ(expected_component, encoded);
+  EXPECT_TRUE(EncodeUri(str, &encoded));
+  EXPECT_EQ(expected_uri, encoded);
+
+  std::string decoded;
+  EXPECT_TRUE(DecodeUriComponent(expected_component, &decoded));
+  EXPECT_EQ(str, decoded);
+  EXPECT_TRUE(DecodeUri(expected_uri, &decoded));
+  EXPECT_EQ(str, decoded);
+
+  GlobalLogOverride global_log_override;
+  EXPECT_FALSE(DecodeUriComponent(expected_component + "%", &decoded));
+  EXPECT_FALSE(DecodeUriComponent(expected_component + "%x0", &decoded));
+  EXPECT_FALSE(EncodeUriComponent(str + "\xCE", &encoded));
+}
+
+TEST(ParseUrlParameters, Decode) {
+  ParsedUrl parsed_url;
+  parsed_url.set_query("a=1&b=x+y%2B&&c&=2&d=%ce&e=&a=3");
+  {
+    GlobalLogOverride global_log_override;
+    ParseUrlParameters(&parsed_url);
+  }
+
+  ASSERT_EQ(4, parsed_url.parameters_size());
+  EXPECT_EQ("a", parsed_url.parameters(0).name());
+  EXPECT_EQ("1", parsed_url.parameters(0).value());
+  EXPECT_EQ("b", parsed_url.parameters(1).name());
+  EXPECT_EQ("x y+", parsed_url.parameters(1).value());
+  EXPECT_EQ("e", parsed_url.parameters(2).name());
+  EXPECT_EQ("", parsed_url.parameters(2).value());
+  EXPECT_EQ("a", parsed_url.parameters(3).name());
+  EXPECT_EQ("3", parsed_url.parameters(3).value());
+
+  // Parsing again replaces the parameters.
+  {
+    GlobalLogOverride global_log_override;
+    ParseUrlParameters(&parsed_url);
+  }
+  EXPECT_EQ(4, parsed_url.parameters_size());
+
+  parsed_url.clear_query();
+  ParseUrlParameters(&parsed_url);
+  EXPECT_EQ(0, parsed_url.parameters_size());
+}
+
+TEST(ParseUrl, Parameters) {
+  const char* url = "/path?a=1&b=x+y%2B&c#fragment";
+
+  ParsedUrl parsed_url;
+  Error error;
+  ASSERT_TRUE(ParseUrl(url, false, &parsed_url, &error));
+  EXPECT_EQ("a=1&b=x+y%2B&c", parsed_url.query());
+  ASSERT_EQ(2, parsed_url.parameters_size());
+  EXPECT_EQ("a", parsed_url.parameters(0).name());
+  EXPECT_EQ("1", parsed_url.parameters(0).value());
+  EXPECT_EQ("b", parsed_url.parameters(1).name());
+  EXPECT_EQ("x y+", parsed_url.parameters(1).value());
+
+  ParsedUrl lazy_parsed_url;
+  ASSERT_TRUE(ParseUrl(url, false, &lazy_parsed_url, &error, false));
+  EXPECT_EQ(parsed_url.query(), lazy_parsed_url.query());
+  EXPECT_EQ(0, lazy_parsed_url.parameters_size());
+
+  ParseUrlParameters(&lazy_parsed_url);
+  EXPECT_TRUE(AreJsonValuesEqual(MakeJsonValue(parsed_url),
+                                 MakeJsonValue(lazy_parsed_url)));
+}
+
+TEST(GetUrlParameter, Find) {
+  const char* query = "a=1&first+name=x+y%2B&d=%ce&d=4&=6";
+
+  std::string value;
+  EXPECT_TRUE(GetUrlParameter(query, "a", &value));
+  EXPECT_EQ("1", value);
+  EXPECT_TRUE(GetUrlParameter(query, "first name", &value));
+  EXPECT_EQ("x y+", value);
+  // Skips the value that fails to decode, as ParseUrlParameters does.
+  {
+    GlobalLogOverride global_log_override;
+    EXPECT_TRUE(GetUrlParameter(query, "d", &value));
+  }
+  EXPECT_EQ("4", value);
+  EXPECT_TRUE(GetUrlParameter("%61=5&a=1", "a", &value));
+  EXPECT_EQ("5", value);
+
+  EXPECT_FALSE(GetUrlParameter(query, "first+name", &value));
+  EXPECT_FALSE(GetUrlParameter(query, "b", &value));
+  EXPECT_FALSE(GetUrlParameter(query, "", &value));
+  EXPECT_EQ("", value);
+}
+
 }  // namespace pjcore
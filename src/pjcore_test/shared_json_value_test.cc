@@ -0,0 +1,188 @@
+// JSON [de]serialization for protobuf + embedded HTTP server and client in C++.
+// Copyright (C) 2014 http://protojson.com/
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+
+#include "pjcore/shared_json_value.h"
+
+#include <gtest/gtest.h>
+
+#include "pjcore/json_properties.h"
+#include "pjcore/json_reader.h"
+#include "pjcore/json_util.h"
+#include "pjcore/json_writer.h"
+
+namespace pjcore {
+
+TEST(SharedJsonValue, Null) {
+  SharedJsonValue value;
+  EXPECT_EQ(JsonValue::TYPE_NULL, value.type());
+  EXPECT_TRUE(AreJsonValuesEqual(JsonNull(), MakeJsonValue(value)));
+  EXPECT_EQ("null", WriteJson(value));
+}
+
+TEST(SharedJsonValue, RoundTrip) {
+  JsonValue json_value = MakeJsonObject(
+      "alpha", MakeJsonArray(true, -1, 2ull, 3.5, "beta", JsonNull()),
+      "gamma", MakeJsonObject("delta", "epsilon"));
+
+  SharedJsonValue value(json_value);
+  EXPECT_TRUE(AreJsonValuesEqual(json_value, MakeJsonValue(value)));
+  EXPECT_EQ(WriteJson(json_value), WriteJson(value));
+
+  EXPECT_EQ(JsonValue::TYPE_OBJECT, value.type());
+  ASSERT_EQ(2, value.object_properties_size());
+  EXPECT_EQ("alpha", value.object_property_name(0));
+  EXPECT_EQ(6, value.object_property_value(0).array_elements_size());
+  EXPECT_EQ(-1, value.GetProperty("alpha").array_elements(1).signed_value());
+  EXPECT_EQ("epsilon",
+            value.GetProperty("gamma").GetProperty("delta").string_value());
+  EXPECT_TRUE(value.HasProperty("gamma"));
+  EXPECT_FALSE(value.HasProperty("zeta"));
+  EXPECT_EQ(JsonValue::TYPE_NULL, value.GetProperty("zeta").type());
+
+  JsonValue consumed(json_value);
+  SharedJsonValue consumed_value(&consumed);
+  EXPECT_TRUE(AreJsonValuesEqual(json_value, MakeJsonValue(consumed_value)));
+  EXPECT_EQ(JsonValue::TYPE_NULL, consumed.type());
+}
+
+TEST(SharedJsonValue, PackedArray) {
+  JsonValue json_value;
+  Error error;
+  JsonReaderConfig pack_numeric_arrays;
+  pack_numeric_arrays.set_pack_numeric_arrays(true);
+  ASSERT_TRUE(ReadJson("[1,2,3]", &json_value, &error, pack_numeric_arrays));
+
+  SharedJsonValue value(json_value);
+  ASSERT_EQ(3, value.array_elements_size());
+  EXPECT_EQ(2, value.array_elements(1).signed_value());
+
+  SharedJsonValue consumed_value(&json_value);
+  EXPECT_EQ("[1,2,3]", WriteJson(consumed_value));
+}
+
+TEST(SharedJsonValue, CopyOnWrite) {
+  SharedJsonValue original(MakeJsonObject(
+      "alpha", MakeJsonObject("beta", 1, "gamma", MakeJsonArray(2, 3)),
+      "delta", MakeJsonObject("epsilon", 4)));
+
+  SharedJsonValue copy = original;
+  EXPECT_TRUE(copy.IsSharedWith(original));
+
+  *copy.MutableProperty("alpha")->MutableProperty("beta") =
+      MakeSharedJsonValue(5);
+
+  EXPECT_FALSE(copy.IsSharedWith(original));
+  EXPECT_FALSE(
+      copy.GetProperty("alpha").IsSharedWith(original.GetProperty("alpha")));
+  EXPECT_TRUE(
+      copy.GetProperty("delta").IsSharedWith(original.GetProperty("delta")));
+  EXPECT_TRUE(copy.GetProperty("alpha").GetProperty("gamma").IsSharedWith(
+      original.GetProperty("alpha").GetProperty("gamma")));
+
+  EXPECT_EQ(
+      "{\"alpha\":{\"beta\":1,\"gamma\":[2,3]},\"delta\":{\"epsilon\":4}}",
+            WriteJson(original));
+  EXPECT_EQ(
+      "{\"alpha\":{\"beta\":5,\"gamma\":[2,3]},\"delta\":{\"epsilon\":4}}",
+            WriteJson(copy));
+
+  *copy.MutableProperty("alpha")->MutableProperty("gamma")->AddArrayElement() =
+      MakeSharedJsonValue("zeta");
+  *copy.MutableProperty("alpha")->MutableProperty("gamma")->MutableArrayElement(
+      0) = SharedJsonNull();
+  copy.ClearProperty("delta");
+
+  EXPECT_EQ("{\"alpha\":{\"beta\":5,\"gamma\":[null,3,\"zeta\"]}}",
+            WriteJson(copy));
+  EXPECT_EQ(2, original.GetProperty("alpha")
+                   .GetProperty("gamma")
+                   .array_elements_size());
+  EXPECT_TRUE(original.HasProperty("delta"));
+}
+
+TEST(SharedJsonValue, SortedProperties) {
+  JsonValue json_value;
+  Error error;
+  ASSERT_TRUE(ReadJson("{\"gamma\":1,\"alpha\":2,\"gamma\":3}",
+                       &json_value, &error));
+
+  SharedJsonValue value(json_value);
+  ASSERT_EQ(2, value.object_properties_size());
+  EXPECT_EQ("alpha", value.object_property_name(0));
+  EXPECT_EQ(1, value.GetProperty("gamma").signed_value());
+
+  *value.MutableProperty("beta") = MakeSharedJsonValue(4);
+  *value.MutableProperty("delta") = MakeSharedJsonValue(5);
+  *value.MutableProperty("aardvark") = MakeSharedJsonValue(6);
+  EXPECT_EQ(
+      "{\"aardvark\":6,\"alpha\":2,\"beta\":4,\"delta\":5,\"gamma\":1}",
+      WriteJson(value));
+  EXPECT_TRUE(AreJsonPropertiesNormalized(MakeJsonValue(value)));
+
+  value.ClearProperty("beta");
+  value.ClearProperty("zeta");
+  EXPECT_FALSE(value.HasProperty("beta"));
+  EXPECT_EQ(5, value.GetProperty("delta").signed_value());
+  EXPECT_EQ(4, value.object_properties_size());
+}
+
+TEST(SharedJsonValueInterner, Test) {
+  SharedJsonValueInterner interner;
+
+  JsonValue json_value = MakeJsonObject(
+      "alpha", MakeJsonObject("beta", MakeJsonArray(1, "gamma")),
+      "delta", MakeJsonObject("beta", MakeJsonArray(1, "gamma")),
+      "epsilon", MakeJsonArray(1.0, -0.0, 0.0));
+
+  SharedJsonValue value = interner.Intern(json_value);
+  EXPECT_TRUE(AreJsonValuesEqual(json_value, MakeJsonValue(value)));
+  EXPECT_EQ(WriteJson(json_value), WriteJson(value));
+
+  EXPECT_TRUE(
+      value.GetProperty("alpha").IsSharedWith(value.GetProperty("delta")));
+  EXPECT_FALSE(value.GetProperty("epsilon").array_elements(0).IsSharedWith(
+      value.GetProperty("alpha")
+          .GetProperty("beta")
+          .array_elements(0)));
+  EXPECT_FALSE(value.GetProperty("epsilon").array_elements(1).IsSharedWith(
+      value.GetProperty("epsilon").array_elements(2)));
+
+  // 1, "gamma", [1,"gamma"], {"beta":...}, 1.0, -0.0, 0.0, [...], root.
+  EXPECT_EQ(9u, interner.size());
+
+  SharedJsonValue other = interner.Intern(MakeJsonObject(
+      "zeta", MakeJsonObject("beta", MakeJsonArray(1, "gamma"))));
+  EXPECT_TRUE(
+      other.GetProperty("zeta").IsSharedWith(value.GetProperty("alpha")));
+  EXPECT_TRUE(interner.Intern(json_value).IsSharedWith(value));
+  EXPECT_EQ(10u, interner.size());
+
+  // Duplicate names keep their first value, as in NormalizeJsonProperties.
+  SharedJsonValue duplicated = interner.Intern(
+      MakeJsonObject("eta", 1, "theta", 2, "eta", 3));
+  SharedJsonValue normalized =
+      interner.Intern(MakeJsonObject("eta", 1, "theta", 2));
+  EXPECT_TRUE(duplicated.IsSharedWith(normalized));
+  EXPECT_EQ("{\"eta\":1,\"theta\":2}", WriteJson(duplicated));
+
+  interner.Clear();
+  EXPECT_EQ(0u, interner.size());
+  EXPECT_FALSE(interner.Intern(json_value).IsSharedWith(value));
+}
+
+}  // namespace pjcore
@@ -0,0 +1,1457 @@
+// Generated by protoc-gen-pjcore.  DO NOT EDIT!
+// source: pjcore_test/test_message.proto
+
+#include "pjcore_test/test_message.pjcore.h"
+
+#include <set>
+#include <string>
+#include <vector>
+
+namespace pjcore {
+
+namespace {
+
+bool ReadTestMessageField(
+    int field_index, ::pjcore::JsonTokenizer* tokenizer,
+    TestMessage* message, ::pjcore::Error* error,
+    ::google::protobuf::RepeatedPtrField<
+        ::pjcore::JsonValue::Property>*
+        unknown_object_properties) {
+  switch (field_index) {
+    case 0:
+      if (tokenizer->token() == ::pjcore::JsonTokenizer::TOKEN_NULL) {
+        message->clear_optional_int32();
+        return true;
+      }
+      {
+        int32_t unboxed;
+        PJCORE_REQUIRE_SILENT(
+            ::pjcore::UnboxJsonValue(*tokenizer, &unboxed, error),
+            "Failed to unbox int32_t");
+        message->set_optional_int32(unboxed);
+      }
+      return true;
+
+    case 1:
+      if (tokenizer->token() == ::pjcore::JsonTokenizer::TOKEN_NULL) {
+        message->clear_optional_int64();
+        return true;
+      }
+      {
+        int64_t unboxed;
+        PJCORE_REQUIRE_SILENT(
+            ::pjcore::UnboxJsonValue(*tokenizer, &unboxed, error),
+            "Failed to unbox int64_t");
+        message->set_optional_int64(unboxed);
+      }
+      return true;
+
+    case 2:
+      if (tokenizer->token() == ::pjcore::JsonTokenizer::TOKEN_NULL) {
+        message->clear_optional_uint32();
+        return true;
+      }
+      {
+        uint32_t unboxed;
+        PJCORE_REQUIRE_SILENT(
+            ::pjcore::UnboxJsonValue(*tokenizer, &unboxed, error),
+            "Failed to unbox uint32_t");
+        message->set_optional_uint32(unboxed);
+      }
+      return true;
+
+    case 3:
+      if (tokenizer->token() == ::pjcore::JsonTokenizer::TOKEN_NULL) {
+        message->clear_optional_uint64();
+        return true;
+      }
+      {
+        uint64_t unboxed;
+        PJCORE_REQUIRE_SILENT(
+            ::pjcore::UnboxJsonValue(*tokenizer, &unboxed, error),
+            "Failed to unbox uint64_t");
+        message->set_optional_uint64(unboxed);
+      }
+      return true;
+
+    case 4:
+      if (tokenizer->token() == ::pjcore::JsonTokenizer::TOKEN_NULL) {
+        message->clear_optional_double();
+        return true;
+      }
+      {
+        double unboxed;
+        PJCORE_REQUIRE_SILENT(
+            ::pjcore::UnboxJsonValue(*tokenizer, &unboxed, error),
+            "Failed to unbox double");
+        message->set_optional_double(unboxed);
+      }
+      return true;
+
+    case 5:
+      if (tokenizer->token() == ::pjcore::JsonTokenizer::TOKEN_NULL) {
+        message->clear_optional_float();
+        return true;
+      }
+      {
+        float unboxed;
+        PJCORE_REQUIRE_SILENT(
+            ::pjcore::UnboxJsonValue(*tokenizer, &unboxed, error),
+            "Failed to unbox float");
+        message->set_optional_float(unboxed);
+      }
+      return true;
+
+    case 6:
+      if (tokenizer->token() == ::pjcore::JsonTokenizer::TOKEN_NULL) {
+        message->clear_optional_bool();
+        return true;
+      }
+      {
+        bool unboxed;
+        PJCORE_REQUIRE_SILENT(
+            ::pjcore::UnboxJsonValue(*tokenizer, &unboxed, error),
+            "Failed to unbox bool");
+        message->set_optional_bool(unboxed);
+      }
+      return true;
+
+    case 7:
+      if (tokenizer->token() == ::pjcore::JsonTokenizer::TOKEN_NULL) {
+        message->clear_optional_enum();
+        return true;
+      }
+      {
+        ::pjcore::TestMessage_TestEnum unboxed;
+        if (tokenizer->type() == ::pjcore::JsonValue::TYPE_STRING &&
+            ::pjcore::TestMessage_TestEnum_Parse(tokenizer->string_value(), &unboxed)) {
+          message->set_optional_enum(unboxed);
+        } else {
+          int32_t number;
+          bool has_number;
+          PJCORE_REQUIRE_SILENT(
+              ::pjcore::UnboxJsonEnumNumber(*tokenizer, &number, &has_number,
+                                            error),
+              "Failed to unbox enum");
+          if (has_number && ::pjcore::TestMessage_TestEnum_IsValid(number)) {
+            message->set_optional_enum(static_cast< ::pjcore::TestMessage_TestEnum>(number));
+          }
+        }
+      }
+      return true;
+
+    case 8:
+      if (tokenizer->token() == ::pjcore::JsonTokenizer::TOKEN_NULL) {
+        message->clear_optional_string();
+        return true;
+      }
+      PJCORE_REQUIRE_SILENT(
+          ::pjcore::UnboxJsonString(tokenizer, message->mutable_optional_string(), error),
+          "Failed to unbox string");
+      return true;
+
+    case 9:
+      if (tokenizer->token() == ::pjcore::JsonTokenizer::TOKEN_NULL) {
+        message->clear_optional_bytes();
+        return true;
+      }
+      PJCORE_REQUIRE_SILENT(
+          ::pjcore::UnboxJsonBytes(*tokenizer, message->mutable_optional_bytes(), error),
+          "Failed to unbox string");
+      return true;
+
+    case 10:
+      if (tokenizer->token() == ::pjcore::JsonTokenizer::TOKEN_NULL) {
+        message->clear_optional_message();
+        return true;
+      }
+      PJCORE_REQUIRE(
+          ::pjcore::ReadJson(tokenizer, message->mutable_optional_message(), error,
+              unknown_object_properties),
+          "Failed to unbox message");
+      return true;
+
+    case 11:
+      if (tokenizer->token() == ::pjcore::JsonTokenizer::TOKEN_NULL) {
+        message->clear_repeated_int32();
+        return true;
+      }
+      if (tokenizer->token() == ::pjcore::JsonTokenizer::TOKEN_BEGIN_ARRAY) {
+        for (;;) {
+          PJCORE_REQUIRE_SILENT(tokenizer->Next(error), "Failed to read value");
+          if (tokenizer->token() == ::pjcore::JsonTokenizer::TOKEN_END_ARRAY) {
+            return true;
+          }
+          {
+            int32_t unboxed;
+            PJCORE_REQUIRE_SILENT(
+                ::pjcore::UnboxJsonValue(*tokenizer, &unboxed, error),
+                "Failed to unbox int32_t");
+            message->add_repeated_int32(unboxed);
+          }
+        }
+      }
+      PJCORE_FAIL(
+          "Array expected for repeated field, or object if repeated message "
+          "has field name");
+
+    case 12:
+      if (tokenizer->token() == ::pjcore::JsonTokenizer::TOKEN_NULL) {
+        message->clear_repeated_int64();
+        return true;
+      }
+      if (tokenizer->token() == ::pjcore::JsonTokenizer::TOKEN_BEGIN_ARRAY) {
+        for (;;) {
+          PJCORE_REQUIRE_SILENT(tokenizer->Next(error), "Failed to read value");
+          if (tokenizer->token() == ::pjcore::JsonTokenizer::TOKEN_END_ARRAY) {
+            return true;
+          }
+          {
+            int64_t unboxed;
+            PJCORE_REQUIRE_SILENT(
+                ::pjcore::UnboxJsonValue(*tokenizer, &unboxed, error),
+                "Failed to unbox int64_t");
+            message->add_repeated_int64(unboxed);
+          }
+        }
+      }
+      PJCORE_FAIL(
+          "Array expected for repeated field, or object if repeated message "
+          "has field name");
+
+    case 13:
+      if (tokenizer->token() == ::pjcore::JsonTokenizer::TOKEN_NULL) {
+        message->clear_repeated_uint32();
+        return true;
+      }
+      if (tokenizer->token() == ::pjcore::JsonTokenizer::TOKEN_BEGIN_ARRAY) {
+        for (;;) {
+          PJCORE_REQUIRE_SILENT(tokenizer->Next(error), "Failed to read value");
+          if (tokenizer->token() == ::pjcore::JsonTokenizer::TOKEN_END_ARRAY) {
+            return true;
+          }
+          {
+            uint32_t unboxed;
+            PJCORE_REQUIRE_SILENT(
+                ::pjcore::UnboxJsonValue(*tokenizer, &unboxed, error),
+                "Failed to unbox uint32_t");
+            message->add_repeated_uint32(unboxed);
+          }
+        }
+      }
+      PJCORE_FAIL(
+          "Array expected for repeated field, or object if repeated message "
+          "has field name");
+
+    case 14:
+      if (tokenizer->token() == ::pjcore::JsonTokenizer::TOKEN_NULL) {
+        message->clear_repeated_uint64();
+        return true;
+      }
+      if (tokenizer->token() == ::pjcore::JsonTokenizer::TOKEN_BEGIN_ARRAY) {
+        for (;;) {
+          PJCORE_REQUIRE_SILENT(tokenizer->Next(error), "Failed to read value");
+          if (tokenizer->token() == ::pjcore::JsonTokenizer::TOKEN_END_ARRAY) {
+            return true;
+          }
+          {
+            uint64_t unboxed;
+            PJCORE_REQUIRE_SILENT(
+                ::pjcore::UnboxJsonValue(*tokenizer, &unboxed, error),
+                "Failed to unbox uint64_t");
+            message->add_repeated_uint64(unboxed);
+          }
+        }
+      }
+      PJCORE_FAIL(
+          "Array expected for repeated field, or object if repeated message "
+          "has field name");
+
+    case 15:
+      if (tokenizer->token() == ::pjcore::JsonTokenizer::TOKEN_NULL) {
+        message->clear_repeated_double();
+        return true;
+      }
+      if (tokenizer->token() == ::pjcore::JsonTokenizer::TOKEN_BEGIN_ARRAY) {
+        for (;;) {
+          PJCORE_REQUIRE_SILENT(tokenizer->Next(error), "Failed to read value");
+          if (tokenizer->token() == ::pjcore::JsonTokenizer::TOKEN_END_ARRAY) {
+            return true;
+          }
+          {
+            double unboxed;
+            PJCORE_REQUIRE_SILENT(
+                ::pjcore::UnboxJsonValue(*tokenizer, &unboxed, error),
+                "Failed to unbox double");
+            message->add_repeated_double(unboxed);
+          }
+        }
+      }
+      PJCORE_FAIL(
+          "Array expected for repeated field, or object if repeated message "
+          "has field name");
+
+    case 16:
+      if (tokenizer->token() == ::pjcore::JsonTokenizer::TOKEN_NULL) {
+        message->clear_repeated_float();
+        return true;
+      }
+      if (tokenizer->token() == ::pjcore::JsonTokenizer::TOKEN_BEGIN_ARRAY) {
+        for (;;) {
+          PJCORE_REQUIRE_SILENT(tokenizer->Next(error), "Failed to read value");
+          if (tokenizer->token() == ::pjcore::JsonTokenizer::TOKEN_END_ARRAY) {
+            return true;
+          }
+          {
+            float unboxed;
+            PJCORE_REQUIRE_SILENT(
+                ::pjcore::UnboxJsonValue(*tokenizer, &unboxed, error),
+                "Failed to unbox float");
+            message->add_repeated_float(unboxed);
+          }
+        }
+      }
+      PJCORE_FAIL(
+          "Array expected for repeated field, or object if repeated message "
+          "has field name");
+
+    case 17:
+      if (tokenizer->token() == ::pjcore::JsonTokenizer::TOKEN_NULL) {
+        message->clear_repeated_bool();
+        return true;
+      }
+      if (tokenizer->token() == ::pjcore::JsonTokenizer::TOKEN_BEGIN_ARRAY) {
+        for (;;) {
+          PJCORE_REQUIRE_SILENT(tokenizer->Next(error), "Failed to read value");
+          if (tokenizer->token() == ::pjcore::JsonTokenizer::TOKEN_END_ARRAY) {
+            return true;
+          }
+          {
+            bool unboxed;
+            PJCORE_REQUIRE_SILENT(
+                ::pjcore::UnboxJsonValue(*tokenizer, &unboxed, error),
+                "Failed to unbox bool");
+            message->add_repeated_bool(unboxed);
+          }
+        }
+      }
+      PJCORE_FAIL(
+          "Array expected for repeated field, or object if repeated message "
+          "has field name");
+
+    case 18:
+      if (tokenizer->token() == ::pjcore::JsonTokenizer::TOKEN_NULL) {
+        message->clear_repeated_enum();
+        return true;
+      }
+      if (tokenizer->token() == ::pjcore::JsonTokenizer::TOKEN_BEGIN_ARRAY) {
+        for (;;) {
+          PJCORE_REQUIRE_SILENT(tokenizer->Next(error), "Failed to read value");
+          if (tokenizer->token() == ::pjcore::JsonTokenizer::TOKEN_END_ARRAY) {
+            return true;
+          }
+          {
+            ::pjcore::TestMessage_TestEnum unboxed;
+            if (tokenizer->type() == ::pjcore::JsonValue::TYPE_STRING &&
+                ::pjcore::TestMessage_TestEnum_Parse(tokenizer->string_value(), &unboxed)) {
+              message->add_repeated_enum(unboxed);
+            } else {
+              int32_t number;
+              bool has_number;
+              PJCORE_REQUIRE_SILENT(
+                  ::pjcore::UnboxJsonEnumNumber(*tokenizer, &number, &has_number,
+                                                error),
+                  "Failed to unbox enum");
+              if (has_number && ::pjcore::TestMessage_TestEnum_IsValid(number)) {
+                message->add_repeated_enum(static_cast< ::pjcore::TestMessage_TestEnum>(number));
+              }
+            }
+          }
+        }
+      }
+      PJCORE_FAIL(
+          "Array expected for repeated field, or object if repeated message "
+          "has field name");
+
+    case 19:
+      if (tokenizer->token() == ::pjcore::JsonTokenizer::TOKEN_NULL) {
+        message->clear_repeated_string();
+        return true;
+      }
+      if (tokenizer->token() == ::pjcore::JsonTokenizer::TOKEN_BEGIN_ARRAY) {
+        for (;;) {
+          PJCORE_REQUIRE_SILENT(tokenizer->Next(error), "Failed to read value");
+          if (tokenizer->token() == ::pjcore::JsonTokenizer::TOKEN_END_ARRAY) {
+            return true;
+          }
+          PJCORE_REQUIRE_SILENT(
+              ::pjcore::UnboxJsonString(tokenizer, message->add_repeated_string(), error),
+              "Failed to unbox string");
+        }
+      }
+      PJCORE_FAIL(
+          "Array expected for repeated field, or object if repeated message "
+          "has field name");
+
+    case 20:
+      if (tokenizer->token() == ::pjcore::JsonTokenizer::TOKEN_NULL) {
+        message->clear_repeated_bytes();
+        return true;
+      }
+      if (tokenizer->token() == ::pjcore::JsonTokenizer::TOKEN_BEGIN_ARRAY) {
+        for (;;) {
+          PJCORE_REQUIRE_SILENT(tokenizer->Next(error), "Failed to read value");
+          if (tokenizer->token() == ::pjcore::JsonTokenizer::TOKEN_END_ARRAY) {
+            return true;
+          }
+          PJCORE_REQUIRE_SILENT(
+              ::pjcore::UnboxJsonBytes(*tokenizer, message->add_repeated_bytes(), error),
+              "Failed to unbox string");
+        }
+      }
+      PJCORE_FAIL(
+          "Array expected for repeated field, or object if repeated message "
+          "has field name");
+
+    case 21:
+      if (tokenizer->token() == ::pjcore::JsonTokenizer::TOKEN_NULL) {
+        message->clear_repeated_message();
+        return true;
+      }
+      if (tokenizer->token() == ::pjcore::JsonTokenizer::TOKEN_BEGIN_ARRAY) {
+        for (;;) {
+          PJCORE_REQUIRE_SILENT(tokenizer->Next(error), "Failed to read value");
+          if (tokenizer->token() == ::pjcore::JsonTokenizer::TOKEN_END_ARRAY) {
+            return true;
+          }
+          PJCORE_REQUIRE(
+              ::pjcore::ReadJson(tokenizer, message->add_repeated_message(), error,
+                  unknown_object_properties),
+              "Failed to unbox message");
+        }
+      }
+      PJCORE_FAIL(
+          "Array expected for repeated field, or object if repeated message "
+          "has field name");
+
+    default:
+      PJCORE_CHECK(false);  // field_index
+      return false;
+  }
+}
+
+bool ReadTestMessageWithObjectPropertiesField(
+    int field_index, ::pjcore::JsonTokenizer* tokenizer,
+    TestMessageWithObjectProperties* message, ::pjcore::Error* error,
+    ::google::protobuf::RepeatedPtrField<
+        ::pjcore::JsonValue::Property>*
+        unknown_object_properties) {
+  switch (field_index) {
+    case 0:
+      if (tokenizer->token() == ::pjcore::JsonTokenizer::TOKEN_NULL) {
+        message->clear_object_properties();
+        return true;
+      }
+      if (tokenizer->token() == ::pjcore::JsonTokenizer::TOKEN_BEGIN_ARRAY) {
+        for (;;) {
+          PJCORE_REQUIRE_SILENT(tokenizer->Next(error), "Failed to read value");
+          if (tokenizer->token() == ::pjcore::JsonTokenizer::TOKEN_END_ARRAY) {
+            return true;
+          }
+          PJCORE_REQUIRE(
+              ::pjcore::ReadJsonMessage(tokenizer, message->add_object_properties(), error,
+                  unknown_object_properties),
+              "Failed to unbox message");
+        }
+      }
+      if (tokenizer->token() == ::pjcore::JsonTokenizer::TOKEN_BEGIN_OBJECT) {
+        ::google::protobuf::RepeatedPtrField< ::pjcore::JsonValue_Property> entries;
+        std::vector<std::string> names;
+        std::set<std::string> seen_names;
+        for (;;) {
+          PJCORE_REQUIRE_SILENT(tokenizer->Next(error), "Failed to read property");
+          if (tokenizer->token() == ::pjcore::JsonTokenizer::TOKEN_END_OBJECT) {
+            break;
+          }
+          names.push_back(std::string());
+          names.back().swap(*tokenizer->mutable_string_value());
+          PJCORE_REQUIRE_SILENT(tokenizer->Next(error), "Failed to read value");
+          if (!tokenizer->config().properties_as_is() &&
+              !seen_names.insert(names.back()).second) {
+            names.pop_back();
+            PJCORE_REQUIRE_SILENT(tokenizer->SkipValue(error), "Failed to skip value");
+            continue;
+          }
+          PJCORE_REQUIRE_SILENT(
+              ::pjcore::ReadJsonMessage(tokenizer, entries.Add(), error, NULL),
+              "Failed to parse message JSON");
+        }
+        std::vector<size_t> order;
+        ::pjcore::OrderJsonNames(tokenizer->config(), names, &order);
+        for (std::vector<size_t>::const_iterator it = order.begin();
+             it != order.end(); ++it) {
+          ::pjcore::JsonValue_Property* entry = message->add_object_properties();
+          entry->Swap(entries.Mutable(static_cast<int>(*it)));
+          ::pjcore::JsonValue name_value = ::pjcore::MakeJsonValue(names[*it]);
+          PJCORE_REQUIRE_SILENT(
+              ::pjcore::UnboxJsonValue(name_value, entry->mutable_name(), error),
+              "Failed to unbox string");
+        }
+        return true;
+      }
+      PJCORE_FAIL(
+          "Array expected for repeated field, or object if repeated message "
+          "has field name");
+
+    default:
+      PJCORE_CHECK(false);  // field_index
+      return false;
+  }
+}
+
+bool ReadTestMessageWithStringMapField(
+    int field_index, ::pjcore::JsonTokenizer* tokenizer,
+    TestMessageWithStringMap* message, ::pjcore::Error* error,
+    ::google::protobuf::RepeatedPtrField<
+        ::pjcore::JsonValue::Property>*
+        unknown_object_properties) {
+  switch (field_index) {
+    case 0:
+      if (tokenizer->token() == ::pjcore::JsonTokenizer::TOKEN_NULL) {
+        message->clear_entries();
+        return true;
+      }
+      if (tokenizer->token() == ::pjcore::JsonTokenizer::TOKEN_BEGIN_ARRAY) {
+        for (;;) {
+          PJCORE_REQUIRE_SILENT(tokenizer->Next(error), "Failed to read value");
+          if (tokenizer->token() == ::pjcore::JsonTokenizer::TOKEN_END_ARRAY) {
+            return true;
+          }
+          PJCORE_REQUIRE(
+              ::pjcore::ReadJson(tokenizer, message->add_entries(), error,
+                  unknown_object_properties),
+              "Failed to unbox message");
+        }
+      }
+      if (tokenizer->token() == ::pjcore::JsonTokenizer::TOKEN_BEGIN_OBJECT) {
+        ::google::protobuf::RepeatedPtrField< ::pjcore::TestMessageWithStringMap_Entry> entries;
+        std::vector<std::string> names;
+        std::set<std::string> seen_names;
+        for (;;) {
+          PJCORE_REQUIRE_SILENT(tokenizer->Next(error), "Failed to read property");
+          if (tokenizer->token() == ::pjcore::JsonTokenizer::TOKEN_END_OBJECT) {
+            break;
+          }
+          names.push_back(std::string());
+          names.back().swap(*tokenizer->mutable_string_value());
+          PJCORE_REQUIRE_SILENT(tokenizer->Next(error), "Failed to read value");
+          if (!tokenizer->config().properties_as_is() &&
+              !seen_names.insert(names.back()).second) {
+            names.pop_back();
+            PJCORE_REQUIRE_SILENT(tokenizer->SkipValue(error), "Failed to skip value");
+            continue;
+          }
+          PJCORE_REQUIRE_SILENT(
+              ::pjcore::ReadJson(tokenizer, entries.Add(), error, NULL),
+              "Failed to parse message JSON");
+        }
+        std::vector<size_t> order;
+        ::pjcore::OrderJsonNames(tokenizer->config(), names, &order);
+        for (std::vector<size_t>::const_iterator it = order.begin();
+             it != order.end(); ++it) {
+          ::pjcore::TestMessageWithStringMap_Entry* entry = message->add_entries();
+          entry->Swap(entries.Mutable(static_cast<int>(*it)));
+          ::pjcore::JsonValue name_value = ::pjcore::MakeJsonValue(names[*it]);
+          PJCORE_REQUIRE_SILENT(
+              ::pjcore::UnboxJsonValue(name_value, entry->mutable_name(), error),
+              "Failed to unbox string");
+        }
+        return true;
+      }
+      PJCORE_FAIL(
+          "Array expected for repeated field, or object if repeated message "
+          "has field name");
+
+    default:
+      PJCORE_CHECK(false);  // field_index
+      return false;
+  }
+}
+
+bool ReadTestMessageWithStringMap_EntryField(
+    int field_index, ::pjcore::JsonTokenizer* tokenizer,
+    TestMessageWithStringMap_Entry* message, ::pjcore::Error* error,
+    ::google::protobuf::RepeatedPtrField<
+        ::pjcore::JsonValue::Property>*
+        unknown_object_properties) {
+  switch (field_index) {
+    case 0:
+      if (tokenizer->token() == ::pjcore::JsonTokenizer::TOKEN_NULL) {
+        message->clear_name();
+        return true;
+      }
+      PJCORE_REQUIRE_SILENT(
+          ::pjcore::UnboxJsonString(tokenizer, message->mutable_name(), error),
+          "Failed to unbox string");
+      return true;
+
+    case 1:
+      if (tokenizer->token() == ::pjcore::JsonTokenizer::TOKEN_NULL) {
+        message->clear_data();
+        return true;
+      }
+      {
+        int32_t unboxed;
+        PJCORE_REQUIRE_SILENT(
+            ::pjcore::UnboxJsonValue(*tokenizer, &unboxed, error),
+            "Failed to unbox int32_t");
+        message->set_data(unboxed);
+      }
+      return true;
+
+    default:
+      PJCORE_CHECK(false);  // field_index
+      return false;
+  }
+}
+
+bool ReadTestMessageWithIntMapField(
+    int field_index, ::pjcore::JsonTokenizer* tokenizer,
+    TestMessageWithIntMap* message, ::pjcore::Error* error,
+    ::google::protobuf::RepeatedPtrField<
+        ::pjcore::JsonValue::Property>*
+        unknown_object_properties) {
+  switch (field_index) {
+    case 0:
+      if (tokenizer->token() == ::pjcore::JsonTokenizer::TOKEN_NULL) {
+        message->clear_entries();
+        return true;
+      }
+      if (tokenizer->token() == ::pjcore::JsonTokenizer::TOKEN_BEGIN_ARRAY) {
+        for (;;) {
+          PJCORE_REQUIRE_SILENT(tokenizer->Next(error), "Failed to read value");
+          if (tokenizer->token() == ::pjcore::JsonTokenizer::TOKEN_END_ARRAY) {
+            return true;
+          }
+          PJCORE_REQUIRE(
+              ::pjcore::ReadJson(tokenizer, message->add_entries(), error,
+                  unknown_object_properties),
+              "Failed to unbox message");
+        }
+      }
+      if (tokenizer->token() == ::pjcore::JsonTokenizer::TOKEN_BEGIN_OBJECT) {
+        ::google::protobuf::RepeatedPtrField< ::pjcore::TestMessageWithIntMap_Entry> entries;
+        std::vector<std::string> names;
+        std::set<std::string> seen_names;
+        for (;;) {
+          PJCORE_REQUIRE_SILENT(tokenizer->Next(error), "Failed to read property");
+          if (tokenizer->token() == ::pjcore::JsonTokenizer::TOKEN_END_OBJECT) {
+            break;
+          }
+          names.push_back(std::string());
+          names.back().swap(*tokenizer->mutable_string_value());
+          PJCORE_REQUIRE_SILENT(tokenizer->Next(error), "Failed to read value");
+          if (!tokenizer->config().properties_as_is() &&
+              !seen_names.insert(names.back()).second) {
+            names.pop_back();
+            PJCORE_REQUIRE_SILENT(tokenizer->SkipValue(error), "Failed to skip value");
+            continue;
+          }
+          PJCORE_REQUIRE_SILENT(
+              ::pjcore::ReadJson(tokenizer, entries.Add(), error, NULL),
+              "Failed to parse message JSON");
+        }
+        std::vector<size_t> order;
+        ::pjcore::OrderJsonNames(tokenizer->config(), names, &order);
+        for (std::vector<size_t>::const_iterator it = order.begin();
+             it != order.end(); ++it) {
+          ::pjcore::TestMessageWithIntMap_Entry* entry = message->add_entries();
+          entry->Swap(entries.Mutable(static_cast<int>(*it)));
+          ::pjcore::JsonValue name_value = ::pjcore::MakeJsonValue(names[*it]);
+          {
+            int32_t unboxed;
+            PJCORE_REQUIRE_SILENT(
+                ::pjcore::UnboxJsonValue(name_value, &unboxed, error),
+                "Failed to unbox int32_t");
+            entry->set_name(unboxed);
+          }
+        }
+        return true;
+      }
+      PJCORE_FAIL(
+          "Array expected for repeated field, or object if repeated message "
+          "has field name");
+
+    default:
+      PJCORE_CHECK(false);  // field_index
+      return false;
+  }
+}
+
+bool ReadTestMessageWithIntMap_EntryField(
+    int field_index, ::pjcore::JsonTokenizer* tokenizer,
+    TestMessageWithIntMap_Entry* message, ::pjcore::Error* error,
+    ::google::protobuf::RepeatedPtrField<
+        ::pjcore::JsonValue::Property>*
+        unknown_object_properties) {
+  switch (field_index) {
+    case 0:
+      if (tokenizer->token() == ::pjcore::JsonTokenizer::TOKEN_NULL) {
+        message->clear_name();
+        return true;
+      }
+      {
+        int32_t unboxed;
+        PJCORE_REQUIRE_SILENT(
+            ::pjcore::UnboxJsonValue(*tokenizer, &unboxed, error),
+            "Failed to unbox int32_t");
+        message->set_name(unboxed);
+      }
+      return true;
+
+    case 1:
+      if (tokenizer->token() == ::pjcore::JsonTokenizer::TOKEN_NULL) {
+        message->clear_data();
+        return true;
+      }
+      PJCORE_REQUIRE_SILENT(
+          ::pjcore::UnboxJsonString(tokenizer, message->mutable_data(), error),
+          "Failed to unbox string");
+      return true;
+
+    default:
+      PJCORE_CHECK(false);  // field_index
+      return false;
+  }
+}
+
+}  // unnamed namespace
+
+void WriteJson(const TestMessage& message,
+               ::pjcore::JsonWriter* writer,
+               const ::pjcore::JsonFieldMask* mask) {
+  writer->BeginObject();
+  const ::pjcore::JsonFieldMask* field_mask;
+  if (message.has_optional_int32() &&
+      ::pjcore::SelectJsonField(mask, "optional_int32", &field_mask)) {
+    writer->Key("optional_int32");
+    writer->Value(static_cast<int32_t>(message.optional_int32()));
+  }
+  if (message.has_optional_int64() &&
+      ::pjcore::SelectJsonField(mask, "optional_int64", &field_mask)) {
+    writer->Key("optional_int64");
+    writer->Value(static_cast<int64_t>(message.optional_int64()));
+  }
+  if (message.has_optional_uint32() &&
+      ::pjcore::SelectJsonField(mask, "optional_uint32", &field_mask)) {
+    writer->Key("optional_uint32");
+    writer->Value(static_cast<uint32_t>(message.optional_uint32()));
+  }
+  if (message.has_optional_uint64() &&
+      ::pjcore::SelectJsonField(mask, "optional_uint64", &field_mask)) {
+    writer->Key("optional_uint64");
+    writer->Value(static_cast<uint64_t>(message.optional_uint64()));
+  }
+  if (message.has_optional_double() &&
+      ::pjcore::SelectJsonField(mask, "optional_double", &field_mask)) {
+    writer->Key("optional_double");
+    writer->Value(message.optional_double());
+  }
+  if (message.has_optional_float() &&
+      ::pjcore::SelectJsonField(mask, "optional_float", &field_mask)) {
+    writer->Key("optional_float");
+    writer->Value(message.optional_float());
+  }
+  if (message.has_optional_bool() &&
+      ::pjcore::SelectJsonField(mask, "optional_bool", &field_mask)) {
+    writer->Key("optional_bool");
+    writer->Value(message.optional_bool());
+  }
+  if (message.has_optional_enum() &&
+      ::pjcore::SelectJsonField(mask, "optional_enum", &field_mask)) {
+    writer->Key("optional_enum");
+    writer->Value(
+        ::pjcore::StringPiece(::pjcore::TestMessage_TestEnum_Name(message.optional_enum())));
+  }
+  if (message.has_optional_string() &&
+      ::pjcore::SelectJsonField(mask, "optional_string", &field_mask)) {
+    writer->Key("optional_string");
+    writer->Value(::pjcore::StringPiece(message.optional_string()));
+  }
+  if (message.has_optional_bytes() &&
+      ::pjcore::SelectJsonField(mask, "optional_bytes", &field_mask)) {
+    writer->Key("optional_bytes");
+    ::pjcore::WriteJsonBytes(message.optional_bytes(), writer);
+  }
+  if (message.has_optional_message() &&
+      ::pjcore::SelectJsonField(mask, "optional_message", &field_mask)) {
+    writer->Key("optional_message");
+    ::pjcore::WriteJson(message.optional_message(), writer, field_mask);
+  }
+  if (message.repeated_int32_size() &&
+      ::pjcore::SelectJsonField(mask, "repeated_int32", &field_mask)) {
+    writer->Key("repeated_int32");
+    writer->BeginArray();
+    for (int index = 0; index < message.repeated_int32_size(); ++index) {
+      writer->Value(static_cast<int32_t>(message.repeated_int32(index)));
+    }
+    writer->EndArray();
+  }
+  if (message.repeated_int64_size() &&
+      ::pjcore::SelectJsonField(mask, "repeated_int64", &field_mask)) {
+    writer->Key("repeated_int64");
+    writer->BeginArray();
+    for (int index = 0; index < message.repeated_int64_size(); ++index) {
+      writer->Value(static_cast<int64_t>(message.repeated_int64(index)));
+    }
+    writer->EndArray();
+  }
+  if (message.repeated_uint32_size() &&
+      ::pjcore::SelectJsonField(mask, "repeated_uint32", &field_mask)) {
+    writer->Key("repeated_uint32");
+    writer->BeginArray();
+    for (int index = 0; index < message.repeated_uint32_size(); ++index) {
+      writer->Value(static_cast<uint32_t>(message.repeated_uint32(index)));
+    }
+    writer->EndArray();
+  }
+  if (message.repeated_uint64_size() &&
+      ::pjcore::SelectJsonField(mask, "repeated_uint64", &field_mask)) {
+    writer->Key("repeated_uint64");
+    writer->BeginArray();
+    for (int index = 0; index < message.repeated_uint64_size(); ++index) {
+      writer->Value(static_cast<uint64_t>(message.repeated_uint64(index)));
+    }
+    writer->EndArray();
+  }
+  if (message.repeated_double_size() &&
+      ::pjcore::SelectJsonField(mask, "repeated_double", &field_mask)) {
+    writer->Key("repeated_double");
+    writer->BeginArray();
+    for (int index = 0; index < message.repeated_double_size(); ++index) {
+      writer->Value(message.repeated_double(index));
+    }
+    writer->EndArray();
+  }
+  if (message.repeated_float_size() &&
+      ::pjcore::SelectJsonField(mask, "repeated_float", &field_mask)) {
+    writer->Key("repeated_float");
+    writer->BeginArray();
+    for (int index = 0; index < message.repeated_float_size(); ++index) {
+      writer->Value(message.repeated_float(index));
+    }
+    writer->EndArray();
+  }
+  if (message.repeated_bool_size() &&
+      ::pjcore::SelectJsonField(mask, "repeated_bool", &field_mask)) {
+    writer->Key("repeated_bool");
+    writer->BeginArray();
+    for (int index = 0; index < message.repeated_bool_size(); ++index) {
+      writer->Value(message.repeated_bool(index));
+    }
+    writer->EndArray();
+  }
+  if (message.repeated_enum_size() &&
+      ::pjcore::SelectJsonField(mask, "repeated_enum", &field_mask)) {
+    writer->Key("repeated_enum");
+    writer->BeginArray();
+    for (int index = 0; index < message.repeated_enum_size(); ++index) {
+      writer->Value(
+          ::pjcore::StringPiece(::pjcore::TestMessage_TestEnum_Name(message.repeated_enum(index))));
+    }
+    writer->EndArray();
+  }
+  if (message.repeated_string_size() &&
+      ::pjcore::SelectJsonField(mask, "repeated_string", &field_mask)) {
+    writer->Key("repeated_string");
+    writer->BeginArray();
+    for (int index = 0; index < message.repeated_string_size(); ++index) {
+      writer->Value(::pjcore::StringPiece(message.repeated_string(index)));
+    }
+    writer->EndArray();
+  }
+  if (message.repeated_bytes_size() &&
+      ::pjcore::SelectJsonField(mask, "repeated_bytes", &field_mask)) {
+    writer->Key("repeated_bytes");
+    writer->BeginArray();
+    for (int index = 0; index < message.repeated_bytes_size(); ++index) {
+      ::pjcore::WriteJsonBytes(message.repeated_bytes(index), writer);
+    }
+    writer->EndArray();
+  }
+  if (message.repeated_message_size() &&
+      ::pjcore::SelectJsonField(mask, "repeated_message", &field_mask)) {
+    writer->Key("repeated_message");
+    writer->BeginArray();
+    for (int index = 0; index < message.repeated_message_size(); ++index) {
+      ::pjcore::WriteJson(message.repeated_message(index), writer, field_mask);
+    }
+    writer->EndArray();
+  }
+  writer->EndObject();
+}
+
+bool ReadJson(::pjcore::JsonTokenizer* tokenizer,
+              TestMessage* message, ::pjcore::Error* error,
+              ::google::protobuf::RepeatedPtrField<
+                  ::pjcore::JsonValue::Property>*
+                  unknown_object_properties) {
+  PJCORE_CHECK(tokenizer);
+  PJCORE_CHECK(message);
+  message->Clear();
+  PJCORE_CHECK(error);
+  error->Clear();
+
+  PJCORE_REQUIRE(
+      tokenizer->token() == ::pjcore::JsonTokenizer::TOKEN_BEGIN_OBJECT,
+      std::string("Value is not an object: ") +
+          ::pjcore::JsonValue::Type_Name(tokenizer->type()));
+
+  ::google::protobuf::RepeatedPtrField< ::pjcore::JsonValue::Property>
+      unknown;
+  bool seen[22] = {false};
+  std::string name;
+
+  for (;;) {
+    PJCORE_REQUIRE_SILENT(tokenizer->Next(error), "Failed to read property");
+    if (tokenizer->token() == ::pjcore::JsonTokenizer::TOKEN_END_OBJECT) {
+      break;
+    }
+    name.swap(*tokenizer->mutable_string_value());
+    PJCORE_REQUIRE_SILENT(tokenizer->Next(error), "Failed to read value");
+
+    int field_index = -1;
+    switch (name.size()) {
+      case 13:
+        if (name == "optional_bool") {
+          field_index = 6;
+        } else if (name == "optional_enum") {
+          field_index = 7;
+        } else if (name == "repeated_bool") {
+          field_index = 17;
+        } else if (name == "repeated_enum") {
+          field_index = 18;
+        }
+        break;
+      case 14:
+        if (name == "optional_int32") {
+          field_index = 0;
+        } else if (name == "optional_int64") {
+          field_index = 1;
+        } else if (name == "optional_float") {
+          field_index = 5;
+        } else if (name == "optional_bytes") {
+          field_index = 9;
+        } else if (name == "repeated_int32") {
+          field_index = 11;
+        } else if (name == "repeated_int64") {
+          field_index = 12;
+        } else if (name == "repeated_float") {
+          field_index = 16;
+        } else if (name == "repeated_bytes") {
+          field_index = 20;
+        }
+        break;
+      case 15:
+        if (name == "optional_uint32") {
+          field_index = 2;
+        } else if (name == "optional_uint64") {
+          field_index = 3;
+        } else if (name == "optional_double") {
+          field_index = 4;
+        } else if (name == "optional_string") {
+          field_index = 8;
+        } else if (name == "repeated_uint32") {
+          field_index = 13;
+        } else if (name == "repeated_uint64") {
+          field_index = 14;
+        } else if (name == "repeated_double") {
+          field_index = 15;
+        } else if (name == "repeated_string") {
+          field_index = 19;
+        }
+        break;
+      case 16:
+        if (name == "optional_message") {
+          field_index = 10;
+        } else if (name == "repeated_message") {
+          field_index = 21;
+        }
+        break;
+    }
+
+    if (field_index < 0) {
+      if (unknown_object_properties) {
+        PJCORE_REQUIRE_SILENT(
+            ::pjcore::ReadJsonProperty(tokenizer, &name, &unknown, error),
+            "Failed to read value");
+      } else {
+        PJCORE_REQUIRE_SILENT(tokenizer->SkipValue(error),
+                              "Failed to skip value");
+      }
+      continue;
+    }
+
+    if (!tokenizer->config().properties_as_is()) {
+      if (seen[field_index]) {
+        PJCORE_REQUIRE_SILENT(tokenizer->SkipValue(error),
+                              "Failed to skip value");
+        continue;
+      }
+      seen[field_index] = true;
+    }
+
+    PJCORE_REQUIRE_SILENT(
+        ReadTestMessageField(field_index, tokenizer, message, error,
+            unknown_object_properties),
+        "Failed to parse field JSON");
+  }
+
+  if (unknown_object_properties) {
+    ::pjcore::AppendUnknownJsonProperties(tokenizer->config(), &unknown,
+                                          unknown_object_properties);
+  }
+  return true;
+}
+
+void WriteJson(const TestMessageWithObjectProperties& message,
+               ::pjcore::JsonWriter* writer,
+               const ::pjcore::JsonFieldMask* mask) {
+  writer->BeginObject();
+  const ::pjcore::JsonFieldMask* field_mask;
+  for (int index = 0; index < message.object_properties_size(); ++index) {
+    if (::pjcore::SelectJsonField(
+            mask, message.object_properties(index).name(), &field_mask)) {
+      writer->Key(message.object_properties(index).name());
+      writer->Value(message.object_properties(index).value());
+    }
+  }
+  writer->EndObject();
+}
+
+bool ReadJson(::pjcore::JsonTokenizer* tokenizer,
+              TestMessageWithObjectProperties* message, ::pjcore::Error* error,
+              ::google::protobuf::RepeatedPtrField<
+                  ::pjcore::JsonValue::Property>*
+                  unknown_object_properties) {
+  PJCORE_CHECK(tokenizer);
+  PJCORE_CHECK(message);
+  message->Clear();
+  PJCORE_CHECK(error);
+  error->Clear();
+
+  PJCORE_REQUIRE(
+      tokenizer->token() == ::pjcore::JsonTokenizer::TOKEN_BEGIN_OBJECT,
+      std::string("Value is not an object: ") +
+          ::pjcore::JsonValue::Type_Name(tokenizer->type()));
+
+  bool seen[1] = {false};
+  std::string name;
+
+  for (;;) {
+    PJCORE_REQUIRE_SILENT(tokenizer->Next(error), "Failed to read property");
+    if (tokenizer->token() == ::pjcore::JsonTokenizer::TOKEN_END_OBJECT) {
+      break;
+    }
+    name.swap(*tokenizer->mutable_string_value());
+    PJCORE_REQUIRE_SILENT(tokenizer->Next(error), "Failed to read value");
+
+    int field_index = -1;
+    switch (name.size()) {
+      case 17:
+        if (name == "object_properties") {
+          field_index = 0;
+        }
+        break;
+    }
+
+    if (field_index < 0) {
+      PJCORE_REQUIRE_SILENT(
+          ::pjcore::ReadJsonProperty(tokenizer, &name, message->mutable_object_properties(), error),
+          "Failed to read value");
+      continue;
+    }
+
+    if (!tokenizer->config().properties_as_is()) {
+      if (seen[field_index]) {
+        PJCORE_REQUIRE_SILENT(tokenizer->SkipValue(error),
+                              "Failed to skip value");
+        continue;
+      }
+      seen[field_index] = true;
+    }
+
+    PJCORE_REQUIRE_SILENT(
+        ReadTestMessageWithObjectPropertiesField(field_index, tokenizer, message, error,
+            unknown_object_properties),
+        "Failed to parse field JSON");
+  }
+
+  ::pjcore::SortJsonProperties(tokenizer->config(), message->mutable_object_properties());
+  return true;
+}
+
+void WriteJson(const TestMessageWithStringMap& message,
+               ::pjcore::JsonWriter* writer,
+               const ::pjcore::JsonFieldMask* mask) {
+  writer->BeginObject();
+  const ::pjcore::JsonFieldMask* field_mask;
+  if (message.entries_size() &&
+      ::pjcore::SelectJsonField(mask, "entries", &field_mask)) {
+    writer->Key("entries");
+    writer->BeginArray();
+    for (int index = 0; index < message.entries_size(); ++index) {
+      ::pjcore::WriteJson(message.entries(index), writer, field_mask);
+    }
+    writer->EndArray();
+  }
+  writer->EndObject();
+}
+
+bool ReadJson(::pjcore::JsonTokenizer* tokenizer,
+              TestMessageWithStringMap* message, ::pjcore::Error* error,
+              ::google::protobuf::RepeatedPtrField<
+                  ::pjcore::JsonValue::Property>*
+                  unknown_object_properties) {
+  PJCORE_CHECK(tokenizer);
+  PJCORE_CHECK(message);
+  message->Clear();
+  PJCORE_CHECK(error);
+  error->Clear();
+
+  PJCORE_REQUIRE(
+      tokenizer->token() == ::pjcore::JsonTokenizer::TOKEN_BEGIN_OBJECT,
+      std::string("Value is not an object: ") +
+          ::pjcore::JsonValue::Type_Name(tokenizer->type()));
+
+  ::google::protobuf::RepeatedPtrField< ::pjcore::JsonValue::Property>
+      unknown;
+  bool seen[1] = {false};
+  std::string name;
+
+  for (;;) {
+    PJCORE_REQUIRE_SILENT(tokenizer->Next(error), "Failed to read property");
+    if (tokenizer->token() == ::pjcore::JsonTokenizer::TOKEN_END_OBJECT) {
+      break;
+    }
+    name.swap(*tokenizer->mutable_string_value());
+    PJCORE_REQUIRE_SILENT(tokenizer->Next(error), "Failed to read value");
+
+    int field_index = -1;
+    switch (name.size()) {
+      case 7:
+        if (name == "entries") {
+          field_index = 0;
+        }
+        break;
+    }
+
+    if (field_index < 0) {
+      if (unknown_object_properties) {
+        PJCORE_REQUIRE_SILENT(
+            ::pjcore::ReadJsonProperty(tokenizer, &name, &unknown, error),
+            "Failed to read value");
+      } else {
+        PJCORE_REQUIRE_SILENT(tokenizer->SkipValue(error),
+                              "Failed to skip value");
+      }
+      continue;
+    }
+
+    if (!tokenizer->config().properties_as_is()) {
+      if (seen[field_index]) {
+        PJCORE_REQUIRE_SILENT(tokenizer->SkipValue(error),
+                              "Failed to skip value");
+        continue;
+      }
+      seen[field_index] = true;
+    }
+
+    PJCORE_REQUIRE_SILENT(
+        ReadTestMessageWithStringMapField(field_index, tokenizer, message, error,
+            unknown_object_properties),
+        "Failed to parse field JSON");
+  }
+
+  if (unknown_object_properties) {
+    ::pjcore::AppendUnknownJsonProperties(tokenizer->config(), &unknown,
+                                          unknown_object_properties);
+  }
+  return true;
+}
+
+void WriteJson(const TestMessageWithStringMap_Entry& message,
+               ::pjcore::JsonWriter* writer,
+               const ::pjcore::JsonFieldMask* mask) {
+  writer->BeginObject();
+  const ::pjcore::JsonFieldMask* field_mask;
+  if (message.has_name() &&
+      ::pjcore::SelectJsonField(mask, "name", &field_mask)) {
+    writer->Key("name");
+    writer->Value(::pjcore::StringPiece(message.name()));
+  }
+  if (message.has_data() &&
+      ::pjcore::SelectJsonField(mask, "data", &field_mask)) {
+    writer->Key("data");
+    writer->Value(static_cast<int32_t>(message.data()));
+  }
+  writer->EndObject();
+}
+
+bool ReadJson(::pjcore::JsonTokenizer* tokenizer,
+              TestMessageWithStringMap_Entry* message, ::pjcore::Error* error,
+              ::google::protobuf::RepeatedPtrField<
+                  ::pjcore::JsonValue::Property>*
+                  unknown_object_properties) {
+  PJCORE_CHECK(tokenizer);
+  PJCORE_CHECK(message);
+  message->Clear();
+  PJCORE_CHECK(error);
+  error->Clear();
+
+  PJCORE_REQUIRE(
+      tokenizer->token() == ::pjcore::JsonTokenizer::TOKEN_BEGIN_OBJECT,
+      std::string("Value is not an object: ") +
+          ::pjcore::JsonValue::Type_Name(tokenizer->type()));
+
+  ::google::protobuf::RepeatedPtrField< ::pjcore::JsonValue::Property>
+      unknown;
+  bool seen[2] = {false};
+  std::string name;
+
+  for (;;) {
+    PJCORE_REQUIRE_SILENT(tokenizer->Next(error), "Failed to read property");
+    if (tokenizer->token() == ::pjcore::JsonTokenizer::TOKEN_END_OBJECT) {
+      break;
+    }
+    name.swap(*tokenizer->mutable_string_value());
+    PJCORE_REQUIRE_SILENT(tokenizer->Next(error), "Failed to read value");
+
+    int field_index = -1;
+    switch (name.size()) {
+      case 4:
+        if (name == "name") {
+          field_index = 0;
+        } else if (name == "data") {
+          field_index = 1;
+        }
+        break;
+    }
+
+    if (field_index < 0) {
+      if (unknown_object_properties) {
+        PJCORE_REQUIRE_SILENT(
+            ::pjcore::ReadJsonProperty(tokenizer, &name, &unknown, error),
+            "Failed to read value");
+      } else {
+        PJCORE_REQUIRE_SILENT(tokenizer->SkipValue(error),
+                              "Failed to skip value");
+      }
+      continue;
+    }
+
+    if (!tokenizer->config().properties_as_is()) {
+      if (seen[field_index]) {
+        PJCORE_REQUIRE_SILENT(tokenizer->SkipValue(error),
+                              "Failed to skip value");
+        continue;
+      }
+      seen[field_index] = true;
+    }
+
+    PJCORE_REQUIRE_SILENT(
+        ReadTestMessageWithStringMap_EntryField(field_index, tokenizer, message, error,
+            unknown_object_properties),
+        "Failed to parse field JSON");
+  }
+
+  if (unknown_object_properties) {
+    ::pjcore::AppendUnknownJsonProperties(tokenizer->config(), &unknown,
+                                          unknown_object_properties);
+  }
+  return true;
+}
+
+void WriteJson(const TestMessageWithIntMap& message,
+               ::pjcore::JsonWriter* writer,
+               const ::pjcore::JsonFieldMask* mask) {
+  writer->BeginObject();
+  const ::pjcore::JsonFieldMask* field_mask;
+  if (message.entries_size() &&
+      ::pjcore::SelectJsonField(mask, "entries", &field_mask)) {
+    writer->Key("entries");
+    writer->BeginArray();
+    for (int index = 0; index < message.entries_size(); ++index) {
+      ::pjcore::WriteJson(message.entries(index), writer, field_mask);
+    }
+    writer->EndArray();
+  }
+  writer->EndObject();
+}
+
+bool ReadJson(::pjcore::JsonTokenizer* tokenizer,
+              TestMessageWithIntMap* message, ::pjcore::Error* error,
+              ::google::protobuf::RepeatedPtrField<
+                  ::pjcore::JsonValue::Property>*
+                  unknown_object_properties) {
+  PJCORE_CHECK(tokenizer);
+  PJCORE_CHECK(message);
+  message->Clear();
+  PJCORE_CHECK(error);
+  error->Clear();
+
+  PJCORE_REQUIRE(
+      tokenizer->token() == ::pjcore::JsonTokenizer::TOKEN_BEGIN_OBJECT,
+      std::string("Value is not an object: ") +
+          ::pjcore::JsonValue::Type_Name(tokenizer->type()));
+
+  ::google::protobuf::RepeatedPtrField< ::pjcore::JsonValue::Property>
+      unknown;
+  bool seen[1] = {false};
+  std::string name;
+
+  for (;;) {
+    PJCORE_REQUIRE_SILENT(tokenizer->Next(error), "Failed to read property");
+    if (tokenizer->token() == ::pjcore::JsonTokenizer::TOKEN_END_OBJECT) {
+      break;
+    }
+    name.swap(*tokenizer->mutable_string_value());
+    PJCORE_REQUIRE_SILENT(tokenizer->Next(error), "Failed to read value");
+
+    int field_index = -1;
+    switch (name.size()) {
+      case 7:
+        if (name == "entries") {
+          field_index = 0;
+        }
+        break;
+    }
+
+    if (field_index < 0) {
+      if (unknown_object_properties) {
+        PJCORE_REQUIRE_SILENT(
+            ::pjcore::ReadJsonProperty(tokenizer, &name, &unknown, error),
+            "Failed to read value");
+      } else {
+        PJCORE_REQUIRE_SILENT(tokenizer->SkipValue(error),
+                              "Failed to skip value");
+      }
+      continue;
+    }
+
+    if (!tokenizer->config().properties_as_is()) {
+      if (seen[field_index]) {
+        PJCORE_REQUIRE_SILENT(tokenizer->SkipValue(error),
+                              "Failed to skip value");
+        continue;
+      }
+      seen[field_index] = true;
+    }
+
+    PJCORE_REQUIRE_SILENT(
+        ReadTestMessageWithIntMapField(field_index, tokenizer, message, error,
+            unknown_object_properties),
+        "Failed to parse field JSON");
+  }
+
+  if (unknown_object_properties) {
+    ::pjcore::AppendUnknownJsonProperties(tokenizer->config(), &unknown,
+                                          unknown_object_properties);
+  }
+  return true;
+}
+
+void WriteJson(const TestMessageWithIntMap_Entry& message,
+               ::pjcore::JsonWriter* writer,
+               const ::pjcore::JsonFieldMask* mask) {
+  writer->BeginObject();
+  const ::pjcore::JsonFieldMask* field_mask;
+  if (message.has_name() &&
+      ::pjcore::SelectJsonField(mask, "name", &field_mask)) {
+    writer->Key("name");
+    writer->Value(static_cast<int32_t>(message.name()));
+  }
+  if (message.has_data() &&
+      ::pjcore::SelectJsonField(mask, "data", &field_mask)) {
+    writer->Key("data");
+    writer->Value(::pjcore::StringPiece(message.data()));
+  }
+  writer->EndObject();
+}
+
+bool ReadJson(::pjcore::JsonTokenizer* tokenizer,
+              TestMessageWithIntMap_Entry* message, ::pjcore::Error* error,
+              ::google::protobuf::RepeatedPtrField<
+                  ::pjcore::JsonValue::Property>*
+                  unknown_object_properties) {
+  PJCORE_CHECK(tokenizer);
+  PJCORE_CHECK(message);
+  message->Clear();
+  PJCORE_CHECK(error);
+  error->Clear();
+
+  PJCORE_REQUIRE(
+      tokenizer->token() == ::pjcore::JsonTokenizer::TOKEN_BEGIN_OBJECT,
+      std::string("Value is not an object: ") +
+          ::pjcore::JsonValue::Type_Name(tokenizer->type()));
+
+  ::google::protobuf::RepeatedPtrField< ::pjcore::JsonValue::Property>
+      unknown;
+  bool seen[2] = {false};
+  std::string name;
+
+  for (;;) {
+    PJCORE_REQUIRE_SILENT(tokenizer->Next(error), "Failed to read property");
+    if (tokenizer->token() == ::pjcore::JsonTokenizer::TOKEN_END_OBJECT) {
+      break;
+    }
+    name.swap(*tokenizer->mutable_string_value());
+    PJCORE_REQUIRE_SILENT(tokenizer->Next(error), "Failed to read value");
+
+    int field_index = -1;
+    switch (name.size()) {
+      case 4:
+        if (name == "name") {
+          field_index = 0;
+        } else if (name == "data") {
+          field_index = 1;
+        }
+        break;
+    }
+
+    if (field_index < 0) {
+      if (unknown_object_properties) {
+        PJCORE_REQUIRE_SILENT(
+            ::pjcore::ReadJsonProperty(tokenizer, &name, &unknown, error),
+            "Failed to read value");
+      } else {
+        PJCORE_REQUIRE_SILENT(tokenizer->SkipValue(error),
+                              "Failed to skip value");
+      }
+      continue;
+    }
+
+    if (!tokenizer->config().properties_as_is()) {
+      if (seen[field_index]) {
+        PJCORE_REQUIRE_SILENT(tokenizer->SkipValue(error),
+                              "Failed to skip value");
+        continue;
+      }
+      seen[field_index] = true;
+    }
+
+    PJCORE_REQUIRE_SILENT(
+        ReadTestMessageWithIntMap_EntryField(field_index, tokenizer, message, error,
+            unknown_object_properties),
+        "Failed to parse field JSON");
+  }
+
+  if (unknown_object_properties) {
+    ::pjcore::AppendUnknownJsonProperties(tokenizer->config(), &unknown,
+                                          unknown_object_properties);
+  }
+  return true;
+}
+
+}  // namespace pjcore
+
@@ -0,0 +1,74 @@
+// Generated by protoc-gen-pjcore.  DO NOT EDIT!
+// source: pjcore_test/test_message.proto
+
+#ifndef PJCORE_TEST_TEST_MESSAGE_PJCORE_H_
+#define PJCORE_TEST_TEST_MESSAGE_PJCORE_H_
+
+#include "pjcore/json_codec.h"
+#include "pjcore_test/test_message.pb.h"
+
+namespace pjcore {
+
+void WriteJson(const TestMessage& message,
+               ::pjcore::JsonWriter* writer,
+               const ::pjcore::JsonFieldMask* mask = NULL);
+
+bool ReadJson(::pjcore::JsonTokenizer* tokenizer,
+              TestMessage* message, ::pjcore::Error* error,
+              ::google::protobuf::RepeatedPtrField<
+                  ::pjcore::JsonValue::Property>*
+                  unknown_object_properties = NULL);
+
+void WriteJson(const TestMessageWithObjectProperties& message,
+               ::pjcore::JsonWriter* writer,
+               const ::pjcore::JsonFieldMask* mask = NULL);
+
+bool ReadJson(::pjcore::JsonTokenizer* tokenizer,
+              TestMessageWithObjectProperties* message, ::pjcore::Error* error,
+              ::google::protobuf::RepeatedPtrField<
+                  ::pjcore::JsonValue::Property>*
+                  unknown_object_properties = NULL);
+
+void WriteJson(const TestMessageWithStringMap& message,
+               ::pjcore::JsonWriter* writer,
+               const ::pjcore::JsonFieldMask* mask = NULL);
+
+bool ReadJson(::pjcore::JsonTokenizer* tokenizer,
+              TestMessageWithStringMap* message, ::pjcore::Error* error,
+              ::google::protobuf::RepeatedPtrField<
+                  ::pjcore::JsonValue::Property>*
+                  unknown_object_properties = NULL);
+
+void WriteJson(const TestMessageWithStringMap_Entry& message,
+               ::pjcore::JsonWriter* writer,
+               const ::pjcore::JsonFieldMask* mask = NULL);
+
+bool ReadJson(::pjcore::JsonTokenizer* tokenizer,
+              TestMessageWithStringMap_Entry* message, ::pjcore::Error* error,
+              ::google::protobuf::RepeatedPtrField<
+                  ::pjcore::JsonValue::Property>*
+                  unknown_object_properties = NULL);
+
+void WriteJson(const TestMessageWithIntMap& message,
+               ::pjcore::JsonWriter* writer,
+               const ::pjcore::JsonFieldMask* mask = NULL);
+
+bool ReadJson(::pjcore::JsonTokenizer* tokenizer,
+              TestMessageWithIntMap* message, ::pjcore::Error* error,
+              ::google::protobuf::RepeatedPtrField<
+                  ::pjcore::JsonValue::Property>*
+                  unknown_object_properties = NULL);
+
+void WriteJson(const TestMessageWithIntMap_Entry& message,
+               ::pjcore::JsonWriter* writer,
+               const ::pjcore::JsonFieldMask* mask = NULL);
+
+bool ReadJson(::pjcore::JsonTokenizer* tokenizer,
+              TestMessageWithIntMap_Entry* message, ::pjcore::Error* error,
+              ::google::protobuf::RepeatedPtrField<
+                  ::pjcore::JsonValue::Property>*
+                  unknown_object_properties = NULL);
+
+}  // namespace pjcore
+
+#endif  // PJCORE_TEST_TEST_MESSAGE_PJCORE_H_
@@ -74,6 +74,37 @@ template <typename Unboxed>
            << " != " << WriteJson(expected_unknown_object_properties);
   }
 
+  JsonValue consumed_value(value);
+  Unboxed consumed_unboxed;
+  JsonValue consumed_unknown_object_properties = MakeJsonObject();
+  if (!UnboxJsonValue(
+          &consumed_value, &consumed_unboxed, &error,
+          consumed_unknown_object_properties.mutable_object_properties())) {
+    return ::testing::AssertionFailure() << "Failed to consume: "
+                                         << ErrorToString(error);
+  }
+
+  std::string consumed_str;
+  if (!consumed_unboxed.SerializeToString(&consumed_str)) {
+    return ::testing::AssertionFailure()
+           << "Failed to serialize consumed unboxed value: "
+           << consumed_unboxed.DebugString();
+  }
+
+  if (consumed_str != expected_str) {
+    return ::testing::AssertionFailure()
+           << "Consumed " << consumed_unboxed.DebugString()
+           << " != " << expected_unboxed.DebugString();
+  }
+
+  if (!AreJsonValuesEqual(consumed_unknown_object_properties,
+                          expected_unknown_object_properties, &diff_path)) {
+    return ::testing::AssertionFailure()
+           << "Unexpected consumed unknown properties at " << diff_path << ": "
+           << WriteJson(consumed_unknown_object_properties)
+           << " != " << WriteJson(expected_unknown_object_properties);
+  }
+
   return ::testing::AssertionSuccess();
 }
 
@@ -93,6 +124,15 @@ template <typename Unboxed>
       return ::testing::AssertionFailure()
              << "Unexpected success: " << actual_unboxed.DebugString();
     }
+
+    JsonValue consumed_value(value);
+    Unboxed consumed_unboxed;
+    Error consumed_error;
+    if (UnboxJsonValue(&consumed_value, &consumed_unboxed, &consumed_error,
+                       &unknown_object_properties)) {
+      return ::testing::AssertionFailure() << "Unexpected consumed success: "
+                                           << consumed_unboxed.DebugString();
+    }
   }
 
   const Error* description_error = &error;
@@ -496,6 +536,23 @@ TEST(UnboxJsonValueMessage, RepeatedDouble) {
       test_message));
 }
 
+TEST(UnboxJsonValueMessage, RepeatedDoubleLarge) {
+  TestMessage test_message;
+  for (int index = 0; index < 100000; ++index) {
+    test_message.add_repeated_double(index * 0.25);
+    test_message.add_repeated_int64(-index);
+  }
+
+  EXPECT_TRUE(TestUnboxSuccess(MakeJsonValue(test_message), test_message));
+
+  test_message.clear_repeated_int64();
+  JsonValue value = MakeJsonValue(test_message);
+  value.mutable_object_properties(0)->mutable_value()->mutable_array_elements(
+      50000)->CopyFrom(MakeJsonValue("x"));
+  EXPECT_TRUE(
+      TestUnboxFailure<TestMessage>(value, "Invalid string for double"));
+}
+
 TEST(UnboxJsonValueMessage, RepeatedFloat) {
   TestMessage test_message;
   EXPECT_TRUE(TestUnboxSuccess(MakeJsonObject("repeated_float", JsonNull()),
@@ -640,6 +697,33 @@ TEST(UnboxJsonValueMessage, RepeatedMessage) {
       test_message));
 }
 
+TEST(UnboxJsonValueMessage, PackedArray) {
+  TestMessage test_message;
+  test_message.add_repeated_int32(1);
+  test_message.add_repeated_int32(-2);
+  test_message.add_repeated_double(0.5);
+  test_message.add_repeated_double(3);
+  test_message.add_repeated_enum(TestMessage::TEST_BETA);
+
+  JsonValue repeated_int32 = MakeJsonArray(1, -2);
+  PJCORE_CHECK(PackJsonArray(&repeated_int32));
+  JsonValue repeated_double = MakeJsonArray(0.5, 3.0);
+  PJCORE_CHECK(PackJsonArray(&repeated_double));
+  JsonValue repeated_enum =
+      MakeJsonArray(static_cast<int>(TestMessage::TEST_BETA));
+  PJCORE_CHECK(PackJsonArray(&repeated_enum));
+
+  EXPECT_TRUE(TestUnboxSuccess(
+      MakeJsonObject("repeated_int32", repeated_int32, "repeated_double",
+                     repeated_double, "repeated_enum", repeated_enum),
+      test_message));
+
+  JsonValue overflow = MakeJsonArray(1, 4294967296ll);
+  PJCORE_CHECK(PackJsonArray(&overflow));
+  EXPECT_TRUE(TestUnboxFailure<TestMessage>(
+      MakeJsonObject("repeated_int32", overflow), "int32_t overflow"));
+}
+
 TEST(UnboxJsonValueMessage, JsonValue) {
   EXPECT_TRUE(TestUnboxSuccess<JsonValue>(JsonNull(), JsonNull()));
 
@@ -765,4 +849,46 @@ TEST(UnboxJsonValueMessage, IntMap) {
       test_message));
 }
 
+TEST(UnboxJsonValueMessage, Consume) {
+  JsonValue value = MakeJsonObject(
+      "optional_string", "alpha", "optional_message",
+      MakeJsonObject("repeated_string", MakeJsonArray("beta", "gamma")),
+      "repeated_bytes", MakeJsonArray("ZGVsdGE="), "epsilon", "zeta");
+
+  TestMessage test_message;
+  Error error;
+  google::protobuf::RepeatedPtrField<JsonValue::Property>
+      unknown_object_properties;
+  ASSERT_TRUE(UnboxJsonValue(&value, &test_message, &error,
+                             &unknown_object_properties))
+      << ErrorToString(error);
+
+  EXPECT_EQ("alpha", test_message.optional_string());
+  ASSERT_EQ(2, test_message.optional_message().repeated_string_size());
+  EXPECT_EQ("beta", test_message.optional_message().repeated_string(0));
+  EXPECT_EQ("gamma", test_message.optional_message().repeated_string(1));
+  ASSERT_EQ(1, test_message.repeated_bytes_size());
+  EXPECT_EQ("delta", test_message.repeated_bytes(0));
+
+  ASSERT_EQ(1, unknown_object_properties.size());
+  EXPECT_EQ("epsilon", unknown_object_properties.Get(0).name());
+  EXPECT_TRUE(AreJsonValuesEqual(MakeJsonValue("zeta"),
+                                 unknown_object_properties.Get(0).value()));
+
+  EXPECT_TRUE(AreJsonValuesEqual(JsonNull(), value));
+}
+
+TEST(UnboxJsonValueMessage, ConsumeJsonValue) {
+  JsonValue value = MakeJsonObject("alpha", MakeJsonArray(1, "beta"));
+  JsonValue expected(value);
+
+  JsonValue consumed;
+  Error error;
+  ASSERT_TRUE(UnboxJsonValue(&value, &consumed, &error))
+      << ErrorToString(error);
+
+  EXPECT_TRUE(AreJsonValuesEqual(expected, consumed));
+  EXPECT_TRUE(AreJsonValuesEqual(JsonNull(), value));
+}
+
 }  // namespace pjcore
@@ -74,6 +74,13 @@ template <typename Unboxed>
   return ::testing::AssertionSuccess();
 }
 
+JsonValue MakeRawNumber(StringPiece text) {
+  JsonValue raw_number;
+  raw_number.set_type(JsonValue::TYPE_RAW_NUMBER);
+  raw_number.set_string_value(text.data(), text.size());
+  return raw_number;
+}
+
 }  // unnamed namespace
 
 TEST(UnboxJsonValue, BoolValue) {
@@ -186,6 +193,21 @@ TEST(UnboxJsonValue, DoubleValue) {
   EXPECT_TRUE(TestUnboxFailure<double>(MakeJsonValue("alpha"), ""));
 }
 
+TEST(UnboxJsonValue, RawNumber) {
+  EXPECT_TRUE(TestUnboxSuccess(MakeRawNumber("0"), false));
+  EXPECT_TRUE(TestUnboxSuccess(MakeRawNumber("-12"), -12));
+  EXPECT_TRUE(TestUnboxSuccess(MakeRawNumber("1e2"), int64_t(100)));
+  EXPECT_TRUE(TestUnboxSuccess(MakeRawNumber("18446744073709551615"),
+                               18446744073709551615ull));
+  EXPECT_TRUE(TestUnboxSuccess(MakeRawNumber("2.5"), 2.5));
+  EXPECT_TRUE(TestUnboxSuccess(MakeRawNumber("2.5"), 2.5f));
+
+  EXPECT_TRUE(TestUnboxFailure<int32_t>(MakeRawNumber("2.5"), "precision"));
+  EXPECT_TRUE(TestUnboxFailure<uint64_t>(MakeRawNumber("-1"), "underflow"));
+  EXPECT_TRUE(TestUnboxFailure<double>(MakeRawNumber("alpha"), "raw number"));
+  EXPECT_TRUE(TestUnboxFailure<std::string>(MakeRawNumber("1"), ""));
+}
+
 TEST(UnboxJsonValue, StringValue) {
   EXPECT_TRUE(TestUnboxSuccess(MakeJsonValue("alpha"), std::string("alpha")));
 
@@ -0,0 +1,1046 @@
+// JSON [de]serialization for protobuf + embedded HTTP server and client in C++.
+// Copyright (C) 2014 http://protojson.com/
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+
+#include "protoc_gen_pjcore/json_codec_generator.h"
+
+#include <stdio.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "google/protobuf/descriptor.h"
+#include "google/protobuf/descriptor.pb.h"
+#include "google/protobuf/io/printer.h"
+#include "google/protobuf/io/zero_copy_stream.h"
+
+#include "pjcore/third_party/chromium/scoped_ptr.h"
+
+namespace pjcore {
+
+using google::protobuf::Descriptor;
+using google::protobuf::EnumDescriptor;
+using google::protobuf::FieldDescriptor;
+using google::protobuf::FileDescriptor;
+using google::protobuf::compiler::GeneratorContext;
+using google::protobuf::io::Printer;
+using google::protobuf::io::ZeroCopyOutputStream;
+
+namespace {
+
+typedef std::map<std::string, std::string> Variables;
+
+const char kJsonValueFullName[] = "pjcore.JsonValue";
+
+const char kJsonPropertyFullName[] = "pjcore.JsonValue.Property";
+
+const char kObjectPropertiesName[] = "object_properties";
+
+const char kRepeatedNameName[] = "name";
+
+const char* const kKeywords[] = {
+    "and", "and_eq", "asm", "auto", "bitand", "bitor", "bool", "break",
+    "case", "catch", "char", "class", "compl", "const", "const_cast",
+    "continue", "default", "delete", "do", "double", "dynamic_cast", "else",
+    "enum", "explicit", "export", "extern", "false", "float", "for", "friend",
+    "goto", "if", "inline", "int", "long", "mutable", "namespace", "new",
+    "not", "not_eq", "operator", "or", "or_eq", "private", "protected",
+    "public", "register", "reinterpret_cast", "return", "short", "signed",
+    "sizeof", "static", "static_cast", "struct", "switch", "template", "this",
+    "throw", "true", "try", "typedef", "typeid", "typename", "union",
+    "unsigned", "using", "virtual", "void", "volatile", "wchar_t", "while",
+    "xor", "xor_eq",
+};
+
+std::string WriteInt(int value) {
+  char buffer[16];
+  snprintf(buffer, sizeof(buffer), "%d", value);
+  return buffer;
+}
+
+std::string StripProto(const std::string& filename) {
+  const std::string suffix(".proto");
+  if (filename.size() >= suffix.size() &&
+      filename.compare(filename.size() - suffix.size(), suffix.size(),
+                       suffix) == 0) {
+    return filename.substr(0, filename.size() - suffix.size());
+  }
+  return filename;
+}
+
+std::string HeaderGuard(const std::string& filename) {
+  std::string guard;
+  for (size_t index = 0; index < filename.size(); ++index) {
+    char ch = filename[index];
+    if (ch >= 'a' && ch <= 'z') {
+      guard.push_back(static_cast<char>(ch - 'a' + 'A'));
+    } else if ((ch >= 'A' && ch <= 'Z') || (ch >= '0' && ch <= '9')) {
+      guard.push_back(ch);
+    } else {
+      guard.push_back('_');
+    }
+  }
+  return guard + "_";
+}
+
+std::vector<std::string> SplitPackage(const std::string& package) {
+  std::vector<std::string> parts;
+  size_t begin = 0;
+  while (begin < package.size()) {
+    size_t end = package.find('.', begin);
+    if (end == std::string::npos) {
+      end = package.size();
+    }
+    parts.push_back(package.substr(begin, end - begin));
+    begin = end + 1;
+  }
+  return parts;
+}
+
+std::string QualifiedNamespace(const FileDescriptor& file) {
+  std::string qualified;
+  std::vector<std::string> parts = SplitPackage(file.package());
+  for (size_t index = 0; index < parts.size(); ++index) {
+    qualified += "::" + parts[index];
+  }
+  return qualified;
+}
+
+// Nested types are flattened with underscores, as protoc's C++ generator does.
+std::string ClassName(const std::string& full_name,
+                      const FileDescriptor& file) {
+  std::string name = full_name;
+  if (!file.package().empty()) {
+    name = name.substr(file.package().size() + 1);
+  }
+  for (size_t index = 0; index < name.size(); ++index) {
+    if (name[index] == '.') {
+      name[index] = '_';
+    }
+  }
+  return name;
+}
+
+std::string QualifiedClassName(const Descriptor& descriptor) {
+  return QualifiedNamespace(*descriptor.file()) + "::" +
+         ClassName(descriptor.full_name(), *descriptor.file());
+}
+
+std::string QualifiedEnumName(const EnumDescriptor& descriptor) {
+  return QualifiedNamespace(*descriptor.file()) + "::" +
+         ClassName(descriptor.full_name(), *descriptor.file());
+}
+
+std::string LowerName(const std::string& name) {
+  std::string lower = name;
+  for (size_t index = 0; index < lower.size(); ++index) {
+    if (lower[index] >= 'A' && lower[index] <= 'Z') {
+      lower[index] = static_cast<char>(lower[index] - 'A' + 'a');
+    }
+  }
+  for (size_t index = 0; index < sizeof(kKeywords) / sizeof(kKeywords[0]);
+       ++index) {
+    if (lower == kKeywords[index]) {
+      return lower + "_";
+    }
+  }
+  return lower;
+}
+
+std::string CamelName(const std::string& name) {
+  std::string camel;
+  bool capitalize = true;
+  for (size_t index = 0; index < name.size(); ++index) {
+    char ch = name[index];
+    if (ch >= 'a' && ch <= 'z') {
+      camel.push_back(capitalize ? static_cast<char>(ch - 'a' + 'A') : ch);
+      capitalize = false;
+    } else if (ch >= 'A' && ch <= 'Z') {
+      camel.push_back(ch);
+      capitalize = false;
+    } else if (ch >= '0' && ch <= '9') {
+      camel.push_back(ch);
+      capitalize = true;
+    } else {
+      capitalize = true;
+    }
+  }
+  return camel;
+}
+
+bool IsJsonValue(const Descriptor& descriptor) {
+  return descriptor.full_name() == kJsonValueFullName;
+}
+
+bool IsObjectProperties(const FieldDescriptor& field) {
+  return field.is_repeated() &&
+         field.cpp_type() == FieldDescriptor::CPPTYPE_MESSAGE &&
+         field.message_type()->full_name() == kJsonPropertyFullName &&
+         field.name() == kObjectPropertiesName;
+}
+
+const FieldDescriptor* FindObjectPropertiesField(const Descriptor& descriptor) {
+  const FieldDescriptor* field =
+      descriptor.FindFieldByName(kObjectPropertiesName);
+  return field && IsObjectProperties(*field) ? field : NULL;
+}
+
+// Field set from the property names of the object form of a repeated message
+// field, or NULL if the field has no object form.
+const FieldDescriptor* FindRepeatedNameField(const FieldDescriptor& field) {
+  if (!field.is_repeated() ||
+      field.cpp_type() != FieldDescriptor::CPPTYPE_MESSAGE) {
+    return NULL;
+  }
+  const FieldDescriptor* name_field =
+      field.message_type()->FindFieldByName(kRepeatedNameName);
+  if (!name_field || name_field->is_repeated() ||
+      name_field->cpp_type() == FieldDescriptor::CPPTYPE_MESSAGE) {
+    return NULL;
+  }
+  return name_field;
+}
+
+// Maps have no repeated accessors, so their messages go through reflection.
+bool HasMapField(const Descriptor& descriptor) {
+  for (int index = 0; index < descriptor.field_count(); ++index) {
+    if (descriptor.field(index)->is_map()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void CollectMessages(const Descriptor& descriptor,
+                     std::vector<const Descriptor*>* messages) {
+  if (descriptor.options().map_entry()) {
+    return;
+  }
+  messages->push_back(&descriptor);
+  for (int index = 0; index < descriptor.nested_type_count(); ++index) {
+    CollectMessages(*descriptor.nested_type(index), messages);
+  }
+}
+
+const char* NumberType(const FieldDescriptor& field) {
+  switch (field.cpp_type()) {
+    case FieldDescriptor::CPPTYPE_INT32:
+      return "int32_t";
+
+    case FieldDescriptor::CPPTYPE_INT64:
+      return "int64_t";
+
+    case FieldDescriptor::CPPTYPE_UINT32:
+      return "uint32_t";
+
+    case FieldDescriptor::CPPTYPE_UINT64:
+      return "uint64_t";
+
+    case FieldDescriptor::CPPTYPE_DOUBLE:
+      return "double";
+
+    case FieldDescriptor::CPPTYPE_FLOAT:
+      return "float";
+
+    case FieldDescriptor::CPPTYPE_BOOL:
+      return "bool";
+
+    default:
+      return NULL;
+  }
+}
+
+// Condition under which MakeJsonValue writes the field.
+std::string PresenceCondition(const FieldDescriptor& field) {
+  std::string name = LowerName(field.name());
+
+  if (field.is_repeated()) {
+    return "message." + name + "_size()";
+  }
+
+  if (field.containing_oneof()) {
+    return "message." + LowerName(field.containing_oneof()->name()) +
+           "_case() == " + QualifiedClassName(*field.containing_type()) +
+           "::k" + CamelName(field.name());
+  }
+
+  if (field.file()->syntax() != FileDescriptor::SYNTAX_PROTO3 ||
+      field.cpp_type() == FieldDescriptor::CPPTYPE_MESSAGE) {
+    return "message.has_" + name + "()";
+  }
+
+  switch (field.cpp_type()) {
+    case FieldDescriptor::CPPTYPE_STRING:
+      return "!message." + name + "().empty()";
+
+    case FieldDescriptor::CPPTYPE_BOOL:
+      return "message." + name + "()";
+
+    default:
+      return "message." + name + "() != 0";
+  }
+}
+
+class FileGenerator {
+ public:
+  explicit FileGenerator(const FileDescriptor& file);
+
+  void GenerateHeader(Printer* printer) const;
+
+  void GenerateSource(Printer* printer) const;
+
+ private:
+  void GenerateNamespaceBegin(Printer* printer) const;
+
+  void GenerateNamespaceEnd(Printer* printer) const;
+
+  void GenerateWriteJson(const Descriptor& descriptor, Printer* printer) const;
+
+  void GenerateWriteValue(const FieldDescriptor& field,
+                          const std::string& expression,
+                          Printer* printer) const;
+
+  void GenerateReadField(const Descriptor& descriptor, Printer* printer) const;
+
+  void GenerateReadRepeated(const FieldDescriptor& field,
+                            Printer* printer) const;
+
+  void GenerateReadObjectForm(const FieldDescriptor& field,
+                              const FieldDescriptor& name_field,
+                              Printer* printer) const;
+
+  void GenerateReadValue(const FieldDescriptor& field, bool from_tokenizer,
+                         const std::string& target, bool add,
+                         const std::string& unknown_object_properties,
+                         Printer* printer) const;
+
+  void GenerateReadJson(const Descriptor& descriptor, Printer* printer) const;
+
+  const FileDescriptor& file_;
+
+  std::vector<const Descriptor*> messages_;
+
+  std::string base_name_;
+
+  std::string namespace_;
+
+  DISALLOW_COPY_AND_ASSIGN(FileGenerator);
+};
+
+FileGenerator::FileGenerator(const FileDescriptor& file)
+    : file_(file),
+      base_name_(StripProto(file.name())),
+      namespace_(QualifiedNamespace(file)) {
+  for (int index = 0; index < file.message_type_count(); ++index) {
+    CollectMessages(*file.message_type(index), &messages_);
+  }
+}
+
+void FileGenerator::GenerateHeader(Printer* printer) const {
+  Variables variables;
+  variables["source"] = file_.name();
+  variables["guard"] = HeaderGuard(base_name_ + ".pjcore.h");
+  variables["pb_h"] = base_name_ + ".pb.h";
+
+  printer->Print(variables,
+                 "// Generated by protoc-gen-pjcore.  DO NOT EDIT!\n"
+                 "// source: $source$\n"
+                 "\n"
+                 "#ifndef $guard$\n"
+                 "#define $guard$\n"
+                 "\n"
+                 "#include \"pjcore/json_codec.h\"\n"
+                 "#include \"$pb_h$\"\n"
+                 "\n");
+
+  GenerateNamespaceBegin(printer);
+
+  for (size_t index = 0; index < messages_.size(); ++index) {
+    variables["class"] = ClassName(messages_[index]->full_name(), file_);
+    printer->Print(
+        variables,
+        "void WriteJson(const $class$& message,\n"
+        "               ::pjcore::JsonWriter* writer,\n"
+        "               const ::pjcore::JsonFieldMask* mask = NULL);\n"
+        "\n"
+        "bool ReadJson(::pjcore::JsonTokenizer* tokenizer,\n"
+        "              $class$* message, ::pjcore::Error* error,\n"
+        "              ::google::protobuf::RepeatedPtrField<\n"
+        "                  ::pjcore::JsonValue::Property>*\n"
+        "                  unknown_object_properties = NULL);\n"
+        "\n");
+  }
+
+  GenerateNamespaceEnd(printer);
+
+  printer->Print(variables, "#endif  // $guard$\n");
+}
+
+void FileGenerator::GenerateSource(Printer* printer) const {
+  Variables variables;
+  variables["source"] = file_.name();
+  variables["pjcore_h"] = base_name_ + ".pjcore.h";
+
+  printer->Print(variables,
+                 "// Generated by protoc-gen-pjcore.  DO NOT EDIT!\n"
+                 "// source: $source$\n"
+                 "\n"
+                 "#include \"$pjcore_h$\"\n"
+                 "\n"
+                 "#include <set>\n"
+                 "#include <string>\n"
+                 "#include <vector>\n"
+                 "\n");
+
+  GenerateNamespaceBegin(printer);
+
+  printer->Print("namespace {\n\n");
+  for (size_t index = 0; index < messages_.size(); ++index) {
+    if (!HasMapField(*messages_[index]) &&
+        messages_[index]->field_count() > 0) {
+      GenerateReadField(*messages_[index], printer);
+    }
+  }
+  printer->Print("}  // unnamed namespace\n\n");
+
+  for (size_t index = 0; index < messages_.size(); ++index) {
+    GenerateWriteJson(*messages_[index], printer);
+    GenerateReadJson(*messages_[index], printer);
+  }
+
+  GenerateNamespaceEnd(printer);
+}
+
+void FileGenerator::GenerateNamespaceBegin(Printer* printer) const {
+  std::vector<std::string> parts = SplitPackage(file_.package());
+  for (size_t index = 0; index < parts.size(); ++index) {
+    printer->Print("namespace $part$ {\n", "part", parts[index]);
+  }
+  if (!parts.empty()) {
+    printer->Print("\n");
+  }
+}
+
+void FileGenerator::GenerateNamespaceEnd(Printer* printer) const {
+  std::vector<std::string> parts = SplitPackage(file_.package());
+  for (size_t index = parts.size(); index > 0; --index) {
+    printer->Print("}  // namespace $part$\n", "part", parts[index - 1]);
+  }
+  if (!parts.empty()) {
+    printer->Print("\n");
+  }
+}
+
+void FileGenerator::GenerateWriteJson(const Descriptor& descriptor,
+                                      Printer* printer) const {
+  Variables variables;
+  variables["class"] = ClassName(descriptor.full_name(), file_);
+
+  printer->Print(variables,
+                 "void WriteJson(const $class$& message,\n"
+                 "               ::pjcore::JsonWriter* writer,\n"
+                 "               const ::pjcore::JsonFieldMask* mask) {\n");
+  printer->Indent();
+
+  if (HasMapField(descriptor)) {
+    printer->Print(
+        "writer->Value(mask ? ::pjcore::MakeJsonValue(message, *mask)\n"
+        "                   : ::pjcore::MakeJsonValue(message));\n");
+    printer->Outdent();
+    printer->Print("}\n\n");
+    return;
+  }
+
+  printer->Print("writer->BeginObject();\n");
+  if (descriptor.field_count() > 0) {
+    printer->Print("const ::pjcore::JsonFieldMask* field_mask;\n");
+  }
+
+  for (int index = 0; index < descriptor.field_count(); ++index) {
+    const FieldDescriptor& field = *descriptor.field(index);
+    variables["name"] = LowerName(field.name());
+    variables["json_name"] = field.name();
+    variables["condition"] = PresenceCondition(field);
+
+    if (IsObjectProperties(field)) {
+      printer->Print(
+          variables,
+          "for (int index = 0; index < message.$name$_size(); ++index) {\n"
+          "  if (::pjcore::SelectJsonField(\n"
+          "          mask, message.$name$(index).name(), &field_mask)) {\n"
+          "    writer->Key(message.$name$(index).name());\n"
+          "    writer->Value(message.$name$(index).value());\n"
+          "  }\n"
+          "}\n");
+      continue;
+    }
+
+    printer->Print(variables,
+                   "if ($condition$ &&\n"
+                   "    ::pjcore::SelectJsonField(mask, \"$json_name$\", "
+                   "&field_mask)) {\n"
+                   "  writer->Key(\"$json_name$\");\n");
+    printer->Indent();
+    if (!field.is_repeated()) {
+      GenerateWriteValue(field, "message." + variables["name"] + "()",
+                         printer);
+    } else {
+      printer->Print(
+          variables,
+          "writer->BeginArray();\n"
+          "for (int index = 0; index < message.$name$_size(); ++index) {\n");
+      printer->Indent();
+      GenerateWriteValue(field, "message." + variables["name"] + "(index)",
+                         printer);
+      printer->Outdent();
+      printer->Print(
+          "}\n"
+          "writer->EndArray();\n");
+    }
+    printer->Outdent();
+    printer->Print("}\n");
+  }
+
+  printer->Print("writer->EndObject();\n");
+  printer->Outdent();
+  printer->Print("}\n\n");
+}
+
+void FileGenerator::GenerateWriteValue(const FieldDescriptor& field,
+                                       const std::string& expression,
+                                       Printer* printer) const {
+  Variables variables;
+  variables["expression"] = expression;
+  variables["namespace"] = namespace_;
+
+  switch (field.cpp_type()) {
+    case FieldDescriptor::CPPTYPE_INT32:
+    case FieldDescriptor::CPPTYPE_INT64:
+    case FieldDescriptor::CPPTYPE_UINT32:
+    case FieldDescriptor::CPPTYPE_UINT64:
+      variables["type"] = NumberType(field);
+      printer->Print(variables,
+                     "writer->Value(static_cast<$type$>($expression$));\n");
+      break;
+
+    case FieldDescriptor::CPPTYPE_DOUBLE:
+    case FieldDescriptor::CPPTYPE_FLOAT:
+    case FieldDescriptor::CPPTYPE_BOOL:
+      printer->Print(variables, "writer->Value($expression$);\n");
+      break;
+
+    case FieldDescriptor::CPPTYPE_ENUM:
+      variables["enum"] = QualifiedEnumName(*field.enum_type());
+      printer->Print(
+          variables,
+          "writer->Value(\n"
+          "    ::pjcore::StringPiece($enum$_Name($expression$)));\n");
+      break;
+
+    case FieldDescriptor::CPPTYPE_STRING:
+      if (field.type() == FieldDescriptor::TYPE_STRING) {
+        printer->Print(variables,
+                       "writer->Value(::pjcore::StringPiece($expression$));\n");
+      } else {
+        printer->Print(variables,
+                       "::pjcore::WriteJsonBytes($expression$, writer);\n");
+      }
+      break;
+
+    case FieldDescriptor::CPPTYPE_MESSAGE:
+      if (IsJsonValue(*field.message_type())) {
+        printer->Print(variables, "writer->Value($expression$);\n");
+      } else if (field.message_type()->file() == &file_) {
+        printer->Print(
+            variables,
+            "$namespace$::WriteJson($expression$, writer, field_mask);\n");
+      } else {
+        printer->Print(
+            variables,
+            "writer->Value(\n"
+            "    field_mask\n"
+            "        ? ::pjcore::MakeJsonValue($expression$, *field_mask)\n"
+            "        : ::pjcore::MakeJsonValue($expression$));\n");
+      }
+      break;
+  }
+}
+
+void FileGenerator::GenerateReadField(const Descriptor& descriptor,
+                                      Printer* printer) const {
+  Variables variables;
+  variables["class"] = ClassName(descriptor.full_name(), file_);
+
+  printer->Print(variables,
+                 "bool Read$class$Field(\n"
+                 "    int field_index, ::pjcore::JsonTokenizer* tokenizer,\n"
+                 "    $class$* message, ::pjcore::Error* error,\n"
+                 "    ::google::protobuf::RepeatedPtrField<\n"
+                 "        ::pjcore::JsonValue::Property>*\n"
+                 "        unknown_object_properties) {\n"
+                 "  switch (field_index) {\n");
+  printer->Indent();
+  printer->Indent();
+
+  for (int index = 0; index < descriptor.field_count(); ++index) {
+    const FieldDescriptor& field = *descriptor.field(index);
+    variables["index"] = WriteInt(index);
+    variables["name"] = LowerName(field.name());
+
+    printer->Print(
+        variables,
+        "case $index$:\n"
+        "  if (tokenizer->token() == ::pjcore::JsonTokenizer::TOKEN_NULL) {\n"
+        "    message->clear_$name$();\n"
+        "    return true;\n"
+        "  }\n");
+    printer->Indent();
+    if (!field.is_repeated()) {
+      GenerateReadValue(field, true, "message", false,
+                        "unknown_object_properties", printer);
+      printer->Print("return true;\n");
+    } else {
+      GenerateReadRepeated(field, printer);
+    }
+    printer->Outdent();
+    printer->Print("\n");
+  }
+
+  printer->Print(
+      "default:\n"
+      "  PJCORE_CHECK(false);  // field_index\n"
+      "  return false;\n");
+  printer->Outdent();
+  printer->Print("}\n");
+  printer->Outdent();
+  printer->Print("}\n\n");
+}
+
+void FileGenerator::GenerateReadRepeated(const FieldDescriptor& field,
+                                         Printer* printer) const {
+  printer->Print(
+      "if (tokenizer->token() == ::pjcore::JsonTokenizer::TOKEN_BEGIN_ARRAY) "
+      "{\n"
+      "  for (;;) {\n"
+      "    PJCORE_REQUIRE_SILENT(tokenizer->Next(error), "
+      "\"Failed to read value\");\n"
+      "    if (tokenizer->token() == "
+      "::pjcore::JsonTokenizer::TOKEN_END_ARRAY) {\n"
+      "      return true;\n"
+      "    }\n");
+  printer->Indent();
+  printer->Indent();
+  GenerateReadValue(field, true, "message", true, "unknown_object_properties",
+                    printer);
+  printer->Outdent();
+  printer->Outdent();
+  printer->Print(
+      "  }\n"
+      "}\n");
+
+  const FieldDescriptor* name_field = FindRepeatedNameField(field);
+  if (name_field) {
+    GenerateReadObjectForm(field, *name_field, printer);
+  }
+
+  printer->Print(
+      "PJCORE_FAIL(\n"
+      "    \"Array expected for repeated field, or object if repeated message "
+      "\"\n"
+      "    \"has field name\");\n");
+}
+
+void FileGenerator::GenerateReadObjectForm(const FieldDescriptor& field,
+                                           const FieldDescriptor& name_field,
+                                           Printer* printer) const {
+  Variables variables;
+  variables["name"] = LowerName(field.name());
+  variables["entry"] = QualifiedClassName(*field.message_type());
+
+  printer->Print(
+      variables,
+      "if (tokenizer->token() == ::pjcore::JsonTokenizer::TOKEN_BEGIN_OBJECT) "
+      "{\n"
+      "  ::google::protobuf::RepeatedPtrField< $entry$> entries;\n"
+      "  std::vector<std::string> names;\n"
+      "  std::set<std::string> seen_names;\n"
+      "  for (;;) {\n"
+      "    PJCORE_REQUIRE_SILENT(tokenizer->Next(error), "
+      "\"Failed to read property\");\n"
+      "    if (tokenizer->token() == "
+      "::pjcore::JsonTokenizer::TOKEN_END_OBJECT) {\n"
+      "      break;\n"
+      "    }\n"
+      "    names.push_back(std::string());\n"
+      "    names.back().swap(*tokenizer->mutable_string_value());\n"
+      "    PJCORE_REQUIRE_SILENT(tokenizer->Next(error), "
+      "\"Failed to read value\");\n"
+      "    if (!tokenizer->config().properties_as_is() &&\n"
+      "        !seen_names.insert(names.back()).second) {\n"
+      "      names.pop_back();\n"
+      "      PJCORE_REQUIRE_SILENT(tokenizer->SkipValue(error), "
+      "\"Failed to skip value\");\n"
+      "      continue;\n"
+      "    }\n");
+  printer->Indent();
+  printer->Indent();
+  if (field.message_type()->file() == &file_) {
+    variables["namespace"] = namespace_;
+    printer->Print(variables,
+                   "PJCORE_REQUIRE_SILENT(\n"
+                   "    $namespace$::ReadJson(tokenizer, entries.Add(), "
+                   "error, NULL),\n"
+                   "    \"Failed to parse message JSON\");\n");
+  } else {
+    printer->Print(variables,
+                   "PJCORE_REQUIRE_SILENT(\n"
+                   "    ::pjcore::ReadJsonMessage(tokenizer, entries.Add(), "
+                   "error, NULL),\n"
+                   "    \"Failed to parse message JSON\");\n");
+  }
+  printer->Outdent();
+  printer->Outdent();
+  printer->Print(
+      variables,
+      "  }\n"
+      "  std::vector<size_t> order;\n"
+      "  ::pjcore::OrderJsonNames(tokenizer->config(), names, &order);\n"
+      "  for (std::vector<size_t>::const_iterator it = order.begin();\n"
+      "       it != order.end(); ++it) {\n"
+      "    $entry$* entry = message->add_$name$();\n"
+      "    entry->Swap(entries.Mutable(static_cast<int>(*it)));\n"
+      "    ::pjcore::JsonValue name_value = "
+      "::pjcore::MakeJsonValue(names[*it]);\n");
+  printer->Indent();
+  printer->Indent();
+  GenerateReadValue(name_field, false, "entry", false, "NULL", printer);
+  printer->Outdent();
+  printer->Outdent();
+  printer->Print(
+      "  }\n"
+      "  return true;\n"
+      "}\n");
+}
+
+void FileGenerator::GenerateReadValue(
+    const FieldDescriptor& field, bool from_tokenizer,
+    const std::string& target, bool add,
+    const std::string& unknown_object_properties, Printer* printer) const {
+  Variables variables;
+  variables["source"] = from_tokenizer ? "*tokenizer" : "name_value";
+  variables["access"] = from_tokenizer ? "tokenizer->" : "name_value.";
+  variables["target"] = target;
+  variables["name"] = LowerName(field.name());
+  variables["set"] = add ? "add_" : "set_";
+  variables["mutable"] = add ? "add_" : "mutable_";
+  variables["unknown_object_properties"] = unknown_object_properties;
+  variables["namespace"] = namespace_;
+
+  switch (field.cpp_type()) {
+    case FieldDescriptor::CPPTYPE_INT32:
+    case FieldDescriptor::CPPTYPE_INT64:
+    case FieldDescriptor::CPPTYPE_UINT32:
+    case FieldDescriptor::CPPTYPE_UINT64:
+    case FieldDescriptor::CPPTYPE_DOUBLE:
+    case FieldDescriptor::CPPTYPE_FLOAT:
+    case FieldDescriptor::CPPTYPE_BOOL:
+      variables["type"] = NumberType(field);
+      printer->Print(
+          variables,
+          "{\n"
+          "  $type$ unboxed;\n"
+          "  PJCORE_REQUIRE_SILENT(\n"
+          "      ::pjcore::UnboxJsonValue($source$, &unboxed, error),\n"
+          "      \"Failed to unbox $type$\");\n"
+          "  $target$->$set$$name$(unboxed);\n"
+          "}\n");
+      break;
+
+    case FieldDescriptor::CPPTYPE_ENUM:
+      variables["enum"] = QualifiedEnumName(*field.enum_type());
+      printer->Print(
+          variables,
+          "{\n"
+          "  $enum$ unboxed;\n"
+          "  if ($access$type() == ::pjcore::JsonValue::TYPE_STRING &&\n"
+          "      $enum$_Parse($access$string_value(), &unboxed)) {\n"
+          "    $target$->$set$$name$(unboxed);\n"
+          "  } else {\n"
+          "    int32_t number;\n"
+          "    bool has_number;\n"
+          "    PJCORE_REQUIRE_SILENT(\n"
+          "        ::pjcore::UnboxJsonEnumNumber($source$, &number, "
+          "&has_number,\n"
+          "                                      error),\n"
+          "        \"Failed to unbox enum\");\n"
+          "    if (has_number && $enum$_IsValid(number)) {\n"
+          "      $target$->$set$$name$(static_cast< $enum$>(number));\n"
+          "    }\n"
+          "  }\n"
+          "}\n");
+      break;
+
+    case FieldDescriptor::CPPTYPE_STRING:
+      if (field.type() != FieldDescriptor::TYPE_STRING) {
+        printer->Print(variables,
+                       "PJCORE_REQUIRE_SILENT(\n"
+                       "    ::pjcore::UnboxJsonBytes($source$, "
+                       "$target$->$mutable$$name$(), error),\n"
+                       "    \"Failed to unbox string\");\n");
+      } else if (from_tokenizer) {
+        printer->Print(variables,
+                       "PJCORE_REQUIRE_SILENT(\n"
+                       "    ::pjcore::UnboxJsonString(tokenizer, "
+                       "$target$->$mutable$$name$(), error),\n"
+                       "    \"Failed to unbox string\");\n");
+      } else {
+        printer->Print(variables,
+                       "PJCORE_REQUIRE_SILENT(\n"
+                       "    ::pjcore::UnboxJsonValue($source$, "
+                       "$target$->$mutable$$name$(), error),\n"
+                       "    \"Failed to unbox string\");\n");
+      }
+      break;
+
+    case FieldDescriptor::CPPTYPE_MESSAGE:
+      if (IsJsonValue(*field.message_type())) {
+        printer->Print(variables,
+                       "PJCORE_REQUIRE(\n"
+                       "    ::pjcore::ReadJson(tokenizer, "
+                       "$target$->$mutable$$name$(), error),\n"
+                       "    \"Failed to unbox message\");\n");
+      } else if (field.message_type()->file() == &file_) {
+        printer->Print(variables,
+                       "PJCORE_REQUIRE(\n"
+                       "    $namespace$::ReadJson(tokenizer, "
+                       "$target$->$mutable$$name$(), error,\n"
+                       "        $unknown_object_properties$),\n"
+                       "    \"Failed to unbox message\");\n");
+      } else {
+        printer->Print(variables,
+                       "PJCORE_REQUIRE(\n"
+                       "    ::pjcore::ReadJsonMessage(tokenizer, "
+                       "$target$->$mutable$$name$(), error,\n"
+                       "        $unknown_object_properties$),\n"
+                       "    \"Failed to unbox message\");\n");
+      }
+      break;
+  }
+}
+
+void FileGenerator::GenerateReadJson(const Descriptor& descriptor,
+                                     Printer* printer) const {
+  Variables variables;
+  variables["class"] = ClassName(descriptor.full_name(), file_);
+  variables["field_count"] = WriteInt(descriptor.field_count());
+
+  printer->Print(variables,
+                 "bool ReadJson(::pjcore::JsonTokenizer* tokenizer,\n"
+                 "              $class$* message, ::pjcore::Error* error,\n"
+                 "              ::google::protobuf::RepeatedPtrField<\n"
+                 "                  ::pjcore::JsonValue::Property>*\n"
+                 "                  unknown_object_properties) {\n");
+  printer->Indent();
+
+  if (HasMapField(descriptor)) {
+    printer->Print(
+        "return ::pjcore::ReadJsonMessage(tokenizer, message, error,\n"
+        "                                 unknown_object_properties);\n");
+    printer->Outdent();
+    printer->Print("}\n\n");
+    return;
+  }
+
+  printer->Print(
+      "PJCORE_CHECK(tokenizer);\n"
+      "PJCORE_CHECK(message);\n"
+      "message->Clear();\n"
+      "PJCORE_CHECK(error);\n"
+      "error->Clear();\n"
+      "\n"
+      "PJCORE_REQUIRE(\n"
+      "    tokenizer->token() == ::pjcore::JsonTokenizer::TOKEN_BEGIN_OBJECT,\n"
+      "    std::string(\"Value is not an object: \") +\n"
+      "        ::pjcore::JsonValue::Type_Name(tokenizer->type()));\n"
+      "\n");
+
+  const FieldDescriptor* object_properties_field =
+      FindObjectPropertiesField(descriptor);
+  if (object_properties_field) {
+    variables["unknown"] =
+        "message->mutable_" + LowerName(object_properties_field->name()) +
+        "()";
+  } else {
+    variables["unknown"] = "&unknown";
+    printer->Print(
+        "::google::protobuf::RepeatedPtrField< ::pjcore::JsonValue::Property>"
+        "\n"
+        "    unknown;\n");
+  }
+  if (descriptor.field_count() > 0) {
+    printer->Print(variables, "bool seen[$field_count$] = {false};\n");
+  }
+  printer->Print(
+      "std::string name;\n"
+      "\n"
+      "for (;;) {\n"
+      "  PJCORE_REQUIRE_SILENT(tokenizer->Next(error), "
+      "\"Failed to read property\");\n"
+      "  if (tokenizer->token() == ::pjcore::JsonTokenizer::TOKEN_END_OBJECT) "
+      "{\n"
+      "    break;\n"
+      "  }\n"
+      "  name.swap(*tokenizer->mutable_string_value());\n"
+      "  PJCORE_REQUIRE_SILENT(tokenizer->Next(error), "
+      "\"Failed to read value\");\n"
+      "\n");
+  printer->Indent();
+
+  if (descriptor.field_count() > 0) {
+    // Dispatches on the name length before comparing names.
+    std::map<size_t, std::vector<int> > by_length;
+    for (int index = 0; index < descriptor.field_count(); ++index) {
+      by_length[descriptor.field(index)->name().size()].push_back(index);
+    }
+
+    printer->Print(
+        "int field_index = -1;\n"
+        "switch (name.size()) {\n");
+    for (std::map<size_t, std::vector<int> >::const_iterator it =
+             by_length.begin();
+         it != by_length.end(); ++it) {
+      printer->Print("  case $length$:\n", "length",
+                     WriteInt(static_cast<int>(it->first)));
+      for (size_t index = 0; index < it->second.size(); ++index) {
+        variables["else"] = index ? "} else " : "";
+        variables["index"] = WriteInt(it->second[index]);
+        variables["json_name"] = descriptor.field(it->second[index])->name();
+        printer->Print(variables,
+                       "    $else$if (name == \"$json_name$\") {\n"
+                       "      field_index = $index$;\n");
+      }
+      printer->Print(
+          "    }\n"
+          "    break;\n");
+    }
+    printer->Print(
+        "}\n"
+        "\n"
+        "if (field_index < 0) {\n");
+    printer->Indent();
+  }
+
+  if (object_properties_field) {
+    printer->Print(variables,
+                   "PJCORE_REQUIRE_SILENT(\n"
+                   "    ::pjcore::ReadJsonProperty(tokenizer, &name, "
+                   "$unknown$, error),\n"
+                   "    \"Failed to read value\");\n");
+  } else {
+    printer->Print(
+        "if (unknown_object_properties) {\n"
+        "  PJCORE_REQUIRE_SILENT(\n"
+        "      ::pjcore::ReadJsonProperty(tokenizer, &name, &unknown, "
+        "error),\n"
+        "      \"Failed to read value\");\n"
+        "} else {\n"
+        "  PJCORE_REQUIRE_SILENT(tokenizer->SkipValue(error),\n"
+        "                        \"Failed to skip value\");\n"
+        "}\n");
+  }
+
+  if (descriptor.field_count() > 0) {
+    printer->Print("continue;\n");
+    printer->Outdent();
+    printer->Print(
+        variables,
+        "}\n"
+        "\n"
+        "if (!tokenizer->config().properties_as_is()) {\n"
+        "  if (seen[field_index]) {\n"
+        "    PJCORE_REQUIRE_SILENT(tokenizer->SkipValue(error),\n"
+        "                          \"Failed to skip value\");\n"
+        "    continue;\n"
+        "  }\n"
+        "  seen[field_index] = true;\n"
+        "}\n"
+        "\n"
+        "PJCORE_REQUIRE_SILENT(\n"
+        "    Read$class$Field(field_index, tokenizer, message, error,\n"
+        "        unknown_object_properties),\n"
+        "    \"Failed to parse field JSON\");\n");
+  }
+
+  printer->Outdent();
+  printer->Print("}\n\n");
+
+  if (object_properties_field) {
+    printer->Print(variables,
+                   "::pjcore::SortJsonProperties(tokenizer->config(), "
+                   "$unknown$);\n");
+  } else {
+    printer->Print(
+        "if (unknown_object_properties) {\n"
+        "  ::pjcore::AppendUnknownJsonProperties(tokenizer->config(), "
+        "&unknown,\n"
+        "                                        "
+        "unknown_object_properties);\n"
+        "}\n");
+  }
+
+  printer->Print("return true;\n");
+  printer->Outdent();
+  printer->Print("}\n\n");
+}
+
+}  // unnamed namespace
+
+JsonCodecGenerator::JsonCodecGenerator() {}
+
+JsonCodecGenerator::~JsonCodecGenerator() {}
+
+bool JsonCodecGenerator::Generate(const FileDescriptor* file,
+                                  const std::string& parameter,
+                                  GeneratorContext* context,
+                                  std::string* error) const {
+  if (!parameter.empty()) {
+    *error = "Unknown parameter: " + parameter;
+    return false;
+  }
+
+  FileGenerator generator(*file);
+  std::string base_name = StripProto(file->name());
+
+  {
+    scoped_ptr<ZeroCopyOutputStream> output(
+        context->Open(base_name + ".pjcore.h"));
+    Printer printer(output.get(), '$');
+    generator.GenerateHeader(&printer);
+  }
+
+  {
+    scoped_ptr<ZeroCopyOutputStream> output(
+        context->Open(base_name + ".pjcore.cc"));
+    Printer printer(output.get(), '$');
+    generator.GenerateSource(&printer);
+  }
+
+  return true;
+}
+
+}  // namespace pjcore
@@ -0,0 +1,52 @@
+// JSON [de]serialization for protobuf + embedded HTTP server and client in C++.
+// Copyright (C) 2014 http://protojson.com/
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+
+#ifndef PROTOC_GEN_PJCORE_JSON_CODEC_GENERATOR_H_
+#define PROTOC_GEN_PJCORE_JSON_CODEC_GENERATOR_H_
+
+#include <string>
+
+#include "google/protobuf/compiler/code_generator.h"
+
+#include "pjcore/third_party/chromium/compiler_specific.h"
+#include "pjcore/third_party/chromium/macros.h"
+
+namespace pjcore {
+
+/**
+ * Emits foo.pjcore.h and foo.pjcore.cc with WriteJson and ReadJson functions
+ * for every message in foo.proto, see pjcore/json_codec.h.
+ */
+class JsonCodecGenerator : public google::protobuf::compiler::CodeGenerator {
+ public:
+  JsonCodecGenerator();
+
+  virtual ~JsonCodecGenerator();
+
+  virtual bool Generate(const google::protobuf::FileDescriptor* file,
+                        const std::string& parameter,
+                        google::protobuf::compiler::GeneratorContext* context,
+                        std::string* error) const OVERRIDE;
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(JsonCodecGenerator);
+};
+
+}  // namespace pjcore
+
+#endif  // PROTOC_GEN_PJCORE_JSON_CODEC_GENERATOR_H_